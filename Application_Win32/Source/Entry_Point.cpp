@@ -19,6 +19,7 @@ int APIENTRY wWinMain(
 		std::shared_ptr<Insight::Win32Window> pWindowsWindow = std::make_shared<Insight::Win32Window>(WindowDesc);
 
 		pApp->SetWindow(pWindowsWindow);
+		pApp->ParseCommandLineArgs(lpCmdLine);
 		pApp->Initialize();
 	}
 	catch (Insight::ieException& Ex) 
@@ -16,6 +16,8 @@
 	#else
 		#define INSIGHT_API
 	#endif
+#else
+	#define INSIGHT_API
 #endif // IE_PLATFORM_BUILD_WIN32
 
 #if defined IE_DEBUG
@@ -23,6 +25,16 @@
 	#define IE_SCOPE_PROFILING_ENABLED
 #endif // IE_DEBUG
 
+// Replaces the global operator new/delete with tagged, per subsystem tracking. See Memory/Memory_Tracker.h.
+#if defined (IE_DEBUG) || defined (IE_RELEASE)
+	#define IE_MEMORY_TRACKING_ENABLED
+#endif
+
+// Keeps the strings behind interned StringIds so they can be shown by name. See Utilities/String_Id.h.
+#if defined IE_DEBUG
+	#define IE_STRING_ID_NAMES_ENABLED
+#endif
+
 #if defined IE_ENABLE_ASSERTS
 	#define IE_ASSERT(x, ...) { if( !(x) ) { IE_DEBUG_LOG(LogSeverity::Error, "Assertion Failed: {0}", __VA_ARGS__); __debugbreak(); } }
 #else
@@ -40,13 +52,17 @@
 
 // Utilities
 #define BIT_SHIFT(x) ( 1 << x )
-#define IE_BIND_LOCAL_EVENT_FN(Fn) std::bind( &Fn, this, std::placeholders::_1 )
+#define IE_BIND_LOCAL_EVENT_FN(Fn) [this](auto&& ... Args) { return std::invoke(&Fn, this, std::forward<decltype(Args)>(Args)...); }
 #define IE_BIND_EVENT_FN(Fn, Class) std::bind( &Fn, Class, std::placeholders::_1 )
 #define IE_BIND_LOCAL_VOID_FN(Fn) std::bind( &Fn, this )
 #define COM_SAFE_RELEASE(ComObject) if(ComObject) { ComObject->Release(); ComObject = nullptr; }
 #define RAW_LITERAL(Value) #Value
 #define MACRO_TO_STRING(Macro) RAW_LITERAL(Macro);
-#define FORCE_INLINE __forceinline
+#if defined (_MSC_VER)
+	#define FORCE_INLINE __forceinline
+#else
+	#define FORCE_INLINE inline __attribute__((always_inline))
+#endif
 
 // Includes
 #include "Insight/Math/Math_Helpers.h"
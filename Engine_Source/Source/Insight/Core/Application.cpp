@@ -7,6 +7,13 @@
 #include "Insight/Core/Layer/ImGui_Layer.h"
 #include "Insight/Core/ie_Exception.h"
 #include "Insight/Rendering/Renderer.h"
+#include "Insight/Memory/Frame_Arena.h"
+#include "Insight/Memory/Deferred_Destruction.h"
+#include "Insight/Memory/Memory_Tracker.h"
+#include "Insight/Systems/Async_IO.h"
+#include "Insight/Core/Scene/Tick_Manager.h"
+#include "Insight/Core/Scene/World_Partition.h"
+#include "Insight/Rendering/Geometry/Transform_Journal.h"
 
 #if defined (IE_PLATFORM_BUILD_WIN32)
 	#include "Platform/DirectX_11/Wrappers/D3D11_ImGui_Layer.h"
@@ -38,6 +45,18 @@ namespace Insight {
 		IE_ASSERT(!s_Instance, "Trying to create Application instance when one already exists!");
 		s_Instance = this;
 
+		m_EventBus.Subscribe<WindowCloseEvent, Application, &Application::OnWindowClose>(this);
+		m_EventBus.Subscribe<WindowResizeEvent, Application, &Application::OnWindowResize>(this);
+		m_EventBus.Subscribe<WindowToggleFullScreenEvent, Application, &Application::OnWindowFullScreen>(this);
+		m_EventBus.Subscribe<SceneSaveEvent, Application, &Application::SaveScene>(this);
+		m_EventBus.Subscribe<AppBeginPlayEvent, Application, &Application::BeginPlay>(this);
+		m_EventBus.Subscribe<AppEndPlayEvent, Application, &Application::EndPlay>(this);
+		m_EventBus.Subscribe<AppScriptReloadEvent, Application, &Application::ReloadScripts>(this);
+		m_EventBus.Subscribe<ShaderReloadEvent, Application, &Application::ReloadShaders>(this);
+		// Window input takes the same path as every other event, the input dispatcher records and maps it.
+		SubscribeInputEvents<KeyPressedEvent, KeyReleasedEvent, KeyTypedEvent, KeyHeldEvent,
+			MouseButtonPressedEvent, MouseButtonReleasedEvent, MouseMovedEvent, MouseRawMoveEvent, MouseScrolledEvent>();
+
 
 		// Initialize the core logger.
 		IE_STRIP_FOR_GAME_DIST(
@@ -50,6 +69,61 @@ namespace Insight {
 
 	Application::~Application()
 	{
+		// Report anything the engine is still holding on to.
+		Memory::MemoryTracker::ReportLeaks();
+		Memory::MemoryTracker::CloseCsv();
+
+		// Write any messages still queued by the logging thread.
+		IE_STRIP_FOR_GAME_DIST(
+			Insight::Debug::Logger::Shutdown();
+		)
+	}
+
+	void Application::ParseCommandLineArgs(const std::wstring& CmdLine)
+	{
+		std::vector<std::string> Args;
+		std::istringstream ArgStream(StringHelper::WideToString(CmdLine));
+		for (std::string Arg; ArgStream >> Arg;)
+			Args.push_back(Arg);
+
+		std::string RecordPath, ReplayPath;
+		for (size_t i = 0; i < Args.size(); ++i)
+		{
+			const bool HasValue = i + 1 < Args.size();
+			if (Args[i] == "-RecordInput" && HasValue)
+				RecordPath = Args[++i];
+			else if (Args[i] == "-ReplayInput" && HasValue)
+				ReplayPath = Args[++i];
+			else if (Args[i] == "-FixedDelta" && HasValue)
+				m_FixedDeltaTime = static_cast<float>(std::atof(Args[++i].c_str()));
+			else if (Args[i] == "-BinaryLog" && HasValue)
+			{
+				if (!Debug::AsyncLogger::Get().OpenBinaryLog(Args[++i]))
+					IE_DEBUG_LOG(LogSeverity::Error, "Failed to open binary log file \"{0}\".", Args[i]);
+			}
+			else if (Args[i] == "-SerialTick")
+				TickManager::SetSerialTicking(true);
+			else if (Args[i] == "-MemoryCsv" && HasValue)
+			{
+				if (!Memory::MemoryTracker::OpenCsv(Args[++i]))
+					IE_DEBUG_LOG(LogSeverity::Error, "Failed to open memory stats file \"{0}\".", Args[i]);
+			}
+		}
+
+		Input::InputRecorder& Recorder = m_InputDispatcher.GetRecorder();
+		if (!ReplayPath.empty())
+		{
+			if (!Recorder.BeginReplay(ReplayPath))
+				return;
+
+			Recorder.SetUseRecordedDeltaTime(m_FixedDeltaTime <= 0.0f);
+			m_pReplayWindow = std::make_shared<Input::ReplayWindow>(Recorder, [this](Event& e) { DispatchEvent(e); }, m_pWindow->GetWidth(), m_pWindow->GetHeight());
+			m_InputDispatcher.SetWindowRef(m_pReplayWindow);
+		}
+		else if (!RecordPath.empty())
+		{
+			Recorder.BeginRecording(RecordPath);
+		}
 	}
 
 	void Application::Initialize()
@@ -59,8 +133,14 @@ namespace Insight {
 		// Initize the main file system.
 		FileSystem::Init();
 
+		// Load the user's input mappings.
+		m_InputDispatcher.LoadMappingsFromJson(StringHelper::WideToString(FileSystem::GetRelativeContentDirectoryW(L"PROFSAVE.ini")));
+
 		// Create and initialize the renderer.
-		Renderer::SetSettingsAndCreateContext(FileSystem::LoadGraphicsSettingsFromJson(), m_pWindow);
+		{
+			IE_MEMORY_TAG(Rendering);
+			Renderer::SetSettingsAndCreateContext(FileSystem::LoadGraphicsSettingsFromJson(), m_pWindow);
+		}
 
 		// Create the game layer that will host all game logic.
 		m_pGameLayer = new GameLayer();
@@ -89,15 +169,35 @@ namespace Insight {
 	}
 
 
+	float Application::BeginFrame()
+	{
+		m_FrameTimer.Tick();
+		Memory::GetGameFrameArena().BeginFrame();
+		float DeltaMs = (m_FixedDeltaTime > 0.0f) ? m_FixedDeltaTime : m_FrameTimer.DeltaTime();
+		Memory::MemoryTracker::BeginFrame(DeltaMs);
+
+		Input::InputRecorder& Recorder = m_InputDispatcher.GetRecorder();
+		Recorder.BeginFrame(DeltaMs);
+		if (Recorder.IsReplayFinished())
+		{
+			Recorder.EndReplay();
+			m_Running = false;
+		}
+		return DeltaMs;
+	}
+
 	float g_GPUThreadFPS = 0.0f;
 	void Application::RenderThread()
 	{
+		IE_MEMORY_TAG(Rendering);
 		FrameTimer GraphicsTimer;
 
 		while (m_Running)
 		{
 			GraphicsTimer.Tick();
 			g_GPUThreadFPS = GraphicsTimer.FPS();
+			Memory::GetRenderFrameArena().BeginFrame();
+			TransformJournal::Get().BeginFrame();
 
 			Renderer::OnUpdate(GraphicsTimer.DeltaTime());
 
@@ -136,12 +236,13 @@ namespace Insight {
 		
 		while (m_Running)
 		{
-			m_FrameTimer.Tick();
-			float DeltaMs = m_FrameTimer.DeltaTime();
+			float DeltaMs = BeginFrame();
 			m_pWindow->SetWindowTitleFPS(g_GPUThreadFPS);
 
 			// Process the window's Messages 
 			m_pWindow->OnUpdate();
+			if (m_pReplayWindow)
+				m_pReplayWindow->OnUpdate();
 
 			//static float WorldSeconds = 0.0f;
 			//WorldSeconds += DeltaMs;
@@ -157,6 +258,12 @@ namespace Insight {
 			// Update the layer stack. 
 			for (Layer* layer : m_LayerStack)
 				layer->OnUpdate(DeltaMs);
+
+			// Start reloading assets changed on disk, they are swapped in by the render thread.
+			ResourceManager::Get().GetAssetHotReload().Update();
+
+			// Free actors and components destroyed this frame.
+			Memory::DeferredDestructionQueue::Get().Flush();
 		}
 
 		// Close the render thread and flush the GPU.
@@ -171,8 +278,7 @@ namespace Insight {
 	Application::ieErrorCode Application::RunSingleThreaded()
 	{
 		{
-			m_FrameTimer.Tick();
-			float DeltaMs = m_FrameTimer.DeltaTime();
+			float DeltaMs = BeginFrame();
 			m_pWindow->SetWindowTitleFPS(g_GPUThreadFPS);
 
 			// Process the window's Messages 
@@ -183,9 +289,12 @@ namespace Insight {
 			//pSCDemoBall->Translate(0.0f, std::sin(WorldSeconds) * 0.02f, 0.0f);
 
 			{
+				IE_MEMORY_TAG(Rendering);
 				static FrameTimer GraphicsTimer;
 				GraphicsTimer.Tick();
 				g_GPUThreadFPS = GraphicsTimer.FPS();
+				Memory::GetRenderFrameArena().BeginFrame();
+				TransformJournal::Get().BeginFrame();
 
 				Renderer::OnUpdate(GraphicsTimer.DeltaTime());
 
@@ -213,6 +322,8 @@ namespace Insight {
 			}
 
 			m_pWindow->OnUpdate();
+			if (m_pReplayWindow)
+				m_pReplayWindow->OnUpdate();
 
 			// Update the input system. 
 			m_InputDispatcher.UpdateInputs(DeltaMs);
@@ -223,12 +334,30 @@ namespace Insight {
 			// Update the layer stack. 
 			for (Layer* layer : m_LayerStack)
 				layer->OnUpdate(DeltaMs);
+
+			// Start reloading assets changed on disk, they are swapped in by the render thread.
+			ResourceManager::Get().GetAssetHotReload().Update();
+
+			// Free actors and components destroyed this frame.
+			Memory::DeferredDestructionQueue::Get().Flush();
 		}
 		return ieErrorCode_Success;
 	}
 
 	void Application::Shutdown()
 	{
+		// Flush any in-progress input recording or replay.
+		m_InputDispatcher.GetRecorder().EndRecording();
+		m_InputDispatcher.GetRecorder().EndReplay();
+
+		// Finish asset reads still in flight before their loaders are destroyed.
+		AsyncIO::Get().Shutdown();
+
+		// Leave the cells of the last save complete.
+		if (m_WorldPartitionCook.valid())
+			m_WorldPartitionCook.wait();
+
+		Memory::DeferredDestructionQueue::Get().Flush();
 	}
 
 	void Application::PushCoreLayers()
@@ -283,18 +412,17 @@ namespace Insight {
 
 	void Application::OnEvent(Event& e)
 	{
-		EventDispatcher Dispatcher(e);
-		Dispatcher.Dispatch<WindowCloseEvent>(IE_BIND_LOCAL_EVENT_FN(Application::OnWindowClose));
-		Dispatcher.Dispatch<WindowResizeEvent>(IE_BIND_LOCAL_EVENT_FN(Application::OnWindowResize));
-		Dispatcher.Dispatch<WindowToggleFullScreenEvent>(IE_BIND_LOCAL_EVENT_FN(Application::OnWindowFullScreen));
-		Dispatcher.Dispatch<SceneSaveEvent>(IE_BIND_LOCAL_EVENT_FN(Application::SaveScene));
-		Dispatcher.Dispatch<AppBeginPlayEvent>(IE_BIND_LOCAL_EVENT_FN(Application::BeginPlay));
-		Dispatcher.Dispatch<AppEndPlayEvent>(IE_BIND_LOCAL_EVENT_FN(Application::EndPlay));
-		Dispatcher.Dispatch<AppScriptReloadEvent>(IE_BIND_LOCAL_EVENT_FN(Application::ReloadScripts));
-		Dispatcher.Dispatch<ShaderReloadEvent>(IE_BIND_LOCAL_EVENT_FN(Application::ReloadShaders));
-
-		// Process input event callbacks. 
-		m_InputDispatcher.ProcessInputEvent(e);
+		// While replaying, input comes from the replay window. Drop what the OS sends.
+		if (m_pReplayWindow && e.IsInCategory(EventCategoryInput))
+			return;
+
+		DispatchEvent(e);
+	}
+
+	void Application::DispatchEvent(Event& e)
+	{
+		// Core application and input events. Indexed by event type so only the matching handlers run.
+		m_EventBus.Publish(e);
 
 		for (auto it = m_LayerStack.end(); it != m_LayerStack.begin();)
 		{
@@ -325,7 +453,19 @@ namespace Insight {
 
 	bool Application::SaveScene(SceneSaveEvent& e)
 	{
-		std::future<bool> Future = std::async(std::launch::async, FileSystem::WriteSceneToJson, m_pGameLayer->GetScene());
+		Scene* pScene = m_pGameLayer->GetScene();
+
+		// The save rewrites the files a cook in flight reads.
+		if (m_WorldPartitionCook.valid())
+			m_WorldPartitionCook.wait();
+
+		if (!FileSystem::WriteSceneToJson(pScene))
+			return true;
+
+		// Game builds stream partitioned scenes from their cells. Cooking reads back the whole saved scene, so it runs in the background rather than as part of the save.
+		const SceneJournal& Journal = pScene->GetJournal();
+		if (pScene->GetWorldCellSize() > 0.0f && Journal.IsTracking())
+			m_WorldPartitionCook = std::async(std::launch::async, &WorldPartition::Cook, Journal.GetSceneDirectory(), pScene->GetWorldCellSize());
 		return true;
 	}
 
@@ -24,7 +24,9 @@
 #include "Insight/Core/Layer/Layer_Stack.h"
 
 #include "Insight/Events/Application_Event.h"
+#include "Insight/Events/Event_Bus.h"
 #include "Insight/Input/Input_Dispatcher.h"
+#include "Insight/Input/Input_Replay_Window.h"
 
 #include "Insight/Core/Layer/Game_Layer.h"
 #include "Insight/Core/Layer/ImGui_Layer.h"
@@ -53,6 +55,16 @@ namespace Insight {
 		inline static Application& Get() { return *s_Instance; }
 
 
+		/*
+			Parse the engine's command line switches. Should be called after the window has been set and before Initialize.
+			-RecordInput <File>		Record all input to a file.
+			-ReplayInput <File>		Replay input from a file instead of the window and exit when it ends.
+			-FixedDelta <Seconds>	Step every frame by a fixed delta time. Overrides the recorded delta times when replaying.
+			-BinaryLog <File>		Also write raw log records to a binary file. Decode with Tools/Log_Decoder.
+			-MemoryCsv <File>		Write per frame memory stats for each allocation tag to a CSV file.
+			-SerialTick				Tick every actor on the game thread in a fixed order, for debugging.
+		*/
+		void ParseCommandLineArgs(const std::wstring& CmdLine);
 		// Initialize the core components of the application. Should be called once
 		// at the beginning of the application, after the window has been initialized.
 		virtual void Initialize();
@@ -99,6 +111,16 @@ namespace Insight {
 	private:
 		void PushCoreLayers();
 		void RenderThread();
+		// Advance the frame timer and input recorder. Returns the delta time to step the frame by.
+		float BeginFrame();
+		// Send an event to the core handlers, the input system and the layer stack.
+		void DispatchEvent(Event& e);
+		// Subscribe the input dispatcher to each of the window input event types.
+		template <typename ... EventClasses>
+		void SubscribeInputEvents()
+		{
+			(m_EventBus.Subscribe<EventClasses, Input::InputDispatcher, &Input::InputDispatcher::OnWindowInputEvent<EventClasses>>(&m_InputDispatcher), ...);
+		}
 
 		virtual bool OnWindowClose(WindowCloseEvent& e);
 		virtual bool OnWindowResize(WindowResizeEvent& e);
@@ -111,6 +133,8 @@ namespace Insight {
 		virtual bool ReloadShaders(ShaderReloadEvent& e);
 	protected:
 		std::shared_ptr<Window>	m_pWindow;
+		// Input source used in place of m_pWindow while replaying recorded input.
+		std::shared_ptr<Input::ReplayWindow> m_pReplayWindow;
 		
 		IE_STRIP_FOR_GAME_DIST(ImGuiLayer* m_pImGuiLayer = nullptr; )
 		IE_STRIP_FOR_GAME_DIST(EditorLayer* m_pEditorLayer = nullptr; )
@@ -119,10 +143,15 @@ namespace Insight {
 		
 		bool					m_Running = true;
 		bool					m_AppInitialized = false;
+		// Delta time in seconds to step each frame by. Zero uses the frame timer.
+		float					m_FixedDeltaTime = 0.0f;
 		LayerStack				m_LayerStack;
 		FrameTimer				m_FrameTimer;
 		FileSystem				m_FileSystem;
 		Input::InputDispatcher	m_InputDispatcher;
+		EventBus				m_EventBus;
+		// Cook of the cells of the last saved partitioned scene, see SaveScene.
+		std::future<bool>		m_WorldPartitionCook;
 		Insight::Runtime::AActor* pARustedBall;
 		Insight::Runtime::SceneComponent* pSCDemoBall;
 	private:
@@ -0,0 +1,312 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Async_Logger.h"
+
+namespace Insight {
+
+	namespace Debug {
+
+		// How long the logger thread sleeps when every ring is empty.
+		static constexpr std::chrono::milliseconds s_IdleWaitTime(2);
+
+		static spdlog::level::level_enum ToSpdlogLevel(LogSeverity Severity)
+		{
+			switch (Severity)
+			{
+			case LogSeverity::Log:		return spdlog::level::info;
+			case LogSeverity::Verbose:	return spdlog::level::trace;
+			case LogSeverity::Warning:	return spdlog::level::warn;
+			case LogSeverity::Error:	return spdlog::level::err;
+			case LogSeverity::Critical:	return spdlog::level::critical;
+			default:					return spdlog::level::warn;
+			}
+		}
+
+
+		// ------------
+		//	 LogRing	|
+		// ------------
+
+		LogRing::LogRing(uint32_t ThreadId)
+			: m_pBuffer(new uint8_t[Capacity])
+			, m_ThreadId(ThreadId)
+		{
+		}
+
+		LogRing::RecordHeader* LogRing::TryReserve(uint32_t PayloadSize)
+		{
+			const uint32_t TotalSize = (static_cast<uint32_t>(sizeof(RecordHeader)) + PayloadSize + 7u) & ~7u;
+
+			uint64_t Write = m_WritePosition.load(std::memory_order_relaxed);
+			const uint64_t Read = m_ReadPosition.load(std::memory_order_acquire);
+
+			// Records never straddle the end of the buffer. Skip the tail if the record does not fit in it.
+			const uint32_t Offset = static_cast<uint32_t>(Write & Mask);
+			const uint32_t Contiguous = Capacity - Offset;
+			const uint32_t Padding = (TotalSize > Contiguous) ? Contiguous : 0u;
+			if ((Write - Read) + Padding + TotalSize > Capacity)
+				return nullptr;
+
+			if (Padding > 0u)
+			{
+				reinterpret_cast<RecordHeader*>(m_pBuffer.get() + Offset)->TotalSize = 0u;
+				Write += Padding;
+			}
+
+			RecordHeader* pRecord = reinterpret_cast<RecordHeader*>(m_pBuffer.get() + (Write & Mask));
+			pRecord->TotalSize = TotalSize;
+			m_PendingWritePosition = Write + TotalSize;
+			return pRecord;
+		}
+
+		void LogRing::Commit(RecordHeader* pRecord)
+		{
+			m_WritePosition.store(m_PendingWritePosition, std::memory_order_release);
+		}
+
+
+		// ----------------
+		//	 AsyncLogger	|
+		// ----------------
+
+		AsyncLogger::~AsyncLogger()
+		{
+			Stop();
+			CloseBinaryLog();
+		}
+
+		void AsyncLogger::Start()
+		{
+			if (m_Running.exchange(true))
+				return;
+
+			m_PendingRecords.reserve(1024);
+			m_ConsumerThread = std::thread(&AsyncLogger::ConsumerThread, this);
+		}
+
+		void AsyncLogger::Stop()
+		{
+			if (!m_Running.exchange(false))
+				return;
+
+			{
+				std::lock_guard<std::mutex> Lock(m_FlushMutex);
+				m_FlushCondition.notify_all();
+			}
+			if (m_ConsumerThread.joinable())
+				m_ConsumerThread.join();
+		}
+
+		void AsyncLogger::Flush()
+		{
+			std::unique_lock<std::mutex> Lock(m_FlushMutex);
+			if (!m_Running.load())
+				return;
+
+			const uint64_t Ticket = ++m_FlushRequested;
+			m_FlushCondition.notify_all();
+			m_FlushCondition.wait(Lock, [this, Ticket]() { return m_FlushCompleted >= Ticket || !m_Running.load(); });
+		}
+
+		bool AsyncLogger::OpenBinaryLog(const std::string& FilePath)
+		{
+			std::lock_guard<std::mutex> Lock(m_BinaryLogMutex);
+			if (m_pBinaryLogFile)
+				fclose(m_pBinaryLogFile);
+
+			m_BinarySiteIds.clear();
+			m_pBinaryLogFile = fopen(FilePath.c_str(), "wb");
+			if (!m_pBinaryLogFile)
+				return false;
+
+			const BinaryLogFileHeader Header = { BinaryLogMagic, BinaryLogVersion };
+			fwrite(&Header, sizeof(BinaryLogFileHeader), 1, m_pBinaryLogFile);
+			return true;
+		}
+
+		void AsyncLogger::CloseBinaryLog()
+		{
+			Flush();
+
+			std::lock_guard<std::mutex> Lock(m_BinaryLogMutex);
+			if (m_pBinaryLogFile)
+			{
+				fclose(m_pBinaryLogFile);
+				m_pBinaryLogFile = nullptr;
+			}
+		}
+
+		LogRing& AsyncLogger::GetThreadRing()
+		{
+			// Marks the ring as retired when the thread exits so the logger can free it once drained.
+			struct ThreadRingHandle
+			{
+				~ThreadRingHandle() { if (pRing) pRing->Retired.store(true, std::memory_order_release); }
+				std::shared_ptr<LogRing> pRing;
+			};
+			static thread_local ThreadRingHandle Handle;
+
+			if (!Handle.pRing)
+			{
+				Handle.pRing = std::make_shared<LogRing>(m_NextThreadId.fetch_add(1u, std::memory_order_relaxed));
+
+				std::lock_guard<std::mutex> Lock(m_RingsMutex);
+				m_Rings.push_back(Handle.pRing);
+			}
+			return *Handle.pRing;
+		}
+
+		uint64_t AsyncLogger::GetTimestamp()
+		{
+			return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+		}
+
+		void AsyncLogger::ConsumerThread()
+		{
+			while (m_Running.load(std::memory_order_acquire))
+			{
+				uint64_t FlushTicket = 0u;
+				{
+					std::lock_guard<std::mutex> Lock(m_FlushMutex);
+					FlushTicket = m_FlushRequested;
+				}
+
+				const uint32_t NumWritten = Drain();
+
+				std::unique_lock<std::mutex> Lock(m_FlushMutex);
+				if (FlushTicket > m_FlushCompleted)
+				{
+					m_FlushCompleted = FlushTicket;
+					m_FlushCondition.notify_all();
+				}
+				if (NumWritten == 0u)
+					m_FlushCondition.wait_for(Lock, s_IdleWaitTime, [this]() { return m_FlushRequested > m_FlushCompleted || !m_Running.load(); });
+			}
+
+			// Write everything that was logged before the logger stopped.
+			Drain();
+
+			std::lock_guard<std::mutex> Lock(m_FlushMutex);
+			m_FlushCompleted = m_FlushRequested;
+			m_FlushCondition.notify_all();
+		}
+
+		uint32_t AsyncLogger::Drain()
+		{
+			std::vector<std::shared_ptr<LogRing>>& Rings = m_DrainRings;
+			{
+				std::lock_guard<std::mutex> Lock(m_RingsMutex);
+				Rings.assign(m_Rings.begin(), m_Rings.end());
+			}
+
+			// Gather the published records of every thread and write them in the order they were logged.
+			m_PendingRecords.clear();
+			std::vector<uint64_t>& ReadPositions = m_DrainReadPositions;
+			ReadPositions.resize(Rings.size());
+			for (size_t i = 0; i < Rings.size(); ++i)
+			{
+				const LogRing* pRing = Rings[i].get();
+				ReadPositions[i] = pRing->Peek([this, pRing](const LogRing::RecordHeader& Record)
+					{
+						m_PendingRecords.push_back({ Record.Timestamp, pRing, &Record });
+					});
+			}
+			std::stable_sort(m_PendingRecords.begin(), m_PendingRecords.end(),
+				[](const PendingRecord& A, const PendingRecord& B) { return A.Timestamp < B.Timestamp; });
+
+			fmt::memory_buffer& Scratch = m_FormatScratch;
+			{
+				std::lock_guard<std::mutex> Lock(m_BinaryLogMutex);
+				for (const PendingRecord& Pending : m_PendingRecords)
+				{
+					WriteRecordText(*Pending.pRecord, Scratch);
+					if (m_pBinaryLogFile)
+						WriteRecordBinary(*Pending.pRing, *Pending.pRecord);
+				}
+				if (m_pBinaryLogFile && !m_PendingRecords.empty())
+					fflush(m_pBinaryLogFile);
+			}
+
+			bool HasRetiredRings = false;
+			for (size_t i = 0; i < Rings.size(); ++i)
+			{
+				LogRing& Ring = *Rings[i];
+				Ring.Release(ReadPositions[i]);
+
+				const uint32_t NumDropped = Ring.NumDropped.exchange(0u, std::memory_order_relaxed);
+				if (NumDropped > 0u && Logger::GetCoreLogger())
+					Logger::GetCoreLogger()->warn("Logger dropped {0} messages from thread {1}. The thread's log ring was full.", NumDropped, Ring.GetThreadId());
+
+				HasRetiredRings |= Ring.Retired.load(std::memory_order_acquire);
+			}
+
+			if (HasRetiredRings)
+			{
+				std::lock_guard<std::mutex> Lock(m_RingsMutex);
+				m_Rings.erase(std::remove_if(m_Rings.begin(), m_Rings.end(),
+					[](const std::shared_ptr<LogRing>& pRing) { return pRing->Retired.load(std::memory_order_acquire) && pRing->IsEmpty(); }), m_Rings.end());
+			}
+
+			Rings.clear();
+			return static_cast<uint32_t>(m_PendingRecords.size());
+		}
+
+		void AsyncLogger::WriteRecordText(const LogRing::RecordHeader& Record, fmt::memory_buffer& Scratch)
+		{
+			std::shared_ptr<spdlog::logger>& pLogger = Logger::GetCoreLogger();
+			if (!pLogger)
+				return;
+
+			const LogSite& Site = *Record.pSite;
+			const uint8_t* pPayload = reinterpret_cast<const uint8_t*>(&Record + 1);
+
+			Scratch.clear();
+			FormatLogPayload(Site.Format.load(std::memory_order_relaxed), pPayload, Record.PayloadSize, Record.NumArgs, Record.Flags, Scratch);
+
+			const spdlog::log_clock::time_point Time(std::chrono::duration_cast<spdlog::log_clock::duration>(std::chrono::nanoseconds(Record.Timestamp)));
+			pLogger->log(Time, spdlog::source_loc{ Site.File, static_cast<int>(Site.Line), "" }, ToSpdlogLevel(static_cast<LogSeverity>(Record.Severity)),
+				spdlog::string_view_t(Scratch.data(), Scratch.size()));
+		}
+
+		void AsyncLogger::WriteRecordBinary(const LogRing& Ring, const LogRing::RecordHeader& Record)
+		{
+			const LogSite& Site = *Record.pSite;
+
+			// Sites are described once, the first time they appear in the file.
+			auto Iter = m_BinarySiteIds.find(&Site);
+			if (Iter == m_BinarySiteIds.end())
+			{
+				const uint32_t SiteId = static_cast<uint32_t>(m_BinarySiteIds.size());
+				Iter = m_BinarySiteIds.emplace(&Site, SiteId).first;
+
+				const char* pFormat = Site.Format.load(std::memory_order_relaxed);
+				BinaryLogSiteHeader SiteHeader = {};
+				SiteHeader.SiteId = SiteId;
+				SiteHeader.Line = Site.Line;
+				SiteHeader.FileLength = static_cast<uint32_t>(strlen(Site.File));
+				SiteHeader.FormatLength = pFormat ? static_cast<uint32_t>(strlen(pFormat)) : 0u;
+
+				fputc(BinaryLogChunk_Site, m_pBinaryLogFile);
+				fwrite(&SiteHeader, sizeof(BinaryLogSiteHeader), 1, m_pBinaryLogFile);
+				fwrite(Site.File, 1, SiteHeader.FileLength, m_pBinaryLogFile);
+				if (pFormat)
+					fwrite(pFormat, 1, SiteHeader.FormatLength, m_pBinaryLogFile);
+			}
+
+			BinaryLogRecordHeader RecordHeader = {};
+			RecordHeader.SiteId = Iter->second;
+			RecordHeader.ThreadId = Ring.GetThreadId();
+			RecordHeader.Timestamp = Record.Timestamp;
+			RecordHeader.PayloadSize = Record.PayloadSize;
+			RecordHeader.Severity = Record.Severity;
+			RecordHeader.NumArgs = Record.NumArgs;
+			RecordHeader.Flags = Record.Flags;
+
+			fputc(BinaryLogChunk_Record, m_pBinaryLogFile);
+			fwrite(&RecordHeader, sizeof(BinaryLogRecordHeader), 1, m_pBinaryLogFile);
+			fwrite(&Record + 1, 1, Record.PayloadSize, m_pBinaryLogFile);
+		}
+
+	} // end namespace Debug
+} // end namespace Insight
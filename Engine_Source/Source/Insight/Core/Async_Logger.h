@@ -0,0 +1,261 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Async_Logger.h
+	Source - Async_Logger.cpp
+
+	Purpose:
+	Low latency logging backend behind IE_DEBUG_LOG.
+
+	Description:
+	Every IE_DEBUG_LOG expansion owns a static LogSite holding the data that never changes
+	between calls (file, line and the format string when it is a literal). Logging copies only
+	the raw arguments (see Log_Codec.h) into a lock-free ring owned by the calling thread. A
+	background thread drains every ring, orders the records by timestamp, formats them and
+	hands them to spdlog. Optionally the raw records are also streamed to a binary log file
+	that can be turned into text later with the Log_Decoder tool.
+
+	If a thread's ring is full Log and Verbose messages are dropped (and counted), Warnings and
+	above wait for space. Critical messages flush the logger before returning.
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+#include "Insight/Core/Log_Codec.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <condition_variable>
+#include <unordered_map>
+
+namespace Insight {
+
+	namespace Debug {
+
+		// Static metadata for a single IE_DEBUG_LOG call site.
+		struct LogSite
+		{
+			// Constexpr so function local sites are constant initialized and need no guard.
+			constexpr LogSite(const char* pFile, uint32_t LineNumber)
+				: File(pFile), Line(LineNumber), Format(nullptr) {}
+
+			const char* File;
+			uint32_t Line;
+			// Set the first time the site logs with a string literal format. Null for dynamic formats.
+			std::atomic<const char*> Format;
+		};
+
+		// Single producer, single consumer byte ring. The producer is the thread that owns it, the consumer the logger thread.
+		class LogRing
+		{
+		public:
+			static constexpr uint32_t Capacity = 256u * 1024u;
+
+			// Header of a record inside of the ring. Followed by the encoded arguments.
+			struct RecordHeader
+			{
+				// Total size of the record including the header, 8 byte aligned. 0 marks a wrap to the start of the ring.
+				uint32_t TotalSize;
+				uint32_t PayloadSize;
+				const LogSite* pSite;
+				uint64_t Timestamp;
+				uint8_t Severity;
+				uint8_t NumArgs;
+				uint8_t Flags;
+			};
+
+		public:
+			LogRing(uint32_t ThreadId);
+			~LogRing() = default;
+
+			// Returns true if a record with the payload size can ever fit in a ring.
+			static inline bool CanFit(uint32_t PayloadSize) { return sizeof(RecordHeader) + PayloadSize <= Capacity / 4u; }
+			// Producer: Reserve contiguous space for a record. Returns nullptr if the ring is full.
+			RecordHeader* TryReserve(uint32_t PayloadSize);
+			// Producer: Publish the most recently reserved record.
+			void Commit(RecordHeader* pRecord);
+
+			// Consumer: Invoke Func for every published record without releasing them.
+			template <typename Fn>
+			uint64_t Peek(Fn&& Func) const;
+			// Consumer: Release every record up to the position returned from Peek.
+			inline void Release(uint64_t ReadPosition) { m_ReadPosition.store(ReadPosition, std::memory_order_release); }
+
+			inline bool IsEmpty() const { return m_ReadPosition.load(std::memory_order_acquire) == m_WritePosition.load(std::memory_order_acquire); }
+			inline uint32_t GetThreadId() const { return m_ThreadId; }
+
+			// Set when the owning thread exits. The logger frees the ring once it has been drained.
+			std::atomic<bool> Retired = false;
+			// Number of messages dropped because the ring was full.
+			std::atomic<uint32_t> NumDropped = 0u;
+
+		private:
+			static constexpr uint32_t Mask = Capacity - 1u;
+			static_assert((Capacity & Mask) == 0u, "LogRing capacity must be a power of two.");
+
+			std::unique_ptr<uint8_t[]> m_pBuffer;
+			uint32_t m_ThreadId;
+			uint64_t m_PendingWritePosition = 0u;
+			alignas(64) std::atomic<uint64_t> m_WritePosition = 0u;
+			alignas(64) std::atomic<uint64_t> m_ReadPosition = 0u;
+		};
+
+		class INSIGHT_API AsyncLogger
+		{
+		public:
+			AsyncLogger() = default;
+			~AsyncLogger();
+
+			static AsyncLogger& Get() { return s_Instance; }
+
+			// Start the background thread. Messages logged before this are buffered.
+			void Start();
+			// Drain every ring and stop the background thread.
+			void Stop();
+			// Block until everything logged so far by any thread has been written.
+			void Flush();
+
+			/*
+				Stream raw log records to a binary file in addition to the console.
+				@param FilePath: File to write. Decode it with Tools/Log_Decoder.
+			*/
+			bool OpenBinaryLog(const std::string& FilePath);
+			void CloseBinaryLog();
+
+			/*
+				Copy the log arguments into the calling thread's ring.
+				@param Site: The static log site.
+				@param Format: The site's format. Const char arrays (string literals) are stored on the site, anything else is copied into the record.
+			*/
+			template <typename FormatType, typename ... Args>
+			void Write(LogSite& Site, LogSeverity Severity, FormatType&& Format, const Args& ... Arguments);
+
+		private:
+			struct PendingRecord
+			{
+				uint64_t Timestamp;
+				const LogRing* pRing;
+				const LogRing::RecordHeader* pRecord;
+			};
+
+			template <typename ... Prepared>
+			void WriteRecord(const LogSite& Site, LogSeverity Severity, uint8_t Flags, const Prepared& ... Arguments);
+
+			LogRing& GetThreadRing();
+			void ConsumerThread();
+			// Drain every ring once. Returns the number of records written.
+			uint32_t Drain();
+			void WriteRecordText(const LogRing::RecordHeader& Record, fmt::memory_buffer& Scratch);
+			void WriteRecordBinary(const LogRing& Ring, const LogRing::RecordHeader& Record);
+
+			static uint64_t GetTimestamp();
+
+		private:
+			std::mutex m_RingsMutex;
+			std::vector<std::shared_ptr<LogRing>> m_Rings;
+			std::atomic<uint32_t> m_NextThreadId = 0u;
+
+			std::thread m_ConsumerThread;
+			std::atomic<bool> m_Running = false;
+
+			// Flush requests are counted so waiting threads can tell when a full drain has passed.
+			std::mutex m_FlushMutex;
+			std::condition_variable m_FlushCondition;
+			uint64_t m_FlushRequested = 0u;
+			uint64_t m_FlushCompleted = 0u;
+
+			// Consumer thread only. Kept between drains to avoid reallocating.
+			std::vector<PendingRecord> m_PendingRecords;
+			std::vector<std::shared_ptr<LogRing>> m_DrainRings;
+			std::vector<uint64_t> m_DrainReadPositions;
+			fmt::memory_buffer m_FormatScratch;
+			FILE* m_pBinaryLogFile = nullptr;
+			std::mutex m_BinaryLogMutex;
+			std::unordered_map<const LogSite*, uint32_t> m_BinarySiteIds;
+
+			// Defined in Log.cpp after the spdlog loggers so it is destroyed (and drained) before them.
+			static AsyncLogger s_Instance;
+		};
+
+
+		template <typename Fn>
+		uint64_t LogRing::Peek(Fn&& Func) const
+		{
+			uint64_t Read = m_ReadPosition.load(std::memory_order_relaxed);
+			const uint64_t Write = m_WritePosition.load(std::memory_order_acquire);
+			while (Read < Write)
+			{
+				const uint32_t Offset = static_cast<uint32_t>(Read & Mask);
+				const RecordHeader* pRecord = reinterpret_cast<const RecordHeader*>(m_pBuffer.get() + Offset);
+				if (pRecord->TotalSize == 0u)
+				{
+					Read += Capacity - Offset;
+					continue;
+				}
+				Func(*pRecord);
+				Read += pRecord->TotalSize;
+			}
+			return Read;
+		}
+
+		template <typename FormatType, typename ... Args>
+		void AsyncLogger::Write(LogSite& Site, LogSeverity Severity, FormatType&& Format, const Args& ... Arguments)
+		{
+			using FormatArray = std::remove_reference_t<FormatType>;
+			if constexpr (std::is_array<FormatArray>::value && std::is_const<std::remove_extent_t<FormatArray>>::value)
+			{
+				// String literal. Same pointer every call, so it lives on the site instead of in the record.
+				if (!Site.Format.load(std::memory_order_relaxed))
+					Site.Format.store(Format, std::memory_order_relaxed);
+				WriteRecord(Site, Severity, 0u, PrepareLogArg(Arguments)...);
+			}
+			else
+			{
+				WriteRecord(Site, Severity, LogRecordFlag_DynamicFormat, PrepareLogArg(Format), PrepareLogArg(Arguments)...);
+			}
+		}
+
+		template <typename ... Prepared>
+		void AsyncLogger::WriteRecord(const LogSite& Site, LogSeverity Severity, uint8_t Flags, const Prepared& ... Arguments)
+		{
+			static_assert(sizeof...(Prepared) < 256, "Too many log arguments.");
+
+			const uint32_t PayloadSize = (0u + ... + GetEncodedLogArgSize(Arguments));
+			LogRing& Ring = GetThreadRing();
+			if (!LogRing::CanFit(PayloadSize))
+			{
+				Ring.NumDropped.fetch_add(1u, std::memory_order_relaxed);
+				return;
+			}
+
+			LogRing::RecordHeader* pRecord = Ring.TryReserve(PayloadSize);
+			while (!pRecord)
+			{
+				// Don't lose warnings or errors. Wait for the logger thread to make room.
+				if (Severity < LogSeverity::Warning || !m_Running.load(std::memory_order_relaxed))
+				{
+					Ring.NumDropped.fetch_add(1u, std::memory_order_relaxed);
+					return;
+				}
+				std::this_thread::yield();
+				pRecord = Ring.TryReserve(PayloadSize);
+			}
+
+			pRecord->PayloadSize = PayloadSize;
+			pRecord->pSite = &Site;
+			pRecord->Timestamp = GetTimestamp();
+			pRecord->Severity = static_cast<uint8_t>(Severity);
+			pRecord->NumArgs = static_cast<uint8_t>(sizeof...(Prepared));
+			pRecord->Flags = Flags;
+
+			uint8_t* pWrite = reinterpret_cast<uint8_t*>(pRecord + 1);
+			((pWrite = EncodeLogArg(pWrite, Arguments)), ...);
+			Ring.Commit(pRecord);
+		}
+
+	} // end namespace Debug
+} // end namespace Insight
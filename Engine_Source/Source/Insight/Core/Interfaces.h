@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Insight/Core/Scene/Actor_Guid.h"
+
 namespace Insight {
 
 	namespace Runtime {
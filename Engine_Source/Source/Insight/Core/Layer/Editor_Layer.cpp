@@ -69,13 +69,22 @@ namespace Insight {
 		UI::EndWindow();
 	}
 
+	void EditorLayer::SetSelectedActor(Runtime::AActor* actor)
+	{
+		m_SelectedActor = ActorRef(actor);
+	}
+
 	void EditorLayer::RenderInspector()
 	{
 		UI::BeginWindow("Details");
 		{
-			if (m_pSelectedActor != nullptr) {
+			if (Runtime::AActor* pSelectedActor = m_SelectedActor.Get()) {
+
+				pSelectedActor->OnImGuiRender();
 
-				m_pSelectedActor->OnImGuiRender();
+				// Properties edited in the panel are written out with the actor's next incremental save.
+				if (UI::IsAnyItemActive())
+					pSelectedActor->MarkDirtyForSave();
 			}
 		}
 		UI::EndWindow();
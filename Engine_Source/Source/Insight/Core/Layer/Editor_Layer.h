@@ -8,6 +8,7 @@
 
 #include "Insight/Physics/Ray.h"
 #include "Insight/Math/ie_Vectors.h"
+#include "Insight/Core/Scene/Actor_Registry.h"
 
 namespace Insight {
 
@@ -38,8 +39,9 @@ namespace Insight {
 		void OnEvent(Event& event) override;
 
 		inline void SetUIEnabled(bool Enabled) { m_UIEnabled = Enabled; }
-		void SetSelectedActor(Runtime::AActor* actor) { m_pSelectedActor = actor; }
-		Runtime::AActor* GetSelectedActor() { return m_pSelectedActor; }
+		void SetSelectedActor(Runtime::AActor* actor);
+		// Returns null if nothing is selected or the selected actor has been destroyed.
+		Runtime::AActor* GetSelectedActor() { return m_SelectedActor.Get(); }
 
 	private:
 		void RenderSceneHeirarchy();
@@ -47,7 +49,7 @@ namespace Insight {
 		void RenderSelectionGizmo();
 		void RenderCreatorWindow();
 	private:
-		Runtime::AActor*		m_pSelectedActor = nullptr;
+		ActorRef				m_SelectedActor;
 		SceneNode*				m_pSceneRootRef = nullptr;
 		Runtime::ACamera*		m_pSceneCameraRef = nullptr;
 		Scene*					m_pCurrentSceneRef = nullptr;
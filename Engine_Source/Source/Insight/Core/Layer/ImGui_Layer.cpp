@@ -2,6 +2,7 @@
 
 #include "ImGui_Layer.h"
 #include "Insight/Core/Application.h"
+#include "Insight/Memory/Memory_Tracker.h"
 
 #if defined (IE_PLATFORM_BUILD_WIN32)
 #include "imgui.h"
@@ -26,6 +27,12 @@ namespace Insight {
 	{
 #if defined (IE_PLATFORM_BUILD_WIN32)
 		IMGUI_CHECKVERSION();
+#if defined (IE_MEMORY_TRACKING_ENABLED)
+		// ImGui allocates with malloc by default, route it through operator new so it shows up under the UI tag.
+		ImGui::SetAllocatorFunctions(
+			[](size_t Size, void*) -> void* { IE_MEMORY_TAG(UI); return ::operator new(Size); },
+			[](void* pMemory, void*) { ::operator delete(pMemory); });
+#endif
 		m_pIO = new ImGuiIO();
 		ImGui::CreateContext();
 		ImGuiIO& io = ImGui::GetIO(); (void)io;
@@ -5,6 +5,7 @@
 
 #include "Insight/Systems/Frame_Timer.h"
 #include "Insight/Rendering/Renderer.h"
+#include "Insight/Memory/Memory_Tracker.h"
 
 namespace Insight {
 
@@ -22,8 +23,21 @@ namespace Insight {
 		virtual void OnUpdate(const float DeltaMs) override
 		{
 			m_FrameTimer.Tick();
-			char OutputBuffer[256];
-			sprintf_s(OutputBuffer, "FPS: %f\nFrame Time: %fms", GetFPS(), GetFrameTime());
+			char OutputBuffer[1024];
+			int Length = sprintf_s(OutputBuffer, "FPS: %f\nFrame Time: %fms", GetFPS(), GetFrameTime());
+
+			if (Memory::MemoryTracker::IsEnabled())
+			{
+				Memory::MemoryTagStats TagStats[Memory::NumMemoryTags];
+				Memory::MemoryTracker::GetAllTagStats(TagStats);
+				for (uint32_t i = 0; i < Memory::NumMemoryTags && Length > 0; ++i)
+				{
+					Length += sprintf_s(OutputBuffer + Length, sizeof(OutputBuffer) - Length, "\n%s: %.2fMB (Peak %.2fMB) %llu allocs/frame",
+						Memory::GetMemoryTagName(static_cast<Memory::MemoryTag>(i)),
+						static_cast<float>(TagStats[i].LiveBytes) / (1024.0f * 1024.0f), static_cast<float>(TagStats[i].PeakBytes) / (1024.0f * 1024.0f),
+						static_cast<unsigned long long>(TagStats[i].FrameAllocations));
+				}
+			}
 			Renderer::DrawText(OutputBuffer);
 		}
 
@@ -10,6 +10,8 @@ namespace Insight {
 
 		std::shared_ptr<spdlog::logger> Logger::s_CoreLogger;
 		std::shared_ptr<spdlog::logger> Logger::s_ClientLogger;
+		// Must be defined after the loggers it writes to so it is destroyed first.
+		AsyncLogger AsyncLogger::s_Instance;
 #if defined IE_DEBUG && defined (IE_PLATFORM_BUILD_WIN32)
 		ConsoleWindow Logger::m_ConsoleWindow;
 #endif
@@ -23,9 +25,17 @@ namespace Insight {
 			s_ClientLogger = spdlog::stdout_color_mt("App");
 			s_ClientLogger->set_level(spdlog::level::trace);
 
+			AsyncLogger::Get().Start();
+
 			return true;
 		}
 
+		void Logger::Shutdown()
+		{
+			AsyncLogger::Get().CloseBinaryLog();
+			AsyncLogger::Get().Stop();
+		}
+
 	}
 }
 
@@ -9,6 +9,8 @@
 #include "spdlog/spdlog.h"
 #include "spdlog/fmt/ostr.h"
 
+#include "Insight/Core/Async_Logger.h"
+
 namespace Insight {
 
 	namespace Debug {
@@ -18,6 +20,8 @@ namespace Insight {
 		{
 		public:
 			static bool Init();
+			// Write any pending messages and stop the logging thread.
+			static void Shutdown();
 			~Logger() { }
 
 			inline static void HoldForUserInput() { system("PAUSE"); }
@@ -37,43 +41,19 @@ namespace Insight {
 
 }
 
-enum class LogSeverity
-{
-	Log,
-	Verbose,
-	Warning,
-	Error,
-	Critical,
-};
-
 namespace Debug {
 
 	// Logger that will log output to the console window. Recommended that you dont call directly. 
-	// Instead, use IE_DEBUG_LOG so logs will be stripped from release builds.
-	template <typename ... LogContents>
-	inline constexpr void Log(LogSeverity Severity = LogSeverity::Log, LogContents ... Contents)
+	// Instead, use IE_DEBUG_LOG so logs will be stripped from release builds and the call site is registered.
+	// Arguments are copied and formatted later on the logging thread.
+	template <typename FormatType, typename ... LogContents>
+	inline void Log(Insight::Debug::LogSite& Site, LogSeverity Severity, FormatType&& Format, const LogContents& ... Contents)
 	{
-		switch (Severity)
-		{
-		case LogSeverity::Log:
-			Insight::Debug::Logger::GetCoreLogger()->info(Contents...);
-			break;
-		case LogSeverity::Verbose:
-			Insight::Debug::Logger::GetCoreLogger()->trace(Contents...);
-			break;
-		case LogSeverity::Warning:
-			Insight::Debug::Logger::GetCoreLogger()->warn(Contents...);
-			break;
-		case LogSeverity::Error:
-			Insight::Debug::Logger::GetCoreLogger()->error(Contents...);
-			break;
-		case LogSeverity::Critical:
-			Insight::Debug::Logger::GetCoreLogger()->critical(Contents...);
-			break;
-		default:
-			Insight::Debug::Logger::GetCoreLogger()->warn("Invalid log severity given to logger. Choose one option from Log::LogSeverity enum.");
-			break;
-		}
+		Insight::Debug::AsyncLogger::Get().Write(Site, Severity, std::forward<FormatType>(Format), Contents...);
+
+		// Make sure critical messages make it out before a possible crash.
+		if (Severity == LogSeverity::Critical)
+			Insight::Debug::AsyncLogger::Get().Flush();
 	}
 }
 
@@ -81,7 +61,7 @@ namespace Debug {
 #if defined (IE_DEBUG) || defined (IE_RELEASE)
 	#define IE_FATAL_ERROR(...) __debugbreak(); OutputDebugString(__VA_ARGS__)
 	#if defined (IE_PLATFORM_BUILD_WIN32)
-		#define IE_DEBUG_LOG(Severity, ...) ::Debug::Log(Severity, __VA_ARGS__);
+		#define IE_DEBUG_LOG(Severity, ...) { static ::Insight::Debug::LogSite IE_LogSite(__FILE__, __LINE__); ::Debug::Log(IE_LogSite, Severity, __VA_ARGS__); }
 	#elif defined (IE_PLATFORM_BUILD_UWP)
 		#define WIDE_STRING(...) L#__VA_ARGS__
 		#define IE_DEBUG_LOG(Severity, ...) {wchar_t Buffer[512]; swprintf(Buffer, sizeof(Buffer), WIDE_STRING(__VA_ARGS__)); OutputDebugString(Buffer);}
@@ -0,0 +1,297 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Log_Codec.h
+
+	Purpose:
+	Raw argument encoding shared by the asynchronous logger and the binary log decoder tool.
+
+	Description:
+	Log arguments are copied into a self describing byte payload instead of being formatted on
+	the calling thread. Each argument is a one byte type tag followed by its value. Arithmetic
+	values are widened to 64 bits, strings are copied with a length prefix and anything else is
+	formatted to a string up front (the slow path, avoid in hot code). The payload is turned back
+	into text later by FormatLogPayload, either by the logger's background thread or by the
+	Log_Decoder tool reading a binary log file.
+
+	This header only depends on the standard library and the fmt library bundled with spdlog.
+
+	Binary log file layout (little endian):
+		BinaryLogFileHeader
+		[BinaryLogChunk_Site, BinaryLogSiteHeader, File, Format] or
+		[BinaryLogChunk_Record, BinaryLogRecordHeader, Payload] ...
+*/
+#pragma once
+
+#include <spdlog/fmt/fmt.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+enum class LogSeverity
+{
+	Log,
+	Verbose,
+	Warning,
+	Error,
+	Critical,
+};
+
+namespace Insight {
+
+	namespace Debug {
+
+		enum class LogArgType : uint8_t
+		{
+			Signed,
+			Unsigned,
+			Float,
+			Bool,
+			Char,
+			String,
+			Pointer,
+		};
+
+		// Longest string argument copied into a record. Longer strings are truncated.
+		constexpr uint32_t MaxLogStringArgLength = 8192u;
+
+		// The record's first argument is the format string (the log site format was not a literal).
+		constexpr uint8_t LogRecordFlag_DynamicFormat = 1u << 0;
+
+		constexpr uint32_t BinaryLogMagic = 0x474C4549u; // "IELG" when read as bytes.
+		constexpr uint32_t BinaryLogVersion = 1u;
+
+		enum BinaryLogChunk : uint8_t
+		{
+			BinaryLogChunk_Site = 'S',
+			BinaryLogChunk_Record = 'R',
+		};
+
+#pragma pack(push, 1)
+		struct BinaryLogFileHeader
+		{
+			uint32_t Magic;
+			uint32_t Version;
+		};
+		// Written once, the first time a log site is seen. Followed by FileLength + FormatLength characters.
+		struct BinaryLogSiteHeader
+		{
+			uint32_t SiteId;
+			uint32_t Line;
+			uint32_t FileLength;
+			uint32_t FormatLength;
+		};
+		// Followed by PayloadSize bytes of encoded arguments.
+		struct BinaryLogRecordHeader
+		{
+			uint32_t SiteId;
+			uint32_t ThreadId;
+			// Nanoseconds since the system clock epoch.
+			uint64_t Timestamp;
+			uint32_t PayloadSize;
+			uint8_t Severity;
+			uint8_t NumArgs;
+			uint8_t Flags;
+			uint8_t Reserved;
+		};
+#pragma pack(pop)
+
+
+		// Argument preparation
+		// --------------------
+		// Every argument is reduced to one of the encodable types before it is sized and written.
+
+		template <typename T>
+		struct IsLogCStringType : std::integral_constant<bool, std::is_same<T, const char*>::value || std::is_same<T, char*>::value> {};
+
+		template <typename T>
+		inline auto PrepareLogArg(const T& Value)
+		{
+			using Type = std::decay_t<T>;
+			if constexpr (std::is_same<Type, bool>::value || std::is_same<Type, char>::value)
+				return Value;
+			else if constexpr (std::is_enum<Type>::value)
+				return static_cast<std::underlying_type_t<Type>>(Value);
+			else if constexpr (std::is_arithmetic<Type>::value)
+				return Value;
+			else if constexpr (IsLogCStringType<Type>::value)
+				return Value ? std::string_view(Value) : std::string_view("(null)");
+			else if constexpr (std::is_pointer<Type>::value)
+				return static_cast<const void*>(Value);
+			else
+				return fmt::format("{}", Value);
+		}
+		inline std::string_view PrepareLogArg(const std::string& Value) { return std::string_view(Value); }
+		inline std::string_view PrepareLogArg(std::string_view Value) { return Value; }
+		template <size_t N>
+		inline std::string_view PrepareLogArg(const char(&Value)[N]) { return std::string_view(Value, strnlen(Value, N)); }
+
+
+		// Encoding
+		// --------
+
+		template <typename T>
+		constexpr LogArgType GetLogArgType()
+		{
+			if constexpr (std::is_same<T, bool>::value)					return LogArgType::Bool;
+			else if constexpr (std::is_same<T, char>::value)			return LogArgType::Char;
+			else if constexpr (std::is_floating_point<T>::value)		return LogArgType::Float;
+			else if constexpr (std::is_signed<T>::value)				return LogArgType::Signed;
+			else if constexpr (std::is_unsigned<T>::value)				return LogArgType::Unsigned;
+			else if constexpr (std::is_same<T, const void*>::value)		return LogArgType::Pointer;
+			else														return LogArgType::String;
+		}
+
+		inline uint32_t GetLogStringLength(std::string_view Value) { return static_cast<uint32_t>(Value.size() < MaxLogStringArgLength ? Value.size() : MaxLogStringArgLength); }
+
+		template <typename T>
+		inline uint32_t GetEncodedLogArgSize(const T& Value)
+		{
+			constexpr LogArgType Type = GetLogArgType<T>();
+			if constexpr (Type == LogArgType::String)
+				return 1u + sizeof(uint32_t) + GetLogStringLength(Value);
+			else if constexpr (Type == LogArgType::Bool || Type == LogArgType::Char)
+				return 1u + 1u;
+			else
+				return 1u + 8u;
+		}
+
+		template <typename T>
+		inline uint8_t* EncodeLogArg(uint8_t* pDest, const T& Value)
+		{
+			constexpr LogArgType Type = GetLogArgType<T>();
+			*pDest++ = static_cast<uint8_t>(Type);
+
+			if constexpr (Type == LogArgType::String)
+			{
+				const uint32_t Length = GetLogStringLength(Value);
+				memcpy(pDest, &Length, sizeof(uint32_t));
+				memcpy(pDest + sizeof(uint32_t), Value.data(), Length);
+				return pDest + sizeof(uint32_t) + Length;
+			}
+			else if constexpr (Type == LogArgType::Bool || Type == LogArgType::Char)
+			{
+				*pDest = static_cast<uint8_t>(Value);
+				return pDest + 1;
+			}
+			else
+			{
+				if constexpr (Type == LogArgType::Float)
+				{
+					const double Wide = static_cast<double>(Value);
+					memcpy(pDest, &Wide, 8);
+				}
+				else if constexpr (Type == LogArgType::Signed)
+				{
+					const int64_t Wide = static_cast<int64_t>(Value);
+					memcpy(pDest, &Wide, 8);
+				}
+				else if constexpr (Type == LogArgType::Unsigned)
+				{
+					const uint64_t Wide = static_cast<uint64_t>(Value);
+					memcpy(pDest, &Wide, 8);
+				}
+				else
+				{
+					const uint64_t Wide = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(Value));
+					memcpy(pDest, &Wide, 8);
+				}
+				return pDest + 8;
+			}
+		}
+
+
+		// Decoding
+		// --------
+
+		/*
+			Format an encoded payload into a buffer.
+			@param Format: The log site format string. Ignored if the record has LogRecordFlag_DynamicFormat.
+			@param pPayload: The encoded arguments.
+			@param PayloadSize: Size of pPayload in bytes.
+			@param NumArgs: Number of encoded arguments (including the dynamic format string if there is one).
+			@param Flags: The record's LogRecordFlag_* flags.
+			@param Out: Buffer to append the formatted message to.
+			Returns false if the payload is malformed. Out will still contain a best effort message.
+		*/
+		inline bool FormatLogPayload(const char* Format, const uint8_t* pPayload, uint32_t PayloadSize, uint8_t NumArgs, uint8_t Flags, fmt::memory_buffer& Out)
+		{
+			fmt::dynamic_format_arg_store<fmt::format_context> Store;
+			fmt::string_view FormatView(Format ? Format : "");
+
+			const uint8_t* pRead = pPayload;
+			const uint8_t* pEnd = pPayload + PayloadSize;
+			bool Valid = true;
+			for (uint8_t i = 0; i < NumArgs && Valid; ++i)
+			{
+				if (pRead >= pEnd) { Valid = false; break; }
+
+				const LogArgType Type = static_cast<LogArgType>(*pRead++);
+				switch (Type)
+				{
+				case LogArgType::Bool:
+				case LogArgType::Char:
+				{
+					if (pRead + 1 > pEnd) { Valid = false; break; }
+					if (Type == LogArgType::Bool)	Store.push_back(*pRead != 0);
+					else							Store.push_back(static_cast<char>(*pRead));
+					pRead += 1;
+					break;
+				}
+				case LogArgType::Signed:
+				case LogArgType::Unsigned:
+				case LogArgType::Float:
+				case LogArgType::Pointer:
+				{
+					if (pRead + 8 > pEnd) { Valid = false; break; }
+					uint64_t Bits = 0;
+					memcpy(&Bits, pRead, 8);
+					pRead += 8;
+
+					if (Type == LogArgType::Signed)			Store.push_back(static_cast<int64_t>(Bits));
+					else if (Type == LogArgType::Unsigned)	Store.push_back(Bits);
+					else if (Type == LogArgType::Float)		{ double Value; memcpy(&Value, &Bits, 8); Store.push_back(Value); }
+					else									Store.push_back(reinterpret_cast<const void*>(static_cast<uintptr_t>(Bits)));
+					break;
+				}
+				case LogArgType::String:
+				{
+					uint32_t Length = 0;
+					if (pRead + sizeof(uint32_t) > pEnd) { Valid = false; break; }
+					memcpy(&Length, pRead, sizeof(uint32_t));
+					pRead += sizeof(uint32_t);
+					if (pRead + Length > pEnd) { Valid = false; break; }
+
+					const fmt::string_view Value(reinterpret_cast<const char*>(pRead), Length);
+					pRead += Length;
+					if (i == 0 && (Flags & LogRecordFlag_DynamicFormat))
+						FormatView = Value;
+					else
+						Store.push_back(Value);
+					break;
+				}
+				default:
+					Valid = false;
+					break;
+				}
+			}
+
+			const size_t StartSize = Out.size();
+			try
+			{
+				fmt::vformat_to(Out, FormatView, fmt::format_args(Store));
+			}
+			catch (const fmt::format_error& Error)
+			{
+				// Fall back to the raw format string so the message is not lost.
+				Out.resize(StartSize);
+				fmt::format_to(Out, "{} [{}]", FormatView, Error.what());
+				Valid = false;
+			}
+			return Valid;
+		}
+
+	} // end namespace Debug
+} // end namespace Insight
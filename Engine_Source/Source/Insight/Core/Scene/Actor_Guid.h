@@ -0,0 +1,57 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Actor_Guid.h
+
+	Purpose:
+	The persistent actor GUID type and its text form, for code that reads or writes GUIDs without
+	needing actors or the ActorRegistry (Ex. the json stream readers compiled into the Pak_Builder).
+
+	Description:
+	A GUID is saved as 16 lower case hex digits. See ActorRegistry for how GUIDs are handed out and resolved.
+*/
+#pragma once
+
+#include <cstdio>
+#include <cstdint>
+#include <string>
+
+namespace Insight {
+
+	// Persistent identity of an actor, saved with its scene. See ActorRegistry.
+	typedef uint64_t ActorGuid;
+
+	const ActorGuid INVALID_ACTOR_GUID = 0;
+
+	// 16 lower case hex digits, how GUIDs are saved.
+	inline std::string ActorGuidToString(ActorGuid Guid)
+	{
+		char Hex[17];
+		snprintf(Hex, sizeof(Hex), "%016llx", static_cast<unsigned long long>(Guid));
+		return Hex;
+	}
+
+	// Returns INVALID_ACTOR_GUID if the string is not a GUID.
+	inline ActorGuid ActorGuidFromString(const char* String, size_t Length)
+	{
+		if (Length == 0u || Length > 16u)
+			return INVALID_ACTOR_GUID;
+
+		ActorGuid Guid = 0u;
+		for (size_t i = 0u; i < Length; ++i)
+		{
+			const char Char = String[i];
+			uint64_t Digit = 0u;
+			if (Char >= '0' && Char <= '9')
+				Digit = static_cast<uint64_t>(Char - '0');
+			else if (Char >= 'a' && Char <= 'f')
+				Digit = static_cast<uint64_t>(Char - 'a' + 10);
+			else if (Char >= 'A' && Char <= 'F')
+				Digit = static_cast<uint64_t>(Char - 'A' + 10);
+			else
+				return INVALID_ACTOR_GUID;
+			Guid = (Guid << 4u) | Digit;
+		}
+		return Guid;
+	}
+
+}
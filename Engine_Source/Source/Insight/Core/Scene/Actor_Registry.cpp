@@ -0,0 +1,165 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Actor_Registry.h"
+
+#include "Insight/Runtime/AActor.h"
+
+#include <chrono>
+#include <random>
+
+namespace Insight {
+
+	ActorRegistry ActorRegistry::s_Instance;
+
+	static constexpr uint32_t InitialNumBuckets = 1024u;
+
+	ActorRegistry::ActorRegistry()
+	{
+		m_Buckets.resize(InitialNumBuckets, Bucket{ INVALID_ACTOR_GUID, InvalidSlot });
+	}
+
+	ActorGuid ActorRegistry::NewGuid()
+	{
+		thread_local std::mt19937_64 Generator = []()
+		{
+			std::random_device Device;
+			const uint64_t Time = static_cast<uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+			std::seed_seq Seed{ Device(), Device(), static_cast<uint32_t>(Time), static_cast<uint32_t>(Time >> 32u) };
+			return std::mt19937_64(Seed);
+		}();
+
+		ActorGuid Guid = INVALID_ACTOR_GUID;
+		while (Guid == INVALID_ACTOR_GUID)
+			Guid = Generator();
+		return Guid;
+	}
+
+	uint32_t ActorRegistry::FindBucket(ActorGuid Guid) const
+	{
+		const uint32_t Mask = static_cast<uint32_t>(m_Buckets.size()) - 1u;
+		uint32_t Index = static_cast<uint32_t>(MixGuid(Guid)) & Mask;
+		while (m_Buckets[Index].Guid != INVALID_ACTOR_GUID && m_Buckets[Index].Guid != Guid)
+			Index = (Index + 1u) & Mask;
+		return Index;
+	}
+
+	uint32_t ActorRegistry::Register(Runtime::AActor* pActor, ActorGuid Guid)
+	{
+		IE_ASSERT(Guid != INVALID_ACTOR_GUID, "Registering an actor without a GUID.");
+
+		// Grow before inserting so there is always an empty bucket to end a probe on.
+		if ((m_NumActors + 1u) * 4u > static_cast<uint32_t>(m_Buckets.size()) * 3u)
+			Grow();
+
+		const uint32_t BucketIndex = FindBucket(Guid);
+		if (m_Buckets[BucketIndex].Guid == Guid)
+			return InvalidSlot;
+
+		uint32_t SlotIndex = 0u;
+		if (!m_FreeSlots.empty())
+		{
+			SlotIndex = m_FreeSlots.back();
+			m_FreeSlots.pop_back();
+		}
+		else
+		{
+			SlotIndex = static_cast<uint32_t>(m_Slots.size());
+			m_Slots.push_back(Slot{ nullptr, INVALID_ACTOR_GUID, 0u });
+		}
+
+		m_Slots[SlotIndex].pActor = pActor;
+		m_Slots[SlotIndex].Guid = Guid;
+		m_Buckets[BucketIndex] = Bucket{ Guid, SlotIndex };
+		m_NumActors++;
+		return SlotIndex;
+	}
+
+	void ActorRegistry::Unregister(uint32_t SlotIndex)
+	{
+		if (SlotIndex >= m_Slots.size() || !m_Slots[SlotIndex].pActor)
+			return;
+
+		Slot& Freed = m_Slots[SlotIndex];
+		uint32_t Hole = FindBucket(Freed.Guid);
+		Freed.pActor = nullptr;
+		Freed.Guid = INVALID_ACTOR_GUID;
+		Freed.Generation++;
+		m_FreeSlots.push_back(SlotIndex);
+		m_NumActors--;
+
+		// Shift back every following entry that probed past the hole, so lookups never stop short of them.
+		const uint32_t Mask = static_cast<uint32_t>(m_Buckets.size()) - 1u;
+		uint32_t Index = Hole;
+		while (true)
+		{
+			Index = (Index + 1u) & Mask;
+			const Bucket& Next = m_Buckets[Index];
+			if (Next.Guid == INVALID_ACTOR_GUID)
+				break;
+
+			const uint32_t Home = static_cast<uint32_t>(MixGuid(Next.Guid)) & Mask;
+			// The entry can move into the hole if its home bucket is not between the hole and where it is now.
+			const bool CanMove = (Hole <= Index) ? (Home <= Hole || Home > Index) : (Home <= Hole && Home > Index);
+			if (CanMove)
+			{
+				m_Buckets[Hole] = Next;
+				Hole = Index;
+			}
+		}
+		m_Buckets[Hole] = Bucket{ INVALID_ACTOR_GUID, InvalidSlot };
+	}
+
+	void ActorRegistry::Grow()
+	{
+		std::vector<Bucket> Old(m_Buckets.size() * 2u, Bucket{ INVALID_ACTOR_GUID, InvalidSlot });
+		Old.swap(m_Buckets);
+		for (const Bucket& Entry : Old)
+		{
+			if (Entry.Guid != INVALID_ACTOR_GUID)
+				m_Buckets[FindBucket(Entry.Guid)] = Entry;
+		}
+	}
+
+	Runtime::AActor* ActorRegistry::Find(ActorGuid Guid) const
+	{
+		uint32_t SlotIndex = InvalidSlot, Generation = 0u;
+		return FindSlot(Guid, SlotIndex, Generation) ? m_Slots[SlotIndex].pActor : nullptr;
+	}
+
+	bool ActorRegistry::FindSlot(ActorGuid Guid, uint32_t& OutSlot, uint32_t& OutGeneration) const
+	{
+		if (Guid == INVALID_ACTOR_GUID)
+			return false;
+
+		const Bucket& Found = m_Buckets[FindBucket(Guid)];
+		if (Found.Guid != Guid)
+			return false;
+
+		OutSlot = Found.Slot;
+		OutGeneration = m_Slots[Found.Slot].Generation;
+		return true;
+	}
+
+	ActorRef::ActorRef(const Runtime::AActor* pActor)
+	{
+		if (!pActor)
+			return;
+
+		m_Guid = pActor->GetGuid();
+		ActorRegistry::Get().FindSlot(m_Guid, m_Slot, m_Generation);
+	}
+
+	Runtime::AActor* ActorRef::Get() const
+	{
+		const ActorRegistry& Registry = ActorRegistry::Get();
+		if (Runtime::AActor* pActor = Registry.GetSlotActor(m_Slot, m_Generation))
+			return pActor;
+
+		// The actor was destroyed, it may have been loaded again since.
+		if (!Registry.FindSlot(m_Guid, m_Slot, m_Generation))
+			return nullptr;
+		return Registry.GetSlotActor(m_Slot, m_Generation);
+	}
+
+}
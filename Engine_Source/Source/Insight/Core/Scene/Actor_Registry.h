@@ -0,0 +1,145 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Actor_Registry.h
+	Source - Actor_Registry.cpp
+
+	Purpose:
+	Finds actors by their persistent GUID in constant time and resolves references to them.
+
+	Description:
+	Every actor has a random 64 bit ActorGuid that is saved with it ("Guid" in Actors.json, the journal
+	and cooked world cells) and given back to it when its scene is loaded again. Actors saved before they
+	had one are given a new GUID on load and written out with it on the next save.
+	The registry holds every live actor of every loaded scene, including streamed world cells, so actors
+	can reference each other across scenes and cells. It is two flat arrays:
+	Slots	- One per live actor: the actor, its GUID and a generation that is bumped when the slot is freed.
+	Buckets	- Open addressing table from GUID to slot. Linear probing over 16 byte buckets, so a lookup is
+			  usually one cache line. Removal shifts the following entries back instead of leaving tombstones.
+	ActorRef is a weak reference that stores the GUID and caches the slot it resolved to. While the actor
+	lives Get is an array index and a generation compare. Once it is destroyed the ref resolves to null,
+	and if an actor with the same GUID comes back (Ex. the scene was reloaded or the cell streamed in
+	again) the ref finds it through the table and caches the new slot.
+	Actors register themselves when they are created and unregister when they are destroyed. The registry
+	is only used from the game thread, where actors are created and destroyed.
+
+	Example Usage:
+	ActorRef Target(pActor);
+	...
+	if (Runtime::AActor* pTarget = Target.Get()) { ... }
+	Runtime::AActor* pFound = ActorRegistry::Get().Find(Guid);
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+#include "Insight/Core/Interfaces.h"
+
+namespace Insight {
+
+	class INSIGHT_API ActorRegistry
+	{
+	public:
+		static constexpr uint32_t InvalidSlot = ~0u;
+
+	public:
+		ActorRegistry();
+		~ActorRegistry() = default;
+
+		ActorRegistry(const ActorRegistry&) = delete;
+		ActorRegistry& operator = (const ActorRegistry&) = delete;
+
+		static ActorRegistry& Get() { return s_Instance; }
+
+		// A new random GUID, never INVALID_ACTOR_GUID. Thread safe.
+		static ActorGuid NewGuid();
+		// See ActorGuidToString and ActorGuidFromString.
+		static std::string GuidToString(ActorGuid Guid) { return ActorGuidToString(Guid); }
+		static ActorGuid GuidFromString(const char* String, size_t Length) { return ActorGuidFromString(String, Length); }
+
+		/*
+			Add an actor under a GUID.
+			Returns the actor's slot, or InvalidSlot if another live actor already has the GUID.
+		*/
+		uint32_t Register(Runtime::AActor* pActor, ActorGuid Guid);
+		// Remove the actor in a slot. References to it resolve to null from now on.
+		void Unregister(uint32_t Slot);
+
+		// Returns null if no live actor has the GUID.
+		Runtime::AActor* Find(ActorGuid Guid) const;
+		// Returns false if no live actor has the GUID.
+		bool FindSlot(ActorGuid Guid, uint32_t& OutSlot, uint32_t& OutGeneration) const;
+		// Returns the actor in a slot if the slot has not been freed since it was looked up.
+		inline Runtime::AActor* GetSlotActor(uint32_t Slot, uint32_t Generation) const
+		{
+			return (Slot < m_Slots.size() && m_Slots[Slot].Generation == Generation) ? m_Slots[Slot].pActor : nullptr;
+		}
+
+		inline uint32_t GetNumActors() const { return m_NumActors; }
+		inline uint32_t GetNumBuckets() const { return static_cast<uint32_t>(m_Buckets.size()); }
+
+	private:
+		struct Bucket
+		{
+			// INVALID_ACTOR_GUID if the bucket is empty.
+			ActorGuid Guid;
+			uint32_t Slot;
+		};
+
+		struct Slot
+		{
+			Runtime::AActor* pActor;
+			ActorGuid Guid;
+			uint32_t Generation;
+		};
+
+		// Index of the bucket holding a GUID, or of the empty bucket it would go in.
+		uint32_t FindBucket(ActorGuid Guid) const;
+		void Grow();
+		static inline uint64_t MixGuid(ActorGuid Guid)
+		{
+			// GUIDs are random, but mix them anyway so hand written or sequential ones still spread out.
+			Guid ^= Guid >> 33u;
+			Guid *= 0xff51afd7ed558ccdull;
+			Guid ^= Guid >> 33u;
+			return Guid;
+		}
+
+	private:
+		// Power of two sized, kept at most 3/4 full.
+		std::vector<Bucket> m_Buckets;
+		std::vector<Slot> m_Slots;
+		std::vector<uint32_t> m_FreeSlots;
+		uint32_t m_NumActors = 0u;
+
+		static ActorRegistry s_Instance;
+	};
+
+	// Weak reference to an actor by GUID. Resolves to null while no live actor has the GUID.
+	class INSIGHT_API ActorRef
+	{
+	public:
+		ActorRef() = default;
+		explicit ActorRef(ActorGuid Guid)
+			: m_Guid(Guid) {}
+		explicit ActorRef(const Runtime::AActor* pActor);
+
+		Runtime::AActor* Get() const;
+		template <typename ActorType>
+		ActorType* Get() const { return dynamic_cast<ActorType*>(Get()); }
+
+		inline ActorGuid GetGuid() const { return m_Guid; }
+		inline bool IsValid() const { return Get() != nullptr; }
+		inline explicit operator bool() const { return IsValid(); }
+		inline void Reset() { m_Guid = INVALID_ACTOR_GUID; m_Slot = ActorRegistry::InvalidSlot; m_Generation = 0u; }
+
+		inline bool operator == (const ActorRef& Other) const { return m_Guid == Other.m_Guid; }
+		inline bool operator != (const ActorRef& Other) const { return m_Guid != Other.m_Guid; }
+
+	private:
+		ActorGuid m_Guid = INVALID_ACTOR_GUID;
+		// The slot the GUID last resolved to.
+		mutable uint32_t m_Slot = ActorRegistry::InvalidSlot;
+		mutable uint32_t m_Generation = 0u;
+	};
+
+}
@@ -0,0 +1,220 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Play_Session_Snapshot.h"
+
+#include "Insight/Core/Scene/Scene_Node.h"
+#include "Insight/Runtime/AActor.h"
+#include "Insight/Runtime/Components/Scene_Component.h"
+#include "Insight/Memory/Deferred_Destruction.h"
+
+namespace Insight {
+
+	// Transforms are captured and restored with memcpy.
+	static_assert(std::is_trivially_copyable<ieTransform>::value, "ieTransform must be trivially copyable to be kept in a play session snapshot.");
+
+	PlaySessionSnapshot* PlaySessionSnapshot::s_pActive = nullptr;
+
+	PlaySessionSnapshot::PlaySessionSnapshot()
+	{
+		if (!s_pActive)
+			s_pActive = this;
+	}
+
+	PlaySessionSnapshot::~PlaySessionSnapshot()
+	{
+		Clear();
+		if (s_pActive == this)
+			s_pActive = nullptr;
+	}
+
+	void PlaySessionSnapshot::Capture(SceneNode* pRoot)
+	{
+		ScopedPerfTimer("PlaySessionSnapshot::Capture", OutputType_Millis);
+
+		Clear();
+		const Runtime::ECS::ComponentTypeId SceneComponentTypeId = Runtime::ECS::GetComponentTypeId<Runtime::SceneComponent>();
+
+		// Collect every node and component once, the buffers are only filled afterwards so each is sized once.
+		std::vector<SceneNode*> Pending{ pRoot };
+		while (!Pending.empty())
+		{
+			SceneNode* pNode = Pending.back();
+			Pending.pop_back();
+			m_CapturedNodes.insert(pNode);
+
+			// Nodes without children get an entry too, so what is spawned under them is found without a walk.
+			m_Parents.push_back({ pNode, static_cast<uint32_t>(m_Children.size()), static_cast<uint32_t>(pNode->m_Children.size()) });
+			m_Children.insert(m_Children.end(), pNode->m_Children.begin(), pNode->m_Children.end());
+			Pending.insert(Pending.end(), pNode->m_Children.begin(), pNode->m_Children.end());
+
+			Runtime::AActor* pActor = dynamic_cast<Runtime::AActor*>(pNode);
+			if (!pActor)
+				continue;
+
+			for (Runtime::ActorComponent* pComponent : pActor->GetAllSubobjects())
+			{
+				if (pComponent->GetTypeId() == SceneComponentTypeId)
+					m_TransformOwners.push_back(static_cast<Runtime::SceneComponent*>(pComponent));
+
+				const uint32_t StateSize = pComponent->GetPlayStateSize();
+				if (StateSize > 0u)
+				{
+					const uint32_t Offset = m_PlayStateEntries.empty() ? 0u : m_PlayStateEntries.back().Offset + m_PlayStateEntries.back().Size;
+					m_PlayStateEntries.push_back({ pComponent, Offset, StateSize });
+				}
+			}
+		}
+
+		m_Transforms.resize(m_TransformOwners.size());
+		for (size_t i = 0; i < m_TransformOwners.size(); ++i)
+		{
+			memcpy(&m_Transforms[i], &m_TransformOwners[i]->GetTransform(), sizeof(ieTransform));
+		}
+
+		if (!m_PlayStateEntries.empty())
+		{
+			m_PlayState.resize(m_PlayStateEntries.back().Offset + m_PlayStateEntries.back().Size);
+			for (const PlayStateEntry& Entry : m_PlayStateEntries)
+			{
+				Entry.pComponent->SavePlayState(m_PlayState.data() + Entry.Offset);
+			}
+		}
+
+		m_IsCaptured = true;
+		IE_DEBUG_LOG(LogSeverity::Verbose, "Captured play session snapshot: {0} nodes, {1} transforms, {2} bytes of component play state.",
+			m_CapturedNodes.size(), m_Transforms.size(), m_PlayState.size());
+	}
+
+	void PlaySessionSnapshot::Restore()
+	{
+		if (!m_IsCaptured)
+			return;
+		ScopedPerfTimer("PlaySessionSnapshot::Restore", OutputType_Millis);
+
+		// Nothing removed from here on is kept.
+		m_IsCaptured = false;
+
+		for (SceneNode* pNode : m_RemovedNodes)
+		{
+			SetRemovedDuringPlay(pNode, false);
+		}
+		m_RemovedNodes.clear();
+
+		// Destroy what was spawned under the captured nodes, then give them back the children they had.
+		for (const ParentEntry& Parent : m_Parents)
+		{
+			for (SceneNode* pChild : Parent.pNode->m_Children)
+			{
+				if (m_CapturedNodes.find(pChild) == m_CapturedNodes.end())
+				{
+					pChild->Destroy();
+					Memory::DeferredDelete(pChild);
+				}
+			}
+			const auto FirstChild = m_Children.begin() + Parent.FirstChild;
+			Parent.pNode->m_Children.assign(FirstChild, FirstChild + Parent.NumChildren);
+			for (SceneNode* pChild : Parent.pNode->m_Children)
+			{
+				pChild->SetParent(Parent.pNode);
+			}
+		}
+
+		// Copy back only the transforms that changed, so a scene that barely moved sends barely any events.
+		std::vector<Runtime::SceneComponent*> Moved;
+		for (size_t i = 0; i < m_TransformOwners.size(); ++i)
+		{
+			Runtime::SceneComponent* pOwner = m_TransformOwners[i];
+			if (!pOwner)
+				continue;
+
+			ieTransform& Current = pOwner->GetTransformRef();
+			if (memcmp(&Current, &m_Transforms[i], sizeof(ieTransform)) != 0)
+			{
+				memcpy(&Current, &m_Transforms[i], sizeof(ieTransform));
+				Moved.push_back(pOwner);
+			}
+		}
+		// Every transform is back before any world matrix is rebuilt from its parent's.
+		for (Runtime::SceneComponent* pMoved : Moved)
+		{
+			pMoved->OnTransformRestored();
+		}
+
+		for (const PlayStateEntry& Entry : m_PlayStateEntries)
+		{
+			if (Entry.pComponent)
+				Entry.pComponent->RestorePlayState(m_PlayState.data() + Entry.Offset);
+		}
+
+		IE_DEBUG_LOG(LogSeverity::Verbose, "Restored play session snapshot: {0} of {1} transforms changed during play.", Moved.size(), m_Transforms.size());
+		Clear();
+	}
+
+	void PlaySessionSnapshot::Clear()
+	{
+		m_IsCaptured = false;
+		for (SceneNode* pNode : m_RemovedNodes)
+		{
+			pNode->Destroy();
+			Memory::DeferredDelete(pNode);
+		}
+		m_RemovedNodes.clear();
+
+		m_TransformOwners.clear();
+		m_Transforms.clear();
+		m_PlayStateEntries.clear();
+		m_PlayState.clear();
+		m_Parents.clear();
+		m_Children.clear();
+		m_CapturedNodes.clear();
+	}
+
+	bool PlaySessionSnapshot::KeepRemovedNode(SceneNode* pNode)
+	{
+		if (!m_IsCaptured || m_CapturedNodes.find(pNode) == m_CapturedNodes.end())
+			return false;
+
+		SetRemovedDuringPlay(pNode, true);
+		m_RemovedNodes.push_back(pNode);
+		return true;
+	}
+
+	void PlaySessionSnapshot::ForgetComponent(Runtime::ActorComponent* pComponent)
+	{
+		if (!m_IsCaptured)
+			return;
+
+		for (Runtime::SceneComponent*& pOwner : m_TransformOwners)
+		{
+			if (pOwner == pComponent)
+				pOwner = nullptr;
+		}
+		for (PlayStateEntry& Entry : m_PlayStateEntries)
+		{
+			if (Entry.pComponent == pComponent)
+				Entry.pComponent = nullptr;
+		}
+	}
+
+	void PlaySessionSnapshot::SetRemovedDuringPlay(SceneNode* pNode, bool Removed)
+	{
+		if (Runtime::AActor* pActor = dynamic_cast<Runtime::AActor*>(pNode))
+		{
+			if (Removed)
+				pActor->UnregisterTickFunctions();
+			for (Runtime::ActorComponent* pComponent : pActor->GetAllSubobjects())
+			{
+				if (Removed)
+					pComponent->OnRemovedDuringPlay();
+				else
+					pComponent->OnRestoredAfterPlay();
+			}
+		}
+		for (SceneNode* pChild : pNode->m_Children)
+		{
+			SetRemovedDuringPlay(pChild, Removed);
+		}
+	}
+
+}
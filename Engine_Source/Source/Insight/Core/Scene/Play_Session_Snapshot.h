@@ -0,0 +1,116 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Play_Session_Snapshot.h
+	Source - Play_Session_Snapshot.cpp
+
+	Purpose:
+	Puts a scene back the way it was before a play session in the editor started.
+
+	Description:
+	When play begins the scene is walked once and its state is copied into flat buffers:
+	- The transform of every scene component, one ieTransform after the other.
+	- The play state of components that have some (See ActorComponent::GetPlayStateSize), packed into one blob.
+	- The children of every node, so the shape of the scene graph can be put back.
+	When play ends the transforms and blobs are copied back in one pass, without walking the scene. Only scene
+	components whose transform actually changed send a translation event.
+
+	Actors that existed when play began are not destroyed if they are removed during play. They are taken out of
+	the scene, stop ticking and are hidden, then put back in the same place when play ends. Actors spawned during
+	play are destroyed when it ends. A component removed during play is not put back.
+
+	Each scene owns a snapshot. Get returns the active one, made active by the scene when it loads.
+
+	Example Usage:
+	m_PlaySnapshot.Capture(m_pSceneRoot);
+	...
+	m_PlaySnapshot.Restore();
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+#include "Insight/Math/Transform.h"
+
+#include <unordered_set>
+
+namespace Insight {
+
+	class SceneNode;
+
+	namespace Runtime {
+		class ActorComponent;
+		class SceneComponent;
+	}
+
+	class INSIGHT_API PlaySessionSnapshot
+	{
+	public:
+		PlaySessionSnapshot();
+		~PlaySessionSnapshot();
+
+		PlaySessionSnapshot(const PlaySessionSnapshot&) = delete;
+		PlaySessionSnapshot& operator = (const PlaySessionSnapshot&) = delete;
+
+		// Get the snapshot of the active scene.
+		inline static PlaySessionSnapshot& Get() { IE_ASSERT(s_pActive, "No play session snapshot has been created!"); return *s_pActive; }
+		inline static bool IsInitialized() { return s_pActive != nullptr; }
+		// Make this the snapshot Get returns. The first one created is active until then.
+		inline void MakeActive() { s_pActive = this; }
+
+		// Copy the state of pRoot and every node under it. Replaces the previous snapshot.
+		void Capture(SceneNode* pRoot);
+		// Put the captured state back, destroy the actors spawned since and drop the snapshot.
+		void Restore();
+		// Drop the snapshot without restoring it. Actors that were removed during play are destroyed.
+		void Clear();
+		inline bool IsCaptured() const { return m_IsCaptured; }
+
+		// Called by Scene::RemoveActor. Returns true if the node existed when the snapshot was captured, it is then
+		// kept to be put back by Restore and the caller must only detach it instead of destroying it.
+		bool KeepRemovedNode(SceneNode* pNode);
+		// Called by an actor deleting one of its components, so Restore does not write to it.
+		void ForgetComponent(Runtime::ActorComponent* pComponent);
+
+		inline uint32_t GetNumTransforms() const { return static_cast<uint32_t>(m_Transforms.size()); }
+		inline size_t GetPlayStateSize() const { return m_PlayState.size(); }
+
+	private:
+		// A component whose play state is in m_PlayState.
+		struct PlayStateEntry
+		{
+			Runtime::ActorComponent* pComponent;
+			uint32_t Offset;
+			uint32_t Size;
+		};
+
+		// A captured node and the range of m_Children it had when the snapshot was captured.
+		struct ParentEntry
+		{
+			SceneNode* pNode;
+			uint32_t FirstChild;
+			uint32_t NumChildren;
+		};
+
+		// Stop or resume ticking and rendering the actors at and under pNode.
+		static void SetRemovedDuringPlay(SceneNode* pNode, bool Removed);
+
+	private:
+		// Parallel arrays, m_Transforms[i] is the captured transform of m_TransformOwners[i].
+		std::vector<Runtime::SceneComponent*> m_TransformOwners;
+		std::vector<ieTransform> m_Transforms;
+
+		std::vector<PlayStateEntry> m_PlayStateEntries;
+		std::vector<uint8_t> m_PlayState;
+
+		std::vector<ParentEntry> m_Parents;
+		std::vector<SceneNode*> m_Children;
+		std::unordered_set<const SceneNode*> m_CapturedNodes;
+		// Captured nodes removed during play, waiting to be put back.
+		std::vector<SceneNode*> m_RemovedNodes;
+
+		bool m_IsCaptured = false;
+
+		static PlaySessionSnapshot* s_pActive;
+	};
+
+}
@@ -6,7 +6,10 @@
 #include "Insight/Runtime/Archetypes/APlayer_Character.h"
 #include "Insight/Runtime/Archetypes/APlayer_Start.h"
 #include "Insight/Runtime/Archetypes/ACamera.h"
+#include "Insight/Runtime/ECS/Transform_System.h"
 #include "Insight/Core/Window.h"
+#include "Insight/Memory/Deferred_Destruction.h"
+#include "Insight/Memory/Memory_Tracker.h"
 
 namespace Insight {
 
@@ -36,7 +39,13 @@ namespace Insight {
 
 	bool Scene::Init(const std::string& fileName)
 	{
+		IE_MEMORY_TAG(Scene);
+		// The actors created from here on keep their components in this scene's world and tick with its tick manager.
+		m_World.MakeActive();
+		m_TickManager.MakeActive();
+		m_PlaySnapshot.MakeActive();
 		m_pSceneRoot = new SceneNode("Scene Root");
+		m_WorldCellSize = 0.0f;
 
 		// Initialize resource managers this scene will need.
 		m_ResourceManager.Init();
@@ -85,32 +94,65 @@ namespace Insight {
 
 	void Scene::BeginPlay()
 	{
+#if !defined (IE_GAME_DIST)
+		// Taken before the player is spawned so the player character is put back too.
+		m_PlaySnapshot.Capture(m_pSceneRoot);
+#endif
 		m_pCamera->SetParent(m_pPlayerCharacter);
 		m_pPlayerStart->SpawnPlayer(m_pPlayerCharacter);
 		m_pCamera->SetViewTarget(m_pPlayerCharacter->GetViewTarget());
 		
 		m_pSceneRoot->BeginPlay();
+		// Only actors and components that tick are registered, everything else costs nothing per frame.
+		// Actors and components added during play are registered as they are added.
+		m_pSceneRoot->RegisterTickFunctions();
 	}
 
 	void Scene::EndPlaySession()
 	{
+		// Stops actors and components added from here on, Ex. by the snapshot restore, from registering.
+		m_pSceneRoot->UnregisterTickFunctions();
+		m_TickManager.Clear();
+		// Copies back every transform and component's play state, and the scene graph's shape, without walking the scene.
+		m_PlaySnapshot.Restore();
+
 		m_pCamera->SetParent(m_pSceneRoot);
 		m_pCamera->SetViewTarget(m_EditorViewTarget);
+	}
 
-		m_pPlayerCharacter->SetPosition(0.0f, 0.0f, 0.0f);
-
-		m_pSceneRoot->EditorEndPlay();
+	void Scene::RemoveActor(Runtime::AActor* pActor)
+	{
+		SceneNode* pParent = pActor->GetParent();
+		if (!pParent)
+			return;
+
+		if (m_PlaySnapshot.KeepRemovedNode(pActor))
+			pParent->DetachChild(pActor);
+		else
+			pParent->RemoveChild(pActor);
 	}
 
 	void Scene::Tick(const float DeltaMs)
 	{
-		m_pPlayerCharacter->Tick(DeltaMs);
-		m_pSceneRoot->Tick(DeltaMs);
+		IE_MEMORY_TAG(Scene);
+		// The player character is registered with the rest of the scene's actors, so it ticks once per frame.
+		m_TickManager.Tick(DeltaMs, m_pPlayerCharacter->GetPosition());
+		// Move the meshes of everything the ticks moved.
+		Runtime::ECS::TransformSystem::Update(m_World);
 	}
 
 	void Scene::OnUpdate(const float DeltaMs)
 	{
+		IE_MEMORY_TAG(Scene);
+		if (m_WorldStreamer.IsActive())
+		{
+			// Stream the world around the player while playing, and around the free camera otherwise.
+			const ieVector3 ViewerPosition = Application::IsPlaySessionUnderWay() ? m_pPlayerCharacter->GetPosition() : m_pCamera->GetPosition();
+			m_WorldStreamer.Update(ViewerPosition);
+		}
 		m_pSceneRoot->OnUpdate(DeltaMs);
+		// Move the meshes of what moved in the editor or while streaming.
+		Runtime::ECS::TransformSystem::Update(m_World);
 	}
 
 	void Scene::OnImGuiRender()
@@ -119,7 +161,19 @@ namespace Insight {
 
 	void Scene::Destroy()
 	{
+		// Actors removed during a play session are held by the snapshot, not the scene root.
+		m_PlaySnapshot.Clear();
+		// Let a running journal compaction finish while the actors it renumbers still exist.
+		m_Journal.Close(m_pSceneRoot);
+		// Cells being read reference the scene's models, the streamed actors themselves are deleted with the scene root.
+		m_WorldStreamer.Shutdown();
+
 		delete m_pSceneRoot;
+		m_pSceneRoot = nullptr;
+
+		// The whole scene is being torn down, release the actors now instead of at the end of the frame
+		// so nothing outlives the resources that are about to be flushed.
+		Memory::DeferredDestructionQueue::Get().Flush();
 	}
 
 	bool Scene::FlushAndOpenNewScene(const std::string& NewScene)
@@ -3,7 +3,12 @@
 #include <Insight/Core.h>
 
 #include "Insight/Systems/Managers/Resource_Manager.h"
+#include "Insight/Core/Scene/Scene_Journal.h"
+#include "Insight/Core/Scene/World_Streamer.h"
+#include "Insight/Core/Scene/Tick_Manager.h"
+#include "Insight/Core/Scene/Play_Session_Snapshot.h"
 #include "Insight/Runtime/Archetypes/ACamera.h"
+#include "Insight/Runtime/ECS/ECS_World.h"
 
 
 namespace Insight {
@@ -36,7 +41,7 @@ namespace Insight {
 		// Called when the world begins a play session. Or a new Scene 
 		// is loaded during game runtime 
 		void BeginPlay();
-		// Called once per frame during game runtime. 
+		// Called once per frame during game runtime. Runs every tick group of the scene's TickManager.
 		void Tick(const float DeltaMs);
 		// Called once per frame during the application's runtime. Some resoruces
 		// aways need to be updated, such as pushing geometry to the GPU for example. This
@@ -54,31 +59,55 @@ namespace Insight {
 
 		// Add an actor to the scene.
 		void AddActor(Runtime::AActor* pActor) { m_pSceneRoot->AddChild(pActor); }
+		// Remove an actor from the scene. It is deleted at the end of the frame, or kept until the play session ends if it existed before it began.
+		void RemoveActor(Runtime::AActor* pActor);
 
 		// Set the name of the level.
 		void SetDisplayName(const std::string& name) { m_DisplayName = name; }
 		// Gets the name of the level.
 		std::string GetDisplayName() { return m_DisplayName; }
-		// Ends the game runtime simulation for the editor.
+		// Ends the game runtime simulation for the editor and puts the scene back the way it was when play began.
 		void EndPlaySession();
 		// Resize the number of actors the scene owns. Usually only needs to be 
 		// done when a new scene is being loaded.
 		void ResizeSceneGraph(size_t NewSceneSize) { m_pSceneRoot->ResizeNumChildren(NewSceneSize); }
 		// Get the number of actors that are currently in the scene.
 		uint32_t GetNumSceneActors() { return m_pSceneRoot->GetNumChildrenNodes(); }
+		// Get the ECS world that stores the components of every actor in the scene.
+		Runtime::ECS::World& GetWorld() { return m_World; }
+		// Get the tick manager the scene's actors and components are ticked by during play.
+		TickManager& GetTickManager() { return m_TickManager; }
+		// Get the snapshot the scene is put back to when a play session in the editor ends.
+		PlaySessionSnapshot& GetPlaySessionSnapshot() { return m_PlaySnapshot; }
+		// Get the journal incremental saves of the scene are appended to.
+		SceneJournal& GetJournal() { return m_Journal; }
+		// Get the streamer that loads the cells of a partitioned scene around the viewer. Only active in game builds.
+		WorldStreamer& GetWorldStreamer() { return m_WorldStreamer; }
+		// Size of the cells the scene's actors are cooked into when it is saved, 0 if the scene is not partitioned. See WorldPartition.
+		void SetWorldCellSize(float CellSize) { m_WorldCellSize = CellSize; }
+		float GetWorldCellSize() const { return m_WorldCellSize; }
 
 
 	private:
+		// Component data of every actor in the scene. Made active by Init, before any of the scene's actors is created.
+		Runtime::ECS::World m_World;
+		// Tick lists of the actors and components that tick during play.
+		TickManager m_TickManager;
+		// State of the scene when the current play session began.
+		PlaySessionSnapshot m_PlaySnapshot;
+
 		Runtime::APlayerCharacter* m_pPlayerCharacter = nullptr;
 		Runtime::APlayerStart* m_pPlayerStart = nullptr;
 		Runtime::ACamera* m_pCamera = nullptr;
 		Runtime::ViewTarget m_EditorViewTarget;
 
 		ieVector3 newPos;
-		Runtime::AActor* m_pSelectedActor = nullptr;
 
 		SceneNode* m_pSceneRoot = nullptr;
 		std::string m_DisplayName;
+		SceneJournal m_Journal;
+		WorldStreamer m_WorldStreamer;
+		float m_WorldCellSize = 0.0f;
 		
 	private:
 		ResourceManager m_ResourceManager;
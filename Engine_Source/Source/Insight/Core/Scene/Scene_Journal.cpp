@@ -0,0 +1,515 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Scene_Journal.h"
+
+#include "Insight/Core/Scene/Scene_Node.h"
+#include "Insight/Runtime/AActor.h"
+#include "Insight/Systems/Json_Stream_Reader.h"
+#include "Insight/Systems/Mapped_File.h"
+#include "Insight/Utilities/Xxh64.h"
+
+#include <cstdio>
+#include <filesystem>
+
+namespace Insight {
+
+	static const char* const ActorsFileName = "/Actors.json";
+	static const char* const JournalFileName = "/Actors.journal";
+	// Files written by a compaction before they are swapped in.
+	static const char* const CompactedSuffix = ".compacted";
+	// Journals that could not be applied are kept under this name for recovery.
+	static const char* const SetAsideSuffix = ".orphaned";
+
+	static size_t GetFileBytes(const std::string& Path)
+	{
+		std::error_code Error;
+		const uintmax_t Bytes = std::filesystem::file_size(Path, Error);
+		return Error ? 0u : static_cast<size_t>(Bytes);
+	}
+
+	// Hash of a file's contents, the hash of no bytes if it cannot be read.
+	static uint64_t GetFileHash(const std::string& Path)
+	{
+		const FileView View = MappedFile::OpenView(Path);
+		return View ? Xxh64::Hash(View.GetData(), View.GetSize()) : Xxh64::Hash(nullptr, 0u);
+	}
+
+	// Read the bytes [Begin, End) of a file, stops early at the end of the file.
+	static bool ReadFileBytes(const std::string& Path, size_t Begin, size_t End, std::string& OutData)
+	{
+		std::ifstream InFile(Path, std::ios::binary);
+		if (!InFile.is_open())
+			return false;
+
+		const size_t FileBytes = GetFileBytes(Path);
+		End = End < FileBytes ? End : FileBytes;
+		if (Begin >= End)
+		{
+			OutData.clear();
+			return true;
+		}
+
+		OutData.resize(End - Begin);
+		InFile.seekg(static_cast<std::streamoff>(Begin));
+		InFile.read(&OutData[0], static_cast<std::streamsize>(OutData.size()));
+		OutData.resize(static_cast<size_t>(InFile.gcount()));
+		return true;
+	}
+
+	static bool WriteFileBytes(const std::string& Path, const char* pData, size_t Size)
+	{
+		std::ofstream OutFile(Path, std::ios::binary | std::ios::trunc);
+		OutFile.write(pData, static_cast<std::streamsize>(Size));
+		return OutFile.good();
+	}
+
+	// Skip the whitespace between records. Returns false at the end of the data.
+	static bool SkipToRecord(rapidjson::StringStream& Stream)
+	{
+		while (Stream.Peek() == ' ' || Stream.Peek() == '\n' || Stream.Peek() == '\r' || Stream.Peek() == '\t')
+			Stream.Take();
+		return Stream.Peek() != '\0';
+	}
+
+	static bool GetSlot(const rapidjson::Value& Record, const char* Key, uint32_t& OutSlot)
+	{
+		auto Iter = Record.FindMember(Key);
+		if (Iter == Record.MemberEnd() || !Iter->value.IsUint())
+			return false;
+
+		OutSlot = Iter->value.GetUint();
+		return true;
+	}
+
+	static void WriteBaseRecord(rapidjson::PrettyWriter<rapidjson::StringBuffer>& Writer, rapidjson::StringBuffer& StrBuffer, size_t BaseBytes, uint64_t BaseHash)
+	{
+		Writer.Reset(StrBuffer);
+		Writer.StartObject();
+		Writer.Key("Op");
+		Writer.String("Base");
+		Writer.Key("Bytes");
+		Writer.Uint64(BaseBytes);
+		Writer.Key("Hash");
+		Writer.Uint64(BaseHash);
+		Writer.EndObject();
+		StrBuffer.Put('\n');
+	}
+
+	bool SceneJournal::Replay::Find(uint32_t Slot, const rapidjson::Value*& pOutJsonActor) const
+	{
+		auto Iter = Slots.find(Slot);
+		if (Iter == Slots.end())
+			return false;
+
+		pOutJsonActor = Iter->second;
+		return true;
+	}
+
+	SceneJournal::~SceneJournal()
+	{
+		Close(nullptr);
+	}
+
+	bool SceneJournal::ReadReplay(const std::string& SceneDirectory, Replay& OutReplay, size_t MaxBytes)
+	{
+		std::string Data;
+		if (!ReadFileBytes(SceneDirectory + JournalFileName, 0u, MaxBytes, Data))
+			return false;
+
+		const size_t BaseBytes = GetFileBytes(SceneDirectory + ActorsFileName);
+		std::vector<std::pair<uint32_t, const rapidjson::Value*>> Pending;
+		bool HasBase = false;
+
+		rapidjson::StringStream Stream(Data.c_str());
+		while (SkipToRecord(Stream))
+		{
+			OutReplay.Records.emplace_back(&OutReplay.Allocator);
+			rapidjson::Document& Record = OutReplay.Records.back();
+			Record.ParseStream<rapidjson::kParseStopWhenDoneFlag>(Stream);
+			if (Record.HasParseError() || !Record.IsObject())
+			{
+				// The last save did not finish writing. Everything it wrote is uncommitted.
+				OutReplay.Records.pop_back();
+				break;
+			}
+
+			std::string Op;
+			json::get_string(Record, "Op", Op);
+			if (!HasBase)
+			{
+				// A journal only applies to the Actors.json it was started against. The size is checked first, it is free.
+				auto Bytes = Record.FindMember("Bytes");
+				auto Hash = Record.FindMember("Hash");
+				if (Op != "Base" || Bytes == Record.MemberEnd() || !Bytes->value.IsUint64() || Bytes->value.GetUint64() != BaseBytes
+					|| Hash == Record.MemberEnd() || !Hash->value.IsUint64() || Hash->value.GetUint64() != GetFileHash(SceneDirectory + ActorsFileName))
+					return false;
+
+				HasBase = true;
+				SkipToRecord(Stream);
+				OutReplay.CommittedBytes = Stream.Tell();
+				continue;
+			}
+
+			uint32_t Slot = 0u;
+			if (Op == "Set" && GetSlot(Record, "Slot", Slot) && Record.HasMember("Actor") && Record["Actor"].IsObject())
+			{
+				Pending.emplace_back(Slot, &Record["Actor"]);
+			}
+			else if (Op == "Remove" && GetSlot(Record, "Slot", Slot))
+			{
+				Pending.emplace_back(Slot, nullptr);
+			}
+			else if (Op == "Commit" && GetSlot(Record, "NumSlots", Slot))
+			{
+				for (const std::pair<uint32_t, const rapidjson::Value*>& Change : Pending)
+					OutReplay.Slots[Change.first] = Change.second;
+				Pending.clear();
+
+				OutReplay.NumSlots = Slot;
+				SkipToRecord(Stream);
+				OutReplay.CommittedBytes = Stream.Tell();
+			}
+		}
+		return HasBase;
+	}
+
+	void SceneJournal::SetAsideJournal(const std::string& SceneDirectory)
+	{
+		const std::string JournalPath = SceneDirectory + JournalFileName;
+		std::error_code Error;
+		if (!std::filesystem::exists(JournalPath, Error))
+			return;
+
+		const std::string SetAsidePath = JournalPath + SetAsideSuffix;
+		std::filesystem::remove(SetAsidePath, Error);
+		std::filesystem::rename(JournalPath, SetAsidePath, Error);
+		IE_DEBUG_LOG(LogSeverity::Warning, "Scene journal \"{0}\" does not match its Actors.json and was not applied. It was moved to \"{1}\".", JournalPath, SetAsidePath);
+	}
+
+	void SceneJournal::Track(const std::string& SceneDirectory, uint32_t NumSlots, std::vector<bool> SavedSlots, size_t JournalBytes)
+	{
+		Close(nullptr);
+
+		m_SceneDirectory = SceneDirectory;
+		m_NumSlots = NumSlots;
+		m_SavedSlots = std::move(SavedSlots);
+		m_SavedSlots.resize(NumSlots, false);
+		m_JournalBytes = JournalBytes;
+	}
+
+	void SceneJournal::TrackFullSave(const std::string& SceneDirectory, SceneNode& Root)
+	{
+		Close(&Root);
+
+		m_SceneDirectory = SceneDirectory;
+		m_NumSlots = 0u;
+		for (auto Iter = Root.GetChildIteratorStart(); Iter != Root.GetChildIteratorEnd(); ++Iter)
+		{
+			SceneNode* pNode = *Iter;
+			if (!pNode->GetCanBeFileParsed() || !dynamic_cast<Runtime::AActor*>(pNode))
+				continue;
+
+			pNode->SetSaveSlot(static_cast<int32_t>(m_NumSlots++));
+			pNode->ClearDirtyForSave();
+		}
+		m_SavedSlots.assign(m_NumSlots, true);
+
+		// The journal was written against the Actors.json that was just replaced.
+		std::remove((m_SceneDirectory + JournalFileName).c_str());
+		m_JournalBytes = 0u;
+	}
+
+	void SceneJournal::Close(SceneNode* pRoot)
+	{
+		if (m_Compaction.valid())
+		{
+			m_Compaction.wait();
+			FinishCompaction(pRoot);
+		}
+
+		m_SceneDirectory.clear();
+		m_NumSlots = 0u;
+		m_SavedSlots.clear();
+		m_JournalBytes = 0u;
+	}
+
+	bool SceneJournal::Append(SceneNode& Root)
+	{
+		if (m_Compaction.valid() && m_Compaction.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+			FinishCompaction(&Root);
+
+		rapidjson::StringBuffer StrBuffer;
+		rapidjson::PrettyWriter<rapidjson::StringBuffer> Writer(StrBuffer);
+
+		// A new journal starts by recording the Actors.json it applies to, see ReadReplay.
+		if (m_JournalBytes == 0u)
+			WriteBaseRecord(Writer, StrBuffer, GetFileBytes(m_SceneDirectory + ActorsFileName), GetFileHash(m_SceneDirectory + ActorsFileName));
+
+		std::vector<SceneNode*> WrittenNodes;
+		std::vector<bool> SavedSlots(m_NumSlots, false);
+		for (auto Iter = Root.GetChildIteratorStart(); Iter != Root.GetChildIteratorEnd(); ++Iter)
+		{
+			SceneNode* pNode = *Iter;
+			if (!pNode->GetCanBeFileParsed() || !dynamic_cast<Runtime::AActor*>(pNode))
+				continue;
+
+			// Actors added since the last save take the next slot.
+			if (pNode->GetSaveSlot() < 0)
+			{
+				pNode->SetSaveSlot(static_cast<int32_t>(m_NumSlots++));
+				pNode->MarkDirtyForSave();
+				SavedSlots.resize(m_NumSlots, false);
+			}
+			const uint32_t Slot = static_cast<uint32_t>(pNode->GetSaveSlot());
+			SavedSlots[Slot] = true;
+
+			if (!pNode->IsDirtyForSave())
+				continue;
+
+			Writer.Reset(StrBuffer);
+			Writer.StartObject();
+			Writer.Key("Op");
+			Writer.String("Set");
+			Writer.Key("Slot");
+			Writer.Uint(Slot);
+			Writer.Key("Actor");
+			pNode->WriteToJson(&Writer);
+			Writer.EndObject();
+			StrBuffer.Put('\n');
+
+			WrittenNodes.push_back(pNode);
+		}
+
+		uint32_t NumRemoved = 0u;
+		for (uint32_t Slot = 0u; Slot < m_SavedSlots.size(); ++Slot)
+		{
+			if (!m_SavedSlots[Slot] || SavedSlots[Slot])
+				continue;
+
+			Writer.Reset(StrBuffer);
+			Writer.StartObject();
+			Writer.Key("Op");
+			Writer.String("Remove");
+			Writer.Key("Slot");
+			Writer.Uint(Slot);
+			Writer.EndObject();
+			StrBuffer.Put('\n');
+			NumRemoved++;
+		}
+
+		if (WrittenNodes.empty() && NumRemoved == 0u)
+			return true;
+
+		Writer.Reset(StrBuffer);
+		Writer.StartObject();
+		Writer.Key("Op");
+		Writer.String("Commit");
+		Writer.Key("NumSlots");
+		Writer.Uint(m_NumSlots);
+		Writer.EndObject();
+		StrBuffer.Put('\n');
+
+		const std::string JournalPath = m_SceneDirectory + JournalFileName;
+		{
+			// Drop anything a save that did not finish left after the last commit.
+			std::error_code Error;
+			if (GetFileBytes(JournalPath) != m_JournalBytes)
+				std::filesystem::resize_file(JournalPath, m_JournalBytes, Error);
+
+			std::ofstream OutFile(JournalPath, std::ios::binary | std::ios::app);
+			OutFile.write(StrBuffer.GetString(), static_cast<std::streamsize>(StrBuffer.GetSize()));
+			OutFile.flush();
+			if (!OutFile.good()) {
+				IE_DEBUG_LOG(LogSeverity::Error, "Failed to append to scene journal \"{0}\".", JournalPath);
+				return false;
+			}
+		}
+
+		for (SceneNode* pNode : WrittenNodes)
+			pNode->ClearDirtyForSave();
+		m_SavedSlots = std::move(SavedSlots);
+		m_JournalBytes += StrBuffer.GetSize();
+
+		IE_DEBUG_LOG(LogSeverity::Verbose, "Scene journal saved {0} changed and {1} removed actors, journal is {2} bytes.", WrittenNodes.size(), NumRemoved, m_JournalBytes);
+
+		if (m_JournalBytes >= CompactAfterBytes && !m_Compaction.valid())
+			m_Compaction = std::async(std::launch::async, &SceneJournal::Compact, m_SceneDirectory, m_JournalBytes);
+
+		return true;
+	}
+
+	SceneJournal::CompactionResult SceneJournal::Compact(const std::string SceneDirectory, size_t JournalBytes)
+	{
+		CompactionResult Result;
+		Result.FoldedBytes = JournalBytes;
+
+		Replay Journal;
+		if (!ReadReplay(SceneDirectory, Journal, JournalBytes))
+			return Result;
+
+		const std::string CompactedPath = SceneDirectory + ActorsFileName + CompactedSuffix;
+		FILE* pFile = fopen(CompactedPath.c_str(), "wb");
+		if (!pFile)
+			return Result;
+
+		char WriteBuffer[64 * 1024];
+		rapidjson::FileWriteStream Stream(pFile, WriteBuffer, sizeof(WriteBuffer));
+		rapidjson::PrettyWriter<rapidjson::FileWriteStream> Writer(Stream);
+
+		Result.SlotRemap.assign(Journal.NumSlots, -1);
+		auto WriteActor = [&](uint32_t Slot, const rapidjson::Value& JsonActor)
+		{
+			JsonActor.Accept(Writer);
+			if (Slot >= Result.SlotRemap.size())
+				Result.SlotRemap.resize(Slot + 1u, -1);
+			Result.SlotRemap[Slot] = static_cast<int32_t>(Result.NewNumSlots++);
+		};
+
+		Writer.StartObject();
+		Writer.Key("Set");
+		Writer.StartArray();
+
+		JsonStream::ActorReadStats Stats;
+		const bool BaseRead = JsonStream::ReadActors((SceneDirectory + ActorsFileName).c_str(), [&](const JsonStream::ActorHeader& Header, const rapidjson::Value& JsonActor)
+		{
+			const rapidjson::Value* pJsonActor = &JsonActor;
+			Journal.Find(Header.Index, pJsonActor);
+			if (pJsonActor)
+				WriteActor(Header.Index, *pJsonActor);
+			return true;
+		}, &Stats);
+
+		// Actors added since Actors.json was written.
+		for (uint32_t Slot = Stats.NumActors; Slot < Journal.NumSlots; ++Slot)
+		{
+			const rapidjson::Value* pJsonActor = nullptr;
+			if (Journal.Find(Slot, pJsonActor) && pJsonActor)
+				WriteActor(Slot, *pJsonActor);
+		}
+
+		Writer.EndArray();
+		Writer.EndObject();
+		Stream.Flush();
+		const bool Written = ferror(pFile) == 0;
+		fclose(pFile);
+
+		if (!BaseRead || !Written)
+		{
+			std::remove(CompactedPath.c_str());
+			return Result;
+		}
+
+		Result.FoldedNumSlots = Journal.NumSlots > Stats.NumActors ? Journal.NumSlots : Stats.NumActors;
+		Result.SlotRemap.resize(Result.FoldedNumSlots, -1);
+		Result.NewBaseBytes = GetFileBytes(CompactedPath);
+		Result.NewBaseHash = GetFileHash(CompactedPath);
+		Result.Succeeded = true;
+		return Result;
+	}
+
+	void SceneJournal::FinishCompaction(SceneNode* pRoot)
+	{
+		const CompactionResult Result = m_Compaction.get();
+
+		const std::string ActorsPath = m_SceneDirectory + ActorsFileName;
+		const std::string JournalPath = m_SceneDirectory + JournalFileName;
+		const std::string CompactedActorsPath = ActorsPath + CompactedSuffix;
+		const std::string CompactedJournalPath = JournalPath + CompactedSuffix;
+		if (!Result.Succeeded) {
+			IE_DEBUG_LOG(LogSeverity::Error, "Failed to compact scene journal \"{0}\". It will keep being appended to.", JournalPath);
+			std::remove(CompactedActorsPath.c_str());
+			return;
+		}
+
+		auto RemapSlot = [&Result](uint32_t Slot) -> int64_t
+		{
+			if (Slot < Result.FoldedNumSlots)
+				return Result.SlotRemap[Slot];
+			return static_cast<int64_t>(Result.NewNumSlots) + (Slot - Result.FoldedNumSlots);
+		};
+
+		// Saves made while the compaction ran are kept, renumbered to the compacted slots.
+		rapidjson::StringBuffer StrBuffer;
+		rapidjson::PrettyWriter<rapidjson::StringBuffer> Writer(StrBuffer);
+		WriteBaseRecord(Writer, StrBuffer, Result.NewBaseBytes, Result.NewBaseHash);
+		{
+			std::string Tail;
+			ReadFileBytes(JournalPath, Result.FoldedBytes, m_JournalBytes, Tail);
+
+			rapidjson::StringStream Stream(Tail.c_str());
+			while (SkipToRecord(Stream))
+			{
+				rapidjson::Document Record;
+				Record.ParseStream<rapidjson::kParseStopWhenDoneFlag>(Stream);
+				if (Record.HasParseError() || !Record.IsObject())
+					break;
+
+				const char* SlotKey = Record.HasMember("NumSlots") ? "NumSlots" : "Slot";
+				uint32_t Slot = 0u;
+				if (GetSlot(Record, SlotKey, Slot))
+				{
+					const int64_t NewSlot = RemapSlot(Slot);
+					if (NewSlot < 0)
+						continue;
+					Record[SlotKey].SetUint(static_cast<uint32_t>(NewSlot));
+				}
+
+				Writer.Reset(StrBuffer);
+				Record.Accept(Writer);
+				StrBuffer.Put('\n');
+			}
+		}
+
+		std::error_code Error;
+		if (!WriteFileBytes(CompactedJournalPath, StrBuffer.GetString(), StrBuffer.GetSize()))
+		{
+			IE_DEBUG_LOG(LogSeverity::Error, "Failed to write compacted scene journal \"{0}\".", CompactedJournalPath);
+			std::remove(CompactedActorsPath.c_str());
+			return;
+		}
+		std::filesystem::rename(CompactedActorsPath, ActorsPath, Error);
+		if (Error)
+		{
+			IE_DEBUG_LOG(LogSeverity::Error, "Failed to replace \"{0}\" with its compacted journal: {1}", ActorsPath, Error.message());
+			std::remove(CompactedActorsPath.c_str());
+			std::remove(CompactedJournalPath.c_str());
+			return;
+		}
+		// If this fails the old journal no longer matches Actors.json and will be set aside by the next load.
+		std::filesystem::rename(CompactedJournalPath, JournalPath, Error);
+		if (Error) {
+			IE_DEBUG_LOG(LogSeverity::Error, "Failed to replace scene journal \"{0}\": {1}", JournalPath, Error.message());
+		}
+
+		// Renumber the slots of the actors still in the scene.
+		const uint32_t NewNumSlots = static_cast<uint32_t>(RemapSlot(m_NumSlots));
+		std::vector<bool> SavedSlots(NewNumSlots, false);
+		for (uint32_t Slot = 0u; Slot < m_SavedSlots.size(); ++Slot)
+		{
+			const int64_t NewSlot = RemapSlot(Slot);
+			if (m_SavedSlots[Slot] && NewSlot >= 0)
+				SavedSlots[static_cast<size_t>(NewSlot)] = true;
+		}
+		if (pRoot)
+		{
+			for (auto Iter = pRoot->GetChildIteratorStart(); Iter != pRoot->GetChildIteratorEnd(); ++Iter)
+			{
+				SceneNode* pNode = *Iter;
+				if (pNode->GetSaveSlot() < 0)
+					continue;
+
+				const int64_t NewSlot = RemapSlot(static_cast<uint32_t>(pNode->GetSaveSlot()));
+				pNode->SetSaveSlot(static_cast<int32_t>(NewSlot));
+				if (NewSlot < 0)
+					pNode->MarkDirtyForSave();
+			}
+		}
+		m_NumSlots = NewNumSlots;
+		m_SavedSlots = std::move(SavedSlots);
+		m_JournalBytes = StrBuffer.GetSize();
+
+		IE_DEBUG_LOG(LogSeverity::Log, "Scene journal compacted into \"{0}\", {1} actors.", ActorsPath, Result.NewNumSlots);
+	}
+
+}
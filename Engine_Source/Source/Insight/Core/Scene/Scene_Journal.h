@@ -0,0 +1,123 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Scene_Journal.h
+	Source - Scene_Journal.cpp
+
+	Purpose:
+	Saves a scene by appending the actors that changed to Actors.journal instead of rewriting Actors.json.
+
+	Description:
+	Every actor in a tracked scene has a save slot, its position in the "Set" array of Actors.json. Actors
+	added since the scene was loaded get the next free slot when they are first saved. Each save appends
+	a batch of json records to Actors.journal in the scene folder:
+	{ "Op": "Base", "Bytes": N, "Hash": H }	- First record only, the size and XXH64 of the Actors.json the journal applies to.
+	{ "Op": "Set", "Slot": S, "Actor": {} }	- The actor in slot S was added or changed, Actor is what AActor::WriteToJson writes.
+	{ "Op": "Remove", "Slot": S }			- The actor in slot S was removed from the scene.
+	{ "Op": "Commit", "NumSlots": N }		- Ends a save. Records after the last Commit are ignored.
+	Only actors flagged with SceneNode::MarkDirtyForSave are written, so a save costs the size of the edit
+	rather than the size of the scene.
+
+	SceneLoader applies the committed records while it streams Actors.json. Once the journal grows past
+	CompactAfterBytes it is folded into a new Actors.json on a worker thread. The next save swaps the
+	new files in and renumbers the live actors' slots, records saved while the compaction ran are kept.
+
+	Example Usage:
+	if (Journal.IsTracking())
+		Journal.Append(pScene->GetSceneRoot());
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+#include <deque>
+#include <cstdint>
+
+namespace Insight {
+
+	class SceneNode;
+
+	class INSIGHT_API SceneJournal
+	{
+	public:
+		// Journal size that starts a compaction.
+		static constexpr size_t CompactAfterBytes = 1024u * 1024u;
+
+		// The committed records of a journal.
+		struct Replay
+		{
+			// Latest json of every slot the journal changed, nullptr for slots that were removed.
+			std::unordered_map<uint32_t, const rapidjson::Value*> Slots;
+			// Number of slots after the last committed save, 0 when nothing was committed.
+			uint32_t NumSlots = 0u;
+			// Size of the journal up to the end of the last committed save.
+			size_t CommittedBytes = 0u;
+
+			rapidjson::MemoryPoolAllocator<> Allocator;
+			std::deque<rapidjson::Document> Records;
+
+			// Find the journal's json for a slot. Returns false if the journal did not change the slot.
+			bool Find(uint32_t Slot, const rapidjson::Value*& pOutJsonActor) const;
+		};
+
+	public:
+		SceneJournal() = default;
+		~SceneJournal();
+
+		/*
+			Read the committed records of a scene's journal.
+			Returns false if the scene has no journal or it was written for a different Actors.json.
+			@param MaxBytes - Only read this much of the journal.
+		*/
+		static bool ReadReplay(const std::string& SceneDirectory, Replay& OutReplay, size_t MaxBytes = SIZE_MAX);
+		// Move a journal that could not be applied aside so it is not appended to, Ex. Actors.json was replaced.
+		static void SetAsideJournal(const std::string& SceneDirectory);
+
+		/*
+			Start tracking a scene that was just loaded. Every loaded actor must have its save slot set.
+			@param NumSlots - Number of slots in Actors.json and the journal.
+			@param SavedSlots - Which slots hold an actor that was loaded into the scene.
+			@param JournalBytes - Committed size of the journal, 0 if there is none.
+		*/
+		void Track(const std::string& SceneDirectory, uint32_t NumSlots, std::vector<bool> SavedSlots, size_t JournalBytes);
+		// Start tracking a scene whose Actors.json was just written in full. Assigns slots in the order the actors were written.
+		void TrackFullSave(const std::string& SceneDirectory, SceneNode& Root);
+		// Stop tracking the scene. Waits for a running compaction and swaps it in.
+		void Close(SceneNode* pRoot);
+
+		inline bool IsTracking() const { return !m_SceneDirectory.empty(); }
+		inline const std::string& GetSceneDirectory() const { return m_SceneDirectory; }
+
+		// Append every added, changed and removed actor under Root to the journal. Returns false if the journal could not be written.
+		bool Append(SceneNode& Root);
+
+	private:
+		struct CompactionResult
+		{
+			bool Succeeded = false;
+			// Journal bytes folded into the new Actors.json.
+			size_t FoldedBytes = 0u;
+			// Slot count of the folded journal.
+			uint32_t FoldedNumSlots = 0u;
+			// New slot of every folded slot, -1 for slots that were removed.
+			std::vector<int32_t> SlotRemap;
+			uint32_t NewNumSlots = 0u;
+			size_t NewBaseBytes = 0u;
+			uint64_t NewBaseHash = 0u;
+		};
+
+		// Write the folded Actors.json next to the current one. Runs on the compaction thread.
+		static CompactionResult Compact(const std::string SceneDirectory, size_t JournalBytes);
+		// Swap the compacted Actors.json in and renumber the slots. pRoot may be null if the scene is being destroyed.
+		void FinishCompaction(SceneNode* pRoot);
+
+	private:
+		std::string m_SceneDirectory;
+		uint32_t m_NumSlots = 0u;
+		// Slots whose actor is in the saved scene, sized to m_NumSlots.
+		std::vector<bool> m_SavedSlots;
+		size_t m_JournalBytes = 0u;
+
+		std::future<CompactionResult> m_Compaction;
+	};
+
+}
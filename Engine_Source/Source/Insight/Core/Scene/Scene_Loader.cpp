@@ -0,0 +1,320 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Scene_Loader.h"
+
+#include "Insight/Core/Scene/Scene.h"
+#include "Insight/Core/Scene/Scene_Journal.h"
+#include "Insight/Core/Scene/World_Partition.h"
+#include "Insight/Rendering/Renderer.h"
+#include "Insight/Runtime/AActor.h"
+#include "Insight/Rendering/Geometry/Model.h"
+#include "Insight/Rendering/Geometry/Mesh_Import_Cache.h"
+#include "Insight/Systems/Json_Stream_Reader.h"
+
+#include "Insight/Rendering/APost_Fx.h"
+#include "Insight/Rendering/ASky_Light.h"
+#include "Insight/Rendering/ASky_Sphere.h"
+#include "Insight/Rendering/Lighting/ASpot_Light.h"
+#include "Insight/Rendering/Lighting/APoint_Light.h"
+#include "Insight/Rendering/Lighting/ADirectional_Light.h"
+
+namespace Insight {
+
+	// The editor loads every actor of a partitioned scene so the whole world can be edited and saved.
+#if defined (IE_GAME_DIST)
+	static constexpr bool StreamWorldCells = true;
+#else
+	static constexpr bool StreamWorldCells = false;
+#endif
+
+	static double MillisecondsSince(std::chrono::steady_clock::time_point Start)
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Start).count();
+	}
+
+#if defined (IE_PLATFORM_BUILD_WIN32)
+	// Collect the model of every static mesh component of an actor's json: { "Subobjects": [ { "StaticMesh": [ { "Mesh": "..." }, ... ] } ] }
+	static void GatherMeshReferences(const rapidjson::Value& JsonActor, std::vector<std::string>& OutMeshPaths)
+	{
+		const rapidjson::Value::ConstMemberIterator Subobjects = JsonActor.FindMember("Subobjects");
+		if (Subobjects == JsonActor.MemberEnd() || !Subobjects->value.IsArray())
+			return;
+
+		for (const rapidjson::Value& Subobject : Subobjects->value.GetArray())
+		{
+			if (!Subobject.IsObject())
+				continue;
+			const rapidjson::Value::ConstMemberIterator StaticMesh = Subobject.FindMember("StaticMesh");
+			if (StaticMesh == Subobject.MemberEnd() || !StaticMesh->value.IsArray())
+				continue;
+
+			for (const rapidjson::Value& Element : StaticMesh->value.GetArray())
+			{
+				if (!Element.IsObject())
+					continue;
+				const rapidjson::Value::ConstMemberIterator Mesh = Element.FindMember("Mesh");
+				if (Mesh != Element.MemberEnd() && Mesh->value.IsString())
+					OutMeshPaths.emplace_back(Mesh->value.GetString(), Mesh->value.GetStringLength());
+			}
+		}
+	}
+#endif
+
+	SceneLoader::SceneLoader(const std::string& SceneDirectory, Scene* pScene)
+		: m_SceneDirectory(SceneDirectory)
+		, m_pScene(pScene)
+	{
+	}
+
+	bool SceneLoader::Load()
+	{
+		const std::chrono::steady_clock::time_point LoadStart = std::chrono::steady_clock::now();
+
+		if (!LoadMeta())
+			return false;
+
+		// Resources load alongside the actors, materials pick up their textures as they finish.
+		std::future<bool> ResourcesLoaded = std::async(std::launch::async, &SceneLoader::LoadResources, this);
+
+		// Game builds only load the actors of a partitioned scene that are not in a cell, the cells are streamed around the viewer.
+		WorldPartition::CellIndex Cells;
+		const bool IsPartitioned = StreamWorldCells && m_pScene->GetWorldCellSize() > 0.0f;
+		const bool IsStreamed = IsPartitioned && WorldPartition::ReadCellIndex(m_SceneDirectory, Cells);
+		if (IsPartitioned && !IsStreamed) {
+			IE_DEBUG_LOG(LogSeverity::Warning, "Scene \"{0}\" is partitioned but its cells have not been cooked. Loading every actor instead.", m_SceneDirectory);
+		}
+		const std::string ActorsDir = IsStreamed ? WorldPartition::GetAlwaysLoadedPath(m_SceneDirectory) : m_SceneDirectory + "/Actors.json";
+
+		// Saves made since Actors.json was last written in full are replayed from the scene's journal.
+		// Cooked cells already include them.
+		SceneJournal::Replay Journal;
+		const bool HasJournal = !IsStreamed && SceneJournal::ReadReplay(m_SceneDirectory, Journal);
+		if (!HasJournal && !IsStreamed)
+			SceneJournal::SetAsideJournal(m_SceneDirectory);
+
+#if defined (IE_PLATFORM_BUILD_WIN32)
+		// The journal is already parsed, only its mesh paths are handed to the prefetch.
+		std::vector<std::string> JournalMeshPaths;
+		for (const auto& Slot : Journal.Slots)
+		{
+			if (Slot.second)
+				GatherMeshReferences(*Slot.second, JournalMeshPaths);
+		}
+		// The mesh scan only hashes member names so it stays ahead of the actors being created below.
+		std::future<void> MeshesPrefetched = std::async(std::launch::async, &SceneLoader::PrefetchMeshes, this, ActorsDir, std::move(JournalMeshPaths));
+#endif
+
+		// Stream the actors
+		bool ActorsRead = false;
+		{
+			const std::chrono::steady_clock::time_point StageStart = std::chrono::steady_clock::now();
+
+			std::vector<bool> SavedSlots;
+			auto CreateActorFromJson = [&](const JsonStream::ActorHeader& Header, const rapidjson::Value& JsonActor)
+			{
+				const rapidjson::Value* pJournalActor = nullptr;
+				if (!Journal.Find(Header.Index, pJournalActor))
+					LoadActor(Header, JsonActor, SavedSlots);
+				else if (pJournalActor)
+					LoadActor(ReadActorHeader(Header.Index, *pJournalActor), *pJournalActor, SavedSlots);
+				return true;
+			};
+
+			JsonStream::ActorReadStats Stats;
+			ActorsRead = JsonStream::ReadActors(ActorsDir.c_str(), CreateActorFromJson, &Stats);
+			if (!ActorsRead) {
+				IE_DEBUG_LOG(LogSeverity::Error, "Failed to load actor file from scene: \"{0}\" from file.", m_SceneDirectory);
+			}
+			else
+			{
+				// Actors added by the journal follow the ones in Actors.json.
+				for (uint32_t Slot = Stats.NumActors; Slot < Journal.NumSlots; ++Slot)
+				{
+					const rapidjson::Value* pJournalActor = nullptr;
+					if (Journal.Find(Slot, pJournalActor) && pJournalActor)
+						LoadActor(ReadActorHeader(Slot, *pJournalActor), *pJournalActor, SavedSlots);
+				}
+
+				// A streamed scene only holds part of the world, it can not be saved back.
+				const uint32_t NumSlots = Journal.NumSlots > Stats.NumActors ? Journal.NumSlots : Stats.NumActors;
+				if (!IsStreamed)
+					m_pScene->GetJournal().Track(m_SceneDirectory, NumSlots, std::move(SavedSlots), HasJournal ? Journal.CommittedBytes : 0u);
+				m_NumJournalSlots = static_cast<uint32_t>(Journal.Slots.size());
+			}
+			m_PeakActorJsonBytes = Stats.PeakActorBytes;
+
+			m_Timings.StreamActorsMs = MillisecondsSince(StageStart);
+		}
+
+		if (ActorsRead) {
+			IE_DEBUG_LOG(LogSeverity::Verbose, "Scene actors loaded.");
+		}
+
+		// Finish
+		bool ResourcesRead = false;
+		{
+			const std::chrono::steady_clock::time_point StageStart = std::chrono::steady_clock::now();
+
+			ResourcesRead = ResourcesLoaded.get();
+#if defined (IE_PLATFORM_BUILD_WIN32)
+			MeshesPrefetched.wait();
+#endif
+
+			// Every model has taken its import by now, release the CPU side copies.
+			m_NumMeshesPrefetched = MeshImportCache::Get().GetNumPrefetched();
+			MeshImportCache::Get().Clear();
+
+			m_Timings.FinishMs = MillisecondsSince(StageStart);
+		}
+
+		// Start after the prefetched imports were cleared, the streamer prefetches the models of each cell itself.
+		if (IsStreamed)
+			m_pScene->GetWorldStreamer().Init(m_SceneDirectory, std::move(Cells), m_pScene);
+
+		m_Timings.TotalMs = MillisecondsSince(LoadStart);
+		LogTimings();
+
+		return ActorsRead && ResourcesRead;
+	}
+
+	bool SceneLoader::LoadMeta()
+	{
+		const std::chrono::steady_clock::time_point StageStart = std::chrono::steady_clock::now();
+
+		JsonStream::SceneMeta Meta;
+		const std::string MetaDir = m_SceneDirectory + "/Meta.json";
+		if (!JsonStream::ReadSceneMeta(MetaDir.c_str(), Meta)) {
+			IE_DEBUG_LOG(LogSeverity::Error, "Failed to load meta file from scene: \"{0}\" from file.", m_SceneDirectory);
+			return false;
+		}
+		m_pScene->SetDisplayName(Meta.SceneName);
+		m_pScene->SetWorldCellSize(Meta.WorldCellSize);
+		Renderer::GetWindowRef().SetWindowTitle(Meta.SceneName);
+		m_pScene->ResizeSceneGraph(Meta.NumSceneActors);
+
+		IE_DEBUG_LOG(LogSeverity::Verbose, "Scene meta data loaded.");
+
+		m_Timings.MetaMs = MillisecondsSince(StageStart);
+		return true;
+	}
+
+	bool SceneLoader::LoadResources()
+	{
+		const std::chrono::steady_clock::time_point StageStart = std::chrono::steady_clock::now();
+
+		std::vector<JsonStream::TextureResource> Textures;
+		const std::string ResourceDir = m_SceneDirectory + "/Resources.json";
+		if (!JsonStream::ReadTextureResources(ResourceDir.c_str(), Textures)) {
+			IE_DEBUG_LOG(LogSeverity::Error, "Failed to load resource file from scene: \"{0}\" from file.", m_SceneDirectory);
+			return false;
+		}
+
+		ResourceManager::Get().LoadTextureResources(Textures);
+
+		IE_DEBUG_LOG(LogSeverity::Verbose, "Scene resouces loaded.");
+
+		m_Timings.ResourcesMs = MillisecondsSince(StageStart);
+		return true;
+	}
+
+	void SceneLoader::PrefetchMeshes(const std::string ActorsDir, const std::vector<std::string> JournalMeshPaths)
+	{
+		const std::chrono::steady_clock::time_point StageStart = std::chrono::steady_clock::now();
+
+		// Actors replayed from the journal are created alongside the ones in Actors.json, their meshes are already known.
+		for (const std::string& MeshPath : JournalMeshPaths)
+			MeshImportCache::Get().Prefetch(Model::GetImportPath(MeshPath));
+
+		// Start importing every mesh the actors use, AActor::LoadFromJson attaches them once the actor is created.
+		// A mesh used by many actors is only imported once.
+		JsonStream::ReadMeshReferences(ActorsDir.c_str(), [](const std::string& MeshPath)
+		{
+			MeshImportCache::Get().Prefetch(Model::GetImportPath(MeshPath));
+		});
+
+		m_Timings.PrefetchMeshesMs = MillisecondsSince(StageStart);
+	}
+
+	void SceneLoader::LoadActor(const JsonStream::ActorHeader& Header, const rapidjson::Value& JsonActor, std::vector<bool>& SavedSlots)
+	{
+		Runtime::AActor* pNewActor = CreateActor(Header, m_NumActorsLoaded);
+		if (pNewActor == nullptr) {
+			IE_DEBUG_LOG(LogSeverity::Error, "Failed to parse actor \"{0}\" into scene", (Header.DisplayName == "") ? "INVALID NAME" : Header.DisplayName);
+			return;
+		}
+		pNewActor->LoadFromJson(&JsonActor);
+
+		// Creating the actor's components flags it as changed, but it matches what is saved. Actors saved
+		// without their GUID stay flagged so the next save writes the one they were given.
+		pNewActor->SetSaveSlot(static_cast<int32_t>(Header.Index));
+		if (pNewActor->GetGuid() == Header.Guid)
+			pNewActor->ClearDirtyForSave();
+		if (Header.Index >= SavedSlots.size())
+			SavedSlots.resize(Header.Index + 1u, false);
+		SavedSlots[Header.Index] = true;
+
+		m_pScene->AddActor(pNewActor);
+		m_NumActorsLoaded++;
+	}
+
+	JsonStream::ActorHeader SceneLoader::ReadActorHeader(uint32_t Slot, const rapidjson::Value& JsonActor)
+	{
+		JsonStream::ActorHeader Header;
+		Header.Index = Slot;
+		json::get_string(JsonActor, "Type", Header.Type);
+		json::get_string(JsonActor, "DisplayName", Header.DisplayName);
+		auto Guid = JsonActor.FindMember("Guid");
+		if (Guid != JsonActor.MemberEnd() && Guid->value.IsString())
+			Header.Guid = ActorRegistry::GuidFromString(Guid->value.GetString(), Guid->value.GetStringLength());
+		return Header;
+	}
+
+	Runtime::AActor* SceneLoader::CreateActor(const JsonStream::ActorHeader& Header, uint32_t SceneIndex)
+	{
+		// The type names are hashed at compile time, so this is one hash of the actor's type and an integer switch.
+		const StringId ActorType = StringId::Intern(Header.Type);
+
+		Runtime::AActor* pActor = nullptr;
+		switch (ActorType.GetHash())
+		{
+		case StringId("Actor").GetHash():
+			pActor = new Runtime::AActor(SceneIndex, Header.DisplayName);
+			break;
+		case StringId("PointLight").GetHash():
+			pActor = new APointLight(SceneIndex, Header.DisplayName);
+			break;
+		case StringId("SpotLight").GetHash():
+			pActor = new ASpotLight(SceneIndex, Header.DisplayName);
+			break;
+		case StringId("DirectionalLight").GetHash():
+			pActor = new ADirectionalLight(SceneIndex, Header.DisplayName);
+			break;
+		case StringId("SkySphere").GetHash():
+			pActor = new ASkySphere(SceneIndex, Header.DisplayName);
+			break;
+		case StringId("SkyLight").GetHash():
+			pActor = new ASkyLight(SceneIndex, Header.DisplayName);
+			break;
+		case StringId("PostFxVolume").GetHash():
+			pActor = new APostFx(SceneIndex, Header.DisplayName);
+			break;
+		default:
+			return nullptr;
+		}
+
+		// References to the actor made before it was saved resolve to it again.
+		if (Header.Guid != INVALID_ACTOR_GUID)
+			pActor->SetGuid(Header.Guid);
+		return pActor;
+	}
+
+	void SceneLoader::LogTimings()
+	{
+		IE_DEBUG_LOG(LogSeverity::Log, "Scene \"{0}\" loaded in {1:.2f}ms. {2} actors, {3} replayed from the journal, {4} unique meshes prefetched, largest actor used {5} bytes of json.",
+			m_SceneDirectory, m_Timings.TotalMs, m_NumActorsLoaded, m_NumJournalSlots, m_NumMeshesPrefetched, m_PeakActorJsonBytes);
+		IE_DEBUG_LOG(LogSeverity::Log, "Scene load stages (ms) - Meta: {0:.2f} Resources: {1:.2f} PrefetchMeshes: {2:.2f} StreamActors: {3:.2f} Finish: {4:.2f}",
+			m_Timings.MetaMs, m_Timings.ResourcesMs, m_Timings.PrefetchMeshesMs, m_Timings.StreamActorsMs, m_Timings.FinishMs);
+	}
+
+}
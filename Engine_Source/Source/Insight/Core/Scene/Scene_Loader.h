@@ -0,0 +1,108 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Scene_Loader.h
+	Source - Scene_Loader.cpp
+
+	Purpose:
+	Loads a .iescene folder (Meta.json, Resources.json, Actors.json) into a Scene in overlapping stages.
+
+	Description:
+	Every file is read with the JsonStream SAX readers, none of them are built into a whole file Document.
+	Stages, in the order they start:
+	1. Meta            - Meta.json is read on the calling thread and sizes the scene graph.
+	2. Resources       - Resources.json is read on its own thread, which then starts the texture loads.
+	3. Prefetch Meshes - Actors.json is scanned on its own thread for the meshes the actors reference
+	                     and every mesh is prefetched with the MeshImportCache as soon as it is found.
+	                     A mesh used by many actors is only imported once.
+	4. Stream Actors   - Actors.json is streamed on the calling thread one actor at a time. Each actor is
+	                     created and added to the scene as soon as its json has been read, in file order,
+	                     so the scene graph is the same every load. Each actor only waits for its own mesh
+	                     import, textures that are not loaded yet are swapped in once they finish.
+	                     Actors changed, added or removed by incremental saves are replayed from the
+	                     scene's SceneJournal as they are streamed.
+	5. Finish          - Waits for the resource and prefetch stages and releases the prefetched imports.
+	In game builds a partitioned scene streams AlwaysLoaded.json in stage 4 instead of Actors.json and
+	hands the rest of its cooked cells to the scene's WorldStreamer. See WorldPartition.
+	Stage timings are logged once the scene has loaded and can be read with GetTimings.
+
+	Example Usage:
+	SceneLoader Loader(FileName, pScene);
+	if (!Loader.Load()) { ... }
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+namespace Insight {
+
+	namespace Runtime {
+		class AActor;
+	}
+
+	namespace JsonStream {
+		struct ActorHeader;
+	}
+
+	class Scene;
+
+	class INSIGHT_API SceneLoader
+	{
+	public:
+		// Wall clock time of each stage in milliseconds.
+		struct StageTimings
+		{
+			double MetaMs = 0.0;
+			// Measured on the resource thread, overlaps streaming the actors.
+			double ResourcesMs = 0.0;
+			// Measured on the prefetch thread, overlaps streaming the actors. Win32 only.
+			double PrefetchMeshesMs = 0.0;
+			// Reading Actors.json and creating every actor in it.
+			double StreamActorsMs = 0.0;
+			// Time spent waiting for the resource stage and outstanding mesh imports after the actors were created.
+			double FinishMs = 0.0;
+			double TotalMs = 0.0;
+		};
+
+	public:
+		/*
+			@param SceneDirectory - Exe relative path to the .iescene folder to load.
+			@param pScene - Scene to populate. Must already be initialized.
+		*/
+		SceneLoader(const std::string& SceneDirectory, Scene* pScene);
+		~SceneLoader() = default;
+
+		// Run every stage. Returns false if one of the scene files could not be read.
+		bool Load();
+
+		inline const StageTimings& GetTimings() const { return m_Timings; }
+		inline uint32_t GetNumActorsLoaded() const { return m_NumActorsLoaded; }
+		inline uint32_t GetNumMeshesPrefetched() const { return m_NumMeshesPrefetched; }
+		// Most memory the json of a single actor needed while streaming Actors.json.
+		inline size_t GetPeakActorJsonBytes() const { return m_PeakActorJsonBytes; }
+
+		// Read the header of an actor from a json object that was not streamed, Ex. from the scene's journal.
+		static JsonStream::ActorHeader ReadActorHeader(uint32_t Slot, const rapidjson::Value& JsonActor);
+		// Create an actor of a streamed type. Returns nullptr for unknown types.
+		static Runtime::AActor* CreateActor(const JsonStream::ActorHeader& Header, uint32_t SceneIndex);
+
+	private:
+		bool LoadMeta();
+		bool LoadResources();
+		// Prefetch the meshes referenced by the actors replayed from the journal, then by an Actors.json file. Called from the prefetch thread.
+		void PrefetchMeshes(const std::string ActorsDir, const std::vector<std::string> JournalMeshPaths);
+		// Create an actor, load it from its json and add it to the scene.
+		void LoadActor(const JsonStream::ActorHeader& Header, const rapidjson::Value& JsonActor, std::vector<bool>& SavedSlots);
+		void LogTimings();
+
+	private:
+		std::string m_SceneDirectory;
+		Scene* m_pScene = nullptr;
+
+		StageTimings m_Timings;
+		uint32_t m_NumActorsLoaded = 0u;
+		uint32_t m_NumMeshesPrefetched = 0u;
+		size_t m_PeakActorJsonBytes = 0u;
+		uint32_t m_NumJournalSlots = 0u;
+	};
+
+}
@@ -1,9 +1,7 @@
 #include <Engine_pch.h>
 
-#include "Insight/Rendering/Renderer.h"
-#include "Insight/Runtime/AActor.h"
 #include "Scene_Node.h"
-#include "Insight/Core/Scene/Scene.h"
+#include "Insight/Memory/Deferred_Destruction.h"
 
 namespace Insight {
 
@@ -23,6 +21,10 @@ namespace Insight {
 	{
 		m_Children.push_back(childNode);
 		childNode->SetParent(this);
+
+		// Added during play, Ex. spawned by gameplay or the editor.
+		if (m_TickFunctionsRegistered)
+			childNode->RegisterTickFunctions();
 	}
 
 	void SceneNode::RemoveChild(SceneNode* ChildNode)
@@ -30,11 +32,24 @@ namespace Insight {
 		auto iter = std::find(m_Children.begin(), m_Children.end(), ChildNode);
 		if (iter != m_Children.end()) {
 
+			// The node may still be on the call stack (Ex. removing itself from the editor), free it at the end of the frame.
 			(*iter)->Destroy();
+			Memory::DeferredDelete(*iter);
 			m_Children.erase(iter);
 		}
 	}
 
+	bool SceneNode::DetachChild(SceneNode* ChildNode)
+	{
+		auto iter = std::find(m_Children.begin(), m_Children.end(), ChildNode);
+		if (iter == m_Children.end())
+			return false;
+
+		ChildNode->UnregisterTickFunctions();
+		m_Children.erase(iter);
+		return true;
+	}
+
 	bool SceneNode::WriteToJson(rapidjson::PrettyWriter<rapidjson::StringBuffer>* Writer)
 	{
 		size_t numChildrenObjects = m_Children.size();
@@ -101,6 +116,22 @@ namespace Insight {
 		}
 	}
 
+	void SceneNode::RegisterTickFunctions()
+	{
+		m_TickFunctionsRegistered = true;
+		for (auto i = m_Children.begin(); i != m_Children.end(); ++i) {
+			(*i)->RegisterTickFunctions();
+		}
+	}
+
+	void SceneNode::UnregisterTickFunctions()
+	{
+		m_TickFunctionsRegistered = false;
+		for (auto i = m_Children.begin(); i != m_Children.end(); ++i) {
+			(*i)->UnregisterTickFunctions();
+		}
+	}
+
 	void SceneNode::Tick(const float DeltaMs)
 	{
 		for (auto i = m_Children.begin(); i != m_Children.end(); ++i) {
@@ -124,8 +155,9 @@ namespace Insight {
 		size_t numChildrenObjects = m_Children.size();
 		for (size_t i = 0; i < numChildrenObjects; ++i) {
 			m_Children[i]->Destroy();
-			delete m_Children[i];
+			Memory::DeferredDelete(m_Children[i]);
 		}
+		m_Children.clear();
 	}
 
 }
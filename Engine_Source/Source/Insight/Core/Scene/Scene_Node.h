@@ -21,15 +21,28 @@ namespace Insight {
 			m_Parent = parent;
 		}
 
+		SceneNode* GetParent() const { return m_Parent; }
+
 		const char* GetDisplayName() { return m_DisplayName.c_str(); }
-		void SetDisplayName(std::string Name) { m_DisplayName = Name; }
+		void SetDisplayName(std::string Name) { m_DisplayName = Name; m_IsDirtyForSave = true; }
 		void SetCanBeFileParsed(bool CanBeParsed) { m_CanBeFileParsed = CanBeParsed; }
+		bool GetCanBeFileParsed() const { return m_CanBeFileParsed; }
+
+		// Position of this node in its scene's saved actor set, -1 until the node is first saved. See SceneJournal.
+		int32_t GetSaveSlot() const { return m_SaveSlot; }
+		void SetSaveSlot(int32_t Slot) { m_SaveSlot = Slot; }
+		// Mark the node as changed so the next incremental save writes it out again.
+		void MarkDirtyForSave() { m_IsDirtyForSave = true; }
+		void ClearDirtyForSave() { m_IsDirtyForSave = false; }
+		bool IsDirtyForSave() const { return m_IsDirtyForSave; }
 
 		void ResizeNumChildren(size_t NumChildren) { m_Children.reserve(NumChildren); }
 		uint32_t GetNumChildrenNodes() { return static_cast<uint32_t>(m_Children.size()); }
 
 		void AddChild(SceneNode* childNode);
 		void RemoveChild(SceneNode* ChildNode);
+		// Take a child out of the graph without destroying it. Returns false if it is not a child of this node.
+		bool DetachChild(SceneNode* ChildNode);
 		std::vector<SceneNode*>::const_iterator GetChildIteratorStart() { return m_Children.begin(); }
 		std::vector<SceneNode*>::const_iterator GetChildIteratorEnd() { return m_Children.end(); }
 
@@ -44,6 +57,12 @@ namespace Insight {
 		virtual void Destroy();
 
 		virtual void BeginPlay();
+		// Register the tick functions of this node and its children with the TickManager. Called once play begins,
+		// children added while the node is registered are registered as they are added.
+		virtual void RegisterTickFunctions();
+		// Unregister the tick functions of this node and its children, Ex. when play ends or the node is detached during play.
+		virtual void UnregisterTickFunctions();
+		inline bool AreTickFunctionsRegistered() const { return m_TickFunctionsRegistered; }
 		virtual void Tick(const float DeltaMs);
 		virtual void Exit();
 
@@ -54,6 +73,10 @@ namespace Insight {
 		SceneNode* m_Parent = nullptr;
 		std::string m_DisplayName;
 		bool m_CanBeFileParsed = true;
+		bool m_IsDirtyForSave = true;
+		int32_t m_SaveSlot = -1;
+		// Set between RegisterTickFunctions and UnregisterTickFunctions.
+		bool m_TickFunctionsRegistered = false;
 	};
 
 }
@@ -0,0 +1,477 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Tick_Manager.h"
+
+#include "Insight/Runtime/AActor.h"
+#include "Insight/Runtime/ECS/Transform_System.h"
+
+#include <queue>
+
+namespace Insight {
+
+	TickManager* TickManager::s_pActive = nullptr;
+	bool TickManager::s_SerialTicking = false;
+
+	TickManager::TickManager()
+	{
+		if (!s_pActive)
+			s_pActive = this;
+		m_GameThreadId = std::this_thread::get_id();
+	}
+
+	TickManager::~TickManager()
+	{
+		StopWorkers();
+		Clear();
+		if (s_pActive == this)
+			s_pActive = nullptr;
+	}
+
+	void TickManager::Register(TickFunction& Function, TickFn pTickFn, void* pTarget, Runtime::AActor* pOwner)
+	{
+		if (!Function.CanEverTick || Function.IsRegistered())
+			return;
+		IE_ASSERT(!m_pTickingList || std::this_thread::get_id() == m_GameThreadId, "Tick functions can only be registered from the game thread.");
+
+		TickList& List = m_Groups[static_cast<size_t>(Function.Group)];
+		Function.Index = static_cast<uint32_t>(List.Entries.size());
+		Function.RegisteredGroup = Function.Group;
+		// Due on the next frame.
+		List.NextTickTimes.push_back(m_Time);
+		List.Entries.push_back(TickEntry{ &Function, pTickFn, pTarget, pOwner, m_Time });
+	}
+
+	void TickManager::Unregister(TickFunction& Function)
+	{
+		if (!Function.IsRegistered())
+			return;
+		IE_ASSERT(!m_pTickingList || std::this_thread::get_id() == m_GameThreadId, "Tick functions can only be unregistered from the game thread.");
+
+		TickList& List = m_Groups[static_cast<size_t>(Function.RegisteredGroup)];
+		const uint32_t Index = Function.Index;
+		Function.Index = TickFunction::InvalidIndex;
+
+		if (&List == m_pTickingList)
+		{
+			// Moving entries now would make the list skip or repeat one, clear it and remove it once the list is done.
+			TickEntry& Entry = List.Entries[Index];
+			Entry.pFunction = nullptr;
+			Entry.pTarget = nullptr;
+			List.NextTickTimes[Index] = std::numeric_limits<double>::max();
+			List.PendingRemovals.push_back(Index);
+
+			// Its task may not have run yet.
+			if (Index < m_TaskOfEntry.size() && m_TaskOfEntry[Index] != TickFunction::InvalidIndex)
+				m_pCancelled[m_TaskOfEntry[Index]].store(true, std::memory_order_release);
+			return;
+		}
+		RemoveEntry(List, Index);
+	}
+
+	void TickManager::RemoveEntry(TickList& List, uint32_t Index)
+	{
+		const uint32_t Last = static_cast<uint32_t>(List.Entries.size()) - 1u;
+		if (Index != Last)
+		{
+			List.Entries[Index] = List.Entries[Last];
+			List.NextTickTimes[Index] = List.NextTickTimes[Last];
+			if (TickFunction* pMoved = List.Entries[Index].pFunction)
+				pMoved->Index = Index;
+		}
+		List.Entries.pop_back();
+		List.NextTickTimes.pop_back();
+	}
+
+	void TickManager::Clear()
+	{
+		for (TickList& List : m_Groups)
+		{
+			for (TickEntry& Entry : List.Entries)
+			{
+				if (Entry.pFunction)
+					Entry.pFunction->Index = TickFunction::InvalidIndex;
+			}
+			List.Entries.clear();
+			List.NextTickTimes.clear();
+			List.PendingRemovals.clear();
+		}
+	}
+
+	uint32_t TickManager::GetNumRegistered() const
+	{
+		uint32_t NumRegistered = 0u;
+		for (const TickList& List : m_Groups)
+			NumRegistered += static_cast<uint32_t>(List.Entries.size() - List.PendingRemovals.size());
+		return NumRegistered;
+	}
+
+	void TickManager::Tick(const float DeltaMs, const ieVector3& ViewerPosition)
+	{
+		m_Time += DeltaMs;
+		m_ViewerPosition = ViewerPosition;
+		m_GameThreadId = std::this_thread::get_id();
+		m_NumTickedLastFrame = 0u;
+
+		for (TickList& List : m_Groups)
+			TickGroupList(List);
+	}
+
+	void TickManager::TickGroupList(TickList& List)
+	{
+		m_pTickingList = &List;
+
+		// Entries registered while the group ticks wait for the next frame.
+		const uint32_t NumEntries = static_cast<uint32_t>(List.Entries.size());
+		m_Tasks.clear();
+		m_TaskOfEntry.assign(NumEntries, TickFunction::InvalidIndex);
+		for (uint32_t i = 0u; i < NumEntries; ++i)
+		{
+			if (List.NextTickTimes[i] > m_Time)
+				continue;
+
+			const TickEntry& Entry = List.Entries[i];
+			m_TaskOfEntry[i] = static_cast<uint32_t>(m_Tasks.size());
+			const bool OnGameThread = Entry.pFunction->RunOnGameThread || s_SerialTicking;
+			m_Tasks.push_back(TickTask{ i, Entry.pTickFn, Entry.pTarget, static_cast<float>(m_Time - Entry.LastTickTime), OnGameThread, 0u, 0u });
+		}
+
+		const uint32_t NumTasks = static_cast<uint32_t>(m_Tasks.size());
+		if (NumTasks > 0u)
+		{
+			if (NumTasks > m_TaskCapacity)
+			{
+				m_TaskCapacity = std::max<size_t>(NumTasks, m_TaskCapacity * 2u);
+				m_pPendingCounts.reset(new std::atomic<uint32_t>[m_TaskCapacity]);
+				m_pCancelled.reset(new std::atomic<bool>[m_TaskCapacity]);
+			}
+			for (uint32_t i = 0u; i < NumTasks; ++i)
+				m_pCancelled[i].store(false, std::memory_order_relaxed);
+
+			const uint32_t NumWorkerTasks = BuildTaskGraph(List);
+			if (!SortTasks(m_TaskOrder))
+			{
+				if (!m_WarnedAboutCycle)
+				{
+					IE_DEBUG_LOG(LogSeverity::Warning, "Tick prerequisites form a cycle. Ticking the group in registration order on the game thread.");
+					m_WarnedAboutCycle = true;
+				}
+				for (uint32_t i = 0u; i < NumTasks; ++i)
+					RunTask(i);
+			}
+			else
+			{
+				if (NumWorkerTasks > 0u && !s_SerialTicking)
+					StartWorkers();
+
+				if (NumWorkerTasks > 0u && !m_Workers.empty())
+				{
+					RunTasksInParallel();
+				}
+				else
+				{
+					for (uint32_t TaskIndex : m_TaskOrder)
+						RunTask(TaskIndex);
+				}
+			}
+		}
+
+		m_pTickingList = nullptr;
+
+		for (const TickTask& Task : m_Tasks)
+		{
+			// Entries unregistered during the group have no function.
+			TickEntry& Ticked = List.Entries[Task.EntryIndex];
+			if (!Ticked.pFunction)
+				continue;
+
+			float Interval = Ticked.pFunction->Interval;
+			if (Ticked.pFunction->UseSignificance && m_Significance.Enabled && Ticked.pOwner)
+				Interval = std::max(Interval, GetSignificanceInterval(Ticked.pOwner));
+			Ticked.LastTickTime = m_Time;
+			List.NextTickTimes[Task.EntryIndex] = m_Time + Interval;
+			m_NumTickedLastFrame++;
+		}
+		m_TaskOfEntry.clear();
+
+		// Remove from the back first so the entries moved into each hole are still live.
+		if (!List.PendingRemovals.empty())
+		{
+			std::sort(List.PendingRemovals.begin(), List.PendingRemovals.end(), std::greater<uint32_t>());
+			for (uint32_t Index : List.PendingRemovals)
+				RemoveEntry(List, Index);
+			List.PendingRemovals.clear();
+		}
+	}
+
+	uint32_t TickManager::BuildTaskGraph(const TickList& List)
+	{
+		const uint32_t NumTasks = static_cast<uint32_t>(m_Tasks.size());
+		m_Edges.clear();
+		for (const uint32_t Slot : m_OwnerSlots)
+			m_LastTaskOfActorSlot[Slot] = TickFunction::InvalidIndex;
+		m_OwnerSlots.clear();
+		uint32_t LastWriters[64];
+		std::fill(std::begin(LastWriters), std::end(LastWriters), TickFunction::InvalidIndex);
+		for (std::vector<uint32_t>& Readers : m_AccessReaders)
+			Readers.clear();
+
+		// Every edge goes from an earlier task to a later one, so these alone can never form a cycle.
+		uint32_t NumWorkerTasks = 0u;
+		for (uint32_t i = 0u; i < NumTasks; ++i)
+		{
+			const TickEntry& Entry = List.Entries[m_Tasks[i].EntryIndex];
+			if (!m_Tasks[i].OnGameThread)
+				NumWorkerTasks++;
+
+			// An actor's ticks run one after another.
+			const uint32_t OwnerSlot = Entry.pOwner ? Entry.pOwner->GetRegistrySlot() : ActorRegistry::InvalidSlot;
+			if (OwnerSlot != ActorRegistry::InvalidSlot)
+			{
+				if (OwnerSlot >= m_LastTaskOfActorSlot.size())
+					m_LastTaskOfActorSlot.resize(OwnerSlot + 1u, TickFunction::InvalidIndex);
+
+				uint32_t& LastTask = m_LastTaskOfActorSlot[OwnerSlot];
+				if (LastTask == TickFunction::InvalidIndex)
+					m_OwnerSlots.push_back(OwnerSlot);
+				else
+					m_Edges.emplace_back(LastTask, i);
+				LastTask = i;
+			}
+
+			// Writes wait on everything before them that touched the state, reads only on the last write.
+			const uint64_t Writes = Entry.pFunction->Writes;
+			uint64_t Accessed = Entry.pFunction->Reads | Writes;
+			for (uint32_t Bit = 0u; Accessed != 0u; ++Bit, Accessed >>= 1u)
+			{
+				if ((Accessed & 1u) == 0u)
+					continue;
+
+				if (LastWriters[Bit] != TickFunction::InvalidIndex)
+					m_Edges.emplace_back(LastWriters[Bit], i);
+				if (Writes & (1ull << Bit))
+				{
+					for (uint32_t Reader : m_AccessReaders[Bit])
+						m_Edges.emplace_back(Reader, i);
+					m_AccessReaders[Bit].clear();
+					LastWriters[Bit] = i;
+				}
+				else
+				{
+					m_AccessReaders[Bit].push_back(i);
+				}
+			}
+		}
+
+		// Prerequisites wait on the last tick of the actor, which runs after all of its others.
+		for (uint32_t i = 0u; i < NumTasks; ++i)
+		{
+			const TickEntry& Entry = List.Entries[m_Tasks[i].EntryIndex];
+			for (const ActorRef& Prerequisite : Entry.pFunction->Prerequisites)
+			{
+				Runtime::AActor* pPrerequisite = Prerequisite.Get();
+				if (!pPrerequisite || pPrerequisite == Entry.pOwner)
+					continue;
+
+				const uint32_t Slot = pPrerequisite->GetRegistrySlot();
+				if (Slot < m_LastTaskOfActorSlot.size() && m_LastTaskOfActorSlot[Slot] != TickFunction::InvalidIndex)
+					m_Edges.emplace_back(m_LastTaskOfActorSlot[Slot], i);
+			}
+		}
+
+		// Store the tasks waiting on each task next to each other.
+		m_NumPrerequisites.assign(NumTasks, 0u);
+		for (const std::pair<uint32_t, uint32_t>& Edge : m_Edges)
+		{
+			m_Tasks[Edge.first].NumDependents++;
+			m_NumPrerequisites[Edge.second]++;
+		}
+		uint32_t FirstDependent = 0u;
+		for (TickTask& Task : m_Tasks)
+		{
+			Task.FirstDependent = FirstDependent;
+			FirstDependent += Task.NumDependents;
+			Task.NumDependents = 0u;
+		}
+		m_Dependents.resize(m_Edges.size());
+		for (const std::pair<uint32_t, uint32_t>& Edge : m_Edges)
+		{
+			TickTask& From = m_Tasks[Edge.first];
+			m_Dependents[From.FirstDependent + From.NumDependents++] = Edge.second;
+		}
+		return NumWorkerTasks;
+	}
+
+	bool TickManager::SortTasks(std::vector<uint32_t>& OutOrder) const
+	{
+		const uint32_t NumTasks = static_cast<uint32_t>(m_Tasks.size());
+		std::vector<uint32_t> NumWaiting(m_NumPrerequisites);
+		std::priority_queue<uint32_t, std::vector<uint32_t>, std::greater<uint32_t>> Ready;
+		for (uint32_t i = 0u; i < NumTasks; ++i)
+		{
+			if (NumWaiting[i] == 0u)
+				Ready.push(i);
+		}
+
+		// Taking the lowest ready index keeps registration order wherever nothing says otherwise.
+		OutOrder.clear();
+		while (!Ready.empty())
+		{
+			const uint32_t TaskIndex = Ready.top();
+			Ready.pop();
+			OutOrder.push_back(TaskIndex);
+
+			const TickTask& Task = m_Tasks[TaskIndex];
+			for (uint32_t i = 0u; i < Task.NumDependents; ++i)
+			{
+				const uint32_t Dependent = m_Dependents[Task.FirstDependent + i];
+				if (--NumWaiting[Dependent] == 0u)
+					Ready.push(Dependent);
+			}
+		}
+		return OutOrder.size() == NumTasks;
+	}
+
+	void TickManager::RunTask(uint32_t TaskIndex)
+	{
+		const TickTask& Task = m_Tasks[TaskIndex];
+		if (!m_pCancelled[TaskIndex].load(std::memory_order_acquire))
+			Task.pTickFn(Task.pTarget, Task.DeltaMs);
+	}
+
+	void TickManager::RunTasksInParallel()
+	{
+		const uint32_t NumTasks = static_cast<uint32_t>(m_Tasks.size());
+		m_NumTasksLeft.store(NumTasks, std::memory_order_relaxed);
+		{
+			std::lock_guard<std::mutex> Lock(m_QueueMutex);
+			for (uint32_t i = 0u; i < NumTasks; ++i)
+			{
+				m_pPendingCounts[i].store(m_NumPrerequisites[i], std::memory_order_relaxed);
+				if (m_NumPrerequisites[i] == 0u)
+					(m_Tasks[i].OnGameThread ? m_GameThreadQueue : m_WorkerQueue).push_back(i);
+			}
+		}
+		m_WorkerWake.notify_all();
+
+		// Run the game thread's tasks, and help the workers while there are none.
+		while (true)
+		{
+			uint32_t TaskIndex = 0u;
+			{
+				std::unique_lock<std::mutex> Lock(m_QueueMutex);
+				m_GameThreadWake.wait(Lock, [this]()
+				{
+					return !m_GameThreadQueue.empty() || !m_WorkerQueue.empty() || m_NumTasksLeft.load(std::memory_order_acquire) == 0u;
+				});
+
+				std::deque<uint32_t>& Queue = !m_GameThreadQueue.empty() ? m_GameThreadQueue : m_WorkerQueue;
+				if (Queue.empty())
+					break;
+				TaskIndex = Queue.front();
+				Queue.pop_front();
+			}
+			RunTask(TaskIndex);
+			FinishTask(TaskIndex);
+		}
+	}
+
+	void TickManager::FinishTask(uint32_t TaskIndex)
+	{
+		const TickTask& Task = m_Tasks[TaskIndex];
+		bool WakeWorkers = false;
+		bool WakeGameThread = false;
+		for (uint32_t i = 0u; i < Task.NumDependents; ++i)
+		{
+			const uint32_t Dependent = m_Dependents[Task.FirstDependent + i];
+			if (m_pPendingCounts[Dependent].fetch_sub(1u, std::memory_order_acq_rel) != 1u)
+				continue;
+
+			std::lock_guard<std::mutex> Lock(m_QueueMutex);
+			if (m_Tasks[Dependent].OnGameThread)
+			{
+				m_GameThreadQueue.push_back(Dependent);
+				WakeGameThread = true;
+			}
+			else
+			{
+				m_WorkerQueue.push_back(Dependent);
+				WakeWorkers = true;
+			}
+		}
+
+		if (m_NumTasksLeft.fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+		{
+			// Taking the lock makes sure the game thread is either waiting or has not checked the count yet.
+			std::lock_guard<std::mutex> Lock(m_QueueMutex);
+			WakeGameThread = true;
+		}
+
+		if (WakeWorkers)
+			m_WorkerWake.notify_all();
+		if (WakeWorkers || WakeGameThread)
+			m_GameThreadWake.notify_one();
+	}
+
+	void TickManager::StartWorkers()
+	{
+		if (!m_Workers.empty())
+			return;
+
+		// The game thread ticks too.
+		const uint32_t NumWorkers = std::max(std::thread::hardware_concurrency(), 2u) - 1u;
+		m_StopWorkers = false;
+		m_Workers.reserve(NumWorkers);
+		for (uint32_t i = 0u; i < NumWorkers; ++i)
+			m_Workers.emplace_back(&TickManager::WorkerThread, this);
+	}
+
+	void TickManager::StopWorkers()
+	{
+		{
+			std::lock_guard<std::mutex> Lock(m_QueueMutex);
+			m_StopWorkers = true;
+		}
+		m_WorkerWake.notify_all();
+		for (std::thread& Worker : m_Workers)
+			Worker.join();
+		m_Workers.clear();
+	}
+
+	void TickManager::WorkerThread()
+	{
+		while (true)
+		{
+			uint32_t TaskIndex = 0u;
+			{
+				std::unique_lock<std::mutex> Lock(m_QueueMutex);
+				m_WorkerWake.wait(Lock, [this]() { return m_StopWorkers || !m_WorkerQueue.empty(); });
+				if (m_StopWorkers)
+					return;
+				TaskIndex = m_WorkerQueue.front();
+				m_WorkerQueue.pop_front();
+			}
+			RunTask(TaskIndex);
+			FinishTask(TaskIndex);
+		}
+	}
+
+	float TickManager::GetSignificanceInterval(Runtime::AActor* pOwner) const
+	{
+		// Actors without a transform are everywhere at once, keep them at full rate.
+		const Runtime::ECS::WorldTransform* pTransform = pOwner->GetWorld().GetComponent<Runtime::ECS::WorldTransform>(pOwner->GetEntity());
+		if (!pTransform)
+			return 0.0f;
+
+		// Where the actor is drawn, the translation row of its world matrix.
+		const Math::Simd::Vector Offset = Math::Simd::Subtract(pTransform->Matrix.r[3], Math::Simd::Set(m_ViewerPosition.x, m_ViewerPosition.y, m_ViewerPosition.z, 1.0f));
+		const float Distance = std::sqrt(Math::Simd::Dot3(Offset, Offset));
+		if (Distance <= m_Significance.FullRateDistance)
+			return 0.0f;
+
+		const float Range = std::max(m_Significance.MinRateDistance - m_Significance.FullRateDistance, 0.001f);
+		const float Alpha = std::min((Distance - m_Significance.FullRateDistance) / Range, 1.0f);
+		return Alpha * m_Significance.MinRateInterval;
+	}
+
+}
@@ -0,0 +1,262 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Tick_Manager.h
+	Source - Tick_Manager.cpp
+
+	Purpose:
+	Ticks the actors and components of a scene that need it, in groups, at their own rate and across worker threads.
+
+	Description:
+	Actors and components describe how they tick with a TickFunction. Types whose Tick does nothing
+	leave CanEverTick false and are never registered, and neither are actors marked static, so they
+	cost nothing per frame. Everything else is registered when play begins, or when it is added to the
+	scene or created during play, and kept in a flat list per TickGroup. Actors and components are
+	unregistered when they are destroyed, removed or detached from the scene. Groups run in order every frame:
+	PrePhysics	- Gameplay that drives movement (Ex. player input, scripts).
+	PostPhysics	- Gameplay that reacts to where things ended up.
+	PostUpdate	- Anything that must see the final state of the frame (Ex. attachments, cameras).
+	The time each entry ticks next is kept in its own array, so an entry waiting on its interval is
+	skipped with one compare. An entry is passed the time since it last ticked, not the frame time.
+
+	Significance lowers the tick rate of actors far from the viewer. Past FullRateDistance an
+	entry's interval is stretched towards MinRateInterval, reached at MinRateDistance. It is
+	evaluated when an entry ticks, so throttled entries do no work in between.
+
+	Each frame the entries of a group that are due are built into a dependency graph. An entry ticks after:
+	- The entries of its own actor registered before it. An actor's ticks never run at the same time.
+	- The ticks of the actors in its Prerequisites (Ex. its parent).
+	- Entries registered before it that write shared state it reads or writes, or read state it writes.
+	Ticks that declared RunOnGameThread false are run by a pool of worker threads as soon as what they
+	depend on has finished, the game thread runs the rest and helps with worker ticks while it waits.
+	Every entry defaults to the game thread, so nothing runs off it unless it says it is safe to.
+	A tick run on a worker may only change its own actor and the shared state it declared. It must not
+	create, destroy or register anything, do that from a tick on the game thread.
+	With serial ticking (-SerialTick) every entry runs on the game thread, in registration order except
+	where a prerequisite says otherwise. The order is the same every run, for debugging.
+
+	Each scene owns a tick manager. Get returns the active one, made active by the scene when it loads.
+
+	Example Usage:
+	APlayerCharacter::APlayerCharacter() { m_PrimaryTick.CanEverTick = true; }
+	AMyActor::AMyActor() { m_PrimaryTick.CanEverTick = true; m_PrimaryTick.RunOnGameThread = false; m_PrimaryTick.Reads = TickAccess_Physics; }
+	pChild->AddTickPrerequisite(pParent);
+	...
+	TickManager::Get().Tick(DeltaMs, ViewerPosition);
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+#include "Insight/Math/Transform.h"
+#include "Insight/Core/Scene/Actor_Registry.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace Insight {
+
+	namespace Runtime {
+		class AActor;
+	}
+
+	enum class TickGroup : uint8_t
+	{
+		PrePhysics,
+		PostPhysics,
+		PostUpdate,
+
+		NumGroups,
+	};
+
+	// Shared state a tick can declare it reads or writes, besides its own actor. Games define their own starting at TickAccess_FirstCustom.
+	enum TickAccess : uint64_t
+	{
+		TickAccess_None			= 0ull,
+		// Transforms of other actors.
+		TickAccess_Transforms	= 1ull << 0,
+		TickAccess_Physics		= 1ull << 1,
+		TickAccess_Audio		= 1ull << 2,
+		TickAccess_Rendering	= 1ull << 3,
+		TickAccess_Spawning		= 1ull << 4,
+
+		TickAccess_FirstCustom	= 1ull << 16,
+	};
+
+	// How an actor or component ticks. Owned by the thing that ticks.
+	struct TickFunction
+	{
+		static constexpr uint32_t InvalidIndex = ~0u;
+
+		// False if the owner's Tick does nothing. It is never registered.
+		bool CanEverTick = false;
+		// Tick less often the further the owner is from the viewer.
+		bool UseSignificance = true;
+		// False if the tick only changes its own actor and the shared state it declares, so it can run on a worker thread.
+		bool RunOnGameThread = true;
+		TickGroup Group = TickGroup::PrePhysics;
+		// Minimum seconds between ticks, 0 to tick every frame.
+		float Interval = 0.0f;
+		// TickAccess flags of the shared state the tick reads and writes.
+		uint64_t Reads = TickAccess_None;
+		uint64_t Writes = TickAccess_None;
+		// Actors whose ticks in the same group finish before this one starts. Destroyed actors are ignored.
+		std::vector<ActorRef> Prerequisites;
+
+		inline bool IsRegistered() const { return Index != InvalidIndex; }
+
+	private:
+		friend class TickManager;
+		// Where the function is in its group's list while registered.
+		uint32_t Index = InvalidIndex;
+		TickGroup RegisteredGroup = TickGroup::PrePhysics;
+	};
+
+	class INSIGHT_API TickManager
+	{
+	public:
+		typedef void(*TickFn)(void* pTarget, float DeltaMs);
+
+		struct SignificanceSettings
+		{
+			bool Enabled = true;
+			// Entries closer than this tick at their own interval.
+			float FullRateDistance = 50.0f;
+			// Entries further than this tick every MinRateInterval seconds.
+			float MinRateDistance = 400.0f;
+			float MinRateInterval = 0.5f;
+		};
+
+	public:
+		TickManager();
+		~TickManager();
+
+		TickManager(const TickManager&) = delete;
+		TickManager& operator = (const TickManager&) = delete;
+
+		// Get the tick manager of the active scene.
+		inline static TickManager& Get() { IE_ASSERT(s_pActive, "No tick manager has been created!"); return *s_pActive; }
+		inline static bool IsInitialized() { return s_pActive != nullptr; }
+		// Make this the tick manager actors and components register with. The first one created is active until then.
+		inline void MakeActive() { s_pActive = this; }
+		// Run every tick on the game thread in a fixed order. Applies to every tick manager, set from -SerialTick.
+		inline static void SetSerialTicking(bool Serial) { s_SerialTicking = Serial; }
+		inline static bool IsSerialTicking() { return s_SerialTicking; }
+
+		/*
+			Start ticking a function. Does nothing if it is already registered or can never tick.
+			Must be called from the game thread.
+			@param pTickFn - Called with pTarget when the function is due.
+			@param pOwner - Actor the function belongs to. Its distance from the viewer throttles the function and its
+							other functions never tick at the same time. Null to never throttle it.
+		*/
+		void Register(TickFunction& Function, TickFn pTickFn, void* pTarget, Runtime::AActor* pOwner);
+		// Stop ticking a function. Safe to call from a tick on the game thread, and for functions that are not registered.
+		void Unregister(TickFunction& Function);
+		// Unregister every function, Ex. when a play session ends.
+		void Clear();
+
+		// Tick every group in order.
+		void Tick(const float DeltaMs, const ieVector3& ViewerPosition);
+
+		inline SignificanceSettings& GetSignificanceSettings() { return m_Significance; }
+		uint32_t GetNumRegistered() const;
+		// Number of entries that ticked last frame.
+		inline uint32_t GetNumTickedLastFrame() const { return m_NumTickedLastFrame; }
+		inline uint32_t GetNumWorkerThreads() const { return static_cast<uint32_t>(m_Workers.size()); }
+
+	private:
+		struct TickEntry
+		{
+			TickFunction* pFunction;
+			TickFn pTickFn;
+			void* pTarget;
+			Runtime::AActor* pOwner;
+			double LastTickTime;
+		};
+
+		struct TickList
+		{
+			// Kept apart from the entries so waiting entries are skipped by reading one array.
+			std::vector<double> NextTickTimes;
+			std::vector<TickEntry> Entries;
+			// Entries unregistered while the list was ticking, removed once it finishes.
+			std::vector<uint32_t> PendingRemovals;
+		};
+
+		// An entry that is due this frame. Workers only ever read tasks, never the tick lists.
+		struct TickTask
+		{
+			uint32_t EntryIndex;
+			TickFn pTickFn;
+			void* pTarget;
+			float DeltaMs;
+			bool OnGameThread;
+			// Range of m_Dependents holding the tasks waiting on this one.
+			uint32_t FirstDependent;
+			uint32_t NumDependents;
+		};
+
+		void TickGroupList(TickList& List);
+		void RemoveEntry(TickList& List, uint32_t Index);
+		// Seconds the owner's distance from the viewer allows between ticks.
+		float GetSignificanceInterval(Runtime::AActor* pOwner) const;
+
+		// Fill m_Dependents and the number of prerequisites of each task. Returns the number of tasks that may run on a worker.
+		uint32_t BuildTaskGraph(const TickList& List);
+		// Order the tasks so each runs after what it depends on, lowest index first. Returns false if they depend on each other in a cycle.
+		bool SortTasks(std::vector<uint32_t>& OutOrder) const;
+		void RunTasksInParallel();
+		// Tick a task unless its function was unregistered after the graph was built.
+		void RunTask(uint32_t TaskIndex);
+		// Queue the tasks that were only waiting on a finished one.
+		void FinishTask(uint32_t TaskIndex);
+		void StartWorkers();
+		void StopWorkers();
+		void WorkerThread();
+
+	private:
+		TickList m_Groups[static_cast<size_t>(TickGroup::NumGroups)];
+		SignificanceSettings m_Significance;
+		// Seconds ticked since the manager was created.
+		double m_Time = 0.0;
+		ieVector3 m_ViewerPosition;
+		TickList* m_pTickingList = nullptr;
+		std::thread::id m_GameThreadId;
+		uint32_t m_NumTickedLastFrame = 0u;
+		bool m_WarnedAboutCycle = false;
+
+		// The graph of the group being ticked, rebuilt every frame.
+		std::vector<TickTask> m_Tasks;
+		std::vector<uint32_t> m_NumPrerequisites;
+		std::vector<uint32_t> m_Dependents;
+		std::vector<std::pair<uint32_t, uint32_t>> m_Edges;
+		std::vector<uint32_t> m_TaskOrder;
+		// Task of each entry in the list being ticked, InvalidIndex if the entry is not due.
+		std::vector<uint32_t> m_TaskOfEntry;
+		// Latest task of each actor seen so far, indexed by ActorRegistry slot. Only the slots in m_OwnerSlots are set.
+		std::vector<uint32_t> m_LastTaskOfActorSlot;
+		std::vector<uint32_t> m_OwnerSlots;
+		// Tasks that read each TickAccess bit since it was last written.
+		std::vector<uint32_t> m_AccessReaders[64];
+		std::unique_ptr<std::atomic<uint32_t>[]> m_pPendingCounts;
+		std::unique_ptr<std::atomic<bool>[]> m_pCancelled;
+		size_t m_TaskCapacity = 0u;
+
+		// Tasks whose prerequisites have finished.
+		std::mutex m_QueueMutex;
+		std::condition_variable m_WorkerWake;
+		std::condition_variable m_GameThreadWake;
+		std::deque<uint32_t> m_WorkerQueue;
+		std::deque<uint32_t> m_GameThreadQueue;
+		std::atomic<uint32_t> m_NumTasksLeft{ 0u };
+		std::vector<std::thread> m_Workers;
+		bool m_StopWorkers = false;
+
+		static TickManager* s_pActive;
+		static bool s_SerialTicking;
+	};
+
+}
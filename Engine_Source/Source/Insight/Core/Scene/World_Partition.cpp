@@ -0,0 +1,241 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "World_Partition.h"
+
+#include "Insight/Core/Scene/Scene_Journal.h"
+#include "Insight/Core/Scene/Scene_Loader.h"
+
+#include <filesystem>
+#include <map>
+#include <set>
+
+namespace Insight {
+
+	static const char* const ActorsFileName = "/Actors.json";
+	static const char* const CellsFolderName = "/Cells";
+	static const char* const CellIndexFileName = "/Cells.json";
+	static const char* const AlwaysLoadedFileName = "/AlwaysLoaded.json";
+	// Cells are cooked into this folder and swapped in once every file has been written.
+	static const char* const CookingSuffix = ".cooking";
+
+	// The actors bucketed into one cell. Cooked files are only read by the engine, so they are written without whitespace.
+	struct CookedCell
+	{
+		CookedCell()
+			: Writer(Actors)
+		{
+			Writer.StartObject();
+			Writer.Key("Set");
+			Writer.StartArray();
+		}
+
+		rapidjson::StringBuffer Actors;
+		rapidjson::Writer<rapidjson::StringBuffer> Writer;
+		uint32_t NumActors = 0u;
+		std::set<std::string> Meshes;
+	};
+
+	static std::string GetCellFileName(int X, int Z)
+	{
+		return "/Cell_" + std::to_string(X) + "_" + std::to_string(Z) + ".json";
+	}
+
+	static bool WriteFile(const std::string& Path, const char* pData, size_t Size)
+	{
+		std::ofstream OutFile(Path, std::ios::binary | std::ios::trunc);
+		OutFile.write(pData, static_cast<std::streamsize>(Size));
+		return OutFile.good();
+	}
+
+	static bool WriteCell(const std::string& Path, CookedCell& Cell)
+	{
+		Cell.Writer.EndArray();
+		Cell.Writer.EndObject();
+		return WriteFile(Path, Cell.Actors.GetString(), Cell.Actors.GetSize());
+	}
+
+	// Collect the models of every static mesh component of an actor.
+	static void AddActorMeshes(const rapidjson::Value& JsonActor, std::set<std::string>& OutMeshes)
+	{
+		auto Subobjects = JsonActor.FindMember("Subobjects");
+		if (Subobjects == JsonActor.MemberEnd() || !Subobjects->value.IsArray())
+			return;
+
+		std::string MeshPath;
+		for (const rapidjson::Value& Subobject : Subobjects->value.GetArray())
+		{
+			if (!Subobject.IsObject())
+				continue;
+			auto StaticMesh = Subobject.FindMember("StaticMesh");
+			if (StaticMesh == Subobject.MemberEnd() || !StaticMesh->value.IsArray() || StaticMesh->value.Empty() || !StaticMesh->value[0].IsObject())
+				continue;
+
+			if (json::get_string(StaticMesh->value[0], "Mesh", MeshPath))
+				OutMeshes.insert(MeshPath);
+		}
+	}
+
+	bool WorldPartition::Cook(const std::string& SceneDirectory, float CellSize)
+	{
+		if (CellSize <= 0.0f) {
+			IE_DEBUG_LOG(LogSeverity::Error, "Failed to cook world partition for scene \"{0}\", the cell size must be greater than 0.", SceneDirectory);
+			return false;
+		}
+		const std::chrono::steady_clock::time_point CookStart = std::chrono::steady_clock::now();
+
+		// Cook what is saved, Actors.json with the journal's saves applied.
+		SceneJournal::Replay Journal;
+		SceneJournal::ReadReplay(SceneDirectory, Journal);
+
+		// Ordered so the cooked files are the same every time the same scene is cooked.
+		std::map<std::pair<int, int>, std::unique_ptr<CookedCell>> Cells;
+		CookedCell AlwaysLoaded;
+		uint32_t NumActors = 0u;
+
+		auto CookActor = [&](const JsonStream::ActorHeader& Header, const rapidjson::Value& JsonActor)
+		{
+			CookedCell* pCell = &AlwaysLoaded;
+			float X = 0.0f, Z = 0.0f;
+			if (GetActorPosition(Header, JsonActor, X, Z))
+			{
+				std::unique_ptr<CookedCell>& pBucket = Cells[{ GetCellCoord(X, CellSize), GetCellCoord(Z, CellSize) }];
+				if (!pBucket)
+					pBucket = std::make_unique<CookedCell>();
+				pCell = pBucket.get();
+			}
+			JsonActor.Accept(pCell->Writer);
+			AddActorMeshes(JsonActor, pCell->Meshes);
+			pCell->NumActors++;
+			NumActors++;
+		};
+
+		JsonStream::ActorReadStats Stats;
+		const bool ActorsRead = JsonStream::ReadActors((SceneDirectory + ActorsFileName).c_str(), [&](const JsonStream::ActorHeader& Header, const rapidjson::Value& JsonActor)
+		{
+			const rapidjson::Value* pJsonActor = &JsonActor;
+			if (!Journal.Find(Header.Index, pJsonActor))
+				CookActor(Header, JsonActor);
+			else if (pJsonActor)
+				CookActor(SceneLoader::ReadActorHeader(Header.Index, *pJsonActor), *pJsonActor);
+			return true;
+		}, &Stats);
+		if (!ActorsRead) {
+			IE_DEBUG_LOG(LogSeverity::Error, "Failed to cook world partition, could not read the actors of scene \"{0}\".", SceneDirectory);
+			return false;
+		}
+
+		// Actors added since Actors.json was written.
+		for (uint32_t Slot = Stats.NumActors; Slot < Journal.NumSlots; ++Slot)
+		{
+			const rapidjson::Value* pJsonActor = nullptr;
+			if (Journal.Find(Slot, pJsonActor) && pJsonActor)
+				CookActor(SceneLoader::ReadActorHeader(Slot, *pJsonActor), *pJsonActor);
+		}
+
+		// Write every file into a new folder so a failed cook leaves the previous cells in place.
+		const std::string CellsDirectory = SceneDirectory + CellsFolderName;
+		const std::string CookingDirectory = CellsDirectory + CookingSuffix;
+		std::error_code Error;
+		std::filesystem::remove_all(CookingDirectory, Error);
+		std::filesystem::create_directories(CookingDirectory, Error);
+
+		bool Written = !Error && WriteCell(CookingDirectory + AlwaysLoadedFileName, AlwaysLoaded);
+
+		rapidjson::StringBuffer StrBuffer;
+		rapidjson::PrettyWriter<rapidjson::StringBuffer> Writer(StrBuffer);
+		Writer.StartObject();
+		Writer.Key("CellSize");
+		Writer.Double(CellSize);
+		Writer.Key("Cells");
+		Writer.StartArray();
+		for (auto& Cell : Cells)
+		{
+			if (!Written)
+				break;
+
+			const int X = Cell.first.first;
+			const int Z = Cell.first.second;
+			Written = WriteCell(CookingDirectory + GetCellFileName(X, Z), *Cell.second);
+
+			Writer.StartObject();
+			Writer.Key("X");
+			Writer.Int(X);
+			Writer.Key("Z");
+			Writer.Int(Z);
+			Writer.Key("NumActors");
+			Writer.Uint(Cell.second->NumActors);
+			Writer.Key("Meshes");
+			Writer.StartArray();
+			for (const std::string& MeshPath : Cell.second->Meshes)
+				Writer.String(MeshPath.c_str());
+			Writer.EndArray();
+			Writer.EndObject();
+		}
+		Writer.EndArray();
+		Writer.EndObject();
+
+		Written = Written && WriteFile(CookingDirectory + CellIndexFileName, StrBuffer.GetString(), StrBuffer.GetSize());
+		if (Written)
+		{
+			std::filesystem::remove_all(CellsDirectory, Error);
+			std::filesystem::rename(CookingDirectory, CellsDirectory, Error);
+			Written = !Error;
+		}
+		if (!Written) {
+			IE_DEBUG_LOG(LogSeverity::Error, "Failed to write the world partition cells of scene \"{0}\".", SceneDirectory);
+			std::filesystem::remove_all(CookingDirectory, Error);
+			return false;
+		}
+
+		const double CookMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - CookStart).count();
+		IE_DEBUG_LOG(LogSeverity::Log, "Cooked {0} actors of scene \"{1}\" into {2} cells of {3} units in {4:.2f}ms, {5} actors are always loaded.",
+			NumActors, SceneDirectory, Cells.size(), CellSize, CookMs, AlwaysLoaded.NumActors);
+		return true;
+	}
+
+	bool WorldPartition::ReadCellIndex(const std::string& SceneDirectory, CellIndex& OutIndex)
+	{
+		const std::string IndexPath = SceneDirectory + CellsFolderName + CellIndexFileName;
+		return JsonStream::ReadWorldCells(IndexPath.c_str(), OutIndex.CellSize, OutIndex.Cells) && OutIndex.CellSize > 0.0f;
+	}
+
+	std::string WorldPartition::GetCellPath(const std::string& SceneDirectory, int X, int Z)
+	{
+		return SceneDirectory + CellsFolderName + GetCellFileName(X, Z);
+	}
+
+	std::string WorldPartition::GetAlwaysLoadedPath(const std::string& SceneDirectory)
+	{
+		return SceneDirectory + CellsFolderName + AlwaysLoadedFileName;
+	}
+
+	bool WorldPartition::GetActorPosition(const JsonStream::ActorHeader& Header, const rapidjson::Value& JsonActor, float& OutX, float& OutZ)
+	{
+		// Lights, the sky and post fx volumes affect the whole world.
+		if (Header.Type != "Actor")
+			return false;
+
+		auto Subobjects = JsonActor.FindMember("Subobjects");
+		if (Subobjects == JsonActor.MemberEnd() || !Subobjects->value.IsArray())
+			return false;
+
+		// Same layout SceneComponent::LoadFromJson reads: { "SceneComponent": [ { "Transform": [ { "posX", ... } ] } ] }
+		for (const rapidjson::Value& Subobject : Subobjects->value.GetArray())
+		{
+			if (!Subobject.IsObject())
+				continue;
+			auto SceneComponent = Subobject.FindMember("SceneComponent");
+			if (SceneComponent == Subobject.MemberEnd() || !SceneComponent->value.IsArray() || SceneComponent->value.Empty() || !SceneComponent->value[0].IsObject())
+				continue;
+
+			auto Transform = SceneComponent->value[0].FindMember("Transform");
+			if (Transform == SceneComponent->value[0].MemberEnd() || !Transform->value.IsArray() || Transform->value.Empty() || !Transform->value[0].IsObject())
+				continue;
+
+			return json::get_float(Transform->value[0], "posX", OutX) && json::get_float(Transform->value[0], "posZ", OutZ);
+		}
+		return false;
+	}
+
+}
@@ -0,0 +1,70 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - World_Partition.h
+	Source - World_Partition.cpp
+
+	Purpose:
+	Cooks the actors of a scene into square grid cells that can be streamed in and out around the viewer.
+
+	Description:
+	A scene is partitioned when its Meta.json has a "WorldCellSize" greater than 0. After such a scene
+	is saved the Application cooks it on a worker thread, the save itself does not wait for it. The
+	cooker reads Actors.json, applies the scene's journal and buckets each actor by the X and Z
+	position of its SceneComponent. Everything is written to the Cells folder of the scene:
+	Cells.json			- The cell size and each cell's coordinate, actor count and the models its actors use.
+	Cell_X_Z.json		- The actors of one cell, in the same format as Actors.json.
+	AlwaysLoaded.json	- Actors that are not placed in the world by a SceneComponent (lights, sky, post fx)
+						  and are loaded with the scene.
+	The editor always loads Actors.json so the whole world can be edited and saved. Game builds load
+	AlwaysLoaded.json with the scene and the scene's WorldStreamer streams the cells.
+
+	Example Usage:
+	WorldPartition::Cook("../Content/Scenes/Norway.iescene", 128.0f);
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+#include "Insight/Systems/Json_Stream_Reader.h"
+
+#include <cmath>
+
+namespace Insight {
+
+	class INSIGHT_API WorldPartition
+	{
+	public:
+		// The cooked cells of a scene.
+		struct CellIndex
+		{
+			float CellSize = 0.0f;
+			std::vector<JsonStream::WorldCell> Cells;
+		};
+
+	public:
+		/*
+			Bucket the saved actors of a scene into cells and write them to the scene's Cells folder.
+			Cells cooked before are replaced. Returns false if the scene could not be read or the cells could not be written.
+			@param SceneDirectory - Exe relative path to the .iescene folder.
+			@param CellSize - Width of a cell on the X and Z axis in world units.
+		*/
+		static bool Cook(const std::string& SceneDirectory, float CellSize);
+
+		// Read the cells cooked for a scene. Returns false if the scene has not been cooked.
+		static bool ReadCellIndex(const std::string& SceneDirectory, CellIndex& OutIndex);
+
+		static std::string GetCellPath(const std::string& SceneDirectory, int X, int Z);
+		static std::string GetAlwaysLoadedPath(const std::string& SceneDirectory);
+
+		// The cell a world position is in.
+		static inline int GetCellCoord(float Position, float CellSize) { return static_cast<int>(std::floor(Position / CellSize)); }
+
+	private:
+		/*
+			Find where an actor is placed in the world.
+			Returns false for actors that have no SceneComponent, they are loaded with the scene.
+		*/
+		static bool GetActorPosition(const JsonStream::ActorHeader& Header, const rapidjson::Value& JsonActor, float& OutX, float& OutZ);
+	};
+
+}
@@ -0,0 +1,344 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "World_Streamer.h"
+
+#include "Insight/Core/Application.h"
+#include "Insight/Core/Scene/Scene.h"
+#include "Insight/Core/Scene/Scene_Loader.h"
+#include "Insight/Runtime/AActor.h"
+#include "Insight/Rendering/Geometry/Model.h"
+#include "Insight/Rendering/Geometry/Mesh_Import_Cache.h"
+#include "Insight/Systems/Virtual_File_System.h"
+
+namespace Insight {
+
+	static float MillisecondsSince(std::chrono::steady_clock::time_point Start)
+	{
+		return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - Start).count();
+	}
+
+	template <typename ResultType>
+	static bool IsReady(const std::future<ResultType>& Future)
+	{
+		return Future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+	}
+
+	WorldStreamer::~WorldStreamer()
+	{
+		Shutdown();
+	}
+
+	void WorldStreamer::Init(const std::string& SceneDirectory, WorldPartition::CellIndex Index, Scene* pScene)
+	{
+		Shutdown();
+
+		m_SceneDirectory = SceneDirectory;
+		m_pScene = pScene;
+		m_CellSize = Index.CellSize;
+		m_Cells.resize(Index.Cells.size());
+		m_CellLookup.reserve(Index.Cells.size());
+		for (uint32_t i = 0u; i < Index.Cells.size(); ++i)
+		{
+			m_Cells[i].Info = std::move(Index.Cells[i]);
+			m_CellLookup[GetCellKey(m_Cells[i].Info.X, m_Cells[i].Info.Z)] = i;
+		}
+
+		IE_DEBUG_LOG(LogSeverity::Log, "Streaming {0} world cells of {1} units for scene \"{2}\".", m_Cells.size(), m_CellSize, SceneDirectory);
+	}
+
+	void WorldStreamer::Shutdown()
+	{
+		for (uint32_t CellIndex : m_ActiveCells)
+		{
+			StreamingCell& Cell = m_Cells[CellIndex];
+			if (Cell.Read.valid())
+				Cell.pActors = Cell.Read.get();
+			ReleaseCellActors(Cell);
+		}
+
+		m_SceneDirectory.clear();
+		m_pScene = nullptr;
+		m_Stats = Stats();
+		m_Cells.clear();
+		m_CellLookup.clear();
+		m_ActiveCells.clear();
+		m_MeshUsers.clear();
+	}
+
+	void WorldStreamer::Update(const ieVector3& ViewerPosition)
+	{
+		if (!IsActive())
+			return;
+
+		UpdateCellDistances(ViewerPosition);
+		StartLoadingCellsInRange(ViewerPosition);
+		FinishReadingCells();
+		InstantiateActors();
+		TeardownActors();
+
+		m_Stats.NumCellsLoaded = 0u;
+		m_Stats.NumCellsInFlight = 0u;
+		m_Stats.NumActorsStreamed = 0u;
+		for (uint32_t CellIndex : m_ActiveCells)
+		{
+			const StreamingCell& Cell = m_Cells[CellIndex];
+			if (Cell.State == CellState::Loaded)
+				m_Stats.NumCellsLoaded++;
+			else if (Cell.State == CellState::Reading || Cell.State == CellState::Instantiating)
+				m_Stats.NumCellsInFlight++;
+			m_Stats.NumActorsStreamed += static_cast<uint32_t>(Cell.SceneActors.size());
+		}
+
+		m_ActiveCells.erase(std::remove_if(m_ActiveCells.begin(), m_ActiveCells.end(),
+			[this](uint32_t CellIndex) { return m_Cells[CellIndex].State == CellState::Unloaded; }), m_ActiveCells.end());
+	}
+
+	void WorldStreamer::UpdateCellDistances(const ieVector3& ViewerPosition)
+	{
+		const float UnloadRadius = std::max(m_Settings.UnloadRadius, m_Settings.LoadRadius);
+		for (uint32_t CellIndex : m_ActiveCells)
+		{
+			StreamingCell& Cell = m_Cells[CellIndex];
+			Cell.Distance = GetDistanceToCell(Cell.Info, ViewerPosition);
+			if (Cell.Distance <= UnloadRadius)
+				continue;
+
+			// Cells being read are dropped once the read finishes, see FinishReadingCells.
+			if (Cell.State == CellState::Instantiating || Cell.State == CellState::Loaded)
+			{
+				ReleaseCellActors(Cell);
+				Cell.State = CellState::Unloading;
+			}
+		}
+	}
+
+	void WorldStreamer::StartLoadingCellsInRange(const ieVector3& ViewerPosition)
+	{
+		uint32_t NumReading = 0u;
+		for (uint32_t CellIndex : m_ActiveCells)
+		{
+			if (m_Cells[CellIndex].State == CellState::Reading)
+				NumReading++;
+		}
+		if (NumReading >= m_Settings.MaxCellsReading)
+			return;
+
+		// Only the cells under the load radius are looked up, not every cell in the world.
+		const float Radius = m_Settings.LoadRadius;
+		const int MinX = WorldPartition::GetCellCoord(ViewerPosition.x - Radius, m_CellSize);
+		const int MaxX = WorldPartition::GetCellCoord(ViewerPosition.x + Radius, m_CellSize);
+		const int MinZ = WorldPartition::GetCellCoord(ViewerPosition.z - Radius, m_CellSize);
+		const int MaxZ = WorldPartition::GetCellCoord(ViewerPosition.z + Radius, m_CellSize);
+
+		std::vector<std::pair<float, uint32_t>> InRange;
+		for (int X = MinX; X <= MaxX; ++X)
+		{
+			for (int Z = MinZ; Z <= MaxZ; ++Z)
+			{
+				auto Iter = m_CellLookup.find(GetCellKey(X, Z));
+				if (Iter == m_CellLookup.end() || m_Cells[Iter->second].State != CellState::Unloaded)
+					continue;
+
+				const float Distance = GetDistanceToCell(m_Cells[Iter->second].Info, ViewerPosition);
+				if (Distance <= Radius)
+					InRange.emplace_back(Distance, Iter->second);
+			}
+		}
+
+		std::sort(InRange.begin(), InRange.end());
+		for (size_t i = 0u; i < InRange.size() && NumReading < m_Settings.MaxCellsReading; ++i, ++NumReading)
+		{
+			m_Cells[InRange[i].second].Distance = InRange[i].first;
+			StartReading(InRange[i].second);
+		}
+	}
+
+	void WorldStreamer::FinishReadingCells()
+	{
+		const float UnloadRadius = std::max(m_Settings.UnloadRadius, m_Settings.LoadRadius);
+		for (uint32_t CellIndex : m_ActiveCells)
+		{
+			StreamingCell& Cell = m_Cells[CellIndex];
+			if (Cell.State != CellState::Reading || !IsReady(Cell.Read))
+				continue;
+
+			Cell.pActors = Cell.Read.get();
+			Cell.NextActor = 0u;
+			if (Cell.Distance > UnloadRadius)
+			{
+				// The viewer moved away while the cell was read.
+				ReleaseCellActors(Cell);
+				Cell.State = CellState::Unloaded;
+				continue;
+			}
+			Cell.SceneActors.reserve(Cell.pActors->Actors.size());
+			Cell.State = CellState::Instantiating;
+		}
+	}
+
+	void WorldStreamer::InstantiateActors()
+	{
+		std::vector<StreamingCell*> Instantiating;
+		for (uint32_t CellIndex : m_ActiveCells)
+		{
+			if (m_Cells[CellIndex].State == CellState::Instantiating)
+				Instantiating.push_back(&m_Cells[CellIndex]);
+		}
+		std::sort(Instantiating.begin(), Instantiating.end(), [](const StreamingCell* pA, const StreamingCell* pB) { return pA->Distance < pB->Distance; });
+
+		const std::chrono::steady_clock::time_point Start = std::chrono::steady_clock::now();
+		const bool IsPlaying = Application::IsPlaySessionUnderWay();
+		uint32_t NumCreated = 0u;
+		for (StreamingCell* pCell : Instantiating)
+		{
+			const CellActors& Actors = *pCell->pActors;
+			while (pCell->NextActor < Actors.Actors.size())
+			{
+				// Always make progress, at least one actor is created per update.
+				if (NumCreated > 0u && MillisecondsSince(Start) >= m_Settings.LoadBudgetMs)
+				{
+					m_Stats.LastInstantiateMs = MillisecondsSince(Start);
+					return;
+				}
+
+				const size_t ActorIndex = pCell->NextActor++;
+				const JsonStream::ActorHeader& Header = Actors.Headers[ActorIndex];
+				Runtime::AActor* pNewActor = SceneLoader::CreateActor(Header, m_pScene->GetNumSceneActors());
+				if (pNewActor == nullptr) {
+					IE_DEBUG_LOG(LogSeverity::Error, "Failed to stream actor \"{0}\" of world cell ({1}, {2}) into scene", (Header.DisplayName == "") ? "INVALID NAME" : Header.DisplayName, pCell->Info.X, pCell->Info.Z);
+					continue;
+				}
+				pNewActor->LoadFromJson(Actors.Actors[ActorIndex]);
+				// Registers the actor's tick functions if play has begun.
+				m_pScene->AddActor(pNewActor);
+
+				// The scene has already been post initialized, bring the actor up to the same point.
+				pNewActor->OnPostInit();
+				if (IsPlaying)
+					pNewActor->BeginPlay();
+
+				pCell->SceneActors.push_back(ActorRef(pNewActor));
+				NumCreated++;
+			}
+
+			ReleaseCellActors(*pCell);
+			pCell->State = CellState::Loaded;
+		}
+		m_Stats.LastInstantiateMs = MillisecondsSince(Start);
+	}
+
+	void WorldStreamer::TeardownActors()
+	{
+		const std::chrono::steady_clock::time_point Start = std::chrono::steady_clock::now();
+		uint32_t NumRemoved = 0u;
+		for (uint32_t CellIndex : m_ActiveCells)
+		{
+			StreamingCell& Cell = m_Cells[CellIndex];
+			if (Cell.State != CellState::Unloading)
+				continue;
+
+			while (!Cell.SceneActors.empty())
+			{
+				if (NumRemoved > 0u && MillisecondsSince(Start) >= m_Settings.UnloadBudgetMs)
+				{
+					m_Stats.LastTeardownMs = MillisecondsSince(Start);
+					return;
+				}
+
+				// The actor is deleted by the end of frame sweep, see Memory::DeferredDestructionQueue.
+				if (Runtime::AActor* pActor = Cell.SceneActors.back().Get())
+				{
+					m_pScene->RemoveActor(pActor);
+					NumRemoved++;
+				}
+				Cell.SceneActors.pop_back();
+			}
+			Cell.State = CellState::Unloaded;
+		}
+		m_Stats.LastTeardownMs = MillisecondsSince(Start);
+	}
+
+	void WorldStreamer::StartReading(uint32_t CellIndex)
+	{
+		StreamingCell& Cell = m_Cells[CellIndex];
+		Cell.MeshImportPaths.clear();
+		for (const std::string& MeshPath : Cell.Info.Meshes)
+		{
+			Cell.MeshImportPaths.push_back(Model::GetImportPath(MeshPath));
+			m_MeshUsers[StringId::Intern(Cell.MeshImportPaths.back())]++;
+		}
+
+		Cell.Read = std::async(std::launch::async, &WorldStreamer::ReadCell, WorldPartition::GetCellPath(m_SceneDirectory, Cell.Info.X, Cell.Info.Z), Cell.MeshImportPaths);
+		Cell.State = CellState::Reading;
+		m_ActiveCells.push_back(CellIndex);
+	}
+
+	std::shared_ptr<WorldStreamer::CellActors> WorldStreamer::ReadCell(const std::string CellPath, const std::vector<std::string> MeshImportPaths)
+	{
+		std::shared_ptr<CellActors> pActors = std::make_shared<CellActors>();
+
+#if defined (IE_PLATFORM_BUILD_WIN32)
+		// A model shared with a cell that is already streaming is only imported once.
+		for (const std::string& ImportPath : MeshImportPaths)
+			MeshImportCache::Get().Prefetch(ImportPath);
+#endif
+
+		// Every actor of the cell is kept until it is created, so the whole file is parsed at once.
+		const FileView CellFile = VirtualFileSystem::Get().Read(CellPath);
+		if (CellFile)
+			pActors->Json.Parse(CellFile.GetChars(), CellFile.GetSize());
+
+		auto Set = pActors->Json.IsObject() ? pActors->Json.FindMember("Set") : pActors->Json.MemberEnd();
+		if (!CellFile || pActors->Json.HasParseError() || !pActors->Json.IsObject() || Set == pActors->Json.MemberEnd() || !Set->value.IsArray())
+		{
+			IE_DEBUG_LOG(LogSeverity::Error, "Failed to read world cell \"{0}\". Its actors will not be streamed in.", CellPath);
+		}
+		else
+		{
+			uint32_t Index = 0u;
+			for (const rapidjson::Value& JsonActor : Set->value.GetArray())
+			{
+				if (!JsonActor.IsObject())
+					continue;
+				pActors->Headers.push_back(SceneLoader::ReadActorHeader(Index++, JsonActor));
+				pActors->Actors.push_back(&JsonActor);
+			}
+		}
+
+#if defined (IE_PLATFORM_BUILD_WIN32)
+		// Wait for the imports here so creating the actors on the game thread never blocks on one.
+		for (const std::string& ImportPath : MeshImportPaths)
+			MeshImportCache::Get().Acquire(ImportPath);
+#endif
+		return pActors;
+	}
+
+	void WorldStreamer::ReleaseCellActors(StreamingCell& Cell)
+	{
+		Cell.pActors.reset();
+		Cell.NextActor = 0u;
+
+		// A model stays prefetched while another cell that uses it is still streaming in.
+		for (const std::string& ImportPath : Cell.MeshImportPaths)
+		{
+			auto Iter = m_MeshUsers.find(StringId::Intern(ImportPath));
+			if (Iter == m_MeshUsers.end() || --Iter->second > 0u)
+				continue;
+
+			m_MeshUsers.erase(Iter);
+			MeshImportCache::Get().Release(ImportPath);
+		}
+		Cell.MeshImportPaths.clear();
+	}
+
+	float WorldStreamer::GetDistanceToCell(const JsonStream::WorldCell& Cell, const ieVector3& Position) const
+	{
+		const float MinX = static_cast<float>(Cell.X) * m_CellSize;
+		const float MinZ = static_cast<float>(Cell.Z) * m_CellSize;
+		const float DistanceX = std::max(std::max(MinX - Position.x, Position.x - (MinX + m_CellSize)), 0.0f);
+		const float DistanceZ = std::max(std::max(MinZ - Position.z, Position.z - (MinZ + m_CellSize)), 0.0f);
+		return std::sqrt(DistanceX * DistanceX + DistanceZ * DistanceZ);
+	}
+
+}
@@ -0,0 +1,163 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - World_Streamer.h
+	Source - World_Streamer.cpp
+
+	Purpose:
+	Loads and unloads the cells of a partitioned scene around the viewer. See WorldPartition.
+
+	Description:
+	Each frame the cells whose nearest point on the X Z plane is within LoadRadius of the viewer are
+	streamed in, and loaded cells further than UnloadRadius are streamed out. UnloadRadius is larger
+	than LoadRadius so a viewer moving along a cell border does not load and unload the same cell
+	every frame. A cell moves through these states:
+	Unloaded		- Nothing of the cell is in memory.
+	Reading			- The cell's file is parsed and its models are imported on a worker thread.
+					  At most MaxCellsReading cells are read at once, nearest first.
+	Instantiating	- The cell's actors are created on the game thread, as many per frame as fit in
+					  LoadBudgetMs, nearest cell first.
+	Loaded			- Every actor of the cell is in the scene.
+	Unloading		- The cell's actors are removed from the scene, as many per frame as fit in UnloadBudgetMs.
+	Actors are always created and removed whole, so a frame can run over its budget by at most one actor.
+
+	Example Usage:
+	// Game thread, once per frame.
+	m_WorldStreamer.Update(ViewerPosition);
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+#include "Insight/Math/Transform.h"
+#include "Insight/Core/Scene/World_Partition.h"
+#include "Insight/Core/Scene/Actor_Registry.h"
+#include "Insight/Utilities/String_Id.h"
+
+namespace Insight {
+
+	namespace Runtime {
+		class AActor;
+	}
+
+	class Scene;
+
+	class INSIGHT_API WorldStreamer
+	{
+	public:
+		struct Settings
+		{
+			// Cells closer than this to the viewer are loaded.
+			float LoadRadius = 256.0f;
+			// Loaded cells are kept until they are further than this from the viewer. Clamped to at least LoadRadius.
+			float UnloadRadius = 320.0f;
+			// Game thread time per frame spent creating the actors of cells that were read.
+			float LoadBudgetMs = 2.0f;
+			// Game thread time per frame spent removing the actors of cells that went out of range.
+			float UnloadBudgetMs = 1.0f;
+			// Cells read on worker threads at the same time.
+			uint32_t MaxCellsReading = 4u;
+		};
+
+		struct Stats
+		{
+			uint32_t NumCellsLoaded = 0u;
+			uint32_t NumCellsInFlight = 0u;
+			uint32_t NumActorsStreamed = 0u;
+			// Game thread time the last update spent creating and removing actors.
+			float LastInstantiateMs = 0.0f;
+			float LastTeardownMs = 0.0f;
+		};
+
+	public:
+		WorldStreamer() = default;
+		~WorldStreamer();
+
+		WorldStreamer(const WorldStreamer&) = delete;
+		WorldStreamer& operator = (const WorldStreamer&) = delete;
+
+		/*
+			Start streaming the cooked cells of a scene.
+			@param SceneDirectory - Exe relative path to the .iescene folder the cells were cooked for.
+			@param Index - The scene's cells, see WorldPartition::ReadCellIndex.
+			@param pScene - Scene streamed actors are added to.
+		*/
+		void Init(const std::string& SceneDirectory, WorldPartition::CellIndex Index, Scene* pScene);
+		// Stop streaming. Waits for cells being read. Streamed actors are left in the scene for it to destroy.
+		void Shutdown();
+
+		// Load and unload cells around the viewer. Call once per frame from the game thread.
+		void Update(const ieVector3& ViewerPosition);
+
+		inline bool IsActive() const { return m_pScene != nullptr; }
+		inline void SetSettings(const Settings& NewSettings) { m_Settings = NewSettings; }
+		inline const Settings& GetSettings() const { return m_Settings; }
+		inline const Stats& GetStats() const { return m_Stats; }
+
+	private:
+		enum class CellState : uint8_t
+		{
+			Unloaded,
+			Reading,
+			Instantiating,
+			Loaded,
+			Unloading,
+		};
+
+		// A cell's actors, parsed on a worker thread.
+		struct CellActors
+		{
+			rapidjson::Document Json;
+			std::vector<JsonStream::ActorHeader> Headers;
+			std::vector<const rapidjson::Value*> Actors;
+		};
+
+		struct StreamingCell
+		{
+			JsonStream::WorldCell Info;
+			CellState State = CellState::Unloaded;
+			// Distance from the viewer on the last update.
+			float Distance = 0.0f;
+
+			// Exe relative paths of the models the cell's actors use, prefetched while the cell is read.
+			std::vector<std::string> MeshImportPaths;
+			std::future<std::shared_ptr<CellActors>> Read;
+			std::shared_ptr<CellActors> pActors;
+			// Next actor of pActors to create.
+			size_t NextActor = 0u;
+			// Actors of the cell that are in the scene. Gameplay or the editor may destroy them before the cell unloads.
+			std::vector<ActorRef> SceneActors;
+		};
+
+		// Parse a cell file and wait for its models to import. Runs on a worker thread.
+		static std::shared_ptr<CellActors> ReadCell(const std::string CellPath, const std::vector<std::string> MeshImportPaths);
+
+		void UpdateCellDistances(const ieVector3& ViewerPosition);
+		void StartLoadingCellsInRange(const ieVector3& ViewerPosition);
+		void FinishReadingCells();
+		void InstantiateActors();
+		void TeardownActors();
+
+		void StartReading(uint32_t CellIndex);
+		// Drop a cell's parsed json and release its prefetched models.
+		void ReleaseCellActors(StreamingCell& Cell);
+
+		// Distance from a point to the nearest point of a cell on the X Z plane.
+		float GetDistanceToCell(const JsonStream::WorldCell& Cell, const ieVector3& Position) const;
+		static inline uint64_t GetCellKey(int X, int Z) { return (static_cast<uint64_t>(static_cast<uint32_t>(X)) << 32u) | static_cast<uint32_t>(Z); }
+
+	private:
+		std::string m_SceneDirectory;
+		Scene* m_pScene = nullptr;
+		Settings m_Settings;
+		Stats m_Stats;
+
+		float m_CellSize = 0.0f;
+		std::vector<StreamingCell> m_Cells;
+		std::unordered_map<uint64_t, uint32_t> m_CellLookup;
+		// Cells that are not unloaded, indices into m_Cells.
+		std::vector<uint32_t> m_ActiveCells;
+		// Number of reading and instantiating cells that use each prefetched model, keyed by the id of its import path.
+		std::unordered_map<StringId, uint32_t> m_MeshUsers;
+	};
+
+}
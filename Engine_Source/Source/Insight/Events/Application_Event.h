@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Event.h"
+#include "Insight/Math/ie_Matricies.h"
 
 namespace Insight {
 
@@ -78,7 +79,7 @@ namespace Insight {
 
 		struct TranslationDetails
 		{
-			ieMatrix4x4 WorldMat;
+			Math::ieMatrix4x4 WorldMat;
 		} TranslationInfo;
 	};
 
@@ -153,4 +154,13 @@ namespace Insight {
 		EVENT_CLASS_TYPE(ShaderReload)
 			EVENT_CLASS_CATEGORY(EventCategoryApplication)
 	};
+
+	class INSIGHT_API AssetReloadEvent : public RendererEvent
+	{
+	public:
+		AssetReloadEvent() {}
+
+		EVENT_CLASS_TYPE(AssetReload)
+			EVENT_CLASS_CATEGORY(EventCategoryApplication)
+	};
 }
\ No newline at end of file
@@ -0,0 +1,79 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Delegate.h
+
+	Purpose:
+	Non-owning, allocation free callable bound to a free function or a member function.
+
+	Description:
+	A delegate is two pointers wide (instance + stub) so arrays of them are contiguous
+	and cheap to walk. Unlike std::function it never heap allocates and the call
+	compiles down to a single indirect call.
+
+	Example Usage:
+	Delegate<bool(WindowResizeEvent&)> Handler = Delegate<bool(WindowResizeEvent&)>::FromMethod<Renderer, &Renderer::OnWindowResize>(this);
+	Handler(e);
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+namespace Insight {
+
+	template <typename Signature>
+	class Delegate;
+
+	template <typename ReturnType, typename ... Args>
+	class Delegate<ReturnType(Args...)>
+	{
+		using StubFn = ReturnType(*)(void*, Args...);
+	public:
+		Delegate() = default;
+
+		// Bind a member function to an object instance. The object must outlive the delegate.
+		template <typename Class, ReturnType(Class::*Method)(Args...)>
+		static Delegate FromMethod(Class* pInstance)
+		{
+			return Delegate(pInstance, &MethodStub<Class, Method>);
+		}
+
+		// Bind a free or static function.
+		template <ReturnType(*Function)(Args...)>
+		static Delegate FromFunction()
+		{
+			return Delegate(nullptr, &FunctionStub<Function>);
+		}
+
+		inline ReturnType operator () (Args ... Arguments) const
+		{
+			return m_pStub(m_pInstance, std::forward<Args>(Arguments)...);
+		}
+
+		inline bool IsBound() const { return m_pStub != nullptr; }
+		inline void* GetInstance() const { return m_pInstance; }
+
+		bool operator == (const Delegate& Other) const { return m_pInstance == Other.m_pInstance && m_pStub == Other.m_pStub; }
+		bool operator != (const Delegate& Other) const { return !(*this == Other); }
+
+	private:
+		Delegate(void* pInstance, StubFn pStub)
+			: m_pInstance(pInstance), m_pStub(pStub) {}
+
+		template <typename Class, ReturnType(Class::*Method)(Args...)>
+		static ReturnType MethodStub(void* pInstance, Args ... Arguments)
+		{
+			return (static_cast<Class*>(pInstance)->*Method)(std::forward<Args>(Arguments)...);
+		}
+
+		template <ReturnType(*Function)(Args...)>
+		static ReturnType FunctionStub(void*, Args ... Arguments)
+		{
+			return Function(std::forward<Args>(Arguments)...);
+		}
+
+	private:
+		void* m_pInstance = nullptr;
+		StubFn m_pStub = nullptr;
+	};
+
+}
@@ -15,7 +15,12 @@ namespace Insight {
 		SceneSave,
 		KeyPressed, KeyReleased, KeyTyped, KeyHeld,
 		MouseButtonPressed, MouseButtonReleased, MouseMoved, RawMouseMoved, MouseScrolled,
-		PhysicsCollisionEvent, WorldTranslationEvent
+		PhysicsCollisionEvent, WorldTranslationEvent,
+		// Added after the input events so the ids in recorded input files stay the same.
+		AssetReload,
+
+		// Not an event. Number of event types, must remain last.
+		NumEventTypes
 	};
 
 	enum EventCategory
@@ -30,7 +35,7 @@ namespace Insight {
 		EventCategoryTranslation = BIT_SHIFT(6)
 	};
 
-#define EVENT_CLASS_TYPE(type) static EventType GetStaticType() { return EventType::##type; }\
+#define EVENT_CLASS_TYPE(type) static constexpr EventType GetStaticType() { return EventType::type; }\
 								virtual EventType GetEventType() const override { return GetStaticType(); }\
 								virtual const char* GetName() const override { return #type; }
 
@@ -39,6 +44,7 @@ namespace Insight {
 	class INSIGHT_API Event
 	{
 		friend class EventDispatcher;
+		friend class EventBus;
 	public:
 		virtual EventType GetEventType() const = 0;
 		virtual const char * GetName() const = 0;
@@ -89,19 +95,18 @@ namespace Insight {
 
 	class INSIGHT_API EventDispatcher
 	{
-		template<typename Event>
-		using EventFn = std::function<bool(Event&)>;
-
 	public:
 		EventDispatcher(Event& event)
 			: m_Event(event) {}
 
-		template<typename Func>
-		bool Dispatch(EventFn<Func> func)
+		// Invoke Func if the event is of type EventClass. Func is called directly
+		// rather than through a std::function so it can be inlined.
+		template<typename EventClass, typename Fn>
+		bool Dispatch(Fn&& Func)
 		{
-			if (m_Event.GetEventType() == Func::GetStaticType())
+			if (m_Event.GetEventType() == EventClass::GetStaticType())
 			{
-				m_Event.m_Handled = func(*(Func*)&m_Event);
+				m_Event.m_Handled = Func(static_cast<EventClass&>(m_Event));
 				return true;
 			}
 			return false;
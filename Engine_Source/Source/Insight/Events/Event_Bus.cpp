@@ -0,0 +1,66 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Event_Bus.h"
+
+namespace Insight {
+
+	EventBus::EventBus()
+	{
+		for (uint32_t i = 0; i < NumChannels; ++i)
+			m_Channels[i].store(nullptr, std::memory_order_relaxed);
+	}
+
+	EventBus::~EventBus()
+	{
+		for (uint32_t i = 0; i < NumChannels; ++i)
+		{
+			delete m_Channels[i].load(std::memory_order_relaxed);
+			m_Channels[i].store(nullptr, std::memory_order_relaxed);
+		}
+	}
+
+	bool EventBus::Publish(Event& e)
+	{
+		const uint32_t Id = static_cast<uint32_t>(e.GetEventType());
+		if (Id >= NumChannels) return false;
+
+		ChannelBase* pChannel = m_Channels[Id].load(std::memory_order_acquire);
+		return pChannel ? pChannel->DeliverErased(e) : false;
+	}
+
+	void EventBus::Flush()
+	{
+		// Only events queued before the flush started are delivered, ones queued by handlers wait for the next flush.
+		ChannelBase* PendingChannels[NumChannels];
+		uint32_t NumPending = 0u;
+		for (uint32_t i = 0; i < NumChannels; ++i)
+		{
+			ChannelBase* pChannel = m_Channels[i].load(std::memory_order_acquire);
+			if (pChannel && pChannel->CollectQueue())
+				PendingChannels[NumPending++] = pChannel;
+		}
+
+		// Merge the channels by sequence. The channel holding the oldest event delivers everything
+		// older than the next oldest event of any other channel, so runs of one type stay batched.
+		while (NumPending > 0u)
+		{
+			uint32_t Oldest = 0u;
+			for (uint32_t i = 1u; i < NumPending; ++i)
+			{
+				if (PendingChannels[i]->GetNextSequence() < PendingChannels[Oldest]->GetNextSequence())
+					Oldest = i;
+			}
+			uint64_t EndSequence = UINT64_MAX;
+			for (uint32_t i = 0u; i < NumPending; ++i)
+			{
+				if (i != Oldest && PendingChannels[i]->GetNextSequence() < EndSequence)
+					EndSequence = PendingChannels[i]->GetNextSequence();
+			}
+
+			if (!PendingChannels[Oldest]->DeliverPending(EndSequence))
+				PendingChannels[Oldest] = PendingChannels[--NumPending];
+		}
+	}
+
+}
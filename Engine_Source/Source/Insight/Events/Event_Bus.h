@@ -0,0 +1,225 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Event_Bus.h
+	Source - Event_Bus.cpp
+
+	Purpose:
+	Typed publish/subscribe hub for engine events.
+
+	Description:
+	Every event type owns a channel indexed by its compile-time EventType id. A channel
+	holds a contiguous array of delegates (no std::function, no allocations per dispatch)
+	and a lock-free MPSC queue. Publish delivers immediately on the calling thread.
+	Enqueue may be called from any thread; queued events are delivered when the owning
+	thread calls Flush (usually once per frame). Every queued event is stamped with a bus
+	wide sequence number, and Flush merges the channels by it, so events of different types
+	are delivered in the order they were enqueued (Ex. a key press before its release).
+	Consecutive events of one type are still delivered as a batch without switching channels.
+	No queued event is ever dropped. When a queue is full the event goes to a locked
+	overflow list instead, and so does everything enqueued after it until the next Flush,
+	so events of a type are still delivered in the order they were enqueued.
+
+	Example Usage:
+	m_EventBus.Subscribe<WindowResizeEvent, Renderer, &Renderer::OnWindowResize>(this);
+	...
+	// Game thread
+	m_EventBus.Enqueue(WindowResizeEvent(Width, Height, false));
+	// Render thread, start of frame
+	m_EventBus.Flush();
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+#include "Insight/Events/Event.h"
+#include "Insight/Events/Delegate.h"
+#include "Insight/Events/MPSC_Queue.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace Insight {
+
+	// Compile-time id for an event class. Usable as an array index.
+	template <typename EventClass>
+	constexpr uint32_t GetEventTypeId()
+	{
+		return static_cast<uint32_t>(EventClass::GetStaticType());
+	}
+
+	class INSIGHT_API EventBus
+	{
+	public:
+		// Number of events of a single type that may be queued between flushes without taking a lock.
+		static constexpr uint32_t QueueCapacity = 256u;
+
+		template <typename EventClass>
+		using Handler = Delegate<bool(EventClass&)>;
+
+	public:
+		EventBus();
+		~EventBus();
+
+		EventBus(const EventBus&) = delete;
+		EventBus& operator = (const EventBus&) = delete;
+
+		/*
+			Subscribe a member function to an event type. Handlers are invoked in subscription
+			order until one returns true (the event was handled). Must be called from the
+			thread that publishes/flushes the bus and not from inside of a handler.
+		*/
+		template <typename EventClass, typename Class, bool(Class::*Method)(EventClass&)>
+		void Subscribe(Class* pInstance)
+		{
+			GetOrCreateChannel<EventClass>().Handlers.push_back(Handler<EventClass>::template FromMethod<Class, Method>(pInstance));
+		}
+
+		template <typename EventClass, typename Class, bool(Class::*Method)(EventClass&)>
+		void Unsubscribe(Class* pInstance)
+		{
+			Channel<EventClass>* pChannel = FindChannel<EventClass>();
+			if (!pChannel) return;
+
+			const Handler<EventClass> Target = Handler<EventClass>::template FromMethod<Class, Method>(pInstance);
+			auto& Handlers = pChannel->Handlers;
+			Handlers.erase(std::remove(Handlers.begin(), Handlers.end(), Target), Handlers.end());
+		}
+
+		// Deliver an event immediately on the calling thread. Returns true if a handler handled it.
+		template <typename EventClass>
+		bool Publish(EventClass& e)
+		{
+			Channel<EventClass>* pChannel = FindChannel<EventClass>();
+			return pChannel ? pChannel->Deliver(e) : false;
+		}
+
+		// Deliver an event whose concrete type is only known at runtime. Costs one extra virtual call over the typed overload.
+		bool Publish(Event& e);
+
+		/*
+			Queue an event for delivery on the next Flush. Safe to call from any thread.
+			Returns false if nothing is subscribed to the event type.
+		*/
+		template <typename EventClass>
+		bool Enqueue(const EventClass& e)
+		{
+			Channel<EventClass>* pChannel = FindChannel<EventClass>();
+			if (!pChannel) return false;
+
+			const QueuedEvent<EventClass> Queued{ m_NextSequence.fetch_add(1u, std::memory_order_relaxed), e };
+			if (!pChannel->HasOverflow.load(std::memory_order_acquire) && pChannel->Queue.TryPush(Queued))
+				return true;
+
+			std::lock_guard<std::mutex> Lock(pChannel->OverflowMutex);
+			if (pChannel->Overflow.empty())
+			{
+				IE_DEBUG_LOG(LogSeverity::Warning, "Event queue for \"{0}\" is full. Holding events in its overflow list until the next flush.", e.GetName());
+			}
+			pChannel->Overflow.push_back(Queued);
+			pChannel->HasOverflow.store(true, std::memory_order_release);
+			return true;
+		}
+
+		// Deliver every queued event in the order it was enqueued. Must be called from a single consumer thread.
+		void Flush();
+
+	private:
+		template <typename EventClass>
+		struct QueuedEvent
+		{
+			uint64_t Sequence;
+			EventClass Payload;
+		};
+
+		struct ChannelBase
+		{
+			virtual ~ChannelBase() = default;
+			virtual bool DeliverErased(Event& e) = 0;
+			// Move everything queued so far into the pending list. Returns false if nothing is pending.
+			virtual bool CollectQueue() = 0;
+			// Sequence of the oldest pending event. Only valid while events are pending.
+			virtual uint64_t GetNextSequence() const = 0;
+			// Deliver pending events until one was enqueued at or after EndSequence. Returns false once nothing is pending.
+			virtual bool DeliverPending(uint64_t EndSequence) = 0;
+		};
+
+		template <typename EventClass>
+		struct Channel : public ChannelBase
+		{
+			std::vector<Handler<EventClass>> Handlers;
+			MPSCQueue<QueuedEvent<EventClass>, QueueCapacity> Queue;
+			// Events enqueued while the queue was full, delivered after it. Producers use it while HasOverflow is set.
+			std::mutex OverflowMutex;
+			std::vector<QueuedEvent<EventClass>> Overflow;
+			std::atomic<bool> HasOverflow{ false };
+			// Events collected by the current Flush. Keeps its capacity between flushes.
+			std::vector<QueuedEvent<EventClass>> Pending;
+			size_t NextPending = 0u;
+
+			inline bool Deliver(EventClass& e)
+			{
+				for (const Handler<EventClass>& Fn : Handlers)
+				{
+					e.m_Handled = Fn(e);
+					if (e.m_Handled) return true;
+				}
+				return false;
+			}
+
+			virtual bool DeliverErased(Event& e) override { return Deliver(static_cast<EventClass&>(e)); }
+			virtual bool CollectQueue() override
+			{
+				Pending.clear();
+				NextPending = 0u;
+				Queue.Drain([this](QueuedEvent<EventClass>& e) { Pending.push_back(std::move(e)); });
+				if (HasOverflow.load(std::memory_order_acquire))
+				{
+					// Producers do not use the queue while HasOverflow is set, so what is still in it is older than the overflow.
+					std::lock_guard<std::mutex> Lock(OverflowMutex);
+					Queue.Drain([this](QueuedEvent<EventClass>& e) { Pending.push_back(std::move(e)); });
+					Pending.insert(Pending.end(), std::make_move_iterator(Overflow.begin()), std::make_move_iterator(Overflow.end()));
+					Overflow.clear();
+					HasOverflow.store(false, std::memory_order_release);
+				}
+				return !Pending.empty();
+			}
+			virtual uint64_t GetNextSequence() const override { return Pending[NextPending].Sequence; }
+			virtual bool DeliverPending(uint64_t EndSequence) override
+			{
+				for (; NextPending < Pending.size() && Pending[NextPending].Sequence < EndSequence; ++NextPending)
+					Deliver(Pending[NextPending].Payload);
+				return NextPending < Pending.size();
+			}
+		};
+
+		template <typename EventClass>
+		Channel<EventClass>* FindChannel()
+		{
+			return static_cast<Channel<EventClass>*>(m_Channels[GetEventTypeId<EventClass>()].load(std::memory_order_acquire));
+		}
+
+		template <typename EventClass>
+		Channel<EventClass>& GetOrCreateChannel()
+		{
+			constexpr uint32_t Id = GetEventTypeId<EventClass>();
+			static_assert(Id < NumChannels, "Event type id is out of range.");
+
+			if (Channel<EventClass>* pChannel = FindChannel<EventClass>())
+				return *pChannel;
+
+			Channel<EventClass>* pNewChannel = new Channel<EventClass>();
+			m_Channels[Id].store(pNewChannel, std::memory_order_release);
+			return *pNewChannel;
+		}
+
+	private:
+		static constexpr uint32_t NumChannels = static_cast<uint32_t>(EventType::NumEventTypes);
+
+		// Channels are created on first subscription and published atomically so
+		// producers on other threads can safely look them up.
+		std::atomic<ChannelBase*> m_Channels[NumChannels];
+		// Stamped on every queued event, Flush delivers across channels in this order.
+		std::atomic<uint64_t> m_NextSequence{ 0u };
+	};
+
+}
@@ -0,0 +1,125 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - MPSC_Queue.h
+
+	Purpose:
+	Bounded lock-free queue with many producer threads and a single consumer thread.
+
+	Description:
+	A fixed ring of slots, each tagged with a sequence number. Producers claim a slot
+	with a single compare-exchange on the tail index and publish it by bumping the slot's
+	sequence. The consumer is the only thread that moves the head so it never contends.
+	Elements do not need to be default constructible; they are constructed in place.
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+#include <atomic>
+
+namespace Insight {
+
+	template <typename ElementType, uint32_t Capacity>
+	class MPSCQueue
+	{
+		static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "MPSCQueue capacity must be a power of two.");
+	public:
+		MPSCQueue()
+		{
+			for (uint32_t i = 0; i < Capacity; ++i)
+				m_Slots[i].Sequence.store(i, std::memory_order_relaxed);
+		}
+
+		~MPSCQueue()
+		{
+			Drain([](ElementType&) {});
+		}
+
+		MPSCQueue(const MPSCQueue&) = delete;
+		MPSCQueue& operator = (const MPSCQueue&) = delete;
+
+		// Push an element from any thread. Returns false if the queue is full.
+		template <typename ... Args>
+		bool TryPush(Args&& ... ConstructionArgs)
+		{
+			Slot* pSlot = nullptr;
+			uint32_t Position = m_Tail.load(std::memory_order_relaxed);
+			for (;;)
+			{
+				pSlot = &m_Slots[Position & (Capacity - 1)];
+				const uint32_t Sequence = pSlot->Sequence.load(std::memory_order_acquire);
+				const int32_t Difference = static_cast<int32_t>(Sequence - Position);
+				if (Difference == 0)
+				{
+					if (m_Tail.compare_exchange_weak(Position, Position + 1, std::memory_order_relaxed))
+						break;
+				}
+				else if (Difference < 0)
+				{
+					return false;
+				}
+				else
+				{
+					Position = m_Tail.load(std::memory_order_relaxed);
+				}
+			}
+
+			new (pSlot->Storage) ElementType(std::forward<Args>(ConstructionArgs)...);
+			pSlot->Sequence.store(Position + 1, std::memory_order_release);
+			return true;
+		}
+
+		// Pop the oldest element. Must only be called from the consumer thread. Returns false if the queue is empty.
+		bool TryPop(ElementType& OutElement)
+		{
+			Slot& HeadSlot = m_Slots[m_Head & (Capacity - 1)];
+			const uint32_t Sequence = HeadSlot.Sequence.load(std::memory_order_acquire);
+			if (static_cast<int32_t>(Sequence - (m_Head + 1)) < 0)
+				return false;
+
+			ElementType* pElement = reinterpret_cast<ElementType*>(HeadSlot.Storage);
+			OutElement = std::move(*pElement);
+			pElement->~ElementType();
+
+			HeadSlot.Sequence.store(m_Head + Capacity, std::memory_order_release);
+			m_Head++;
+			return true;
+		}
+
+		// Pop every element currently in the queue and invoke Func on each. Must only be called from the consumer thread.
+		template <typename Fn>
+		uint32_t Drain(Fn&& Func)
+		{
+			uint32_t NumDrained = 0;
+			for (;;)
+			{
+				Slot& HeadSlot = m_Slots[m_Head & (Capacity - 1)];
+				const uint32_t Sequence = HeadSlot.Sequence.load(std::memory_order_acquire);
+				if (static_cast<int32_t>(Sequence - (m_Head + 1)) < 0)
+					break;
+
+				ElementType* pElement = reinterpret_cast<ElementType*>(HeadSlot.Storage);
+				Func(*pElement);
+				pElement->~ElementType();
+
+				HeadSlot.Sequence.store(m_Head + Capacity, std::memory_order_release);
+				m_Head++;
+				NumDrained++;
+			}
+			return NumDrained;
+		}
+
+	private:
+		struct Slot
+		{
+			std::atomic<uint32_t> Sequence;
+			alignas(ElementType) uint8_t Storage[sizeof(ElementType)];
+		};
+
+		// Keep producers and the consumer on separate cache lines.
+		alignas(64) std::atomic<uint32_t> m_Tail = 0u;
+		alignas(64) uint32_t m_Head = 0u;
+		alignas(64) Slot m_Slots[Capacity];
+	};
+
+}
@@ -15,53 +15,281 @@ namespace Insight {
 		{
 			s_Instance = this;
 
-			// TODO load these from a settings file
+			// Defaults until the user settings have been loaded.
 			// TODO Change axis mappings depending on play mode (Editor/InGame)
-			m_AxisMappings.push_back({ "MoveForward", KeyMapCode_Keyboard_W, 1.0f });
-			m_AxisMappings.push_back({ "MoveForward", KeyMapCode_Keyboard_S, -1.0f });
-			m_AxisMappings.push_back({ "MoveForward", GamepadCode_Thumbstick_Left_Axis_Y, 1.0f });
-			m_AxisMappings.push_back({ "MoveRight", KeyMapCode_Keyboard_D, 1.0f });
-			m_AxisMappings.push_back({ "MoveRight", KeyMapCode_Keyboard_A, -1.0f });
-			m_AxisMappings.push_back({ "MoveRight", GamepadCode_Thumbstick_Left_Axis_X, 1.0f });
-			m_AxisMappings.push_back({ "MoveUp", KeyMapCode_Keyboard_E, 1.0f });
-			m_AxisMappings.push_back({ "MoveUp", KeyMapCode_Keyboard_Q, -1.0f });
-			m_AxisMappings.push_back({ "MoveUp", GamepadCode_Trigger_Right, 1.0f });
-			m_AxisMappings.push_back({ "MoveUp", GamepadCode_Trigger_Left, -1.0f });
-
-			m_AxisMappings.push_back({ "LookUp", KeyMapCode_Mouse_MoveY, 1.0f });
-			m_AxisMappings.push_back({ "LookUp", KeyMapCode_Mouse_MoveY, -1.0f });
-			m_AxisMappings.push_back({ "LookUp", GamepadCode_Thumbstick_Right_Axis_Y, -1.0f });
-			m_AxisMappings.push_back({ "LookRight", KeyMapCode_Mouse_MoveX, 1.0f });
-			m_AxisMappings.push_back({ "LookRight", KeyMapCode_Mouse_MoveX, -1.0f });
-			m_AxisMappings.push_back({ "LookRight", GamepadCode_Thumbstick_Right_Axis_X, 1.0f });
-			m_AxisMappings.push_back({ "MouseWheelUp", KeyMapCode_Mouse_Wheel_Up, 1.0f });
-			m_AxisMappings.push_back({ "MouseWheelUp", KeyMapCode_Mouse_Wheel_Up, -1.0f });
-
-			m_ActionMappings.push_back({ "CameraPitchYawLock", KeyMapCode_Mouse_Button_Right });
-			m_ActionMappings.push_back({ "CameraPitchYawLock", GamepadCode_Thumbstick_Right_Axis_X });
-			m_ActionMappings.push_back({ "Sprint", KeyMapCode_Keyboard_Shift });
-			m_ActionMappings.push_back({ "Sprint", GamepadCode_Button_Thumbstick_Left });
-
+			LoadDefaultMappings();
 
 			m_GamepadLeftStickSensitivity = 10.0f;
 			m_GamepadRightStickSensitivity = 10.0f;
 		}
 
+		void InputDispatcher::LoadDefaultMappings()
+		{
+			std::vector<AxisMapping> AxisMappings;
+			AxisMappings.push_back({ "MoveForward", KeyMapCode_Keyboard_W, 1.0f });
+			AxisMappings.push_back({ "MoveForward", KeyMapCode_Keyboard_S, -1.0f });
+			AxisMappings.push_back({ "MoveForward", GamepadCode_Thumbstick_Left_Axis_Y, 1.0f });
+			AxisMappings.push_back({ "MoveRight", KeyMapCode_Keyboard_D, 1.0f });
+			AxisMappings.push_back({ "MoveRight", KeyMapCode_Keyboard_A, -1.0f });
+			AxisMappings.push_back({ "MoveRight", GamepadCode_Thumbstick_Left_Axis_X, 1.0f });
+			AxisMappings.push_back({ "MoveUp", KeyMapCode_Keyboard_E, 1.0f });
+			AxisMappings.push_back({ "MoveUp", KeyMapCode_Keyboard_Q, -1.0f });
+			AxisMappings.push_back({ "MoveUp", GamepadCode_Trigger_Right, 1.0f });
+			AxisMappings.push_back({ "MoveUp", GamepadCode_Trigger_Left, -1.0f });
+
+			AxisMappings.push_back({ "LookUp", KeyMapCode_Mouse_MoveY, 1.0f });
+			AxisMappings.push_back({ "LookUp", KeyMapCode_Mouse_MoveY, -1.0f });
+			AxisMappings.push_back({ "LookUp", GamepadCode_Thumbstick_Right_Axis_Y, -1.0f });
+			AxisMappings.push_back({ "LookRight", KeyMapCode_Mouse_MoveX, 1.0f });
+			AxisMappings.push_back({ "LookRight", KeyMapCode_Mouse_MoveX, -1.0f });
+			AxisMappings.push_back({ "LookRight", GamepadCode_Thumbstick_Right_Axis_X, 1.0f });
+			AxisMappings.push_back({ "MouseWheelUp", KeyMapCode_Mouse_Wheel_Up, 1.0f });
+			AxisMappings.push_back({ "MouseWheelUp", KeyMapCode_Mouse_Wheel_Up, -1.0f });
+
+			std::vector<ActionMapping> ActionMappings;
+			ActionMappings.push_back({ "CameraPitchYawLock", KeyMapCode_Mouse_Button_Right });
+			ActionMappings.push_back({ "CameraPitchYawLock", GamepadCode_Thumbstick_Right_Axis_X });
+			ActionMappings.push_back({ "Sprint", KeyMapCode_Keyboard_Shift });
+			ActionMappings.push_back({ "Sprint", GamepadCode_Button_Thumbstick_Left });
+
+			SetMappings(AxisMappings, ActionMappings);
+		}
+
+		bool InputDispatcher::LoadMappingsFromJson(const std::string& SettingsFile)
+		{
+			ScopedPerfTimer("InputDispatcher::LoadMappingsFromJson", OutputType_Millis);
+
+			rapidjson::Document RawSettingsFile;
+			if (!json::load(SettingsFile.c_str(), RawSettingsFile)) {
+				IE_DEBUG_LOG(LogSeverity::Error, "Failed to load input settings from file: \"{0}\". Default input mappings will be applied.", SettingsFile);
+				LoadDefaultMappings();
+				return false;
+			}
+
+			// Expected layout: { "Input": [ { "AxisMappings": [ ... ], "ActionMappings": [ ... ] } ] }
+			const rapidjson::Value* pInputSettings = nullptr;
+			if (RawSettingsFile.IsObject() && RawSettingsFile.HasMember("Input")) {
+				const rapidjson::Value& JsonInput = RawSettingsFile["Input"];
+				if (JsonInput.IsArray() && !JsonInput.Empty() && JsonInput[0].IsObject())
+					pInputSettings = &JsonInput[0];
+			}
+			if (!pInputSettings) {
+				IE_DEBUG_LOG(LogSeverity::Warning, "No input settings found in file: \"{0}\". Default input mappings will be applied.", SettingsFile);
+				LoadDefaultMappings();
+				return false;
+			}
+			const rapidjson::Value::ConstMemberIterator JsonAxisIter = pInputSettings->FindMember("AxisMappings");
+			const rapidjson::Value::ConstMemberIterator JsonActionIter = pInputSettings->FindMember("ActionMappings");
+			if (JsonAxisIter == pInputSettings->MemberEnd() || !JsonAxisIter->value.IsArray()
+				|| JsonActionIter == pInputSettings->MemberEnd() || !JsonActionIter->value.IsArray()) {
+				IE_DEBUG_LOG(LogSeverity::Warning, "Input settings in file \"{0}\" are missing their axis or action mappings. Default input mappings will be applied.", SettingsFile);
+				LoadDefaultMappings();
+				return false;
+			}
+
+			auto ReadMapping = [](const rapidjson::Value& JsonMapping, char* OutHint, KeyMapCode& OutKeyCode) -> bool
+			{
+				if (!JsonMapping.IsObject()) {
+					IE_DEBUG_LOG(LogSeverity::Warning, "Input mapping is not an object. Skipping.");
+					return false;
+				}
+				std::string Hint, KeyName;
+				json::get_string(JsonMapping, "Hint", Hint);
+				json::get_string(JsonMapping, "Key", KeyName);
+
+				OutKeyCode = KeyCodeFromName(KeyName.c_str());
+				if (OutKeyCode == -1 || Hint.empty() || Hint.size() >= MaxHintStringLength) {
+					IE_DEBUG_LOG(LogSeverity::Warning, "Invalid input mapping \"{0}\" -> \"{1}\". Skipping.", Hint, KeyName);
+					return false;
+				}
+				memcpy(OutHint, Hint.c_str(), Hint.size() + 1);
+				return true;
+			};
+
+			std::vector<AxisMapping> AxisMappings;
+			const rapidjson::Value& JsonAxisMappings = JsonAxisIter->value;
+			for (rapidjson::SizeType i = 0; i < JsonAxisMappings.Size(); ++i)
+			{
+				AxisMapping Axis = {};
+				if (!ReadMapping(JsonAxisMappings[i], Axis.Hint, Axis.MappedKeyCode))
+					continue;
+				json::get_float(JsonAxisMappings[i], "Scale", Axis.Scale);
+				AxisMappings.push_back(Axis);
+			}
+
+			std::vector<ActionMapping> ActionMappings;
+			const rapidjson::Value& JsonActionMappings = JsonActionIter->value;
+			for (rapidjson::SizeType i = 0; i < JsonActionMappings.Size(); ++i)
+			{
+				ActionMapping Action = {};
+				if (!ReadMapping(JsonActionMappings[i], Action.Hint, Action.MappedKeyCode))
+					continue;
+				ActionMappings.push_back(Action);
+			}
+
+			SetMappings(AxisMappings, ActionMappings);
+			return true;
+		}
+
+		void InputDispatcher::SetMappings(const std::vector<AxisMapping>& AxisMappings, const std::vector<ActionMapping>& ActionMappings)
+		{
+			m_AxisMappings = AxisMappings;
+			m_ActionMappings = ActionMappings;
+			CompileBindings();
+		}
+
+		KeyMapCode InputDispatcher::KeyCodeFromName(const char* Name)
+		{
+			// Key codes are initialized from platform codes at startup so this table cannot be static.
+#define IE_KEY_NAME(Code) { #Code, Code }
+			const std::pair<const char*, KeyMapCode> KeyNames[] =
+			{
+				IE_KEY_NAME(KeyMapCode_Mouse_Button_Left), IE_KEY_NAME(KeyMapCode_Mouse_Button_Right), IE_KEY_NAME(KeyMapCode_Mouse_Button_Middle),
+				IE_KEY_NAME(KeyMapCode_Mouse_Wheel_Up), IE_KEY_NAME(KeyMapCode_Mouse_Wheel_Down), IE_KEY_NAME(KeyMapCode_Mouse_Wheel_Left), IE_KEY_NAME(KeyMapCode_Mouse_Wheel_Right),
+				IE_KEY_NAME(KeyMapCode_Mouse_MoveX), IE_KEY_NAME(KeyMapCode_Mouse_MoveY),
+
+				IE_KEY_NAME(KeyMapCode_Keyboard_Shift), IE_KEY_NAME(KeyMapCode_Keyboard_Shift_Left), IE_KEY_NAME(KeyMapCode_Keyboard_Shift_Right),
+				IE_KEY_NAME(KeyMapCode_Keyboard_Alt), IE_KEY_NAME(KeyMapCode_Keyboard_Control),
+				IE_KEY_NAME(KeyMapCode_Keyboard_Arrow_Left), IE_KEY_NAME(KeyMapCode_Keyboard_Arrow_Right), IE_KEY_NAME(KeyMapCode_Keyboard_Arrow_Up), IE_KEY_NAME(KeyMapCode_Keyboard_Arrow_Down),
+				IE_KEY_NAME(KeyMapCode_Keyboard_0), IE_KEY_NAME(KeyMapCode_Keyboard_1), IE_KEY_NAME(KeyMapCode_Keyboard_2), IE_KEY_NAME(KeyMapCode_Keyboard_3), IE_KEY_NAME(KeyMapCode_Keyboard_4),
+				IE_KEY_NAME(KeyMapCode_Keyboard_5), IE_KEY_NAME(KeyMapCode_Keyboard_6), IE_KEY_NAME(KeyMapCode_Keyboard_7), IE_KEY_NAME(KeyMapCode_Keyboard_8), IE_KEY_NAME(KeyMapCode_Keyboard_9),
+				IE_KEY_NAME(KeyMapCode_Keyboard_A), IE_KEY_NAME(KeyMapCode_Keyboard_B), IE_KEY_NAME(KeyMapCode_Keyboard_C), IE_KEY_NAME(KeyMapCode_Keyboard_D), IE_KEY_NAME(KeyMapCode_Keyboard_E),
+				IE_KEY_NAME(KeyMapCode_Keyboard_F), IE_KEY_NAME(KeyMapCode_Keyboard_G), IE_KEY_NAME(KeyMapCode_Keyboard_H), IE_KEY_NAME(KeyMapCode_Keyboard_I), IE_KEY_NAME(KeyMapCode_Keyboard_J),
+				IE_KEY_NAME(KeyMapCode_Keyboard_K), IE_KEY_NAME(KeyMapCode_Keyboard_L), IE_KEY_NAME(KeyMapCode_Keyboard_M), IE_KEY_NAME(KeyMapCode_Keyboard_N), IE_KEY_NAME(KeyMapCode_Keyboard_O),
+				IE_KEY_NAME(KeyMapCode_Keyboard_P), IE_KEY_NAME(KeyMapCode_Keyboard_Q), IE_KEY_NAME(KeyMapCode_Keyboard_R), IE_KEY_NAME(KeyMapCode_Keyboard_S), IE_KEY_NAME(KeyMapCode_Keyboard_T),
+				IE_KEY_NAME(KeyMapCode_Keyboard_U), IE_KEY_NAME(KeyMapCode_Keyboard_V), IE_KEY_NAME(KeyMapCode_Keyboard_W), IE_KEY_NAME(KeyMapCode_Keyboard_X), IE_KEY_NAME(KeyMapCode_Keyboard_Y),
+				IE_KEY_NAME(KeyMapCode_Keyboard_Z),
+
+				IE_KEY_NAME(GamepadCode_Button_A), IE_KEY_NAME(GamepadCode_Button_B), IE_KEY_NAME(GamepadCode_Button_X), IE_KEY_NAME(GamepadCode_Button_Y),
+				IE_KEY_NAME(GamepadCode_Button_DPad_Up), IE_KEY_NAME(GamepadCode_Button_DPad_Down), IE_KEY_NAME(GamepadCode_Button_DPad_Left), IE_KEY_NAME(GamepadCode_Button_DPad_Right),
+				IE_KEY_NAME(GamepadCode_Button_Start), IE_KEY_NAME(GamepadCode_Button_Back),
+				IE_KEY_NAME(GamepadCode_Button_Thumbstick_Left), IE_KEY_NAME(GamepadCode_Button_Thumbstick_Right),
+				IE_KEY_NAME(GamepadCode_Button_Shoulder_Left), IE_KEY_NAME(GamepadCode_Button_Shoulder_Right),
+				IE_KEY_NAME(GamepadCode_Trigger_Left), IE_KEY_NAME(GamepadCode_Trigger_Right),
+				IE_KEY_NAME(GamepadCode_Thumbstick_Left_Axis_X), IE_KEY_NAME(GamepadCode_Thumbstick_Left_Axis_Y),
+				IE_KEY_NAME(GamepadCode_Thumbstick_Right_Axis_X), IE_KEY_NAME(GamepadCode_Thumbstick_Right_Axis_Y),
+			};
+#undef IE_KEY_NAME
+
+			for (const auto& Key : KeyNames)
+			{
+				if (strcmp(Key.first, Name) == 0)
+					return Key.second;
+			}
+			return -1;
+		}
+
+		uint32_t InputDispatcher::GetOrCreateAxisIndex(const char* Hint)
+		{
+			auto Result = m_AxisIndices.emplace(HashInputHint(Hint), static_cast<uint32_t>(m_AxisIndices.size()));
+			if (Result.second)
+				m_AxisCallbackRanges.resize(m_AxisIndices.size());
+			return (*Result.first).second;
+		}
+
+		uint32_t InputDispatcher::GetOrCreateActionIndex(const char* Hint)
+		{
+			auto Result = m_ActionIndices.emplace(HashInputHint(Hint), static_cast<uint32_t>(m_ActionIndices.size()));
+			if (Result.second)
+				m_ActionCallbackRanges.resize(m_ActionIndices.size() * NumInputEventTypes);
+			return (*Result.first).second;
+		}
+
+		void InputDispatcher::CompileBindings()
+		{
+			// Bucket the mappings by key code so dispatch is a single table lookup.
+			std::vector<uint32_t> AxisOrder(m_AxisMappings.size());
+			for (uint32_t i = 0; i < AxisOrder.size(); ++i) AxisOrder[i] = i;
+			std::stable_sort(AxisOrder.begin(), AxisOrder.end(), [this](uint32_t A, uint32_t B) { return m_AxisMappings[A].MappedKeyCode < m_AxisMappings[B].MappedKeyCode; });
+
+			std::vector<uint32_t> ActionOrder(m_ActionMappings.size());
+			for (uint32_t i = 0; i < ActionOrder.size(); ++i) ActionOrder[i] = i;
+			std::stable_sort(ActionOrder.begin(), ActionOrder.end(), [this](uint32_t A, uint32_t B) { return m_ActionMappings[A].MappedKeyCode < m_ActionMappings[B].MappedKeyCode; });
+
+			for (uint32_t i = 0; i < MaxKeyMapCodes; ++i)
+			{
+				m_AxisKeyRanges[i] = {};
+				m_ActionKeyRanges[i] = {};
+			}
+
+			m_AxisBindings.clear();
+			m_PolledKeys.clear();
+			for (uint32_t MappingIndex : AxisOrder)
+			{
+				const AxisMapping& Axis = m_AxisMappings[MappingIndex];
+				if (Axis.MappedKeyCode < 0 || Axis.MappedKeyCode >= static_cast<KeyMapCode>(MaxKeyMapCodes)) {
+					IE_DEBUG_LOG(LogSeverity::Warning, "Axis mapping \"{0}\" has an out of range key code {1}. Skipping.", Axis.Hint, Axis.MappedKeyCode);
+					continue;
+				}
+
+				BindingRange& Range = m_AxisKeyRanges[Axis.MappedKeyCode];
+				if (Range.Count == 0u)
+				{
+					Range.First = static_cast<uint32_t>(m_AxisBindings.size());
+					// Each key only needs to be polled once, no matter how many axes it drives.
+					m_PolledKeys.push_back(Axis.MappedKeyCode);
+				}
+				Range.Count++;
+				m_AxisBindings.push_back({ GetOrCreateAxisIndex(Axis.Hint), Axis.Scale });
+			}
+
+			m_ActionBindings.clear();
+			for (uint32_t MappingIndex : ActionOrder)
+			{
+				const ActionMapping& Action = m_ActionMappings[MappingIndex];
+				if (Action.MappedKeyCode < 0 || Action.MappedKeyCode >= static_cast<KeyMapCode>(MaxKeyMapCodes)) {
+					IE_DEBUG_LOG(LogSeverity::Warning, "Action mapping \"{0}\" has an out of range key code {1}. Skipping.", Action.Hint, Action.MappedKeyCode);
+					continue;
+				}
+
+				BindingRange& Range = m_ActionKeyRanges[Action.MappedKeyCode];
+				if (Range.Count == 0u)
+					Range.First = static_cast<uint32_t>(m_ActionBindings.size());
+				Range.Count++;
+				m_ActionBindings.push_back({ GetOrCreateActionIndex(Action.Hint), true, 0.0f });
+			}
+
+			RebuildCallbackRanges(m_AxisCallbacks, m_AxisCallbackRanges, static_cast<uint32_t>(m_AxisIndices.size()));
+			RebuildCallbackRanges(m_ActionCallbacks, m_ActionCallbackRanges, static_cast<uint32_t>(m_ActionIndices.size()) * NumInputEventTypes);
+		}
+
+		template <typename CallbackFn>
+		void InputDispatcher::RebuildCallbackRanges(const std::vector<HintCallback<CallbackFn>>& Callbacks, std::vector<BindingRange>& OutRanges, uint32_t NumSlots)
+		{
+			OutRanges.assign(NumSlots, BindingRange{});
+			for (uint32_t i = 0; i < Callbacks.size(); ++i)
+			{
+				BindingRange& Range = OutRanges[Callbacks[i].SlotIndex];
+				if (Range.Count == 0u)
+					Range.First = i;
+				Range.Count++;
+			}
+		}
+
 		void InputDispatcher::UpdateInputs(float DeltaMs)
 		{
+			// Replay
+			// ------
+			// Held keys and gamepads come from the recording instead of the OS.
+			if (m_Recorder.IsReplaying())
+			{
+				m_Recorder.ForEachReplayedEvent(InputSource_Polled, [this](Event& e) { DispatchInputEvent(e); });
+				return;
+			}
+
 			// Keyboard
 			// --------
 			// The Window only sends one event telling us the key has been pressed.
 			// We need to continuously check it to see if it is being held.
 			// We do this below.
-			for (uint32_t i = 0; i < m_AxisMappings.size(); i++)
+			for (KeyMapCode Key : m_PolledKeys)
 			{
 				// If the key in the axis mapping is pressed, dispatch an event.
-				if(m_pOwningWindowRef->GetAsyncKeyState(m_AxisMappings[i].MappedKeyCode) == InputEventType_Pressed)
-								{
+				if(m_pOwningWindowRef->GetAsyncKeyState(Key) == InputEventType_Pressed)
+				{
 					// Dispatching KeyHolding events will happen in InputDispatcher::DispatchActionEvent
-					KeyPressedEvent e(m_AxisMappings[i].MappedKeyCode, 0, 1.0f);
-					ProcessInputEvent(e);
+					KeyPressedEvent e(Key, 0, 1.0f);
+					ProcessPolledInputEvent(e);
 				}
 			}
 
@@ -72,6 +300,18 @@ namespace Insight {
 		}
 
 		void InputDispatcher::ProcessInputEvent(Event& e)
+		{
+			m_Recorder.RecordEvent(e, InputSource_Window);
+			DispatchInputEvent(e);
+		}
+
+		void InputDispatcher::ProcessPolledInputEvent(Event& e)
+		{
+			m_Recorder.RecordEvent(e, InputSource_Polled);
+			DispatchInputEvent(e);
+		}
+
+		void InputDispatcher::DispatchInputEvent(Event& e)
 		{
 			EventDispatcher Dispatcher(e);
 			// Mouse Buttons
@@ -92,16 +332,28 @@ namespace Insight {
 
 		void InputDispatcher::RegisterAxisCallback(const char* Name, EventInputAxisFn Callback)
 		{
-			m_AxisCallbacks[Name].push_back(Callback);
+			const uint32_t AxisIndex = GetOrCreateAxisIndex(Name);
+
+			// Keep the array sorted by slot so each axis' callbacks are contiguous.
+			auto InsertPos = std::upper_bound(m_AxisCallbacks.begin(), m_AxisCallbacks.end(), AxisIndex,
+				[](uint32_t Slot, const HintCallback<EventInputAxisFn>& Other) { return Slot < Other.SlotIndex; });
+			m_AxisCallbacks.insert(InsertPos, { AxisIndex, std::move(Callback) });
+			RebuildCallbackRanges(m_AxisCallbacks, m_AxisCallbackRanges, static_cast<uint32_t>(m_AxisIndices.size()));
 		}
 
 		void InputDispatcher::RegisterActionCallback(const char* Name, InputEventType EventType, EventInputActionFn Callback)
 		{
-			m_ActionCallbacks[{Name, EventType}].push_back(Callback);
+			const uint32_t Slot = GetOrCreateActionIndex(Name) * NumInputEventTypes + static_cast<uint32_t>(EventType);
+
+			auto InsertPos = std::upper_bound(m_ActionCallbacks.begin(), m_ActionCallbacks.end(), Slot,
+				[](uint32_t Slot, const HintCallback<EventInputActionFn>& Other) { return Slot < Other.SlotIndex; });
+			m_ActionCallbacks.insert(InsertPos, { Slot, std::move(Callback) });
+			RebuildCallbackRanges(m_ActionCallbacks, m_ActionCallbackRanges, static_cast<uint32_t>(m_ActionIndices.size()) * NumInputEventTypes);
 		}
 
 		void InputDispatcher::AddGamepadVibration(uint32_t PlayerIndex, GampadRumbleMotor Direction, float Amount)
 		{
+#if defined (IE_PLATFORM_WINDOWS)
 			IE_ASSERT(PlayerIndex <= XUSER_MAX_COUNT, "Trying to add vibration to an invalid controller index");
 
 			XINPUT_VIBRATION VibrationInfo;
@@ -113,113 +365,109 @@ namespace Insight {
 				VibrationInfo.wRightMotorSpeed = static_cast<WORD>(65535 / (65535 * Amount));
 
 			XInputSetState(PlayerIndex, &VibrationInfo);
+#endif // IE_PLATFORM_WINDOWS
+		}
+
+		void InputDispatcher::InvokeAxisCallbacks(uint32_t AxisIndex, float Value)
+		{
+			const BindingRange& Range = m_AxisCallbackRanges[AxisIndex];
+			for (uint32_t i = Range.First; i < Range.First + Range.Count; ++i)
+			{
+				m_AxisCallbacks[i].Callback(Value);
+			}
+		}
+
+		void InputDispatcher::InvokeActionCallbacks(uint32_t ActionIndex, InputEventType EventType)
+		{
+			const BindingRange& Range = m_ActionCallbackRanges[ActionIndex * NumInputEventTypes + static_cast<uint32_t>(EventType)];
+			for (uint32_t i = Range.First; i < Range.First + Range.Count; ++i)
+			{
+				m_ActionCallbacks[i].Callback();
+			}
 		}
 
 		bool InputDispatcher::DispatchAxisEvent(KeyPressedEvent& e)
 		{
-			for (AxisMapping& Axis : m_AxisMappings)
+			const KeyMapCode Key = e.GetKeyCode();
+			if (Key < 0 || Key >= static_cast<KeyMapCode>(MaxKeyMapCodes)) return false;
+
+			const BindingRange& Range = m_AxisKeyRanges[Key];
+			for (uint32_t i = Range.First; i < Range.First + Range.Count; ++i)
 			{
-				// Find the key in the axis map.
-				if (Axis.MappedKeyCode == e.GetKeyCode())
-				{
-					// Use the keycode as the key into the axis map to find 
-					// the callbacks associated with it.
-					auto Callbacks = &m_AxisCallbacks[Axis.Hint];
-					for (EventInputAxisFn Callback : *Callbacks)
-					{
-						// Call the callbacks.
-						Callback(Axis.Scale * e.GetMoveDelta());
-					}
-				}
+				const AxisBinding& Axis = m_AxisBindings[i];
+				InvokeAxisCallbacks(Axis.AxisIndex, Axis.Scale * e.GetMoveDelta());
 			}
 			return false;
 		}
 
 		bool InputDispatcher::DispatchMouseScrolledEvent(MouseScrolledEvent& e)
 		{
-			for (AxisMapping& Axis : m_AxisMappings)
-			{
-				// Find the key in the axis map.
-				if (Axis.MappedKeyCode == e.GetKeyCode())
-				{
-					float MoveFactor = e.GetYOffset();
+			const KeyMapCode Key = e.GetKeyCode();
+			if (Key < 0 || Key >= static_cast<KeyMapCode>(MaxKeyMapCodes)) return false;
 
-					// Use the keycode as the key into the axis map to find 
-					// the callbacks associated with it.
-					auto Callbacks = &m_AxisCallbacks[Axis.Hint];
-					for (EventInputAxisFn Callback : *Callbacks)
-					{
-						// Invoke the callbacks.
-						Callback(MoveFactor);
-					}
-				}
+			const float MoveFactor = e.GetYOffset();
+			const BindingRange& Range = m_AxisKeyRanges[Key];
+			for (uint32_t i = Range.First; i < Range.First + Range.Count; ++i)
+			{
+				InvokeAxisCallbacks(m_AxisBindings[i].AxisIndex, MoveFactor);
 			}
 			return false;
 		}
 
 		bool InputDispatcher::DispatchMouseMoveEvent(MouseMovedEvent& e)
 		{
-			for (AxisMapping& Axis : m_AxisMappings)
+			const KeyMapCode Key = e.GetKeyCode();
+			if (Key < 0 || Key >= static_cast<KeyMapCode>(MaxKeyMapCodes)) return false;
+
+			float MoveFactor = 0.0f;
+			if (Key == KeyMapCode_Mouse_MoveX) MoveFactor = e.GetX();
+			if (Key == KeyMapCode_Mouse_MoveY) MoveFactor = e.GetY();
+
+			const BindingRange& Range = m_AxisKeyRanges[Key];
+			for (uint32_t i = Range.First; i < Range.First + Range.Count; ++i)
 			{
-				// Find the key in the axis map.
-				if (Axis.MappedKeyCode == e.GetKeyCode())
-				{
-					float MoveFactor = 0.0f;
-					if (e.GetKeyCode() == KeyMapCode_Mouse_MoveX) MoveFactor = e.GetX();
-					if (e.GetKeyCode() == KeyMapCode_Mouse_MoveY) MoveFactor = e.GetY();
-
-					// Use the keycode as the key into the axis map to find 
-					// the callbacks associated with it.
-					auto Callbacks = &m_AxisCallbacks[Axis.Hint];
-					for (EventInputAxisFn Callback : *Callbacks)
-					{
-						// Invoke the callbacks.
-						Callback(MoveFactor);
-					}
-				}
+				InvokeAxisCallbacks(m_AxisBindings[i].AxisIndex, MoveFactor);
 			}
 			return false;
 		}
 
 		bool InputDispatcher::DispatchActionEvent(InputEvent& e)
 		{
-			for (ActionMapping& Action : m_ActionMappings)
+			const KeyMapCode Key = e.GetKeyCode();
+			if (Key < 0 || Key >= static_cast<KeyMapCode>(MaxKeyMapCodes)) return false;
+
+			const BindingRange& Range = m_ActionKeyRanges[Key];
+			for (uint32_t i = Range.First; i < Range.First + Range.Count; ++i)
 			{
-				if (Action.MappedKeyCode == e.GetKeyCode())
+				ActionBinding& Action = m_ActionBindings[i];
+
+				if (e.GetEventType() == InputEventType_Released)
 				{
-					if (e.GetEventType() == InputEventType_Released)
-					{
-						Action.CanDispatch = true;
-						// The key had been released reset 
-						// the holding timer.
-						Action.HoldTime = 0.0f;
-					}
+					Action.CanDispatch = true;
+					// The key had been released reset 
+					// the holding timer.
+					Action.HoldTime = 0.0f;
+				}
 
-					// If the key has been pressed once or a key is being held, dispatch the function calls.
-					// Note: KeyHeld events are only dispatched from the timer code below.
-					if (Action.CanDispatch || (e.GetEventType() == InputEventType_Held))
-					{
-						auto Callbacks = &m_ActionCallbacks[{Action.Hint, e.GetEventType()}];
-						for (EventInputActionFn Callback : *Callbacks)
-						{
-							// Invoke the callbacks.
-							Callback();
-						}
-					}
+				// If the key has been pressed once or a key is being held, dispatch the function calls.
+				// Note: KeyHeld events are only dispatched from the timer code below.
+				if (Action.CanDispatch || (e.GetEventType() == InputEventType_Held))
+				{
+					InvokeActionCallbacks(Action.ActionIndex, e.GetEventType());
+				}
 
-					if (e.GetEventType() == InputEventType_Pressed)
+				if (e.GetEventType() == InputEventType_Pressed)
+				{
+					Action.CanDispatch = false;
+					// If the the key is pressed start the timer to see if the key is being held.
+					Action.HoldTime += 0.16f;
+					if (Action.HoldTime >= m_MaxKeyHoldTime)
 					{
-						Action.CanDispatch = false;
-						// If the the key is pressed start the timer to see if the key is being held.
-						Action.HoldTime += 0.16f;
-						if (Action.HoldTime >= m_MaxKeyHoldTime)
-						{
-							// Time is greater than the max hold time 
-							// (They have been holding the key for 1/0.16 seconds)
-							// meaning they are holding the key. Send out a key hold 
-							KeyHeldEvent e(e.GetKeyCode());
-							DispatchActionEvent(e);
-						}
+						// Time is greater than the max hold time 
+						// (They have been holding the key for 1/0.16 seconds)
+						// meaning they are holding the key. Send out a key hold 
+						KeyHeldEvent HeldEvent(Key);
+						DispatchActionEvent(HeldEvent);
 					}
 				}
 			}
@@ -228,6 +476,7 @@ namespace Insight {
 
 		void InputDispatcher::HandleControllerInput(const float DeltaMs)
 		{
+#if defined (IE_PLATFORM_WINDOWS)
 			// Constant gamepad polling is poor for performance, so set
 			// a poll interval and update the controller every other frame.
 			static float GamepadPollRate = 0.0f;
@@ -249,23 +498,23 @@ namespace Insight {
 						if (State.Gamepad.wButtons & XBoxCode_Button_PressMask_A)
 						{
 							KeyPressedEvent e(GamepadCode_Button_A, 0);
-							ProcessInputEvent(e);
+							ProcessPolledInputEvent(e);
 						}
 						else if (m_XBoxGamepads[i].Gamepad.wButtons & XBoxCode_Button_PressMask_A)
 						{
 							KeyReleasedEvent e(GamepadCode_Button_A);
-							ProcessInputEvent(e);
+							ProcessPolledInputEvent(e);
 						}
 
 						if (State.Gamepad.wButtons & XBoxCode_Button_PressMask_B)
 						{
 							KeyPressedEvent e(GamepadCode_Button_B, 0);
-							ProcessInputEvent(e);
+							ProcessPolledInputEvent(e);
 						}
 						else if (m_XBoxGamepads[i].Gamepad.wButtons & XBoxCode_Button_PressMask_B)
 						{
 							KeyReleasedEvent e(GamepadCode_Button_B);
-							ProcessInputEvent(e);
+							ProcessPolledInputEvent(e);
 						}
 
 
@@ -273,12 +522,12 @@ namespace Insight {
 						if (State.Gamepad.wButtons & XBoxCode_Button_PressMask_X)
 						{
 							KeyPressedEvent e(GamepadCode_Button_X, 0);
-							ProcessInputEvent(e);
+							ProcessPolledInputEvent(e);
 						}
 						else if (m_XBoxGamepads[i].Gamepad.wButtons & XBoxCode_Button_PressMask_X)
 						{
 							KeyReleasedEvent e(GamepadCode_Button_X);
-							ProcessInputEvent(e);
+							ProcessPolledInputEvent(e);
 						}
 
 
@@ -286,12 +535,12 @@ namespace Insight {
 						if (State.Gamepad.wButtons & XBoxCode_Button_PressMask_Y)
 						{
 							KeyPressedEvent e(GamepadCode_Button_Y, 0);
-							ProcessInputEvent(e);
+							ProcessPolledInputEvent(e);
 						}
 						else if (m_XBoxGamepads[i].Gamepad.wButtons & XBoxCode_Button_PressMask_Y)
 						{
 							KeyReleasedEvent e(GamepadCode_Button_Y);
-							ProcessInputEvent(e);
+							ProcessPolledInputEvent(e);
 						}
 
 
@@ -299,12 +548,12 @@ namespace Insight {
 						if (State.Gamepad.wButtons & XBoxCode_Button_PressMask_DPad_Up)
 						{
 							KeyPressedEvent e(GamepadCode_Button_DPad_Up, 0);
-							ProcessInputEvent(e);
+							ProcessPolledInputEvent(e);
 						}
 						else if ((m_XBoxGamepads[i].Gamepad.wButtons & XBoxCode_Button_PressMask_DPad_Up))
 						{
 							KeyReleasedEvent e(GamepadCode_Button_DPad_Up);
-							ProcessInputEvent(e);
+							ProcessPolledInputEvent(e);
 						}
 
 
@@ -312,12 +561,12 @@ namespace Insight {
 						if (State.Gamepad.wButtons & XBoxCode_Button_PressMask_DPad_Down)
 						{
 							KeyPressedEvent e(GamepadCode_Button_DPad_Down, 0);
-							ProcessInputEvent(e);
+							ProcessPolledInputEvent(e);
 						}
 						else if ((m_XBoxGamepads[i].Gamepad.wButtons & XBoxCode_Button_PressMask_DPad_Down))
 						{
 							KeyReleasedEvent e(GamepadCode_Button_DPad_Down);
-							ProcessInputEvent(e);
+							ProcessPolledInputEvent(e);
 						}
 
 
@@ -325,12 +574,12 @@ namespace Insight {
 						if (State.Gamepad.wButtons & XBoxCode_Button_PressMask_DPad_Left)
 						{
 							KeyPressedEvent e(GamepadCode_Button_DPad_Left, 0);
-							ProcessInputEvent(e);
+							ProcessPolledInputEvent(e);
 						}
 						else if ((m_XBoxGamepads[i].Gamepad.wButtons & XBoxCode_Button_PressMask_DPad_Left))
 						{
 							KeyReleasedEvent e(GamepadCode_Button_DPad_Left);
-							ProcessInputEvent(e);
+							ProcessPolledInputEvent(e);
 						}
 
 
@@ -338,12 +587,12 @@ namespace Insight {
 						if (State.Gamepad.wButtons & XBoxCode_Button_PressMask_DPad_Right)
 						{
 							KeyPressedEvent e(GamepadCode_Button_DPad_Right, 0);
-							ProcessInputEvent(e);
+							ProcessPolledInputEvent(e);
 						}
 						else if ((m_XBoxGamepads[i].Gamepad.wButtons & XBoxCode_Button_PressMask_DPad_Right))
 						{
 							KeyReleasedEvent e(GamepadCode_Button_DPad_Right);
-							ProcessInputEvent(e);
+							ProcessPolledInputEvent(e);
 						}
 
 
@@ -351,12 +600,12 @@ namespace Insight {
 						if (State.Gamepad.wButtons & XBoxCode_Button_PressMask_Start)
 						{
 							KeyPressedEvent e(GamepadCode_Button_Start, 0);
-							ProcessInputEvent(e);
+							ProcessPolledInputEvent(e);
 						}
 						else if ((m_XBoxGamepads[i].Gamepad.wButtons & XBoxCode_Button_PressMask_Start))
 						{
 							KeyReleasedEvent e(GamepadCode_Button_Start);
-							ProcessInputEvent(e);
+							ProcessPolledInputEvent(e);
 						}
 
 
@@ -364,12 +613,12 @@ namespace Insight {
 						if (State.Gamepad.wButtons & XBoxCode_Button_PressMask_Back)
 						{
 							KeyPressedEvent e(GamepadCode_Button_Back, 0);
-							ProcessInputEvent(e);
+							ProcessPolledInputEvent(e);
 						}
 						else if ((m_XBoxGamepads[i].Gamepad.wButtons & XBoxCode_Button_PressMask_Back))
 						{
 							KeyReleasedEvent e(GamepadCode_Button_Back);
-							ProcessInputEvent(e);
+							ProcessPolledInputEvent(e);
 						}
 
 
@@ -377,12 +626,12 @@ namespace Insight {
 						if (State.Gamepad.wButtons & XBoxCode_Button_PressMask_Thumbstick_Left)
 						{
 							KeyPressedEvent e(GamepadCode_Button_Thumbstick_Left, 0);
-							ProcessInputEvent(e);
+							ProcessPolledInputEvent(e);
 						}
 						else if ((m_XBoxGamepads[i].Gamepad.wButtons & XBoxCode_Button_PressMask_Thumbstick_Left))
 						{
 							KeyReleasedEvent e(GamepadCode_Button_Thumbstick_Left);
-							ProcessInputEvent(e);
+							ProcessPolledInputEvent(e);
 						}
 
 
@@ -390,12 +639,12 @@ namespace Insight {
 						if (State.Gamepad.wButtons & XBoxCode_Button_PressMask_Thumbstick_Right)
 						{
 							KeyPressedEvent e(GamepadCode_Button_Thumbstick_Right, 0);
-							ProcessInputEvent(e);
+							ProcessPolledInputEvent(e);
 						}
 						else if ((m_XBoxGamepads[i].Gamepad.wButtons & XBoxCode_Button_PressMask_Thumbstick_Right))
 						{
 							KeyReleasedEvent e(GamepadCode_Button_Thumbstick_Right);
-							ProcessInputEvent(e);
+							ProcessPolledInputEvent(e);
 						}
 
 
@@ -403,12 +652,12 @@ namespace Insight {
 						if (State.Gamepad.wButtons & XBoxCode_Button_PressMask_Shoulder_Left)
 						{
 							KeyPressedEvent e(GamepadCode_Button_Shoulder_Left, 0);
-							ProcessInputEvent(e);
+							ProcessPolledInputEvent(e);
 						}
 						else if ((m_XBoxGamepads[i].Gamepad.wButtons & XBoxCode_Button_PressMask_Shoulder_Left))
 						{
 							KeyReleasedEvent e(GamepadCode_Button_Shoulder_Left);
-							ProcessInputEvent(e);
+							ProcessPolledInputEvent(e);
 						}
 
 
@@ -416,12 +665,12 @@ namespace Insight {
 						if (State.Gamepad.wButtons & XBoxCode_Button_PressMask_Shoulder_Right)
 						{
 							KeyPressedEvent e(GamepadCode_Button_Shoulder_Right, 0);
-							ProcessInputEvent(e);
+							ProcessPolledInputEvent(e);
 						}
 						else if ((m_XBoxGamepads[i].Gamepad.wButtons & XBoxCode_Button_PressMask_Shoulder_Right))
 						{
 							KeyReleasedEvent e(GamepadCode_Button_Shoulder_Right);
-							ProcessInputEvent(e);
+							ProcessPolledInputEvent(e);
 						}
 
 						// Has the state changed since last poll?
@@ -439,7 +688,7 @@ namespace Insight {
 							float TriggerNormalized = TriggerL / 255;
 							//IE_DEBUG_LOG(LogSeverity::Log, "0 - 1: {0}", TriggerNormalized);
 							KeyPressedEvent e(GamepadCode_Trigger_Left, 0, TriggerNormalized);
-							ProcessInputEvent(e);
+							ProcessPolledInputEvent(e);
 						}
 						else
 						{
@@ -447,7 +696,7 @@ namespace Insight {
 							{
 								TriggerLPressed = false; 
 								KeyReleasedEvent e(GamepadCode_Trigger_Left);
-								ProcessInputEvent(e);
+								ProcessPolledInputEvent(e);
 							}
 						}
 
@@ -460,7 +709,7 @@ namespace Insight {
 							float TriggerNormalized = TriggerR / 255;
 							//IE_DEBUG_LOG(LogSeverity::Log, "0 - 1: {0}", TriggerNormalized);
 							KeyPressedEvent e(GamepadCode_Trigger_Right, 0, TriggerNormalized);
-							ProcessInputEvent(e);
+							ProcessPolledInputEvent(e);
 						}
 						else
 						{
@@ -468,7 +717,7 @@ namespace Insight {
 							{
 								TriggerRPressed = false;
 								KeyReleasedEvent e(GamepadCode_Trigger_Right);
-								ProcessInputEvent(e);
+								ProcessPolledInputEvent(e);
 							}
 						}
 
@@ -529,7 +778,7 @@ namespace Insight {
 						{
 							MoovedLY = true;
 							KeyPressedEvent e(GamepadCode_Thumbstick_Left_Axis_Y, 0, MoveDeltaLY);
-							ProcessInputEvent(e);
+							ProcessPolledInputEvent(e);
 						}
 						else
 						{
@@ -537,7 +786,7 @@ namespace Insight {
 							{
 								MoovedLY = false;
 								KeyReleasedEvent e(GamepadCode_Thumbstick_Left_Axis_Y);
-								ProcessInputEvent(e);
+								ProcessPolledInputEvent(e);
 							}
 						}
 
@@ -547,7 +796,7 @@ namespace Insight {
 						{
 							MoovedLX = true;
 							KeyPressedEvent e(GamepadCode_Thumbstick_Left_Axis_X, 0, MoveDeltaLX);
-							ProcessInputEvent(e);
+							ProcessPolledInputEvent(e);
 						}
 						else
 						{
@@ -555,7 +804,7 @@ namespace Insight {
 							{
 								MoovedLX = false;
 								KeyReleasedEvent e(GamepadCode_Thumbstick_Left_Axis_X);
-								ProcessInputEvent(e);
+								ProcessPolledInputEvent(e);
 							}
 						}
 
@@ -565,7 +814,7 @@ namespace Insight {
 						{
 							MoovedRY = true;
 							KeyPressedEvent e(GamepadCode_Thumbstick_Right_Axis_Y, 0, MoveDeltaRY);
-							ProcessInputEvent(e);
+							ProcessPolledInputEvent(e);
 						}
 						else
 						{
@@ -573,7 +822,7 @@ namespace Insight {
 							{
 								MoovedRY = false;
 								KeyReleasedEvent e(GamepadCode_Thumbstick_Right_Axis_Y);
-								ProcessInputEvent(e);
+								ProcessPolledInputEvent(e);
 							}
 						}
 
@@ -583,7 +832,7 @@ namespace Insight {
 						{
 							MoovedRX = true;
 							KeyPressedEvent e(GamepadCode_Thumbstick_Right_Axis_X, 0, MoveDeltaRX);
-							ProcessInputEvent(e);
+							ProcessPolledInputEvent(e);
 						}
 						else
 						{
@@ -591,7 +840,7 @@ namespace Insight {
 							{
 								MoovedRX = false;
 								KeyReleasedEvent e(GamepadCode_Thumbstick_Right_Axis_X);
-								ProcessInputEvent(e);
+								ProcessPolledInputEvent(e);
 							}
 						}
 					}
@@ -601,6 +850,7 @@ namespace Insight {
 					}
 				}
 			}
+#endif // IE_PLATFORM_WINDOWS
 		}
 		
 		
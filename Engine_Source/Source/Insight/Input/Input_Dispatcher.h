@@ -12,11 +12,12 @@
 	Mapping profiles are created and components request member functions to be called when input
 	events are fulfill the profiles needs. Actor InputComponents (Input_Component.h) bind axis
 	and actions for this to request this functionality.
+	Mappings are loaded from the "Input" section of the user settings file and compiled into
+	per key code binding tables, so dispatching an event never hashes strings or allocates.
 
 	Example Usage:
 	ActionMapping::Hint = "Jump"
 	ActionMapping::MappedKeycode = KeyMapCode_Keyboard_Space
-	ActionMapping::CanDispatch = true;
 	-	Any components that binds a member function to this ActionMapping will be called.
 		Ex. pMyInputComponent->BindAction("Jump", InputEventType_Pressed, IE_BIND_VOID_FN(MyClass::DoJump));
 			- Method "DoJump" will be called in class named "MyClass" when the space bar is pressed.
@@ -29,23 +30,40 @@
 #include "Insight/Events/Event.h"
 #include "Insight/Events/Key_Event.h"
 #include "Insight/Events/Mouse_Event.h"
+#include "Insight/Input/Input_Recorder.h"
+#include "Insight/Utilities/String_Id.h"
 
 // For XBox Controllers
+#if defined (IE_PLATFORM_WINDOWS)
 #include <Xinput.h>
+#endif
 
 namespace Insight {
 
+	class Window;
+
 	namespace Input {
 
 
 
 		constexpr uint8_t MaxHintStringLength = 32u;
+		// Key codes are platform virtual key codes and always fit in a byte.
+		constexpr uint32_t MaxKeyMapCodes = 256u;
 
 		// The required function signature an input component's axis binding should use.
 		using EventInputAxisFn = std::function<void(float)>;
 		// The required function signature an input component's action binding should use.
 		using EventInputActionFn = std::function<void(void)>;
 
+		// Integer id for an axis or action hint. Hints are hashed once when mappings are compiled or callbacks are registered.
+		typedef uint32_t InputHintId;
+
+		// Hash of a hint string, the same as StringId32's. Usable in constant expressions.
+		constexpr InputHintId HashInputHint(const char* Hint)
+		{
+			return StringHash::Fnv1a32(Hint, StringHash::Length(Hint));
+		}
+
 		/*
 			Describes an axis mapping that input components can use to recieve events on.
 			@param Hint: The name to associate an event with.
@@ -54,7 +72,7 @@ namespace Insight {
 		*/
 		struct AxisMapping
 		{
-			const char	Hint[MaxHintStringLength];
+			char		Hint[MaxHintStringLength];
 			KeyMapCode	MappedKeyCode;
 			float		Scale;
 		};
@@ -63,18 +81,11 @@ namespace Insight {
 			Describes an action mapping that input components can use to recieve events on.
 			@param Hint: The name to associate an event with.
 			@param MappedKeyCode: The keycode that will trigger the event callbacks attached to this axis mapping
-			@param CanDispatch: Internal variable used to determine wether to send a "released" event once a
-								"pressed" event has been sent.
-			@parame HoldTime: Internal counter variable that keeps track of how much time the mapped key has been 
-							  held down. If greater than InputDispatcher::m_MaxKeyHoldTime, InputEventType::InputEventType_Held 
-							  events will be dispatched for this action.
 		*/
 		struct ActionMapping
 		{
-			const char	Hint[MaxHintStringLength];
+			char		Hint[MaxHintStringLength];
 			KeyMapCode	MappedKeyCode;
-			bool		CanDispatch = true;
-			float		HoldTime;
 		};
 
 		class INSIGHT_API InputDispatcher
@@ -93,14 +104,40 @@ namespace Insight {
 			*/
 			void SetWindowRef(std::shared_ptr<Window> pWindow) { m_pOwningWindowRef = pWindow; }
 
+			/*
+				Replace the axis and action mappings with those found in the user settings file. 
+				Keeps the current mappings if the file could not be loaded.
+				@param SettingsFile: Path to the settings file. See Content/PROFSAVE.ini "Input" section.
+			*/
+			bool LoadMappingsFromJson(const std::string& SettingsFile);
+			/*
+				Replace the axis and action mappings and rebuild the binding tables.
+			*/
+			void SetMappings(const std::vector<AxisMapping>& AxisMappings, const std::vector<ActionMapping>& ActionMappings);
+			/*
+				Returns the key code with the given name (Ex. "KeyMapCode_Keyboard_W"). -1 if no key exists with the name.
+			*/
+			static KeyMapCode KeyCodeFromName(const char* Name);
+
 			/*
 				Updates the keyboard axis mappings with the OS.
 			*/
 			void UpdateInputs(float DeltaMs);
 			/*
 				Decodes and sends events to approbriate Dispatch* functions.
+				Events passed here are recorded as window input when a recording is active.
 			*/
 			void ProcessInputEvent(Event& e);
+			/*
+				Event bus handler for input sent by the window. Processes the event and leaves it unhandled so layers still see it.
+			*/
+			template <typename EventClass>
+			bool OnWindowInputEvent(EventClass& e) { ProcessInputEvent(e); return false; }
+
+			/*
+				Returns the recorder used to capture and replay the input stream.
+			*/
+			inline InputRecorder& GetRecorder() { return m_Recorder; }
 
 			/*
 				Register an Axis callback function. Used by Actor input components.
@@ -119,6 +156,60 @@ namespace Insight {
 			void AddGamepadVibration(uint32_t PlayerIndex, GampadRumbleMotor Direction, float Amount);
 
 		private:
+			// A range of elements inside of a flat array.
+			struct BindingRange
+			{
+				uint32_t First = 0u;
+				uint32_t Count = 0u;
+			};
+			// A compiled axis mapping.
+			struct AxisBinding
+			{
+				uint32_t AxisIndex;
+				float Scale;
+			};
+			// A compiled action mapping with its runtime key state.
+			struct ActionBinding
+			{
+				uint32_t ActionIndex;
+				// Used to determine wether to send a "released" event once a "pressed" event has been sent.
+				bool CanDispatch;
+				// How long the mapped key has been held down. If greater than InputDispatcher::m_MaxKeyHoldTime, 
+				// InputEventType::InputEventType_Held events will be dispatched for this action.
+				float HoldTime;
+			};
+			template <typename CallbackFn>
+			struct HintCallback
+			{
+				uint32_t SlotIndex;
+				CallbackFn Callback;
+			};
+			static constexpr uint32_t NumInputEventTypes = InputEventType_Moved + 1u;
+
+			void LoadDefaultMappings();
+			/*
+				Resolve every mapping hint to a dense index and build the key code lookup tables. 
+				Only run when the mappings change, never per frame.
+			*/
+			void CompileBindings();
+			uint32_t GetOrCreateAxisIndex(const char* Hint);
+			uint32_t GetOrCreateActionIndex(const char* Hint);
+			// Rebuild the offsets of each slot into a sorted flat callback array.
+			template <typename CallbackFn>
+			static void RebuildCallbackRanges(const std::vector<HintCallback<CallbackFn>>& Callbacks, std::vector<BindingRange>& OutRanges, uint32_t NumSlots);
+
+			void InvokeAxisCallbacks(uint32_t AxisIndex, float Value);
+			void InvokeActionCallbacks(uint32_t ActionIndex, InputEventType EventType);
+
+			/*
+				Record and dispatch an event generated by polling the OS or a gamepad.
+			*/
+			void ProcessPolledInputEvent(Event& e);
+			/*
+				Sends an event to the approbriate Dispatch* functions without recording it.
+			*/
+			void DispatchInputEvent(Event& e);
+
 			/*
 				Dispatch an event to all callbacks that request a key press event.
 			*/
@@ -148,17 +239,33 @@ namespace Insight {
 			std::shared_ptr<Window> m_pOwningWindowRef;
 			// Holds all axis mapping profiles.
 			std::vector<AxisMapping> m_AxisMappings;
-			// Holds all callback funcitons and their corisponding hints found the Axis mappings stored in InputDispatcher::m_AxisMappings.
-			std::map<std::string, std::vector<EventInputAxisFn>> m_AxisCallbacks;
 			// Holds all action mapping profiles.
 			std::vector<ActionMapping> m_ActionMappings;
-			// Holds all callback funcitons and their corisponding hints found the actoin mappings stored in InputDispatcher::m_ActionMappings.
-			std::map<std::pair<std::string, InputEventType>, std::vector<EventInputActionFn>> m_ActionCallbacks;
+
+			// Hint hash to dense axis/action index. Only touched when compiling bindings or registering callbacks.
+			std::unordered_map<InputHintId, uint32_t> m_AxisIndices;
+			std::unordered_map<InputHintId, uint32_t> m_ActionIndices;
+
+			// Compiled bindings sorted by key code. m_*KeyRanges index into them by key code.
+			std::vector<AxisBinding> m_AxisBindings;
+			std::vector<ActionBinding> m_ActionBindings;
+			BindingRange m_AxisKeyRanges[MaxKeyMapCodes];
+			BindingRange m_ActionKeyRanges[MaxKeyMapCodes];
+			// Unique key codes that must be polled each frame to detect held axis keys.
+			std::vector<KeyMapCode> m_PolledKeys;
+
+			// Flat callback arrays sorted by slot. Axis slots are axis indices, action slots are (ActionIndex * NumInputEventTypes + InputEventType).
+			std::vector<HintCallback<EventInputAxisFn>> m_AxisCallbacks;
+			std::vector<BindingRange> m_AxisCallbackRanges;
+			std::vector<HintCallback<EventInputActionFn>> m_ActionCallbacks;
+			std::vector<BindingRange> m_ActionCallbackRanges;
 
 			// Max amount of time the user pressed a key before it is recognized as being held.
 			float m_MaxKeyHoldTime = 1.0f;
+#if defined (IE_PLATFORM_WINDOWS)
 			// Input states for all XBox controllers.
 			XINPUT_STATE m_XBoxGamepads[XUSER_MAX_COUNT];
+#endif
 			// The interval in which to poll controllers and update their input state. This should be kep to a small value and never be 0.
 			float m_GamepadPollInterval;
 
@@ -166,6 +273,9 @@ namespace Insight {
 			float m_GamepadLeftStickSensitivity;
 			float m_GamepadRightStickSensitivity;
 
+			// Captures or plays back the input stream.
+			InputRecorder m_Recorder;
+
 		private:
 			// Static instance of the Input Dispatcher.
 			static InputDispatcher* s_Instance;
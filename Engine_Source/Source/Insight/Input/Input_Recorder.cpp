@@ -0,0 +1,250 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Input_Recorder.h"
+
+namespace Insight {
+
+	namespace Input {
+
+		InputRecorder::~InputRecorder()
+		{
+			EndRecording();
+			EndReplay();
+		}
+
+		bool InputRecorder::BeginRecording(const std::string& FilePath)
+		{
+			IE_ASSERT(!IsReplaying(), "Cannot record input while a replay is in progress.");
+			EndRecording();
+
+			m_pRecordingFile = fopen(FilePath.c_str(), "wb");
+			if (!m_pRecordingFile)
+			{
+				IE_DEBUG_LOG(LogSeverity::Error, "Failed to open input recording file \"{0}\" for writing.", FilePath);
+				return false;
+			}
+
+			// Frame count is patched when the recording ends.
+			const FileHeader Header = { FileMagic, FileVersion, 0u };
+			fwrite(&Header, sizeof(FileHeader), 1, m_pRecordingFile);
+
+			m_RecordingPath = FilePath;
+			m_NumRecordedFrames = 0u;
+			m_HasPendingFrame = false;
+			m_PendingEvents.clear();
+			m_PendingEvents.reserve(64);
+
+			IE_DEBUG_LOG(LogSeverity::Log, "Recording input to \"{0}\".", FilePath);
+			return true;
+		}
+
+		void InputRecorder::EndRecording()
+		{
+			if (!m_pRecordingFile)
+				return;
+
+			WritePendingFrame();
+
+			const FileHeader Header = { FileMagic, FileVersion, m_NumRecordedFrames };
+			fseek(m_pRecordingFile, 0, SEEK_SET);
+			fwrite(&Header, sizeof(FileHeader), 1, m_pRecordingFile);
+			fclose(m_pRecordingFile);
+			m_pRecordingFile = nullptr;
+
+			IE_DEBUG_LOG(LogSeverity::Log, "Finished recording {0} frames of input to \"{1}\".", m_NumRecordedFrames, m_RecordingPath);
+		}
+
+		bool InputRecorder::BeginReplay(const std::string& FilePath)
+		{
+			IE_ASSERT(!IsRecording(), "Cannot replay input while recording.");
+
+			FILE* pFile = fopen(FilePath.c_str(), "rb");
+			if (!pFile)
+			{
+				IE_DEBUG_LOG(LogSeverity::Error, "Failed to open input recording \"{0}\" for replay.", FilePath);
+				return false;
+			}
+
+			FileHeader Header = {};
+			if (fread(&Header, sizeof(FileHeader), 1, pFile) != 1 || Header.Magic != FileMagic || Header.Version != FileVersion)
+			{
+				IE_DEBUG_LOG(LogSeverity::Error, "\"{0}\" is not a valid input recording or was written by an incompatible version.", FilePath);
+				fclose(pFile);
+				return false;
+			}
+
+			m_ReplayFrames.clear();
+			m_ReplayEvents.clear();
+			m_ReplayFrames.reserve(Header.NumFrames);
+
+			for (uint32_t i = 0; i < Header.NumFrames; ++i)
+			{
+				FrameHeader Frame = {};
+				if (fread(&Frame, sizeof(FrameHeader), 1, pFile) != 1)
+				{
+					IE_DEBUG_LOG(LogSeverity::Warning, "Input recording \"{0}\" is truncated. Replaying the first {1} frames.", FilePath, i);
+					break;
+				}
+
+				const uint32_t FirstEvent = static_cast<uint32_t>(m_ReplayEvents.size());
+				m_ReplayEvents.resize(FirstEvent + Frame.NumEvents);
+				if (Frame.NumEvents > 0 && fread(&m_ReplayEvents[FirstEvent], sizeof(RecordedInputEvent), Frame.NumEvents, pFile) != Frame.NumEvents)
+				{
+					IE_DEBUG_LOG(LogSeverity::Warning, "Input recording \"{0}\" is truncated. Replaying the first {1} frames.", FilePath, i);
+					m_ReplayEvents.resize(FirstEvent);
+					break;
+				}
+				m_ReplayFrames.push_back({ Frame.DeltaTime, FirstEvent, Frame.NumEvents });
+			}
+			fclose(pFile);
+
+			m_IsReplaying = true;
+			m_CurrentReplayFrame = 0u;
+			m_ReplayFrameActive = false;
+			m_TotalReplayFrameTime = 0.0;
+			m_MinReplayFrameTime = std::numeric_limits<double>::max();
+			m_MaxReplayFrameTime = 0.0;
+			m_NumTimedReplayFrames = 0u;
+
+			IE_DEBUG_LOG(LogSeverity::Log, "Replaying {0} frames ({1} events) of input from \"{2}\".", m_ReplayFrames.size(), m_ReplayEvents.size(), FilePath);
+			return true;
+		}
+
+		void InputRecorder::EndReplay()
+		{
+			if (!m_IsReplaying)
+				return;
+
+			if (m_NumTimedReplayFrames > 0)
+			{
+				IE_DEBUG_LOG(LogSeverity::Log, "Input replay finished. Frames: {0} | Avg: {1}ms | Min: {2}ms | Max: {3}ms",
+					m_NumTimedReplayFrames, m_TotalReplayFrameTime / m_NumTimedReplayFrames, m_MinReplayFrameTime, m_MaxReplayFrameTime);
+			}
+
+			m_IsReplaying = false;
+			m_ReplayFrameActive = false;
+			m_ReplayFrames.clear();
+			m_ReplayEvents.clear();
+		}
+
+		void InputRecorder::BeginFrame(float& DeltaTime)
+		{
+			if (IsRecording())
+			{
+				WritePendingFrame();
+				m_PendingFrame.DeltaTime = DeltaTime;
+				m_PendingFrame.NumEvents = 0u;
+				m_HasPendingFrame = true;
+			}
+			else if (m_IsReplaying)
+			{
+				const auto Now = std::chrono::high_resolution_clock::now();
+				if (m_ReplayFrameActive)
+				{
+					const double FrameTime = std::chrono::duration<double, std::milli>(Now - m_LastFrameStart).count();
+					m_TotalReplayFrameTime += FrameTime;
+					m_MinReplayFrameTime = std::min(m_MinReplayFrameTime, FrameTime);
+					m_MaxReplayFrameTime = std::max(m_MaxReplayFrameTime, FrameTime);
+					m_NumTimedReplayFrames++;
+				}
+				m_LastFrameStart = Now;
+
+				m_ReplayFrameActive = m_CurrentReplayFrame < m_ReplayFrames.size();
+				if (m_ReplayFrameActive)
+				{
+					if (m_UseRecordedDeltaTime)
+						DeltaTime = m_ReplayFrames[m_CurrentReplayFrame].DeltaTime;
+					m_CurrentReplayFrame++;
+				}
+			}
+		}
+
+		void InputRecorder::RecordEvent(const Event& e, InputSource Source)
+		{
+			// Events that arrive before the first frame begins have no delta time to pair with.
+			if (!IsRecording() || !m_HasPendingFrame)
+				return;
+
+			const InputEvent* pInput = dynamic_cast<const InputEvent*>(&e);
+			const RecordedEventId Id = ToRecordedEventId(e.GetEventType());
+			if (!pInput || Id == RecordedEventId_Invalid)
+				return;
+
+			RecordedInputEvent Record = {};
+			Record.Source = static_cast<uint8_t>(Source);
+			Record.EventType = static_cast<uint8_t>(Id);
+			Record.InputType = static_cast<uint8_t>(pInput->GetEventType());
+			Record.KeyCode = static_cast<int32_t>(pInput->GetKeyCode());
+
+			switch (e.GetEventType())
+			{
+			case EventType::KeyPressed:
+			{
+				const KeyPressedEvent& Pressed = static_cast<const KeyPressedEvent&>(e);
+				Record.X = Pressed.GetMoveDelta();
+				Record.Y = static_cast<float>(Pressed.GetRepeatCount());
+				break;
+			}
+			case EventType::MouseMoved:
+			{
+				const MouseMovedEvent& Moved = static_cast<const MouseMovedEvent&>(e);
+				Record.X = Moved.GetX();
+				Record.Y = Moved.GetY();
+				break;
+			}
+			case EventType::RawMouseMoved:
+			{
+				const MouseRawMoveEvent& Moved = static_cast<const MouseRawMoveEvent&>(e);
+				Record.X = static_cast<float>(Moved.GetX());
+				Record.Y = static_cast<float>(Moved.GetY());
+				break;
+			}
+			case EventType::MouseScrolled:
+			{
+				const MouseScrolledEvent& Scrolled = static_cast<const MouseScrolledEvent&>(e);
+				Record.X = Scrolled.GetXOffset();
+				Record.Y = Scrolled.GetYOffset();
+				break;
+			}
+			default:
+				break;
+			}
+
+			m_PendingEvents.push_back(Record);
+			m_PendingFrame.NumEvents++;
+		}
+
+		RecordedEventId InputRecorder::ToRecordedEventId(EventType Type)
+		{
+			switch (Type)
+			{
+			case EventType::KeyPressed:				return RecordedEventId_KeyPressed;
+			case EventType::KeyReleased:			return RecordedEventId_KeyReleased;
+			case EventType::KeyHeld:				return RecordedEventId_KeyHeld;
+			case EventType::KeyTyped:				return RecordedEventId_KeyTyped;
+			case EventType::MouseMoved:				return RecordedEventId_MouseMoved;
+			case EventType::RawMouseMoved:			return RecordedEventId_RawMouseMoved;
+			case EventType::MouseScrolled:			return RecordedEventId_MouseScrolled;
+			case EventType::MouseButtonPressed:		return RecordedEventId_MouseButtonPressed;
+			case EventType::MouseButtonReleased:	return RecordedEventId_MouseButtonReleased;
+			default:								return RecordedEventId_Invalid;
+			}
+		}
+
+		void InputRecorder::WritePendingFrame()
+		{
+			if (!m_HasPendingFrame)
+				return;
+
+			fwrite(&m_PendingFrame, sizeof(FrameHeader), 1, m_pRecordingFile);
+			if (!m_PendingEvents.empty())
+				fwrite(m_PendingEvents.data(), sizeof(RecordedInputEvent), m_PendingEvents.size(), m_pRecordingFile);
+
+			m_PendingEvents.clear();
+			m_HasPendingFrame = false;
+			m_NumRecordedFrames++;
+		}
+
+	} // end namespace Input
+} // end namespace Insight
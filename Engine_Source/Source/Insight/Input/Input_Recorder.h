@@ -0,0 +1,208 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Input_Recorder.h
+	Source - Input_Recorder.cpp
+
+	Purpose:
+	Records the input stream entering the InputDispatcher and plays it back deterministically.
+
+	Description:
+	While recording, every input event reaching InputDispatcher::ProcessInputEvent is written
+	alongside the delta time of the frame it arrived in. Events are tagged with their source:
+	window events (messages from the OS) or polled events (held keys and gamepads generated by
+	InputDispatcher::UpdateInputs). During replay the window events are fed back through a
+	ReplayWindow and the polled events through the dispatcher, one recorded frame per engine
+	frame, so a session can be rerun with identical input for A/B performance comparisons.
+
+	File layout (little endian):
+		FileHeader
+		[FrameHeader, RecordedInputEvent * FrameHeader::NumEvents] * FileHeader::NumFrames
+
+	Example Usage:
+	Insight.exe -RecordInput Session.ieinput
+	Insight.exe -ReplayInput Session.ieinput -FixedDelta 0.016
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+#include "Insight/Events/Event.h"
+#include "Insight/Events/Key_Event.h"
+#include "Insight/Events/Mouse_Event.h"
+
+namespace Insight {
+
+	namespace Input {
+
+		// Where a recorded input event entered the input system.
+		typedef enum _InputSource : uint8_t
+		{
+			InputSource_Window = 0,
+			InputSource_Polled = 1,
+		} InputSource;
+
+		// Stable id of a recorded event type. These are written to disk and must never be renumbered,
+		// add new ids at the end and bump InputRecorder::FileVersion instead.
+		typedef enum _RecordedEventId : uint8_t
+		{
+			RecordedEventId_Invalid				= 0,
+			RecordedEventId_KeyPressed			= 1,
+			RecordedEventId_KeyReleased			= 2,
+			RecordedEventId_KeyHeld				= 3,
+			RecordedEventId_KeyTyped			= 4,
+			RecordedEventId_MouseMoved			= 5,
+			RecordedEventId_RawMouseMoved		= 6,
+			RecordedEventId_MouseScrolled		= 7,
+			RecordedEventId_MouseButtonPressed	= 8,
+			RecordedEventId_MouseButtonReleased	= 9,
+		} RecordedEventId;
+
+		class INSIGHT_API InputRecorder
+		{
+		public:
+			// "IEIR" when read as bytes.
+			static constexpr uint32_t FileMagic = 0x52494549u;
+			// 2 - EventType is a RecordedEventId instead of the raw EventType value.
+			static constexpr uint32_t FileVersion = 2u;
+
+#pragma pack(push, 1)
+			struct FileHeader
+			{
+				uint32_t Magic;
+				uint32_t Version;
+				uint32_t NumFrames;
+			};
+			struct FrameHeader
+			{
+				float DeltaTime;
+				uint32_t NumEvents;
+			};
+			// A single input event. Payload meaning depends on EventType (Ex. X/Y for mouse events, MoveDelta/RepeatCount for key presses).
+			struct RecordedInputEvent
+			{
+				uint8_t Source;
+				// A RecordedEventId.
+				uint8_t EventType;
+				// An InputEventType.
+				uint8_t InputType;
+				uint8_t Reserved;
+				int32_t KeyCode;
+				float X;
+				float Y;
+			};
+#pragma pack(pop)
+			static_assert(sizeof(RecordedInputEvent) == 16, "RecordedInputEvent should stay 16 bytes.");
+
+		public:
+			InputRecorder() = default;
+			~InputRecorder();
+
+			/*
+				Start writing the input stream to a file. Frames are appended as they complete.
+				@param FilePath: The file to write. Will be overwritten if it exists.
+			*/
+			bool BeginRecording(const std::string& FilePath);
+			// Write the remaining frames and close the recording file.
+			void EndRecording();
+
+			/*
+				Load a recording and start replaying it on the next frame.
+				@param FilePath: The recording to play back.
+			*/
+			bool BeginReplay(const std::string& FilePath);
+			// Stop replaying and log a summary of the frame times measured during the replay.
+			void EndReplay();
+
+			/*
+				Advance to the next frame. Must be called once at the beginning of every game frame.
+				@param DeltaTime: Recording - the delta time of the frame being recorded.
+								  Replaying - replaced by the recorded delta time unless SetUseRecordedDeltaTime(false) was called.
+			*/
+			void BeginFrame(float& DeltaTime);
+
+			// Record an input event. Does nothing when not recording.
+			void RecordEvent(const Event& e, InputSource Source);
+
+			/*
+				Invoke a function for every event from a source in the current replay frame.
+				@param Func: Callable with the signature void(Event&).
+			*/
+			template <typename Fn>
+			void ForEachReplayedEvent(InputSource Source, Fn&& Func);
+
+			inline bool IsRecording() const { return m_pRecordingFile != nullptr; }
+			inline bool IsReplaying() const { return m_IsReplaying; }
+			// Returns true once every recorded frame has been played back.
+			inline bool IsReplayFinished() const { return m_IsReplaying && !m_ReplayFrameActive && m_CurrentReplayFrame >= m_ReplayFrames.size(); }
+			inline void SetUseRecordedDeltaTime(bool UseRecordedDelta) { m_UseRecordedDeltaTime = UseRecordedDelta; }
+
+		private:
+			struct ReplayFrame
+			{
+				float DeltaTime;
+				uint32_t FirstEvent;
+				uint32_t NumEvents;
+			};
+
+			void WritePendingFrame();
+
+			// Returns RecordedEventId_Invalid for events that are not recorded.
+			static RecordedEventId ToRecordedEventId(EventType Type);
+
+		private:
+			// Recording
+			FILE* m_pRecordingFile = nullptr;
+			std::string m_RecordingPath;
+			uint32_t m_NumRecordedFrames = 0u;
+			bool m_HasPendingFrame = false;
+			FrameHeader m_PendingFrame = {};
+			std::vector<RecordedInputEvent> m_PendingEvents;
+
+			// Replay
+			bool m_IsReplaying = false;
+			bool m_UseRecordedDeltaTime = true;
+			std::vector<ReplayFrame> m_ReplayFrames;
+			std::vector<RecordedInputEvent> m_ReplayEvents;
+			size_t m_CurrentReplayFrame = 0u;
+			bool m_ReplayFrameActive = false;
+
+			// Wall clock frame time statistics gathered while replaying.
+			std::chrono::high_resolution_clock::time_point m_LastFrameStart;
+			double m_TotalReplayFrameTime = 0.0;
+			double m_MinReplayFrameTime = 0.0;
+			double m_MaxReplayFrameTime = 0.0;
+			uint32_t m_NumTimedReplayFrames = 0u;
+		};
+
+		template <typename Fn>
+		void InputRecorder::ForEachReplayedEvent(InputSource Source, Fn&& Func)
+		{
+			if (!m_ReplayFrameActive)
+				return;
+
+			const ReplayFrame& Frame = m_ReplayFrames[m_CurrentReplayFrame - 1];
+			for (uint32_t i = Frame.FirstEvent; i < Frame.FirstEvent + Frame.NumEvents; ++i)
+			{
+				const RecordedInputEvent& Record = m_ReplayEvents[i];
+				if (Record.Source != Source)
+					continue;
+
+				const KeyMapCode Key = static_cast<KeyMapCode>(Record.KeyCode);
+				switch (static_cast<RecordedEventId>(Record.EventType))
+				{
+				case RecordedEventId_KeyPressed:			{ KeyPressedEvent e(Key, static_cast<int>(Record.Y), Record.X); Func(e); break; }
+				case RecordedEventId_KeyReleased:			{ KeyReleasedEvent e(Key); Func(e); break; }
+				case RecordedEventId_KeyHeld:				{ KeyHeldEvent e(Key); Func(e); break; }
+				case RecordedEventId_KeyTyped:				{ KeyTypedEvent e(Key); Func(e); break; }
+				case RecordedEventId_MouseMoved:			{ MouseMovedEvent e(Record.X, Record.Y, Key); Func(e); break; }
+				case RecordedEventId_RawMouseMoved:			{ MouseRawMoveEvent e(static_cast<int>(Record.X), static_cast<int>(Record.Y), Key, static_cast<InputEventType>(Record.InputType)); Func(e); break; }
+				case RecordedEventId_MouseScrolled:			{ MouseScrolledEvent e(Record.X, Record.Y, Key, static_cast<InputEventType>(Record.InputType)); Func(e); break; }
+				case RecordedEventId_MouseButtonPressed:	{ MouseButtonPressedEvent e(Key); Func(e); break; }
+				case RecordedEventId_MouseButtonReleased:	{ MouseButtonReleasedEvent e(Key); Func(e); break; }
+				default: break;
+				}
+			}
+		}
+
+	} // end namespace Input
+} // end namespace Insight
@@ -0,0 +1,24 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Input_Replay_Window.h"
+
+namespace Insight {
+
+	namespace Input {
+
+		ReplayWindow::ReplayWindow(InputRecorder& Recorder, const EventCallbackFn& CallbackFn, uint32_t Width, uint32_t Height)
+			: m_Recorder(Recorder)
+		{
+			SetEventCallback(CallbackFn);
+			Resize(Width, Height, false);
+			m_WindowTitle = L"Input Replay";
+		}
+
+		void ReplayWindow::OnUpdate()
+		{
+			m_Recorder.ForEachReplayedEvent(InputSource_Window, m_EventCallbackFn);
+		}
+
+	} // end namespace Input
+} // end namespace Insight
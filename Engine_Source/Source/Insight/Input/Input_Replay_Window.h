@@ -0,0 +1,55 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Input_Replay_Window.h
+	Source - Input_Replay_Window.cpp
+
+	Purpose:
+	Stand-in window that feeds recorded input into the application.
+
+	Description:
+	During an input replay the application keeps rendering into its real window but ignores the
+	input the OS sends it. The replay window takes its place as the input source: each OnUpdate
+	it emits the window events recorded for the current frame through its event callback, and it
+	reports every key as released when polled so the InputDispatcher never reads the live keyboard.
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+#include "Insight/Core/Window.h"
+#include "Insight/Input/Input_Recorder.h"
+
+namespace Insight {
+
+	namespace Input {
+
+		class INSIGHT_API ReplayWindow : public Window
+		{
+		public:
+			/*
+				@param Recorder: The recorder to pull events from. Must be replaying and outlive the window.
+				@param CallbackFn: Where replayed window events are sent. Usually the application's event dispatch.
+				@param Width/Height: Dimensions reported to input consumers. Should match the real window.
+			*/
+			ReplayWindow(InputRecorder& Recorder, const EventCallbackFn& CallbackFn, uint32_t Width, uint32_t Height);
+			virtual ~ReplayWindow() = default;
+
+			// Emit the window events recorded for the current replay frame.
+			virtual void OnUpdate() override;
+			virtual void Shutdown() override {}
+			virtual void PostInit() override {}
+
+			virtual bool ProccessWindowMessages() override { return true; }
+			virtual void CreateMessageBox(const std::wstring& Message, const std::wstring& Title) override {}
+
+			virtual void* GetNativeWindow() const override { return nullptr; }
+			virtual bool SetWindowTitleFPS(float fps) override { return true; }
+			virtual InputEventType GetAsyncKeyState(KeyMapCode Key) const override { return InputEventType_Released; }
+			virtual bool SetWindowTitle(const std::string& newText, bool completlyOverride = false) override { return true; }
+
+		private:
+			InputRecorder& m_Recorder;
+		};
+
+	} // end namespace Input
+} // end namespace Insight
@@ -0,0 +1,225 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Batch_Math.h"
+#include "Batch_Math_Kernels.h"
+
+#include "Insight/Systems/Cpu_Features.h"
+
+#include <atomic>
+
+namespace Insight {
+
+	namespace Math {
+
+		namespace BatchKernels {
+
+			// Reference kernels
+			// -----------------
+
+			void TransformPointsReference(const Simd::Matrix& Matrix, const ieFloat3* pPoints, ieFloat3* pOutPoints, size_t Begin, size_t End)
+			{
+				for (size_t i = Begin; i < End; ++i)
+				{
+					const Simd::Vector P = Simd::LoadFloat3(&pPoints[i].x);
+					Simd::Vector Result = Simd::MultiplyAdd(Simd::SplatLane<0>(P), Matrix.r[0], Matrix.r[3]);
+					Result = Simd::MultiplyAdd(Simd::SplatLane<1>(P), Matrix.r[1], Result);
+					Result = Simd::MultiplyAdd(Simd::SplatLane<2>(P), Matrix.r[2], Result);
+					Simd::StoreFloat3(&pOutPoints[i].x, Result);
+				}
+			}
+
+			void TransformAABBsReference(const Simd::Matrix& Matrix, const ieAABB* pBoxes, ieAABB* pOutBoxes, size_t Begin, size_t End)
+			{
+				// The extents of the transformed box are the extents projected onto the absolute matrix rows.
+				Simd::Vector AbsRows[3];
+				for (int Row = 0; Row < 3; ++Row)
+				{
+					float Values[4];
+					Simd::StoreFloat4(Values, Matrix.r[Row]);
+					AbsRows[Row] = Simd::Set(std::fabs(Values[0]), std::fabs(Values[1]), std::fabs(Values[2]), 0.0f);
+				}
+
+				for (size_t i = Begin; i < End; ++i)
+				{
+					const Simd::Vector Center = Simd::LoadFloat3(&pBoxes[i].Center.x);
+					const Simd::Vector Extents = Simd::LoadFloat3(&pBoxes[i].Extents.x);
+
+					Simd::Vector NewCenter = Simd::MultiplyAdd(Simd::SplatLane<0>(Center), Matrix.r[0], Matrix.r[3]);
+					NewCenter = Simd::MultiplyAdd(Simd::SplatLane<1>(Center), Matrix.r[1], NewCenter);
+					NewCenter = Simd::MultiplyAdd(Simd::SplatLane<2>(Center), Matrix.r[2], NewCenter);
+
+					Simd::Vector NewExtents = Simd::Multiply(Simd::SplatLane<0>(Extents), AbsRows[0]);
+					NewExtents = Simd::MultiplyAdd(Simd::SplatLane<1>(Extents), AbsRows[1], NewExtents);
+					NewExtents = Simd::MultiplyAdd(Simd::SplatLane<2>(Extents), AbsRows[2], NewExtents);
+
+					Simd::StoreFloat3(&pOutBoxes[i].Center.x, NewCenter);
+					Simd::StoreFloat3(&pOutBoxes[i].Extents.x, NewExtents);
+				}
+			}
+
+			void MultiplyMatricesReference(const Simd::Matrix* pA, size_t AStride, const Simd::Matrix* pB, size_t BStride, Simd::Matrix* pOut, size_t Begin, size_t End)
+			{
+				for (size_t i = Begin; i < End; ++i)
+					pOut[i] = Simd::MatrixMultiply(pA[i * AStride], pB[i * BStride]);
+			}
+
+			uint32_t CullSpheresReference(const ieFrustum& Frustum, const ieSphere* pSpheres, uint32_t Begin, uint32_t End, uint32_t* pOutVisibleIndices)
+			{
+				uint32_t NumVisible = 0u;
+				for (uint32_t i = Begin; i < End; ++i)
+				{
+					const ieSphere& Sphere = pSpheres[i];
+					bool Visible = true;
+					for (const ieFloat4& Plane : Frustum.Planes)
+					{
+						const float Distance = Plane.x * Sphere.Center.x + Plane.y * Sphere.Center.y + Plane.z * Sphere.Center.z + Plane.w;
+						Visible &= Distance >= -Sphere.Radius;
+					}
+					if (Visible)
+						pOutVisibleIndices[NumVisible++] = i;
+				}
+				return NumVisible;
+			}
+
+			uint32_t CullAABBsReference(const ieFrustum& Frustum, const ieAABB* pBoxes, uint32_t Begin, uint32_t End, uint32_t* pOutVisibleIndices)
+			{
+				uint32_t NumVisible = 0u;
+				for (uint32_t i = Begin; i < End; ++i)
+				{
+					const ieAABB& Box = pBoxes[i];
+					bool Visible = true;
+					for (const ieFloat4& Plane : Frustum.Planes)
+					{
+						const float Distance = Plane.x * Box.Center.x + Plane.y * Box.Center.y + Plane.z * Box.Center.z + Plane.w;
+						const float Radius = std::fabs(Plane.x) * Box.Extents.x + std::fabs(Plane.y) * Box.Extents.y + std::fabs(Plane.z) * Box.Extents.z;
+						Visible &= Distance + Radius >= 0.0f;
+					}
+					if (Visible)
+						pOutVisibleIndices[NumVisible++] = i;
+				}
+				return NumVisible;
+			}
+
+			void ComposeTransformsReference(const ieFloat3* pPositions, const ieFloat4* pRotations, const ieFloat3* pScales, Simd::Matrix* pOut, size_t Begin, size_t End)
+			{
+				for (size_t i = Begin; i < End; ++i)
+					pOut[i] = Simd::MatrixScaleTranslationRotation(Simd::LoadFloat3(&pScales[i].x), Simd::LoadFloat3(&pPositions[i].x), Simd::LoadFloat4(&pRotations[i].x));
+			}
+
+
+			static void TransformPoints(const Simd::Matrix& Matrix, const ieFloat3* pPoints, ieFloat3* pOutPoints, size_t Count)
+			{
+				TransformPointsReference(Matrix, pPoints, pOutPoints, 0u, Count);
+			}
+
+			static void TransformAABBs(const Simd::Matrix& Matrix, const ieAABB* pBoxes, ieAABB* pOutBoxes, size_t Count)
+			{
+				TransformAABBsReference(Matrix, pBoxes, pOutBoxes, 0u, Count);
+			}
+
+			static void MultiplyMatrices(const Simd::Matrix* pA, size_t AStride, const Simd::Matrix* pB, size_t BStride, Simd::Matrix* pOut, size_t Count)
+			{
+				MultiplyMatricesReference(pA, AStride, pB, BStride, pOut, 0u, Count);
+			}
+
+			static uint32_t CullSpheres(const ieFrustum& Frustum, const ieSphere* pSpheres, uint32_t Count, uint32_t* pOutVisibleIndices)
+			{
+				return CullSpheresReference(Frustum, pSpheres, 0u, Count, pOutVisibleIndices);
+			}
+
+			static uint32_t CullAABBs(const ieFrustum& Frustum, const ieAABB* pBoxes, uint32_t Count, uint32_t* pOutVisibleIndices)
+			{
+				return CullAABBsReference(Frustum, pBoxes, 0u, Count, pOutVisibleIndices);
+			}
+
+			static void ComposeTransforms(const ieFloat3* pPositions, const ieFloat4* pRotations, const ieFloat3* pScales, Simd::Matrix* pOut, size_t Count)
+			{
+				ComposeTransformsReference(pPositions, pRotations, pScales, pOut, 0u, Count);
+			}
+
+			static const BatchMathKernels s_ReferenceKernels =
+			{
+				TransformPoints,
+				TransformAABBs,
+				MultiplyMatrices,
+				CullSpheres,
+				CullAABBs,
+				ComposeTransforms,
+			};
+
+		} // end namespace BatchKernels
+
+
+		// Dispatch
+		// --------
+
+		static std::atomic<const BatchMathKernels*> s_pActiveKernels{ nullptr };
+		static std::atomic<BatchMathLevel> s_ActiveLevel{ BatchMathLevel::Reference };
+
+		const char* GetBatchMathLevelName(BatchMathLevel Level)
+		{
+			switch (Level)
+			{
+			case BatchMathLevel::Reference:	return "Reference";
+			case BatchMathLevel::SSE4:		return "SSE4";
+			case BatchMathLevel::AVX2:		return "AVX2";
+			case BatchMathLevel::AVX512:	return "AVX512";
+			default:						return "Invalid";
+			}
+		}
+
+		const BatchMathKernels* BatchMath::GetKernels(BatchMathLevel Level)
+		{
+			const CpuFeatures& Cpu = CpuFeatures::Get();
+			switch (Level)
+			{
+			case BatchMathLevel::Reference:	return &BatchKernels::s_ReferenceKernels;
+			case BatchMathLevel::SSE4:		return Cpu.SSE41 ? BatchKernels::GetSSE4Kernels() : nullptr;
+			case BatchMathLevel::AVX2:		return (Cpu.AVX2 && Cpu.FMA) ? BatchKernels::GetAVX2Kernels() : nullptr;
+			case BatchMathLevel::AVX512:	return Cpu.AVX512F ? BatchKernels::GetAVX512Kernels() : nullptr;
+			default:						return nullptr;
+			}
+		}
+
+		BatchMathLevel BatchMath::GetBestSupportedLevel()
+		{
+			for (int Level = static_cast<int>(BatchMathLevel::NumLevels) - 1; Level > 0; --Level)
+			{
+				if (GetKernels(static_cast<BatchMathLevel>(Level)))
+					return static_cast<BatchMathLevel>(Level);
+			}
+			return BatchMathLevel::Reference;
+		}
+
+		BatchMathLevel BatchMath::GetActiveLevel()
+		{
+			GetActiveKernels();
+			return s_ActiveLevel.load(std::memory_order_relaxed);
+		}
+
+		bool BatchMath::SetActiveLevel(BatchMathLevel Level)
+		{
+			const BatchMathKernels* pKernels = GetKernels(Level);
+			if (!pKernels)
+				return false;
+
+			s_ActiveLevel.store(Level, std::memory_order_relaxed);
+			s_pActiveKernels.store(pKernels, std::memory_order_release);
+			return true;
+		}
+
+		const BatchMathKernels& BatchMath::GetActiveKernels()
+		{
+			const BatchMathKernels* pKernels = s_pActiveKernels.load(std::memory_order_acquire);
+			if (!pKernels)
+			{
+				// Several threads may get here first, they all pick the same level.
+				SetActiveLevel(GetBestSupportedLevel());
+				pKernels = s_pActiveKernels.load(std::memory_order_acquire);
+			}
+			return *pKernels;
+		}
+
+	} // end namespace Math
+} // end namespace Insight
@@ -0,0 +1,145 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Batch_Math.h
+	Source - Batch_Math.cpp
+
+	Purpose:
+	Math kernels that process whole arrays of points, bounds and matrices at once.
+
+	Description:
+	Each kernel has a reference implementation that handles one element at a time, plus SSE4,
+	AVX2 and AVX-512 implementations that process 4, 8 or 16 elements per iteration. The
+	widest set the CPU supports is picked the first time a kernel is called (see CpuFeatures).
+	Arrays do not need any particular alignment and may be of any length, leftovers that do not
+	fill a whole SIMD register are finished with the reference implementation.
+
+	Matrices follow the Simd_Math conventions: row major, row vectors, row 3 is the translation.
+
+	Example Usage:
+	uint32_t* pVisible = Scratch.AllocateArray<uint32_t>(NumSpheres);
+	uint32_t NumVisible = BatchMath::CullSpheres(Frustum, pSpheres, NumSpheres, pVisible);
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+#include "Insight/Math/ie_Vectors.h"
+#include "Insight/Math/Simd_Math.h"
+
+namespace Insight {
+
+	namespace Math {
+
+		struct ieSphere
+		{
+			ieFloat3 Center;
+			float Radius;
+		};
+
+		// Axis aligned bounding box stored as center and half size.
+		struct ieAABB
+		{
+			ieFloat3 Center;
+			ieFloat3 Extents;
+		};
+
+		// Six planes (Normal.xyz, Distance) with normals facing into the frustum.
+		// A point P is inside a plane when dot(Normal, P) + Distance >= 0.
+		struct ieFrustum
+		{
+			ieFloat4 Planes[6];
+		};
+
+		enum class BatchMathLevel : uint8_t
+		{
+			// One element at a time using the compile time Simd_Math backend.
+			Reference,
+			SSE4,
+			AVX2,
+			AVX512,
+
+			NumLevels
+		};
+
+		INSIGHT_API const char* GetBatchMathLevelName(BatchMathLevel Level);
+
+		// One implementation of every kernel. See BatchMath for what each one does.
+		struct BatchMathKernels
+		{
+			void (*TransformPoints)(const Simd::Matrix& Matrix, const ieFloat3* pPoints, ieFloat3* pOutPoints, size_t Count);
+			void (*TransformAABBs)(const Simd::Matrix& Matrix, const ieAABB* pBoxes, ieAABB* pOutBoxes, size_t Count);
+			void (*MultiplyMatrices)(const Simd::Matrix* pA, size_t AStride, const Simd::Matrix* pB, size_t BStride, Simd::Matrix* pOut, size_t Count);
+			uint32_t (*CullSpheres)(const ieFrustum& Frustum, const ieSphere* pSpheres, uint32_t Count, uint32_t* pOutVisibleIndices);
+			uint32_t (*CullAABBs)(const ieFrustum& Frustum, const ieAABB* pBoxes, uint32_t Count, uint32_t* pOutVisibleIndices);
+			void (*ComposeTransforms)(const ieFloat3* pPositions, const ieFloat4* pRotations, const ieFloat3* pScales, Simd::Matrix* pOut, size_t Count);
+		};
+
+		class INSIGHT_API BatchMath
+		{
+		public:
+			// The widest level both compiled in and supported by this CPU.
+			static BatchMathLevel GetBestSupportedLevel();
+			static BatchMathLevel GetActiveLevel();
+			// Force a level, Ex. to compare implementations. Returns false and leaves the active level unchanged if it is not supported.
+			static bool SetActiveLevel(BatchMathLevel Level);
+			// Returns the kernels for a level, or null if it is not supported.
+			static const BatchMathKernels* GetKernels(BatchMathLevel Level);
+
+			/*
+				Transform points by an affine matrix.
+				@param pOutPoints: May be the same array as pPoints.
+			*/
+			static inline void TransformPoints(const Simd::Matrix& Matrix, const ieFloat3* pPoints, ieFloat3* pOutPoints, size_t Count)
+			{
+				GetActiveKernels().TransformPoints(Matrix, pPoints, pOutPoints, Count);
+			}
+
+			/*
+				Transform boxes by an affine matrix. The results are the axis aligned boxes enclosing the transformed boxes.
+				@param pOutBoxes: May be the same array as pBoxes.
+			*/
+			static inline void TransformAABBs(const Simd::Matrix& Matrix, const ieAABB* pBoxes, ieAABB* pOutBoxes, size_t Count)
+			{
+				GetActiveKernels().TransformAABBs(Matrix, pBoxes, pOutBoxes, Count);
+			}
+
+			/*
+				pOut[i] = pA[i * AStride] * pB[i * BStride]. A stride of zero repeats the same matrix for every element,
+				Ex. multiplying every child matrix by one parent matrix.
+			*/
+			static inline void MultiplyMatrices(const Simd::Matrix* pA, size_t AStride, const Simd::Matrix* pB, size_t BStride, Simd::Matrix* pOut, size_t Count)
+			{
+				GetActiveKernels().MultiplyMatrices(pA, AStride, pB, BStride, pOut, Count);
+			}
+
+			/*
+				Test spheres against a frustum.
+				@param pOutVisibleIndices: Receives the index of every sphere at least partially inside, in ascending order. Must hold Count indices.
+				@return The number of visible spheres.
+			*/
+			static inline uint32_t CullSpheres(const ieFrustum& Frustum, const ieSphere* pSpheres, uint32_t Count, uint32_t* pOutVisibleIndices)
+			{
+				return GetActiveKernels().CullSpheres(Frustum, pSpheres, Count, pOutVisibleIndices);
+			}
+
+			// Same as CullSpheres for axis aligned boxes.
+			static inline uint32_t CullAABBs(const ieFrustum& Frustum, const ieAABB* pBoxes, uint32_t Count, uint32_t* pOutVisibleIndices)
+			{
+				return GetActiveKernels().CullAABBs(Frustum, pBoxes, Count, pOutVisibleIndices);
+			}
+
+			/*
+				Build local matrices from position, unit quaternion and scale arrays.
+				Uses the same Scale * Translation * Rotation order as ieTransform.
+			*/
+			static inline void ComposeTransforms(const ieFloat3* pPositions, const ieFloat4* pRotations, const ieFloat3* pScales, Simd::Matrix* pOut, size_t Count)
+			{
+				GetActiveKernels().ComposeTransforms(pPositions, pRotations, pScales, pOut, Count);
+			}
+
+		private:
+			static const BatchMathKernels& GetActiveKernels();
+		};
+
+	} // end namespace Math
+} // end namespace Insight
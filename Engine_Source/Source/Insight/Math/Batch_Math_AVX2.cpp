@@ -0,0 +1,204 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Batch_Math_Kernels.h"
+
+#if defined (IE_BATCH_MATH_X86)
+
+#include <immintrin.h>
+
+#if defined (__clang__)
+	#pragma clang attribute push(__attribute__((target("avx2,fma"))), apply_to = function)
+#elif defined (__GNUC__)
+	#pragma GCC push_options
+	#pragma GCC target("avx2,fma")
+#endif
+
+namespace Insight {
+
+	namespace Math {
+
+		namespace BatchKernels {
+
+		namespace {
+
+			struct AVX2Ops
+			{
+				using Float = __m256;
+				static constexpr uint32_t Width = 8u;
+				static constexpr uint32_t AllLanes = 0xFFu;
+
+				static FORCE_INLINE Float Set1(float Value) { return _mm256_set1_ps(Value); }
+				static FORCE_INLINE Float Zero() { return _mm256_setzero_ps(); }
+				static FORCE_INLINE Float Add(Float A, Float B) { return _mm256_add_ps(A, B); }
+				static FORCE_INLINE Float Sub(Float A, Float B) { return _mm256_sub_ps(A, B); }
+				static FORCE_INLINE Float Mul(Float A, Float B) { return _mm256_mul_ps(A, B); }
+				static FORCE_INLINE Float MulAdd(Float A, Float B, Float C) { return _mm256_fmadd_ps(A, B, C); }
+				static FORCE_INLINE uint32_t CompareGE(Float A, Float B) { return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(A, B, _CMP_GE_OQ))); }
+
+				static FORCE_INLINE Float Gather(const float* pBase, uint32_t Stride)
+				{
+					const __m256i Offsets = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(static_cast<int>(Stride)));
+					return _mm256_i32gather_ps(pBase, Offsets, 4);
+				}
+
+				// AVX2 has no scatter, write each 128 bit half with SSE stores.
+				static FORCE_INLINE void Scatter(float* pBase, uint32_t Stride, Float Value)
+				{
+					const __m128 Low = _mm256_castps256_ps128(Value);
+					const __m128 High = _mm256_extractf128_ps(Value, 1);
+					_mm_store_ss(pBase, Low);
+					_mm_store_ss(pBase + Stride, _mm_shuffle_ps(Low, Low, _MM_SHUFFLE(1, 1, 1, 1)));
+					_mm_store_ss(pBase + Stride * 2, _mm_movehl_ps(Low, Low));
+					_mm_store_ss(pBase + Stride * 3, _mm_shuffle_ps(Low, Low, _MM_SHUFFLE(3, 3, 3, 3)));
+					_mm_store_ss(pBase + Stride * 4, High);
+					_mm_store_ss(pBase + Stride * 5, _mm_shuffle_ps(High, High, _MM_SHUFFLE(1, 1, 1, 1)));
+					_mm_store_ss(pBase + Stride * 6, _mm_movehl_ps(High, High));
+					_mm_store_ss(pBase + Stride * 7, _mm_shuffle_ps(High, High, _MM_SHUFFLE(3, 3, 3, 3)));
+				}
+
+				// Transposes within each 128 bit half, so row K holds lane K in its low half and lane K + 4 in its high half.
+				static FORCE_INLINE void StoreRows4(float* pBase, uint32_t Stride, Float A, Float B, Float C, Float D)
+				{
+					const __m256 AB_Low = _mm256_unpacklo_ps(A, B);
+					const __m256 AB_High = _mm256_unpackhi_ps(A, B);
+					const __m256 CD_Low = _mm256_unpacklo_ps(C, D);
+					const __m256 CD_High = _mm256_unpackhi_ps(C, D);
+					const __m256 Rows[4] = {
+						_mm256_shuffle_ps(AB_Low, CD_Low, _MM_SHUFFLE(1, 0, 1, 0)),
+						_mm256_shuffle_ps(AB_Low, CD_Low, _MM_SHUFFLE(3, 2, 3, 2)),
+						_mm256_shuffle_ps(AB_High, CD_High, _MM_SHUFFLE(1, 0, 1, 0)),
+						_mm256_shuffle_ps(AB_High, CD_High, _MM_SHUFFLE(3, 2, 3, 2)),
+					};
+					for (uint32_t Row = 0; Row < 4; ++Row)
+					{
+						_mm_storeu_ps(pBase + Stride * Row, _mm256_castps256_ps128(Rows[Row]));
+						_mm_storeu_ps(pBase + Stride * (Row + 4), _mm256_extractf128_ps(Rows[Row], 1));
+					}
+				}
+			};
+
+		} // end anonymous namespace
+
+		} // end namespace BatchKernels
+	} // end namespace Math
+} // end namespace Insight
+
+#include "Batch_Math_Kernels.inl"
+
+namespace Insight {
+
+	namespace Math {
+
+		namespace BatchKernels {
+
+		namespace {
+
+			void TransformPointsAVX2(const Simd::Matrix& Matrix, const ieFloat3* pPoints, ieFloat3* pOutPoints, size_t Count)
+			{
+				TransformPointsT<AVX2Ops>(Matrix, pPoints, pOutPoints, Count);
+			}
+
+			void TransformAABBsAVX2(const Simd::Matrix& Matrix, const ieAABB* pBoxes, ieAABB* pOutBoxes, size_t Count)
+			{
+				TransformAABBsT<AVX2Ops>(Matrix, pBoxes, pOutBoxes, Count);
+			}
+
+			// Two output rows per register. Each 128 bit lane splats its own row of A against the rows of B broadcast to both lanes.
+			void MultiplyMatricesAVX2(const Simd::Matrix* pA, size_t AStride, const Simd::Matrix* pB, size_t BStride, Simd::Matrix* pOut, size_t Count)
+			{
+				for (size_t i = 0; i < Count; ++i)
+				{
+					const float* A = reinterpret_cast<const float*>(&pA[i * AStride]);
+					const float* B = reinterpret_cast<const float*>(&pB[i * BStride]);
+					const __m256 B0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(B + 0));
+					const __m256 B1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(B + 4));
+					const __m256 B2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(B + 8));
+					const __m256 B3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(B + 12));
+
+					__m256 Rows[2];
+					for (int Half = 0; Half < 2; ++Half)
+					{
+						const __m256 ARows = _mm256_loadu_ps(A + Half * 8);
+						__m256 Result = _mm256_mul_ps(_mm256_permute_ps(ARows, _MM_SHUFFLE(0, 0, 0, 0)), B0);
+						Result = _mm256_fmadd_ps(_mm256_permute_ps(ARows, _MM_SHUFFLE(1, 1, 1, 1)), B1, Result);
+						Result = _mm256_fmadd_ps(_mm256_permute_ps(ARows, _MM_SHUFFLE(2, 2, 2, 2)), B2, Result);
+						Result = _mm256_fmadd_ps(_mm256_permute_ps(ARows, _MM_SHUFFLE(3, 3, 3, 3)), B3, Result);
+						Rows[Half] = Result;
+					}
+					// Written after all reads so pOut may alias pA or pB.
+					float* Out = reinterpret_cast<float*>(&pOut[i]);
+					_mm256_storeu_ps(Out + 0, Rows[0]);
+					_mm256_storeu_ps(Out + 8, Rows[1]);
+				}
+			}
+
+			uint32_t CullSpheresAVX2(const ieFrustum& Frustum, const ieSphere* pSpheres, uint32_t Count, uint32_t* pOutVisibleIndices)
+			{
+				return CullSpheresT<AVX2Ops>(Frustum, pSpheres, Count, pOutVisibleIndices);
+			}
+
+			uint32_t CullAABBsAVX2(const ieFrustum& Frustum, const ieAABB* pBoxes, uint32_t Count, uint32_t* pOutVisibleIndices)
+			{
+				return CullAABBsT<AVX2Ops>(Frustum, pBoxes, Count, pOutVisibleIndices);
+			}
+
+			void ComposeTransformsAVX2(const ieFloat3* pPositions, const ieFloat4* pRotations, const ieFloat3* pScales, Simd::Matrix* pOut, size_t Count)
+			{
+				ComposeTransformsT<AVX2Ops>(pPositions, pRotations, pScales, pOut, Count);
+			}
+
+		} // end anonymous namespace
+
+		} // end namespace BatchKernels
+	} // end namespace Math
+} // end namespace Insight
+
+#if defined (__clang__)
+	#pragma clang attribute pop
+#elif defined (__GNUC__)
+	#pragma GCC pop_options
+#endif
+
+namespace Insight {
+
+	namespace Math {
+
+		namespace BatchKernels {
+
+			const BatchMathKernels* GetAVX2Kernels()
+			{
+				static const BatchMathKernels s_Kernels =
+				{
+					TransformPointsAVX2,
+					TransformAABBsAVX2,
+					MultiplyMatricesAVX2,
+					CullSpheresAVX2,
+					CullAABBsAVX2,
+					ComposeTransformsAVX2,
+				};
+				return &s_Kernels;
+			}
+
+		} // end namespace BatchKernels
+	} // end namespace Math
+} // end namespace Insight
+
+#else
+
+namespace Insight {
+
+	namespace Math {
+
+		namespace BatchKernels {
+
+			const BatchMathKernels* GetAVX2Kernels()
+			{
+				return nullptr;
+			}
+
+		} // end namespace BatchKernels
+	} // end namespace Math
+} // end namespace Insight
+
+#endif // IE_BATCH_MATH_X86
@@ -0,0 +1,188 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Batch_Math_Kernels.h"
+
+#if defined (IE_BATCH_MATH_X86)
+
+#include <immintrin.h>
+
+#if defined (__clang__)
+	#pragma clang attribute push(__attribute__((target("avx512f"))), apply_to = function)
+#elif defined (__GNUC__)
+	#pragma GCC push_options
+	#pragma GCC target("avx512f")
+#endif
+
+namespace Insight {
+
+	namespace Math {
+
+		namespace BatchKernels {
+
+		namespace {
+
+			struct AVX512Ops
+			{
+				using Float = __m512;
+				static constexpr uint32_t Width = 16u;
+				static constexpr uint32_t AllLanes = 0xFFFFu;
+
+				static FORCE_INLINE Float Set1(float Value) { return _mm512_set1_ps(Value); }
+				static FORCE_INLINE Float Zero() { return _mm512_setzero_ps(); }
+				static FORCE_INLINE Float Add(Float A, Float B) { return _mm512_add_ps(A, B); }
+				static FORCE_INLINE Float Sub(Float A, Float B) { return _mm512_sub_ps(A, B); }
+				static FORCE_INLINE Float Mul(Float A, Float B) { return _mm512_mul_ps(A, B); }
+				static FORCE_INLINE Float MulAdd(Float A, Float B, Float C) { return _mm512_fmadd_ps(A, B, C); }
+				static FORCE_INLINE uint32_t CompareGE(Float A, Float B) { return static_cast<uint32_t>(_mm512_cmp_ps_mask(A, B, _CMP_GE_OQ)); }
+
+				static FORCE_INLINE __m512i Offsets(uint32_t Stride)
+				{
+					return _mm512_mullo_epi32(_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), _mm512_set1_epi32(static_cast<int>(Stride)));
+				}
+
+				static FORCE_INLINE Float Gather(const float* pBase, uint32_t Stride)
+				{
+					return _mm512_i32gather_ps(Offsets(Stride), pBase, 4);
+				}
+
+				static FORCE_INLINE void Scatter(float* pBase, uint32_t Stride, Float Value)
+				{
+					_mm512_i32scatter_ps(pBase, Offsets(Stride), Value, 4);
+				}
+
+				// Transposes within each 128 bit quarter, so row K holds lanes K, K + 4, K + 8 and K + 12.
+				static FORCE_INLINE void StoreRows4(float* pBase, uint32_t Stride, Float A, Float B, Float C, Float D)
+				{
+					const __m512 AB_Low = _mm512_unpacklo_ps(A, B);
+					const __m512 AB_High = _mm512_unpackhi_ps(A, B);
+					const __m512 CD_Low = _mm512_unpacklo_ps(C, D);
+					const __m512 CD_High = _mm512_unpackhi_ps(C, D);
+					const __m512 Rows[4] = {
+						_mm512_shuffle_ps(AB_Low, CD_Low, _MM_SHUFFLE(1, 0, 1, 0)),
+						_mm512_shuffle_ps(AB_Low, CD_Low, _MM_SHUFFLE(3, 2, 3, 2)),
+						_mm512_shuffle_ps(AB_High, CD_High, _MM_SHUFFLE(1, 0, 1, 0)),
+						_mm512_shuffle_ps(AB_High, CD_High, _MM_SHUFFLE(3, 2, 3, 2)),
+					};
+					for (uint32_t Row = 0; Row < 4; ++Row)
+					{
+						_mm_storeu_ps(pBase + Stride * Row, _mm512_castps512_ps128(Rows[Row]));
+						_mm_storeu_ps(pBase + Stride * (Row + 4), _mm512_extractf32x4_ps(Rows[Row], 1));
+						_mm_storeu_ps(pBase + Stride * (Row + 8), _mm512_extractf32x4_ps(Rows[Row], 2));
+						_mm_storeu_ps(pBase + Stride * (Row + 12), _mm512_extractf32x4_ps(Rows[Row], 3));
+					}
+				}
+			};
+
+		} // end anonymous namespace
+
+		} // end namespace BatchKernels
+	} // end namespace Math
+} // end namespace Insight
+
+#include "Batch_Math_Kernels.inl"
+
+namespace Insight {
+
+	namespace Math {
+
+		namespace BatchKernels {
+
+		namespace {
+
+			void TransformPointsAVX512(const Simd::Matrix& Matrix, const ieFloat3* pPoints, ieFloat3* pOutPoints, size_t Count)
+			{
+				TransformPointsT<AVX512Ops>(Matrix, pPoints, pOutPoints, Count);
+			}
+
+			void TransformAABBsAVX512(const Simd::Matrix& Matrix, const ieAABB* pBoxes, ieAABB* pOutBoxes, size_t Count)
+			{
+				TransformAABBsT<AVX512Ops>(Matrix, pBoxes, pOutBoxes, Count);
+			}
+
+			// The whole matrix in one register. Each 128 bit lane splats its own row of A against the rows of B broadcast to every lane.
+			void MultiplyMatricesAVX512(const Simd::Matrix* pA, size_t AStride, const Simd::Matrix* pB, size_t BStride, Simd::Matrix* pOut, size_t Count)
+			{
+				for (size_t i = 0; i < Count; ++i)
+				{
+					const float* A = reinterpret_cast<const float*>(&pA[i * AStride]);
+					const float* B = reinterpret_cast<const float*>(&pB[i * BStride]);
+					const __m512 ARows = _mm512_loadu_ps(A);
+
+					__m512 Result = _mm512_mul_ps(_mm512_permute_ps(ARows, _MM_SHUFFLE(0, 0, 0, 0)), _mm512_broadcast_f32x4(_mm_loadu_ps(B + 0)));
+					Result = _mm512_fmadd_ps(_mm512_permute_ps(ARows, _MM_SHUFFLE(1, 1, 1, 1)), _mm512_broadcast_f32x4(_mm_loadu_ps(B + 4)), Result);
+					Result = _mm512_fmadd_ps(_mm512_permute_ps(ARows, _MM_SHUFFLE(2, 2, 2, 2)), _mm512_broadcast_f32x4(_mm_loadu_ps(B + 8)), Result);
+					Result = _mm512_fmadd_ps(_mm512_permute_ps(ARows, _MM_SHUFFLE(3, 3, 3, 3)), _mm512_broadcast_f32x4(_mm_loadu_ps(B + 12)), Result);
+					_mm512_storeu_ps(reinterpret_cast<float*>(&pOut[i]), Result);
+				}
+			}
+
+			uint32_t CullSpheresAVX512(const ieFrustum& Frustum, const ieSphere* pSpheres, uint32_t Count, uint32_t* pOutVisibleIndices)
+			{
+				return CullSpheresT<AVX512Ops>(Frustum, pSpheres, Count, pOutVisibleIndices);
+			}
+
+			uint32_t CullAABBsAVX512(const ieFrustum& Frustum, const ieAABB* pBoxes, uint32_t Count, uint32_t* pOutVisibleIndices)
+			{
+				return CullAABBsT<AVX512Ops>(Frustum, pBoxes, Count, pOutVisibleIndices);
+			}
+
+			void ComposeTransformsAVX512(const ieFloat3* pPositions, const ieFloat4* pRotations, const ieFloat3* pScales, Simd::Matrix* pOut, size_t Count)
+			{
+				ComposeTransformsT<AVX512Ops>(pPositions, pRotations, pScales, pOut, Count);
+			}
+
+		} // end anonymous namespace
+
+		} // end namespace BatchKernels
+	} // end namespace Math
+} // end namespace Insight
+
+#if defined (__clang__)
+	#pragma clang attribute pop
+#elif defined (__GNUC__)
+	#pragma GCC pop_options
+#endif
+
+namespace Insight {
+
+	namespace Math {
+
+		namespace BatchKernels {
+
+			const BatchMathKernels* GetAVX512Kernels()
+			{
+				static const BatchMathKernels s_Kernels =
+				{
+					TransformPointsAVX512,
+					TransformAABBsAVX512,
+					MultiplyMatricesAVX512,
+					CullSpheresAVX512,
+					CullAABBsAVX512,
+					ComposeTransformsAVX512,
+				};
+				return &s_Kernels;
+			}
+
+		} // end namespace BatchKernels
+	} // end namespace Math
+} // end namespace Insight
+
+#else
+
+namespace Insight {
+
+	namespace Math {
+
+		namespace BatchKernels {
+
+			const BatchMathKernels* GetAVX512Kernels()
+			{
+				return nullptr;
+			}
+
+		} // end namespace BatchKernels
+	} // end namespace Math
+} // end namespace Insight
+
+#endif // IE_BATCH_MATH_X86
@@ -0,0 +1,62 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Batch_Math_Kernels.h
+	Source - Batch_Math.cpp
+
+	Purpose:
+	Internal interface between BatchMath and its per instruction set implementations.
+
+	Description:
+	The SSE4, AVX2 and AVX-512 kernels each live in their own translation unit that is compiled
+	for that instruction set, and expose their table through the getters below. The reference
+	kernels work on index ranges so the wide kernels can finish off their leftovers with them.
+	Only include from the Batch_Math sources.
+*/
+#pragma once
+
+#include "Insight/Math/Batch_Math.h"
+
+#include <cmath>
+#include <cstring>
+
+#if defined (_MSC_VER)
+	#include <intrin.h>
+#endif
+
+#if defined (_M_X64) || defined (_M_IX86) || defined (__x86_64__) || defined (__i386__)
+	#define IE_BATCH_MATH_X86
+#endif
+
+namespace Insight {
+
+	namespace Math {
+
+		namespace BatchKernels {
+
+			// Reference kernels. Process elements [Begin, End), visible indices are written relative to the start of the arrays.
+			void TransformPointsReference(const Simd::Matrix& Matrix, const ieFloat3* pPoints, ieFloat3* pOutPoints, size_t Begin, size_t End);
+			void TransformAABBsReference(const Simd::Matrix& Matrix, const ieAABB* pBoxes, ieAABB* pOutBoxes, size_t Begin, size_t End);
+			void MultiplyMatricesReference(const Simd::Matrix* pA, size_t AStride, const Simd::Matrix* pB, size_t BStride, Simd::Matrix* pOut, size_t Begin, size_t End);
+			uint32_t CullSpheresReference(const ieFrustum& Frustum, const ieSphere* pSpheres, uint32_t Begin, uint32_t End, uint32_t* pOutVisibleIndices);
+			uint32_t CullAABBsReference(const ieFrustum& Frustum, const ieAABB* pBoxes, uint32_t Begin, uint32_t End, uint32_t* pOutVisibleIndices);
+			void ComposeTransformsReference(const ieFloat3* pPositions, const ieFloat4* pRotations, const ieFloat3* pScales, Simd::Matrix* pOut, size_t Begin, size_t End);
+
+			// Null when the instruction set was not compiled in.
+			const BatchMathKernels* GetSSE4Kernels();
+			const BatchMathKernels* GetAVX2Kernels();
+			const BatchMathKernels* GetAVX512Kernels();
+
+			FORCE_INLINE uint32_t CountTrailingZeros(uint32_t Value)
+			{
+#if defined (_MSC_VER)
+				unsigned long Index;
+				_BitScanForward(&Index, Value);
+				return static_cast<uint32_t>(Index);
+#else
+				return static_cast<uint32_t>(__builtin_ctz(Value));
+#endif
+			}
+
+		} // end namespace BatchKernels
+	} // end namespace Math
+} // end namespace Insight
@@ -0,0 +1,283 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Batch_Math_Kernels.inl
+	Source - Batch_Math_SSE4.cpp, Batch_Math_AVX2.cpp, Batch_Math_AVX512.cpp
+
+	Purpose:
+	Kernel bodies shared by every instruction set.
+
+	Description:
+	Each kernel is written once against an Ops type that wraps one register width. The including
+	translation unit enables its instruction set before including this file and provides an Ops
+	type with:
+		Float, Width, AllLanes
+		Set1, Zero, Add, Sub, Mul, MulAdd(A, B, C) = A * B + C
+		CompareGE(A, B) -> bit per lane where A >= B
+		Gather(pBase, Stride) / Scatter(pBase, Stride, Value): lane i reads/writes pBase[i * Stride]
+		StoreRows4(pBase, Stride, A, B, C, D): lane i writes { A, B, C, D } to pBase + i * Stride
+	Elements are processed Width at a time in structure of arrays form, the leftovers go through
+	the reference kernels. Not guarded by pragma once on purpose, each instruction set gets its own copy.
+*/
+
+namespace Insight {
+
+	namespace Math {
+
+		namespace BatchKernels {
+
+		// Internal linkage so nothing compiled for a wider instruction set can be merged into another translation unit.
+		namespace {
+
+			// Matrices and vectors are read as plain floats so the kernels do not depend on the Simd_Math backend.
+			inline void CopyToFloats(const Simd::Matrix& Matrix, float (&OutValues)[4][4])
+			{
+				static_assert(sizeof(Simd::Matrix) == sizeof(OutValues), "Simd::Matrix is expected to be 16 tightly packed floats.");
+				memcpy(OutValues, &Matrix, sizeof(OutValues));
+			}
+
+			template <typename Ops>
+			void TransformPointsT(const Simd::Matrix& Matrix, const ieFloat3* pPoints, ieFloat3* pOutPoints, size_t Count)
+			{
+				using Float = typename Ops::Float;
+
+				float M[4][4];
+				CopyToFloats(Matrix, M);
+				Float Rows[4][3];
+				for (int Row = 0; Row < 4; ++Row)
+					for (int Col = 0; Col < 3; ++Col)
+						Rows[Row][Col] = Ops::Set1(M[Row][Col]);
+
+				const size_t BlockEnd = Count - Count % Ops::Width;
+				for (size_t i = 0; i < BlockEnd; i += Ops::Width)
+				{
+					const Float X = Ops::Gather(&pPoints[i].x, 3);
+					const Float Y = Ops::Gather(&pPoints[i].y, 3);
+					const Float Z = Ops::Gather(&pPoints[i].z, 3);
+
+					for (int Col = 0; Col < 3; ++Col)
+					{
+						Float Result = Ops::MulAdd(X, Rows[0][Col], Rows[3][Col]);
+						Result = Ops::MulAdd(Y, Rows[1][Col], Result);
+						Result = Ops::MulAdd(Z, Rows[2][Col], Result);
+						Ops::Scatter(&pOutPoints[i].x + Col, 3, Result);
+					}
+				}
+				TransformPointsReference(Matrix, pPoints, pOutPoints, BlockEnd, Count);
+			}
+
+			template <typename Ops>
+			void TransformAABBsT(const Simd::Matrix& Matrix, const ieAABB* pBoxes, ieAABB* pOutBoxes, size_t Count)
+			{
+				using Float = typename Ops::Float;
+				constexpr uint32_t BoxStride = sizeof(ieAABB) / sizeof(float);
+
+				float M[4][4];
+				CopyToFloats(Matrix, M);
+				Float Rows[4][3];
+				Float AbsRows[3][3];
+				for (int Row = 0; Row < 4; ++Row)
+				{
+					for (int Col = 0; Col < 3; ++Col)
+					{
+						Rows[Row][Col] = Ops::Set1(M[Row][Col]);
+						if (Row < 3)
+							AbsRows[Row][Col] = Ops::Set1(std::fabs(M[Row][Col]));
+					}
+				}
+
+				const size_t BlockEnd = Count - Count % Ops::Width;
+				for (size_t i = 0; i < BlockEnd; i += Ops::Width)
+				{
+					const float* pBase = &pBoxes[i].Center.x;
+					const Float CX = Ops::Gather(pBase + 0, BoxStride);
+					const Float CY = Ops::Gather(pBase + 1, BoxStride);
+					const Float CZ = Ops::Gather(pBase + 2, BoxStride);
+					const Float EX = Ops::Gather(pBase + 3, BoxStride);
+					const Float EY = Ops::Gather(pBase + 4, BoxStride);
+					const Float EZ = Ops::Gather(pBase + 5, BoxStride);
+
+					Float NewCenter[3];
+					Float NewExtents[3];
+					for (int Col = 0; Col < 3; ++Col)
+					{
+						NewCenter[Col] = Ops::MulAdd(CX, Rows[0][Col], Rows[3][Col]);
+						NewCenter[Col] = Ops::MulAdd(CY, Rows[1][Col], NewCenter[Col]);
+						NewCenter[Col] = Ops::MulAdd(CZ, Rows[2][Col], NewCenter[Col]);
+
+						NewExtents[Col] = Ops::Mul(EX, AbsRows[0][Col]);
+						NewExtents[Col] = Ops::MulAdd(EY, AbsRows[1][Col], NewExtents[Col]);
+						NewExtents[Col] = Ops::MulAdd(EZ, AbsRows[2][Col], NewExtents[Col]);
+					}
+
+					// All inputs are loaded before anything is written, so in place transforms are safe.
+					float* pOutBase = &pOutBoxes[i].Center.x;
+					for (int Col = 0; Col < 3; ++Col)
+					{
+						Ops::Scatter(pOutBase + Col, BoxStride, NewCenter[Col]);
+						Ops::Scatter(pOutBase + 3 + Col, BoxStride, NewExtents[Col]);
+					}
+				}
+				TransformAABBsReference(Matrix, pBoxes, pOutBoxes, BlockEnd, Count);
+			}
+
+			inline uint32_t WriteVisibleIndices(uint32_t LaneMask, uint32_t FirstIndex, uint32_t* pOutVisibleIndices)
+			{
+				uint32_t NumVisible = 0u;
+				while (LaneMask)
+				{
+					pOutVisibleIndices[NumVisible++] = FirstIndex + CountTrailingZeros(LaneMask);
+					LaneMask &= LaneMask - 1u;
+				}
+				return NumVisible;
+			}
+
+			template <typename Ops>
+			uint32_t CullSpheresT(const ieFrustum& Frustum, const ieSphere* pSpheres, uint32_t Count, uint32_t* pOutVisibleIndices)
+			{
+				using Float = typename Ops::Float;
+				constexpr uint32_t SphereStride = sizeof(ieSphere) / sizeof(float);
+
+				Float Planes[6][4];
+				for (int Plane = 0; Plane < 6; ++Plane)
+				{
+					Planes[Plane][0] = Ops::Set1(Frustum.Planes[Plane].x);
+					Planes[Plane][1] = Ops::Set1(Frustum.Planes[Plane].y);
+					Planes[Plane][2] = Ops::Set1(Frustum.Planes[Plane].z);
+					Planes[Plane][3] = Ops::Set1(Frustum.Planes[Plane].w);
+				}
+
+				uint32_t NumVisible = 0u;
+				const uint32_t BlockEnd = Count - Count % Ops::Width;
+				for (uint32_t i = 0; i < BlockEnd; i += Ops::Width)
+				{
+					const float* pBase = &pSpheres[i].Center.x;
+					const Float X = Ops::Gather(pBase + 0, SphereStride);
+					const Float Y = Ops::Gather(pBase + 1, SphereStride);
+					const Float Z = Ops::Gather(pBase + 2, SphereStride);
+					const Float NegativeRadius = Ops::Sub(Ops::Zero(), Ops::Gather(pBase + 3, SphereStride));
+
+					uint32_t LaneMask = Ops::AllLanes;
+					for (int Plane = 0; Plane < 6; ++Plane)
+					{
+						Float Distance = Ops::MulAdd(X, Planes[Plane][0], Planes[Plane][3]);
+						Distance = Ops::MulAdd(Y, Planes[Plane][1], Distance);
+						Distance = Ops::MulAdd(Z, Planes[Plane][2], Distance);
+						LaneMask &= Ops::CompareGE(Distance, NegativeRadius);
+					}
+					NumVisible += WriteVisibleIndices(LaneMask, i, pOutVisibleIndices + NumVisible);
+				}
+				return NumVisible + CullSpheresReference(Frustum, pSpheres, BlockEnd, Count, pOutVisibleIndices + NumVisible);
+			}
+
+			template <typename Ops>
+			uint32_t CullAABBsT(const ieFrustum& Frustum, const ieAABB* pBoxes, uint32_t Count, uint32_t* pOutVisibleIndices)
+			{
+				using Float = typename Ops::Float;
+				constexpr uint32_t BoxStride = sizeof(ieAABB) / sizeof(float);
+
+				Float Planes[6][4];
+				Float AbsNormals[6][3];
+				for (int Plane = 0; Plane < 6; ++Plane)
+				{
+					const ieFloat4& Source = Frustum.Planes[Plane];
+					Planes[Plane][0] = Ops::Set1(Source.x);
+					Planes[Plane][1] = Ops::Set1(Source.y);
+					Planes[Plane][2] = Ops::Set1(Source.z);
+					Planes[Plane][3] = Ops::Set1(Source.w);
+					AbsNormals[Plane][0] = Ops::Set1(std::fabs(Source.x));
+					AbsNormals[Plane][1] = Ops::Set1(std::fabs(Source.y));
+					AbsNormals[Plane][2] = Ops::Set1(std::fabs(Source.z));
+				}
+
+				const Float ZeroDistance = Ops::Zero();
+				uint32_t NumVisible = 0u;
+				const uint32_t BlockEnd = Count - Count % Ops::Width;
+				for (uint32_t i = 0; i < BlockEnd; i += Ops::Width)
+				{
+					const float* pBase = &pBoxes[i].Center.x;
+					const Float CX = Ops::Gather(pBase + 0, BoxStride);
+					const Float CY = Ops::Gather(pBase + 1, BoxStride);
+					const Float CZ = Ops::Gather(pBase + 2, BoxStride);
+					const Float EX = Ops::Gather(pBase + 3, BoxStride);
+					const Float EY = Ops::Gather(pBase + 4, BoxStride);
+					const Float EZ = Ops::Gather(pBase + 5, BoxStride);
+
+					uint32_t LaneMask = Ops::AllLanes;
+					for (int Plane = 0; Plane < 6; ++Plane)
+					{
+						// Signed distance of the center plus the box's projected radius on the plane normal.
+						Float Distance = Ops::MulAdd(CX, Planes[Plane][0], Planes[Plane][3]);
+						Distance = Ops::MulAdd(CY, Planes[Plane][1], Distance);
+						Distance = Ops::MulAdd(CZ, Planes[Plane][2], Distance);
+						Distance = Ops::MulAdd(EX, AbsNormals[Plane][0], Distance);
+						Distance = Ops::MulAdd(EY, AbsNormals[Plane][1], Distance);
+						Distance = Ops::MulAdd(EZ, AbsNormals[Plane][2], Distance);
+						LaneMask &= Ops::CompareGE(Distance, ZeroDistance);
+					}
+					NumVisible += WriteVisibleIndices(LaneMask, i, pOutVisibleIndices + NumVisible);
+				}
+				return NumVisible + CullAABBsReference(Frustum, pBoxes, BlockEnd, Count, pOutVisibleIndices + NumVisible);
+			}
+
+			template <typename Ops>
+			void ComposeTransformsT(const ieFloat3* pPositions, const ieFloat4* pRotations, const ieFloat3* pScales, Simd::Matrix* pOut, size_t Count)
+			{
+				using Float = typename Ops::Float;
+				constexpr uint32_t MatrixStride = sizeof(Simd::Matrix) / sizeof(float);
+
+				const Float One = Ops::Set1(1.0f);
+				const Float Two = Ops::Set1(2.0f);
+				const Float Zero = Ops::Zero();
+
+				const size_t BlockEnd = Count - Count % Ops::Width;
+				for (size_t i = 0; i < BlockEnd; i += Ops::Width)
+				{
+					const Float QX = Ops::Gather(&pRotations[i].x, 4);
+					const Float QY = Ops::Gather(&pRotations[i].y, 4);
+					const Float QZ = Ops::Gather(&pRotations[i].z, 4);
+					const Float QW = Ops::Gather(&pRotations[i].w, 4);
+
+					const Float XX = Ops::Mul(QX, QX), YY = Ops::Mul(QY, QY), ZZ = Ops::Mul(QZ, QZ);
+					const Float XY = Ops::Mul(QX, QY), XZ = Ops::Mul(QX, QZ), YZ = Ops::Mul(QY, QZ);
+					const Float WX = Ops::Mul(QW, QX), WY = Ops::Mul(QW, QY), WZ = Ops::Mul(QW, QZ);
+
+					// Same layout as Simd::MatrixRotationQuaternion.
+					Float R[3][3];
+					R[0][0] = Ops::Sub(One, Ops::Mul(Two, Ops::Add(YY, ZZ)));
+					R[0][1] = Ops::Mul(Two, Ops::Add(XY, WZ));
+					R[0][2] = Ops::Mul(Two, Ops::Sub(XZ, WY));
+					R[1][0] = Ops::Mul(Two, Ops::Sub(XY, WZ));
+					R[1][1] = Ops::Sub(One, Ops::Mul(Two, Ops::Add(XX, ZZ)));
+					R[1][2] = Ops::Mul(Two, Ops::Add(YZ, WX));
+					R[2][0] = Ops::Mul(Two, Ops::Add(XZ, WY));
+					R[2][1] = Ops::Mul(Two, Ops::Sub(YZ, WX));
+					R[2][2] = Ops::Sub(One, Ops::Mul(Two, Ops::Add(XX, YY)));
+
+					const Float Scale[3] = { Ops::Gather(&pScales[i].x, 3), Ops::Gather(&pScales[i].y, 3), Ops::Gather(&pScales[i].z, 3) };
+					const Float TX = Ops::Gather(&pPositions[i].x, 3);
+					const Float TY = Ops::Gather(&pPositions[i].y, 3);
+					const Float TZ = Ops::Gather(&pPositions[i].z, 3);
+
+					// Transform each row back to one matrix per lane.
+					float* pOutBase = reinterpret_cast<float*>(&pOut[i]);
+					for (int Row = 0; Row < 3; ++Row)
+						Ops::StoreRows4(pOutBase + Row * 4, MatrixStride, Ops::Mul(Scale[Row], R[Row][0]), Ops::Mul(Scale[Row], R[Row][1]), Ops::Mul(Scale[Row], R[Row][2]), Zero);
+
+					// Translation row is the position rotated by the quaternion, T * R.
+					Float Translation[3];
+					for (int Col = 0; Col < 3; ++Col)
+					{
+						Translation[Col] = Ops::Mul(TX, R[0][Col]);
+						Translation[Col] = Ops::MulAdd(TY, R[1][Col], Translation[Col]);
+						Translation[Col] = Ops::MulAdd(TZ, R[2][Col], Translation[Col]);
+					}
+					Ops::StoreRows4(pOutBase + 12, MatrixStride, Translation[0], Translation[1], Translation[2], One);
+				}
+				ComposeTransformsReference(pPositions, pRotations, pScales, pOut, BlockEnd, Count);
+			}
+
+		} // end anonymous namespace
+
+		} // end namespace BatchKernels
+	} // end namespace Math
+} // end namespace Insight
@@ -0,0 +1,185 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Batch_Math_Kernels.h"
+
+#if defined (IE_BATCH_MATH_X86)
+
+#include <immintrin.h>
+
+#if defined (__clang__)
+	#pragma clang attribute push(__attribute__((target("sse4.1"))), apply_to = function)
+#elif defined (__GNUC__)
+	#pragma GCC push_options
+	#pragma GCC target("sse4.1")
+#endif
+
+namespace Insight {
+
+	namespace Math {
+
+		namespace BatchKernels {
+
+		namespace {
+
+			struct SSE4Ops
+			{
+				using Float = __m128;
+				static constexpr uint32_t Width = 4u;
+				static constexpr uint32_t AllLanes = 0xFu;
+
+				static FORCE_INLINE Float Set1(float Value) { return _mm_set1_ps(Value); }
+				static FORCE_INLINE Float Zero() { return _mm_setzero_ps(); }
+				static FORCE_INLINE Float Add(Float A, Float B) { return _mm_add_ps(A, B); }
+				static FORCE_INLINE Float Sub(Float A, Float B) { return _mm_sub_ps(A, B); }
+				static FORCE_INLINE Float Mul(Float A, Float B) { return _mm_mul_ps(A, B); }
+				static FORCE_INLINE Float MulAdd(Float A, Float B, Float C) { return _mm_add_ps(_mm_mul_ps(A, B), C); }
+				static FORCE_INLINE uint32_t CompareGE(Float A, Float B) { return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmpge_ps(A, B))); }
+
+				static FORCE_INLINE Float Gather(const float* pBase, uint32_t Stride)
+				{
+					return _mm_setr_ps(pBase[0], pBase[Stride], pBase[Stride * 2], pBase[Stride * 3]);
+				}
+
+				static FORCE_INLINE void Scatter(float* pBase, uint32_t Stride, Float Value)
+				{
+					_mm_store_ss(pBase, Value);
+					_mm_store_ss(pBase + Stride, _mm_shuffle_ps(Value, Value, _MM_SHUFFLE(1, 1, 1, 1)));
+					_mm_store_ss(pBase + Stride * 2, _mm_movehl_ps(Value, Value));
+					_mm_store_ss(pBase + Stride * 3, _mm_shuffle_ps(Value, Value, _MM_SHUFFLE(3, 3, 3, 3)));
+				}
+
+				static FORCE_INLINE void StoreRows4(float* pBase, uint32_t Stride, Float A, Float B, Float C, Float D)
+				{
+					_MM_TRANSPOSE4_PS(A, B, C, D);
+					_mm_storeu_ps(pBase, A);
+					_mm_storeu_ps(pBase + Stride, B);
+					_mm_storeu_ps(pBase + Stride * 2, C);
+					_mm_storeu_ps(pBase + Stride * 3, D);
+				}
+			};
+
+		} // end anonymous namespace
+
+		} // end namespace BatchKernels
+	} // end namespace Math
+} // end namespace Insight
+
+#include "Batch_Math_Kernels.inl"
+
+namespace Insight {
+
+	namespace Math {
+
+		namespace BatchKernels {
+
+		namespace {
+
+			void TransformPointsSSE4(const Simd::Matrix& Matrix, const ieFloat3* pPoints, ieFloat3* pOutPoints, size_t Count)
+			{
+				TransformPointsT<SSE4Ops>(Matrix, pPoints, pOutPoints, Count);
+			}
+
+			void TransformAABBsSSE4(const Simd::Matrix& Matrix, const ieAABB* pBoxes, ieAABB* pOutBoxes, size_t Count)
+			{
+				TransformAABBsT<SSE4Ops>(Matrix, pBoxes, pOutBoxes, Count);
+			}
+
+			// One output row per register, each row of A is splatted lane by lane against the rows of B.
+			void MultiplyMatricesSSE4(const Simd::Matrix* pA, size_t AStride, const Simd::Matrix* pB, size_t BStride, Simd::Matrix* pOut, size_t Count)
+			{
+				for (size_t i = 0; i < Count; ++i)
+				{
+					const float* A = reinterpret_cast<const float*>(&pA[i * AStride]);
+					const float* B = reinterpret_cast<const float*>(&pB[i * BStride]);
+					const __m128 B0 = _mm_loadu_ps(B + 0);
+					const __m128 B1 = _mm_loadu_ps(B + 4);
+					const __m128 B2 = _mm_loadu_ps(B + 8);
+					const __m128 B3 = _mm_loadu_ps(B + 12);
+
+					__m128 Rows[4];
+					for (int Row = 0; Row < 4; ++Row)
+					{
+						const __m128 ARow = _mm_loadu_ps(A + Row * 4);
+						__m128 Result = _mm_mul_ps(_mm_shuffle_ps(ARow, ARow, _MM_SHUFFLE(0, 0, 0, 0)), B0);
+						Result = _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(ARow, ARow, _MM_SHUFFLE(1, 1, 1, 1)), B1), Result);
+						Result = _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(ARow, ARow, _MM_SHUFFLE(2, 2, 2, 2)), B2), Result);
+						Result = _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(ARow, ARow, _MM_SHUFFLE(3, 3, 3, 3)), B3), Result);
+						Rows[Row] = Result;
+					}
+					// Written after all reads so pOut may alias pA or pB.
+					float* Out = reinterpret_cast<float*>(&pOut[i]);
+					for (int Row = 0; Row < 4; ++Row)
+						_mm_storeu_ps(Out + Row * 4, Rows[Row]);
+				}
+			}
+
+			uint32_t CullSpheresSSE4(const ieFrustum& Frustum, const ieSphere* pSpheres, uint32_t Count, uint32_t* pOutVisibleIndices)
+			{
+				return CullSpheresT<SSE4Ops>(Frustum, pSpheres, Count, pOutVisibleIndices);
+			}
+
+			uint32_t CullAABBsSSE4(const ieFrustum& Frustum, const ieAABB* pBoxes, uint32_t Count, uint32_t* pOutVisibleIndices)
+			{
+				return CullAABBsT<SSE4Ops>(Frustum, pBoxes, Count, pOutVisibleIndices);
+			}
+
+			void ComposeTransformsSSE4(const ieFloat3* pPositions, const ieFloat4* pRotations, const ieFloat3* pScales, Simd::Matrix* pOut, size_t Count)
+			{
+				ComposeTransformsT<SSE4Ops>(pPositions, pRotations, pScales, pOut, Count);
+			}
+
+		} // end anonymous namespace
+
+		} // end namespace BatchKernels
+	} // end namespace Math
+} // end namespace Insight
+
+#if defined (__clang__)
+	#pragma clang attribute pop
+#elif defined (__GNUC__)
+	#pragma GCC pop_options
+#endif
+
+namespace Insight {
+
+	namespace Math {
+
+		namespace BatchKernels {
+
+			const BatchMathKernels* GetSSE4Kernels()
+			{
+				static const BatchMathKernels s_Kernels =
+				{
+					TransformPointsSSE4,
+					TransformAABBsSSE4,
+					MultiplyMatricesSSE4,
+					CullSpheresSSE4,
+					CullAABBsSSE4,
+					ComposeTransformsSSE4,
+				};
+				return &s_Kernels;
+			}
+
+		} // end namespace BatchKernels
+	} // end namespace Math
+} // end namespace Insight
+
+#else
+
+namespace Insight {
+
+	namespace Math {
+
+		namespace BatchKernels {
+
+			const BatchMathKernels* GetSSE4Kernels()
+			{
+				return nullptr;
+			}
+
+		} // end namespace BatchKernels
+	} // end namespace Math
+} // end namespace Insight
+
+#endif // IE_BATCH_MATH_X86
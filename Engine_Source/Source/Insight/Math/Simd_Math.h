@@ -0,0 +1,368 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Simd_Math.h
+	Source - N/A
+
+	Purpose:
+	Small platform independent SIMD layer for vectors, quaternions and matrices.
+
+	Description:
+	The backend is picked at compile time: SSE on x86/x64, NEON on ARM and plain floats
+	everywhere else. Define IE_SIMD_FORCE_SCALAR to build the scalar backend on any platform,
+	useful for checking the SIMD paths against it. Nothing here depends on DirectXMath so it
+	builds on Linux for tools and benchmarks.
+
+	Conventions match the DirectXMath ones the renderer uses so results can be handed
+	straight to an ieMatrix: matrices are row major and multiply row vectors (v * M), and
+	quaternions built from Euler angles match XMQuaternionRotationRollPitchYaw (roll about Z,
+	then pitch about X, then yaw about Y).
+
+	Example Usage:
+	Simd::Vector Rotation = Simd::QuaternionRollPitchYaw(Pitch, Yaw, 0.0f);
+	Simd::Vector Forward = Simd::Rotate3(Simd::Set(0.0f, 0.0f, 1.0f, 0.0f), Rotation);
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+#include <cmath>
+
+#if !defined (IE_SIMD_FORCE_SCALAR) && (defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2))
+	#define IE_SIMD_SSE
+	#include <emmintrin.h>
+#elif !defined (IE_SIMD_FORCE_SCALAR) && (defined (__ARM_NEON) || defined (_M_ARM64) || defined (_M_ARM))
+	#define IE_SIMD_NEON
+	#include <arm_neon.h>
+#else
+	#define IE_SIMD_SCALAR
+#endif
+
+namespace Insight {
+
+	namespace Math {
+
+		namespace Simd {
+
+#if defined (IE_SIMD_SSE)
+			typedef __m128 Vector;
+#elif defined (IE_SIMD_NEON)
+			typedef float32x4_t Vector;
+#else
+			struct alignas(16) Vector
+			{
+				float f[4];
+			};
+#endif
+
+			// Four row vectors. Row 3 holds the translation.
+			struct alignas(16) Matrix
+			{
+				Vector r[4];
+			};
+
+
+			// Construction, loads and stores
+			// -------------------------------
+
+			FORCE_INLINE Vector Set(float X, float Y, float Z, float W)
+			{
+#if defined (IE_SIMD_SSE)
+				return _mm_set_ps(W, Z, Y, X);
+#elif defined (IE_SIMD_NEON)
+				const float Values[4] = { X, Y, Z, W };
+				return vld1q_f32(Values);
+#else
+				return Vector{ { X, Y, Z, W } };
+#endif
+			}
+
+			FORCE_INLINE Vector Splat(float Value)
+			{
+#if defined (IE_SIMD_SSE)
+				return _mm_set1_ps(Value);
+#elif defined (IE_SIMD_NEON)
+				return vdupq_n_f32(Value);
+#else
+				return Vector{ { Value, Value, Value, Value } };
+#endif
+			}
+
+			FORCE_INLINE Vector Zero()
+			{
+				return Splat(0.0f);
+			}
+
+			// Load three floats. W is set to zero.
+			FORCE_INLINE Vector LoadFloat3(const float* pSource)
+			{
+#if defined (IE_SIMD_SSE)
+				return _mm_set_ps(0.0f, pSource[2], pSource[1], pSource[0]);
+#elif defined (IE_SIMD_NEON)
+				return vcombine_f32(vld1_f32(pSource), vld1_lane_f32(pSource + 2, vdup_n_f32(0.0f), 0));
+#else
+				return Vector{ { pSource[0], pSource[1], pSource[2], 0.0f } };
+#endif
+			}
+
+			FORCE_INLINE Vector LoadFloat4(const float* pSource)
+			{
+#if defined (IE_SIMD_SSE)
+				return _mm_loadu_ps(pSource);
+#elif defined (IE_SIMD_NEON)
+				return vld1q_f32(pSource);
+#else
+				return Vector{ { pSource[0], pSource[1], pSource[2], pSource[3] } };
+#endif
+			}
+
+			FORCE_INLINE void StoreFloat3(float* pDest, Vector V)
+			{
+#if defined (IE_SIMD_SSE)
+				_mm_storel_pi(reinterpret_cast<__m64*>(pDest), V);
+				_mm_store_ss(pDest + 2, _mm_shuffle_ps(V, V, _MM_SHUFFLE(2, 2, 2, 2)));
+#elif defined (IE_SIMD_NEON)
+				vst1_f32(pDest, vget_low_f32(V));
+				vst1q_lane_f32(pDest + 2, V, 2);
+#else
+				pDest[0] = V.f[0]; pDest[1] = V.f[1]; pDest[2] = V.f[2];
+#endif
+			}
+
+			FORCE_INLINE void StoreFloat4(float* pDest, Vector V)
+			{
+#if defined (IE_SIMD_SSE)
+				_mm_storeu_ps(pDest, V);
+#elif defined (IE_SIMD_NEON)
+				vst1q_f32(pDest, V);
+#else
+				pDest[0] = V.f[0]; pDest[1] = V.f[1]; pDest[2] = V.f[2]; pDest[3] = V.f[3];
+#endif
+			}
+
+
+			// Component access
+			// ----------------
+
+			template <int Lane>
+			FORCE_INLINE float GetLane(Vector V)
+			{
+				static_assert(Lane >= 0 && Lane < 4, "Vector lane out of range.");
+#if defined (IE_SIMD_SSE)
+				return _mm_cvtss_f32(_mm_shuffle_ps(V, V, _MM_SHUFFLE(Lane, Lane, Lane, Lane)));
+#elif defined (IE_SIMD_NEON)
+				return vgetq_lane_f32(V, Lane);
+#else
+				return V.f[Lane];
+#endif
+			}
+
+			template <int Lane>
+			FORCE_INLINE Vector SplatLane(Vector V)
+			{
+				static_assert(Lane >= 0 && Lane < 4, "Vector lane out of range.");
+#if defined (IE_SIMD_SSE)
+				return _mm_shuffle_ps(V, V, _MM_SHUFFLE(Lane, Lane, Lane, Lane));
+#elif defined (IE_SIMD_NEON)
+				return vdupq_n_f32(vgetq_lane_f32(V, Lane));
+#else
+				return Splat(V.f[Lane]);
+#endif
+			}
+
+			FORCE_INLINE float GetX(Vector V) { return GetLane<0>(V); }
+			FORCE_INLINE float GetY(Vector V) { return GetLane<1>(V); }
+			FORCE_INLINE float GetZ(Vector V) { return GetLane<2>(V); }
+			FORCE_INLINE float GetW(Vector V) { return GetLane<3>(V); }
+
+
+			// Arithmetic
+			// ----------
+
+			FORCE_INLINE Vector Add(Vector A, Vector B)
+			{
+#if defined (IE_SIMD_SSE)
+				return _mm_add_ps(A, B);
+#elif defined (IE_SIMD_NEON)
+				return vaddq_f32(A, B);
+#else
+				return Vector{ { A.f[0] + B.f[0], A.f[1] + B.f[1], A.f[2] + B.f[2], A.f[3] + B.f[3] } };
+#endif
+			}
+
+			FORCE_INLINE Vector Subtract(Vector A, Vector B)
+			{
+#if defined (IE_SIMD_SSE)
+				return _mm_sub_ps(A, B);
+#elif defined (IE_SIMD_NEON)
+				return vsubq_f32(A, B);
+#else
+				return Vector{ { A.f[0] - B.f[0], A.f[1] - B.f[1], A.f[2] - B.f[2], A.f[3] - B.f[3] } };
+#endif
+			}
+
+			FORCE_INLINE Vector Multiply(Vector A, Vector B)
+			{
+#if defined (IE_SIMD_SSE)
+				return _mm_mul_ps(A, B);
+#elif defined (IE_SIMD_NEON)
+				return vmulq_f32(A, B);
+#else
+				return Vector{ { A.f[0] * B.f[0], A.f[1] * B.f[1], A.f[2] * B.f[2], A.f[3] * B.f[3] } };
+#endif
+			}
+
+			// Returns A * B + C.
+			FORCE_INLINE Vector MultiplyAdd(Vector A, Vector B, Vector C)
+			{
+#if defined (IE_SIMD_SSE)
+				return _mm_add_ps(_mm_mul_ps(A, B), C);
+#elif defined (IE_SIMD_NEON)
+				return vmlaq_f32(C, A, B);
+#else
+				return Add(Multiply(A, B), C);
+#endif
+			}
+
+			FORCE_INLINE Vector Scale(Vector V, float Factor)
+			{
+				return Multiply(V, Splat(Factor));
+			}
+
+			FORCE_INLINE Vector Negate(Vector V)
+			{
+				return Subtract(Zero(), V);
+			}
+
+			FORCE_INLINE float Dot3(Vector A, Vector B)
+			{
+#if defined (IE_SIMD_SSE)
+				const __m128 Product = _mm_mul_ps(A, B);
+				const __m128 Y = _mm_shuffle_ps(Product, Product, _MM_SHUFFLE(1, 1, 1, 1));
+				const __m128 Z = _mm_shuffle_ps(Product, Product, _MM_SHUFFLE(2, 2, 2, 2));
+				return _mm_cvtss_f32(_mm_add_ss(_mm_add_ss(Product, Y), Z));
+#else
+				const Vector Product = Multiply(A, B);
+				return GetX(Product) + GetY(Product) + GetZ(Product);
+#endif
+			}
+
+			// Cross product of the XYZ components. W of the result is zero.
+			FORCE_INLINE Vector Cross3(Vector A, Vector B)
+			{
+#if defined (IE_SIMD_SSE)
+				const __m128 A_YZX = _mm_shuffle_ps(A, A, _MM_SHUFFLE(3, 0, 2, 1));
+				const __m128 B_YZX = _mm_shuffle_ps(B, B, _MM_SHUFFLE(3, 0, 2, 1));
+				const __m128 Result = _mm_sub_ps(_mm_mul_ps(A, B_YZX), _mm_mul_ps(A_YZX, B));
+				return _mm_shuffle_ps(Result, Result, _MM_SHUFFLE(3, 0, 2, 1));
+#else
+				const float AX = GetX(A), AY = GetY(A), AZ = GetZ(A);
+				const float BX = GetX(B), BY = GetY(B), BZ = GetZ(B);
+				return Set(AY * BZ - AZ * BY, AZ * BX - AX * BZ, AX * BY - AY * BX, 0.0f);
+#endif
+			}
+
+
+			// Quaternions
+			// -----------
+
+			// Build a rotation quaternion from Euler angles in radians. Matches XMQuaternionRotationRollPitchYaw.
+			inline Vector QuaternionRollPitchYaw(float Pitch, float Yaw, float Roll)
+			{
+				const float SP = std::sin(Pitch * 0.5f), CP = std::cos(Pitch * 0.5f);
+				const float SY = std::sin(Yaw * 0.5f), CY = std::cos(Yaw * 0.5f);
+				const float SR = std::sin(Roll * 0.5f), CR = std::cos(Roll * 0.5f);
+				return Set(
+					CR * SP * CY + SR * CP * SY,
+					CR * CP * SY - SR * SP * CY,
+					SR * CP * CY - CR * SP * SY,
+					CR * CP * CY + SR * SP * SY
+				);
+			}
+
+			// Rotate the XYZ components of a vector by a unit quaternion. W of V should be zero.
+			FORCE_INLINE Vector Rotate3(Vector V, Vector Q)
+			{
+				// v' = v + w * t + q.xyz x t, where t = 2 * (q.xyz x v).
+				const Vector T = Scale(Cross3(Q, V), 2.0f);
+				return Add(MultiplyAdd(SplatLane<3>(Q), T, V), Cross3(Q, T));
+			}
+
+
+			// Matrices
+			// --------
+
+			FORCE_INLINE Matrix MatrixIdentity()
+			{
+				return Matrix{ { Set(1.0f, 0.0f, 0.0f, 0.0f), Set(0.0f, 1.0f, 0.0f, 0.0f), Set(0.0f, 0.0f, 1.0f, 0.0f), Set(0.0f, 0.0f, 0.0f, 1.0f) } };
+			}
+
+			// Rotation matrix from a unit quaternion. Matches XMMatrixRotationQuaternion.
+			inline Matrix MatrixRotationQuaternion(Vector Q)
+			{
+				const float X = GetX(Q), Y = GetY(Q), Z = GetZ(Q), W = GetW(Q);
+				const float XX = X * X, YY = Y * Y, ZZ = Z * Z;
+				const float XY = X * Y, XZ = X * Z, YZ = Y * Z;
+				const float WX = W * X, WY = W * Y, WZ = W * Z;
+				return Matrix{ {
+					Set(1.0f - 2.0f * (YY + ZZ), 2.0f * (XY + WZ), 2.0f * (XZ - WY), 0.0f),
+					Set(2.0f * (XY - WZ), 1.0f - 2.0f * (XX + ZZ), 2.0f * (YZ + WX), 0.0f),
+					Set(2.0f * (XZ + WY), 2.0f * (YZ - WX), 1.0f - 2.0f * (XX + YY), 0.0f),
+					Set(0.0f, 0.0f, 0.0f, 1.0f)
+				} };
+			}
+
+			// Swap rows and columns. Matches XMMatrixTranspose.
+			FORCE_INLINE Matrix MatrixTranspose(const Matrix& M)
+			{
+#if defined (IE_SIMD_SSE)
+				Matrix Result = M;
+				_MM_TRANSPOSE4_PS(Result.r[0], Result.r[1], Result.r[2], Result.r[3]);
+				return Result;
+#else
+				float Rows[4][4];
+				for (int i = 0; i < 4; ++i)
+					StoreFloat4(Rows[i], M.r[i]);
+				Matrix Result;
+				for (int i = 0; i < 4; ++i)
+					Result.r[i] = Set(Rows[0][i], Rows[1][i], Rows[2][i], Rows[3][i]);
+				return Result;
+#endif
+			}
+
+			// Returns A * B.
+			FORCE_INLINE Matrix MatrixMultiply(const Matrix& A, const Matrix& B)
+			{
+				Matrix Result;
+				for (int i = 0; i < 4; ++i)
+				{
+					const Vector Row = A.r[i];
+					Vector Out = Multiply(SplatLane<0>(Row), B.r[0]);
+					Out = MultiplyAdd(SplatLane<1>(Row), B.r[1], Out);
+					Out = MultiplyAdd(SplatLane<2>(Row), B.r[2], Out);
+					Out = MultiplyAdd(SplatLane<3>(Row), B.r[3], Out);
+					Result.r[i] = Out;
+				}
+				return Result;
+			}
+
+			/*
+				Build Scale * Translation * Rotation, the order ieTransform has always composed its local matrix in.
+				Translation is applied before rotation, so the rotation also swings the position about the parent's origin.
+				@param ScaleFactors: XYZ scale. W is ignored.
+				@param Translation: XYZ translation. W must be zero.
+				@param Rotation: Unit quaternion.
+			*/
+			inline Matrix MatrixScaleTranslationRotation(Vector ScaleFactors, Vector Translation, Vector Rotation)
+			{
+				const Matrix RotationMatrix = MatrixRotationQuaternion(Rotation);
+				return Matrix{ {
+					Multiply(SplatLane<0>(ScaleFactors), RotationMatrix.r[0]),
+					Multiply(SplatLane<1>(ScaleFactors), RotationMatrix.r[1]),
+					Multiply(SplatLane<2>(ScaleFactors), RotationMatrix.r[2]),
+					Add(Rotate3(Translation, Rotation), Set(0.0f, 0.0f, 0.0f, 1.0f))
+				} };
+			}
+
+		} // end namespace Simd
+	} // end namespace Math
+} // end namespace Insight
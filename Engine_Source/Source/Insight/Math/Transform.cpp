@@ -1,87 +1,15 @@
 #include <Engine_pch.h>
 
 #include "Transform.h"
-#include "Insight/Core/Application.h"
 
 namespace Insight {
 
-
-
-	ieTransform::ieTransform()
-	{
-	}
-
-	ieTransform::~ieTransform()
-	{
-	}
-
-	ieTransform::ieTransform(const ieTransform& t)
-	{
-		m_Position = t.m_Position;
-		m_Rotation = t.m_Rotation;
-		m_Scale = t.m_Scale;
-	}
-
-	ieTransform::ieTransform(ieTransform&& transform) noexcept
-	{
-		m_LocalMatrix = transform.m_LocalMatrix;
-		m_WorldMatrix = transform.m_WorldMatrix;
-
-		m_TranslationMat = transform.m_TranslationMat;
-		m_RotationMat = transform.m_RotationMat;
-		m_ScaleMat = transform.m_ScaleMat;
-
-		m_Position = transform.m_Position;
-		m_Rotation = transform.m_Rotation;
-		m_Scale = transform.m_Scale;
-
-		m_LocalForward = transform.m_LocalForward;
-		m_LocalBackward = transform.m_LocalBackward;
-		m_LocalLeft = transform.m_LocalLeft;
-		m_LocalRight = transform.m_LocalRight;
-		m_LocalUp = transform.m_LocalUp;
-		m_LocalDown = transform.m_LocalDown;
-	}
-
-	ieTransform& ieTransform::operator=(const ieTransform& transform)
-	{
-		// Vectors
-		m_Position = transform.m_Position;
-		m_Rotation = transform.m_Rotation;
-		m_Scale = transform.m_Scale;
-		m_LocalForward = transform.m_LocalForward;
-		m_LocalBackward = transform.m_LocalBackward;
-		m_LocalLeft = transform.m_LocalLeft;
-		m_LocalRight = transform.m_LocalRight;
-		m_LocalUp = transform.m_LocalUp;
-		m_LocalDown = transform.m_LocalDown;
-
-		// Matricies
-		m_LocalMatrix = transform.m_LocalMatrix;
-		m_WorldMatrix = transform.m_WorldMatrix;
-		m_TranslationMat = transform.m_TranslationMat;
-		m_ScaleMat = transform.m_ScaleMat;
-		m_RotationMat = transform.m_RotationMat;
-
-		return *this;
-	}
-
-	void ieTransform::EditorEndPlay()
-	{
-		m_Position = m_EditorPlayOriginPosition;
-		m_Rotation = m_EditorPlayOriginRotation;
-		m_Scale = m_EditorPlayOriginScale;
-
-		UpdateIfTransformed(true);
-	}
-
 	void ieTransform::Translate(float x, float y, float z)
 	{
-		m_Position.x += x; 
-		m_Position.y += y; 
-		m_Position.z += z; 
-		TranslateLocalMatrix();
-		UpdateLocalMatrix();
+		m_Position.x += x;
+		m_Position.y += y;
+		m_Position.z += z;
+		m_DirtyFlags |= DirtyFlag_Matrix;
 	}
 
 	void ieTransform::Rotate(float XInDegrees, float YInDegrees, float ZInDegrees)
@@ -89,17 +17,15 @@ namespace Insight {
 		m_Rotation.x += DEGREES_TO_RADIANS(XInDegrees);
 		m_Rotation.y += DEGREES_TO_RADIANS(YInDegrees);
 		m_Rotation.z += DEGREES_TO_RADIANS(ZInDegrees);
-		RotateLocalMatrix();
-		UpdateLocalMatrix();
+		m_DirtyFlags |= DirtyFlag_Matrix | DirtyFlag_Rotation;
 	}
 
 	void ieTransform::Scale(float x, float y, float z)
 	{
-		m_Scale.x += x; 
-		m_Scale.y += y; 
+		m_Scale.x += x;
+		m_Scale.y += y;
 		m_Scale.z += z;
-		ScaleLocalMatrix();
-		UpdateLocalMatrix();
+		m_DirtyFlags |= DirtyFlag_Matrix;
 	}
 
 	void ieTransform::LookAt(const ieVector3& target)
@@ -124,92 +50,77 @@ namespace Insight {
 		}
 		if (target.z > 0)
 		{
-			yaw += XM_PI;
+			yaw += PI;
 		}
 
 		SetRotation(ieVector3(pitch, yaw, 0.0f));
 	}
 
-	void ieTransform::SetDirection(const ieVector3& NewDirection)
+	void ieTransform::UpdateLocalMatrix()
 	{
-		XMMATRIX vecRotationMatrix = XMMatrixRotationRollPitchYaw(NewDirection.x, NewDirection.y, NewDirection.z);
-		m_LocalForward = XMVector3TransformCoord(Vector3::Forward, vecRotationMatrix);
-		m_LocalBackward = XMVector3TransformCoord(Vector3::Backward, vecRotationMatrix);
-		m_LocalLeft = XMVector3TransformCoord(Vector3::Left, vecRotationMatrix);
-		m_LocalRight = XMVector3TransformCoord(Vector3::Right, vecRotationMatrix);
-		m_LocalUp = XMVector3TransformCoord(Vector3::Up, vecRotationMatrix);
-		m_LocalDown = XMVector3TransformCoord(Vector3::Down, vecRotationMatrix);
+		if (m_DirtyFlags & DirtyFlag_Rotation)
+		{
+			m_Orientation = BuildOrientation();
+			m_DirtyFlags &= ~DirtyFlag_Rotation;
+		}
+		if (m_DirtyFlags & DirtyFlag_Matrix)
+		{
+			m_LocalMatrix = Simd::MatrixScaleTranslationRotation(Simd::LoadFloat3(&m_Scale.x), Simd::LoadFloat3(&m_Position.x), m_Orientation);
+			m_DirtyFlags &= ~DirtyFlag_Matrix;
+		}
 	}
 
-	void ieTransform::SetLocalMatrix(ieMatrix matrix)
+	Simd::Matrix ieTransform::GetLocalSimdMatrix() const
 	{
-		m_LocalMatrix = matrix;
-	}
+		if (m_DirtyFlags & DirtyFlag_Matrix)
+			return Simd::MatrixScaleTranslationRotation(Simd::LoadFloat3(&m_Scale.x), Simd::LoadFloat3(&m_Position.x), GetOrientation());
 
-	void ieTransform::SetWorldMatrix(ieMatrix matrix)
-	{
-		m_WorldMatrix = matrix;
+		return m_LocalMatrix;
 	}
 
-	void ieTransform::UpdateIfTransformed(bool ForceUpdate)
+	ieMatrix ieTransform::GetLocalMatrix() const
 	{
-		if ((m_Transformed && !Application::Get().IsPlaySessionUnderWay()) || ForceUpdate)
-		{
-			TranslateLocalMatrix();
-			ScaleLocalMatrix();
-			RotateLocalMatrix();
-
-			UpdateLocalMatrix();
-			UpdateEditorOriginPositionRotationScale();
-
-			m_Transformed = false;
-		}
+		return ToPlatformMatrix(GetLocalSimdMatrix());
 	}
 
-	void ieTransform::UpdateLocalMatrix()
+	ieMatrix ieTransform::GetLocalMatrixTransposed() const
 	{
-		m_LocalMatrix = m_ScaleMat * m_TranslationMat * m_RotationMat;
-		UpdateLocalDirectionVectors();
+#if defined (IE_PLATFORM_WINDOWS)
+		return XMMatrixTranspose(GetLocalMatrix());
+#else
+		return ToPlatformMatrix(Simd::MatrixTranspose(GetLocalSimdMatrix()));
+#endif
 	}
 
-	void ieTransform::TranslateLocalMatrix()
+	ieMatrix ieTransform::GetWorldMatrix() const
 	{
-		m_TranslationMat = XMMatrixTranslationFromVector(m_Position);
+		return ToPlatformMatrix(m_WorldMatrix);
 	}
 
-	void ieTransform::ScaleLocalMatrix()
+	void ieTransform::SetWorldMatrix(const ieMatrix& matrix)
 	{
-		XMMATRIX position = m_TranslationMat;
-		// send to origin
-		m_TranslationMat = XMMatrixTranslation(0.0f, 0.0f, 0.0f);
-		// scale
-		m_ScaleMat = XMMatrixScaling(m_Scale.x, m_Scale.y, m_Scale.z);
-		// send back to position
-		m_TranslationMat = position;
-
+		m_WorldMatrix = FromPlatformMatrix(matrix);
 	}
 
-	void ieTransform::RotateLocalMatrix()
+	ieMatrix ieTransform::GetWorldMatrixTransposed() const
 	{
-		m_RotationMat = XMMatrixRotationRollPitchYaw(m_Rotation.x, m_Rotation.y, m_Rotation.z);
+#if defined (IE_PLATFORM_WINDOWS)
+		return XMMatrixTranspose(GetWorldMatrix());
+#else
+		return ToPlatformMatrix(Simd::MatrixTranspose(m_WorldMatrix));
+#endif
 	}
 
-	void ieTransform::UpdateLocalDirectionVectors()
+	Simd::Vector ieTransform::BuildOrientation() const
 	{
-		ieMatrix vecRotationMatrix = XMMatrixRotationRollPitchYaw(m_Rotation.x, m_Rotation.y, m_Rotation.z);
-		m_LocalForward = XMVector3TransformCoord(Vector3::Forward, m_RotationMat);
-		m_LocalBackward = XMVector3TransformCoord(Vector3::Backward, m_RotationMat);
-		m_LocalLeft = XMVector3TransformCoord(Vector3::Left, m_RotationMat);
-		m_LocalRight = XMVector3TransformCoord(Vector3::Right, m_RotationMat);
-		m_LocalUp = XMVector3TransformCoord(Vector3::Up, m_RotationMat);
-		m_LocalDown = XMVector3TransformCoord(Vector3::Down, m_RotationMat);
+		return Simd::QuaternionRollPitchYaw(m_Rotation.x, m_Rotation.y, m_Rotation.z);
 	}
 
-	void ieTransform::UpdateEditorOriginPositionRotationScale()
+	ieVector3 ieTransform::RotateDirection(float x, float y, float z) const
 	{
-		m_EditorPlayOriginPosition = m_Position;
-		m_EditorPlayOriginRotation = m_Rotation;
-		m_EditorPlayOriginScale = m_Scale;
+		ieVector3 Direction;
+		Simd::StoreFloat3(&Direction.x, Simd::Rotate3(Simd::Set(x, y, z, 0.0f), GetOrientation()));
+		return Direction;
 	}
 
 }
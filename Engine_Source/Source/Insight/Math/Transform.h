@@ -3,24 +3,33 @@
 #include <Insight/Core.h>
 #include "Insight/Math/ie_Vectors.h"
 #include "Insight/Math/ie_Matricies.h"
+#include "Insight/Math/Simd_Math.h"
 
 namespace Insight {
 
+#if defined (IE_PLATFORM_WINDOWS)
 	using namespace DirectX;
+#endif
 	using namespace Math;
 
+	/*
+		Position, rotation and scale of an object.
+
+		The rotation is kept as the Euler angles it was set with (radians) and as a quaternion
+		built from them. Changes only flag the cached local matrix and quaternion as dirty, the
+		owner rebuilds them with UpdateLocalMatrix once it is done changing the transform, so any
+		number of Set/Translate/Rotate calls in a frame cost one rebuild. Const getters never
+		write to the cache, so the render thread and worker ticks can read the same transform at
+		once. Reading a dirty transform through them builds the result without storing it.
+		Direction vectors are derived from the quaternion when requested rather than stored.
+	*/
 	class INSIGHT_API ieTransform
 	{
 	public:
-		ieTransform();
-		~ieTransform();
-		ieTransform(const ieTransform& transform);
-		ieTransform(ieTransform&& transform) noexcept;
-
-		ieTransform& operator = (const ieTransform& transform);
-
-		void EditorEndPlay();
-		void EditorInit() { UpdateEditorOriginPositionRotationScale(); }
+		ieTransform() = default;
+		~ieTransform() = default;
+		ieTransform(const ieTransform& transform) = default;
+		ieTransform& operator = (const ieTransform& transform) = default;
 
 		inline ieFloat3 GetPositionFloat3() const { return ieFloat3(m_Position.x, m_Position.y, m_Position.z); }
 		inline ieFloat3 GetRotationFloat3() const { return ieFloat3(m_Rotation.x, m_Rotation.y, m_Rotation.z); }
@@ -30,24 +39,29 @@ namespace Insight {
 		inline const ieVector3& GetRotation()	const { return m_Rotation; }
 		inline const ieVector3& GetScale()		const { return m_Scale; }
 
-		inline ieVector3& GetPositionRef()	{ m_Transformed = true; return m_Position; }
-		inline ieVector3& GetRotationRef()	{ m_Transformed = true; return m_Rotation; }
-		inline ieVector3& GetScaleRef()		{ m_Transformed = true; return m_Scale; }
+		// Writable references for editor widgets. The transform is marked dirty as soon as one is taken.
+		inline ieVector3& GetPositionRef()	{ m_DirtyFlags |= DirtyFlag_Matrix; return m_Position; }
+		inline ieVector3& GetRotationRef()	{ m_DirtyFlags |= DirtyFlag_Matrix | DirtyFlag_Rotation; return m_Rotation; }
+		inline ieVector3& GetScaleRef()		{ m_DirtyFlags |= DirtyFlag_Matrix; return m_Scale; }
+
+		inline void SetPosition(float x, float y, float z)	{ m_Position.x = x; m_Position.y = y; m_Position.z = z; m_DirtyFlags |= DirtyFlag_Matrix; }
+		inline void SetRotation(float XInDegrees, float YInDegrees, float ZInDegrees)	{ m_Rotation.x = (XInDegrees); m_Rotation.y = (YInDegrees); m_Rotation.z = (ZInDegrees); m_DirtyFlags |= DirtyFlag_Matrix | DirtyFlag_Rotation; }
+		inline void SetScale(float x, float y, float z)		{ m_Scale.x = x; m_Scale.y = y; m_Scale.z = z; m_DirtyFlags |= DirtyFlag_Matrix; }
 
-		inline void SetPosition(float x, float y, float z)	{ m_Position.x = x; m_Position.y = y; m_Position.z = z; TranslateLocalMatrix(); UpdateLocalMatrix(); }
-		inline void SetRotation(float XInDegrees, float YInDegrees, float ZInDegrees)	{ m_Rotation.x = (XInDegrees); m_Rotation.y = (YInDegrees); m_Rotation.z = (ZInDegrees); RotateLocalMatrix(); UpdateLocalMatrix(); }
-		inline void SetScale(float x, float y, float z)		{ m_Scale.x = x; m_Scale.y = y; m_Scale.z = z; ScaleLocalMatrix(); UpdateLocalMatrix(); }
+		inline void SetPosition(const ieVector3& vector)	{ m_Position = vector; m_DirtyFlags |= DirtyFlag_Matrix; }
+		inline void SetRotation(const ieVector3& vector)	{ m_Rotation = vector; m_DirtyFlags |= DirtyFlag_Matrix | DirtyFlag_Rotation; }
+		inline void SetScale(const ieVector3& vector)		{ m_Scale = vector; m_DirtyFlags |= DirtyFlag_Matrix; }
 
-		inline void SetPosition(const ieVector3& vector)	{ m_Position = vector; TranslateLocalMatrix(); UpdateLocalMatrix(); }
-		inline void SetRotation(const ieVector3& vector)	{ m_Rotation = vector; RotateLocalMatrix(); UpdateLocalMatrix(); }
-		inline void SetScale(const ieVector3& vector)		{ m_Scale = vector; ScaleLocalMatrix(); UpdateLocalMatrix(); }
+		// Local direction vectors, derived from the rotation on request.
+		ieVector3 GetLocalForward()		const { return RotateDirection(0.0f, 0.0f, 1.0f); }
+		ieVector3 GetLocalBackward()	const { return RotateDirection(0.0f, 0.0f, -1.0f); }
+		ieVector3 GetLocalLeft()		const { return RotateDirection(-1.0f, 0.0f, 0.0f); }
+		ieVector3 GetLocalRight()		const { return RotateDirection(1.0f, 0.0f, 0.0f); }
+		ieVector3 GetLocalUp()			const { return RotateDirection(0.0f, 1.0f, 0.0f); }
+		ieVector3 GetLocalDown()		const { return RotateDirection(0.0f, -1.0f, 0.0f); }
 
-		inline const ieVector3& GetLocalForward()	const { return m_LocalForward; }
-		inline const ieVector3& GetLocalBackward()	const { return m_LocalBackward; }
-		inline const ieVector3& GetLocalLeft()		const { return m_LocalLeft; }
-		inline const ieVector3& GetLocalRight()		const { return m_LocalRight; }
-		inline const ieVector3& GetLocalUp()		const { return m_LocalUp; }
-		inline const ieVector3& GetLocalDown()		const { return m_LocalDown; }
+		// Returns the rotation as a unit quaternion.
+		inline Simd::Vector GetOrientation() const { return (m_DirtyFlags & DirtyFlag_Rotation) ? BuildOrientation() : m_Orientation; }
 
 		void Translate(float x, float y, float z);
 		void Rotate(float XInDegrees, float YInDegrees, float ZInDegrees);
@@ -55,77 +69,46 @@ namespace Insight {
 
 		// Have object look at a point in space
 		void LookAt(const ieVector3& LookAtPos);
-		void SetDirection(const ieVector3& NewDirection);
 
+		// Rebuild the cached local matrix and quaternion if the transform changed. Called by the owner of the transform on the thread that changes it.
+		void UpdateLocalMatrix();
+		// Returns the objects local matrix. Built on the fly if the transform changed since the last UpdateLocalMatrix.
+		Simd::Matrix GetLocalSimdMatrix() const;
 		// Returns objects local matrix
-		ieMatrix GetLocalMatrix() { UpdateIfTransformed(); return m_LocalMatrix; }
-		// Returns a reference to the objects local matrix
-		ieMatrix& GetLocalMatrixRef() { UpdateIfTransformed(); return m_LocalMatrix; }
-		// Set the objects local matrix
-		void SetLocalMatrix(ieMatrix matrix);
-		ieMatrix GetLocalMatrixTransposed() const { return XMMatrixTranspose(m_LocalMatrix); }
+		ieMatrix GetLocalMatrix() const;
+		ieMatrix GetLocalMatrixTransposed() const;
 
 		// Returns the objects world space matrix
-		ieMatrix GetWorldMatrix() { UpdateIfTransformed(); return m_WorldMatrix; }
-		// Returns a reference to the objects world space matrix
-		ieMatrix& GetWorldMatrixRef() { return m_WorldMatrix; }
+		ieMatrix GetWorldMatrix() const;
+		inline const Simd::Matrix& GetWorldSimdMatrix() const { return m_WorldMatrix; }
 		// Set the objects world matrix
-		void SetWorldMatrix(ieMatrix matrix);
-		ieMatrix GetWorldMatrixTransposed() const { return XMMatrixTranspose(m_WorldMatrix); }
-
-		ieMatrix& GetTranslationMatrixRef() { return m_TranslationMat; }
-		ieMatrix GetTranslationMatrix() { return m_TranslationMat; }
-		void SetTranslationMatrix(ieMatrix matrix) { m_TranslationMat = matrix; UpdateLocalMatrix(); }
+		void SetWorldMatrix(const ieMatrix& matrix);
+		inline void SetWorldSimdMatrix(const Simd::Matrix& matrix) { m_WorldMatrix = matrix; }
+		ieMatrix GetWorldMatrixTransposed() const;
 
-		ieMatrix& GetRotationMatrixRef() { return m_RotationMat; }
-		ieMatrix GetRotationMatrix() { return m_RotationMat; }
-		void SetRotationMatrix(ieMatrix matrix) { m_RotationMat = matrix; UpdateLocalMatrix(); }
+		// True if the transform has changed since the last UpdateLocalMatrix.
+		inline bool IsDirty() const { return m_DirtyFlags != 0; }
 
-		ieMatrix& GetScaleMatrixRef() { return m_ScaleMat; }
-		ieMatrix GetScaleMatrix() { return m_ScaleMat; }
-		void SetScaleMatrix(ieMatrix matrix) { m_ScaleMat = matrix; UpdateLocalMatrix(); }
-
-
-		// Update the objects local directional vectors.
-		// DO NOT CALL UNLESS YOU KNOW WHAT YOU'RE DOING
-		void UpdateLocalDirectionVectors();
-
-		void UpdateEditorOriginPositionRotationScale();
 	protected:
+		enum DirtyFlags : uint8_t
+		{
+			DirtyFlag_Matrix = BIT_SHIFT(0),
+			DirtyFlag_Rotation = BIT_SHIFT(1),
+		};
 
-		bool m_Transformed = false;
+		Simd::Vector BuildOrientation() const;
+		ieVector3 RotateDirection(float x, float y, float z) const;
 
-		void UpdateIfTransformed(bool ForceUpdate = false);
-		
-
-		void UpdateLocalMatrix();
+		// Built by UpdateLocalMatrix from the values below.
+		Simd::Matrix m_LocalMatrix = Simd::MatrixIdentity();
+		Simd::Matrix m_WorldMatrix = Simd::MatrixIdentity();
+		Simd::Vector m_Orientation = Simd::Set(0.0f, 0.0f, 0.0f, 1.0f);
 
-		void TranslateLocalMatrix();
-		void ScaleLocalMatrix();
-		void RotateLocalMatrix();
-
-		XMMATRIX m_LocalMatrix = XMMatrixIdentity();
-		XMMATRIX m_WorldMatrix = XMMatrixIdentity();
-
-		XMMATRIX m_TranslationMat = XMMatrixIdentity();
-		XMMATRIX m_RotationMat = XMMatrixIdentity();
-		XMMATRIX m_ScaleMat = XMMatrixIdentity();
-
-		ieVector3 m_Position = m_Position.Zero;
-		ieVector3 m_Rotation = m_Rotation.Zero;
-		ieVector3 m_Scale = m_Scale.One;
-		
-		ieVector3 m_EditorPlayOriginPosition = m_Position;
-		ieVector3 m_EditorPlayOriginRotation = m_Rotation;
-		ieVector3 m_EditorPlayOriginScale = m_Scale;
-		
-		ieVector3 m_LocalForward = m_LocalForward.Forward;
-		ieVector3 m_LocalBackward = m_LocalBackward.Backward;
-		ieVector3 m_LocalLeft = m_LocalLeft.Left;
-		ieVector3 m_LocalRight = m_LocalRight.Right;
-		ieVector3 m_LocalUp = m_LocalUp.Up;
-		ieVector3 m_LocalDown = m_LocalDown.Down;
+		ieVector3 m_Position = Vector3::Zero;
+		ieVector3 m_Rotation = Vector3::Zero;
+		ieVector3 m_Scale = Vector3::One;
 
+		uint8_t m_DirtyFlags = 0u;
 	};
 
 }
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <Insight/Core.h>
+#include "Insight/Math/Simd_Math.h"
+#if defined (IE_PLATFORM_WINDOWS)
 #include <DirectXMath.h>
+#endif
 
 namespace Insight {
 
@@ -34,7 +37,36 @@ namespace Insight {
 		using ieMatrix2x2 = glm::mat2x2;
 		using ieMatrix3x3 = glm::mat3x3;
 		using ieMatrix4x4 = glm::mat4x4;
+#else
+		using ieMatrix = Simd::Matrix;
+		using ieMatrix4x4 = Simd::Matrix;
+#endif
+
+		// Conversion between the engine's SIMD matrix and the platform matrix type.
+		// Both hold four row vectors in the same register type unless the scalar SIMD backend is in use.
+		inline ieMatrix ToPlatformMatrix(const Simd::Matrix& Source)
+		{
+#if defined (IE_PLATFORM_WINDOWS) && defined (IE_SIMD_SCALAR)
+			return DirectX::XMLoadFloat4x4(reinterpret_cast<const DirectX::XMFLOAT4X4*>(&Source));
+#elif defined (IE_PLATFORM_WINDOWS)
+			return DirectX::XMMATRIX(Source.r[0], Source.r[1], Source.r[2], Source.r[3]);
+#else
+			return Source;
+#endif
+		}
+
+		inline Simd::Matrix FromPlatformMatrix(const ieMatrix& Source)
+		{
+#if defined (IE_PLATFORM_WINDOWS) && defined (IE_SIMD_SCALAR)
+			Simd::Matrix Result;
+			DirectX::XMStoreFloat4x4(reinterpret_cast<DirectX::XMFLOAT4X4*>(&Result), Source);
+			return Result;
+#elif defined (IE_PLATFORM_WINDOWS)
+			return Simd::Matrix{ { Source.r[0], Source.r[1], Source.r[2], Source.r[3] } };
+#else
+			return Source;
 #endif
+		}
 
 	}
 
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <Insight/Core.h>
+#if defined (IE_PLATFORM_WINDOWS)
 #include <DirectX12/TK/Inc/SimpleMath.h>
+#endif
 
 namespace Insight {
 
@@ -107,6 +109,11 @@ namespace Insight {
 		using ieVector2 = glm::vec2;
 		using ieVector3 = glm::vec3;
 		using ieVector4 = glm::vec4;
+#else
+		// Tools and benchmarks built without a platform math library only need storage.
+		using ieVector2 = ieFloat2;
+		using ieVector3 = ieFloat3;
+		using ieVector4 = ieFloat4;
 #endif // IE_PLATFORM_BUILD_WIN32
 
 
@@ -0,0 +1,74 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Arena_Allocator.h
+
+	Purpose:
+	STL compatible allocators backed by the frame arenas and scratch stacks.
+
+	Description:
+	Lets standard containers draw their memory from an arena so building a temporary list
+	does not touch the general heap. Deallocation does nothing, the memory is released when
+	the arena resets or the scratch scope closes. Reserve up front where possible, a growing
+	container leaves its old buffers behind in the arena until then.
+
+	A container using these allocators must not outlive its arena's frame or scratch scope.
+
+	Example Usage:
+	Memory::ScratchScope Scratch;
+	Memory::ScratchVector<uint32_t> Indices{ Memory::ScratchAllocator<uint32_t>(Scratch.GetStack()) };
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+#include "Insight/Memory/Frame_Arena.h"
+#include "Insight/Memory/Scratch_Allocator.h"
+
+#include <vector>
+
+namespace Insight {
+
+	namespace Memory {
+
+		// ArenaType must provide void* Allocate(size_t Size, size_t Alignment).
+		template <typename T, typename ArenaType>
+		class ArenaAllocator
+		{
+		public:
+			using value_type = T;
+
+			template <typename U>
+			struct rebind { using other = ArenaAllocator<U, ArenaType>; };
+
+			explicit ArenaAllocator(ArenaType& Arena) noexcept
+				: m_pArena(&Arena) {}
+			template <typename U>
+			ArenaAllocator(const ArenaAllocator<U, ArenaType>& Other) noexcept
+				: m_pArena(Other.GetArena()) {}
+
+			inline T* allocate(size_t Count) { return static_cast<T*>(m_pArena->Allocate(sizeof(T) * Count, alignof(T))); }
+			inline void deallocate(T* pMemory, size_t Count) noexcept {}
+
+			inline ArenaType* GetArena() const { return m_pArena; }
+
+		private:
+			ArenaType* m_pArena;
+		};
+
+		template <typename T, typename U, typename ArenaType>
+		inline bool operator == (const ArenaAllocator<T, ArenaType>& Lhs, const ArenaAllocator<U, ArenaType>& Rhs) { return Lhs.GetArena() == Rhs.GetArena(); }
+		template <typename T, typename U, typename ArenaType>
+		inline bool operator != (const ArenaAllocator<T, ArenaType>& Lhs, const ArenaAllocator<U, ArenaType>& Rhs) { return Lhs.GetArena() != Rhs.GetArena(); }
+
+		template <typename T>
+		using FrameAllocator = ArenaAllocator<T, FrameArena>;
+		template <typename T>
+		using ScratchAllocator = ArenaAllocator<T, ScratchStack>;
+
+		template <typename T>
+		using FrameVector = std::vector<T, FrameAllocator<T>>;
+		template <typename T>
+		using ScratchVector = std::vector<T, ScratchAllocator<T>>;
+
+	} // end namespace Memory
+} // end namespace Insight
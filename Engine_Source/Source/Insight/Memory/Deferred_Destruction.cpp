@@ -0,0 +1,42 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Deferred_Destruction.h"
+
+namespace Insight {
+
+	namespace Memory {
+
+		DeferredDestructionQueue DeferredDestructionQueue::s_Instance;
+
+		DeferredDestructionQueue::~DeferredDestructionQueue()
+		{
+			Flush();
+		}
+
+		void DeferredDestructionQueue::Enqueue(void* pObject, DeleterFn Deleter)
+		{
+			std::lock_guard<std::mutex> Lock(m_Mutex);
+			m_Pending.push_back({ pObject, Deleter });
+		}
+
+		void DeferredDestructionQueue::Flush()
+		{
+			for (;;)
+			{
+				{
+					std::lock_guard<std::mutex> Lock(m_Mutex);
+					if (m_Pending.empty())
+						return;
+					m_Deleting.swap(m_Pending);
+				}
+
+				// Delete in the order the objects were queued.
+				for (const PendingObject& Pending : m_Deleting)
+					Pending.Deleter(Pending.pObject);
+				m_Deleting.clear();
+			}
+		}
+
+	} // end namespace Memory
+} // end namespace Insight
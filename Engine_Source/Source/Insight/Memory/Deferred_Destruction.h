@@ -0,0 +1,73 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Deferred_Destruction.h
+	Source - Deferred_Destruction.cpp
+
+	Purpose:
+	Delays deleting objects until a point in the frame where nothing can still be using them.
+
+	Description:
+	Actors and components are often removed while the scene is being walked (Ex. an actor
+	deleting itself from its own details panel or a script despawning another actor mid tick).
+	Instead of deleting in place they are queued here and deleted by the end of frame sweep in
+	Application, after the game thread has finished with the frame. Objects queued while the
+	sweep is running (Ex. a destructor releasing its children) are deleted in the same sweep.
+
+	Example Usage:
+	pActor->Destroy();
+	Memory::DeferredDelete(pActor);
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+#include <mutex>
+#include <vector>
+
+namespace Insight {
+
+	namespace Memory {
+
+		class INSIGHT_API DeferredDestructionQueue
+		{
+		public:
+			typedef void(*DeleterFn)(void*);
+
+		public:
+			DeferredDestructionQueue() = default;
+			~DeferredDestructionQueue();
+
+			static DeferredDestructionQueue& Get() { return s_Instance; }
+
+			// Queue an object to be deleted at the end of the frame. Thread safe.
+			void Enqueue(void* pObject, DeleterFn Deleter);
+			// Delete everything that has been queued. Call once per frame from the game thread.
+			void Flush();
+
+			inline uint32_t GetNumPending() { std::lock_guard<std::mutex> Lock(m_Mutex); return static_cast<uint32_t>(m_Pending.size()); }
+
+		private:
+			struct PendingObject
+			{
+				void* pObject;
+				DeleterFn Deleter;
+			};
+
+			std::mutex m_Mutex;
+			std::vector<PendingObject> m_Pending;
+			// Flush swaps the pending list in here so deleters can queue more objects while it runs.
+			std::vector<PendingObject> m_Deleting;
+
+			static DeferredDestructionQueue s_Instance;
+		};
+
+		// Delete an object at the end of the frame.
+		template <typename T>
+		inline void DeferredDelete(T* pObject)
+		{
+			if (pObject)
+				DeferredDestructionQueue::Get().Enqueue(pObject, [](void* pTarget) { delete static_cast<T*>(pTarget); });
+		}
+
+	} // end namespace Memory
+} // end namespace Insight
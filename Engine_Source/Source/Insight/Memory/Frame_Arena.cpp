@@ -0,0 +1,38 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Frame_Arena.h"
+
+namespace Insight {
+
+	namespace Memory {
+
+		static constexpr size_t s_GameFrameArenaSize = 2u * 1024u * 1024u;
+		static constexpr size_t s_RenderFrameArenaSize = 2u * 1024u * 1024u;
+
+		FrameArena::FrameArena(size_t CapacityPerFrame, const char* DebugName)
+			: m_Buffers{ { CapacityPerFrame, DebugName }, { CapacityPerFrame, DebugName } }
+		{
+		}
+
+		void FrameArena::BeginFrame()
+		{
+			m_CurrentBuffer = (m_CurrentBuffer + 1u) % NumBuffers;
+			m_Buffers[m_CurrentBuffer].Reset();
+			m_FrameIndex++;
+		}
+
+		FrameArena& GetGameFrameArena()
+		{
+			static FrameArena s_GameFrameArena(s_GameFrameArenaSize, "Game Frame");
+			return s_GameFrameArena;
+		}
+
+		FrameArena& GetRenderFrameArena()
+		{
+			static FrameArena s_RenderFrameArena(s_RenderFrameArenaSize, "Render Frame");
+			return s_RenderFrameArena;
+		}
+
+	} // end namespace Memory
+} // end namespace Insight
@@ -0,0 +1,85 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Frame_Arena.h
+	Source - Frame_Arena.cpp
+
+	Purpose:
+	Double buffered linear arena for memory that only lives for a frame.
+
+	Description:
+	Holds two LinearArenas and switches between them every frame. BeginFrame resets the
+	arena that was used two frames ago, so anything allocated during a frame stays valid
+	until the end of the following frame. That is long enough to hand per-frame data from
+	one stage of the frame to the next without copying it.
+
+	The engine owns two frame arenas, one for each of the main threads. The game frame arena
+	is reset in Application::BeginFrame and the render frame arena at the start of every
+	render thread frame. Only use an arena from the thread that resets it.
+
+	Example Usage:
+	Memory::FrameVector<Mesh*> Visible{ Memory::FrameAllocator<Mesh*>(Memory::GetRenderFrameArena()) };
+	Matrix* pMatrices = Memory::GetGameFrameArena().AllocateArray<Matrix>(NumActors);
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+#include "Insight/Memory/Linear_Arena.h"
+
+namespace Insight {
+
+	namespace Memory {
+
+		class INSIGHT_API FrameArena
+		{
+		public:
+			static constexpr uint32_t NumBuffers = 2u;
+
+			/*
+				@param CapacityPerFrame: Size of each of the two buffers in bytes.
+				@param DebugName: Name used when reporting overflows. Must outlive the arena.
+			*/
+			FrameArena(size_t CapacityPerFrame, const char* DebugName);
+			~FrameArena() = default;
+
+			FrameArena(const FrameArena&) = delete;
+			FrameArena& operator = (const FrameArena&) = delete;
+
+			// Switch to the next buffer and release everything allocated in it two frames ago.
+			void BeginFrame();
+
+			// Allocate uninitialized memory that lives until the end of the next frame.
+			inline void* Allocate(size_t Size, size_t Alignment = DefaultAlignment) { return m_Buffers[m_CurrentBuffer].Allocate(Size, Alignment); }
+
+			// Allocate an uninitialized array. T must be trivially destructible, destructors are never called.
+			template <typename T>
+			inline T* AllocateArray(size_t Count)
+			{
+				static_assert(std::is_trivially_destructible<T>::value, "Frame arena memory is never destructed.");
+				return static_cast<T*>(Allocate(sizeof(T) * Count, alignof(T)));
+			}
+
+			// Construct an object in the arena. T must be trivially destructible, destructors are never called.
+			template <typename T, typename ... Args>
+			inline T* New(Args&& ... ConstructionArgs)
+			{
+				static_assert(std::is_trivially_destructible<T>::value, "Frame arena memory is never destructed.");
+				return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(ConstructionArgs)...);
+			}
+
+			inline uint64_t GetFrameIndex() const { return m_FrameIndex; }
+			inline const LinearArena& GetCurrentBuffer() const { return m_Buffers[m_CurrentBuffer]; }
+
+		private:
+			LinearArena m_Buffers[NumBuffers];
+			uint32_t m_CurrentBuffer = 0u;
+			uint64_t m_FrameIndex = 0u;
+		};
+
+		// Frame arena owned by the game thread. Reset in Application::BeginFrame.
+		INSIGHT_API FrameArena& GetGameFrameArena();
+		// Frame arena owned by the render thread. Reset at the start of each render frame.
+		INSIGHT_API FrameArena& GetRenderFrameArena();
+
+	} // end namespace Memory
+} // end namespace Insight
@@ -0,0 +1,77 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Linear_Arena.h"
+
+namespace Insight {
+
+	namespace Memory {
+
+		// Every block starts on a cache line so allocations from different threads share as few lines as possible.
+		static constexpr size_t s_BlockAlignment = 64u;
+
+		LinearArena::LinearArena(size_t Capacity, const char* DebugName)
+			: m_pBase(static_cast<uint8_t*>(::operator new(Capacity, std::align_val_t(s_BlockAlignment))))
+			, m_Capacity(Capacity)
+			, m_DebugName(DebugName)
+		{
+		}
+
+		LinearArena::~LinearArena()
+		{
+			Reset();
+			::operator delete(m_pBase, std::align_val_t(s_BlockAlignment));
+		}
+
+		void* LinearArena::Allocate(size_t Size, size_t Alignment)
+		{
+			IE_ASSERT((Alignment & (Alignment - 1)) == 0, "Arena alignment must be a power of two.");
+
+			const uintptr_t Base = reinterpret_cast<uintptr_t>(m_pBase);
+			size_t Offset = m_Offset.load(std::memory_order_relaxed);
+			for (;;)
+			{
+				const size_t AlignedOffset = AlignUp(Base + Offset, Alignment) - Base;
+				const size_t NewOffset = AlignedOffset + Size;
+				if (NewOffset > m_Capacity)
+					return AllocateOverflow(Size, Alignment);
+
+				if (m_Offset.compare_exchange_weak(Offset, NewOffset, std::memory_order_relaxed))
+					return m_pBase + AlignedOffset;
+			}
+		}
+
+		void LinearArena::Reset()
+		{
+			const size_t Used = m_Offset.exchange(0u, std::memory_order_relaxed);
+			if (Used > m_PeakUsed)
+				m_PeakUsed = Used;
+
+			std::lock_guard<std::mutex> Lock(m_OverflowMutex);
+			if (m_OverflowBlocks.empty())
+				return;
+
+			IE_DEBUG_LOG(LogSeverity::Warning, "Linear arena \"{0}\" ran out of space ({1} bytes). {2} allocations ({3} bytes) fell back to the heap.",
+				m_DebugName, m_Capacity, m_OverflowBlocks.size(), m_OverflowBytes);
+
+			for (const OverflowBlock& Block : m_OverflowBlocks)
+				::operator delete(Block.pMemory, std::align_val_t(Block.Alignment));
+			m_OverflowBlocks.clear();
+			m_OverflowBytes = 0u;
+		}
+
+		void* LinearArena::AllocateOverflow(size_t Size, size_t Alignment)
+		{
+			if (Alignment < DefaultAlignment)
+				Alignment = DefaultAlignment;
+
+			void* pMemory = ::operator new(Size, std::align_val_t(Alignment));
+
+			std::lock_guard<std::mutex> Lock(m_OverflowMutex);
+			m_OverflowBlocks.push_back({ pMemory, Alignment });
+			m_OverflowBytes += Size;
+			return pMemory;
+		}
+
+	} // end namespace Memory
+} // end namespace Insight
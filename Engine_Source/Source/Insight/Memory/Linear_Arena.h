@@ -0,0 +1,85 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Linear_Arena.h
+	Source - Linear_Arena.cpp
+
+	Purpose:
+	Fixed size bump allocator that is released all at once.
+
+	Description:
+	Allocating is a single atomic add on an offset into one pre-allocated block, so any
+	thread may allocate from the arena at the same time. Nothing is freed individually;
+	Reset makes the whole block available again. If the block runs out the arena falls back
+	to the general heap so callers never receive null, those allocations are freed on the
+	next Reset and reported so the capacity can be tuned.
+
+	Objects placed in an arena never have their destructors called.
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <cstddef>
+
+namespace Insight {
+
+	namespace Memory {
+
+		constexpr size_t DefaultAlignment = alignof(std::max_align_t);
+
+		// Round Value up to the next multiple of Alignment. Alignment must be a power of two.
+		inline size_t AlignUp(size_t Value, size_t Alignment) { return (Value + Alignment - 1) & ~(Alignment - 1); }
+
+		class INSIGHT_API LinearArena
+		{
+		public:
+			/*
+				@param Capacity: Size of the arena's block in bytes.
+				@param DebugName: Name used when reporting overflows. Must outlive the arena.
+			*/
+			LinearArena(size_t Capacity, const char* DebugName);
+			~LinearArena();
+
+			LinearArena(const LinearArena&) = delete;
+			LinearArena& operator = (const LinearArena&) = delete;
+
+			// Allocate uninitialized memory. Thread safe.
+			void* Allocate(size_t Size, size_t Alignment = DefaultAlignment);
+			// Release every allocation. Must not overlap with calls to Allocate.
+			void Reset();
+
+			// Returns true if the pointer was allocated from the arena's block.
+			inline bool Owns(const void* pMemory) const { return pMemory >= m_pBase && pMemory < m_pBase + m_Capacity; }
+
+			inline size_t GetCapacity() const { return m_Capacity; }
+			inline size_t GetUsed() const { return m_Offset.load(std::memory_order_relaxed); }
+			// The most bytes used between two resets since the arena was created.
+			inline size_t GetPeakUsed() const { return m_PeakUsed; }
+			inline const char* GetDebugName() const { return m_DebugName; }
+
+		private:
+			void* AllocateOverflow(size_t Size, size_t Alignment);
+
+		private:
+			uint8_t* m_pBase = nullptr;
+			size_t m_Capacity = 0u;
+			alignas(64) std::atomic<size_t> m_Offset = 0u;
+			size_t m_PeakUsed = 0u;
+			const char* m_DebugName;
+
+			// Heap fallback once the block is exhausted.
+			struct OverflowBlock
+			{
+				void* pMemory;
+				size_t Alignment;
+			};
+			std::mutex m_OverflowMutex;
+			std::vector<OverflowBlock> m_OverflowBlocks;
+			size_t m_OverflowBytes = 0u;
+		};
+
+	} // end namespace Memory
+} // end namespace Insight
@@ -0,0 +1,433 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Memory_Tracker.h"
+
+#include <new>
+#include <atomic>
+#include <mutex>
+#include <cstdlib>
+
+namespace Insight {
+
+	namespace Memory {
+
+		// Running counters for one tag.
+		struct TagCounters
+		{
+			std::atomic<int64_t> LiveBytes{ 0 };
+			std::atomic<int64_t> LiveAllocations{ 0 };
+			std::atomic<uint64_t> TotalAllocations{ 0 };
+			std::atomic<uint64_t> TotalBytes{ 0 };
+			std::atomic<uint64_t> TotalFrees{ 0 };
+		};
+
+		// Counters of every tag, owned by one thread at a time. Each block gets its own cache lines so
+		// threads never share one while allocating. Readers sum the blocks of every thread.
+		struct alignas(64) ThreadCounters
+		{
+			TagCounters Tags[NumMemoryTags];
+			std::atomic<bool> IsInUse{ false };
+		};
+
+		// Totals at the start of the current frame, used to work out the per frame numbers.
+		struct FrameBaseline
+		{
+			uint64_t TotalAllocations;
+			uint64_t TotalBytes;
+			uint64_t TotalFrees;
+		};
+
+		// Threads beyond this share s_SharedCounters.
+		static constexpr uint32_t s_MaxTrackedThreads = 128u;
+
+		// Constant initialized so allocations made before any static constructor runs are still counted.
+		static ThreadCounters s_ThreadCounters[s_MaxTrackedThreads];
+		// Used by threads that did not get a block of their own, and by threads that are exiting.
+		static ThreadCounters s_SharedCounters;
+		static thread_local MemoryTag s_ThreadTag = MemoryTag::Untagged;
+		static thread_local ThreadCounters* s_pThreadCounters = nullptr;
+
+		// Peaks are taken from the summed live bytes whenever the stats are read.
+		static std::atomic<int64_t> s_PeakBytes[NumMemoryTags];
+		static std::atomic<int64_t> s_FramePeakBytes[NumMemoryTags];
+
+		static std::mutex s_FrameMutex;
+		static FrameBaseline s_FrameBaselines[NumMemoryTags];
+		static MemoryTagStats s_FrameStats[NumMemoryTags];
+		static FILE* s_pCsvFile = nullptr;
+
+		uint64_t MemoryTracker::s_FrameIndex = 0u;
+
+		// Hands the calling thread's block back to the pool when the thread exits. Counts stay in the
+		// block, the next thread to take it keeps adding to them.
+		struct ThreadCountersLease
+		{
+			ThreadCounters* pCounters = nullptr;
+
+			~ThreadCountersLease()
+			{
+				if (!pCounters)
+					return;
+				// Allocations made by the rest of the thread's shutdown go to the shared block.
+				s_pThreadCounters = &s_SharedCounters;
+				pCounters->IsInUse.store(false, std::memory_order_release);
+			}
+		};
+		static thread_local ThreadCountersLease s_ThreadCountersLease;
+
+		static ThreadCounters& GetThreadCounters()
+		{
+			if (s_pThreadCounters)
+				return *s_pThreadCounters;
+
+			s_pThreadCounters = &s_SharedCounters;
+			for (ThreadCounters& Counters : s_ThreadCounters)
+			{
+				bool IsInUse = false;
+				if (Counters.IsInUse.compare_exchange_strong(IsInUse, true, std::memory_order_acquire))
+				{
+					s_pThreadCounters = &Counters;
+					s_ThreadCountersLease.pCounters = &Counters;
+					break;
+				}
+			}
+			return *s_pThreadCounters;
+		}
+
+		template <typename T>
+		static inline void AddCounter(std::atomic<T>& Counter, T Value, bool IsShared)
+		{
+			// An owned block has a single writer, so it does not need a locked read-modify-write.
+			if (IsShared)
+				Counter.fetch_add(Value, std::memory_order_relaxed);
+			else
+				Counter.store(Counter.load(std::memory_order_relaxed) + Value, std::memory_order_relaxed);
+		}
+
+		static inline void UpdateMax(std::atomic<int64_t>& Max, int64_t Value)
+		{
+			int64_t Current = Max.load(std::memory_order_relaxed);
+			while (Value > Current && !Max.compare_exchange_weak(Current, Value, std::memory_order_relaxed)) {}
+		}
+
+		// Sum of every thread's counters for a tag.
+		struct TagTotals
+		{
+			int64_t LiveBytes = 0;
+			int64_t LiveAllocations = 0;
+			uint64_t TotalAllocations = 0u;
+			uint64_t TotalBytes = 0u;
+			uint64_t TotalFrees = 0u;
+		};
+
+		static void AccumulateTag(const TagCounters& Counters, TagTotals& OutTotals)
+		{
+			OutTotals.LiveBytes += Counters.LiveBytes.load(std::memory_order_relaxed);
+			OutTotals.LiveAllocations += Counters.LiveAllocations.load(std::memory_order_relaxed);
+			OutTotals.TotalAllocations += Counters.TotalAllocations.load(std::memory_order_relaxed);
+			OutTotals.TotalBytes += Counters.TotalBytes.load(std::memory_order_relaxed);
+			OutTotals.TotalFrees += Counters.TotalFrees.load(std::memory_order_relaxed);
+		}
+
+		static TagTotals SumTag(uint32_t TagIndex)
+		{
+			TagTotals Totals;
+			for (const ThreadCounters& Counters : s_ThreadCounters)
+				AccumulateTag(Counters.Tags[TagIndex], Totals);
+			AccumulateTag(s_SharedCounters.Tags[TagIndex], Totals);
+
+			UpdateMax(s_PeakBytes[TagIndex], Totals.LiveBytes);
+			UpdateMax(s_FramePeakBytes[TagIndex], Totals.LiveBytes);
+			return Totals;
+		}
+
+		const char* GetMemoryTagName(MemoryTag Tag)
+		{
+			switch (Tag)
+			{
+			case MemoryTag::Untagged:	return "Untagged";
+			case MemoryTag::Rendering:	return "Rendering";
+			case MemoryTag::Scene:		return "Scene";
+			case MemoryTag::Assets:		return "Assets";
+			case MemoryTag::Scripting:	return "Scripting";
+			case MemoryTag::Physics:	return "Physics";
+			case MemoryTag::UI:			return "UI";
+			default:					return "Invalid";
+			}
+		}
+
+		MemoryTag MemoryTracker::GetThreadTag()
+		{
+			return s_ThreadTag;
+		}
+
+		void MemoryTracker::SetThreadTag(MemoryTag Tag)
+		{
+			s_ThreadTag = Tag;
+		}
+
+		void MemoryTracker::OnAllocate(MemoryTag Tag, size_t Size)
+		{
+			ThreadCounters& Thread = GetThreadCounters();
+			const bool IsShared = &Thread == &s_SharedCounters;
+			TagCounters& Counters = Thread.Tags[static_cast<uint32_t>(Tag)];
+			AddCounter<int64_t>(Counters.LiveBytes, static_cast<int64_t>(Size), IsShared);
+			AddCounter<int64_t>(Counters.LiveAllocations, 1, IsShared);
+			AddCounter<uint64_t>(Counters.TotalAllocations, 1u, IsShared);
+			AddCounter<uint64_t>(Counters.TotalBytes, Size, IsShared);
+		}
+
+		void MemoryTracker::OnFree(MemoryTag Tag, size_t Size)
+		{
+			// Memory freed by another thread than the one that allocated it leaves the two blocks with opposite live counts, their sum is still right.
+			ThreadCounters& Thread = GetThreadCounters();
+			const bool IsShared = &Thread == &s_SharedCounters;
+			TagCounters& Counters = Thread.Tags[static_cast<uint32_t>(Tag)];
+			AddCounter<int64_t>(Counters.LiveBytes, -static_cast<int64_t>(Size), IsShared);
+			AddCounter<int64_t>(Counters.LiveAllocations, -1, IsShared);
+			AddCounter<uint64_t>(Counters.TotalFrees, 1u, IsShared);
+		}
+
+		void MemoryTracker::BeginFrame(float DeltaTime)
+		{
+			if (!IsEnabled())
+				return;
+
+			std::lock_guard<std::mutex> Lock(s_FrameMutex);
+			const float InvDeltaTime = DeltaTime > 0.0f ? 1.0f / DeltaTime : 0.0f;
+			for (uint32_t i = 0; i < NumMemoryTags; ++i)
+			{
+				const TagTotals Totals = SumTag(i);
+				FrameBaseline& Baseline = s_FrameBaselines[i];
+				MemoryTagStats& Frame = s_FrameStats[i];
+
+				const uint64_t TotalAllocations = Totals.TotalAllocations;
+				const uint64_t TotalBytes = Totals.TotalBytes;
+				const uint64_t TotalFrees = Totals.TotalFrees;
+
+				Frame.FrameAllocations = TotalAllocations - Baseline.TotalAllocations;
+				Frame.FrameBytesAllocated = TotalBytes - Baseline.TotalBytes;
+				Frame.FrameFrees = TotalFrees - Baseline.TotalFrees;
+				Frame.FramePeakBytes = s_FramePeakBytes[i].exchange(Totals.LiveBytes, std::memory_order_relaxed);
+				Frame.LiveBytes = Totals.LiveBytes;
+				Frame.LiveAllocations = Totals.LiveAllocations;
+				Frame.AllocationsPerSecond = static_cast<float>(Frame.FrameAllocations) * InvDeltaTime;
+				Frame.BytesPerSecond = static_cast<float>(Frame.FrameBytesAllocated) * InvDeltaTime;
+
+				Baseline = { TotalAllocations, TotalBytes, TotalFrees };
+			}
+
+			if (s_pCsvFile)
+			{
+				for (uint32_t i = 0; i < NumMemoryTags; ++i)
+				{
+					const MemoryTagStats& Frame = s_FrameStats[i];
+					fprintf(s_pCsvFile, "%llu,%s,%lld,%lld,%lld,%llu,%llu,%llu,%lld,%.1f,%.1f\n",
+						static_cast<unsigned long long>(s_FrameIndex), GetMemoryTagName(static_cast<MemoryTag>(i)),
+						static_cast<long long>(Frame.LiveBytes),
+						static_cast<long long>(Frame.LiveAllocations),
+						static_cast<long long>(s_PeakBytes[i].load(std::memory_order_relaxed)),
+						static_cast<unsigned long long>(Frame.FrameAllocations), static_cast<unsigned long long>(Frame.FrameBytesAllocated),
+						static_cast<unsigned long long>(Frame.FrameFrees), static_cast<long long>(Frame.FramePeakBytes),
+						Frame.AllocationsPerSecond, Frame.BytesPerSecond);
+				}
+			}
+
+			s_FrameIndex++;
+		}
+
+		MemoryTagStats MemoryTracker::GetTagStats(MemoryTag Tag)
+		{
+			const uint32_t Index = static_cast<uint32_t>(Tag);
+			const TagTotals Totals = SumTag(Index);
+
+			MemoryTagStats Stats;
+			{
+				std::lock_guard<std::mutex> Lock(s_FrameMutex);
+				Stats = s_FrameStats[Index];
+			}
+			Stats.LiveBytes = Totals.LiveBytes;
+			Stats.LiveAllocations = Totals.LiveAllocations;
+			Stats.PeakBytes = s_PeakBytes[Index].load(std::memory_order_relaxed);
+			Stats.TotalAllocations = Totals.TotalAllocations;
+			Stats.TotalBytesAllocated = Totals.TotalBytes;
+			return Stats;
+		}
+
+		void MemoryTracker::GetAllTagStats(MemoryTagStats (&OutStats)[NumMemoryTags])
+		{
+			for (uint32_t i = 0; i < NumMemoryTags; ++i)
+				OutStats[i] = GetTagStats(static_cast<MemoryTag>(i));
+		}
+
+		bool MemoryTracker::OpenCsv(const std::string& FilePath)
+		{
+			std::lock_guard<std::mutex> Lock(s_FrameMutex);
+			if (s_pCsvFile)
+				fclose(s_pCsvFile);
+
+			s_pCsvFile = fopen(FilePath.c_str(), "w");
+			if (!s_pCsvFile)
+				return false;
+
+			fprintf(s_pCsvFile, "Frame,Tag,LiveBytes,LiveAllocations,PeakBytes,FrameAllocations,FrameBytes,FrameFrees,FramePeakBytes,AllocationsPerSecond,BytesPerSecond\n");
+			return true;
+		}
+
+		void MemoryTracker::CloseCsv()
+		{
+			std::lock_guard<std::mutex> Lock(s_FrameMutex);
+			if (s_pCsvFile)
+			{
+				fclose(s_pCsvFile);
+				s_pCsvFile = nullptr;
+			}
+		}
+
+		void MemoryTracker::ReportLeaks()
+		{
+			if (!IsEnabled())
+				return;
+
+			bool FoundLeaks = false;
+			for (uint32_t i = 0; i < NumMemoryTags; ++i)
+			{
+				const MemoryTag Tag = static_cast<MemoryTag>(i);
+				const MemoryTagStats Stats = GetTagStats(Tag);
+				if (Stats.LiveAllocations <= 0)
+					continue;
+
+				// Untagged memory includes globals that live until the process exits, it is listed for reference only.
+				if (Tag == MemoryTag::Untagged)
+				{
+					IE_DEBUG_LOG(LogSeverity::Log, "Memory still allocated at shutdown: {0} - {1} allocations ({2} bytes).", GetMemoryTagName(Tag), Stats.LiveAllocations, Stats.LiveBytes);
+					continue;
+				}
+
+				IE_DEBUG_LOG(LogSeverity::Warning, "Memory leaked at shutdown: {0} - {1} allocations ({2} bytes). Peak: {3} bytes.", GetMemoryTagName(Tag), Stats.LiveAllocations, Stats.LiveBytes, Stats.PeakBytes);
+				FoundLeaks = true;
+			}
+
+			if (!FoundLeaks)
+			{
+				IE_DEBUG_LOG(LogSeverity::Log, "No tagged memory leaked.");
+			}
+		}
+
+	} // end namespace Memory
+} // end namespace Insight
+
+
+#if defined (IE_MEMORY_TRACKING_ENABLED)
+
+// Global allocation hooks
+// -----------------------
+// Every allocation is prefixed with a header recording its size and tag so frees can be
+// attributed to the tag the memory was allocated under, whatever the current tag is.
+
+namespace {
+
+	using Insight::Memory::MemoryTag;
+	using Insight::Memory::MemoryTracker;
+
+	struct AllocationHeader
+	{
+		uint64_t Size;
+		// Distance from the start of the underlying block to the user pointer.
+		uint32_t Offset;
+		uint8_t Tag;
+		uint8_t OverAligned;
+		uint16_t Reserved;
+	};
+	constexpr size_t s_HeaderSize = 16u;
+	static_assert(sizeof(AllocationHeader) == s_HeaderSize, "Allocation header size changed.");
+
+	inline void* AlignedMalloc(size_t Size, size_t Alignment)
+	{
+#if defined (IE_PLATFORM_WINDOWS)
+		return _aligned_malloc(Size, Alignment);
+#else
+		void* pMemory = nullptr;
+		return posix_memalign(&pMemory, Alignment, Size) == 0 ? pMemory : nullptr;
+#endif
+	}
+
+	inline void AlignedFree(void* pMemory)
+	{
+#if defined (IE_PLATFORM_WINDOWS)
+		_aligned_free(pMemory);
+#else
+		free(pMemory);
+#endif
+	}
+
+	inline void* TrackedAllocate(size_t Size, size_t Alignment) noexcept
+	{
+		// Alignment is a power of two, so over aligned blocks place the user pointer a whole alignment in.
+		const bool OverAligned = Alignment > s_HeaderSize;
+		const size_t Offset = OverAligned ? Alignment : s_HeaderSize;
+		void* pBlock = OverAligned ? AlignedMalloc(Size + Offset, Alignment) : malloc(Size + Offset);
+		if (!pBlock)
+			return nullptr;
+
+		uint8_t* pUser = static_cast<uint8_t*>(pBlock) + Offset;
+		AllocationHeader* pHeader = reinterpret_cast<AllocationHeader*>(pUser) - 1;
+		const MemoryTag Tag = MemoryTracker::GetThreadTag();
+		pHeader->Size = Size;
+		pHeader->Offset = static_cast<uint32_t>(Offset);
+		pHeader->Tag = static_cast<uint8_t>(Tag);
+		pHeader->OverAligned = OverAligned ? 1u : 0u;
+		pHeader->Reserved = 0u;
+
+		MemoryTracker::OnAllocate(Tag, Size);
+		return pUser;
+	}
+
+	inline void TrackedFree(void* pMemory) noexcept
+	{
+		if (!pMemory)
+			return;
+
+		const AllocationHeader* pHeader = reinterpret_cast<const AllocationHeader*>(pMemory) - 1;
+		MemoryTracker::OnFree(static_cast<MemoryTag>(pHeader->Tag), static_cast<size_t>(pHeader->Size));
+
+		void* pBlock = static_cast<uint8_t*>(pMemory) - pHeader->Offset;
+		if (pHeader->OverAligned)
+			AlignedFree(pBlock);
+		else
+			free(pBlock);
+	}
+
+	inline void* TrackedAllocateOrThrow(size_t Size, size_t Alignment)
+	{
+		if (void* pMemory = TrackedAllocate(Size, Alignment))
+			return pMemory;
+		throw std::bad_alloc();
+	}
+
+} // end anonymous namespace
+
+void* operator new(size_t Size) { return TrackedAllocateOrThrow(Size, s_HeaderSize); }
+void* operator new[](size_t Size) { return TrackedAllocateOrThrow(Size, s_HeaderSize); }
+void* operator new(size_t Size, const std::nothrow_t&) noexcept { return TrackedAllocate(Size, s_HeaderSize); }
+void* operator new[](size_t Size, const std::nothrow_t&) noexcept { return TrackedAllocate(Size, s_HeaderSize); }
+void* operator new(size_t Size, std::align_val_t Alignment) { return TrackedAllocateOrThrow(Size, static_cast<size_t>(Alignment)); }
+void* operator new[](size_t Size, std::align_val_t Alignment) { return TrackedAllocateOrThrow(Size, static_cast<size_t>(Alignment)); }
+void* operator new(size_t Size, std::align_val_t Alignment, const std::nothrow_t&) noexcept { return TrackedAllocate(Size, static_cast<size_t>(Alignment)); }
+void* operator new[](size_t Size, std::align_val_t Alignment, const std::nothrow_t&) noexcept { return TrackedAllocate(Size, static_cast<size_t>(Alignment)); }
+
+void operator delete(void* pMemory) noexcept { TrackedFree(pMemory); }
+void operator delete[](void* pMemory) noexcept { TrackedFree(pMemory); }
+void operator delete(void* pMemory, size_t) noexcept { TrackedFree(pMemory); }
+void operator delete[](void* pMemory, size_t) noexcept { TrackedFree(pMemory); }
+void operator delete(void* pMemory, const std::nothrow_t&) noexcept { TrackedFree(pMemory); }
+void operator delete[](void* pMemory, const std::nothrow_t&) noexcept { TrackedFree(pMemory); }
+void operator delete(void* pMemory, std::align_val_t) noexcept { TrackedFree(pMemory); }
+void operator delete[](void* pMemory, std::align_val_t) noexcept { TrackedFree(pMemory); }
+void operator delete(void* pMemory, size_t, std::align_val_t) noexcept { TrackedFree(pMemory); }
+void operator delete[](void* pMemory, size_t, std::align_val_t) noexcept { TrackedFree(pMemory); }
+void operator delete(void* pMemory, std::align_val_t, const std::nothrow_t&) noexcept { TrackedFree(pMemory); }
+void operator delete[](void* pMemory, std::align_val_t, const std::nothrow_t&) noexcept { TrackedFree(pMemory); }
+
+#endif // IE_MEMORY_TRACKING_ENABLED
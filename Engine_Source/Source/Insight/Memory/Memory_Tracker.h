@@ -0,0 +1,147 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Memory_Tracker.h
+	Source - Memory_Tracker.cpp
+
+	Purpose:
+	Tracks where heap memory goes, broken down by engine subsystem.
+
+	Description:
+	When IE_MEMORY_TRACKING_ENABLED is defined (Debug and Release builds) the global operator
+	new and delete are replaced with versions that prefix every allocation with a small header
+	holding its size and tag. The tag is taken from the calling thread's current tag, set with
+	IE_MEMORY_TAG for the rest of a scope. Untagged memory is reported as Untagged.
+
+	Per tag the tracker keeps live bytes, live allocations and running totals. Every thread
+	counts into a block of its own, so the hooks never contend on a shared counter, and the
+	blocks are summed when the stats are read. The peak live bytes are taken from those sums,
+	so they are the highest values seen at a read (at least once a frame) rather than the exact
+	high water mark between reads. Once a frame MemoryTracker::BeginFrame
+	turns the running totals into per frame numbers (allocations, bytes and frees during the last
+	frame, plus allocation rate per second) that can be read with GetTagStats for an overlay, or
+	streamed to a CSV file one row per frame. ReportLeaks logs every tag that still has live
+	memory at shutdown.
+
+	Only memory allocated through operator new is seen. Third party libraries using malloc
+	directly (Ex. Assimp internals, Mono) are not tracked unless routed through it like ImGui.
+
+	Example Usage:
+	{
+		IE_MEMORY_TAG(Assets);
+		LoadModel(...); // Everything allocated in here is counted against Assets.
+	}
+	Memory::MemoryTagStats Stats = Memory::MemoryTracker::GetTagStats(Memory::MemoryTag::Assets);
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+#include <cstdio>
+#include <cstdint>
+#include <string>
+
+namespace Insight {
+
+	namespace Memory {
+
+		enum class MemoryTag : uint8_t
+		{
+			Untagged,
+			Rendering,
+			Scene,
+			Assets,
+			Scripting,
+			Physics,
+			UI,
+
+			NumTags
+		};
+		constexpr uint32_t NumMemoryTags = static_cast<uint32_t>(MemoryTag::NumTags);
+
+		INSIGHT_API const char* GetMemoryTagName(MemoryTag Tag);
+
+		struct MemoryTagStats
+		{
+			// Current state.
+			int64_t LiveBytes;
+			int64_t LiveAllocations;
+			int64_t PeakBytes;
+			uint64_t TotalAllocations;
+			uint64_t TotalBytesAllocated;
+
+			// The last frame completed by MemoryTracker::BeginFrame.
+			uint64_t FrameAllocations;
+			uint64_t FrameBytesAllocated;
+			uint64_t FrameFrees;
+			int64_t FramePeakBytes;
+			float AllocationsPerSecond;
+			float BytesPerSecond;
+		};
+
+		class INSIGHT_API MemoryTracker
+		{
+		public:
+			// True if the global allocation hooks are compiled in. All stats read zero otherwise.
+			static constexpr bool IsEnabled()
+			{
+#if defined (IE_MEMORY_TRACKING_ENABLED)
+				return true;
+#else
+				return false;
+#endif
+			}
+
+			static MemoryTag GetThreadTag();
+			static void SetThreadTag(MemoryTag Tag);
+
+			/*
+				Close the current frame's stats and start a new frame. Call once per frame from the game thread.
+				@param DeltaTime: Length of the frame that just finished, in seconds.
+			*/
+			static void BeginFrame(float DeltaTime);
+
+			static MemoryTagStats GetTagStats(MemoryTag Tag);
+			static void GetAllTagStats(MemoryTagStats (&OutStats)[NumMemoryTags]);
+			static inline uint64_t GetFrameIndex() { return s_FrameIndex; }
+
+			/*
+				Stream one CSV row per tag per frame to a file, written in BeginFrame.
+				@param FilePath: File to write. Will be overwritten if it exists.
+			*/
+			static bool OpenCsv(const std::string& FilePath);
+			static void CloseCsv();
+
+			// Log every tag that still has live allocations. Call at shutdown once the engine has released its resources.
+			static void ReportLeaks();
+
+			// Called by the allocation hooks.
+			static void OnAllocate(MemoryTag Tag, size_t Size);
+			static void OnFree(MemoryTag Tag, size_t Size);
+
+		private:
+			static uint64_t s_FrameIndex;
+		};
+
+		// Sets the calling thread's memory tag for the lifetime of the scope.
+		class ScopedMemoryTag
+		{
+		public:
+			ScopedMemoryTag(MemoryTag Tag)
+				: m_PreviousTag(MemoryTracker::GetThreadTag())
+			{
+				MemoryTracker::SetThreadTag(Tag);
+			}
+			~ScopedMemoryTag() { MemoryTracker::SetThreadTag(m_PreviousTag); }
+
+		private:
+			MemoryTag m_PreviousTag;
+		};
+
+	} // end namespace Memory
+} // end namespace Insight
+
+#if defined (IE_MEMORY_TRACKING_ENABLED)
+	#define IE_MEMORY_TAG(Tag) ::Insight::Memory::ScopedMemoryTag IE_MemoryTagScope(::Insight::Memory::MemoryTag::Tag)
+#else
+	#define IE_MEMORY_TAG(Tag)
+#endif
@@ -0,0 +1,101 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Object_Pool.h"
+
+namespace Insight {
+
+	namespace Memory {
+
+		// Slabs are at least this big, or hold at least s_MinSlotsPerSlab slots for large classes.
+		static constexpr size_t s_TargetSlabSize = 16u * 1024u;
+		static constexpr uint32_t s_MinSlotsPerSlab = 8u;
+
+		static inline size_t AlignToCacheLine(size_t Value) { return (Value + SlabPool::CacheLineSize - 1) & ~(SlabPool::CacheLineSize - 1); }
+
+		SlabPool::SlabPool(size_t ObjectSize, const char* DebugName)
+			: m_DebugName(DebugName)
+			, m_ObjectSize(ObjectSize)
+			, m_SlotStride(AlignToCacheLine(ObjectOffset + ObjectSize))
+			, m_pSlabs(new uint8_t*[MaxSlabs])
+		{
+			const size_t SlotsPerSlab = s_TargetSlabSize / m_SlotStride;
+			m_SlotsPerSlab = SlotsPerSlab > s_MinSlotsPerSlab ? static_cast<uint32_t>(SlotsPerSlab) : s_MinSlotsPerSlab;
+		}
+
+		SlabPool::~SlabPool()
+		{
+			for (uint32_t i = 0; i < m_NumSlabs; ++i)
+				::operator delete(m_pSlabs[i], std::align_val_t(CacheLineSize));
+		}
+
+		void* SlabPool::Allocate()
+		{
+			std::lock_guard<std::mutex> Lock(m_Mutex);
+			if (m_FreeSlots.empty())
+				AllocateSlab();
+
+			const uint32_t Index = m_FreeSlots.back();
+			m_FreeSlots.pop_back();
+			m_NumLive++;
+
+			return GetSlot(Index) + ObjectOffset;
+		}
+
+		void SlabPool::Free(void* pObject)
+		{
+			PoolSlotHeader* pHeader = GetHeader(pObject);
+			IE_ASSERT(pHeader->pPool == this, "Object is being freed to a pool it was not allocated from.");
+
+			// Invalidate outstanding handles before the slot can be handed out again.
+			pHeader->Generation.fetch_add(1u, std::memory_order_release);
+
+			std::lock_guard<std::mutex> Lock(m_Mutex);
+			m_FreeSlots.push_back(pHeader->Index);
+			m_NumLive--;
+		}
+
+		void SlabPool::AllocateSlab()
+		{
+			IE_ASSERT(m_NumSlabs < MaxSlabs, "Object pool is out of slabs.");
+
+			uint8_t* pSlab = static_cast<uint8_t*>(::operator new(m_SlotStride * m_SlotsPerSlab, std::align_val_t(CacheLineSize)));
+			const uint32_t FirstIndex = m_NumSlabs * m_SlotsPerSlab;
+			m_pSlabs[m_NumSlabs++] = pSlab;
+
+			// Push in reverse so the first slot of the slab is handed out first.
+			m_FreeSlots.reserve(m_FreeSlots.size() + m_SlotsPerSlab);
+			for (uint32_t i = m_SlotsPerSlab; i-- > 0;)
+			{
+				PoolSlotHeader* pHeader = reinterpret_cast<PoolSlotHeader*>(pSlab + i * m_SlotStride);
+				pHeader->pPool = this;
+				pHeader->Index = FirstIndex + i;
+				new (&pHeader->Generation) std::atomic<uint32_t>(0u);
+				m_FreeSlots.push_back(FirstIndex + i);
+			}
+		}
+
+		void* AllocateUnpooled(size_t Size)
+		{
+			uint8_t* pMemory = static_cast<uint8_t*>(::operator new(SlabPool::ObjectOffset + Size, std::align_val_t(SlabPool::MaxObjectAlignment)));
+			PoolSlotHeader* pHeader = reinterpret_cast<PoolSlotHeader*>(pMemory);
+			pHeader->pPool = nullptr;
+			pHeader->Index = 0u;
+			new (&pHeader->Generation) std::atomic<uint32_t>(0u);
+			return pMemory + SlabPool::ObjectOffset;
+		}
+
+		void PoolFree(void* pObject)
+		{
+			if (!pObject)
+				return;
+
+			PoolSlotHeader* pHeader = SlabPool::GetHeader(pObject);
+			if (pHeader->pPool)
+				pHeader->pPool->Free(pObject);
+			else
+				::operator delete(pHeader, std::align_val_t(SlabPool::MaxObjectAlignment));
+		}
+
+	} // end namespace Memory
+} // end namespace Insight
@@ -0,0 +1,192 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Object_Pool.h
+	Source - Object_Pool.cpp
+
+	Purpose:
+	Slab backed pools for objects that are created and destroyed often (actors and components).
+
+	Description:
+	Every pooled class gets a pool of fixed size slots sized for that exact class. Slots are
+	carved out of slabs that are never returned to the heap, so spawning and despawning reuses
+	the same cache line aligned memory instead of churning the general allocator. Freed slots
+	are reused most recently freed first to keep hot memory in cache.
+
+	A class opts in with IE_DECLARE_POOLED_CLASS, which routes its new and delete to the pool.
+	Existing new/delete expressions keep working. A class derived from a pooled class that does
+	not declare the macro itself falls back to the heap, it is still safe to delete and to
+	reference with a handle.
+
+	Each slot starts with a small header holding a generation that is bumped when the slot is
+	freed. PoolHandle pairs an object with the generation it was created with, so a handle to
+	a destroyed object resolves to null instead of dangling, even after the slot is reused.
+
+	Example Usage:
+	class AMyActor : public Runtime::AActor
+	{
+		IE_DECLARE_POOLED_CLASS(AMyActor)
+		...
+	};
+	Memory::PoolHandle<AMyActor> Handle(new AMyActor(...));
+	if (AMyActor* pActor = Handle.Get()) { ... }
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <typeinfo>
+#include <type_traits>
+
+namespace Insight {
+
+	namespace Memory {
+
+		class SlabPool;
+
+		// Sits directly in front of every object allocated by a pooled class's operator new.
+		struct PoolSlotHeader
+		{
+			// Null if the object fell back to the heap.
+			SlabPool* pPool;
+			uint32_t Index;
+			std::atomic<uint32_t> Generation;
+		};
+
+		class INSIGHT_API SlabPool
+		{
+		public:
+			static constexpr size_t CacheLineSize = 64u;
+			// Objects start this many bytes into their slot, right after the header.
+			static constexpr size_t ObjectOffset = 16u;
+			static constexpr size_t MaxObjectAlignment = ObjectOffset;
+			static constexpr uint32_t MaxSlabs = 4096u;
+			static_assert(sizeof(PoolSlotHeader) <= ObjectOffset, "Pool slot header does not fit in front of the object.");
+
+		public:
+			/*
+				@param ObjectSize: Size of the pooled class.
+				@param DebugName: Name of the pooled class. Must outlive the pool.
+			*/
+			SlabPool(size_t ObjectSize, const char* DebugName);
+			~SlabPool();
+
+			SlabPool(const SlabPool&) = delete;
+			SlabPool& operator = (const SlabPool&) = delete;
+
+			// Returns uninitialized memory for one object. Thread safe.
+			void* Allocate();
+			// Return an object's memory to the pool and invalidate its handles. Thread safe.
+			void Free(void* pObject);
+
+			inline static PoolSlotHeader* GetHeader(void* pObject) { return reinterpret_cast<PoolSlotHeader*>(static_cast<uint8_t*>(pObject) - ObjectOffset); }
+			inline static const PoolSlotHeader* GetHeader(const void* pObject) { return reinterpret_cast<const PoolSlotHeader*>(static_cast<const uint8_t*>(pObject) - ObjectOffset); }
+
+			inline const char* GetDebugName() const { return m_DebugName; }
+			inline size_t GetObjectSize() const { return m_ObjectSize; }
+			inline size_t GetSlotStride() const { return m_SlotStride; }
+			inline uint32_t GetNumSlabs() const { return m_NumSlabs; }
+			inline uint32_t GetNumSlots() const { return m_NumSlabs * m_SlotsPerSlab; }
+			inline uint32_t GetNumLive() const { return m_NumLive; }
+
+		private:
+			uint8_t* GetSlot(uint32_t Index) const { return m_pSlabs[Index / m_SlotsPerSlab] + (Index % m_SlotsPerSlab) * m_SlotStride; }
+			void AllocateSlab();
+
+		private:
+			const char* m_DebugName;
+			size_t m_ObjectSize;
+			size_t m_SlotStride;
+			uint32_t m_SlotsPerSlab;
+
+			std::mutex m_Mutex;
+			// Fixed size so slab pointers never move while other threads read them.
+			std::unique_ptr<uint8_t*[]> m_pSlabs;
+			uint32_t m_NumSlabs = 0u;
+			std::vector<uint32_t> m_FreeSlots;
+			uint32_t m_NumLive = 0u;
+		};
+
+		// Allocate an object with a header but without a pool. Used when a pooled class's operator new is asked for a different size.
+		INSIGHT_API void* AllocateUnpooled(size_t Size);
+		// Free memory returned by PoolAllocate or AllocateUnpooled.
+		INSIGHT_API void PoolFree(void* pObject);
+
+		// The pool for objects of exactly type T. Pools live for the lifetime of the process.
+		template <typename T>
+		SlabPool& GetObjectPool()
+		{
+			static_assert(alignof(T) <= SlabPool::MaxObjectAlignment, "Pooled classes may not be aligned beyond 16 bytes.");
+			static SlabPool* s_pPool = new SlabPool(sizeof(T), typeid(T).name());
+			return *s_pPool;
+		}
+
+		template <typename T>
+		inline void* PoolAllocate(size_t Size)
+		{
+			return (Size == sizeof(T)) ? GetObjectPool<T>().Allocate() : AllocateUnpooled(Size);
+		}
+
+
+		// Generational reference to an object allocated by a pooled class.
+		template <typename T>
+		class PoolHandle
+		{
+		public:
+			PoolHandle() = default;
+			explicit PoolHandle(T* pObject)
+				: m_pObject(pObject)
+			{
+				if (!pObject)
+					return;
+
+				// The header sits in front of the most derived object, which may not be where the T sub-object starts.
+				const void* pMostDerived = nullptr;
+				if constexpr (std::is_polymorphic<T>::value)
+					pMostDerived = dynamic_cast<const void*>(pObject);
+				else
+					pMostDerived = pObject;
+
+				const PoolSlotHeader* pHeader = SlabPool::GetHeader(pMostDerived);
+				if (pHeader->pPool)
+				{
+					m_pHeader = pHeader;
+					m_Generation = pHeader->Generation.load(std::memory_order_relaxed);
+				}
+			}
+
+			// Returns the object, or null if it has been destroyed. Heap fallback objects cannot be checked and are always returned.
+			inline T* Get() const
+			{
+				if (m_pHeader && m_pHeader->Generation.load(std::memory_order_acquire) != m_Generation)
+					return nullptr;
+				return m_pObject;
+			}
+
+			inline bool IsValid() const { return Get() != nullptr; }
+			inline explicit operator bool() const { return IsValid(); }
+			inline void Reset() { m_pObject = nullptr; m_pHeader = nullptr; m_Generation = 0u; }
+
+			inline bool operator == (const PoolHandle& Other) const { return m_pObject == Other.m_pObject && m_Generation == Other.m_Generation; }
+			inline bool operator != (const PoolHandle& Other) const { return !(*this == Other); }
+
+		private:
+			T* m_pObject = nullptr;
+			const PoolSlotHeader* m_pHeader = nullptr;
+			uint32_t m_Generation = 0u;
+		};
+
+	} // end namespace Memory
+} // end namespace Insight
+
+// Route a class's new and delete through its object pool. Every class in a pooled hierarchy should declare it.
+#define IE_DECLARE_POOLED_CLASS(ClassName)																			\
+public:																												\
+	static void* operator new(size_t Size) { return ::Insight::Memory::PoolAllocate<ClassName>(Size); }			\
+	static void operator delete(void* pObject) { ::Insight::Memory::PoolFree(pObject); }							\
+	static void* operator new(size_t Size, void* pPlacement) { return pPlacement; }									\
+	static void operator delete(void* pObject, void* pPlacement) {}													\
+private:
@@ -0,0 +1,66 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Scratch_Allocator.h"
+
+namespace Insight {
+
+	namespace Memory {
+
+		static constexpr size_t s_StackAlignment = 64u;
+
+		ScratchStack::ScratchStack()
+			: m_pBase(static_cast<uint8_t*>(::operator new(Capacity, std::align_val_t(s_StackAlignment))))
+		{
+		}
+
+		ScratchStack::~ScratchStack()
+		{
+			RewindTo({ 0u, 0u });
+			::operator delete(m_pBase, std::align_val_t(s_StackAlignment));
+		}
+
+		ScratchStack& ScratchStack::Get()
+		{
+			static thread_local ScratchStack s_ThreadStack;
+			return s_ThreadStack;
+		}
+
+		void* ScratchStack::Allocate(size_t Size, size_t Alignment)
+		{
+			IE_ASSERT((Alignment & (Alignment - 1)) == 0, "Scratch alignment must be a power of two.");
+
+			const uintptr_t Base = reinterpret_cast<uintptr_t>(m_pBase);
+			const size_t AlignedOffset = AlignUp(Base + m_Offset, Alignment) - Base;
+			if (AlignedOffset + Size <= Capacity)
+			{
+				m_Offset = AlignedOffset + Size;
+				if (m_Offset > m_PeakUsed)
+					m_PeakUsed = m_Offset;
+				return m_pBase + AlignedOffset;
+			}
+
+			// Out of stack space. The block is freed when the scope that owns it closes.
+			if (Alignment < DefaultAlignment)
+				Alignment = DefaultAlignment;
+			void* pMemory = ::operator new(Size, std::align_val_t(Alignment));
+			m_OverflowBlocks.push_back({ pMemory, Alignment });
+			IE_DEBUG_LOG(LogSeverity::Verbose, "Scratch stack ran out of space. Allocated {0} bytes from the heap instead.", Size);
+			return pMemory;
+		}
+
+		void ScratchStack::RewindTo(const Marker& StackMarker)
+		{
+			IE_ASSERT(StackMarker.Offset <= m_Offset, "Scratch scopes must be closed in the reverse order they were opened.");
+
+			m_Offset = StackMarker.Offset;
+			while (m_OverflowBlocks.size() > StackMarker.NumOverflowBlocks)
+			{
+				const OverflowBlock& Block = m_OverflowBlocks.back();
+				::operator delete(Block.pMemory, std::align_val_t(Block.Alignment));
+				m_OverflowBlocks.pop_back();
+			}
+		}
+
+	} // end namespace Memory
+} // end namespace Insight
@@ -0,0 +1,107 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Scratch_Allocator.h
+	Source - Scratch_Allocator.cpp
+
+	Purpose:
+	Per thread stack of temporary memory for short lived allocations inside of a function.
+
+	Description:
+	Every thread gets its own ScratchStack the first time it asks for one so allocating never
+	needs to synchronize. A ScratchScope remembers the top of the stack when it is created and
+	rewinds to it when it goes out of scope, releasing everything allocated inside of it in one
+	step. Scopes nest, so a recursive function may open a scope at each level. If the stack
+	runs out allocations fall back to the heap and are freed when the owning scope closes.
+
+	Objects placed on the scratch stack never have their destructors called.
+
+	Example Usage:
+	Memory::ScratchScope Scratch;
+	Mesh** ppMeshes = Scratch.AllocateArray<Mesh*>(NumMeshes);
+	Memory::ScratchVector<Mesh*> Meshes{ Memory::ScratchAllocator<Mesh*>(Memory::ScratchStack::Get()) };
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+#include "Insight/Memory/Linear_Arena.h"
+
+namespace Insight {
+
+	namespace Memory {
+
+		class INSIGHT_API ScratchStack
+		{
+		public:
+			static constexpr size_t Capacity = 1024u * 1024u;
+
+			// A position on the stack that can be rewound to.
+			struct Marker
+			{
+				size_t Offset;
+				size_t NumOverflowBlocks;
+			};
+
+		public:
+			ScratchStack();
+			~ScratchStack();
+
+			ScratchStack(const ScratchStack&) = delete;
+			ScratchStack& operator = (const ScratchStack&) = delete;
+
+			// Returns the calling thread's scratch stack.
+			static ScratchStack& Get();
+
+			// Allocate uninitialized memory. Released when the enclosing ScratchScope closes.
+			void* Allocate(size_t Size, size_t Alignment = DefaultAlignment);
+
+			inline Marker GetMarker() const { return { m_Offset, m_OverflowBlocks.size() }; }
+			// Release everything allocated after the marker was taken.
+			void RewindTo(const Marker& StackMarker);
+
+			inline size_t GetUsed() const { return m_Offset; }
+			inline size_t GetPeakUsed() const { return m_PeakUsed; }
+
+		private:
+			struct OverflowBlock
+			{
+				void* pMemory;
+				size_t Alignment;
+			};
+
+			uint8_t* m_pBase = nullptr;
+			size_t m_Offset = 0u;
+			size_t m_PeakUsed = 0u;
+			std::vector<OverflowBlock> m_OverflowBlocks;
+		};
+
+		// Releases every scratch allocation made on this thread during the scope's lifetime.
+		class ScratchScope
+		{
+		public:
+			ScratchScope()
+				: m_Stack(ScratchStack::Get()), m_Marker(m_Stack.GetMarker()) {}
+			~ScratchScope() { m_Stack.RewindTo(m_Marker); }
+
+			ScratchScope(const ScratchScope&) = delete;
+			ScratchScope& operator = (const ScratchScope&) = delete;
+
+			inline void* Allocate(size_t Size, size_t Alignment = DefaultAlignment) { return m_Stack.Allocate(Size, Alignment); }
+
+			// Allocate an uninitialized array. T must be trivially destructible, destructors are never called.
+			template <typename T>
+			inline T* AllocateArray(size_t Count)
+			{
+				static_assert(std::is_trivially_destructible<T>::value, "Scratch memory is never destructed.");
+				return static_cast<T*>(m_Stack.Allocate(sizeof(T) * Count, alignof(T)));
+			}
+
+			inline ScratchStack& GetStack() { return m_Stack; }
+
+		private:
+			ScratchStack& m_Stack;
+			ScratchStack::Marker m_Marker;
+		};
+
+	} // end namespace Memory
+} // end namespace Insight
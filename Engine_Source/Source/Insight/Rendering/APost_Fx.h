@@ -9,6 +9,7 @@ namespace Insight {
 
 	class INSIGHT_API APostFx : public Runtime::AActor
 	{
+		IE_DECLARE_POOLED_CLASS(APostFx)
 	public:
 		APostFx(ActorId id, Runtime::ActorType type = "Spot Light Actor");
 		virtual ~APostFx();
@@ -87,6 +87,8 @@ namespace Insight {
 			Writer->Key("DisplayName");
 			Writer->String(SceneNode::GetDisplayName());
 
+			WriteGuidToJson(*Writer);
+
 			Writer->Key("Transform");
 			Writer->StartArray(); // Start Write Transform
 			{
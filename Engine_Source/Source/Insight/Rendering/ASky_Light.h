@@ -10,6 +10,7 @@ namespace Insight {
 
 	class INSIGHT_API ASkyLight : public Runtime::AActor
 	{
+		IE_DECLARE_POOLED_CLASS(ASkyLight)
 	public:
 		ASkyLight(ActorId id, Runtime::ActorType type = "Sky Light Actor");
 		virtual ~ASkyLight();
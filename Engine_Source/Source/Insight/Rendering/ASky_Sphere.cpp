@@ -68,6 +68,8 @@ namespace Insight {
 			Writer->Key("DisplayName");
 			Writer->String(SceneNode::GetDisplayName());
 
+			WriteGuidToJson(*Writer);
+
 			Writer->Key("Transform");
 			Writer->StartArray(); // Start Write Transform
 			{
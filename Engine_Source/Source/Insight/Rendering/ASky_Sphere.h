@@ -10,6 +10,7 @@ namespace Insight {
 	
 	class INSIGHT_API ASkySphere : public Runtime::AActor
 	{
+		IE_DECLARE_POOLED_CLASS(ASkySphere)
 	public:
 		ASkySphere(ActorId id, Runtime::ActorType type = "Sky Sphere Actor");
 		virtual ~ASkySphere();
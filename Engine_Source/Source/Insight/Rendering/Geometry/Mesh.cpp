@@ -30,6 +30,13 @@ namespace Insight {
 
 		m_Transform = std::move(mesh.m_Transform);
 		m_ConstantBufferPerObject = mesh.m_ConstantBufferPerObject;
+		m_RTInstanceIndex = mesh.m_RTInstanceIndex;
+		m_TransformId = mesh.m_TransformId;
+
+		mesh.m_pIndexBuffer = nullptr;
+		mesh.m_pVertexBuffer = nullptr;
+		mesh.m_RTInstanceIndex = ~0u;
+		mesh.m_TransformId = TransformJournal::InvalidId;
 	}
 
 	Mesh::~Mesh()
@@ -41,19 +48,38 @@ namespace Insight {
 	{
 		delete m_pVertexBuffer;
 		delete m_pIndexBuffer;
+		m_pVertexBuffer = nullptr;
+		m_pIndexBuffer = nullptr;
+
+		// The acceleration structure holds its own references to the buffers until it drops the instance.
+		if (m_RTInstanceIndex != ~0u)
+		{
+			Renderer::GetAs<Direct3D12Context>().UnregisterGeometryWithRTAccelerationStucture(m_RTInstanceIndex);
+			m_RTInstanceIndex = ~0u;
+		}
+
+		TransformJournal::Get().Unregister(m_TransformId);
+		m_TransformId = TransformJournal::InvalidId;
 	}
 
 	void Mesh::Init(const Verticies& Verticies, const Indices& Indices)
 	{
+		m_TransformId = TransformJournal::Get().Register();
 		CreateBuffers(Verticies, Indices);
 	}
 
 	void Mesh::PreRender(const XMMATRIX& parentMat)
 	{
-		m_Transform.SetWorldMatrix(XMMatrixMultiply(parentMat, m_Transform.GetLocalMatrix()));
-		m_ConstantBufferPerObject.World = m_Transform.GetWorldMatrixRef();
+		PreRender(Math::Simd::MatrixMultiply(Math::FromPlatformMatrix(parentMat), m_Transform.GetLocalSimdMatrix()));
+	}
+
+	void Mesh::PreRender(const Math::Simd::Matrix& WorldMatrix)
+	{
+		m_Transform.SetWorldSimdMatrix(WorldMatrix);
+		m_ConstantBufferPerObject.World = m_Transform.GetWorldMatrix();
 
-		if (m_ShouldUpdateAS) UpdateAccelerationStructures();
+		// The renderer picks the change up from the journal, Ex. to upload the constant buffer and refit the ray tracing acceleration structure.
+		TransformJournal::Get().Record(m_TransformId, m_ConstantBufferPerObject.World);
 	}
 
 	uint32_t Mesh::GetVertexCount()
@@ -103,15 +129,14 @@ namespace Insight {
 
 			if (Renderer::GetIsRayTraceEnabled()) {
 
-				m_ShouldUpdateAS = true;
-				
 				m_RTInstanceIndex = Renderer::GetAs<Direct3D12Context>()
 					.RegisterGeometryWithRTAccelerationStucture(
 						reinterpret_cast<D3D12VertexBuffer*>(m_pVertexBuffer)->GetVertexBuffer(),
 						reinterpret_cast<D3D12IndexBuffer*>(m_pIndexBuffer)->GetIndexBuffer(),
 						reinterpret_cast<D3D12VertexBuffer*>(m_pVertexBuffer)->GetNumVerticies(),
 						reinterpret_cast<D3D12IndexBuffer*>(m_pIndexBuffer)->GetNumIndices(),
-						m_Transform.GetWorldMatrix()
+						m_Transform.GetWorldMatrix(),
+						m_TransformId
 					);
 			}
 
@@ -129,11 +154,6 @@ namespace Insight {
 		}
 		}
 	}
-	
-	void Mesh::UpdateAccelerationStructures()
-	{
-		Renderer::GetAs<Direct3D12Context>().UpdateRTAccelerationStructureMatrix(m_RTInstanceIndex, m_Transform.GetWorldMatrix());
-	}
 
 }
 
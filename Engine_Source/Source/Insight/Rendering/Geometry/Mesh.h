@@ -8,6 +8,7 @@
 
 #include "Insight/Rendering/Geometry/Vertex_Buffer.h"
 #include "Insight/Rendering/Geometry/Index_Buffer.h"
+#include "Insight/Rendering/Geometry/Transform_Journal.h"
 
 namespace Insight {
 
@@ -20,6 +21,8 @@ namespace Insight {
 		~Mesh();
 
 		void PreRender(const ieMatrix4x4& parentMat);
+		// Same as PreRender for a world matrix that was already combined with the parent, Ex. by BatchMath.
+		void PreRender(const Math::Simd::Matrix& WorldMatrix);
 		void Render();
 		void Destroy();
 		void OnImGuiRender();
@@ -27,6 +30,10 @@ namespace Insight {
 		inline ieTransform& GetTransformRef() { return m_Transform; }
 		inline const ieTransform& GetTransform() const { return m_Transform; }
 		inline CB_VS_PerObject GetConstantBuffer() { return m_ConstantBufferPerObject; }
+		// Id the mesh's world matrix changes are recorded under in the TransformJournal.
+		inline TransformJournal::TransformId GetTransformId() const { return m_TransformId; }
+		// Instance of the mesh in the ray tracing acceleration structure, ~0u if it has none.
+		inline uint32_t GetRTInstanceIndex() const { return m_RTInstanceIndex; }
 
 		uint32_t GetVertexCount();
 		uint32_t GetVertexBufferSize();
@@ -37,7 +44,6 @@ namespace Insight {
 	private:
 		void Init(const Verticies& verticies, const Indices& indices);
 		void CreateBuffers(const Verticies& Verticies, const Indices& Indices);
-		void UpdateAccelerationStructures();
 	private:
 		ieVertexBuffer* m_pVertexBuffer;
 		ieIndexBuffer* m_pIndexBuffer;
@@ -46,7 +52,8 @@ namespace Insight {
 		CB_VS_PerObject	m_ConstantBufferPerObject = {};
 
 		bool			m_CastsShadows = true;
-		uint32_t		m_RTInstanceIndex = 0U;
-		bool			m_ShouldUpdateAS = false;
+		// Instance in the ray tracing acceleration structure, ~0u if the mesh has none.
+		uint32_t		m_RTInstanceIndex = ~0u;
+		TransformJournal::TransformId m_TransformId = TransformJournal::InvalidId;
 	};
 }
@@ -0,0 +1,135 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Mesh_Import_Cache.h"
+
+#include "Insight/Memory/Memory_Tracker.h"
+#include "Insight/Systems/Virtual_File_System.h"
+
+namespace Insight {
+
+	MeshImportCache MeshImportCache::s_Instance;
+
+	// The result of a prefetch. If it is destroyed without a result, Ex. the read was dropped without
+	// calling back, it completes as failed so Acquire never waits on it forever.
+	class PendingImport
+	{
+	public:
+		PendingImport() = default;
+		~PendingImport() { Complete(nullptr); }
+
+		inline std::shared_future<MeshImportCache::ImportResult> GetFuture() { return m_Promise.get_future().share(); }
+
+		void Complete(MeshImportCache::ImportResult Result)
+		{
+			if (m_IsComplete)
+				return;
+			m_IsComplete = true;
+			m_Promise.set_value(std::move(Result));
+		}
+
+	private:
+		std::promise<MeshImportCache::ImportResult> m_Promise;
+		bool m_IsComplete = false;
+	};
+
+	MeshImportCache::ImportResult MeshImportCache::Import(const std::string& Path, const FileView& Contents)
+	{
+		IE_MEMORY_TAG(Assets);
+		try
+		{
+			std::shared_ptr<ImportedModel> pImported = make_shared<ImportedModel>();
+			if (!MeshImporter::ImportFromFile(Path, Contents, *pImported))
+				return nullptr;
+			return pImported;
+		}
+		catch (const std::exception& Exception)
+		{
+			IE_DEBUG_LOG(LogSeverity::Error, "Failed to import model \"{0}\": {1}", Path, Exception.what());
+			return nullptr;
+		}
+	}
+
+	void MeshImportCache::Prefetch(const std::string& Path)
+	{
+		const StringId PathId = StringId::Intern(Path);
+		std::shared_ptr<PendingImport> pImport = std::make_shared<PendingImport>();
+		{
+			std::lock_guard<std::mutex> Lock(m_Mutex);
+			auto Iter = m_Imports.find(PathId);
+			if (Iter != m_Imports.end())
+			{
+				// Already being imported, possibly by an Acquire that would otherwise drop it.
+				Iter->second.IsKept = true;
+				return;
+			}
+			m_Imports.emplace(PathId, CacheEntry{ pImport->GetFuture(), true });
+		}
+
+		// The model file is read with the async I/O service and imported on the I/O worker the read finishes on.
+		// Queued outside the lock, the import runs before ReadAsync returns if AsyncIO is not running.
+		VirtualFileSystem::Get().ReadAsync(Path, AsyncIO::Priority::Normal, [Path, pImport](FileView Contents)
+			{
+				pImport->Complete(Import(Path, Contents));
+			});
+	}
+
+	MeshImportCache::ImportResult MeshImportCache::Acquire(const std::string& Path)
+	{
+		const StringId PathId = StringId::Intern(Path);
+		std::shared_future<ImportResult> Pending;
+		PendingImport OwnImport;
+		{
+			std::lock_guard<std::mutex> Lock(m_Mutex);
+			auto Iter = m_Imports.find(PathId);
+			if (Iter != m_Imports.end())
+				Pending = Iter->second.Import;
+			else
+				m_Imports.emplace(PathId, CacheEntry{ OwnImport.GetFuture(), false });
+		}
+
+		// Wait outside the lock so other models can acquire their imports in the meantime.
+		if (Pending.valid())
+			return Pending.get();
+
+		// Registered before importing, so a prefetch or acquire of the same path on another thread waits on this import instead of starting its own.
+		ImportResult Result = Import(Path, FileView());
+		OwnImport.Complete(Result);
+		{
+			std::lock_guard<std::mutex> Lock(m_Mutex);
+			auto Iter = m_Imports.find(PathId);
+			if (Iter != m_Imports.end() && !Iter->second.IsKept)
+				m_Imports.erase(Iter);
+		}
+		return Result;
+	}
+
+	void MeshImportCache::Release(const std::string& Path)
+	{
+		const StringId PathId = StringId::Intern(Path);
+		std::shared_future<ImportResult> Import;
+		{
+			std::lock_guard<std::mutex> Lock(m_Mutex);
+			auto Iter = m_Imports.find(PathId);
+			if (Iter == m_Imports.end())
+				return;
+
+			Import = std::move(Iter->second.Import);
+			m_Imports.erase(Iter);
+		}
+		Import.wait();
+	}
+
+	void MeshImportCache::Clear()
+	{
+		std::unordered_map<StringId, CacheEntry> Imports;
+		{
+			std::lock_guard<std::mutex> Lock(m_Mutex);
+			Imports.swap(m_Imports);
+		}
+
+		for (auto& Entry : Imports)
+			Entry.second.Import.wait();
+	}
+
+}
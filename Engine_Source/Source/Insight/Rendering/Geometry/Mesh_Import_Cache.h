@@ -0,0 +1,85 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Mesh_Import_Cache.h
+	Source - Mesh_Import_Cache.cpp
+
+	Purpose:
+	Runs model imports ahead of the models that need them, one import per file.
+
+	Description:
+	While a scene is loading the SceneLoader prefetches every model referenced by its actors.
+	Each unique path is read once with AsyncIO and imported on the I/O worker its read finishes on, so
+	many actors sharing a mesh share one Assimp import and one mesh is parsed while the next are read. Model::Create acquires the
+	prefetched result, waiting only if that import is still running. Paths that were not
+	prefetched (Ex. a mesh changed in the editor) are imported on the calling thread and not kept,
+	unless a prefetch of the same path arrives while that import runs. Either way a path is only ever
+	imported once at a time, later prefetches and acquires wait on the import already running.
+	Clear drops the CPU side copies once the scene has finished loading. The WorldStreamer prefetches
+	the meshes of each cell it streams in and releases them one by one with Release.
+
+	Example Usage:
+	MeshImportCache::Get().Prefetch("../Content/Models/Cube.fbx");
+	...
+	MeshImportCache::ImportResult Imported = MeshImportCache::Get().Acquire("../Content/Models/Cube.fbx");
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+#include "Insight/Rendering/Geometry/Mesh_Importer.h"
+#include "Insight/Utilities/String_Id.h"
+
+#include <future>
+#include <mutex>
+#include <unordered_map>
+
+namespace Insight {
+
+	class INSIGHT_API MeshImportCache
+	{
+	public:
+		// Shared between every model created from the same file. nullptr if the import failed.
+		typedef std::shared_ptr<const ImportedModel> ImportResult;
+
+	public:
+		MeshImportCache() = default;
+		~MeshImportCache() = default;
+
+		static MeshImportCache& Get() { return s_Instance; }
+
+		// Start reading and importing a model in the background. Does nothing if the path is already prefetched. Thread safe.
+		// @param Path - Exe relative path to the model file, the same path the model imports from.
+		void Prefetch(const std::string& Path);
+		// Returns the import for a path. Waits for the import if it is still running, or imports on
+		// the calling thread if the path was never prefetched. A prefetch whose read or import failed
+		// returns nullptr rather than blocking. Thread safe.
+		ImportResult Acquire(const std::string& Path);
+		// Release the prefetched import of one path, Ex. once a streamed world cell has created its models.
+		// Waits for the import if it is still running. Thread safe.
+		void Release(const std::string& Path);
+		// Release every prefetched import. Imports still running are waited on.
+		void Clear();
+
+		inline uint32_t GetNumPrefetched() { std::lock_guard<std::mutex> Lock(m_Mutex); return static_cast<uint32_t>(m_Imports.size()); }
+
+	private:
+		// @param Contents - The model file if it was already read, otherwise it is read by the importer.
+		static ImportResult Import(const std::string& Path, const FileView& Contents);
+
+	private:
+		struct CacheEntry
+		{
+			std::shared_future<ImportResult> Import;
+			// False for an import started by Acquire, it is dropped once done unless a prefetch asked for the path meanwhile.
+			bool IsKept;
+		};
+
+	private:
+		std::mutex m_Mutex;
+		// Keyed by the id of the import path.
+		std::unordered_map<StringId, CacheEntry> m_Imports;
+
+		static MeshImportCache s_Instance;
+	};
+
+}
@@ -0,0 +1,212 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Mesh_Importer.h"
+
+#if defined (IE_MESH_IMPORTER_ASSIMP)
+#include "Insight/Systems/Virtual_File_System.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#endif
+
+namespace Insight {
+
+	namespace MeshImporter {
+
+#if defined (IE_MESH_IMPORTER_ASSIMP)
+
+		// A file read through the VirtualFileSystem, so models and the files they reference (Ex. an .obj's .mtl) can be packed.
+		class VfsIOStream : public Assimp::IOStream
+		{
+		public:
+			explicit VfsIOStream(FileView View)
+				: m_View(std::move(View)) {}
+
+			size_t Read(void* pvBuffer, size_t pSize, size_t pCount) override
+			{
+				if (pSize == 0u)
+					return 0u;
+				const size_t Count = std::min(pCount, (m_View.GetSize() - m_Position) / pSize);
+				memcpy(pvBuffer, m_View.GetData() + m_Position, Count * pSize);
+				m_Position += Count * pSize;
+				return Count;
+			}
+			size_t Write(const void*, size_t, size_t) override { return 0u; }
+
+			aiReturn Seek(size_t pOffset, aiOrigin pOrigin) override
+			{
+				size_t Position = pOffset;
+				if (pOrigin == aiOrigin_CUR)
+					Position = m_Position + pOffset;
+				else if (pOrigin == aiOrigin_END)
+					Position = m_View.GetSize() - pOffset;
+				if (Position > m_View.GetSize())
+					return aiReturn_FAILURE;
+				m_Position = Position;
+				return aiReturn_SUCCESS;
+			}
+			size_t Tell() const override { return m_Position; }
+			size_t FileSize() const override { return m_View.GetSize(); }
+			void Flush() override {}
+
+		private:
+			FileView m_View;
+			size_t m_Position = 0u;
+		};
+
+		class VfsIOSystem : public Assimp::IOSystem
+		{
+		public:
+			// @param Prefetched - Contents of the file at PrefetchedPath, if they were read ahead of the import.
+			VfsIOSystem(const std::string& PrefetchedPath, FileView Prefetched)
+				: m_PrefetchedPath(PrefetchedPath), m_Prefetched(std::move(Prefetched)) {}
+
+			bool Exists(const char* pFile) const override { return IsPrefetched(pFile) || VirtualFileSystem::Get().Exists(pFile); }
+			char getOsSeparator() const override { return '/'; }
+
+			Assimp::IOStream* Open(const char* pFile, const char* pMode) override
+			{
+				// Models are only ever read.
+				if (strchr(pMode, 'w') || strchr(pMode, 'a') || strchr(pMode, '+'))
+					return nullptr;
+				FileView View = IsPrefetched(pFile) ? m_Prefetched : VirtualFileSystem::Get().Read(pFile);
+				return View ? new VfsIOStream(std::move(View)) : nullptr;
+			}
+			void Close(Assimp::IOStream* pFile) override { delete pFile; }
+
+		private:
+			inline bool IsPrefetched(const char* pFile) const { return m_Prefetched && m_PrefetchedPath == pFile; }
+
+		private:
+			std::string m_PrefetchedPath;
+			FileView m_Prefetched;
+		};
+
+		static Math::Simd::Matrix LoadAssimpMatrix(const aiMatrix4x4& Matrix)
+		{
+			using namespace Math;
+			return Simd::Matrix{ { Simd::LoadFloat4(&Matrix.a1), Simd::LoadFloat4(&Matrix.b1), Simd::LoadFloat4(&Matrix.c1), Simd::LoadFloat4(&Matrix.d1) } };
+		}
+
+		static void ProcessMesh(const aiMesh* pMesh, ImportedMesh& OutMesh)
+		{
+			Verticies& MeshVerticies = OutMesh.MeshVerticies;
+			MeshVerticies.reserve(pMesh->mNumVertices);
+
+			// Load Verticies
+			for (uint32_t i = 0; i < pMesh->mNumVertices; i++)
+			{
+				Vertex3D Vertex;
+
+				// Position
+				Vertex.Position.x = pMesh->mVertices[i].x;
+				Vertex.Position.y = pMesh->mVertices[i].y;
+				Vertex.Position.z = pMesh->mVertices[i].z;
+
+				// Normals
+				Vertex.Normal.x = (float)pMesh->mNormals[i].x;
+				Vertex.Normal.y = (float)pMesh->mNormals[i].y;
+				Vertex.Normal.z = (float)pMesh->mNormals[i].z;
+
+				// Texture Coords/Tangents
+				if (pMesh->mTextureCoords[0])
+				{
+					Vertex.TexCoords.x = (float)pMesh->mTextureCoords[0][i].x;
+					Vertex.TexCoords.y = (float)pMesh->mTextureCoords[0][i].y;
+
+					Vertex.Tangent.x = pMesh->mTangents[i].x;
+					Vertex.Tangent.y = pMesh->mTangents[i].y;
+					Vertex.Tangent.z = pMesh->mTangents[i].z;
+
+					Vertex.BiTangent.x = pMesh->mBitangents[i].x;
+					Vertex.BiTangent.y = pMesh->mBitangents[i].y;
+					Vertex.BiTangent.z = pMesh->mBitangents[i].z;
+				}
+				else
+				{
+					Vertex.TexCoords = ieFloat2(0.0f, 0.0f);
+					Vertex.Tangent = ieFloat3(0.0f, 0.0f, 0.0f);
+					Vertex.BiTangent = ieFloat3(0.0f, 0.0f, 0.0f);
+				}
+
+				MeshVerticies.push_back(Vertex);
+			}
+
+			// Load Indices
+			Indices& MeshIndices = OutMesh.MeshIndices;
+			MeshIndices.reserve(pMesh->mNumFaces * 3u);
+			for (uint32_t i = 0; i < pMesh->mNumFaces; i++)
+			{
+				const aiFace& Face = pMesh->mFaces[i];
+				for (uint32_t j = 0; j < Face.mNumIndices; j++)
+				{
+					MeshIndices.push_back(Face.mIndices[j]);
+				}
+			}
+		}
+
+		static void ParseNode_r(const aiNode* pNode, int32_t ParentIndex, std::vector<ImportedMeshNode>& OutNodes)
+		{
+			const int32_t NodeIndex = static_cast<int32_t>(OutNodes.size());
+			OutNodes.push_back({});
+			ImportedMeshNode& Node = OutNodes.back();
+
+			Node.Name = pNode->mName.C_Str();
+			Node.ParentIndex = ParentIndex;
+			Node.Transform = Math::Simd::MatrixIdentity();
+			if (pNode->mParent) {
+				Node.Transform = Math::Simd::MatrixMultiply(LoadAssimpMatrix(pNode->mTransformation), LoadAssimpMatrix(pNode->mParent->mTransformation));
+			}
+			Node.MeshIndices.assign(pNode->mMeshes, pNode->mMeshes + pNode->mNumMeshes);
+
+			// Node is invalidated once the children are pushed.
+			for (uint32_t i = 0; i < pNode->mNumChildren; ++i) {
+				ParseNode_r(pNode->mChildren[i], NodeIndex, OutNodes);
+			}
+		}
+
+		bool ImportFromFile(const std::string& Path, const FileView& Contents, ImportedModel& OutModel)
+		{
+			Assimp::Importer Importer;
+			// The importer takes ownership of the IO system.
+			Importer.SetIOHandler(new VfsIOSystem(Path, Contents));
+			const aiScene* pScene = Importer.ReadFile(
+				Path,
+				aiProcess_ImproveCacheLocality | aiProcessPreset_TargetRealtime_Fast | aiProcess_ConvertToLeftHanded
+			);
+
+			if (!pScene || pScene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !pScene->mRootNode) {
+				IE_DEBUG_LOG(LogSeverity::Error, "Assimp import error: {0}", Importer.GetErrorString());
+				return false;
+			}
+
+			OutModel.Meshes.resize(pScene->mNumMeshes);
+			for (uint32_t i = 0; i < pScene->mNumMeshes; ++i) {
+				ProcessMesh(pScene->mMeshes[i], OutModel.Meshes[i]);
+			}
+
+			ParseNode_r(pScene->mRootNode, -1, OutModel.Nodes);
+			return true;
+		}
+
+#else
+
+		bool ImportFromFile(const std::string& Path, const FileView& Contents, ImportedModel& OutModel)
+		{
+			IE_DEBUG_LOG(LogSeverity::Error, "No mesh importer available on this platform to load: \"{0}\"", Path);
+			return false;
+		}
+
+#endif // IE_MESH_IMPORTER_ASSIMP
+
+		bool ImportFromFile(const std::string& Path, ImportedModel& OutModel)
+		{
+			return ImportFromFile(Path, FileView(), OutModel);
+		}
+
+	} // end namespace MeshImporter
+}
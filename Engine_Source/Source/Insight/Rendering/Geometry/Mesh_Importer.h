@@ -0,0 +1,71 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Mesh_Importer.h
+	Source - Mesh_Importer.cpp
+
+	Purpose:
+	Reads model files from disk into CPU side vertex, index and node data.
+
+	Description:
+	Importing does not touch the renderer, the Model creates its GPU meshes from the result.
+	This keeps the expensive part of loading a model (Assimp parsing and post processing)
+	independent of the graphics API so it can run on any thread and be measured on its own.
+	Assimp is used on every platform except UWP, which loads FBX files with OpenFBX in Model.cpp.
+
+	Example Usage:
+	ImportedModel Model;
+	if (MeshImporter::ImportFromFile("../Content/Models/Cube.fbx", Model)) { ... }
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+#include "Insight/Math/Simd_Math.h"
+#include "Insight/Rendering/Geometry/Vertex_Buffer.h"
+#include "Insight/Rendering/Geometry/Index_Buffer.h"
+#include "Insight/Systems/Mapped_File.h"
+
+#if !defined (IE_PLATFORM_BUILD_UWP)
+	#define IE_MESH_IMPORTER_ASSIMP
+#endif
+
+namespace Insight {
+
+	struct ImportedMesh
+	{
+		Verticies	MeshVerticies;
+		Indices		MeshIndices;
+	};
+
+	struct ImportedMeshNode
+	{
+		std::string Name;
+		Math::Simd::Matrix Transform;
+		// Index of the parent node in ImportedModel::Nodes. -1 for the root.
+		int32_t ParentIndex;
+		// Indices into ImportedModel::Meshes.
+		std::vector<uint32_t> MeshIndices;
+	};
+
+	struct ImportedModel
+	{
+		std::vector<ImportedMesh> Meshes;
+		// Depth first, parents always come before their children. Nodes[0] is the root.
+		std::vector<ImportedMeshNode> Nodes;
+	};
+
+	namespace MeshImporter {
+
+		/*
+			Import every mesh and node in a model file.
+			@param Path - Exe relative path to the model file.
+			@param OutModel - Populated with the model's meshes and node hierarchy.
+			Returns false if the file could not be read or the platform has no importer.
+		*/
+		INSIGHT_API bool ImportFromFile(const std::string& Path, ImportedModel& OutModel);
+		// Import a model file whose contents were already read, Ex. with VirtualFileSystem::ReadAsync.
+		// Files the model references are still read from Path's folder. Contents may be invalid, then Path is read.
+		INSIGHT_API bool ImportFromFile(const std::string& Path, const FileView& Contents, ImportedModel& OutModel);
+
+	} // end namespace MeshImporter
+}
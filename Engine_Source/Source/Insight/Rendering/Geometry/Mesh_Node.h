@@ -7,8 +7,8 @@ namespace Insight {
 	class INSIGHT_API MeshNode
 	{
 	public:
-		MeshNode(std::vector<Mesh*> meshChildren, ieTransform transform, std::string displayName = "Default Mesh Node")
-			: m_MeshChildren(meshChildren), m_Transform(transform), m_DisplayName(displayName) {}
+		MeshNode(Mesh* const* ppMeshChildren, uint32_t NumMeshChildren, ieTransform transform, std::string displayName = "Default Mesh Node")
+			: m_MeshChildren(ppMeshChildren, ppMeshChildren + NumMeshChildren), m_Transform(transform), m_DisplayName(displayName) {}
 		~MeshNode() {}
 
 		void PreRender(XMMATRIX& parentMat, UINT32& gpuAddressOffset);
@@ -1,8 +1,13 @@
 #include <Engine_pch.h>
 
 #include "Model.h"
+#include "Mesh_Import_Cache.h"
 #include "Insight/Utilities/String_Helper.h"
 #include "Insight/Rendering/Material.h"
+#include "Insight/Memory/Scratch_Allocator.h"
+#include "Insight/Memory/Memory_Tracker.h"
+#include "Insight/Math/Batch_Math.h"
+#include "Insight/Systems/Managers/Geometry_Manager.h"
 
 #include "Insight/UI/UI_Lib.h"
 
@@ -47,16 +52,22 @@ namespace Insight {
 
 	bool Model::Create(const std::string& path, Material* pMaterial)
 	{
+		IE_MEMORY_TAG(Assets);
 		m_pMaterial = pMaterial;
 
 		m_AssetDirectoryRelativePath = path;
-		m_Directory = StringHelper::WideToString(FileSystem::GetRelativeContentDirectoryW(StringHelper::StringToWide(path)));
+		m_Directory = GetImportPath(path);
 		m_FileName = StringHelper::GetFilenameFromDirectory(m_Directory);
 		SceneNode::SetDisplayName("Static Mesh");
 
 		return LoadModelFromFile(m_Directory);
 	}
 
+	std::string Model::GetImportPath(const std::string& ContentPath)
+	{
+		return StringHelper::WideToString(FileSystem::GetRelativeContentDirectoryW(StringHelper::StringToWide(ContentPath)));
+	}
+
 	void Model::OnImGuiRender()
 	{
 		UI::Text("Asset: ");
@@ -94,12 +105,37 @@ namespace Insight {
 
 	void Model::CalculateParent(const ieMatrix4x4& parentMat)
 	{
-		auto worldMat = XMMatrixMultiply(m_pRoot->GetTransformRef().GetLocalMatrixRef(), parentMat);
-		for (unique_ptr<Mesh>& mesh : m_Meshes) {
-			mesh->PreRender(worldMat);
+		std::lock_guard<std::mutex> Lock(m_MeshesMutex);
+		m_ParentWorldMatrix = Math::FromPlatformMatrix(parentMat);
+		UpdateMeshWorldMatrices(m_ParentWorldMatrix);
+	}
+
+	void Model::UpdateMeshWorldMatrices(const Math::Simd::Matrix& ParentWorld)
+	{
+		const Math::Simd::Matrix RootWorld = Math::Simd::MatrixMultiply(m_pRoot->GetTransform().GetLocalSimdMatrix(), ParentWorld);
+
+		// Every mesh world matrix is RootWorld * Local, multiply them all in one batch.
+		const size_t NumMeshes = m_Meshes.size();
+		Memory::ScratchScope Scratch;
+		Math::Simd::Matrix* pLocals = Scratch.AllocateArray<Math::Simd::Matrix>(NumMeshes);
+		for (size_t i = 0; i < NumMeshes; ++i) {
+			pLocals[i] = m_Meshes[i]->GetTransform().GetLocalSimdMatrix();
+		}
+		Math::BatchMath::MultiplyMatrices(&RootWorld, 0u, pLocals, 1u, pLocals, NumMeshes);
+
+		for (size_t i = 0; i < NumMeshes; ++i) {
+			m_Meshes[i]->PreRender(pLocals[i]);
 		}
 	}
 
+	void Model::SetCanBeRendered(bool Enabled)
+	{
+		// Hidden models are skipped when constant buffer slots are handed out.
+		if (m_Visible != Enabled)
+			GeometryManager::MarkLayoutDirty();
+		m_Visible = Enabled;
+	}
+
 	void Model::Render()
 	{
 		int numMeshChildren = (int)m_Meshes.size();
@@ -111,37 +147,30 @@ namespace Insight {
 	bool Model::LoadModelFromFile(const std::string& path)
 	{
 #if defined (IE_PLATFORM_BUILD_WIN32)
-		Assimp::Importer Importer;
-		const aiScene* pScene = Importer.ReadFile(
-			path,
-			aiProcess_ImproveCacheLocality | aiProcessPreset_TargetRealtime_Fast | aiProcess_ConvertToLeftHanded
-		);
-
-		if (!pScene || pScene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !pScene->mRootNode) {
-			IE_DEBUG_LOG(LogSeverity::Error, "Assimp import error: {0}", Importer.GetErrorString());
+		// Scene loading prefetches its models, only wait for the import here if it is still running.
+		MeshImportCache::ImportResult Imported = MeshImportCache::Get().Acquire(path);
+		if (!Imported) {
 			return false;
 		}
 
-		for (size_t i = 0; i < pScene->mNumMeshes; ++i) {
-			m_Meshes.push_back(
-				std::move(AssimpProcessMesh(pScene->mMeshes[i], pScene))
-			);
+		m_Meshes.reserve(Imported->Meshes.size());
+		for (const ImportedMesh& MeshData : Imported->Meshes) {
+			m_Meshes.push_back(std::make_unique<Mesh>(MeshData.MeshVerticies, MeshData.MeshIndices));
 		}
 
-		m_pRoot = AssimpParseNode_r(pScene->mRootNode);
+		m_pRoot = CreateMeshNodes(*Imported);
 
 #elif defined (IE_PLATFORM_BUILD_UWP)
 
 		std::string FileExtension = StringHelper::GetFileExtension(path);
 		if (FileExtension == "FBX" || FileExtension == "fbx")
 		{
-			size_t FileSize;
-			char* FileContents = FileSystem::ReadRawData(path.c_str(), FileSize);
+			FileView FileContents = FileSystem::ReadFile(path);
 			if (!FileContents) 
 				return false;
 			ofbx::IScene* pScene = ofbx::load(
-				(const ofbx::u8*)FileContents, 
-				(int)FileSize, 
+				(const ofbx::u8*)FileContents.GetData(), 
+				(int)FileContents.GetSize(), 
 				(ofbx::u64)ofbx::LoadFlags::TRIANGULATE
 			);
 			const ofbx::GlobalSettings* s = pScene->getGlobalSettings();
@@ -163,11 +192,9 @@ namespace Insight {
 				//m_pRoot = OFBXParseNode_r(pScene->getRoot());
 				ieTransform Transform;
 				Transform.SetWorldMatrix(XMMATRIX((float*)&pScene->getRoot()->getGlobalTransform().m[0]));
-				std::vector<Mesh*> CurMeshPtrs;
-				CurMeshPtrs.push_back(m_Meshes[0].get());
-				m_pRoot = std::make_unique<MeshNode>(CurMeshPtrs, Transform, pScene->getRoot()->name);
+				Mesh* pRootMesh = m_Meshes[0].get();
+				m_pRoot = std::make_unique<MeshNode>(&pRootMesh, 1u, Transform, pScene->getRoot()->name);
 			}
-			delete[] FileContents;
 		}
 		else 
 		{
@@ -180,89 +207,73 @@ namespace Insight {
 
 #if defined (IE_PLATFORM_BUILD_WIN32)
 
-	unique_ptr<MeshNode> Model::AssimpParseNode_r(::aiNode* pNode)
+	void Model::Reload(const ImportedModel& Imported)
 	{
-		ieTransform transform;
-		if (pNode->mParent) {
-			XMMATRIX mat = XMMatrixMultiply(XMMATRIX(&pNode->mTransformation.a1), XMMATRIX(&pNode->mParent->mTransformation.a1));
-			transform.SetWorldMatrix(mat);
-		}
-
-		// Create a pointer to all the meshes this node owns
-		std::vector<Mesh*> curMeshPtrs;
-		curMeshPtrs.reserve(pNode->mNumMeshes);
-		for (UINT i = 0; i < pNode->mNumMeshes; i++) {
-			const auto meshIndex = pNode->mMeshes[i];
-			curMeshPtrs.push_back(m_Meshes.at(meshIndex).get());
+		IE_MEMORY_TAG(Assets);
+		// Build the new meshes aside, the game thread keeps moving the old ones meanwhile.
+		std::vector<std::unique_ptr<Mesh>> Meshes;
+		Meshes.reserve(Imported.Meshes.size());
+		for (const ImportedMesh& MeshData : Imported.Meshes) {
+			Meshes.push_back(std::make_unique<Mesh>(MeshData.MeshVerticies, MeshData.MeshIndices));
 		}
-
-		auto pMeshNode = std::make_unique<MeshNode>(curMeshPtrs, transform, pNode->mName.C_Str());
-		for (UINT i = 0; i < pNode->mNumChildren; ++i) {
-			pMeshNode->AddChild(AssimpParseNode_r(pNode->mChildren[i]));
+		std::unique_ptr<MeshNode> pOldRoot;
+		{
+			std::lock_guard<std::mutex> Lock(m_MeshesMutex);
+			m_Meshes.swap(Meshes);
+			pOldRoot = std::move(m_pRoot);
+			m_pRoot = CreateMeshNodes(Imported);
+
+			// The root transform is placed by the owning component and saved with the scene.
+			if (m_pRoot && pOldRoot)
+				m_pRoot->GetTransformRef() = pOldRoot->GetTransform();
+
+			// Nothing else moves the new meshes until the owning actor moves again.
+			if (m_pRoot)
+				UpdateMeshWorldMatrices(m_ParentWorldMatrix);
 		}
+		// Meshes now holds the replaced meshes.
+		pOldRoot.reset();
+		Meshes.clear();
 
-		return pMeshNode;
+		// The model may be registered, its meshes' constant buffer slots changed.
+		GeometryManager::MarkLayoutDirty();
 	}
 
-	unique_ptr<Mesh> Model::AssimpProcessMesh(::aiMesh* pMesh, const ::aiScene* pScene)
+	unique_ptr<MeshNode> Model::CreateMeshNodes(const ImportedModel& Imported)
 	{
-		std::vector<Vertex3D> Verticies; Verticies.reserve(pMesh->mNumVertices);
-		std::vector<DWORD> Indices;
-
-		// Load Verticies
-		for (uint32_t i = 0; i < pMesh->mNumVertices; i++)
+		// Nodes are stored parents first, so every parent exists by the time its children are attached.
+		std::vector<MeshNode*> CreatedNodes(Imported.Nodes.size(), nullptr);
+		unique_ptr<MeshNode> pRoot;
+		for (size_t n = 0; n < Imported.Nodes.size(); ++n)
 		{
-			Vertex3D Vertex;
-
-			// Position
-			Vertex.Position.x = pMesh->mVertices[i].x;
-			Vertex.Position.y = pMesh->mVertices[i].y;
-			Vertex.Position.z = pMesh->mVertices[i].z;
-
-			// Normals
-			Vertex.Normal.x = (float)pMesh->mNormals[i].x;
-			Vertex.Normal.y = (float)pMesh->mNormals[i].y;
-			Vertex.Normal.z = (float)pMesh->mNormals[i].z;
+			const ImportedMeshNode& Node = Imported.Nodes[n];
 
+			ieTransform transform;
+			transform.SetWorldSimdMatrix(Node.Transform);
 
-			// Texture Coords/Tangents
-			if (pMesh->mTextureCoords[0])
+			// Create a pointer to all the meshes this node owns
+			unique_ptr<MeshNode> pMeshNode;
 			{
-				Vertex.TexCoords.x = (float)pMesh->mTextureCoords[0][i].x;
-				Vertex.TexCoords.y = (float)pMesh->mTextureCoords[0][i].y;
-
-				Vertex.Tangent.x = pMesh->mTangents[i].x;
-				Vertex.Tangent.y = pMesh->mTangents[i].y;
-				Vertex.Tangent.z = pMesh->mTangents[i].z;
+				const uint32_t NumNodeMeshes = static_cast<uint32_t>(Node.MeshIndices.size());
+				Memory::ScratchScope Scratch;
+				Mesh** ppCurMeshes = Scratch.AllocateArray<Mesh*>(NumNodeMeshes);
+				for (uint32_t i = 0; i < NumNodeMeshes; i++) {
+					ppCurMeshes[i] = m_Meshes.at(Node.MeshIndices[i]).get();
+				}
 
-				Vertex.BiTangent.x = pMesh->mBitangents[i].x;
-				Vertex.BiTangent.y = pMesh->mBitangents[i].y;
-				Vertex.BiTangent.z = pMesh->mBitangents[i].z;
-			}
-			else
-			{
-				Vertex.TexCoords = ieFloat2(0.0f, 0.0f);
-				Vertex.Tangent = ieFloat3(0.0f, 0.0f, 0.0f);
-				Vertex.BiTangent = ieFloat3(0.0f, 0.0f, 0.0f);
+				pMeshNode = std::make_unique<MeshNode>(ppCurMeshes, NumNodeMeshes, transform, Node.Name);
 			}
+			CreatedNodes[n] = pMeshNode.get();
 
-			Verticies.push_back(Vertex);
+			if (Node.ParentIndex < 0)
+				pRoot = std::move(pMeshNode);
+			else
+				CreatedNodes[Node.ParentIndex]->AddChild(std::move(pMeshNode));
 		}
 
-		// Load Indices
-		for (uint32_t i = 0; i < pMesh->mNumFaces; i++)
-		{
-			aiFace Face = pMesh->mFaces[i];
-
-			for (uint32_t j = 0; j < Face.mNumIndices; j++)
-			{
-				Indices.push_back(Face.mIndices[j]);
-		}
+		return pRoot;
 	}
 
-		return std::make_unique<Mesh>(Verticies, Indices);
-}
-
 #elif defined (IE_PLATFORM_BUILD_UWP)
 
 	std::unique_ptr<Mesh> Model::OFBXProcessMesh(const ofbx::Mesh& FBXMesh)
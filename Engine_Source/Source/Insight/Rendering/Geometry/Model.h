@@ -4,12 +4,9 @@
 
 #include "Insight/Core/Scene/Scene_Node.h"
 #include "Insight/Rendering/Geometry/Mesh_Node.h"
+#include "Insight/Rendering/Geometry/Mesh_Importer.h"
 
-#if defined (IE_PLATFORM_BUILD_WIN32)
-#include <assimp/Importer.hpp>
-#include <assimp/postprocess.h>
-#include <assimp/scene.h>
-#elif defined (IE_PLATFORM_BUILD_UWP)
+#if defined (IE_PLATFORM_BUILD_UWP)
 #include "ofbx.h"
 //#define TINYOBJLOADER_IMPLEMENTATION
 //#include <tinyobjloader/tiny_obj_loader.h>
@@ -29,6 +26,8 @@ namespace Insight {
 		~Model();
 
 		bool Create(const std::string& path, Material* pMaterial);
+		// Returns the exe relative path a model is imported from, given its content directory relative path.
+		static std::string GetImportPath(const std::string& ContentPath);
 		void OnImGuiRender();
 		void RenderSceneHeirarchy();
 		void BindResources(bool IsDeferredPass);
@@ -41,31 +40,43 @@ namespace Insight {
 
 		// Visibility
 		bool GetCanBeRendered() { return m_Visible; }
-		bool SetCanBeRendered(bool Enabled) { m_Visible = Enabled; }
+		void SetCanBeRendered(bool Enabled);
 		bool GetCanCastShadows() { return m_CastsShadows; }
 		bool SetCanCastShadows(bool Enabled) { m_CastsShadows = Enabled; }
 
 		std::unique_ptr<Mesh>& GetMeshAtIndex(int index) { return m_Meshes[index]; }
 		const size_t GetNumChildMeshes() const { return m_Meshes.size(); }
 
+#if defined (IE_PLATFORM_BUILD_WIN32)
+		// Replace the model's meshes with a new import of its file, keeping the root transform and placing the new meshes under the last parent matrix.
+		// Call from the render thread before the frame is recorded, once the GPU is done with the frames in flight.
+		void Reload(const ImportedModel& Imported);
+#endif
+
 		void CalculateParent(const ieMatrix4x4& parentMat);
 		void Render();
 		void Destroy();
 
 	private:
 		bool LoadModelFromFile(const std::string& path);
+		// Recompute every mesh's world matrix under ParentWorld. m_MeshesMutex must be held.
+		void UpdateMeshWorldMatrices(const Math::Simd::Matrix& ParentWorld);
 		
 #if defined (IE_PLATFORM_BUILD_WIN32)
-		std::unique_ptr<MeshNode> AssimpParseNode_r(aiNode* pNode);
-		std::unique_ptr<Mesh> AssimpProcessMesh(aiMesh* pMesh, const aiScene* pScene);
+		// Create the mesh node hierarchy for an imported model. Meshes must already be created.
+		std::unique_ptr<MeshNode> CreateMeshNodes(const ImportedModel& Imported);
 #elif defined (IE_PLATFORM_BUILD_UWP)
 		std::unique_ptr<Mesh> OFBXProcessMesh(const ofbx::Mesh& FBXMesh);
 		//std::unique_ptr<Mesh> TinyOBJProcessMesh();
 #endif
 
 	private:
+		// Held by the game thread while it moves the meshes and by Reload while it replaces them.
+		std::mutex m_MeshesMutex;
 		std::vector<std::unique_ptr<Mesh>> m_Meshes;
 		std::unique_ptr<MeshNode> m_pRoot;
+		// The matrix last passed to CalculateParent, Reload places the new meshes under it.
+		Math::Simd::Matrix m_ParentWorldMatrix = Math::Simd::MatrixIdentity();
 		
 		Material* m_pMaterial = nullptr;
 
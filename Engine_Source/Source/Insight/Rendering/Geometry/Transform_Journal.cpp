@@ -0,0 +1,86 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Transform_Journal.h"
+
+#include "Insight/Memory/Frame_Arena.h"
+
+namespace Insight {
+
+	TransformJournal TransformJournal::s_Instance;
+
+	TransformJournal::TransformId TransformJournal::Register()
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+
+		if (!m_FreeIds.empty())
+		{
+			const TransformId Id = m_FreeIds.back();
+			m_FreeIds.pop_back();
+			return Id;
+		}
+		m_EntryOfId.push_back(InvalidId);
+		return m_IdCapacity++;
+	}
+
+	void TransformJournal::Unregister(TransformId Id)
+	{
+		if (Id == InvalidId)
+			return;
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+
+		const uint32_t Entry = m_EntryOfId[Id];
+		if (Entry != InvalidId)
+		{
+			m_Recording.Ids[Entry] = InvalidId;
+			m_EntryOfId[Id] = InvalidId;
+		}
+		m_PendingFreeIds.push_back(Id);
+	}
+
+	void TransformJournal::Record(TransformId Id, const ieMatrix4x4& WorldMatrix)
+	{
+		if (Id == InvalidId)
+			return;
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+
+		uint32_t& Entry = m_EntryOfId[Id];
+		if (Entry != InvalidId)
+		{
+			m_Recording.WorldMatrices[Entry] = WorldMatrix;
+			return;
+		}
+		Entry = static_cast<uint32_t>(m_Recording.Ids.size());
+		m_Recording.Ids.push_back(Id);
+		m_Recording.WorldMatrices.push_back(WorldMatrix);
+	}
+
+	void TransformJournal::BeginFrame()
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+
+		// The previous published frame is done with, so are the ids unregistered while it was being read.
+		m_FreeIds.insert(m_FreeIds.end(), m_PendingFreeIds.begin(), m_PendingFreeIds.end());
+		m_PendingFreeIds.clear();
+
+		// The arena keeps this frame's lists alive until the end of the next render frame, past the next BeginFrame.
+		Memory::FrameArena& Arena = Memory::GetRenderFrameArena();
+		m_NumPublished = static_cast<uint32_t>(m_Recording.Ids.size());
+		TransformId* pIds = Arena.AllocateArray<TransformId>(m_NumPublished);
+		ieMatrix4x4* pWorldMatrices = Arena.AllocateArray<ieMatrix4x4>(m_NumPublished);
+		for (uint32_t i = 0; i < m_NumPublished; ++i)
+		{
+			const TransformId Id = m_Recording.Ids[i];
+			if (Id != InvalidId)
+				m_EntryOfId[Id] = InvalidId;
+			pIds[i] = Id;
+			pWorldMatrices[i] = m_Recording.WorldMatrices[i];
+		}
+		m_pPublishedIds = pIds;
+		m_pPublishedWorldMatrices = pWorldMatrices;
+
+		m_Recording.Ids.clear();
+		m_Recording.WorldMatrices.clear();
+	}
+
+}
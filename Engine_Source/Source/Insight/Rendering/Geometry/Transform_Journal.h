@@ -0,0 +1,109 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Transform_Journal.h
+	Source - Transform_Journal.cpp
+
+	Purpose:
+	Records which renderable transforms changed each frame, so the renderer only updates what moved.
+
+	Description:
+	Every mesh gets a TransformId when it is created. Whenever its world matrix is recomputed the new
+	matrix is recorded against that id. A transform that changes several times in a frame has one
+	entry holding its latest matrix.
+
+	Changes are recorded from the game thread (Ex. ticks moving actors) and the render thread (Ex. the
+	editor gizmo). BeginFrame is called by the render thread at the start of each of its frames, right
+	after the render frame arena is reset. It copies what was recorded since the previous call into the
+	render frame arena as a compact list of ids and a parallel list of world matrices, which stays
+	unchanged until the next BeginFrame. The recording lists keep their capacity, so recording and
+	publishing do not touch the heap once the engine has warmed up. Consumers read the published lists
+	on the render thread and keep their own tables indexed by TransformId, Ex.:
+	- The per-object constant buffer upload only rewrites the slots of meshes that moved.
+	- The ray tracing top level acceleration structure is only refit when one of its instances moved.
+
+	An id is not reused until the frame after it was unregistered, so a published entry never refers to a
+	different transform than the one that recorded it.
+
+	BeginFrame runs every render frame, even ones where the renderer skips its work (Ex. the window is
+	minimized), because the render frame arena it publishes into is reset every frame. The changes of a
+	skipped frame are never read again, so a consumer that skips frames rebuilds its table from the
+	meshes themselves before reading the journal again. See Direct3D12Context::ResyncTransformsAfterSkippedFrames.
+
+	Example Usage:
+	m_TransformId = TransformJournal::Get().Register();
+	TransformJournal::Get().Record(m_TransformId, WorldMatrix);
+	...
+	const TransformJournal& Journal = TransformJournal::Get();
+	for (uint32_t i = 0; i < Journal.GetNumChanged(); ++i) { Update(Journal.GetChangedIds()[i], Journal.GetChangedWorldMatrices()[i]); }
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+#include "Insight/Math/Transform.h"
+
+#include <mutex>
+
+namespace Insight {
+
+	class INSIGHT_API TransformJournal
+	{
+	public:
+		typedef uint32_t TransformId;
+		static constexpr TransformId InvalidId = ~0u;
+
+	public:
+		TransformJournal() = default;
+		~TransformJournal() = default;
+
+		TransformJournal(const TransformJournal&) = delete;
+		TransformJournal& operator = (const TransformJournal&) = delete;
+
+		static TransformJournal& Get() { return s_Instance; }
+
+		// Get an id for a new transform.
+		TransformId Register();
+		// Release an id. Changes it recorded that have not been published are dropped.
+		void Unregister(TransformId Id);
+
+		// Record the new world matrix of a transform. Safe to call from any thread.
+		void Record(TransformId Id, const ieMatrix4x4& WorldMatrix);
+
+		// Publish the changes recorded since the last call. Called by the render thread at the start of its frame, after the render frame arena is reset.
+		void BeginFrame();
+
+		// Number of transforms that changed in the published frame.
+		inline uint32_t GetNumChanged() const { return m_NumPublished; }
+		inline bool HasChanges() const { return m_NumPublished > 0u; }
+		// Ids of the transforms that changed in the published frame. Entries dropped by Unregister are InvalidId.
+		inline const TransformId* GetChangedIds() const { return m_pPublishedIds; }
+		// World matrix of each changed transform, parallel to GetChangedIds.
+		inline const ieMatrix4x4* GetChangedWorldMatrices() const { return m_pPublishedWorldMatrices; }
+		// One past the largest id handed out, for sizing tables indexed by TransformId.
+		inline uint32_t GetIdCapacity() const { return m_IdCapacity; }
+
+	private:
+		struct ChangeList
+		{
+			std::vector<TransformId> Ids;
+			std::vector<ieMatrix4x4> WorldMatrices;
+		};
+
+	private:
+		std::mutex m_Mutex;
+		ChangeList m_Recording;
+		// Copy of the last published m_Recording, allocated from the render frame arena.
+		const TransformId* m_pPublishedIds = nullptr;
+		const ieMatrix4x4* m_pPublishedWorldMatrices = nullptr;
+		uint32_t m_NumPublished = 0u;
+		// Position of each id's entry in m_Recording, InvalidId if it has none.
+		std::vector<uint32_t> m_EntryOfId;
+		std::vector<TransformId> m_FreeIds;
+		// Ids unregistered since the last BeginFrame, free once the frame that may reference them is gone.
+		std::vector<TransformId> m_PendingFreeIds;
+		uint32_t m_IdCapacity = 0u;
+
+		static TransformJournal s_Instance;
+	};
+
+}
@@ -105,6 +105,8 @@ namespace Insight {
 			Writer->Key("DisplayName");
 			Writer->String(SceneNode::GetDisplayName());
 
+			WriteGuidToJson(*Writer);
+
 			// Directional Light Attributes
 			Writer->Key("Emission");
 			Writer->StartArray();
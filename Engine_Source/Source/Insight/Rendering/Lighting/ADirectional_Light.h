@@ -9,6 +9,7 @@ namespace Insight {
 
 	class INSIGHT_API ADirectionalLight : public Runtime::AActor
 	{
+		IE_DECLARE_POOLED_CLASS(ADirectionalLight)
 	public:
 		ADirectionalLight(ActorId id, Runtime::ActorType type = "Directional Light Actor");
 		virtual ~ADirectionalLight();
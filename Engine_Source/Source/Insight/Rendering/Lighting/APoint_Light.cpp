@@ -53,6 +53,8 @@ namespace Insight {
 			Writer->Key("DisplayName");
 			Writer->String(SceneNode::GetDisplayName());
 
+			WriteGuidToJson(*Writer);
+
 			Writer->Key("Subobjects");
 			Writer->StartArray(); // Start Write SubObjects
 			{
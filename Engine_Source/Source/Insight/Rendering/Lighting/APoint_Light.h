@@ -13,6 +13,7 @@ namespace Insight {
 
 	class INSIGHT_API APointLight : public Runtime::AActor
 	{
+		IE_DECLARE_POOLED_CLASS(APointLight)
 	public:
 		APointLight(ActorId id, Runtime::ActorType type = "Point Light Actor");
 		virtual ~APointLight();
@@ -9,6 +9,7 @@ namespace Insight {
 
 	class INSIGHT_API ASpotLight : public Runtime::AActor
 	{
+		IE_DECLARE_POOLED_CLASS(ASpotLight)
 	public:
 		ASpotLight(ActorId id, Runtime::ActorType type = "Spot Light Actor");
 		virtual ~ASpotLight();
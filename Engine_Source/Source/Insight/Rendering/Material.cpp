@@ -31,19 +31,19 @@ namespace Insight {
 		// to give us the proper texture once it is loaded.
 		{
 			if (m_AlbedoMap && m_AlbedoMap->IsDefaultTexture()) {
-				TextureManager.RegisterTextureLoadCallback(TextureMangerIds[0], &m_AlbedoMap);
+				TextureManager.RegisterTextureLoadCallback(TextureMangerIds[0], Texture::eTextureType_Albedo, &m_AlbedoMap);
 			}
 			if (m_NormalMap && m_NormalMap->IsDefaultTexture()) {
-				TextureManager.RegisterTextureLoadCallback(TextureMangerIds[1], &m_NormalMap);
+				TextureManager.RegisterTextureLoadCallback(TextureMangerIds[1], Texture::eTextureType_Normal, &m_NormalMap);
 			}
 			if (m_MetallicMap && m_MetallicMap->IsDefaultTexture()) {
-				TextureManager.RegisterTextureLoadCallback(TextureMangerIds[2], &m_MetallicMap);
+				TextureManager.RegisterTextureLoadCallback(TextureMangerIds[2], Texture::eTextureType_Metallic, &m_MetallicMap);
 			}
 			if (m_RoughnessMap && m_RoughnessMap->IsDefaultTexture()) {
-				TextureManager.RegisterTextureLoadCallback(TextureMangerIds[3], &m_RoughnessMap);
+				TextureManager.RegisterTextureLoadCallback(TextureMangerIds[3], Texture::eTextureType_Roughness, &m_RoughnessMap);
 			}
 			if (m_AOMap && m_AOMap->IsDefaultTexture()) {
-				TextureManager.RegisterTextureLoadCallback(TextureMangerIds[4], &m_AOMap);
+				TextureManager.RegisterTextureLoadCallback(TextureMangerIds[4], Texture::eTextureType_AmbientOcclusion, &m_AOMap);
 			}
 		}
 
@@ -139,12 +139,11 @@ namespace Insight {
 			json::get_int(JsonMaterial, "RoughnessMapID", m_RoughnessTextureManagerID);
 			json::get_int(JsonMaterial, "AOMapID", m_AoTextureManagerID);
 
-			TextureManager& textureManager = ResourceManager::Get().GetTextureManager();
-			m_AlbedoMap = textureManager.GetTextureByID(m_AlbedoTextureManagerID, Texture::eTextureType::eTextureType_Albedo);
-			m_NormalMap = textureManager.GetTextureByID(m_NormalTextureManagerID, Texture::eTextureType::eTextureType_Normal);
-			m_MetallicMap = textureManager.GetTextureByID(m_MetallicTextureManagerID, Texture::eTextureType::eTextureType_Metallic);
-			m_RoughnessMap = textureManager.GetTextureByID(m_RoughnessTextureManagerID, Texture::eTextureType::eTextureType_Roughness);
-			m_AOMap = textureManager.GetTextureByID(m_AoTextureManagerID, Texture::eTextureType::eTextureType_AmbientOcclusion);
+			AcquireTexture(m_AlbedoMap, m_AlbedoTextureManagerID, Texture::eTextureType::eTextureType_Albedo);
+			AcquireTexture(m_NormalMap, m_NormalTextureManagerID, Texture::eTextureType::eTextureType_Normal);
+			AcquireTexture(m_MetallicMap, m_MetallicTextureManagerID, Texture::eTextureType::eTextureType_Metallic);
+			AcquireTexture(m_RoughnessMap, m_RoughnessTextureManagerID, Texture::eTextureType::eTextureType_Roughness);
+			AcquireTexture(m_AOMap, m_AoTextureManagerID, Texture::eTextureType::eTextureType_AmbientOcclusion);
 
 		} if (m_MaterialType == eMaterialType::eMaterialType_Translucent) {
 
@@ -154,12 +153,11 @@ namespace Insight {
 			json::get_int(JsonMaterial, "OpacityMapID", m_OpacityTextureManagerID);
 			json::get_int(JsonMaterial, "TranslucencyMapID", m_TranslucencyTextureManagerID);
 
-			TextureManager& textureManager = ResourceManager::Get().GetTextureManager();
-			m_AlbedoMap = textureManager.GetTextureByID(m_AlbedoTextureManagerID, Texture::eTextureType::eTextureType_Albedo);
-			m_NormalMap = textureManager.GetTextureByID(m_NormalTextureManagerID, Texture::eTextureType::eTextureType_Normal);
-			m_RoughnessMap = textureManager.GetTextureByID(m_RoughnessTextureManagerID, Texture::eTextureType::eTextureType_Roughness);
-			m_OpacityMap = textureManager.GetTextureByID(m_OpacityTextureManagerID, Texture::eTextureType::eTextureType_Opacity);
-			m_TranslucencyMap = textureManager.GetTextureByID(m_TranslucencyTextureManagerID, Texture::eTextureType::eTextureType_Translucency);
+			AcquireTexture(m_AlbedoMap, m_AlbedoTextureManagerID, Texture::eTextureType::eTextureType_Albedo);
+			AcquireTexture(m_NormalMap, m_NormalTextureManagerID, Texture::eTextureType::eTextureType_Normal);
+			AcquireTexture(m_RoughnessMap, m_RoughnessTextureManagerID, Texture::eTextureType::eTextureType_Roughness);
+			AcquireTexture(m_OpacityMap, m_OpacityTextureManagerID, Texture::eTextureType::eTextureType_Opacity);
+			AcquireTexture(m_TranslucencyMap, m_TranslucencyTextureManagerID, Texture::eTextureType::eTextureType_Translucency);
 		}
 
 		json::get_float(jsonUVOffset[0], "x", m_ShaderCB.UVOffset.x);
@@ -292,6 +290,29 @@ namespace Insight {
 
 	}
 
+	bool Material::ReplaceTexture(const StrongTexturePtr& pTexture)
+	{
+		const IE_TEXTURE_INFO& TexInfo = pTexture->GetTextureInfo();
+		StrongTexturePtr* pMap = nullptr;
+		switch (TexInfo.Type)
+		{
+		case Texture::eTextureType_Albedo:				pMap = &m_AlbedoMap; break;
+		case Texture::eTextureType_Normal:				pMap = &m_NormalMap; break;
+		case Texture::eTextureType_Metallic:			pMap = &m_MetallicMap; break;
+		case Texture::eTextureType_Roughness:			pMap = &m_RoughnessMap; break;
+		case Texture::eTextureType_AmbientOcclusion:	pMap = &m_AOMap; break;
+		case Texture::eTextureType_Opacity:				pMap = &m_OpacityMap; break;
+		case Texture::eTextureType_Translucency:		pMap = &m_TranslucencyMap; break;
+		default: return false;
+		}
+
+		if (!*pMap || (*pMap)->GetTextureInfo().Id != TexInfo.Id)
+			return false;
+
+		*pMap = pTexture;
+		return true;
+	}
+
 	void Material::BindResources(bool IsDeferredPass)
 	{
 		if (m_AlbedoMap.get()) {
@@ -348,4 +369,15 @@ namespace Insight {
 		}
 	}
 
+	void Material::AcquireTexture(StrongTexturePtr& OutTexture, Texture::ID TextureId, Texture::eTextureType TextureType)
+	{
+		TextureManager& TextureManager = ResourceManager::Get().GetTextureManager();
+		OutTexture = TextureManager.GetTextureByID(TextureId, TextureType);
+
+		// Scene textures load while actors are being created, wait for the proper texture if it is not loaded yet.
+		if (TextureId > 0 && OutTexture && OutTexture->IsDefaultTexture()) {
+			TextureManager.RegisterTextureLoadCallback(TextureId, TextureType, &OutTexture);
+		}
+	}
+
 }
\ No newline at end of file
@@ -48,9 +48,15 @@ namespace Insight {
 		CB_PS_VS_PerObjectMaterialAdditives GetMaterialOverrideConstantBuffer() { return m_ShaderCB; }
 
 		void OnImGuiRender();
+		// Swap in a texture that was reloaded from its file if the material uses it. Returns true if the material used the texture.
+		bool ReplaceTexture(const StrongTexturePtr& pTexture);
 		
 		void BindResources(bool IsDeferredPass);
 
+	private:
+		// Look up a texture by id. If it is not loaded yet the default texture is used until the texture manager finishes loading it.
+		void AcquireTexture(StrongTexturePtr& OutTexture, Texture::ID TextureId, Texture::eTextureType TextureType);
+
 	private:
 		eMaterialType m_MaterialType = eMaterialType::eMaterialType_Invalid;
 
@@ -3,6 +3,7 @@
 #include "Renderer.h"
 
 #include "Insight/Core/Application.h"
+#include "Insight/Systems/Managers/Resource_Manager.h"
 
 #include "Platform/DirectX_11/Direct3D11_Context.h"
 #include "Platform/DirectX_12/Direct3D12_Context.h"
@@ -15,31 +16,27 @@ namespace Insight {
 
 	Renderer::Renderer()
 	{
+		m_EventBus.Subscribe<WindowResizeEvent, Renderer, &Renderer::OnWindowResize>(this);
+		m_EventBus.Subscribe<WindowToggleFullScreenEvent, Renderer, &Renderer::OnWindowFullScreen>(this);
+		m_EventBus.Subscribe<ShaderReloadEvent, Renderer, &Renderer::OnShaderReload>(this);
+		m_EventBus.Subscribe<AssetReloadEvent, Renderer, &Renderer::OnAssetReload>(this);
 	}
 
 	void Renderer::HandleEvents()
 	{
-		while(s_Instance->m_WindowResizeEventQueue.size() != 0)
-		{
-			s_Instance->OnWindowResize(s_Instance->m_WindowResizeEventQueue.front());
-			s_Instance->m_WindowResizeEventQueue.pop();
-		}
-		while (s_Instance->m_ShaderReloadEventQueue.size() != 0)
-		{
-			s_Instance->OnShaderReload(s_Instance->m_ShaderReloadEventQueue.front());
-			s_Instance->m_ShaderReloadEventQueue.pop();
-		}
-		while (s_Instance->m_WindowFullScreenEventQueue.size() != 0)
-		{
-			s_Instance->OnWindowFullScreen(s_Instance->m_WindowFullScreenEventQueue.front());
-			s_Instance->m_WindowFullScreenEventQueue.pop();
-		}
+		s_Instance->m_EventBus.Flush();
 	}
 
 	Renderer::~Renderer()
 	{
 	}
 
+	bool Renderer::OnAssetReload(AssetReloadEvent& e)
+	{
+		ResourceManager::Get().GetAssetHotReload().SwapReloadedAssets();
+		return true;
+	}
+
 	bool Renderer::SetSettingsAndCreateContext(GraphicsSettings GraphicsSettings, std::shared_ptr<Window> pWindow)
 	{
 		IE_ASSERT(!s_Instance, "Rendering Context already exists! Cannot have more that one context created at a time.");
@@ -10,6 +10,7 @@
 
 #include "Platform/DirectX_Shared/Constant_Buffer_Types.h"
 #include "Insight/Events/Event.h"
+#include "Insight/Events/Event_Bus.h"
 
 /*
 	Represents a base for a graphics context the application will use for rendering.
@@ -102,6 +103,8 @@ namespace Insight {
 		static inline void ExecuteDraw() { s_Instance->ExecuteDraw_Impl(); }
 		// Swap buffers with the new frame.
 		static inline void SwapBuffers() { s_Instance->SwapBuffers_Impl(); }
+		// Block until the GPU has finished every frame in flight, Ex. before releasing resources they may read.
+		static inline void WaitForGPU() { s_Instance->WaitForGPU_Impl(); }
 		
 		template <class WindowClassType>
 		static inline WindowClassType& GetWindowRefAs() 
@@ -128,25 +131,16 @@ namespace Insight {
 		inline bool OnWindowFullScreen(WindowToggleFullScreenEvent& e) { s_Instance->OnWindowFullScreen_Impl(); return true; }
 		// Reloads all shaders
 		inline bool OnShaderReload(ShaderReloadEvent& e) { s_Instance->OnShaderReload_Impl(); return true; }
+		// Swaps in the assets hot reloaded since the last frame. See AssetHotReload.
+		bool OnAssetReload(AssetReloadEvent& e);
 		// Push an event to the renderers queue. Window resize events, shader resload events etc. 
 		// Before each fram the renderer ill handle all events in the queue before proessing a frame, 
 		// eliminateing the possibility of the Game thread modifying resources the Render thread is using mid frame.
+		// Safe to call from any thread.
 		template <class EventType>
-		static void PushEvent(EventType& e)
+		static void PushEvent(const EventType& e)
 		{ 
-			if constexpr (std::is_same<EventType, WindowResizeEvent>::value)
-			{
-				s_Instance->m_WindowResizeEventQueue.push(e);
-			}
-			if constexpr (std::is_same<EventType, WindowToggleFullScreenEvent>::value)
-			{
-				s_Instance->m_WindowFullScreenEventQueue.push(e);
-			}
-			if constexpr (std::is_same<EventType, ShaderReloadEvent>::value)
-			{
-				s_Instance->m_ShaderReloadEventQueue.push(e);
-			}
-
+			s_Instance->m_EventBus.Enqueue<EventType>(e);
 		}
 
 		inline void OnEditorRender() { s_Instance->OnEditorRender_Impl(); }
@@ -205,6 +199,7 @@ namespace Insight {
 		virtual void OnEditorRender_Impl() = 0;
 		virtual void ExecuteDraw_Impl() = 0;
 		virtual void SwapBuffers_Impl() = 0;
+		virtual void WaitForGPU_Impl() = 0;
 		virtual void OnWindowResize_Impl() = 0;
 		virtual void OnWindowFullScreen_Impl() = 0;
 		virtual void OnShaderReload_Impl() = 0;
@@ -250,9 +245,8 @@ namespace Insight {
 		Runtime::ACamera* m_pWorldCameraRef = nullptr;
 		std::shared_ptr<Window> m_pWindowRef;
 
-		std::queue<WindowResizeEvent> m_WindowResizeEventQueue;
-		std::queue<WindowToggleFullScreenEvent> m_WindowFullScreenEventQueue;
-		std::queue<ShaderReloadEvent> m_ShaderReloadEventQueue;
+		// Events pushed from the game thread, drained by the render thread in HandleEvents.
+		EventBus m_EventBus;
 
 	private:
 		static Renderer* s_Instance;
@@ -2,6 +2,8 @@
 
 #include <Insight/Core.h>
 
+#include "Insight/Systems/Mapped_File.h"
+
 namespace Insight {
 
 
@@ -35,6 +37,8 @@ namespace Insight {
 			bool IsCubeMap = false;
 			std::wstring Filepath;
 			ID Id;
+			// The texture's file if it was read ahead of creating the texture. Released once the texture is created.
+			FileView SourceFile;
 		};
 
 	public:
@@ -66,6 +70,10 @@ namespace Insight {
 		// Returns true if the texture is the default for its type. False if not.
 		inline bool IsDefaultTexture() const { return m_TextureInfo.Id < 0; }
 
+	protected:
+		// Take the file read ahead of creating the texture so it is released with the caller's copy.
+		inline FileView TakeSourceFile() { FileView Source = m_TextureInfo.SourceFile; m_TextureInfo.SourceFile = FileView(); return Source; }
+
 	protected:
 		IE_TEXTURE_INFO	m_TextureInfo = {};
 	};
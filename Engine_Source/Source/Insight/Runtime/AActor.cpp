@@ -7,6 +7,8 @@
 #include "Insight/Runtime/Components/Static_Mesh_Component.h"
 #include "Insight/Runtime/Components/CSharp_Scirpt_Component.h"
 #include "Insight/Runtime/Components/Sphere_Collider.h"
+#include "Insight/Memory/Deferred_Destruction.h"
+#include "Insight/Core/Scene/Play_Session_Snapshot.h"
 
 //TEMP
 #include "Insight/Rendering/Material.h"
@@ -21,10 +23,45 @@ namespace Insight {
 			: m_Id(Id), m_NumComponents(0), m_DeltaMs(0.0f)
 		{
 			SceneNode::SetDisplayName(ActorName);
+			m_pWorld = &ECS::World::Get();
+			m_Entity = m_pWorld->CreateEntity();
+
+			// Loaded actors are given back their saved GUID with SetGuid.
+			m_Guid = ActorRegistry::NewGuid();
+			m_RegistrySlot = ActorRegistry::Get().Register(this, m_Guid);
 		}
 
 		AActor::~AActor()
 		{
+			UnregisterTickFunctions();
+			ActorRegistry::Get().Unregister(m_RegistrySlot);
+			DestroyEntity();
+		}
+
+		bool AActor::SetGuid(ActorGuid Guid)
+		{
+			if (Guid == m_Guid)
+				return true;
+
+			ActorRegistry& Registry = ActorRegistry::Get();
+			const uint32_t Slot = Registry.Register(this, Guid);
+			if (Slot == ActorRegistry::InvalidSlot)
+			{
+				IE_DEBUG_LOG(LogSeverity::Warning, "Actor \"{0}\" was saved with GUID {1}, which is already in use. It keeps GUID {2}.",
+					GetDisplayName(), ActorRegistry::GuidToString(Guid), ActorRegistry::GuidToString(m_Guid));
+				return false;
+			}
+
+			Registry.Unregister(m_RegistrySlot);
+			m_RegistrySlot = Slot;
+			m_Guid = Guid;
+			return true;
+		}
+
+		void AActor::WriteGuidToJson(rapidjson::PrettyWriter<rapidjson::StringBuffer>& Writer) const
+		{
+			Writer.Key("Guid");
+			Writer.String(ActorRegistry::GuidToString(m_Guid).c_str());
 		}
 
 		bool AActor::LoadFromJson(const rapidjson::Value* jsonActor)
@@ -33,10 +70,19 @@ namespace Insight {
 				return true;
 
 			// Load Subobjects
-			const rapidjson::Value& JsonSubobjects = (*jsonActor)["Subobjects"];
+			const rapidjson::Value::ConstMemberIterator JsonSubobjectsIter = jsonActor->FindMember("Subobjects");
+			if (JsonSubobjectsIter == jsonActor->MemberEnd() || !JsonSubobjectsIter->value.IsArray()) {
+				IE_DEBUG_LOG(LogSeverity::Warning, "Actor \"{0}\" has no subobjects array.", SceneNode::GetDisplayName());
+				return true;
+			}
+			const rapidjson::Value& JsonSubobjects = JsonSubobjectsIter->value;
 
 			for (UINT i = 0; i < JsonSubobjects.Size(); ++i) {
 
+				if (!JsonSubobjects[i].IsObject()) {
+					continue;
+				}
+
 				if (JsonSubobjects[i].HasMember("SceneComponent")) {
 					SceneComponent* ptr = AActor::CreateDefaultSubobject<SceneComponent>();
 					ptr->LoadFromJson(JsonSubobjects[i]["SceneComponent"]);
@@ -74,6 +120,8 @@ namespace Insight {
 				Writer->Key("DisplayName");
 				Writer->String(SceneNode::GetDisplayName());
 
+				WriteGuidToJson(*Writer);
+
 				Writer->Key("Subobjects");
 				Writer->StartArray(); // Start Write SubObjects
 				{
@@ -120,6 +168,7 @@ namespace Insight {
 				if (m_DisplayName == "") {
 					m_DisplayName = "MyActor";
 				}
+				MarkDirtyForSave();
 			}
 
 			UI::NodeFlags TreeFlags = UI::TreeNode_Leaf;
@@ -131,7 +180,7 @@ namespace Insight {
 					// Set the Details panel to be blank
 					Application::Get().GetEditorLayer().SetSelectedActor(nullptr);
 					// remove the actor fom the world
-					m_Parent->RemoveChild(this);
+					Application::Get().GetScene().RemoveActor(this);
 					// Pop the rest of the tree nodes for ImGui.
 					// Thers no reason to leave this scope the actor has been deleted.
 					UI::TreePopNode();
@@ -247,15 +296,56 @@ namespace Insight {
 			}
 		}
 
-		void AActor::Tick(const float DeltaMs)
+		static void TickActor(void* pTarget, float DeltaMs)
 		{
-			SceneNode::Tick(DeltaMs);
-			for (auto& comp : m_Components)
-			{
-				comp->Tick(DeltaMs);
+			static_cast<AActor*>(pTarget)->Tick(DeltaMs);
+		}
+
+		static void TickComponent(void* pTarget, float DeltaMs)
+		{
+			static_cast<ActorComponent*>(pTarget)->Tick(DeltaMs);
+		}
+
+		void AActor::RegisterTickFunctions()
+		{
+			SceneNode::RegisterTickFunctions();
+			if (IsStatic())
+				return;
+
+			TickManager::Get().Register(m_PrimaryTick, &TickActor, this, this);
+			for (uint32_t i = 0; i < m_NumComponents; ++i) {
+				RegisterComponentTick(m_Components[i]);
+			}
+		}
+
+		void AActor::RegisterComponentTick(ActorComponent* pComponent)
+		{
+			TickManager::Get().Register(pComponent->GetComponentTick(), &TickComponent, pComponent, this);
+		}
+
+		void AActor::UnregisterTickFunctions()
+		{
+			SceneNode::UnregisterTickFunctions();
+			if (!TickManager::IsInitialized())
+				return;
+
+			TickManager& Ticks = TickManager::Get();
+			Ticks.Unregister(m_PrimaryTick);
+			for (uint32_t i = 0; i < m_NumComponents; ++i) {
+				Ticks.Unregister(m_Components[i]->GetComponentTick());
 			}
 		}
 
+		bool AActor::IsStatic()
+		{
+			SceneComponent* pRoot = GetSubobject<SceneComponent>();
+			return pRoot && pRoot->IsStatic();
+		}
+
+		void AActor::Tick(const float DeltaMs)
+		{
+		}
+
 		void AActor::Exit()
 		{
 			SceneNode::Exit();
@@ -264,13 +354,26 @@ namespace Insight {
 
 		void AActor::Destroy()
 		{
+			UnregisterTickFunctions();
 			SceneNode::Destroy();
 
 			for (uint32_t i = 0; i < m_NumComponents; i++) {
 				m_Components[i]->OnDestroy();
-				delete m_Components[i];
+				Memory::DeferredDelete(m_Components[i]);
 			}
 			m_Components.clear();
+			m_NumComponents = 0;
+
+			DestroyEntity();
+		}
+
+		void AActor::DestroyEntity()
+		{
+			// Destroyed actors are deleted at the end of the frame, possibly after their scene and its world.
+			if (!m_Entity.IsValid())
+				return;
+			m_pWorld->DestroyEntity(m_Entity);
+			m_Entity = ECS::INVALID_ENTITY;
 		}
 
 		void AActor::OnEvent(Event& e)
@@ -290,20 +393,32 @@ namespace Insight {
 			IE_ASSERT(std::find(m_Components.begin(), m_Components.end(), component) != m_Components.end(), "Could not find Component in Actor list while attempting to delete");
 
 			auto iter = std::find(m_Components.begin(), m_Components.end(), component);
+			if (TickManager::IsInitialized())
+				TickManager::Get().Unregister((*iter)->GetComponentTick());
+			if (PlaySessionSnapshot::IsInitialized())
+				PlaySessionSnapshot::Get().ForgetComponent(component);
 			(*iter)->OnDetach();
 			(*iter)->OnDestroy();
 			m_Components.erase(iter);
 			m_NumComponents--;
+			MarkDirtyForSave();
+
+			Memory::DeferredDelete(component);
 		}
 
 		void AActor::RemoveAllSubobjects()
 		{
 			for (uint32_t i = 0; i < m_NumComponents; ++i) {
+				if (TickManager::IsInitialized())
+					TickManager::Get().Unregister(m_Components[i]->GetComponentTick());
+				if (PlaySessionSnapshot::IsInitialized())
+					PlaySessionSnapshot::Get().ForgetComponent(m_Components[i]);
 				m_Components[i]->OnDestroy();
-				delete m_Components[i];
+				Memory::DeferredDelete(m_Components[i]);
 			}
 			m_Components.clear();
 			m_NumComponents = 0;
+			MarkDirtyForSave();
 		}
 
 		bool AActor::OnCollision(PhysicsEvent& e)
@@ -4,8 +4,12 @@
 #include "Insight/Events/Event.h"
 #include "Insight/Math/Transform.h"
 #include "Insight/Core/Scene/Scene_Node.h"
+#include "Insight/Core/Scene/Actor_Registry.h"
+#include "Insight/Core/Scene/Tick_Manager.h"
 #include "Insight/Runtime/Components/Scene_Component.h"
 #include "Insight/Events/Application_Event.h"
+#include "Insight/Runtime/ECS/ECS_World.h"
+#include "Insight/Memory/Object_Pool.h"
 
 
 namespace Insight {
@@ -17,6 +21,7 @@ namespace Insight {
 
 		class INSIGHT_API AActor : public SceneNode
 		{
+			IE_DECLARE_POOLED_CLASS(AActor)
 		public:
 			typedef std::vector<ActorComponent*> ActorComponents;
 
@@ -41,27 +46,59 @@ namespace Insight {
 
 			virtual void BeginPlay();
 			virtual void EditorEndPlay() override;
+			// Register the actor's and its components' tick functions, unless the actor is static.
+			virtual void RegisterTickFunctions() override;
+			virtual void UnregisterTickFunctions() override;
+			// Called by the TickManager while the actor's primary tick is registered. Components and child
+			// actors tick on their own. See GetPrimaryTick.
 			virtual void Tick(const float DeltaMs);
 			virtual void Exit();
 
+			// How the actor itself ticks. Actor types whose Tick does something set CanEverTick in their constructor.
+			TickFunction& GetPrimaryTick() { return m_PrimaryTick; }
+			// Tick after another actor's ticks in the same group, Ex. after the actor this one is attached to.
+			void AddTickPrerequisite(const AActor* pActor) { m_PrimaryTick.Prerequisites.push_back(ActorRef(pActor)); }
+			// Returns true if the actor's root scene component is static.
+			bool IsStatic();
+
 			ActorId GetId() { return m_Id; }
+			// Persistent identity of the actor, saved with its scene. See ActorRegistry.
+			ActorGuid GetGuid() const { return m_Guid; }
+			// Give the actor the GUID it was saved with. Returns false and keeps the current GUID if another live actor already has it.
+			bool SetGuid(ActorGuid Guid);
+			// The actor's slot in the ActorRegistry, unique among live actors. Usable as an index into per-actor tables.
+			uint32_t GetRegistrySlot() const { return m_RegistrySlot; }
 		public:
 			template<typename ComponentType>
 			ComponentType* CreateDefaultSubobject()
 			{
-				ActorComponent* Component = new ComponentType(this);
+				ComponentType* Component = new ComponentType(this);
 				IE_ASSERT(Component, "Trying to add null component to actor.");
 
 				Component->OnAttach();
 				Component->SetEventCallback(IE_BIND_LOCAL_EVENT_FN(AActor::OnEvent));
+				Component->SetTypeId(ECS::GetComponentTypeId<ComponentType>());
 
 				m_Components.push_back(Component);
 				m_NumComponents++;
-				return (ComponentType*)Component;
+				MarkDirtyForSave();
+
+				// Created during play, it ticks from the next frame like the rest of the actor.
+				if (m_TickFunctionsRegistered && !IsStatic())
+					RegisterComponentTick(Component);
+				return Component;
 			}
 			template<typename ComponentType>
 			ComponentType* GetSubobject()
 			{
+				constexpr ECS::ComponentTypeId TypeId = ECS::GetComponentTypeId<ComponentType>();
+				for (ActorComponent* pComponent : m_Components)
+				{
+					if (pComponent->GetTypeId() == TypeId)
+						return static_cast<ComponentType*>(pComponent);
+				}
+
+				// No component of the exact type, the caller may be asking for a base class.
 				ComponentType* component = nullptr;
 				for (ActorComponent* _component : m_Components)
 				{
@@ -72,13 +109,29 @@ namespace Insight {
 			}
 			void RemoveSubobject(ActorComponent* component);
 			void RemoveAllSubobjects();
-			std::vector<ActorComponent*> GetAllSubobjects() const { return m_Components; }
+			const ActorComponents& GetAllSubobjects() const { return m_Components; }
+			// The actor's first scene component. Its world matrix is the actor's, see ECS::WorldTransform.
+			SceneComponent* GetRootComponent() { return GetSubobject<SceneComponent>(); }
+			// Get the ECS entity that stores this actor's component data.
+			ECS::Entity GetEntity() const { return m_Entity; }
+			// Get the ECS world of the scene the actor was created in.
+			ECS::World& GetWorld() const { return *m_pWorld; }
+		protected:
+			// Write the actor's "Guid" member. Every actor type writes it after its "DisplayName".
+			void WriteGuidToJson(rapidjson::PrettyWriter<rapidjson::StringBuffer>& Writer) const;
 		private:
 			bool OnCollision(PhysicsEvent& e);
+			void RegisterComponentTick(ActorComponent* pComponent);
+			void DestroyEntity();
 		protected:
 			ActorComponents m_Components;
 			uint32_t m_NumComponents;
 			ActorId m_Id;
+			ActorGuid m_Guid = INVALID_ACTOR_GUID;
+			uint32_t m_RegistrySlot = ActorRegistry::InvalidSlot;
+			TickFunction m_PrimaryTick;
+			ECS::World* m_pWorld;
+			ECS::Entity m_Entity;
 			float m_DeltaMs;
 		private:
 
@@ -61,7 +61,6 @@ namespace Insight {
 			m_pSceneComponent->Rotate(yPos * m_MouseSensitivity, xPos * m_MouseSensitivity, 0.0f);
 
 			UpdateViewMatrix();
-			m_pSceneComponent->GetTransformRef().UpdateLocalDirectionVectors();
 		}
 
 		void ACamera::OnEvent(Event& e)
@@ -160,7 +159,6 @@ namespace Insight {
 				m_pSceneComponent->Rotate(Value * m_MouseSensitivity * m_DeltaMs, 0.0f, 0.0f);
 
 				UpdateViewMatrix();
-				m_pSceneComponent->GetTransformRef().UpdateLocalDirectionVectors();
 			}
 		}
 
@@ -171,7 +169,6 @@ namespace Insight {
 				m_pSceneComponent->Rotate(0.0f, Value * m_MouseSensitivity * m_DeltaMs, 0.0f);
 
 				UpdateViewMatrix();
-				m_pSceneComponent->GetTransformRef().UpdateLocalDirectionVectors();
 			}
 		}
 
@@ -38,6 +38,7 @@ namespace Insight {
 
 		class INSIGHT_API ACamera : public APawn
 		{
+			IE_DECLARE_POOLED_CLASS(ACamera)
 		public:
 			friend class APlayerCharacter;
 			using Super = APawn;
@@ -90,7 +91,6 @@ namespace Insight {
 				if (UpdateView) {
 					UpdateViewMatrix();
 				}
-				m_pSceneComponent->GetTransformRef().UpdateLocalDirectionVectors();
 			}
 
 			void OnEvent(Event& e);
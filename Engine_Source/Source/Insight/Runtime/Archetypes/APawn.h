@@ -17,6 +17,7 @@ namespace Insight {
 
 		class INSIGHT_API APawn : public AActor
 		{
+			IE_DECLARE_POOLED_CLASS(APawn)
 		public:
 			using Super = AActor;
 		public:
@@ -18,6 +18,10 @@ namespace Insight {
 		{
 			IE_ASSERT(!s_Instance, "Trying to create another instnace of a player character!");
 			s_Instance = this;
+			// The player drives the viewer, it always ticks at full rate before anything reacts to it.
+			m_PrimaryTick.CanEverTick = true;
+			m_PrimaryTick.UseSignificance = false;
+			m_PrimaryTick.Group = TickGroup::PrePhysics;
 			m_ViewTarget = ACamera::GetDefaultViewTarget(); // This should be loaded through a player settings file
 
 			//m_pCamera = new ACamera(m_ViewTarget);
@@ -12,6 +12,7 @@ namespace Insight {
 
 		class INSIGHT_API APlayerCharacter : public APawn
 		{
+			IE_DECLARE_POOLED_CLASS(APlayerCharacter)
 		public:
 			APlayerCharacter(ActorId id, ActorName name = "Player Character");
 			virtual ~APlayerCharacter();
@@ -12,6 +12,7 @@ namespace Insight {
 
 		class INSIGHT_API APlayerController : public AActor
 		{
+			IE_DECLARE_POOLED_CLASS(APlayerController)
 		public:
 			APlayerController();
 			~APlayerController();
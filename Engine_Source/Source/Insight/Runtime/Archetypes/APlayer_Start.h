@@ -13,6 +13,7 @@ namespace Insight {
 
 		class INSIGHT_API APlayerStart : public AActor
 		{
+			IE_DECLARE_POOLED_CLASS(APlayerStart)
 		public:
 			APlayerStart(ActorId id, ActorName name = "Player Start");
 			virtual ~APlayerStart();
@@ -2,6 +2,9 @@
 #include <Insight/Core.h>
 
 #include "Insight/Events/Event.h"
+#include "Insight/Runtime/ECS/ECS_Types.h"
+#include "Insight/Memory/Object_Pool.h"
+#include "Insight/Core/Scene/Tick_Manager.h"
 
 
 namespace Insight {
@@ -14,6 +17,7 @@ namespace Insight {
 
 		class ActorComponent
 		{
+			IE_DECLARE_POOLED_CLASS(ActorComponent)
 		public:
 			using EventCallbackFn = std::function<void(Event&)>;
 
@@ -42,11 +46,22 @@ namespace Insight {
 
 			virtual void BeginPlay() = 0;
 			virtual void EditorEndPlay() = 0;
+			// Called by the TickManager while the component's tick is registered. See GetComponentTick.
 			virtual void Tick(const float DeltaMs) = 0;
 
 			virtual void OnAttach() = 0;
 			virtual void OnDetach() = 0;
 
+			// Size in bytes of the state, besides transforms, that play can change and the editor should get back when it ends. See PlaySessionSnapshot.
+			virtual uint32_t GetPlayStateSize() const { return 0u; }
+			// Write GetPlayStateSize bytes of play state to pState when a play session begins.
+			virtual void SavePlayState(uint8_t* pState) const {}
+			// Read back what SavePlayState wrote when the play session ends.
+			virtual void RestorePlayState(const uint8_t* pState) {}
+			// Called when the owning actor is removed during play and kept to be put back when it ends. The component should stop being seen.
+			virtual void OnRemovedDuringPlay() {}
+			virtual void OnRestoredAfterPlay() {}
+
 			//void SetEventCallbackFunction()
 			bool GetIsComponentEnabled() const { return m_Enabled; }
 			void SetComponentEnabled(bool Enable) { m_Enabled = Enable; }
@@ -54,6 +69,13 @@ namespace Insight {
 			const char* GetName() const { return m_ComponentName; };
 
 			void SetOwner(AActor* Owner) { m_pOwner = Owner; }
+			// How the component ticks. Components whose Tick does something set CanEverTick in their constructor.
+			TickFunction& GetComponentTick() { return m_ComponentTick; }
+
+			// Id of the component's concrete type, so components of an exact type are found without a dynamic_cast.
+			// Set by the owning actor when the component is created.
+			ECS::ComponentTypeId GetTypeId() const { return m_TypeId; }
+			void SetTypeId(ECS::ComponentTypeId TypeId) { m_TypeId = TypeId; }
 		protected:
 			ActorComponent(const char* ComponentName, Runtime::AActor* Owner)
 				: m_ComponentName(ComponentName), m_pOwner(Owner) 
@@ -62,6 +84,8 @@ namespace Insight {
 			Runtime::AActor* m_pOwner;
 			const char* m_ComponentName;
 			bool m_Enabled = true;
+			TickFunction m_ComponentTick;
+			ECS::ComponentTypeId m_TypeId = ECS::INVALID_COMPONENT_TYPE_ID;
 
 			// ImGui uses ID's to sort through subwindows.
 			// If we dont add a uid to each submenu, components of 
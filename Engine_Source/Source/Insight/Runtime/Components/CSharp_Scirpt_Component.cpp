@@ -5,6 +5,7 @@
 #include "Insight/Systems/Managers/Resource_Manager.h"
 #include "Insight/Runtime/AActor.h"
 #include "Insight/Core/Application.h"
+#include "Insight/Memory/Memory_Tracker.h"
 
 
 namespace Insight {
@@ -17,6 +18,10 @@ namespace Insight {
 		CSharpScriptComponent::CSharpScriptComponent(AActor* pOwner)
 			: ActorComponent("C-Sharp Script Component", pOwner)
 		{
+			m_ComponentTick.CanEverTick = true;
+			// A script only moves its own actor, so scripts of different actors tick on the workers side by side.
+			// Invoking into Mono from a worker needs the worker attached to the domain first (mono_thread_attach).
+			m_ComponentTick.RunOnGameThread = false;
 			//m_pMonoScriptManager = &ResourceManager::Get().GetMonoScriptManager();
 			/*if (m_pMonoScriptManager) {
 				m_pMonoScriptManager->RegisterScript(this);
@@ -42,6 +47,7 @@ namespace Insight {
 
 		void CSharpScriptComponent::RegisterScript()
 		{
+			IE_MEMORY_TAG(Scripting);
 			// Register the class with mono runtime
 		/*	if (!m_pMonoScriptManager->CreateClass(m_pClass, m_pObject, m_ModuleName.c_str())) {
 				IE_DEBUG_LOG(LogSeverity::Error, "Failed to create C# class for \"{0}\"", m_ModuleName);
@@ -239,6 +245,7 @@ namespace Insight {
 		void CSharpScriptComponent::Tick(const float DeltaMs)
 		{
 			if (!m_CanBeTicked) { return; }
+			IE_MEMORY_TAG(Scripting);
 			UpdateScriptFields();
 
 			void* args[1];
@@ -14,6 +14,7 @@ namespace Insight {
 
 		class INSIGHT_API CSharpScriptComponent : public ActorComponent
 		{
+			IE_DECLARE_POOLED_CLASS(CSharpScriptComponent)
 		public:
 			struct EventData
 			{
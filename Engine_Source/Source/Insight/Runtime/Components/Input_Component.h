@@ -11,6 +11,7 @@ namespace Insight {
 
 		class INSIGHT_API InputComponent : public ActorComponent
 		{
+			IE_DECLARE_POOLED_CLASS(InputComponent)
 		public:
 			typedef void(*OutVoidInFloatFn_t)(float);
 			typedef void(*OutVoidInVoidFn_t)(void);
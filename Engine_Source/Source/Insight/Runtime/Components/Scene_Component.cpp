@@ -2,7 +2,9 @@
 
 #include "Scene_Component.h"
 
+#include "Insight/Runtime/AActor.h"
 #include "Insight/Runtime/Archetypes/ACamera.h"
+#include "Insight/Runtime/ECS/Transform_System.h"
 
 #include "Insight/UI/UI_Lib.h"
 #include "Insight/Core/Application.h"
@@ -15,6 +17,9 @@ namespace Insight {
 		SceneComponent::SceneComponent(AActor* pOwner)
 			: ActorComponent("SceneComponent", pOwner)
 		{
+			// The actor's world matrix is kept by value in its entity, for the TransformSystem.
+			if (m_pOwner && !m_pOwner->GetWorld().HasComponent<ECS::WorldTransform>(m_pOwner->GetEntity()))
+				m_pOwner->GetWorld().AddComponent<ECS::WorldTransform>(m_pOwner->GetEntity());
 		}
 
 		SceneComponent::~SceneComponent()
@@ -100,6 +105,9 @@ namespace Insight {
 
 		void SceneComponent::OnPostInit()
 		{
+			m_Transform.UpdateLocalMatrix();
+			WriteWorldTransform(m_Transform.GetLocalSimdMatrix());
+
 			TranslationEvent e;
 			e.TranslationInfo.WorldMat = m_Transform.GetLocalMatrix();
 			m_TranslationData.EventCallback(e);
@@ -119,6 +127,11 @@ namespace Insight {
 
 		void SceneComponent::OnImGuiRender()
 		{
+			const ieVector3 PrevPosition = m_Transform.GetPosition();
+			const ieVector3 PrevRotation = m_Transform.GetRotation();
+			const ieVector3 PrevScale = m_Transform.GetScale();
+			const bool PrevIsStatic = m_IsStatic;
+
 			RenderSelectionGizmo();
 			
 			if (UI::CollapsingHeader(m_ComponentName, UI::TreeNode_DefaultOpen)) {
@@ -134,6 +147,9 @@ namespace Insight {
 
 				NotifyTranslationEvent();
 			}
+
+			if (m_Transform.GetPosition() != PrevPosition || m_Transform.GetRotation() != PrevRotation || m_Transform.GetScale() != PrevScale || m_IsStatic != PrevIsStatic)
+				MarkOwnerDirty();
 		}
 
 		void SceneComponent::RenderSceneHeirarchy()
@@ -142,12 +158,10 @@ namespace Insight {
 
 		void SceneComponent::BeginPlay()
 		{
-			m_EditorTransform = m_Transform;
 		}
 
 		void SceneComponent::EditorEndPlay()
 		{
-			m_EditorTransform = m_Transform;
 		}
 
 		void SceneComponent::Tick(const float DeltaMs)
@@ -222,8 +236,33 @@ namespace Insight {
 			//}
 		}
 
+		void SceneComponent::MarkOwnerDirty()
+		{
+			if (m_pOwner)
+				m_pOwner->MarkDirtyForSave();
+		}
+
+		void SceneComponent::WriteWorldTransform(const Math::Simd::Matrix& WorldMatrix)
+		{
+			// Only the root moves the actor, the matrices of its other scene components are their own.
+			if (!m_pOwner || m_pOwner->GetRootComponent() != this)
+				return;
+
+			if (ECS::WorldTransform* pWorldTransform = m_pOwner->GetWorld().GetComponent<ECS::WorldTransform>(m_pOwner->GetEntity()))
+			{
+				pWorldTransform->Matrix = WorldMatrix;
+				pWorldTransform->Changed = true;
+			}
+		}
+
+		void SceneComponent::OnTransformRestored()
+		{
+			NotifyTranslationEvent();
+		}
+
 		void SceneComponent::NotifyTranslationEvent()
 		{
+			m_Transform.UpdateLocalMatrix();
 			if (m_pParent)
 			{
 				m_Transform.SetWorldMatrix(XMMatrixMultiply(m_Transform.GetLocalMatrix(), m_pParent->GetTransformRef().GetWorldMatrix()));
@@ -232,6 +271,8 @@ namespace Insight {
 			{
 				m_Transform.SetWorldMatrix(m_Transform.GetLocalMatrix());
 			}
+			WriteWorldTransform(m_Transform.GetWorldSimdMatrix());
+
 			TranslationEvent e;
 			e.TranslationInfo.WorldMat = m_Transform.GetWorldMatrix();
 			m_TranslationData.EventCallback(e);
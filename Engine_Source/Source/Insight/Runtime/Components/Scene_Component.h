@@ -14,6 +14,7 @@ namespace Insight {
 
 		class INSIGHT_API SceneComponent : public Runtime::ActorComponent
 		{
+			IE_DECLARE_POOLED_CLASS(SceneComponent)
 		public:
 			struct TranslationData
 			{
@@ -60,21 +61,21 @@ namespace Insight {
 			// Remove the parent this scene component.
 			inline void DetachParent() { m_pParent = nullptr; }
 
-			inline void SetPosition(ieVector3 NewPosition) { m_Transform.SetPosition(NewPosition); }
-			inline void SetRotation(ieVector3 NewRotation) { m_Transform.SetRotation(NewRotation); }
-			inline void SetScale(ieVector3 NewScale) { m_Transform.SetScale(NewScale); }
+			inline void SetPosition(ieVector3 NewPosition) { m_Transform.SetPosition(NewPosition); MarkOwnerDirty(); }
+			inline void SetRotation(ieVector3 NewRotation) { m_Transform.SetRotation(NewRotation); MarkOwnerDirty(); }
+			inline void SetScale(ieVector3 NewScale) { m_Transform.SetScale(NewScale); MarkOwnerDirty(); }
 			 
-			inline void SetPosition(float X, float Y, float Z) { m_Transform.SetPosition({ X, Y, Z }); }
-			inline void SetRotation(float X, float Y, float Z) { m_Transform.SetRotation({ X, Y, Z }); }
-			inline void SetScale(float X, float Y, float Z) { m_Transform.SetScale({ X, Y, Z }); }
+			inline void SetPosition(float X, float Y, float Z) { m_Transform.SetPosition({ X, Y, Z }); MarkOwnerDirty(); }
+			inline void SetRotation(float X, float Y, float Z) { m_Transform.SetRotation({ X, Y, Z }); MarkOwnerDirty(); }
+			inline void SetScale(float X, float Y, float Z) { m_Transform.SetScale({ X, Y, Z }); MarkOwnerDirty(); }
 			 
-			inline void SetPosition(float XYZ) { m_Transform.SetPosition({ XYZ, XYZ, XYZ }); }
-			inline void SetRotation(float XYZ) { m_Transform.SetRotation({ XYZ, XYZ, XYZ }); }
-			inline void SetScale(float XYZ) { m_Transform.SetScale({ XYZ, XYZ, XYZ }); }
+			inline void SetPosition(float XYZ) { m_Transform.SetPosition({ XYZ, XYZ, XYZ }); MarkOwnerDirty(); }
+			inline void SetRotation(float XYZ) { m_Transform.SetRotation({ XYZ, XYZ, XYZ }); MarkOwnerDirty(); }
+			inline void SetScale(float XYZ) { m_Transform.SetScale({ XYZ, XYZ, XYZ }); MarkOwnerDirty(); }
 			 
-			inline void Translate(float X, float Y, float Z) { m_Transform.Translate(X, Y, Z); NotifyTranslationEvent(); }
-			inline void Rotate(float X, float Y, float Z) { m_Transform.Rotate(X, Y, Z);  NotifyTranslationEvent(); }
-			inline void Scale(float X, float Y, float Z) { m_Transform.Scale(X, Y, Z); NotifyTranslationEvent(); }
+			inline void Translate(float X, float Y, float Z) { m_Transform.Translate(X, Y, Z); NotifyTranslationEvent(); MarkOwnerDirty(); }
+			inline void Rotate(float X, float Y, float Z) { m_Transform.Rotate(X, Y, Z); NotifyTranslationEvent(); MarkOwnerDirty(); }
+			inline void Scale(float X, float Y, float Z) { m_Transform.Scale(X, Y, Z); NotifyTranslationEvent(); MarkOwnerDirty(); }
 
 			inline ieVector3 GetPosition() { return m_Transform.GetPosition(); }
 			inline ieVector3 GetRotation() { return m_Transform.GetRotation(); }
@@ -84,16 +85,25 @@ namespace Insight {
 			inline ieVector3& GetRotationRef() { return m_Transform.GetRotationRef(); }
 			inline ieVector3& GetScaleRef() { return m_Transform.GetScaleRef(); }
 
+			// Static components never move during play. Actors whose root is static are not ticked.
+			inline bool IsStatic() const { return m_IsStatic; }
+			inline void SetIsStatic(bool IsStatic) { m_IsStatic = IsStatic; MarkOwnerDirty(); }
+
 			inline const ieTransform& GetTransform() const { return m_Transform; }
 			inline ieTransform& GetTransformRef() { return m_Transform; }
+			// Rebuild the world matrix and notify the owner after the transform was written to directly. See PlaySessionSnapshot.
+			void OnTransformRestored();
 
 		private:
 			void RenderSelectionGizmo();
 			inline void NotifyTranslationEvent();
+			// Flag the owning actor to be written out on the next incremental scene save.
+			void MarkOwnerDirty();
+			// Store the world matrix in the owning actor's entity if this is the actor's root, the TransformSystem moves its static meshes from there.
+			void WriteWorldTransform(const Math::Simd::Matrix& WorldMatrix);
 
 		private:
 			ieTransform m_Transform;
-			ieTransform m_EditorTransform;
 
 			bool m_IsStatic = false;
 			TranslationData m_TranslationData;
@@ -100,5 +100,15 @@ namespace Insight {
 
 		}
 
+		void SphereColliderComponent::OnRemovedDuringPlay()
+		{
+			PhysicsManager::UnRegisterPhysicsObject(this);
+		}
+
+		void SphereColliderComponent::OnRestoredAfterPlay()
+		{
+			PhysicsManager::RegisterPhysicsObject(this);
+		}
+
 	} // end namespace Runtime
 } // end namespace Insight
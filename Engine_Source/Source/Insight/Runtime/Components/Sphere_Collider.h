@@ -14,6 +14,7 @@ namespace Insight {
 
 		class INSIGHT_API SphereColliderComponent : public IPhysicsObject, public ActorComponent
 		{
+			IE_DECLARE_POOLED_CLASS(SphereColliderComponent)
 		public:
 			struct CollisionData
 			{
@@ -47,6 +48,12 @@ namespace Insight {
 			virtual void OnAttach() override;
 			virtual void OnDetach() override;
 
+			virtual uint32_t GetPlayStateSize() const override { return sizeof(m_Radius); }
+			virtual void SavePlayState(uint8_t* pState) const override { memcpy(pState, &m_Radius, sizeof(m_Radius)); }
+			virtual void RestorePlayState(const uint8_t* pState) override { memcpy(&m_Radius, pState, sizeof(m_Radius)); }
+			virtual void OnRemovedDuringPlay() override;
+			virtual void OnRestoredAfterPlay() override;
+
 			float GetRadius() { return m_Radius; }
 			void SetRadius(float Radius) { m_Radius = Radius; }
 
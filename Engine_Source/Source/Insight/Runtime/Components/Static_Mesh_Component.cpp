@@ -3,6 +3,7 @@
 #include "Static_Mesh_Component.h"
 
 #include "Insight/Runtime/AActor.h"
+#include "Insight/Runtime/ECS/Transform_System.h"
 #include "Insight/Systems/Managers/Resource_Manager.h"
 #include "Insight/Rendering/Renderer.h"
 #include "Insight/Rendering/Material.h"
@@ -28,21 +29,36 @@ namespace Insight {
 
 		bool StaticMeshComponent::LoadFromJson(const rapidjson::Value& JsonStaticMeshComponent)
 		{
+			// Expected layout: [ { "Mesh": "...", "Enabled": true, "LocalTransform": [ { ... } ] }, { Material } ]
+			if (!JsonStaticMeshComponent.IsArray() || JsonStaticMeshComponent.Size() < 2 || !JsonStaticMeshComponent[0].IsObject() || !JsonStaticMeshComponent[1].IsObject()) {
+				IE_DEBUG_LOG(LogSeverity::Error, "Static mesh component of actor \"{0}\" is malformed. No mesh will be attached.", m_pOwner->GetDisplayName());
+				return false;
+			}
+			const rapidjson::Value& JsonMesh = JsonStaticMeshComponent[0];
+
 			// Load Material
 			m_pMaterial->LoadFromJson(JsonStaticMeshComponent[1]);
 
 			// Load Mesh
 			std::string ModelPath;
-			json::get_string(JsonStaticMeshComponent[0], "Mesh", ModelPath);
+			json::get_string(JsonMesh, "Mesh", ModelPath);
 			AttachMesh(ModelPath);
+			if (!m_pModel) {
+				return false;
+			}
 
-			json::get_bool(JsonStaticMeshComponent[0], "Enabled", ActorComponent::m_Enabled);
+			json::get_bool(JsonMesh, "Enabled", ActorComponent::m_Enabled);
 
 			// Load Mesh Local Transform
+			const rapidjson::Value::ConstMemberIterator JsonTransform = JsonMesh.FindMember("LocalTransform");
+			if (JsonTransform == JsonMesh.MemberEnd() || !JsonTransform->value.IsArray() || JsonTransform->value.Empty() || !JsonTransform->value[0].IsObject()) {
+				IE_DEBUG_LOG(LogSeverity::Warning, "Static mesh \"{0}\" has no local transform. Using the identity transform.", ModelPath);
+				return true;
+			}
 			float posX, posY, posZ;
 			float rotX, rotY, rotZ;
 			float scaX, scaY, scaZ;
-			const rapidjson::Value& MeshTransform = JsonStaticMeshComponent[0]["LocalTransform"];
+			const rapidjson::Value& MeshTransform = JsonTransform->value;
 			// Position
 			json::get_float(MeshTransform[0], "posX", posX);
 			json::get_float(MeshTransform[0], "posY", posY);
@@ -64,6 +80,10 @@ namespace Insight {
 
 		bool StaticMeshComponent::WriteToJson(rapidjson::PrettyWriter<rapidjson::StringBuffer>& Writer)
 		{
+			// A component whose mesh failed to load has nothing to save.
+			if (!m_pModel)
+				return false;
+
 			Writer.Key("StaticMesh");
 			Writer.StartArray(); // Start SM Write
 			{
@@ -124,8 +144,6 @@ namespace Insight {
 
 		void StaticMeshComponent::OnEvent(Event& e)
 		{
-			EventDispatcher Dispatcher(e);
-			Dispatcher.Dispatch<TranslationEvent>(IE_BIND_LOCAL_EVENT_FN(StaticMeshComponent::OnEventTranslation));
 		}
 
 		void StaticMeshComponent::OnInit()
@@ -134,8 +152,11 @@ namespace Insight {
 
 		void StaticMeshComponent::OnDestroy()
 		{
-			GeometryManager::UnRegisterOpaqueModel(m_pModel);
-			m_pModel->Destroy();
+			if (m_pModel) {
+				UnbindModel();
+				GeometryManager::UnRegisterOpaqueModel(m_pModel);
+				m_pModel->Destroy();
+			}
 			delete m_pMaterial;
 		}
 
@@ -189,6 +210,7 @@ namespace Insight {
 			ScopedPerfTimer(("StaticMeshComponent::AttachMesh \"" + Path + "\"").c_str(), OutputType_Seconds);
 
 			if (m_pModel) {
+				UnbindModel();
 				GeometryManager::UnRegisterOpaqueModel(m_pModel);
 				m_pModel.reset();
 			}
@@ -198,14 +220,8 @@ namespace Insight {
 				return;
 			}
 
-			Material::eMaterialType MaterialType = m_pMaterial->GetMaterialType();
-
-			if (MaterialType == Material::eMaterialType::eMaterialType_Opaque) {
-				GeometryManager::RegisterOpaqueModel(m_pModel);
-			}
-			else if (MaterialType == Material::eMaterialType::eMaterialType_Translucent) {
-				GeometryManager::RegisterTranslucentModel(m_pModel);
-			}
+			RegisterModel();
+			BindModel();
 
 			// Experamental: Multi-threaded model laoding
 			//m_ModelLoadFuture = std::async(std::launch::async, LoadModelAsync, m_pModel, AssestDirectoryRelPath, m_pMaterial);
@@ -244,12 +260,60 @@ namespace Insight {
 			GeometryManager::UnRegisterOpaqueModel(m_pModel);
 		}
 
-		bool StaticMeshComponent::OnEventTranslation(TranslationEvent& e)
+		void StaticMeshComponent::OnRemovedDuringPlay()
 		{
-			if(m_pModel)
-				m_pModel->CalculateParent(e.TranslationInfo.WorldMat);
+			if (!m_pModel)
+				return;
+
+			if (m_pMaterial->GetMaterialType() == Material::eMaterialType::eMaterialType_Translucent) {
+				GeometryManager::UnRegisterTranslucentModel(m_pModel);
+			}
+			else {
+				GeometryManager::UnRegisterOpaqueModel(m_pModel);
+			}
+		}
+
+		void StaticMeshComponent::OnRestoredAfterPlay()
+		{
+			if (m_pModel)
+				RegisterModel();
+		}
+
+		void StaticMeshComponent::RegisterModel()
+		{
+			Material::eMaterialType MaterialType = m_pMaterial->GetMaterialType();
+
+			if (MaterialType == Material::eMaterialType::eMaterialType_Opaque) {
+				GeometryManager::RegisterOpaqueModel(m_pModel);
+			}
+			else if (MaterialType == Material::eMaterialType::eMaterialType_Translucent) {
+				GeometryManager::RegisterTranslucentModel(m_pModel);
+			}
+		}
+
+		void StaticMeshComponent::BindModel()
+		{
+			ECS::World& World = m_pOwner->GetWorld();
+			const ECS::Entity Entity = m_pOwner->GetEntity();
+			ECS::StaticMeshModels* pMeshes = World.GetComponent<ECS::StaticMeshModels>(Entity);
+			if (!pMeshes)
+				pMeshes = &World.AddComponent<ECS::StaticMeshModels>(Entity);
+			pMeshes->Models.push_back(m_pModel.get());
+
+			// Put the new model under the actor's current world matrix on the next update.
+			if (ECS::WorldTransform* pWorldTransform = World.GetComponent<ECS::WorldTransform>(Entity))
+				pWorldTransform->Changed = true;
+		}
+
+		void StaticMeshComponent::UnbindModel()
+		{
+			ECS::StaticMeshModels* pMeshes = m_pOwner->GetWorld().GetComponent<ECS::StaticMeshModels>(m_pOwner->GetEntity());
+			if (!pMeshes)
+				return;
 
-			return false;
+			auto Iter = std::find(pMeshes->Models.begin(), pMeshes->Models.end(), m_pModel.get());
+			if (Iter != pMeshes->Models.end())
+				pMeshes->Models.erase(Iter);
 		}
 
 	} // end namespace Runtime
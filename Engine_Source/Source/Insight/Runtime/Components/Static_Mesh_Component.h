@@ -13,6 +13,7 @@ namespace Insight {
 
 		class INSIGHT_API StaticMeshComponent : public ActorComponent
 		{
+			IE_DECLARE_POOLED_CLASS(StaticMeshComponent)
 		public:
 			struct EventData
 			{
@@ -51,6 +52,9 @@ namespace Insight {
 			virtual void OnAttach() override;
 			virtual void OnDetach() override;
 
+			virtual void OnRemovedDuringPlay() override;
+			virtual void OnRestoredAfterPlay() override;
+
 			inline void SetPosition(ieVector3& Pos) { m_pModel->GetMeshRootTransformRef().SetPosition(Pos.x, Pos.y, Pos.z); }
 			inline void SetRotation(ieVector3& Rot) { m_pModel->GetMeshRootTransformRef().SetRotation(Rot.x, Rot.y, Rot.z); }
 			inline void SetScale(ieVector3& Sca) { m_pModel->GetMeshRootTransformRef().SetScale(Sca.x, Sca.y, Sca.z); }
@@ -59,7 +63,11 @@ namespace Insight {
 			inline void SetRotation(float X, float Y, float Z) { m_pModel->GetMeshRootTransformRef().SetRotation(X, Y, Z); }
 			inline void SetScale(float X, float Y, float Z) { m_pModel->GetMeshRootTransformRef().SetScale(X, Y, Z); }
 		private:
-			bool OnEventTranslation(TranslationEvent& e);
+			// Hand the model to the geometry manager list matching its material.
+			void RegisterModel();
+			// Add the model to the owning actor's ECS::StaticMeshModels, the TransformSystem moves it with the actor from then on.
+			void BindModel();
+			void UnbindModel();
 
 		private:
 			std::string m_DynamicAssetDir;
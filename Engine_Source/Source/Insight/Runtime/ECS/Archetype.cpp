@@ -0,0 +1,163 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Archetype.h"
+
+namespace Insight {
+
+	namespace Runtime {
+
+		namespace ECS {
+
+			static inline uint32_t AlignUp(uint32_t Value, uint32_t Alignment)
+			{
+				return (Value + Alignment - 1u) & ~(Alignment - 1u);
+			}
+
+			Archetype::Archetype(const std::vector<const ComponentTypeInfo*>& SortedTypes)
+				: m_ComponentTypes(SortedTypes)
+			{
+				// Work out how many entities fit in a chunk. Account for the worst case
+				// padding between columns so the layout below always fits.
+				uint32_t RowSize = sizeof(Entity);
+				uint32_t PaddingBudget = 0u;
+				for (const ComponentTypeInfo* pType : m_ComponentTypes)
+				{
+					RowSize += pType->Size;
+					PaddingBudget += pType->Alignment;
+				}
+
+				m_ChunkCapacity = (ChunkSizeInBytes > PaddingBudget) ? (ChunkSizeInBytes - PaddingBudget) / RowSize : 0u;
+				if (m_ChunkCapacity == 0u)
+					m_ChunkCapacity = 1u;
+
+				// Lay out the columns. Entity handles always come first.
+				m_ColumnOffsets.reserve(m_ComponentTypes.size());
+				uint32_t Offset = sizeof(Entity) * m_ChunkCapacity;
+				for (const ComponentTypeInfo* pType : m_ComponentTypes)
+				{
+					Offset = AlignUp(Offset, pType->Alignment);
+					m_ColumnOffsets.push_back(Offset);
+					Offset += pType->Size * m_ChunkCapacity;
+				}
+				m_ChunkAllocationSize = AlignUp(Offset, ChunkAlignment);
+			}
+
+			Archetype::~Archetype()
+			{
+				for (Chunk& CurrentChunk : m_Chunks)
+				{
+					for (uint32_t Column = 0; Column < GetNumColumns(); ++Column)
+					{
+						const ComponentTypeInfo* pType = m_ComponentTypes[Column];
+						uint8_t* pColumn = static_cast<uint8_t*>(GetColumnData(CurrentChunk, Column));
+						for (uint32_t Row = 0; Row < CurrentChunk.Count; ++Row)
+						{
+							pType->Destruct(pColumn + (static_cast<size_t>(Row) * pType->Size));
+						}
+					}
+					FreeChunk(CurrentChunk);
+				}
+				m_Chunks.clear();
+			}
+
+			int32_t Archetype::GetColumnIndex(ComponentTypeId TypeId) const
+			{
+				// Types are sorted by id. Archetypes rarely have more than a handful of columns
+				// so a binary search over the small array is plenty fast.
+				auto Iter = std::lower_bound(m_ComponentTypes.begin(), m_ComponentTypes.end(), TypeId,
+					[](const ComponentTypeInfo* pType, ComponentTypeId Id) { return pType->Id < Id; });
+
+				if (Iter != m_ComponentTypes.end() && (*Iter)->Id == TypeId)
+					return static_cast<int32_t>(Iter - m_ComponentTypes.begin());
+
+				return -1;
+			}
+
+			bool Archetype::HasAllComponents(const ComponentTypeId* pTypeIds, size_t NumTypeIds) const
+			{
+				for (size_t i = 0; i < NumTypeIds; ++i)
+				{
+					if (!HasComponent(pTypeIds[i]))
+						return false;
+				}
+				return true;
+			}
+
+			Archetype::Location Archetype::AllocateRow(Entity NewEntity)
+			{
+				if (m_Chunks.empty() || m_Chunks.back().Count == m_ChunkCapacity)
+					AllocateChunk();
+
+				Chunk& TargetChunk = m_Chunks.back();
+				Location Loc;
+				Loc.ChunkIndex = static_cast<uint32_t>(m_Chunks.size() - 1);
+				Loc.Row = TargetChunk.Count;
+
+				GetEntities(TargetChunk)[Loc.Row] = NewEntity;
+				TargetChunk.Count++;
+				m_NumEntities++;
+
+				return Loc;
+			}
+
+			Entity Archetype::RemoveRow(const Location& Loc, bool DestructComponents)
+			{
+				IE_ASSERT(Loc.ChunkIndex < m_Chunks.size(), "Trying to remove a row from a chunk that does not exist.");
+
+				Chunk& TargetChunk = m_Chunks[Loc.ChunkIndex];
+				Chunk& LastChunk = m_Chunks.back();
+				const uint32_t LastRow = LastChunk.Count - 1u;
+
+				if (DestructComponents)
+				{
+					for (uint32_t Column = 0; Column < GetNumColumns(); ++Column)
+					{
+						m_ComponentTypes[Column]->Destruct(GetComponentData(Loc, Column));
+					}
+				}
+
+				Entity MovedEntity = INVALID_ENTITY;
+				const bool IsLastRow = (&TargetChunk == &LastChunk) && (Loc.Row == LastRow);
+				if (!IsLastRow)
+				{
+					// Fill the hole with the last entity in the archetype.
+					const Location LastLoc = { static_cast<uint32_t>(m_Chunks.size() - 1), LastRow };
+					for (uint32_t Column = 0; Column < GetNumColumns(); ++Column)
+					{
+						m_ComponentTypes[Column]->Relocate(GetComponentData(Loc, Column), GetComponentData(LastLoc, Column));
+					}
+					MovedEntity = GetEntities(LastChunk)[LastRow];
+					GetEntities(TargetChunk)[Loc.Row] = MovedEntity;
+				}
+
+				LastChunk.Count--;
+				m_NumEntities--;
+
+				if (LastChunk.Count == 0u)
+				{
+					FreeChunk(LastChunk);
+					m_Chunks.pop_back();
+				}
+
+				return MovedEntity;
+			}
+
+			void Archetype::AllocateChunk()
+			{
+				Chunk NewChunk;
+				NewChunk.pData = static_cast<uint8_t*>(::operator new(m_ChunkAllocationSize, std::align_val_t(ChunkAlignment)));
+				NewChunk.Count = 0u;
+				m_Chunks.push_back(NewChunk);
+			}
+
+			void Archetype::FreeChunk(Chunk& TargetChunk)
+			{
+				::operator delete(TargetChunk.pData, std::align_val_t(ChunkAlignment));
+				TargetChunk.pData = nullptr;
+				TargetChunk.Count = 0u;
+			}
+
+		} // end namespace ECS
+	} // end namespace Runtime
+} // end namespace Insight
@@ -0,0 +1,108 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Archetype.h
+	Source - Archetype.cpp
+
+	Purpose:
+	Storage for every entity that owns exactly the same set of component types.
+
+	Description:
+	Entities are packed into fixed size chunks. Each chunk stores its components as
+	contiguous columns (structure of arrays) so systems can walk one component type
+	for many entities without chasing pointers. Removing an entity swaps the last
+	entity of the archetype into the hole so chunks always stay dense.
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+#include "Insight/Runtime/ECS/ECS_Types.h"
+
+namespace Insight {
+
+	namespace Runtime {
+
+		namespace ECS {
+
+			class INSIGHT_API Archetype
+			{
+			public:
+				// Target size of a single chunk. Archetypes with very wide rows will grow this to fit at least one entity.
+				static constexpr uint32_t ChunkSizeInBytes = 16u * 1024u;
+				static constexpr uint32_t ChunkAlignment = 64u;
+
+				struct Chunk
+				{
+					uint8_t* pData = nullptr;
+					uint32_t Count = 0u;
+				};
+
+				// Where an entity lives inside of an archetype.
+				struct Location
+				{
+					uint32_t ChunkIndex;
+					uint32_t Row;
+				};
+
+			public:
+				// @param SortedTypes: Component types stored by this archetype, sorted by ComponentTypeInfo::Id.
+				Archetype(const std::vector<const ComponentTypeInfo*>& SortedTypes);
+				~Archetype();
+
+				Archetype(const Archetype&) = delete;
+				Archetype& operator = (const Archetype&) = delete;
+
+				// Returns the column for a component type. -1 if the archetype does not store the type.
+				int32_t GetColumnIndex(ComponentTypeId TypeId) const;
+				inline bool HasComponent(ComponentTypeId TypeId) const { return GetColumnIndex(TypeId) != -1; }
+				// Returns true if this archetype stores every type in pTypeIds.
+				bool HasAllComponents(const ComponentTypeId* pTypeIds, size_t NumTypeIds) const;
+
+				inline const std::vector<const ComponentTypeInfo*>& GetComponentTypes() const { return m_ComponentTypes; }
+				inline uint32_t GetNumColumns() const { return static_cast<uint32_t>(m_ComponentTypes.size()); }
+				inline uint32_t GetChunkCapacity() const { return m_ChunkCapacity; }
+				inline uint32_t GetNumChunks() const { return static_cast<uint32_t>(m_Chunks.size()); }
+				inline uint32_t GetNumEntities() const { return m_NumEntities; }
+				inline Chunk& GetChunk(uint32_t ChunkIndex) { return m_Chunks[ChunkIndex]; }
+
+				// Returns the entity handles stored in a chunk.
+				inline Entity* GetEntities(const Chunk& TargetChunk) const { return reinterpret_cast<Entity*>(TargetChunk.pData); }
+				// Returns the first element of a column inside of a chunk.
+				inline void* GetColumnData(const Chunk& TargetChunk, uint32_t ColumnIndex) const { return TargetChunk.pData + m_ColumnOffsets[ColumnIndex]; }
+				// Returns a pointer to a single component.
+				inline void* GetComponentData(const Location& Loc, uint32_t ColumnIndex) const
+				{
+					return static_cast<uint8_t*>(GetColumnData(m_Chunks[Loc.ChunkIndex], ColumnIndex)) + (static_cast<size_t>(Loc.Row) * m_ComponentTypes[ColumnIndex]->Size);
+				}
+
+				// Reserves a row at the end of the archetype for an entity. Component memory in the row is left uninitialized.
+				Location AllocateRow(Entity NewEntity);
+				/*
+					Removes a row by moving the last row of the archetype into it.
+					@param Loc: The row to remove.
+					@param DestructComponents: If true, the components in the removed row are destroyed. Pass false when they have already been relocated.
+					@return The entity that was moved into Loc. INVALID_ENTITY if the removed row was the last row.
+				*/
+				Entity RemoveRow(const Location& Loc, bool DestructComponents);
+
+				// Cached archetype graph edges. Adding/removing a component type from an entity in this archetype leads to the edge target.
+				std::unordered_map<ComponentTypeId, Archetype*> AddEdges;
+				std::unordered_map<ComponentTypeId, Archetype*> RemoveEdges;
+
+			private:
+				void AllocateChunk();
+				void FreeChunk(Chunk& TargetChunk);
+
+			private:
+				std::vector<const ComponentTypeInfo*> m_ComponentTypes;
+				std::vector<uint32_t> m_ColumnOffsets;
+				std::vector<Chunk> m_Chunks;
+
+				uint32_t m_ChunkCapacity = 0u;
+				uint32_t m_ChunkAllocationSize = 0u;
+				uint32_t m_NumEntities = 0u;
+			};
+
+		} // end namespace ECS
+	} // end namespace Runtime
+} // end namespace Insight
@@ -0,0 +1,118 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#pragma once
+
+#include <Insight/Core.h>
+
+#include <new>
+
+namespace Insight {
+
+	namespace Runtime {
+
+		namespace ECS {
+
+			class World;
+
+			// Unique identifier for a component type. Generated at compile time from the type's name.
+			typedef uint64_t ComponentTypeId;
+
+			constexpr ComponentTypeId INVALID_COMPONENT_TYPE_ID = 0u;
+
+			/*
+				Handle to an entity living inside of an ECS::World.
+				@param Index: Slot in the world's entity record table.
+				@param Generation: Incremented each time the slot is recycled so stale handles can be detected.
+			*/
+			struct Entity
+			{
+				uint32_t Index = UINT32_MAX;
+				uint32_t Generation = 0u;
+
+				inline bool IsValid() const { return Index != UINT32_MAX; }
+
+				bool operator == (const Entity& Other) const { return Index == Other.Index && Generation == Other.Generation; }
+				bool operator != (const Entity& Other) const { return !(*this == Other); }
+			};
+
+			constexpr Entity INVALID_ENTITY = {};
+
+			namespace Internal {
+
+				// FNV-1a hash of a null terminated string. Usable in constant expressions.
+				constexpr uint64_t HashTypeName(const char* Name)
+				{
+					uint64_t Hash = 14695981039346656037ull;
+					while (*Name != '\0')
+					{
+						Hash ^= static_cast<uint64_t>(static_cast<uint8_t>(*Name++));
+						Hash *= 1099511628211ull;
+					}
+					return Hash;
+				}
+
+				template <typename ComponentType>
+				constexpr ComponentTypeId GetComponentTypeIdImpl()
+				{
+#if defined (_MSC_VER)
+					return HashTypeName(__FUNCSIG__);
+#else
+					return HashTypeName(__PRETTY_FUNCTION__);
+#endif
+				}
+
+			} // end namespace Internal
+
+			// Returns the compile-time type id for a component type.
+			template <typename ComponentType>
+			constexpr ComponentTypeId GetComponentTypeId()
+			{
+				using RawType = std::remove_cv_t<std::remove_reference_t<ComponentType>>;
+				constexpr ComponentTypeId Id = Internal::GetComponentTypeIdImpl<RawType>();
+				static_assert(Id != INVALID_COMPONENT_TYPE_ID, "Component type hashed to the invalid id.");
+				return Id;
+			}
+
+			/*
+				Type-erased description of a component type. Archetypes use this to lay out
+				their chunk columns and to move/destroy components without knowing their type.
+			*/
+			struct ComponentTypeInfo
+			{
+				ComponentTypeId Id;
+				uint32_t Size;
+				uint32_t Alignment;
+				// Move-construct a component from pSource into uninitialized memory at pDestination, then destroy pSource.
+				void(*Relocate)(void* pDestination, void* pSource);
+				// Destroy a component in place.
+				void(*Destruct)(void* pComponent);
+			};
+
+			// Returns the static type info for a component type.
+			template <typename ComponentType>
+			const ComponentTypeInfo& GetComponentTypeInfo()
+			{
+				static_assert(std::is_move_constructible<ComponentType>::value, "ECS components must be move constructible.");
+				static_assert(!std::is_pointer<ComponentType>::value, "ECS components are stored by value. Store the data a system reads, not a pointer to it.");
+
+				static const ComponentTypeInfo s_Info =
+				{
+					GetComponentTypeId<ComponentType>(),
+					static_cast<uint32_t>(sizeof(ComponentType)),
+					static_cast<uint32_t>(alignof(ComponentType)),
+					[](void* pDestination, void* pSource)
+					{
+						ComponentType* pSrc = static_cast<ComponentType*>(pSource);
+						new (pDestination) ComponentType(std::move(*pSrc));
+						pSrc->~ComponentType();
+					},
+					[](void* pComponent)
+					{
+						static_cast<ComponentType*>(pComponent)->~ComponentType();
+					}
+				};
+				return s_Info;
+			}
+
+		} // end namespace ECS
+	} // end namespace Runtime
+} // end namespace Insight
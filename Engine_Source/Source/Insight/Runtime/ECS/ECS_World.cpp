@@ -0,0 +1,282 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "ECS_World.h"
+
+namespace Insight {
+
+	namespace Runtime {
+
+		namespace ECS {
+
+			World* World::s_pActive = nullptr;
+
+			World::World()
+			{
+				if (!s_pActive)
+					s_pActive = this;
+
+				m_pEmptyArchetype = FindOrCreateArchetype({});
+			}
+
+			World::~World()
+			{
+				Clear();
+				if (s_pActive == this)
+					s_pActive = nullptr;
+			}
+
+			void World::Clear()
+			{
+				m_QueryCaches.clear();
+				m_ArchetypeLookup.clear();
+				m_Archetypes.clear();
+				m_EntityRecords.clear();
+				m_FreeEntityIndices.clear();
+				m_NumLivingEntities = 0u;
+
+				m_pEmptyArchetype = FindOrCreateArchetype({});
+			}
+
+			Entity World::CreateEntity()
+			{
+				uint32_t Index;
+				if (!m_FreeEntityIndices.empty())
+				{
+					Index = m_FreeEntityIndices.back();
+					m_FreeEntityIndices.pop_back();
+				}
+				else
+				{
+					Index = static_cast<uint32_t>(m_EntityRecords.size());
+					m_EntityRecords.emplace_back();
+				}
+
+				EntityRecord& Record = m_EntityRecords[Index];
+				Entity NewEntity = { Index, Record.Generation };
+
+				Record.Alive = true;
+				Record.pArchetype = m_pEmptyArchetype;
+				Record.Loc = m_pEmptyArchetype->AllocateRow(NewEntity);
+
+				m_NumLivingEntities++;
+				return NewEntity;
+			}
+
+			void World::DestroyEntity(Entity Target)
+			{
+				if (!IsAlive(Target))
+					return;
+
+				EntityRecord& Record = m_EntityRecords[Target.Index];
+				Entity MovedEntity = Record.pArchetype->RemoveRow(Record.Loc, true);
+				if (MovedEntity.IsValid())
+					PatchMovedEntity(MovedEntity, Record.Loc);
+
+				Record.Alive = false;
+				Record.pArchetype = nullptr;
+				Record.Generation++;
+				m_FreeEntityIndices.push_back(Target.Index);
+				m_NumLivingEntities--;
+			}
+
+			bool World::IsAlive(Entity Target) const
+			{
+				return Target.Index < m_EntityRecords.size()
+					&& m_EntityRecords[Target.Index].Alive
+					&& m_EntityRecords[Target.Index].Generation == Target.Generation;
+			}
+
+			void* World::AddComponentUninitialized(Entity Target, const ComponentTypeInfo& TypeInfo)
+			{
+				IE_ASSERT(IsAlive(Target), "Trying to add a component to an entity that does not exist.");
+
+				EntityRecord& Record = m_EntityRecords[Target.Index];
+				Archetype* pCurrent = Record.pArchetype;
+
+				const int32_t ExistingColumn = pCurrent->GetColumnIndex(TypeInfo.Id);
+				if (ExistingColumn != -1)
+				{
+					// Replace the existing component in place.
+					void* pExisting = pCurrent->GetComponentData(Record.Loc, static_cast<uint32_t>(ExistingColumn));
+					TypeInfo.Destruct(pExisting);
+					return pExisting;
+				}
+
+				// Follow the cached edge or build the destination archetype.
+				Archetype* pTarget = nullptr;
+				auto EdgeIter = pCurrent->AddEdges.find(TypeInfo.Id);
+				if (EdgeIter != pCurrent->AddEdges.end())
+				{
+					pTarget = (*EdgeIter).second;
+				}
+				else
+				{
+					std::vector<const ComponentTypeInfo*> NewTypes = pCurrent->GetComponentTypes();
+					auto InsertPos = std::lower_bound(NewTypes.begin(), NewTypes.end(), TypeInfo.Id,
+						[](const ComponentTypeInfo* pType, ComponentTypeId Id) { return pType->Id < Id; });
+					NewTypes.insert(InsertPos, &TypeInfo);
+
+					pTarget = FindOrCreateArchetype(NewTypes);
+					pCurrent->AddEdges[TypeInfo.Id] = pTarget;
+					pTarget->RemoveEdges[TypeInfo.Id] = pCurrent;
+				}
+
+				MoveEntity(Record, Target, pTarget);
+				return pTarget->GetComponentData(Record.Loc, static_cast<uint32_t>(pTarget->GetColumnIndex(TypeInfo.Id)));
+			}
+
+			void World::RemoveComponentById(Entity Target, ComponentTypeId TypeId)
+			{
+				if (!IsAlive(Target))
+					return;
+
+				EntityRecord& Record = m_EntityRecords[Target.Index];
+				Archetype* pCurrent = Record.pArchetype;
+
+				const int32_t Column = pCurrent->GetColumnIndex(TypeId);
+				if (Column == -1)
+					return;
+
+				Archetype* pTarget = nullptr;
+				auto EdgeIter = pCurrent->RemoveEdges.find(TypeId);
+				if (EdgeIter != pCurrent->RemoveEdges.end())
+				{
+					pTarget = (*EdgeIter).second;
+				}
+				else
+				{
+					std::vector<const ComponentTypeInfo*> NewTypes = pCurrent->GetComponentTypes();
+					NewTypes.erase(NewTypes.begin() + Column);
+
+					pTarget = FindOrCreateArchetype(NewTypes);
+					pCurrent->RemoveEdges[TypeId] = pTarget;
+					pTarget->AddEdges[TypeId] = pCurrent;
+				}
+
+				// The removed component does not exist in the target archetype so MoveEntity
+				// will not relocate it. Destroy it before the row is recycled.
+				pCurrent->GetComponentTypes()[Column]->Destruct(pCurrent->GetComponentData(Record.Loc, static_cast<uint32_t>(Column)));
+				MoveEntity(Record, Target, pTarget);
+			}
+
+			void* World::GetComponentById(Entity Target, ComponentTypeId TypeId)
+			{
+				if (!IsAlive(Target))
+					return nullptr;
+
+				const EntityRecord& Record = m_EntityRecords[Target.Index];
+				const int32_t Column = Record.pArchetype->GetColumnIndex(TypeId);
+				if (Column == -1)
+					return nullptr;
+
+				return Record.pArchetype->GetComponentData(Record.Loc, static_cast<uint32_t>(Column));
+			}
+
+			void World::MoveEntity(EntityRecord& Record, Entity Target, Archetype* pNewArchetype)
+			{
+				Archetype* pOldArchetype = Record.pArchetype;
+				const Archetype::Location OldLoc = Record.Loc;
+				const Archetype::Location NewLoc = pNewArchetype->AllocateRow(Target);
+
+				// Relocate every component both archetypes share. Both type lists are
+				// sorted so a single merge pass finds the matching columns.
+				const std::vector<const ComponentTypeInfo*>& OldTypes = pOldArchetype->GetComponentTypes();
+				const std::vector<const ComponentTypeInfo*>& NewTypes = pNewArchetype->GetComponentTypes();
+				uint32_t OldColumn = 0u, NewColumn = 0u;
+				while (OldColumn < OldTypes.size() && NewColumn < NewTypes.size())
+				{
+					if (OldTypes[OldColumn]->Id == NewTypes[NewColumn]->Id)
+					{
+						NewTypes[NewColumn]->Relocate(pNewArchetype->GetComponentData(NewLoc, NewColumn), pOldArchetype->GetComponentData(OldLoc, OldColumn));
+						OldColumn++;
+						NewColumn++;
+					}
+					else if (OldTypes[OldColumn]->Id < NewTypes[NewColumn]->Id)
+					{
+						OldColumn++;
+					}
+					else
+					{
+						NewColumn++;
+					}
+				}
+
+				// The old row now only holds relocated (destroyed) components, remove it without destructing again.
+				Entity MovedEntity = pOldArchetype->RemoveRow(OldLoc, false);
+				if (MovedEntity.IsValid())
+					PatchMovedEntity(MovedEntity, OldLoc);
+
+				Record.pArchetype = pNewArchetype;
+				Record.Loc = NewLoc;
+			}
+
+			void World::PatchMovedEntity(Entity MovedEntity, const Archetype::Location& NewLoc)
+			{
+				m_EntityRecords[MovedEntity.Index].Loc = NewLoc;
+			}
+
+			Archetype* World::FindOrCreateArchetype(const std::vector<const ComponentTypeInfo*>& SortedTypes)
+			{
+				const uint64_t Hash = HashTypeSet(SortedTypes);
+
+				auto Range = m_ArchetypeLookup.equal_range(Hash);
+				for (auto Iter = Range.first; Iter != Range.second; ++Iter)
+				{
+					if ((*Iter).second->GetComponentTypes() == SortedTypes)
+						return (*Iter).second;
+				}
+
+				m_Archetypes.push_back(std::make_unique<Archetype>(SortedTypes));
+				Archetype* pNewArchetype = m_Archetypes.back().get();
+				m_ArchetypeLookup.insert({ Hash, pNewArchetype });
+				return pNewArchetype;
+			}
+
+			const std::vector<Archetype*>& World::GetMatchingArchetypes(const ComponentTypeId* pTypeIds, size_t NumTypeIds)
+			{
+				// The same set of types in a different order is the same query.
+				ComponentTypeId SortedIds[32];
+				IE_ASSERT(NumTypeIds <= _countof(SortedIds), "Too many component types in ECS query.");
+				std::copy(pTypeIds, pTypeIds + NumTypeIds, SortedIds);
+				std::sort(SortedIds, SortedIds + NumTypeIds);
+
+				QueryCache& Cache = m_QueryCaches[HashTypeIds(SortedIds, NumTypeIds)];
+				if (Cache.TypeIds.empty())
+					Cache.TypeIds.assign(SortedIds, SortedIds + NumTypeIds);
+
+				// Only test archetypes that were created since the last time this query ran.
+				for (; Cache.NumArchetypesTested < m_Archetypes.size(); ++Cache.NumArchetypesTested)
+				{
+					Archetype* pArchetype = m_Archetypes[Cache.NumArchetypesTested].get();
+					if (pArchetype->HasAllComponents(Cache.TypeIds.data(), Cache.TypeIds.size()))
+						Cache.Matches.push_back(pArchetype);
+				}
+				return Cache.Matches;
+			}
+
+			uint64_t World::HashTypeSet(const std::vector<const ComponentTypeInfo*>& SortedTypes)
+			{
+				uint64_t Hash = 14695981039346656037ull;
+				for (const ComponentTypeInfo* pType : SortedTypes)
+				{
+					Hash ^= pType->Id;
+					Hash *= 1099511628211ull;
+				}
+				return Hash;
+			}
+
+			uint64_t World::HashTypeIds(const ComponentTypeId* pTypeIds, size_t NumTypeIds)
+			{
+				uint64_t Hash = 14695981039346656037ull;
+				for (size_t i = 0; i < NumTypeIds; ++i)
+				{
+					Hash ^= pTypeIds[i];
+					Hash *= 1099511628211ull;
+				}
+				return Hash;
+			}
+
+		} // end namespace ECS
+	} // end namespace Runtime
+} // end namespace Insight
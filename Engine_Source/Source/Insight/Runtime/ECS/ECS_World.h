@@ -0,0 +1,179 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - ECS_World.h
+	Source - ECS_World.cpp
+
+	Purpose:
+	Owns every entity and archetype for a scene and provides typed queries over them.
+
+	Description:
+	Components are plain data stored by value, grouped by archetype (the exact set of component
+	types an entity owns). Adding or removing a component moves the entity to a new archetype,
+	following cached graph edges so the lookup is only paid once per transition.
+	Each scene owns its own world. The active world is the one new actors create their entity in,
+	an actor keeps using the world it was created in (see AActor::GetWorld).
+
+	Example Usage:
+	ECS::World& World = pActor->GetWorld();
+	World.ForEachChunk<WorldTransform, StaticMeshModels>([](uint32_t Count, const ECS::Entity* pEntities, WorldTransform* pTransforms, StaticMeshModels* pMeshes)
+	{
+		for (uint32_t i = 0; i < Count; ++i) { ... }
+	});
+	See TransformSystem.
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+#include "Insight/Runtime/ECS/ECS_Types.h"
+#include "Insight/Runtime/ECS/Archetype.h"
+
+namespace Insight {
+
+	namespace Runtime {
+
+		namespace ECS {
+
+			class INSIGHT_API World
+			{
+			public:
+				World();
+				~World();
+
+				World(const World&) = delete;
+				World& operator = (const World&) = delete;
+
+				// Get the active ECS world, the one new actors are created in.
+				inline static World& Get() { IE_ASSERT(s_pActive, "No ECS world has been created!"); return *s_pActive; }
+				// Returns true if an ECS world is active.
+				inline static bool IsInitialized() { return s_pActive != nullptr; }
+				// Create new actors in this world, Ex. when the scene that owns it is loaded. The first world created is active until then.
+				inline void MakeActive() { s_pActive = this; }
+
+				// Create an entity with no components.
+				Entity CreateEntity();
+				// Destroy an entity and all of its components. Stale handles are ignored.
+				void DestroyEntity(Entity Target);
+				// Returns true if the handle refers to a living entity.
+				bool IsAlive(Entity Target) const;
+				// Returns the number of living entities.
+				inline uint32_t GetNumEntities() const { return m_NumLivingEntities; }
+				inline uint32_t GetNumArchetypes() const { return static_cast<uint32_t>(m_Archetypes.size()); }
+
+				// Add a component to an entity, constructing it in place with Args. If the entity already has one it is replaced.
+				template <typename ComponentType, typename ... Args>
+				ComponentType& AddComponent(Entity Target, Args&& ... ConstructionArgs)
+				{
+					const ComponentTypeInfo& TypeInfo = GetComponentTypeInfo<ComponentType>();
+					void* pMemory = AddComponentUninitialized(Target, TypeInfo);
+					return *(new (pMemory) ComponentType(std::forward<Args>(ConstructionArgs)...));
+				}
+
+				// Remove a component from an entity. Does nothing if the entity does not own one.
+				template <typename ComponentType>
+				void RemoveComponent(Entity Target) { RemoveComponentById(Target, GetComponentTypeId<ComponentType>()); }
+				void RemoveComponentById(Entity Target, ComponentTypeId TypeId);
+
+				// Returns a pointer to an entity's component. nullptr if the entity does not own one.
+				template <typename ComponentType>
+				ComponentType* GetComponent(Entity Target) { return static_cast<ComponentType*>(GetComponentById(Target, GetComponentTypeId<ComponentType>())); }
+				void* GetComponentById(Entity Target, ComponentTypeId TypeId);
+
+				template <typename ComponentType>
+				bool HasComponent(Entity Target) { return GetComponentById(Target, GetComponentTypeId<ComponentType>()) != nullptr; }
+
+				/*
+					Invoke a function for every chunk that contains all of the requested component types.
+					@param Func: Callable with the signature void(uint32_t Count, const Entity* pEntities, ComponentTypes* ...)
+				*/
+				template <typename ... ComponentTypes, typename Fn>
+				void ForEachChunk(Fn&& Func)
+				{
+					static_assert(sizeof...(ComponentTypes) > 0, "ECS queries require at least one component type.");
+					static constexpr ComponentTypeId TypeIds[] = { GetComponentTypeId<ComponentTypes>()... };
+					const std::vector<Archetype*>& Matches = GetMatchingArchetypes(TypeIds, sizeof...(ComponentTypes));
+
+					for (Archetype* pArchetype : Matches)
+					{
+						const int32_t Columns[] = { pArchetype->GetColumnIndex(GetComponentTypeId<ComponentTypes>())... };
+						for (uint32_t ChunkIndex = 0; ChunkIndex < pArchetype->GetNumChunks(); ++ChunkIndex)
+						{
+							Archetype::Chunk& CurrentChunk = pArchetype->GetChunk(ChunkIndex);
+							InvokeChunk<ComponentTypes...>(Func, *pArchetype, CurrentChunk, Columns, std::index_sequence_for<ComponentTypes...>{});
+						}
+					}
+				}
+
+				/*
+					Invoke a function for every entity that owns all of the requested component types.
+					@param Func: Callable with the signature void(Entity, ComponentTypes& ...)
+				*/
+				template <typename ... ComponentTypes, typename Fn>
+				void ForEach(Fn&& Func)
+				{
+					ForEachChunk<ComponentTypes...>([&Func](uint32_t Count, const Entity* pEntities, ComponentTypes* ... pColumns)
+					{
+						for (uint32_t i = 0; i < Count; ++i)
+						{
+							Func(pEntities[i], pColumns[i]...);
+						}
+					});
+				}
+
+				// Destroy every entity and archetype.
+				void Clear();
+
+			private:
+				struct EntityRecord
+				{
+					Archetype* pArchetype = nullptr;
+					Archetype::Location Loc = { 0u, 0u };
+					uint32_t Generation = 0u;
+					bool Alive = false;
+				};
+
+				struct QueryCache
+				{
+					std::vector<ComponentTypeId> TypeIds;
+					std::vector<Archetype*> Matches;
+					// Number of archetypes that have been tested against this query.
+					size_t NumArchetypesTested = 0u;
+				};
+
+			private:
+				void* AddComponentUninitialized(Entity Target, const ComponentTypeInfo& TypeInfo);
+				Archetype* FindOrCreateArchetype(const std::vector<const ComponentTypeInfo*>& SortedTypes);
+				// Move an entity's shared components into a new archetype and update its record.
+				void MoveEntity(EntityRecord& Record, Entity Target, Archetype* pNewArchetype);
+				void PatchMovedEntity(Entity MovedEntity, const Archetype::Location& NewLoc);
+				const std::vector<Archetype*>& GetMatchingArchetypes(const ComponentTypeId* pTypeIds, size_t NumTypeIds);
+
+				template <typename ... ComponentTypes, typename Fn, size_t ... Indices>
+				inline void InvokeChunk(Fn& Func, Archetype& TargetArchetype, Archetype::Chunk& TargetChunk, const int32_t* pColumns, std::index_sequence<Indices...>)
+				{
+					Func(TargetChunk.Count, TargetArchetype.GetEntities(TargetChunk),
+						static_cast<ComponentTypes*>(TargetArchetype.GetColumnData(TargetChunk, static_cast<uint32_t>(pColumns[Indices])))...);
+				}
+
+				static uint64_t HashTypeSet(const std::vector<const ComponentTypeInfo*>& SortedTypes);
+				static uint64_t HashTypeIds(const ComponentTypeId* pTypeIds, size_t NumTypeIds);
+
+			private:
+				std::vector<EntityRecord> m_EntityRecords;
+				std::vector<uint32_t> m_FreeEntityIndices;
+				uint32_t m_NumLivingEntities = 0u;
+
+				std::vector<std::unique_ptr<Archetype>> m_Archetypes;
+				// Archetypes keyed by a hash of their sorted type ids. Collisions are resolved by comparing the type lists.
+				std::unordered_multimap<uint64_t, Archetype*> m_ArchetypeLookup;
+				Archetype* m_pEmptyArchetype = nullptr;
+
+				std::unordered_map<uint64_t, QueryCache> m_QueryCaches;
+
+			private:
+				static World* s_pActive;
+			};
+
+		} // end namespace ECS
+	} // end namespace Runtime
+} // end namespace Insight
@@ -0,0 +1,34 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Transform_System.h"
+
+#include "Insight/Runtime/ECS/ECS_World.h"
+#include "Insight/Rendering/Geometry/Model.h"
+
+namespace Insight {
+
+	namespace Runtime {
+
+		namespace ECS {
+
+			void TransformSystem::Update(World& TargetWorld)
+			{
+				TargetWorld.ForEachChunk<WorldTransform, StaticMeshModels>([](uint32_t Count, const Entity*, WorldTransform* pTransforms, StaticMeshModels* pMeshes)
+				{
+					for (uint32_t i = 0; i < Count; ++i)
+					{
+						if (!pTransforms[i].Changed)
+							continue;
+
+						const ieMatrix ParentMatrix = Math::ToPlatformMatrix(pTransforms[i].Matrix);
+						for (Model* pModel : pMeshes[i].Models)
+							pModel->CalculateParent(ParentMatrix);
+						pTransforms[i].Changed = false;
+					}
+				});
+			}
+
+		} // end namespace ECS
+	} // end namespace Runtime
+} // end namespace Insight
@@ -0,0 +1,65 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Transform_System.h
+	Source - Transform_System.cpp
+
+	Purpose:
+	Moves the static meshes of the actors whose transform changed, in one pass over the ECS chunks.
+
+	Description:
+	Every actor with a scene component owns a WorldTransform, stored by value in its entity. When the
+	actor's root scene component rebuilds its world matrix it writes the matrix there and flags the
+	row as changed. Other scene components of the actor do not, so the actor has one world matrix.
+	The models of all of an actor's static mesh components are listed in its StaticMeshModels.
+	Once per update, and again after the scene has ticked, Update walks the chunks holding both. The
+	flags and matrices of a chunk are packed next to each other, so an actor that did not move costs
+	one read of its flag, and only the meshes of the actors that moved are touched.
+
+	Example Usage:
+	m_TickManager.Tick(DeltaMs, ViewerPosition);
+	Runtime::ECS::TransformSystem::Update(m_World);
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+#include "Insight/Math/Simd_Math.h"
+
+namespace Insight {
+
+	class Model;
+
+	namespace Runtime {
+
+		namespace ECS {
+
+			class World;
+
+			// World matrix of an actor, written by its root scene component.
+			struct WorldTransform
+			{
+				Math::Simd::Matrix Matrix = Math::Simd::MatrixIdentity();
+				// Set when Matrix is written or a model is added, cleared once the actor's static meshes have been moved.
+				bool Changed = false;
+			};
+
+			// The models of every static mesh component of an actor, in the order they were attached.
+			struct StaticMeshModels
+			{
+				std::vector<Model*> Models;
+			};
+
+			class INSIGHT_API TransformSystem
+			{
+			public:
+				// Move the static meshes of every actor whose WorldTransform changed since the last call. Called on the game thread.
+				static void Update(World& TargetWorld);
+
+			private:
+				TransformSystem() = default;
+				~TransformSystem() = default;
+			};
+
+		} // end namespace ECS
+	} // end namespace Runtime
+} // end namespace Insight
@@ -3,17 +3,16 @@
 
 namespace Insight {
 
-	size_t ID::ms_uniqueID = 0;
+	std::atomic<uint64_t> ID::ms_uniqueID = 1u;
 
 	ID::ID()
 	{
 		m_Id = GetUniqueID();
 	}
 
-	std::string ID::GetUniqueID()
+	uint64_t ID::GetUniqueID()
 	{
-		return ("uid_" + std::to_string(ms_uniqueID++));
+		return ms_uniqueID.fetch_add(1u, std::memory_order_relaxed);
 	}
 
 }
-
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 
 #include <Insight/Core.h>
+#include "Insight/Utilities/String_Id.h"
 
 namespace Insight {
 
@@ -18,41 +20,43 @@ namespace Insight {
 	public:
 		ID();
 		ID(const std::string& id)
-			: m_Name(id), m_Id(id), m_Tag(id) {}
+			: m_Name(StringId::Intern(id)), m_Id(StringId::Intern(id).GetHash()), m_Tag(m_Name) {}
 		ID(const char* id)
-			: m_Name(id), m_Id(id), m_Tag(id) {}
+			: m_Name(StringId::Intern(id)), m_Id(StringId::Intern(id).GetHash()), m_Tag(m_Name) {}
 
 		bool operator == (const ID& id) const { return m_Id == id.m_Id; }
 		bool operator != (const ID& id) const { return m_Id != id.m_Id; }
 
 		bool IsValid() const
 		{
-			return (m_Id != "");
+			return (m_Id != 0u);
 		}
 
-		static size_t ms_uniqueID;
-		static std::string GetUniqueID();
-		void SetUniqueID(std::string id) { m_Id = id; }
+		// Unique ids count up from 1 and are handed out from any thread.
+		static std::atomic<uint64_t> ms_uniqueID;
+		static uint64_t GetUniqueID();
+		void SetUniqueID(uint64_t id) { m_Id = id; }
+		uint64_t GetUniqueIDValue() const { return m_Id; }
 
-		std::string& GetName() { return m_Name; }
-		void SetName(std::string name) { m_Name = name; }
+		// Names, types and tags are interned, comparing them compares integers. See StringId::GetString to display them.
+		StringId GetName() const { return m_Name; }
+		void SetName(const std::string& name) { m_Name = StringId::Intern(name); }
 
-		std::string& GetType() { return m_Type; }
-		void SetType(std::string type) { m_Type = type; }
+		StringId GetType() const { return m_Type; }
+		void SetType(const std::string& type) { m_Type = StringId::Intern(type); }
 
-		std::string& GetTag() { return m_Tag; }
-		void SetTag(std::string tag) { m_Tag = tag; }
+		StringId GetTag() const { return m_Tag; }
+		void SetTag(const std::string& tag) { m_Tag = StringId::Intern(tag); }
 
 		void SetLayer(const int& layer) { m_Layer = layer; }
 		int GetLayer() const { return m_Layer; }
 
 	protected:
-		std::string m_Type;
-		std::string m_Name;
-		std::string m_Id;
-		std::string m_Tag;
-		int m_Layer;
+		StringId m_Type;
+		StringId m_Name;
+		uint64_t m_Id = 0u;
+		StringId m_Tag;
+		int m_Layer = DEFAULT;
 	};
 
 }
-
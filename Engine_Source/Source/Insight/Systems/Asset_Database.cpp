@@ -0,0 +1,519 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Asset_Database.h"
+
+#include "Insight/Systems/Json_Stream_Reader.h"
+#include "Insight/Systems/Mapped_File.h"
+#include "Insight/Utilities/String_Helper.h"
+#include "Insight/Utilities/Xxh64.h"
+
+#include <atomic>
+#include <cctype>
+#include <filesystem>
+#include <map>
+#include <set>
+#include <unordered_set>
+
+namespace Insight {
+
+	namespace {
+
+		const char* const SceneExtension = ".iescene";
+		const char* const MaterialTag = "#material_";
+
+		struct ScannedFile
+		{
+			// Path on disk, in the case it was found in.
+			std::string SourcePath;
+			// Content relative, normalized.
+			std::string Path;
+			uint64_t Hash = 0u;
+		};
+
+		// State shared while the files of one scene are scanned.
+		struct SceneScan
+		{
+			std::string ScenePath;
+			AssetDatabase::Asset* pScene = nullptr;
+			std::unordered_map<std::string, AssetDatabase::Asset>* pAssets = nullptr;
+			// Resources.json texture IDs to texture paths.
+			std::unordered_map<int, std::string> TextureIds;
+		};
+
+		AssetDatabase::AssetType GetTypeFromExtension(const std::string& Path)
+		{
+			std::string Extension = std::filesystem::path(Path).extension().string();
+			for (char& Character : Extension)
+				Character = static_cast<char>(std::tolower(static_cast<unsigned char>(Character)));
+
+			static const char* const ModelExtensions[] = { ".fbx", ".obj", ".gltf", ".glb", ".dae", ".3ds", ".blend" };
+			static const char* const TextureExtensions[] = { ".png", ".jpg", ".jpeg", ".dds", ".hdr", ".tga", ".bmp", ".tif", ".tiff" };
+			for (const char* Model : ModelExtensions)
+				if (Extension == Model)
+					return AssetDatabase::AssetType::Model;
+			for (const char* Texture : TextureExtensions)
+				if (Extension == Texture)
+					return AssetDatabase::AssetType::Texture;
+			return AssetDatabase::AssetType::File;
+		}
+
+		std::string ToHex(uint64_t Value)
+		{
+			char Buffer[17];
+			snprintf(Buffer, sizeof(Buffer), "%016llx", static_cast<unsigned long long>(Value));
+			return Buffer;
+		}
+
+		uint64_t FromHex(const rapidjson::Value& Json, const char* Key)
+		{
+			auto Iter = Json.FindMember(Key);
+			if (Iter == Json.MemberEnd() || !Iter->value.IsString())
+				return 0u;
+			return static_cast<uint64_t>(strtoull(Iter->value.GetString(), nullptr, 16));
+		}
+
+		void AddMaterial(const rapidjson::Value& JsonMaterial, SceneScan& Scan)
+		{
+			// Materials with the same textures and properties are one asset.
+			rapidjson::StringBuffer Buffer;
+			rapidjson::Writer<rapidjson::StringBuffer> Writer(Buffer);
+			JsonMaterial.Accept(Writer);
+			const uint64_t SettingsHash = Xxh64::Hash(Buffer.GetString(), Buffer.GetSize());
+
+			const std::string MaterialPath = Scan.ScenePath + MaterialTag + ToHex(SettingsHash);
+			Scan.pScene->Dependencies.push_back(MaterialPath);
+
+			AssetDatabase::Asset& Material = (*Scan.pAssets)[MaterialPath];
+			if (!Material.Path.empty())
+				return;
+			Material.Path = MaterialPath;
+			Material.Type = AssetDatabase::AssetType::Material;
+			Material.SettingsHash = SettingsHash;
+
+			// "AlbedoMapID", "NormalMapID", ... resolve to the textures listed in Resources.json.
+			static const size_t SuffixLength = strlen("MapID");
+			for (auto Member = JsonMaterial.MemberBegin(); Member != JsonMaterial.MemberEnd(); ++Member)
+			{
+				const size_t NameLength = Member->name.GetStringLength();
+				if (!Member->value.IsInt() || NameLength < SuffixLength || strcmp(Member->name.GetString() + NameLength - SuffixLength, "MapID") != 0)
+					continue;
+
+				auto Texture = Scan.TextureIds.find(Member->value.GetInt());
+				if (Texture != Scan.TextureIds.end())
+					Material.Dependencies.push_back(Texture->second);
+			}
+		}
+
+		// Find the models, textures and materials anywhere in an actor's json, whichever components it has.
+		void ScanActorJson(const rapidjson::Value& Json, SceneScan& Scan)
+		{
+			if (Json.IsString())
+			{
+				const std::string Value(Json.GetString(), Json.GetStringLength());
+				if (GetTypeFromExtension(Value) != AssetDatabase::AssetType::File)
+					Scan.pScene->Dependencies.push_back(StringHelper::NormalizePath(Value));
+			}
+			else if (Json.IsArray())
+			{
+				for (const rapidjson::Value& Element : Json.GetArray())
+					ScanActorJson(Element, Scan);
+			}
+			else if (Json.IsObject())
+			{
+				if (Json.HasMember("AlbedoMapID"))
+					AddMaterial(Json, Scan);
+				for (auto Member = Json.MemberBegin(); Member != Json.MemberEnd(); ++Member)
+					ScanActorJson(Member->value, Scan);
+			}
+		}
+
+		// Scan every record of an Actors.journal, including ones a later save replaced. Packing a few unused assets is
+		// safer than missing one an actor still uses.
+		void ScanJournal(const std::string& JournalPath, SceneScan& Scan)
+		{
+			const FileView View = MappedFile::OpenView(JournalPath);
+			if (!View)
+				return;
+
+			const std::string Data(View.GetChars(), View.GetSize());
+			rapidjson::StringStream Stream(Data.c_str());
+			while (true)
+			{
+				while (Stream.Peek() == ' ' || Stream.Peek() == '\n' || Stream.Peek() == '\r' || Stream.Peek() == '\t')
+					Stream.Take();
+				if (Stream.Peek() == '\0')
+					break;
+
+				rapidjson::Document Record;
+				Record.ParseStream<rapidjson::kParseStopWhenDoneFlag>(Stream);
+				if (Record.HasParseError() || !Record.IsObject())
+					break;
+
+				auto Actor = Record.FindMember("Actor");
+				if (Actor != Record.MemberEnd())
+					ScanActorJson(Actor->value, Scan);
+			}
+		}
+
+		void ScanScene(const std::string& ScenePath, const std::vector<const ScannedFile*>& SceneFiles, std::unordered_map<std::string, AssetDatabase::Asset>& Assets,
+			std::unordered_map<std::string, std::set<uint64_t>>& TextureSettings)
+		{
+			AssetDatabase::Asset& Scene = Assets[ScenePath];
+			Scene.Path = ScenePath;
+			Scene.Type = AssetDatabase::AssetType::Scene;
+
+			SceneScan Scan;
+			Scan.ScenePath = ScenePath;
+			Scan.pScene = &Scene;
+			Scan.pAssets = &Assets;
+
+			// SceneFiles is sorted by path, so the hash does not depend on the order the files were listed in.
+			const ScannedFile* pResources = nullptr;
+			const ScannedFile* pActors = nullptr;
+			const ScannedFile* pJournal = nullptr;
+			for (const ScannedFile* pFile : SceneFiles)
+			{
+				Scene.SourceHash = Xxh64::Combine(Scene.SourceHash, pFile->Hash);
+				Scene.Dependencies.push_back(pFile->Path);
+
+				const std::string Name = pFile->Path.substr(ScenePath.size());
+				if (Name == "/resources.json")
+					pResources = pFile;
+				else if (Name == "/actors.json")
+					pActors = pFile;
+				else if (Name == "/actors.journal")
+					pJournal = pFile;
+			}
+
+			std::vector<JsonStream::TextureResource> Textures;
+			if (pResources && JsonStream::ReadTextureResources(pResources->SourcePath.c_str(), Textures))
+			{
+				for (const JsonStream::TextureResource& Texture : Textures)
+				{
+					const std::string TexturePath = StringHelper::NormalizePath(Texture.Filepath);
+					Scene.Dependencies.push_back(TexturePath);
+					Scan.TextureIds[Texture.ID] = TexturePath;
+
+					const uint64_t Settings[] = { static_cast<uint64_t>(Texture.Type), static_cast<uint64_t>(Texture.GenerateMipMaps) };
+					TextureSettings[TexturePath].insert(Xxh64::Hash(Settings, sizeof(Settings)));
+				}
+			}
+
+			if (pActors)
+			{
+				JsonStream::ReadActors(pActors->SourcePath.c_str(), [&Scan](const JsonStream::ActorHeader&, const rapidjson::Value& JsonActor)
+					{
+						ScanActorJson(JsonActor, Scan);
+						return true;
+					});
+			}
+			if (pJournal)
+				ScanJournal(pJournal->SourcePath, Scan);
+		}
+
+	}
+
+	bool AssetDatabase::Load(const std::string& DatabasePath)
+	{
+		m_Assets.clear();
+
+		const FileView View = MappedFile::OpenView(DatabasePath);
+		if (!View)
+			return false;
+
+		rapidjson::Document Json;
+		Json.Parse(View.GetChars(), View.GetSize());
+		if (Json.HasParseError() || !Json.IsObject())
+		{
+			IE_DEBUG_LOG(LogSeverity::Warning, "Ignoring asset database \"{0}\", it is not valid json.", DatabasePath);
+			return false;
+		}
+
+		int FileVersion = 0;
+		json::get_int(Json, "Version", FileVersion);
+		auto JsonAssets = Json.FindMember("Assets");
+		if (FileVersion != static_cast<int>(Version) || JsonAssets == Json.MemberEnd() || !JsonAssets->value.IsArray())
+		{
+			IE_DEBUG_LOG(LogSeverity::Warning, "Ignoring asset database \"{0}\", it was written by a different version.", DatabasePath);
+			return false;
+		}
+
+		for (const rapidjson::Value& JsonAsset : JsonAssets->value.GetArray())
+		{
+			Asset Loaded;
+			std::string TypeName;
+			json::get_string(JsonAsset, "Path", Loaded.Path);
+			json::get_string(JsonAsset, "Type", TypeName);
+			if (Loaded.Path.empty())
+				continue;
+
+			for (AssetType Type : { AssetType::File, AssetType::Scene, AssetType::Model, AssetType::Texture, AssetType::Material })
+				if (TypeName == GetTypeName(Type))
+					Loaded.Type = Type;
+			Loaded.SourceHash = FromHex(JsonAsset, "SourceHash");
+			Loaded.SettingsHash = FromHex(JsonAsset, "SettingsHash");
+			Loaded.CookedHash = FromHex(JsonAsset, "CookedHash");
+			Loaded.CookedFrom = FromHex(JsonAsset, "CookedFrom");
+
+			auto Dependencies = JsonAsset.FindMember("Dependencies");
+			if (Dependencies != JsonAsset.MemberEnd() && Dependencies->value.IsArray())
+			{
+				for (const rapidjson::Value& Dependency : Dependencies->value.GetArray())
+					if (Dependency.IsString())
+						Loaded.Dependencies.emplace_back(Dependency.GetString(), Dependency.GetStringLength());
+			}
+
+			std::string Path = Loaded.Path;
+			m_Assets.emplace(std::move(Path), std::move(Loaded));
+		}
+		return true;
+	}
+
+	bool AssetDatabase::Save(const std::string& DatabasePath) const
+	{
+		// Sorted so the file diffs cleanly between cooks.
+		std::vector<const Asset*> Sorted;
+		Sorted.reserve(m_Assets.size());
+		for (const auto& Entry : m_Assets)
+			Sorted.push_back(&Entry.second);
+		std::sort(Sorted.begin(), Sorted.end(), [](const Asset* pLhs, const Asset* pRhs) { return pLhs->Path < pRhs->Path; });
+
+		rapidjson::StringBuffer StrBuffer;
+		rapidjson::PrettyWriter<rapidjson::StringBuffer> Writer(StrBuffer);
+		Writer.StartObject();
+		Writer.Key("Version");
+		Writer.Uint(Version);
+		Writer.Key("Assets");
+		Writer.StartArray();
+		for (const Asset* pAsset : Sorted)
+		{
+			Writer.StartObject();
+			Writer.Key("Path");
+			Writer.String(pAsset->Path.c_str());
+			Writer.Key("Type");
+			Writer.String(GetTypeName(pAsset->Type));
+			Writer.Key("SourceHash");
+			Writer.String(ToHex(pAsset->SourceHash).c_str());
+			Writer.Key("SettingsHash");
+			Writer.String(ToHex(pAsset->SettingsHash).c_str());
+			Writer.Key("CookedHash");
+			Writer.String(ToHex(pAsset->CookedHash).c_str());
+			Writer.Key("CookedFrom");
+			Writer.String(ToHex(pAsset->CookedFrom).c_str());
+			Writer.Key("Dependencies");
+			Writer.StartArray();
+			for (const std::string& Dependency : pAsset->Dependencies)
+				Writer.String(Dependency.c_str());
+			Writer.EndArray();
+			Writer.EndObject();
+		}
+		Writer.EndArray();
+		Writer.EndObject();
+
+		const std::string TempPath = DatabasePath + ".tmp";
+		{
+			std::ofstream Out(TempPath, std::ios::binary | std::ios::trunc);
+			Out.write(StrBuffer.GetString(), static_cast<std::streamsize>(StrBuffer.GetSize()));
+			if (!Out.good())
+			{
+				IE_DEBUG_LOG(LogSeverity::Error, "Failed to write asset database \"{0}\".", TempPath);
+				return false;
+			}
+		}
+
+		std::error_code Error;
+		std::filesystem::rename(TempPath, DatabasePath, Error);
+		if (Error)
+		{
+			IE_DEBUG_LOG(LogSeverity::Error, "Failed to replace asset database \"{0}\": {1}", DatabasePath, Error.message());
+			return false;
+		}
+		return true;
+	}
+
+	bool AssetDatabase::Scan(const std::string& ContentDirectory, uint32_t NumThreads)
+	{
+		namespace fs = std::filesystem;
+
+		std::error_code Error;
+		const fs::path Root(ContentDirectory);
+		if (!fs::is_directory(Root, Error))
+		{
+			IE_DEBUG_LOG(LogSeverity::Error, "Failed to scan \"{0}\" for assets, it is not a directory.", ContentDirectory);
+			return false;
+		}
+
+		std::vector<ScannedFile> Files;
+		for (fs::recursive_directory_iterator Iter(Root, Error); !Error && Iter != fs::recursive_directory_iterator(); Iter.increment(Error))
+		{
+			if (!Iter->is_regular_file(Error))
+				continue;
+
+			ScannedFile File;
+			File.SourcePath = Iter->path().string();
+			File.Path = StringHelper::NormalizePath(Iter->path().lexically_relative(Root).string());
+			Files.push_back(std::move(File));
+		}
+		if (Error)
+		{
+			IE_DEBUG_LOG(LogSeverity::Error, "Failed to list the files of \"{0}\": {1}", ContentDirectory, Error.message());
+			return false;
+		}
+		std::sort(Files.begin(), Files.end(), [](const ScannedFile& Lhs, const ScannedFile& Rhs) { return Lhs.Path < Rhs.Path; });
+
+		// Hash the files in parallel, each worker takes the next file that has not been hashed.
+		if (NumThreads == 0u)
+			NumThreads = std::max(std::thread::hardware_concurrency(), 1u);
+		std::atomic<size_t> NextFile = 0u;
+		std::vector<std::future<void>> Workers;
+		for (uint32_t i = 0u; i < NumThreads; ++i)
+		{
+			Workers.push_back(std::async(std::launch::async, [&Files, &NextFile]()
+				{
+					for (size_t Index = NextFile++; Index < Files.size(); Index = NextFile++)
+					{
+						const FileView View = MappedFile::OpenView(Files[Index].SourcePath);
+						Files[Index].Hash = View ? Xxh64::Hash(View.GetData(), View.GetSize()) : 0u;
+					}
+				}));
+		}
+		for (std::future<void>& Worker : Workers)
+			Worker.wait();
+
+		std::unordered_map<std::string, Asset> Assets;
+		std::map<std::string, std::vector<const ScannedFile*>> Scenes;
+		for (const ScannedFile& File : Files)
+		{
+			Asset& Scanned = Assets[File.Path];
+			Scanned.Path = File.Path;
+			Scanned.Type = GetTypeFromExtension(File.Path);
+			Scanned.SourceHash = File.Hash;
+			if (Scanned.Type == AssetType::Model)
+				Scanned.SettingsHash = Xxh64::Hash(&ModelImportVersion, sizeof(ModelImportVersion));
+
+			const size_t SceneEnd = File.Path.find(std::string(SceneExtension) + "/");
+			if (SceneEnd != std::string::npos)
+				Scenes[File.Path.substr(0u, SceneEnd + strlen(SceneExtension))].push_back(&File);
+		}
+
+		std::unordered_map<std::string, std::set<uint64_t>> TextureSettings;
+		for (const auto& Scene : Scenes)
+			ScanScene(Scene.first, Scene.second, Assets, TextureSettings);
+
+		for (const auto& Texture : TextureSettings)
+		{
+			auto Iter = Assets.find(Texture.first);
+			if (Iter == Assets.end())
+				continue;
+			for (uint64_t Settings : Texture.second)
+				Iter->second.SettingsHash = Xxh64::Combine(Iter->second.SettingsHash, Settings);
+		}
+
+		for (auto& Entry : Assets)
+		{
+			Asset& Scanned = Entry.second;
+			std::sort(Scanned.Dependencies.begin(), Scanned.Dependencies.end());
+			Scanned.Dependencies.erase(std::unique(Scanned.Dependencies.begin(), Scanned.Dependencies.end()), Scanned.Dependencies.end());
+
+			// Keep what the asset was last cooked to, IsCookUpToDate decides if it still applies.
+			auto Previous = m_Assets.find(Entry.first);
+			if (Previous != m_Assets.end())
+			{
+				Scanned.CookedHash = Previous->second.CookedHash;
+				Scanned.CookedFrom = Previous->second.CookedFrom;
+			}
+		}
+
+		m_Assets.swap(Assets);
+		IE_DEBUG_LOG(LogSeverity::Log, "Scanned {0} files and {1} scenes in \"{2}\".", Files.size(), Scenes.size(), ContentDirectory);
+		return true;
+	}
+
+	const AssetDatabase::Asset* AssetDatabase::Find(const std::string& Path) const
+	{
+		auto Iter = m_Assets.find(Path);
+		return Iter != m_Assets.end() ? &Iter->second : nullptr;
+	}
+
+	uint64_t AssetDatabase::GetCookKey(const Asset& CookedAsset, uint64_t CookOptionsHash)
+	{
+		return Xxh64::Combine(Xxh64::Combine(CookedAsset.SourceHash, CookedAsset.SettingsHash), CookOptionsHash);
+	}
+
+	bool AssetDatabase::IsCookUpToDate(const std::string& Path, uint64_t CookOptionsHash, uint64_t& OutCookedHash) const
+	{
+		const Asset* pAsset = Find(Path);
+		if (!pAsset || pAsset->CookedHash == 0u || pAsset->CookedFrom != GetCookKey(*pAsset, CookOptionsHash))
+			return false;
+
+		OutCookedHash = pAsset->CookedHash;
+		return true;
+	}
+
+	void AssetDatabase::SetCooked(const std::string& Path, uint64_t CookOptionsHash, uint64_t CookedHash)
+	{
+		auto Iter = m_Assets.find(Path);
+		if (Iter == m_Assets.end())
+			return;
+
+		Iter->second.CookedHash = CookedHash;
+		Iter->second.CookedFrom = GetCookKey(Iter->second, CookOptionsHash);
+	}
+
+	void AssetDatabase::GetDependencies(const std::string& Path, std::vector<std::string>& OutPaths) const
+	{
+		std::unordered_set<std::string> Visited = { Path };
+		const size_t First = OutPaths.size();
+		OutPaths.push_back(Path);
+		for (size_t i = First; i < OutPaths.size(); ++i)
+		{
+			const Asset* pAsset = Find(OutPaths[i]);
+			if (!pAsset)
+				continue;
+
+			for (const std::string& Dependency : pAsset->Dependencies)
+				if (Visited.insert(Dependency).second)
+					OutPaths.push_back(Dependency);
+		}
+	}
+
+	void AssetDatabase::GetDependents(const std::string& Path, std::vector<std::string>& OutPaths) const
+	{
+		std::unordered_map<std::string, std::vector<const std::string*>> Users;
+		for (const auto& Entry : m_Assets)
+			for (const std::string& Dependency : Entry.second.Dependencies)
+				Users[Dependency].push_back(&Entry.second.Path);
+
+		std::unordered_set<std::string> Visited = { Path };
+		std::vector<const std::string*> Pending = { &Path };
+		while (!Pending.empty())
+		{
+			auto Iter = Users.find(*Pending.back());
+			Pending.pop_back();
+			if (Iter == Users.end())
+				continue;
+
+			for (const std::string* pUser : Iter->second)
+			{
+				if (!Visited.insert(*pUser).second)
+					continue;
+				OutPaths.push_back(*pUser);
+				Pending.push_back(pUser);
+			}
+		}
+	}
+
+	const char* AssetDatabase::GetTypeName(AssetType Type)
+	{
+		switch (Type)
+		{
+		case AssetType::Scene:		return "Scene";
+		case AssetType::Model:		return "Model";
+		case AssetType::Texture:	return "Texture";
+		case AssetType::Material:	return "Material";
+		default:					return "File";
+		}
+	}
+
+}
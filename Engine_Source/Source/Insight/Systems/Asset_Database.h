@@ -0,0 +1,116 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Asset_Database.h
+	Source - Asset_Database.cpp
+
+	Purpose:
+	Records what every asset in a Content folder was made from and which assets use it, so cooking
+	only redoes what changed and packaging only takes what a scene needs.
+
+	Description:
+	Every file is an asset keyed by its Content relative path, normalized with StringHelper::NormalizePath.
+	Scan hashes every file with XXH64 and rebuilds the dependency graph from the scenes:
+	Scene		- "scenes/norway.iescene". Depends on the files in its folder and everything its actors use.
+	Model		- A model file a StaticMesh component loads. Depends on nothing, the importer's settings are versioned.
+	Texture		- A texture listed in a scene's Resources.json or named by an actor (Ex. the sky's cube maps).
+	Material	- "scenes/norway.iescene#material_<hash>". The texture IDs and properties of a mesh's material,
+				  which are stored inline in the actor. Depends on the textures the IDs resolve to in Resources.json.
+	File		- Everything else, Ex. fonts, sounds and the scene's own json files.
+	Actors.journal is scanned with Actors.json, so actors saved since the last compaction are included.
+	Each asset keeps the hash of its source, the hash of the settings it is loaded with and the hash of
+	its cooked output along with the source and cook settings that output was made from. Cooking (see
+	PakWriter) asks IsCookUpToDate for each file and copies the previous output of those that are.
+	The database is saved as json next to the archive it describes. Scan, Load and SetCooked are not
+	thread safe, the const queries can be called from any thread once they are done.
+
+	Example Usage:
+	AssetDatabase Database;
+	Database.Load("../Content.iedb");
+	Database.Scan("../Content");
+	std::vector<std::string> Dependencies;
+	Database.GetDependencies("scenes/norway.iescene", Dependencies);
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+namespace Insight {
+
+	class INSIGHT_API AssetDatabase
+	{
+	public:
+		static constexpr uint32_t Version = 1u;
+		// Bump when the import flags in MeshImporter change so every model is cooked again.
+		static constexpr uint32_t ModelImportVersion = 1u;
+
+		enum class AssetType : uint8_t
+		{
+			File,
+			Scene,
+			Model,
+			Texture,
+			Material,
+		};
+
+		struct Asset
+		{
+			std::string Path;
+			AssetType Type = AssetType::File;
+			// XXH64 of the file. Scenes combine the hashes of the files in their folder, materials have no file and use 0.
+			uint64_t SourceHash = 0u;
+			// Hash of the settings the asset is loaded with, Ex. a texture's type and whether mips are generated.
+			uint64_t SettingsHash = 0u;
+			// XXH64 of the asset's cooked output. 0 if it has not been cooked.
+			uint64_t CookedHash = 0u;
+			// Hash of the source, settings and cook options the cooked output was made from.
+			uint64_t CookedFrom = 0u;
+			// Content relative paths of the assets this one uses directly. Paths of missing files are kept so they can be reported.
+			std::vector<std::string> Dependencies;
+		};
+
+	public:
+		AssetDatabase() = default;
+		~AssetDatabase() = default;
+
+		// Load a database saved with Save. Returns false and leaves the database empty if it is missing or invalid.
+		bool Load(const std::string& DatabasePath);
+		// Write the database. The previous file is replaced once the new one has been written.
+		bool Save(const std::string& DatabasePath) const;
+
+		/*
+			Hash every file under a Content folder and rebuild the dependency graph from its scenes.
+			The cooked hashes of assets that are still there are kept, assets that are gone are dropped.
+			@param NumThreads - Threads files are hashed on. 0 uses one per core.
+			Returns false if the folder could not be listed.
+		*/
+		bool Scan(const std::string& ContentDirectory, uint32_t NumThreads = 0u);
+
+		// Returns nullptr if there is no asset with the path.
+		const Asset* Find(const std::string& Path) const;
+		inline uint32_t GetNumAssets() const { return static_cast<uint32_t>(m_Assets.size()); }
+		inline const std::unordered_map<std::string, Asset>& GetAssets() const { return m_Assets; }
+
+		/*
+			Returns true if an asset's cooked output was made from its current source and settings.
+			@param CookOptionsHash - Hash of the options of the cook, so changing them cooks everything again.
+			@param OutCookedHash - Set to the hash the previous output must match to be reused.
+		*/
+		bool IsCookUpToDate(const std::string& Path, uint64_t CookOptionsHash, uint64_t& OutCookedHash) const;
+		// Record the output an asset was cooked to with its current source and settings.
+		void SetCooked(const std::string& Path, uint64_t CookOptionsHash, uint64_t CookedHash);
+
+		// Every asset Path uses, directly or through other assets, starting with Path. Missing files are included.
+		void GetDependencies(const std::string& Path, std::vector<std::string>& OutPaths) const;
+		// Every asset that uses Path, directly or through other assets, Ex. the scenes a texture is in.
+		void GetDependents(const std::string& Path, std::vector<std::string>& OutPaths) const;
+
+		static const char* GetTypeName(AssetType Type);
+
+	private:
+		static uint64_t GetCookKey(const Asset& CookedAsset, uint64_t CookOptionsHash);
+
+	private:
+		std::unordered_map<std::string, Asset> m_Assets;
+	};
+
+}
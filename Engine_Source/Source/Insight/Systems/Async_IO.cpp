@@ -0,0 +1,777 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Async_IO.h"
+
+#include "Insight/Utilities/String_Helper.h"
+
+#if !defined (IE_PLATFORM_WINDOWS)
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <cerrno>
+#endif
+#if defined (__linux__)
+	#include <linux/io_uring.h>
+	#include <poll.h>
+	#include <sys/eventfd.h>
+	#include <sys/mman.h>
+	#include <sys/syscall.h>
+	#include <sys/uio.h>
+#endif
+
+namespace Insight {
+
+	AsyncIO AsyncIO::s_Instance;
+
+	static constexpr intptr_t InvalidFile = -1;
+	// Largest single read handed to the OS. Longer reads are split.
+	static constexpr uint64_t MaxReadSize = 1ull << 30u;
+
+	struct AsyncRead
+	{
+		AsyncIO::ReadRequest Request;
+		std::chrono::steady_clock::time_point QueuedTime;
+		intptr_t File = InvalidFile;
+		uint64_t BytesRead = 0u;
+		bool Failed = false;
+
+		inline uint64_t GetRemaining() const { return Request.Size - BytesRead; }
+		inline uint64_t GetNextOffset() const { return Request.Offset + BytesRead; }
+		inline uint8_t* GetNextDestination() const { return static_cast<uint8_t*>(Request.pDestination) + BytesRead; }
+
+#if defined (IE_PLATFORM_WINDOWS)
+		struct OverlappedRead
+		{
+			OVERLAPPED Overlapped;
+			AsyncRead* pRead;
+		} Overlapped;
+#elif defined (__linux__)
+		iovec Vector;
+#endif
+	};
+
+	struct AsyncCompletion
+	{
+		AsyncRead* pRead;
+		// Bytes read, 0 at the end of the file, negative if the read failed.
+		int64_t Result;
+	};
+
+	// Queue the OS reads from on the I/O thread. Every method is called from the I/O thread except Wake.
+	class AsyncIOBackend
+	{
+	public:
+		virtual ~AsyncIOBackend() = default;
+
+		virtual const char* GetName() const = 0;
+		// True if files must be opened for overlapped reads.
+		virtual bool UsesOverlappedFiles() const { return false; }
+		// Called once for each file opened for the backend. Returns false if the backend cannot read from it.
+		virtual bool OnFileOpened(intptr_t) { return true; }
+
+		// Start reading the next part of each read. Reads that finished without being queued are added to OutCompleted.
+		virtual void Submit(const std::vector<AsyncRead*>& Reads, std::vector<AsyncCompletion>& OutCompleted) = 0;
+		// Wait until a read finishes or Wake is called.
+		virtual void Wait(std::vector<AsyncCompletion>& OutCompleted) = 0;
+		// Make the I/O thread return from Wait. Thread safe.
+		virtual void Wake() = 0;
+	};
+
+	// ---------------------
+	//	Platform File Access |
+	// ---------------------
+
+	static intptr_t OpenFileForRead(const std::string& Path, [[maybe_unused]] bool Overlapped)
+	{
+#if defined (IE_PLATFORM_WINDOWS)
+		const std::wstring WidePath = StringHelper::StringToWide(Path);
+		const DWORD ShareMode = FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE;
+	#if defined (IE_PLATFORM_BUILD_WIN32)
+		HANDLE hFile = CreateFileW(WidePath.c_str(), GENERIC_READ, ShareMode, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | (Overlapped ? FILE_FLAG_OVERLAPPED : 0), nullptr);
+	#elif defined (IE_PLATFORM_BUILD_UWP)
+		CREATEFILE2_EXTENDED_PARAMETERS Params = {};
+		Params.dwSize = sizeof(Params);
+		Params.dwFileAttributes = FILE_ATTRIBUTE_NORMAL;
+		Params.dwFileFlags = Overlapped ? FILE_FLAG_OVERLAPPED : 0;
+		HANDLE hFile = CreateFile2(WidePath.c_str(), GENERIC_READ, ShareMode, OPEN_EXISTING, &Params);
+	#endif
+		return reinterpret_cast<intptr_t>(hFile);
+#else
+		const int File = open(Path.c_str(), O_RDONLY | O_CLOEXEC);
+		return File < 0 ? InvalidFile : static_cast<intptr_t>(File);
+#endif
+	}
+
+	static void CloseFile(intptr_t File)
+	{
+#if defined (IE_PLATFORM_WINDOWS)
+		CloseHandle(reinterpret_cast<HANDLE>(File));
+#else
+		close(static_cast<int>(File));
+#endif
+	}
+
+	// Read the rest of a read on the calling thread from a file that was not opened for overlapped reads.
+	static void ReadBlocking(AsyncRead& Read)
+	{
+		while (Read.GetRemaining() > 0u)
+		{
+			const uint64_t Size = std::min(Read.GetRemaining(), MaxReadSize);
+#if defined (IE_PLATFORM_WINDOWS)
+			// An offset in the OVERLAPPED makes the read positional, so threads can share the handle.
+			OVERLAPPED Overlapped = {};
+			Overlapped.Offset = static_cast<DWORD>(Read.GetNextOffset());
+			Overlapped.OffsetHigh = static_cast<DWORD>(Read.GetNextOffset() >> 32u);
+			DWORD BytesRead = 0u;
+			if (!ReadFile(reinterpret_cast<HANDLE>(Read.File), Read.GetNextDestination(), static_cast<DWORD>(Size), &BytesRead, &Overlapped))
+			{
+				Read.Failed = GetLastError() != ERROR_HANDLE_EOF;
+				return;
+			}
+#else
+			const ssize_t BytesRead = pread(static_cast<int>(Read.File), Read.GetNextDestination(), static_cast<size_t>(Size), static_cast<off_t>(Read.GetNextOffset()));
+			if (BytesRead < 0)
+			{
+				if (errno == EINTR)
+					continue;
+				Read.Failed = true;
+				return;
+			}
+#endif
+			if (BytesRead == 0)
+				return;
+			Read.BytesRead += static_cast<uint64_t>(BytesRead);
+		}
+	}
+
+	// --------------
+	//	IOCP Backend |
+	// --------------
+
+#if defined (IE_PLATFORM_WINDOWS)
+
+	class CompletionPortBackend : public AsyncIOBackend
+	{
+	public:
+		~CompletionPortBackend()
+		{
+			if (m_hPort)
+				CloseHandle(m_hPort);
+		}
+
+		bool Init()
+		{
+			m_hPort = CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, 1);
+			return m_hPort != nullptr;
+		}
+
+		const char* GetName() const override { return "IOCP"; }
+		bool UsesOverlappedFiles() const override { return true; }
+		bool OnFileOpened(intptr_t File) override
+		{
+			return CreateIoCompletionPort(reinterpret_cast<HANDLE>(File), m_hPort, ReadKey, 0) != nullptr;
+		}
+
+		void Submit(const std::vector<AsyncRead*>& Reads, std::vector<AsyncCompletion>& OutCompleted) override
+		{
+			for (AsyncRead* pRead : Reads)
+			{
+				AsyncRead::OverlappedRead& Overlapped = pRead->Overlapped;
+				Overlapped = {};
+				Overlapped.pRead = pRead;
+				Overlapped.Overlapped.Offset = static_cast<DWORD>(pRead->GetNextOffset());
+				Overlapped.Overlapped.OffsetHigh = static_cast<DWORD>(pRead->GetNextOffset() >> 32u);
+
+				// The completion is posted to the port even if the read finishes immediately.
+				const DWORD Size = static_cast<DWORD>(std::min(pRead->GetRemaining(), MaxReadSize));
+				if (!ReadFile(reinterpret_cast<HANDLE>(pRead->File), pRead->GetNextDestination(), Size, nullptr, &Overlapped.Overlapped))
+				{
+					const DWORD Error = GetLastError();
+					if (Error != ERROR_IO_PENDING)
+						OutCompleted.push_back({ pRead, Error == ERROR_HANDLE_EOF ? 0 : -1 });
+				}
+			}
+		}
+
+		void Wait(std::vector<AsyncCompletion>& OutCompleted) override
+		{
+			OVERLAPPED_ENTRY Entries[64];
+			ULONG NumEntries = 0u;
+			if (!GetQueuedCompletionStatusEx(m_hPort, Entries, _countof(Entries), &NumEntries, INFINITE, FALSE))
+				return;
+
+			for (ULONG i = 0u; i < NumEntries; ++i)
+			{
+				if (Entries[i].lpCompletionKey != ReadKey)
+					continue;
+
+				AsyncRead* pRead = reinterpret_cast<AsyncRead::OverlappedRead*>(Entries[i].lpOverlapped)->pRead;
+				DWORD BytesRead = 0u;
+				if (GetOverlappedResult(reinterpret_cast<HANDLE>(pRead->File), Entries[i].lpOverlapped, &BytesRead, FALSE))
+					OutCompleted.push_back({ pRead, static_cast<int64_t>(BytesRead) });
+				else
+					OutCompleted.push_back({ pRead, GetLastError() == ERROR_HANDLE_EOF ? 0 : -1 });
+			}
+		}
+
+		void Wake() override
+		{
+			PostQueuedCompletionStatus(m_hPort, 0u, WakeKey, nullptr);
+		}
+
+	private:
+		static constexpr ULONG_PTR ReadKey = 1u;
+		static constexpr ULONG_PTR WakeKey = 2u;
+		HANDLE m_hPort = nullptr;
+	};
+
+#endif // IE_PLATFORM_WINDOWS
+
+	// ------------------
+	//	io_uring Backend |
+	// ------------------
+
+#if defined (__linux__)
+
+	class IoUringBackend : public AsyncIOBackend
+	{
+	public:
+		~IoUringBackend()
+		{
+			if (m_pSqes)
+				munmap(m_pSqes, m_SqesSize);
+			if (m_pCqRing && m_pCqRing != m_pSqRing)
+				munmap(m_pCqRing, m_CqRingSize);
+			if (m_pSqRing)
+				munmap(m_pSqRing, m_SqRingSize);
+			if (m_WakeFd >= 0)
+				close(m_WakeFd);
+			if (m_RingFd >= 0)
+				close(m_RingFd);
+		}
+
+		bool Init(uint32_t QueueDepth)
+		{
+			// One extra entry for the poll on the wake event.
+			io_uring_params Params = {};
+			m_RingFd = static_cast<int>(syscall(__NR_io_uring_setup, QueueDepth + 1u, &Params));
+			if (m_RingFd < 0)
+				return false;
+
+			m_SqRingSize = Params.sq_off.array + Params.sq_entries * sizeof(uint32_t);
+			m_CqRingSize = Params.cq_off.cqes + Params.cq_entries * sizeof(io_uring_cqe);
+			const bool SingleMap = (Params.features & IORING_FEAT_SINGLE_MMAP) != 0u;
+			if (SingleMap)
+				m_SqRingSize = m_CqRingSize = std::max(m_SqRingSize, m_CqRingSize);
+
+			m_pSqRing = MapRing(m_SqRingSize, IORING_OFF_SQ_RING);
+			m_pCqRing = SingleMap ? m_pSqRing : MapRing(m_CqRingSize, IORING_OFF_CQ_RING);
+			m_SqesSize = Params.sq_entries * sizeof(io_uring_sqe);
+			m_pSqes = static_cast<io_uring_sqe*>(MapRing(m_SqesSize, IORING_OFF_SQES));
+			if (!m_pSqRing || !m_pCqRing || !m_pSqes)
+				return false;
+
+			uint8_t* pSq = static_cast<uint8_t*>(m_pSqRing);
+			m_pSqHead = reinterpret_cast<uint32_t*>(pSq + Params.sq_off.head);
+			m_pSqTail = reinterpret_cast<uint32_t*>(pSq + Params.sq_off.tail);
+			m_SqMask = *reinterpret_cast<uint32_t*>(pSq + Params.sq_off.ring_mask);
+			m_pSqArray = reinterpret_cast<uint32_t*>(pSq + Params.sq_off.array);
+			m_SqEntries = Params.sq_entries;
+
+			uint8_t* pCq = static_cast<uint8_t*>(m_pCqRing);
+			m_pCqHead = reinterpret_cast<uint32_t*>(pCq + Params.cq_off.head);
+			m_pCqTail = reinterpret_cast<uint32_t*>(pCq + Params.cq_off.tail);
+			m_CqMask = *reinterpret_cast<uint32_t*>(pCq + Params.cq_off.ring_mask);
+			m_pCqes = reinterpret_cast<io_uring_cqe*>(pCq + Params.cq_off.cqes);
+
+			m_WakeFd = eventfd(0u, EFD_CLOEXEC);
+			return m_WakeFd >= 0;
+		}
+
+		const char* GetName() const override { return "io_uring"; }
+
+		void Submit(const std::vector<AsyncRead*>& Reads, std::vector<AsyncCompletion>&) override
+		{
+			// The poll on the wake event fires once, it is queued again after every wake.
+			if (!m_IsWakeArmed)
+			{
+				io_uring_sqe* pSqe = GetSqe();
+				pSqe->opcode = IORING_OP_POLL_ADD;
+				pSqe->fd = m_WakeFd;
+				pSqe->poll_events = POLLIN;
+				pSqe->user_data = WakeTag;
+				m_IsWakeArmed = true;
+			}
+
+			for (AsyncRead* pRead : Reads)
+			{
+				pRead->Vector.iov_base = pRead->GetNextDestination();
+				pRead->Vector.iov_len = static_cast<size_t>(std::min(pRead->GetRemaining(), MaxReadSize));
+
+				io_uring_sqe* pSqe = GetSqe();
+				pSqe->opcode = IORING_OP_READV;
+				pSqe->fd = static_cast<int>(pRead->File);
+				pSqe->off = pRead->GetNextOffset();
+				pSqe->addr = reinterpret_cast<uint64_t>(&pRead->Vector);
+				pSqe->len = 1u;
+				pSqe->user_data = reinterpret_cast<uint64_t>(pRead);
+			}
+		}
+
+		void Wait(std::vector<AsyncCompletion>& OutCompleted) override
+		{
+			// Submit everything queued since the last wait and wait for a completion in one call.
+			const int Submitted = static_cast<int>(syscall(__NR_io_uring_enter, m_RingFd, m_NumUnsubmitted, 1u, IORING_ENTER_GETEVENTS, nullptr, 0u));
+			if (Submitted > 0)
+				m_NumUnsubmitted -= static_cast<uint32_t>(Submitted);
+
+			uint32_t Head = *m_pCqHead;
+			const uint32_t Tail = __atomic_load_n(m_pCqTail, __ATOMIC_ACQUIRE);
+			for (; Head != Tail; ++Head)
+			{
+				const io_uring_cqe& Cqe = m_pCqes[Head & m_CqMask];
+				if (Cqe.user_data == WakeTag)
+				{
+					uint64_t WakeCount = 0u;
+					(void)read(m_WakeFd, &WakeCount, sizeof(WakeCount));
+					m_IsWakeArmed = false;
+					continue;
+				}
+				OutCompleted.push_back({ reinterpret_cast<AsyncRead*>(Cqe.user_data), static_cast<int64_t>(Cqe.res) });
+			}
+			__atomic_store_n(m_pCqHead, Head, __ATOMIC_RELEASE);
+		}
+
+		void Wake() override
+		{
+			const uint64_t One = 1u;
+			(void)write(m_WakeFd, &One, sizeof(One));
+		}
+
+	private:
+		void* MapRing(size_t Size, uint64_t Offset)
+		{
+			void* pRing = mmap(nullptr, Size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_RingFd, static_cast<off_t>(Offset));
+			return pRing == MAP_FAILED ? nullptr : pRing;
+		}
+
+		// The I/O thread is the only producer. Reads in flight never exceed the ring size, so there is always a free entry.
+		io_uring_sqe* GetSqe()
+		{
+			const uint32_t Tail = *m_pSqTail;
+			const uint32_t Index = Tail & m_SqMask;
+			io_uring_sqe* pSqe = &m_pSqes[Index];
+			memset(pSqe, 0, sizeof(io_uring_sqe));
+			m_pSqArray[Index] = Index;
+			__atomic_store_n(m_pSqTail, Tail + 1u, __ATOMIC_RELEASE);
+			m_NumUnsubmitted++;
+			return pSqe;
+		}
+
+	private:
+		static constexpr uint64_t WakeTag = 0u;
+
+		int m_RingFd = -1;
+		int m_WakeFd = -1;
+		bool m_IsWakeArmed = false;
+		uint32_t m_NumUnsubmitted = 0u;
+
+		void* m_pSqRing = nullptr;
+		void* m_pCqRing = nullptr;
+		size_t m_SqRingSize = 0u;
+		size_t m_CqRingSize = 0u;
+		io_uring_sqe* m_pSqes = nullptr;
+		size_t m_SqesSize = 0u;
+
+		uint32_t* m_pSqHead = nullptr;
+		uint32_t* m_pSqTail = nullptr;
+		uint32_t* m_pSqArray = nullptr;
+		uint32_t m_SqMask = 0u;
+		uint32_t m_SqEntries = 0u;
+
+		uint32_t* m_pCqHead = nullptr;
+		uint32_t* m_pCqTail = nullptr;
+		io_uring_cqe* m_pCqes = nullptr;
+		uint32_t m_CqMask = 0u;
+	};
+
+#endif // __linux__
+
+	// ---------
+	//	AsyncIO |
+	// ---------
+
+	AsyncIO::AsyncIO()
+	{
+	}
+
+	AsyncIO::~AsyncIO()
+	{
+		Shutdown();
+	}
+
+	bool AsyncIO::Init(const Settings& IOSettings)
+	{
+		if (m_Running)
+			return false;
+
+		m_Settings = IOSettings;
+		m_Settings.QueueDepth = std::max(m_Settings.QueueDepth, 1u);
+		if (m_Settings.NumWorkerThreads == 0u)
+			m_Settings.NumWorkerThreads = std::max(std::thread::hardware_concurrency(), 2u) - 1u;
+
+		if (!m_Settings.ForceThreadPool)
+		{
+#if defined (IE_PLATFORM_WINDOWS)
+			std::unique_ptr<CompletionPortBackend> pBackend = std::make_unique<CompletionPortBackend>();
+			if (pBackend->Init())
+				m_pBackend = std::move(pBackend);
+#elif defined (__linux__)
+			std::unique_ptr<IoUringBackend> pBackend = std::make_unique<IoUringBackend>();
+			if (pBackend->Init(m_Settings.QueueDepth))
+				m_pBackend = std::move(pBackend);
+#endif
+			if (!m_pBackend)
+			{
+				IE_DEBUG_LOG(LogSeverity::Warning, "Failed to create the platform's asynchronous I/O queue. Files will be read on a thread pool instead.");
+			}
+		}
+
+		ResetStats();
+		m_Stopping = false;
+		m_Running = true;
+		if (m_pBackend)
+			m_IOThread = std::thread(&AsyncIO::IOThread, this);
+		for (uint32_t i = 0u; i < m_Settings.NumWorkerThreads; ++i)
+			m_Workers.emplace_back(&AsyncIO::WorkerThread, this);
+
+		IE_DEBUG_LOG(LogSeverity::Log, "Asynchronous I/O started with the {0} backend, {1} worker threads and a queue depth of {2}.", GetBackendName(), m_Settings.NumWorkerThreads, m_Settings.QueueDepth);
+		return true;
+	}
+
+	void AsyncIO::Shutdown()
+	{
+		if (!m_Running)
+			return;
+
+		{
+			std::lock_guard<std::mutex> Lock(m_Mutex);
+			m_Stopping = true;
+		}
+		m_WorkCondition.notify_all();
+		if (m_pBackend)
+			m_pBackend->Wake();
+
+		if (m_IOThread.joinable())
+			m_IOThread.join();
+		for (std::thread& Worker : m_Workers)
+			Worker.join();
+		m_Workers.clear();
+
+		m_pBackend.reset();
+		m_Running = false;
+		m_Stopping = false;
+	}
+
+	void AsyncIO::Read(ReadRequest Request)
+	{
+		std::unique_ptr<AsyncRead> pRead = std::make_unique<AsyncRead>();
+		pRead->Request = std::move(Request);
+		pRead->QueuedTime = std::chrono::steady_clock::now();
+
+		{
+			std::unique_lock<std::mutex> Lock(m_Mutex);
+			if (m_Running && !m_Stopping)
+			{
+				if (m_NumOutstanding++ == 0u)
+					m_BusySince = pRead->QueuedTime;
+				m_NumQueued++;
+				m_Queued[static_cast<size_t>(pRead->Request.ReadPriority)].push_back(std::move(pRead));
+			}
+		}
+
+		if (pRead)
+		{
+			pRead->File = OpenFileForRead(pRead->Request.Path, false);
+			pRead->Failed = pRead->File == InvalidFile;
+			if (!pRead->Failed)
+			{
+				ReadBlocking(*pRead);
+				CloseFile(pRead->File);
+			}
+
+			ReadResult Result;
+			Result.Succeeded = !pRead->Failed;
+			Result.BytesRead = pRead->BytesRead;
+			Result.LatencyMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - pRead->QueuedTime).count();
+			if (pRead->Request.OnComplete)
+				pRead->Request.OnComplete(Result);
+			return;
+		}
+
+		if (!m_pBackend)
+			m_WorkCondition.notify_one();
+		else if (!m_WakePending.exchange(true))
+			m_pBackend->Wake();
+	}
+
+	void AsyncIO::WaitIdle()
+	{
+		std::unique_lock<std::mutex> Lock(m_Mutex);
+		m_IdleCondition.wait(Lock, [this]() { return m_NumOutstanding == 0u; });
+	}
+
+	AsyncIO::Stats AsyncIO::GetStats() const
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		Stats Current = m_Stats;
+		Current.NumQueued = m_NumQueued;
+		Current.NumInFlight = m_NumInFlight;
+
+		std::chrono::steady_clock::duration BusyTime = m_BusyTime;
+		if (m_NumOutstanding > 0u)
+			BusyTime += std::chrono::steady_clock::now() - m_BusySince;
+		const double BusySeconds = std::chrono::duration<double>(BusyTime).count();
+		const uint64_t NumFinished = m_Stats.NumCompleted + m_Stats.NumFailed;
+		Current.ThroughputMBs = BusySeconds > 0.0 ? static_cast<float>(m_Stats.BytesRead / (1024.0 * 1024.0) / BusySeconds) : 0.0f;
+		Current.AverageLatencyMs = NumFinished > 0u ? static_cast<float>(m_TotalLatencyMs / NumFinished) : 0.0f;
+		return Current;
+	}
+
+	void AsyncIO::ResetStats()
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		m_Stats = Stats();
+		m_TotalLatencyMs = 0.0;
+		m_BusyTime = {};
+		m_BusySince = std::chrono::steady_clock::now();
+	}
+
+	const char* AsyncIO::GetBackendName() const
+	{
+		if (!m_Running)
+			return "None";
+		return m_pBackend ? m_pBackend->GetName() : "ThreadPool";
+	}
+
+	std::unique_ptr<AsyncRead> AsyncIO::PopQueued()
+	{
+		for (std::deque<std::unique_ptr<AsyncRead>>& Queue : m_Queued)
+		{
+			if (Queue.empty())
+				continue;
+
+			std::unique_ptr<AsyncRead> pRead = std::move(Queue.front());
+			Queue.pop_front();
+			m_NumQueued--;
+			return pRead;
+		}
+		return nullptr;
+	}
+
+	void AsyncIO::QueueCompletion(std::unique_ptr<AsyncRead> pRead)
+	{
+		m_Completed.push_back(std::move(pRead));
+		m_WorkCondition.notify_one();
+	}
+
+	void AsyncIO::RunCompletion(AsyncRead& Read)
+	{
+		ReadResult Result;
+		Result.Succeeded = !Read.Failed;
+		Result.BytesRead = Read.BytesRead;
+		Result.LatencyMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - Read.QueuedTime).count();
+
+		{
+			std::lock_guard<std::mutex> Lock(m_Mutex);
+			if (Result.Succeeded)
+				m_Stats.NumCompleted++;
+			else
+				m_Stats.NumFailed++;
+			m_Stats.BytesRead += Result.BytesRead;
+			m_Stats.MaxLatencyMs = std::max(m_Stats.MaxLatencyMs, Result.LatencyMs);
+			m_TotalLatencyMs += Result.LatencyMs;
+		}
+
+		if (Read.Request.OnComplete)
+			Read.Request.OnComplete(Result);
+
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		if (--m_NumOutstanding == 0u)
+		{
+			m_BusyTime += std::chrono::steady_clock::now() - m_BusySince;
+			m_IdleCondition.notify_all();
+			// Threads waiting to shut down are waiting for the last callback.
+			if (m_Stopping)
+			{
+				m_WorkCondition.notify_all();
+				if (m_pBackend)
+					m_pBackend->Wake();
+			}
+		}
+	}
+
+	bool AsyncIO::AcquireFile(AsyncRead& Read)
+	{
+		std::lock_guard<std::mutex> Lock(m_FilesMutex);
+		auto Iter = m_OpenFiles.find(Read.Request.Path);
+		if (Iter == m_OpenFiles.end())
+		{
+			const intptr_t File = OpenFileForRead(Read.Request.Path, m_pBackend && m_pBackend->UsesOverlappedFiles());
+			if (File == InvalidFile)
+				return false;
+			if (m_pBackend && !m_pBackend->OnFileOpened(File))
+			{
+				CloseFile(File);
+				return false;
+			}
+			Iter = m_OpenFiles.insert({ Read.Request.Path, { File, 0u } }).first;
+		}
+
+		Iter->second.NumReads++;
+		Read.File = Iter->second.Handle;
+		return true;
+	}
+
+	void AsyncIO::ReleaseFile(AsyncRead& Read)
+	{
+		std::lock_guard<std::mutex> Lock(m_FilesMutex);
+		auto Iter = m_OpenFiles.find(Read.Request.Path);
+		if (Iter != m_OpenFiles.end() && --Iter->second.NumReads == 0u)
+		{
+			CloseFile(Iter->second.Handle);
+			m_OpenFiles.erase(Iter);
+		}
+		Read.File = InvalidFile;
+	}
+
+	void AsyncIO::IOThread()
+	{
+		// Reads with the backend, owned here until they are handed to the workers.
+		std::unordered_map<AsyncRead*, std::unique_ptr<AsyncRead>> InFlight;
+		std::vector<std::unique_ptr<AsyncRead>> Popped;
+		std::vector<AsyncRead*> Submissions;
+		std::vector<AsyncCompletion> Completions;
+
+		while (true)
+		{
+			m_WakePending = false;
+
+			// Fill the OS queue from the highest priority reads.
+			{
+				std::lock_guard<std::mutex> Lock(m_Mutex);
+				if (m_Stopping && m_NumQueued == 0u && InFlight.empty())
+					break;
+
+				while (m_NumInFlight + Popped.size() < m_Settings.QueueDepth)
+				{
+					std::unique_ptr<AsyncRead> pRead = PopQueued();
+					if (!pRead)
+						break;
+					Popped.push_back(std::move(pRead));
+				}
+				m_NumInFlight += static_cast<uint32_t>(Popped.size());
+				m_Stats.PeakInFlight = std::max(m_Stats.PeakInFlight, m_NumInFlight);
+			}
+
+			for (std::unique_ptr<AsyncRead>& pRead : Popped)
+			{
+				if (!AcquireFile(*pRead))
+				{
+					pRead->Failed = true;
+					Completions.push_back({ pRead.get(), -1 });
+				}
+				else
+				{
+					Submissions.push_back(pRead.get());
+				}
+				AsyncRead* pKey = pRead.get();
+				InFlight.emplace(pKey, std::move(pRead));
+			}
+			Popped.clear();
+
+			m_pBackend->Submit(Submissions, Completions);
+			Submissions.clear();
+			if (Completions.empty())
+				m_pBackend->Wait(Completions);
+
+			// Reads that stopped short of the end of the file are read again from where they stopped.
+			std::lock_guard<std::mutex> Lock(m_Mutex);
+			for (const AsyncCompletion& Completion : Completions)
+			{
+				AsyncRead& Read = *Completion.pRead;
+				if (Completion.Result < 0)
+				{
+					Read.Failed = true;
+				}
+				else
+				{
+					Read.BytesRead += static_cast<uint64_t>(Completion.Result);
+					if (Completion.Result > 0 && Read.GetRemaining() > 0u)
+					{
+						Submissions.push_back(&Read);
+						continue;
+					}
+				}
+
+				if (Read.File != InvalidFile)
+					ReleaseFile(Read);
+				m_NumInFlight--;
+				auto Iter = InFlight.find(&Read);
+				QueueCompletion(std::move(Iter->second));
+				InFlight.erase(Iter);
+			}
+			Completions.clear();
+		}
+	}
+
+	void AsyncIO::WorkerThread()
+	{
+		std::unique_lock<std::mutex> Lock(m_Mutex);
+		while (true)
+		{
+			if (!m_Completed.empty())
+			{
+				std::unique_ptr<AsyncRead> pRead = std::move(m_Completed.front());
+				m_Completed.pop_front();
+				Lock.unlock();
+				RunCompletion(*pRead);
+				pRead.reset();
+				Lock.lock();
+				continue;
+			}
+
+			// Without a backend the workers read the files themselves.
+			if (!m_pBackend && m_NumQueued > 0u)
+			{
+				std::unique_ptr<AsyncRead> pRead = PopQueued();
+				m_NumInFlight++;
+				m_Stats.PeakInFlight = std::max(m_Stats.PeakInFlight, m_NumInFlight);
+				Lock.unlock();
+
+				if (AcquireFile(*pRead))
+				{
+					ReadBlocking(*pRead);
+					ReleaseFile(*pRead);
+				}
+				else
+				{
+					pRead->Failed = true;
+				}
+
+				Lock.lock();
+				m_NumInFlight--;
+				Lock.unlock();
+				RunCompletion(*pRead);
+				pRead.reset();
+				Lock.lock();
+				continue;
+			}
+
+			if (m_Stopping && m_NumOutstanding == 0u)
+				break;
+			m_WorkCondition.wait(Lock);
+		}
+	}
+
+}
@@ -0,0 +1,186 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Async_IO.h
+	Source - Async_IO.cpp
+
+	Purpose:
+	Reads file ranges in the background and calls back when each read has finished.
+
+	Description:
+	A read request names a file, the range to read, where to put the bytes, a priority and a completion
+	callback. Requests are queued by priority and handed to one of these backends:
+	I/O Completion Port	- Windows. One I/O thread issues overlapped ReadFile calls and waits on the port.
+	io_uring			- Linux. One I/O thread fills the submission ring with every read that fits and
+						  submits the batch with a single io_uring_enter, then reaps the completion ring.
+	Thread Pool			- Every platform, and the fallback if the platform's queue cannot be created. Worker
+						  threads pop requests and read them with blocking positional reads.
+	At most QueueDepth reads are with the OS at once. Queued reads that have not been submitted yet are
+	taken highest priority first. Completion callbacks never run on the I/O thread, they are run by the
+	worker threads so a loader can decode one file while the next ones are still being read.
+	Files stay open while they have reads in flight, so a batch of reads out of one .iepak opens it once.
+	Reads issued while the service is not running are read on the calling thread before Read returns.
+
+	Example Usage:
+	AsyncIO::ReadRequest Request;
+	Request.Path = "../Content.iepak";
+	Request.Offset = Entry.Offset;
+	Request.Size = Entry.StoredSize;
+	Request.pDestination = Buffer.data();
+	Request.OnComplete = [](const AsyncIO::ReadResult& Result) { ... };
+	AsyncIO::Get().Read(std::move(Request));
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+
+namespace Insight {
+
+	struct AsyncRead;
+	class AsyncIOBackend;
+
+	class INSIGHT_API AsyncIO
+	{
+	public:
+		enum class Priority : uint8_t
+		{
+			High,
+			Normal,
+			Low,
+
+			Count,
+		};
+
+		struct ReadResult
+		{
+			bool Succeeded = false;
+			// Less than the requested size if the range ran past the end of the file.
+			uint64_t BytesRead = 0u;
+			// Time from the request being queued to the read finishing.
+			float LatencyMs = 0.0f;
+		};
+		typedef std::function<void(const ReadResult&)> Callback;
+
+		struct ReadRequest
+		{
+			std::string Path;
+			uint64_t Offset = 0u;
+			uint64_t Size = 0u;
+			// Must stay valid until OnComplete is called.
+			void* pDestination = nullptr;
+			Priority ReadPriority = Priority::Normal;
+			// Called on a worker thread once the read has finished or failed.
+			Callback OnComplete;
+		};
+
+		struct Settings
+		{
+			// Reads handed to the OS at once.
+			uint32_t QueueDepth = 32u;
+			// Threads completion callbacks run on, the thread pool backend also reads on them. 0 picks one per core, less one.
+			uint32_t NumWorkerThreads = 0u;
+			// Use the thread pool backend even if the platform has an async one.
+			bool ForceThreadPool = false;
+		};
+
+		struct Stats
+		{
+			uint32_t NumQueued = 0u;
+			uint32_t NumInFlight = 0u;
+			uint32_t PeakInFlight = 0u;
+			uint64_t NumCompleted = 0u;
+			uint64_t NumFailed = 0u;
+			uint64_t BytesRead = 0u;
+			// Bytes read per second while there were reads queued or in flight, so idle time does not lower it.
+			float ThroughputMBs = 0.0f;
+			float AverageLatencyMs = 0.0f;
+			float MaxLatencyMs = 0.0f;
+		};
+
+	public:
+		AsyncIO();
+		~AsyncIO();
+
+		AsyncIO(const AsyncIO&) = delete;
+		AsyncIO& operator = (const AsyncIO&) = delete;
+
+		static AsyncIO& Get() { return s_Instance; }
+
+		// Start the I/O and worker threads. Returns false if the service is already running.
+		bool Init(const Settings& IOSettings);
+		inline bool Init() { return Init(Settings()); }
+		// Finish every queued read and its callback, then stop the threads.
+		void Shutdown();
+
+		// Queue a read. Thread safe, may be called from a completion callback.
+		void Read(ReadRequest Request);
+		// Wait until every queued read has finished and its callback has returned. Must not be called from a completion callback.
+		void WaitIdle();
+
+		Stats GetStats() const;
+		void ResetStats();
+		inline bool IsRunning() const { return m_Running; }
+		// "IOCP", "io_uring" or "ThreadPool". "None" while the service is not running.
+		const char* GetBackendName() const;
+
+	private:
+		void IOThread();
+		void WorkerThread();
+
+		// Take the highest priority queued read. Call with m_Mutex locked.
+		std::unique_ptr<AsyncRead> PopQueued();
+		// Hand a finished read to the worker threads. Call with m_Mutex locked.
+		void QueueCompletion(std::unique_ptr<AsyncRead> pRead);
+		// Record a finished read's stats and run its callback. Call without m_Mutex locked.
+		void RunCompletion(AsyncRead& Read);
+
+		// Open the file a read is from, or share the handle of reads already using it. Returns false if it could not be opened.
+		bool AcquireFile(AsyncRead& Read);
+		// Close the file a read is from if no other read is using it.
+		void ReleaseFile(AsyncRead& Read);
+
+	private:
+		std::unique_ptr<AsyncIOBackend> m_pBackend;
+		Settings m_Settings;
+		std::atomic<bool> m_Running = false;
+		bool m_Stopping = false;
+
+		mutable std::mutex m_Mutex;
+		// Signaled when a read is queued, a read completes or the service is stopping.
+		std::condition_variable m_WorkCondition;
+		std::condition_variable m_IdleCondition;
+		std::deque<std::unique_ptr<AsyncRead>> m_Queued[static_cast<size_t>(Priority::Count)];
+		std::deque<std::unique_ptr<AsyncRead>> m_Completed;
+		uint32_t m_NumQueued = 0u;
+		uint32_t m_NumInFlight = 0u;
+		// Reads that were queued and have not had their callback run yet.
+		uint32_t m_NumOutstanding = 0u;
+
+		// Set when the I/O thread has been woken and has not looked at the queue since.
+		std::atomic<bool> m_WakePending = false;
+
+		struct OpenFile
+		{
+			intptr_t Handle;
+			uint32_t NumReads;
+		};
+		std::mutex m_FilesMutex;
+		std::unordered_map<std::string, OpenFile> m_OpenFiles;
+
+		std::thread m_IOThread;
+		std::vector<std::thread> m_Workers;
+
+		// Stats, guarded by m_Mutex.
+		Stats m_Stats;
+		double m_TotalLatencyMs = 0.0;
+		std::chrono::steady_clock::duration m_BusyTime = {};
+		std::chrono::steady_clock::time_point m_BusySince;
+
+		static AsyncIO s_Instance;
+	};
+
+}
@@ -0,0 +1,99 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Cpu_Features.h"
+
+#include <cstring>
+
+#if defined (_MSC_VER) && (defined (_M_X64) || defined (_M_IX86))
+	#include <intrin.h>
+	#define IE_CPUID_X86
+#elif (defined (__GNUC__) || defined (__clang__)) && (defined (__x86_64__) || defined (__i386__))
+	#include <cpuid.h>
+	#define IE_CPUID_X86
+#endif
+
+namespace Insight {
+
+#if defined (IE_CPUID_X86)
+	static void QueryCpuId(uint32_t Leaf, uint32_t SubLeaf, uint32_t (&OutRegisters)[4])
+	{
+#if defined (_MSC_VER)
+		int Registers[4];
+		__cpuidex(Registers, static_cast<int>(Leaf), static_cast<int>(SubLeaf));
+		for (int i = 0; i < 4; ++i)
+			OutRegisters[i] = static_cast<uint32_t>(Registers[i]);
+#else
+		__cpuid_count(Leaf, SubLeaf, OutRegisters[0], OutRegisters[1], OutRegisters[2], OutRegisters[3]);
+#endif
+	}
+
+	// Extended control register 0: which register states the OS saves.
+	static uint64_t QueryXCR0()
+	{
+#if defined (_MSC_VER)
+		return _xgetbv(0);
+#else
+		uint32_t Low, High;
+		__asm__ __volatile__("xgetbv" : "=a"(Low), "=d"(High) : "c"(0));
+		return (static_cast<uint64_t>(High) << 32) | Low;
+#endif
+	}
+
+	static CpuFeatures DetectCpuFeatures()
+	{
+		CpuFeatures Features;
+
+		uint32_t Registers[4]; // EAX, EBX, ECX, EDX
+		QueryCpuId(0u, 0u, Registers);
+		const uint32_t MaxLeaf = Registers[0];
+		memcpy(Features.Vendor + 0, &Registers[1], 4);
+		memcpy(Features.Vendor + 4, &Registers[3], 4);
+		memcpy(Features.Vendor + 8, &Registers[2], 4);
+		Features.Vendor[12] = '\0';
+
+		if (MaxLeaf < 1u)
+			return Features;
+
+		QueryCpuId(1u, 0u, Registers);
+		const uint32_t Leaf1ECX = Registers[2];
+		Features.SSE41 = (Leaf1ECX & (1u << 19)) != 0;
+		Features.SSE42 = (Leaf1ECX & (1u << 20)) != 0;
+
+		const bool OSXSave = (Leaf1ECX & (1u << 27)) != 0;
+		const uint64_t XCR0 = OSXSave ? QueryXCR0() : 0u;
+		// XMM and YMM state.
+		const bool OSSavesAVX = (XCR0 & 0x6u) == 0x6u;
+		// Opmask, upper ZMM0-15 and ZMM16-31 state.
+		const bool OSSavesAVX512 = OSSavesAVX && (XCR0 & 0xE0u) == 0xE0u;
+
+		Features.AVX = OSSavesAVX && (Leaf1ECX & (1u << 28)) != 0;
+		Features.FMA = Features.AVX && (Leaf1ECX & (1u << 12)) != 0;
+
+		if (MaxLeaf < 7u)
+			return Features;
+
+		QueryCpuId(7u, 0u, Registers);
+		const uint32_t Leaf7EBX = Registers[1];
+		Features.AVX2 = Features.AVX && (Leaf7EBX & (1u << 5)) != 0;
+		Features.AVX512F = OSSavesAVX512 && (Leaf7EBX & (1u << 16)) != 0;
+		Features.AVX512DQ = Features.AVX512F && (Leaf7EBX & (1u << 17)) != 0;
+		Features.AVX512BW = Features.AVX512F && (Leaf7EBX & (1u << 30)) != 0;
+		Features.AVX512VL = Features.AVX512F && (Leaf7EBX & (1u << 31)) != 0;
+
+		return Features;
+	}
+#else
+	static CpuFeatures DetectCpuFeatures()
+	{
+		return CpuFeatures{};
+	}
+#endif // IE_CPUID_X86
+
+	const CpuFeatures& CpuFeatures::Get()
+	{
+		static const CpuFeatures s_Features = DetectCpuFeatures();
+		return s_Features;
+	}
+
+} // end namespace Insight
@@ -0,0 +1,41 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Cpu_Features.h
+	Source - Cpu_Features.cpp
+
+	Purpose:
+	Reports which instruction set extensions the CPU running the engine supports.
+
+	Description:
+	Queried once with CPUID on first use. AVX levels are only reported when the operating system
+	also saves the wider registers on context switches (XGETBV), so a reported feature is always
+	safe to use. Non x86 platforms report no features.
+
+	Example Usage:
+	if (CpuFeatures::Get().AVX2) { ... }
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+namespace Insight {
+
+	struct INSIGHT_API CpuFeatures
+	{
+		bool SSE41 = false;
+		bool SSE42 = false;
+		bool AVX = false;
+		bool AVX2 = false;
+		bool FMA = false;
+		bool AVX512F = false;
+		bool AVX512DQ = false;
+		bool AVX512BW = false;
+		bool AVX512VL = false;
+
+		// CPU vendor string (Ex. "GenuineIntel"). Empty on non x86 platforms.
+		char Vendor[13] = {};
+
+		static const CpuFeatures& Get();
+	};
+
+} // end namespace Insight
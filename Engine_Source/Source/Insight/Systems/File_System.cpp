@@ -4,15 +4,14 @@
 
 #include "Insight/Core/Application.h"
 #include "Insight/Core/Scene/scene.h"
+#include "Insight/Core/Scene/Scene_Loader.h"
+#include "Insight/Core/Scene/Scene_Journal.h"
+#include "Insight/Systems/Json_Stream_Reader.h"
+#include "Insight/Systems/Virtual_File_System.h"
 #include "Insight/Core/ie_Exception.h"
 #include "Insight/Utilities/String_Helper.h"
 
-#include "Insight/Rendering/APost_Fx.h"
-#include "Insight/Rendering/ASky_Light.h"
-#include "Insight/Rendering/ASky_Sphere.h"
-#include "Insight/Rendering/Lighting/ASpot_Light.h"
-#include "Insight/Rendering/Lighting/APoint_Light.h"
-#include "Insight/Rendering/Lighting/ADirectional_Light.h"
+#include <filesystem>
 
 namespace Insight {
 
@@ -29,33 +28,40 @@ namespace Insight {
 	bool FileSystem::Init()
 	{
 		SetWorkingDirectory();
-		
+		MountContent();
+
+		// Asset loaders queue their reads and decode on the I/O workers as the reads finish.
+		AsyncIO::Get().Init();
+
 		return true;
 	}
 
-	char* FileSystem::ReadRawData(const char* Path, size_t& OutDataSize)
+	void FileSystem::MountContent()
 	{
-		FILE* pFile = fopen(Path, "rb");
-		if (!pFile)
-		{
-			HRESULT hr = HRESULT_FROM_WIN32(GetLastError());
-			IE_DEBUG_LOG(LogSeverity::Error, "Failed to read raw file with path: \"{0}\"", Path);
-			OutDataSize = -1;
-			return nullptr;
-		}
+		VirtualFileSystem& VFS = VirtualFileSystem::Get();
+#if defined (IE_GAME_DIST)
+		VFS.SetPreferLooseFiles(false);
+#else
+		// Files edited while the engine is running are read over the packed copies.
+		VFS.SetPreferLooseFiles(true);
+#endif
 
-		// Get the size of the file.
-		fseek(pFile, 0, SEEK_END);
-		OutDataSize = ftell(pFile);
-		fseek(pFile, 0, SEEK_SET);
-		
-		// Fill the buffer with the data in the file.
-		char* FileContents = new char[OutDataSize];
-		fread(FileContents, 1, OutDataSize, pFile);
+		// "../Content/" is packed to "../Content.iepak".
+		std::string ContentDirectory = StringHelper::WideToString(GetRelativeContentDirectoryW(L""));
+		ContentDirectory.pop_back();
+		const std::string PakPath = ContentDirectory + ".iepak";
 
-		fclose(pFile);
+		std::error_code Error;
+		if (std::filesystem::exists(PakPath, Error))
+			VFS.Mount(ContentDirectory, PakPath);
+	}
 
-		return FileContents;
+	FileView FileSystem::ReadFile(const std::string& Path)
+	{
+		FileView View = VirtualFileSystem::Get().Read(Path);
+		if (!View)
+			IE_DEBUG_LOG(LogSeverity::Error, "Failed to read file with path: \"{0}\"", Path);
+		return View;
 	}
 
 	void FileSystem::SaveEngineUserSettings(Renderer::GraphicsSettings Settings)
@@ -124,20 +130,22 @@ namespace Insight {
 		{
 			ScopedPerfTimer("LoadSceneFromJson::LoadGraphicsSettingsFromJson", OutputType_Seconds);
 
-			rapidjson::Document RawSettingsFile;
+			// Settings missing from the file keep their defaults.
+			JsonStream::GraphicsSettings RendererSettings;
+			RendererSettings.TargetAPI = (int)UserGraphicsSettings.TargetRenderAPI;
+			RendererSettings.TextureQuality = UserGraphicsSettings.MipLodBias;
+			RendererSettings.TextureFiltering = (int)UserGraphicsSettings.MaxAnisotropy;
+			RendererSettings.RayTraceEnabled = UserGraphicsSettings.RayTraceEnabled;
+
 			const std::string SettingsDir = StringHelper::WideToString(GetRelativeContentDirectoryW(L"PROFSAVE.ini"));
-			if (!json::load(SettingsDir.c_str(), RawSettingsFile)) {
+			if (!JsonStream::ReadGraphicsSettings(SettingsDir.c_str(), RendererSettings)) {
 				IE_DEBUG_LOG(LogSeverity::Error, "Failed to load graphics settings from file: \"{0}\". Default graphics settings will be applied.", SettingsDir);
 				return UserGraphicsSettings;
 			}
-			int MaxAniso, TargetRenderAPI;
-			const rapidjson::Value& RendererSettings = RawSettingsFile["Renderer"];
-			json::get_int(RendererSettings[0], "TargetAPI", TargetRenderAPI);
-			json::get_float(RendererSettings[0], "TextureQuality", UserGraphicsSettings.MipLodBias);
-			json::get_int(RendererSettings[0], "TextureFiltering", MaxAniso);
-			json::get_bool(RendererSettings[0], "RayTraceEnabled", UserGraphicsSettings.RayTraceEnabled);
-			UserGraphicsSettings.MaxAnisotropy = MaxAniso;
-			UserGraphicsSettings.TargetRenderAPI = (Renderer::TargetRenderAPI)TargetRenderAPI;
+			UserGraphicsSettings.TargetRenderAPI = (Renderer::TargetRenderAPI)RendererSettings.TargetAPI;
+			UserGraphicsSettings.MipLodBias = RendererSettings.TextureQuality;
+			UserGraphicsSettings.MaxAnisotropy = RendererSettings.TextureFiltering;
+			UserGraphicsSettings.RayTraceEnabled = RendererSettings.RayTraceEnabled;
 		}
 
 		return UserGraphicsSettings;
@@ -145,114 +153,16 @@ namespace Insight {
 
 	bool FileSystem::LoadSceneFromJson(const std::string& FileName, Scene* pScene)
 	{
-		// Load in Meta.json
-		{
-			ScopedPerfTimer("LoadSceneFromJson::LoadMetaData", OutputType_Seconds);
-
-			rapidjson::Document rawMetaFile;
-			const std::string metaDir = FileName + "/Meta.json";
-			if (!json::load(metaDir.c_str(), rawMetaFile)) {
-				IE_DEBUG_LOG(LogSeverity::Error, "Failed to load meta file from scene: \"{0}\" from file.", FileName);
-				return false;
-			}
-			std::string sceneName;
-			int NumActorsInScene;
-			json::get_string(rawMetaFile, "SceneName", sceneName);
-			pScene->SetDisplayName(sceneName);
-			Renderer::GetWindowRef().SetWindowTitle(sceneName);
-			
-			json::get_int(rawMetaFile, "NumSceneActors", NumActorsInScene);
-			pScene->ResizeSceneGraph(NumActorsInScene);
-
-			IE_DEBUG_LOG(LogSeverity::Verbose, "Scene meta data loaded.");
-		}
-
-		// Load in Resources.json
-		{
-			ScopedPerfTimer("LoadSceneFromJson::LoadResources", OutputType_Seconds);
-
-			rapidjson::Document RawResourceFile;
-			const std::string ResorurceDir = FileName + "/Resources.json";
-			if (!json::load(ResorurceDir.c_str(), RawResourceFile)) {
-				IE_DEBUG_LOG(LogSeverity::Error, "Failed to load resource file from scene: \"{0}\" from file.", FileName);
-				return false;
-			}
-
-			ResourceManager::Get().LoadResourcesFromJson(RawResourceFile);
-
-			IE_DEBUG_LOG(LogSeverity::Verbose, "Scene resouces loaded.");
-		}
-
-		// Load in Actors.json last once resources have been intialized
-		{
-			ScopedPerfTimer("LoadSceneFromJson::LoadActors", OutputType_Seconds);
-
-			rapidjson::Document RawActorsFile;
-			const std::string ActorsDir = FileName + "/Actors.json";
-			if (!json::load(ActorsDir.c_str(), RawActorsFile)) {
-				IE_DEBUG_LOG(LogSeverity::Error, "Failed to load actor file from scene: \"{0}\" from file.", FileName);
-				return false;
-			}
-
-			Runtime::AActor* pNewActor = nullptr;
-			uint32_t ActorSceneIndex = 0;
-
-			const rapidjson::Value& SceneObjects = RawActorsFile["Set"];
-			for (rapidjson::SizeType a = 0; a < SceneObjects.Size(); a++)
-			{
-				const rapidjson::Value& jsonActor = SceneObjects[a];
-
-				std::string ActorDisplayName;
-				std::string ActorType;
-				json::get_string(jsonActor, "DisplayName", ActorDisplayName);
-				json::get_string(jsonActor, "Type", ActorType);
-
-				if (ActorType == "Actor") {
-					pNewActor = new Runtime::AActor(ActorSceneIndex, ActorDisplayName);
-					pNewActor->LoadFromJson(&jsonActor);
-				}
-				else if (ActorType == "PointLight") {
-					pNewActor = new APointLight(ActorSceneIndex, ActorDisplayName);
-					pNewActor->LoadFromJson(&jsonActor);
-				}
-				else if (ActorType == "SpotLight") {
-					pNewActor = new ASpotLight(ActorSceneIndex, ActorDisplayName);
-					pNewActor->LoadFromJson(&jsonActor);
-				}
- 				else if (ActorType == "DirectionalLight") {
-					pNewActor = new ADirectionalLight(ActorSceneIndex, ActorDisplayName);
-					pNewActor->LoadFromJson(&jsonActor);
-				}
-				else if (ActorType == "SkySphere") {
-					pNewActor = new ASkySphere(ActorSceneIndex, ActorDisplayName);
-					pNewActor->LoadFromJson(&jsonActor);
-				}
-				else if (ActorType == "SkyLight") {
-					pNewActor = new ASkyLight(ActorSceneIndex, ActorDisplayName);
-					pNewActor->LoadFromJson(&jsonActor);
-				}
-				else if (ActorType == "PostFxVolume") {
-					pNewActor = new APostFx(ActorSceneIndex, ActorDisplayName);
-					pNewActor->LoadFromJson(&jsonActor);
-				}
-
-				if (pNewActor == nullptr) {
-					IE_DEBUG_LOG(LogSeverity::Error, "Failed to parse actor \"{0}\" into scene", (ActorDisplayName == "") ? "INVALID NAME" : ActorDisplayName);
-					continue;
-				}
-
-				pScene->AddActor(pNewActor);
-				ActorSceneIndex++;
-			}
-
-			IE_DEBUG_LOG(LogSeverity::Verbose, "Scene actors loaded.");
-		}
-
-		return true;
+		SceneLoader Loader(FileName, pScene);
+		return Loader.Load();
 	}
 
 	bool FileSystem::WriteSceneToJson(Scene* pScene)
 	{
+		// A scene that was loaded or saved before is saved back to the same folder.
+		SceneJournal& Journal = pScene->GetJournal();
+		const std::string SceneDirectory = Journal.IsTracking() ? Journal.GetSceneDirectory() : "../Content/Scenes/" + pScene->GetDisplayName() + ".iescene";
+
 		// Save Out Meta.json
 		{
 			rapidjson::StringBuffer StrBuffer;
@@ -263,10 +173,15 @@ namespace Insight {
 			Writer.String(pScene->GetDisplayName().c_str());
 			Writer.Key("NumSceneActors");
 			Writer.Int(pScene->GetNumSceneActors());
+			if (pScene->GetWorldCellSize() > 0.0f)
+			{
+				Writer.Key("WorldCellSize");
+				Writer.Double(pScene->GetWorldCellSize());
+			}
 			Writer.EndObject();
 
 			// Final Export
-			std::string sceneName = "../Content/Scenes/" + pScene->GetDisplayName() + ".iescene/Meta.json";
+			std::string sceneName = SceneDirectory + "/Meta.json";
 			std::ofstream offstream(sceneName.c_str());
 			offstream << StrBuffer.GetString();
 
@@ -276,6 +191,16 @@ namespace Insight {
 			}
 		}
 
+		// Only the actors that changed since the last save are appended to the scene's journal.
+		if (Journal.IsTracking())
+		{
+			if (!Journal.Append(pScene->GetSceneRoot())) {
+				IE_DEBUG_LOG(LogSeverity::Error, "Failed to append changed actors to the journal for scene: {0}", pScene->GetDisplayName());
+				return false;
+			}
+			return true;
+		}
+
 		// Save Out Actors.json
 		{
 			rapidjson::StringBuffer StrBuffer;
@@ -284,7 +209,7 @@ namespace Insight {
 			pScene->WriteToJson(&Writer);
 
 			// Final Export
-			std::string sceneName = "../Content/Scenes/" + pScene->GetDisplayName() + ".iescene/Actors.json";
+			std::string sceneName = SceneDirectory + "/Actors.json";
 			std::ofstream offstream(sceneName.c_str());
 			offstream << StrBuffer.GetString();
 
@@ -293,21 +218,14 @@ namespace Insight {
 				return false;
 			}
 		}
+		Journal.TrackFullSave(SceneDirectory, pScene->GetSceneRoot());
 
 		return true;
 	}
 
 	bool FileSystem::FileExistsInContentDirectory(const std::string& Path)
 	{
-		std::string RawPath;
-#if defined (IE_PLATFORM_BUILD_WIN32)
-		RawPath += "../Content/" + Path;
-		return PathFileExistsA(RawPath.c_str());
-#elif defined (IE_PLATFORM_BUILD_UWP)
-		RawPath += "Content/" + Path;
-		#pragma message ("UWP: FileExistsInContentDirectory not implemented for this platform.")
-		return false;
-#endif
+		return VirtualFileSystem::Get().Exists(StringHelper::WideToString(GetRelativeContentDirectoryW(StringHelper::StringToWide(Path))));
 	}
 
 	std::wstring FileSystem::GetShaderPathW(const wchar_t* Shader)
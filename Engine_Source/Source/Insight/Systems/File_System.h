@@ -2,6 +2,7 @@
 
 #include <Insight/Core.h>
 #include "Insight/Rendering/Renderer.h"
+#include "Insight/Systems/Mapped_File.h"
 
 namespace Insight {
 
@@ -14,8 +15,8 @@ namespace Insight {
 		~FileSystem();
 
 		/*
-			Initializes the filesystems working directory. Should be called once
-			during app initialization.
+			Initializes the filesystems working directory and mounts the packed content
+			if there is any, see VirtualFileSystem. Should be called once during app initialization.
 		*/
 		static bool Init();
 
@@ -45,14 +46,16 @@ namespace Insight {
 		static Renderer::GraphicsSettings LoadGraphicsSettingsFromJson();
 
 		/*
-			loads a scene from a json file.
+			loads a scene from a json file. See SceneLoader for the stages the scene is loaded in.
 			@param Filename - Content directory relative path to the scene to be loaded.
 			@pram pScene - Scene object to populate.
 		*/
 		static bool LoadSceneFromJson(const std::string& FileName, Scene* pScene);
 
 		/*
-			Saves a scene to a json file.
+			Saves a scene to a json file. Scenes that were loaded or saved before only append
+			their changed actors to the scene's journal, see SceneJournal. The cells of partitioned
+			scenes are cooked separately from what was saved, see WorldPartition.
 			@param pScene - The scene onject to parse to disk.
 		*/
 		static bool WriteSceneToJson(Scene* pScene);
@@ -70,12 +73,11 @@ namespace Insight {
 		static std::wstring GetShaderPathW(const wchar_t* Shader);
 
 		/*
-			Reads in the raw data for a file and returns its contents. nullptr if the file read was unsuccessful. WARNING: Creates data on the heap,
-			make sure to free the return value once you are finished with it.
+			Reads a whole file through the VirtualFileSystem, from the packed content or from disk.
+			The view is invalid if the file could not be read. Its data stays valid for as long as the view is held.
 			@param Path - Exe relative path to the file to read.
-			@param OutDataSize - Populated with the size of the file that is read in. -1 if the file read was unsuccessful.
 		*/
-		static char* ReadRawData(const char* Path, size_t& OutDataSize);
+		static FileView ReadFile(const std::string& Path);
 
 	protected:
 		/*
@@ -88,6 +90,10 @@ namespace Insight {
 			Set the current working directory for the application.
 		*/
 		static void SetWorkingDirectory();
+		/*
+			Mount Content.iepak, packed next to the Content folder, over the Content folder.
+		*/
+		static void MountContent();
 	};
 
 }
@@ -0,0 +1,216 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "File_Watcher.h"
+
+#include "Insight/Utilities/String_Helper.h"
+
+#include <filesystem>
+
+namespace Insight {
+
+	typedef std::unordered_map<std::string, std::filesystem::file_time_type> FileWriteTimes;
+
+	// Record the last write time of every file under a directory.
+	static void ScanWriteTimes(const std::string& Directory, FileWriteTimes& OutWriteTimes)
+	{
+		std::error_code Error;
+		std::filesystem::recursive_directory_iterator Iter(Directory, std::filesystem::directory_options::skip_permission_denied, Error);
+		for (; !Error && Iter != std::filesystem::recursive_directory_iterator(); Iter.increment(Error))
+		{
+			if (!Iter->is_regular_file(Error))
+				continue;
+
+			const std::filesystem::file_time_type WriteTime = Iter->last_write_time(Error);
+			if (!Error)
+				OutWriteTimes[Iter->path().string()] = WriteTime;
+		}
+	}
+
+	FileWatcher::~FileWatcher()
+	{
+		Stop();
+	}
+
+	bool FileWatcher::Start(const std::string& Directory)
+	{
+		Stop();
+
+		std::error_code Error;
+		if (!std::filesystem::is_directory(Directory, Error)) {
+			IE_DEBUG_LOG(LogSeverity::Error, "Failed to watch directory \"{0}\", it does not exist.", Directory);
+			return false;
+		}
+		m_Directory = Directory;
+		m_Running = true;
+
+#if defined (IE_PLATFORM_BUILD_WIN32)
+		m_hDirectory = CreateFileW(StringHelper::StringToWide(Directory).c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+			nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+		m_hStopEvent = CreateEvent(nullptr, TRUE, FALSE, nullptr);
+		if (m_hDirectory != INVALID_HANDLE_VALUE && m_hStopEvent)
+		{
+			m_IsPolling = false;
+			m_Thread = std::thread(&FileWatcher::NotificationThread, this);
+			return true;
+		}
+		IE_DEBUG_LOG(LogSeverity::Warning, "Failed to open change notifications for \"{0}\", it will be polled every {1}ms instead.", Directory, PollIntervalMs);
+#endif
+
+		m_IsPolling = true;
+		m_Thread = std::thread(&FileWatcher::PollThread, this);
+		return true;
+	}
+
+	void FileWatcher::Stop()
+	{
+		if (m_Thread.joinable())
+		{
+			{
+				std::lock_guard<std::mutex> Lock(m_StopMutex);
+				m_Running = false;
+			}
+			m_StopCondition.notify_all();
+#if defined (IE_PLATFORM_BUILD_WIN32)
+			if (m_hStopEvent)
+				SetEvent(m_hStopEvent);
+#endif
+			m_Thread.join();
+		}
+		m_Running = false;
+
+#if defined (IE_PLATFORM_BUILD_WIN32)
+		if (m_hDirectory != INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(m_hDirectory);
+			m_hDirectory = INVALID_HANDLE_VALUE;
+		}
+		if (m_hStopEvent)
+		{
+			CloseHandle(m_hStopEvent);
+			m_hStopEvent = nullptr;
+		}
+#endif
+
+		std::lock_guard<std::mutex> Lock(m_ChangedMutex);
+		m_ChangedFiles.clear();
+	}
+
+	void FileWatcher::PollChanges(std::vector<std::string>& OutChangedFiles, uint32_t SettleMs)
+	{
+		const std::chrono::steady_clock::time_point Now = std::chrono::steady_clock::now();
+		const std::chrono::milliseconds Settle(SettleMs);
+
+		std::lock_guard<std::mutex> Lock(m_ChangedMutex);
+		for (auto Iter = m_ChangedFiles.begin(); Iter != m_ChangedFiles.end();)
+		{
+			if (Now - Iter->second < Settle)
+			{
+				++Iter;
+				continue;
+			}
+			OutChangedFiles.push_back(Iter->first);
+			Iter = m_ChangedFiles.erase(Iter);
+		}
+	}
+
+	void FileWatcher::OnFileChanged(const std::string& Path)
+	{
+		const std::string Normalized = StringHelper::NormalizePath(Path);
+
+		std::lock_guard<std::mutex> Lock(m_ChangedMutex);
+		m_ChangedFiles[Normalized] = std::chrono::steady_clock::now();
+	}
+
+	void FileWatcher::PollThread()
+	{
+		FileWriteTimes WriteTimes;
+		ScanWriteTimes(m_Directory, WriteTimes);
+
+		std::unique_lock<std::mutex> StopLock(m_StopMutex);
+		while (!m_StopCondition.wait_for(StopLock, std::chrono::milliseconds(PollIntervalMs), [this]() { return !m_Running; }))
+		{
+			FileWriteTimes Scanned;
+			Scanned.reserve(WriteTimes.size());
+			ScanWriteTimes(m_Directory, Scanned);
+
+			for (const auto& File : Scanned)
+			{
+				auto Previous = WriteTimes.find(File.first);
+				if (Previous == WriteTimes.end() || Previous->second != File.second)
+					OnFileChanged(File.first);
+			}
+			WriteTimes = std::move(Scanned);
+		}
+	}
+
+#if defined (IE_PLATFORM_BUILD_WIN32)
+	void FileWatcher::NotificationThread()
+	{
+		// ReadDirectoryChangesW requires a DWORD aligned buffer.
+		std::vector<DWORD> NotifyBuffer(16u * 1024u);
+		const DWORD NotifyBufferBytes = static_cast<DWORD>(NotifyBuffer.size() * sizeof(DWORD));
+		const DWORD NotifyFilter = FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_FILE_NAME;
+
+		OVERLAPPED Overlapped = {};
+		Overlapped.hEvent = CreateEvent(nullptr, TRUE, FALSE, nullptr);
+		bool NotificationsFailed = Overlapped.hEvent == nullptr;
+
+		while (m_Running && !NotificationsFailed)
+		{
+			ResetEvent(Overlapped.hEvent);
+			if (!ReadDirectoryChangesW(m_hDirectory, NotifyBuffer.data(), NotifyBufferBytes, TRUE, NotifyFilter, nullptr, &Overlapped, nullptr))
+			{
+				NotificationsFailed = true;
+				break;
+			}
+
+			HANDLE WaitHandles[2] = { Overlapped.hEvent, m_hStopEvent };
+			const DWORD WaitResult = WaitForMultipleObjects(2, WaitHandles, FALSE, INFINITE);
+			DWORD NumBytes = 0;
+			if (WaitResult != WAIT_OBJECT_0)
+			{
+				// Stopped. The pending read must finish before its buffer goes away.
+				CancelIo(m_hDirectory);
+				GetOverlappedResult(m_hDirectory, &Overlapped, &NumBytes, TRUE);
+				break;
+			}
+			if (!GetOverlappedResult(m_hDirectory, &Overlapped, &NumBytes, FALSE))
+			{
+				NotificationsFailed = true;
+				break;
+			}
+			if (NumBytes == 0)
+			{
+				// More changes were made than fit in the buffer, they are lost.
+				IE_DEBUG_LOG(LogSeverity::Warning, "File change notifications for \"{0}\" overflowed. Some changes were not reported.", m_Directory);
+				continue;
+			}
+
+			const uint8_t* pRecord = reinterpret_cast<const uint8_t*>(NotifyBuffer.data());
+			for (;;)
+			{
+				const FILE_NOTIFY_INFORMATION* pInfo = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(pRecord);
+				if (pInfo->Action == FILE_ACTION_MODIFIED || pInfo->Action == FILE_ACTION_ADDED || pInfo->Action == FILE_ACTION_RENAMED_NEW_NAME)
+				{
+					const std::wstring RelativePath(pInfo->FileName, pInfo->FileNameLength / sizeof(WCHAR));
+					OnFileChanged(m_Directory + "/" + StringHelper::WideToString(RelativePath));
+				}
+				if (pInfo->NextEntryOffset == 0)
+					break;
+				pRecord += pInfo->NextEntryOffset;
+			}
+		}
+		if (Overlapped.hEvent)
+			CloseHandle(Overlapped.hEvent);
+
+		if (NotificationsFailed && m_Running)
+		{
+			IE_DEBUG_LOG(LogSeverity::Warning, "File change notifications for \"{0}\" failed, polling every {1}ms instead.", m_Directory, PollIntervalMs);
+			m_IsPolling = true;
+			PollThread();
+		}
+	}
+#endif
+
+}
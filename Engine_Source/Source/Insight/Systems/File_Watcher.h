@@ -0,0 +1,93 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - File_Watcher.h
+	Source - File_Watcher.cpp
+
+	Purpose:
+	Reports files that were written to under a directory while the engine is running.
+
+	Description:
+	A background thread waits on the platform's directory change notifications (ReadDirectoryChangesW
+	on Win32) for the whole directory tree. Platforms without them, or a directory the notifications
+	could not be opened for, fall back to comparing every file's last write time each PollIntervalMs.
+	Editors and exporters usually write a file several times when saving it, so a change is only
+	reported once the file has not been written to for the settle time passed to PollChanges.
+	Paths are reported normalized with StringHelper::NormalizePath so they can be compared with asset paths.
+
+	Example Usage:
+	m_Watcher.Start("../Content");
+	...
+	std::vector<std::string> ChangedFiles;
+	m_Watcher.PollChanges(ChangedFiles, 200u);
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+
+namespace Insight {
+
+	class INSIGHT_API FileWatcher
+	{
+	public:
+		// How often the polling fallback checks the directory.
+		static constexpr uint32_t PollIntervalMs = 500u;
+
+	public:
+		FileWatcher() = default;
+		~FileWatcher();
+
+		FileWatcher(const FileWatcher&) = delete;
+		FileWatcher& operator = (const FileWatcher&) = delete;
+
+		// Start watching every file under a directory. Returns false if the directory does not exist.
+		bool Start(const std::string& Directory);
+		// Stop watching and join the watch thread. Changes that were not polled are dropped.
+		void Stop();
+
+		/*
+			Collect the files that changed and have not been written to since.
+			@param OutChangedFiles - Appended with the normalized path of each settled file.
+			@param SettleMs - How long a file must go unchanged before it is reported.
+			Thread safe.
+		*/
+		void PollChanges(std::vector<std::string>& OutChangedFiles, uint32_t SettleMs);
+
+		inline bool IsWatching() const { return m_Running; }
+		// True if the directory is being polled rather than watched with change notifications.
+		inline bool IsPolling() const { return m_IsPolling; }
+
+	private:
+		// Record a change to a file. Called from the watch thread.
+		void OnFileChanged(const std::string& Path);
+		// Compare every file's last write time against the previous scan.
+		void PollThread();
+#if defined (IE_PLATFORM_BUILD_WIN32)
+		// Wait on ReadDirectoryChangesW. Falls back to polling if the notifications stop working.
+		void NotificationThread();
+#endif
+
+	private:
+		std::string m_Directory;
+		std::atomic<bool> m_Running = false;
+		std::atomic<bool> m_IsPolling = false;
+		std::thread m_Thread;
+
+		// Wakes the polling thread when the watcher is stopped.
+		std::mutex m_StopMutex;
+		std::condition_variable m_StopCondition;
+
+		// Changed files and when they were last written to.
+		std::mutex m_ChangedMutex;
+		std::unordered_map<std::string, std::chrono::steady_clock::time_point> m_ChangedFiles;
+
+#if defined (IE_PLATFORM_BUILD_WIN32)
+		HANDLE m_hDirectory = INVALID_HANDLE_VALUE;
+		HANDLE m_hStopEvent = nullptr;
+#endif
+	};
+
+}
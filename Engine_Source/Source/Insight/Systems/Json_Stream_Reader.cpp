@@ -0,0 +1,474 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Json_Stream_Reader.h"
+
+#include "Insight/Systems/Virtual_File_System.h"
+#include "Insight/Core/Scene/Actor_Guid.h"
+
+#include <rapidjson/reader.h>
+#include <rapidjson/memorystream.h>
+
+#include <climits>
+
+namespace Insight {
+
+	namespace JsonStream {
+
+		namespace {
+
+			// Containers nested deeper than this are still parsed, their member names are just not tracked.
+			constexpr uint32_t MaxTrackedDepth = 32u;
+			// Memory the per actor Document starts with. Most actors fit without allocating.
+			constexpr size_t ActorBufferSize = 16u * 1024u;
+
+			constexpr uint32_t Key_Set				= HashKey("Set");
+			constexpr uint32_t Key_Type				= HashKey("Type");
+			constexpr uint32_t Key_DisplayName		= HashKey("DisplayName");
+			constexpr uint32_t Key_Guid				= HashKey("Guid");
+			constexpr uint32_t Key_Subobjects		= HashKey("Subobjects");
+			constexpr uint32_t Key_StaticMesh		= HashKey("StaticMesh");
+			constexpr uint32_t Key_Mesh				= HashKey("Mesh");
+			constexpr uint32_t Key_SceneName		= HashKey("SceneName");
+			constexpr uint32_t Key_NumSceneActors	= HashKey("NumSceneActors");
+			constexpr uint32_t Key_WorldCellSize	= HashKey("WorldCellSize");
+			constexpr uint32_t Key_CellSize			= HashKey("CellSize");
+			constexpr uint32_t Key_Cells			= HashKey("Cells");
+			constexpr uint32_t Key_X				= HashKey("X");
+			constexpr uint32_t Key_Z				= HashKey("Z");
+			constexpr uint32_t Key_NumActors		= HashKey("NumActors");
+			constexpr uint32_t Key_Meshes			= HashKey("Meshes");
+			constexpr uint32_t Key_Textures			= HashKey("Textures");
+			constexpr uint32_t Key_ID				= HashKey("ID");
+			constexpr uint32_t Key_Name				= HashKey("Name");
+			constexpr uint32_t Key_Filepath			= HashKey("Filepath");
+			constexpr uint32_t Key_GenerateMipMaps	= HashKey("GenerateMipMaps");
+			constexpr uint32_t Key_Renderer			= HashKey("Renderer");
+			constexpr uint32_t Key_TargetAPI		= HashKey("TargetAPI");
+			constexpr uint32_t Key_TextureQuality	= HashKey("TextureQuality");
+			constexpr uint32_t Key_TextureFiltering	= HashKey("TextureFiltering");
+			constexpr uint32_t Key_RayTraceEnabled	= HashKey("RayTraceEnabled");
+
+			/*
+				Tracks where in the file each value is. m_Depth is the number of open objects and arrays
+				(1 inside the root object) and PathAt(d) is the hash of the member that opened the container
+				at depth d, 0 for the root and array elements. Ex. a value in Textures[2] is read at depth 3
+				with PathAt(2) == Key_Textures.
+
+				Scalar values are passed to the derived handler's On* functions with the hash of their member
+				name, converted the way the json::get_* helpers accept them.
+			*/
+			template <typename Derived>
+			class PathHandler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, Derived>
+			{
+			public:
+				bool Key(const char* Str, rapidjson::SizeType Length, bool) { m_Key = HashKey(Str, Length); return true; }
+				bool StartObject() { if (m_Depth == 0u) m_RootIsObject = true; Push(); return true; }
+				bool EndObject(rapidjson::SizeType) { Pop(); return true; }
+				bool StartArray() { Push(); return true; }
+				bool EndArray(rapidjson::SizeType) { Pop(); return true; }
+
+				// get_int only accepts values that fit in an int.
+				bool Int(int Value) { return Self().OnInt(TakeKey(), Value); }
+				bool Uint(unsigned Value) { const uint32_t Key = TakeKey(); return Value <= static_cast<unsigned>(INT_MAX) ? Self().OnInt(Key, static_cast<int>(Value)) : true; }
+				// get_float only accepts numbers written with a decimal point or exponent.
+				bool Double(double Value) { return Self().OnFloat(TakeKey(), static_cast<float>(Value)); }
+				bool Bool(bool Value) { return Self().OnBool(TakeKey(), Value); }
+				bool String(const char* Str, rapidjson::SizeType Length, bool) { return Self().OnString(TakeKey(), Str, Length); }
+				// Null, Int64 and Uint64 are never read by the engine.
+				bool Default() { m_Key = 0u; return true; }
+
+				bool OnInt(uint32_t, int) { return true; }
+				bool OnFloat(uint32_t, float) { return true; }
+				bool OnBool(uint32_t, bool) { return true; }
+				bool OnString(uint32_t, const char*, rapidjson::SizeType) { return true; }
+
+				inline bool IsRootObject() const { return m_RootIsObject; }
+
+			protected:
+				inline uint32_t PathAt(uint32_t Depth) const { return (Depth > 0u && Depth <= MaxTrackedDepth) ? m_Path[Depth - 1u] : 0u; }
+
+				uint32_t m_Depth = 0u;
+
+			private:
+				inline Derived& Self() { return static_cast<Derived&>(*this); }
+				inline uint32_t TakeKey() { const uint32_t Key = m_Key; m_Key = 0u; return Key; }
+				inline void Push()
+				{
+					if (m_Depth < MaxTrackedDepth)
+						m_Path[m_Depth] = m_Key;
+					++m_Depth;
+					m_Key = 0u;
+				}
+				inline void Pop() { --m_Depth; m_Key = 0u; }
+
+			private:
+				uint32_t m_Path[MaxTrackedDepth] = {};
+				uint32_t m_Key = 0u;
+				bool m_RootIsObject = false;
+			};
+
+			// Meta.json: { "SceneName": "...", "NumSceneActors": N, "WorldCellSize": S }
+			class SceneMetaHandler : public PathHandler<SceneMetaHandler>
+			{
+			public:
+				SceneMetaHandler(SceneMeta& Out)
+					: m_Out(Out) {}
+
+				bool OnInt(uint32_t Key, int Value)
+				{
+					if (m_Depth == 1u && Key == Key_NumSceneActors)
+						m_Out.NumSceneActors = Value;
+					return true;
+				}
+				bool OnFloat(uint32_t Key, float Value)
+				{
+					if (m_Depth == 1u && Key == Key_WorldCellSize)
+						m_Out.WorldCellSize = Value;
+					return true;
+				}
+				bool OnString(uint32_t Key, const char* Str, rapidjson::SizeType Length)
+				{
+					if (m_Depth == 1u && Key == Key_SceneName)
+						m_Out.SceneName.assign(Str, Length);
+					return true;
+				}
+
+			private:
+				SceneMeta& m_Out;
+			};
+
+			// Resources.json: { "Textures": [ { "ID", "Type", "Name", "Filepath", "GenerateMipMaps" }, ... ] }
+			class TextureResourceHandler : public PathHandler<TextureResourceHandler>
+			{
+			public:
+				TextureResourceHandler(std::vector<TextureResource>& Out)
+					: m_Out(Out) {}
+
+				bool StartObject()
+				{
+					PathHandler::StartObject();
+					if (IsInTexture())
+						m_Out.emplace_back();
+					return true;
+				}
+
+				bool OnInt(uint32_t Key, int Value)
+				{
+					if (!IsInTexture())
+						return true;
+					if (Key == Key_ID)				m_Out.back().ID = Value;
+					else if (Key == Key_Type)		m_Out.back().Type = Value;
+					return true;
+				}
+				bool OnBool(uint32_t Key, bool Value)
+				{
+					if (IsInTexture() && Key == Key_GenerateMipMaps)
+						m_Out.back().GenerateMipMaps = Value;
+					return true;
+				}
+				bool OnString(uint32_t Key, const char* Str, rapidjson::SizeType Length)
+				{
+					if (!IsInTexture())
+						return true;
+					if (Key == Key_Name)			m_Out.back().Name.assign(Str, Length);
+					else if (Key == Key_Filepath)	m_Out.back().Filepath.assign(Str, Length);
+					return true;
+				}
+
+			private:
+				inline bool IsInTexture() const { return m_Depth == 3u && PathAt(2u) == Key_Textures; }
+
+			private:
+				std::vector<TextureResource>& m_Out;
+			};
+
+			// PROFSAVE.ini: { "Renderer": [ { "TargetAPI", "TextureQuality", "TextureFiltering", "RayTraceEnabled" } ] }
+			class GraphicsSettingsHandler : public PathHandler<GraphicsSettingsHandler>
+			{
+			public:
+				GraphicsSettingsHandler(GraphicsSettings& Out)
+					: m_Out(Out) {}
+
+				bool StartObject()
+				{
+					PathHandler::StartObject();
+					if (m_Depth == 3u && PathAt(2u) == Key_Renderer)
+						++m_NumRendererEntries;
+					return true;
+				}
+
+				bool OnInt(uint32_t Key, int Value)
+				{
+					if (!IsInFirstRendererEntry())
+						return true;
+					if (Key == Key_TargetAPI)				m_Out.TargetAPI = Value;
+					else if (Key == Key_TextureFiltering)	m_Out.TextureFiltering = Value;
+					return true;
+				}
+				bool OnFloat(uint32_t Key, float Value)
+				{
+					if (IsInFirstRendererEntry() && Key == Key_TextureQuality)
+						m_Out.TextureQuality = Value;
+					return true;
+				}
+				bool OnBool(uint32_t Key, bool Value)
+				{
+					if (IsInFirstRendererEntry() && Key == Key_RayTraceEnabled)
+						m_Out.RayTraceEnabled = Value;
+					return true;
+				}
+
+			private:
+				// The engine only reads Renderer[0].
+				inline bool IsInFirstRendererEntry() const { return m_Depth == 3u && PathAt(2u) == Key_Renderer && m_NumRendererEntries == 1u; }
+
+			private:
+				GraphicsSettings& m_Out;
+				uint32_t m_NumRendererEntries = 0u;
+			};
+
+			// Cells.json: { "CellSize": S, "Cells": [ { "X", "Z", "NumActors", "Meshes": [ "...", ... ] }, ... ] }
+			class WorldCellHandler : public PathHandler<WorldCellHandler>
+			{
+			public:
+				WorldCellHandler(float& OutCellSize, std::vector<WorldCell>& OutCells)
+					: m_OutCellSize(OutCellSize), m_Out(OutCells) {}
+
+				bool StartObject()
+				{
+					PathHandler::StartObject();
+					if (IsInCell())
+						m_Out.emplace_back();
+					return true;
+				}
+
+				bool OnInt(uint32_t Key, int Value)
+				{
+					if (!IsInCell())
+						return true;
+					if (Key == Key_X)				m_Out.back().X = Value;
+					else if (Key == Key_Z)			m_Out.back().Z = Value;
+					else if (Key == Key_NumActors)	m_Out.back().NumActors = Value;
+					return true;
+				}
+				bool OnFloat(uint32_t Key, float Value)
+				{
+					if (m_Depth == 1u && Key == Key_CellSize)
+						m_OutCellSize = Value;
+					return true;
+				}
+				bool OnString(uint32_t, const char* Str, rapidjson::SizeType Length)
+				{
+					if (m_Depth == 4u && PathAt(4u) == Key_Meshes && PathAt(2u) == Key_Cells)
+						m_Out.back().Meshes.emplace_back(Str, Length);
+					return true;
+				}
+
+			private:
+				inline bool IsInCell() const { return m_Depth == 3u && PathAt(2u) == Key_Cells; }
+
+			private:
+				float& m_OutCellSize;
+				std::vector<WorldCell>& m_Out;
+			};
+
+			// Actors.json: { "Set": [ { "Type": "...", "DisplayName": "...", "Subobjects": [ { "StaticMesh": [ { "Mesh": "..." }, ... ] } ] }, ... ] }
+			class MeshReferenceHandler : public PathHandler<MeshReferenceHandler>
+			{
+			public:
+				MeshReferenceHandler(const std::function<void(const std::string&)>& OnMesh)
+					: m_OnMesh(OnMesh) {}
+
+				bool OnString(uint32_t Key, const char* Str, rapidjson::SizeType Length)
+				{
+					if (Key == Key_Mesh && m_Depth == 7u && PathAt(6u) == Key_StaticMesh && PathAt(4u) == Key_Subobjects && PathAt(2u) == Key_Set)
+					{
+						m_MeshPath.assign(Str, Length);
+						m_OnMesh(m_MeshPath);
+					}
+					return true;
+				}
+
+			private:
+				const std::function<void(const std::string&)>& m_OnMesh;
+				std::string m_MeshPath;
+			};
+
+			/*
+				Forwards the events of each actor in "Set" into a Document holding only that actor, then visits it.
+				Depth 1 is the root object, 2 the "Set" array and 3 an actor's members.
+			*/
+			class ActorHandler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, ActorHandler>
+			{
+			public:
+				ActorHandler(const ActorVisitor& Visitor)
+					: m_Visitor(Visitor)
+					, m_Buffer(ActorBufferSize)
+					, m_Allocator(m_Buffer.data(), m_Buffer.size())
+					, m_Actor(&m_Allocator)
+				{
+				}
+
+				bool StartObject()
+				{
+					if (m_Depth == 0u)
+						m_RootIsObject = true;
+					else if (m_Depth == 2u && m_InSet)
+						m_InActor = true;
+					++m_Depth;
+					return m_InActor ? m_Actor.StartObject() : true;
+				}
+				bool EndObject(rapidjson::SizeType MemberCount)
+				{
+					--m_Depth;
+					if (!m_InActor)
+						return true;
+
+					m_Actor.EndObject(MemberCount);
+					return m_Depth == 2u ? VisitActor() : true;
+				}
+				bool StartArray()
+				{
+					if (!m_InActor && m_Depth == 1u && m_Key == Key_Set)
+						m_InSet = true;
+					++m_Depth;
+					return m_InActor ? m_Actor.StartArray() : true;
+				}
+				bool EndArray(rapidjson::SizeType ElementCount)
+				{
+					--m_Depth;
+					if (m_InActor)
+						return m_Actor.EndArray(ElementCount);
+
+					if (m_Depth == 1u)
+						m_InSet = false;
+					return true;
+				}
+				bool Key(const char* Str, rapidjson::SizeType Length, bool Copy)
+				{
+					// Only the root members and the actor's own members need to be recognised.
+					if (m_Depth <= 3u)
+						m_Key = HashKey(Str, Length);
+					return m_InActor ? m_Actor.Key(Str, Length, Copy) : true;
+				}
+				bool String(const char* Str, rapidjson::SizeType Length, bool Copy)
+				{
+					if (!m_InActor)
+						return true;
+
+					if (m_Depth == 3u)
+					{
+						if (m_Key == Key_Type)				m_Header.Type.assign(Str, Length);
+						else if (m_Key == Key_DisplayName)	m_Header.DisplayName.assign(Str, Length);
+						else if (m_Key == Key_Guid)			m_Header.Guid = ActorGuidFromString(Str, Length);
+					}
+					return m_Actor.String(Str, Length, Copy);
+				}
+				bool Null()						{ return m_InActor ? m_Actor.Null() : true; }
+				bool Bool(bool Value)			{ return m_InActor ? m_Actor.Bool(Value) : true; }
+				bool Int(int Value)				{ return m_InActor ? m_Actor.Int(Value) : true; }
+				bool Uint(unsigned Value)		{ return m_InActor ? m_Actor.Uint(Value) : true; }
+				bool Int64(int64_t Value)		{ return m_InActor ? m_Actor.Int64(Value) : true; }
+				bool Uint64(uint64_t Value)		{ return m_InActor ? m_Actor.Uint64(Value) : true; }
+				bool Double(double Value)		{ return m_InActor ? m_Actor.Double(Value) : true; }
+
+				inline bool IsRootObject() const { return m_RootIsObject; }
+				inline const ActorReadStats& GetStats() const { return m_Stats; }
+
+			private:
+				bool VisitActor()
+				{
+					// Move the finished actor off the Document's parse stack into the Document itself.
+					auto Finish = [](rapidjson::Document&) { return true; };
+					m_Actor.Populate(Finish);
+
+					const size_t ActorBytes = m_Allocator.Capacity() + m_Actor.GetStackCapacity();
+					m_Stats.PeakActorBytes = ActorBytes > m_Stats.PeakActorBytes ? ActorBytes : m_Stats.PeakActorBytes;
+
+					m_Header.Index = m_Stats.NumActors++;
+					const bool Continue = m_Visitor(m_Header, m_Actor);
+
+					// Release the actor, the allocator keeps its initial buffer for the next one.
+					m_Actor.SetNull();
+					m_Allocator.Clear();
+					m_Header.Type.clear();
+					m_Header.DisplayName.clear();
+					m_Header.Guid = 0u;
+					m_InActor = false;
+					return Continue;
+				}
+
+			private:
+				const ActorVisitor& m_Visitor;
+				std::vector<char> m_Buffer;
+				rapidjson::MemoryPoolAllocator<> m_Allocator;
+				rapidjson::Document m_Actor;
+
+				ActorHeader m_Header;
+				ActorReadStats m_Stats;
+				uint32_t m_Depth = 0u;
+				uint32_t m_Key = 0u;
+				bool m_RootIsObject = false;
+				bool m_InSet = false;
+				bool m_InActor = false;
+			};
+
+			template <typename Handler>
+			bool ParseFile(const char* Path, Handler& FileHandler)
+			{
+				const FileView View = VirtualFileSystem::Get().Read(Path);
+				if (!View)
+					return false;
+
+				rapidjson::MemoryStream Stream(View.GetChars(), View.GetSize());
+				rapidjson::Reader Reader;
+				const rapidjson::ParseResult Result = Reader.Parse(Stream, FileHandler);
+
+				// json::load only accepts files with an object at the root.
+				return !Result.IsError() && FileHandler.IsRootObject();
+			}
+
+		} // end anonymous namespace
+
+		bool ReadSceneMeta(const char* Path, SceneMeta& OutMeta)
+		{
+			SceneMetaHandler Handler(OutMeta);
+			return ParseFile(Path, Handler);
+		}
+
+		bool ReadTextureResources(const char* Path, std::vector<TextureResource>& OutTextures)
+		{
+			TextureResourceHandler Handler(OutTextures);
+			return ParseFile(Path, Handler);
+		}
+
+		bool ReadGraphicsSettings(const char* Path, GraphicsSettings& OutSettings)
+		{
+			GraphicsSettingsHandler Handler(OutSettings);
+			return ParseFile(Path, Handler);
+		}
+
+		bool ReadWorldCells(const char* Path, float& OutCellSize, std::vector<WorldCell>& OutCells)
+		{
+			WorldCellHandler Handler(OutCellSize, OutCells);
+			return ParseFile(Path, Handler);
+		}
+
+		bool ReadActors(const char* Path, const ActorVisitor& Visitor, ActorReadStats* pOutStats)
+		{
+			ActorHandler Handler(Visitor);
+			const bool Succeeded = ParseFile(Path, Handler);
+			if (pOutStats)
+				*pOutStats = Handler.GetStats();
+			return Succeeded;
+		}
+
+		bool ReadMeshReferences(const char* Path, const std::function<void(const std::string& MeshPath)>& OnMesh)
+		{
+			MeshReferenceHandler Handler(OnMesh);
+			return ParseFile(Path, Handler);
+		}
+
+	} // end namespace JsonStream
+}
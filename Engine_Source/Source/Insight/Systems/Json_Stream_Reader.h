@@ -0,0 +1,134 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Json_Stream_Reader.h
+	Source - Json_Stream_Reader.cpp
+
+	Purpose:
+	Reads the engine's json files (scene files and PROFSAVE.ini) as a stream of SAX events
+	instead of building a rapidjson::Document for the whole file.
+
+	Description:
+	Each reader runs a rapidjson::Reader over the file's view from the VirtualFileSystem, mapped
+	or read out of the packed content, so nothing is copied to read it. Member names are hashed as
+	they arrive and the hash of the member that opened every enclosing object or array is kept
+	on a stack, so a value is matched against the path it was found at (Ex. Textures[].ID)
+	and written straight into the output struct. Nothing but the output is allocated.
+
+	Fields follow the same rules as the json::get_* helpers used by the DOM readers, so existing
+	files load exactly the same: a missing or mistyped field leaves the output untouched and
+	float fields only accept numbers written with a decimal point.
+
+	Actors are too varied to flatten into one struct, and every actor type reads itself with
+	LoadFromJson. ReadActors captures each actor's type and name directly and builds a small
+	Document for only the actor being visited. That Document is cleared and its memory reused
+	for the next actor, so memory use depends on the largest actor rather than on the scene size.
+
+	Example Usage:
+	JsonStream::ReadActors("../Content/Scenes/Debug.iescene/Actors.json",
+		[](const JsonStream::ActorHeader& Header, const rapidjson::Value& JsonActor) { ...; return true; });
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+#include "Insight/Utilities/String_Id.h"
+
+#include <functional>
+
+namespace Insight {
+
+	namespace JsonStream {
+
+		// Hash of a member name, the same as StringId32's. Usable in constant expressions.
+		constexpr uint32_t HashKey(const char* Key, size_t Length)
+		{
+			return StringHash::Fnv1a32(Key, Length);
+		}
+
+		constexpr uint32_t HashKey(const char* Key)
+		{
+			return StringHash::Fnv1a32(Key, StringHash::Length(Key));
+		}
+
+		// Meta.json
+		struct SceneMeta
+		{
+			std::string SceneName;
+			int NumSceneActors = 0;
+			// Size of a world partition cell, 0 if the scene is not partitioned. See WorldPartition.
+			float WorldCellSize = 0.0f;
+		};
+
+		// An entry of the "Textures" array in Resources.json.
+		struct TextureResource
+		{
+			int ID = 0;
+			int Type = 0;
+			std::string Name;
+			std::string Filepath;
+			bool GenerateMipMaps = false;
+		};
+
+		// The "Renderer" settings in PROFSAVE.ini.
+		struct GraphicsSettings
+		{
+			int TargetAPI = 0;
+			float TextureQuality = 0.0f;
+			int TextureFiltering = 0;
+			bool RayTraceEnabled = false;
+		};
+
+		// An entry of the "Cells" array in a world partition's Cells.json.
+		struct WorldCell
+		{
+			int X = 0;
+			int Z = 0;
+			int NumActors = 0;
+			// Content directory relative paths of the models the cell's actors use.
+			std::vector<std::string> Meshes;
+		};
+
+		// The members every actor in Actors.json has.
+		struct ActorHeader
+		{
+			// Position of the actor in the "Set" array.
+			uint32_t Index = 0u;
+			std::string Type;
+			std::string DisplayName;
+			// Saved GUID of the actor, 0 if it was saved before actors had one. See ActorRegistry.
+			uint64_t Guid = 0u;
+		};
+
+		// Called for every actor in file order with the actor's json object. The object is only valid during the call.
+		// Return false to stop reading.
+		typedef std::function<bool(const ActorHeader& Header, const rapidjson::Value& JsonActor)> ActorVisitor;
+
+		struct ActorReadStats
+		{
+			uint32_t NumActors = 0u;
+			// Most memory held by the per actor Document, including its parse stack.
+			size_t PeakActorBytes = 0u;
+		};
+
+		/*
+			Each reader returns false if the file could not be opened, is not valid json or its root is not an object.
+			Fields missing from the file leave the matching output field untouched.
+		*/
+		INSIGHT_API bool ReadSceneMeta(const char* Path, SceneMeta& OutMeta);
+		INSIGHT_API bool ReadTextureResources(const char* Path, std::vector<TextureResource>& OutTextures);
+		INSIGHT_API bool ReadGraphicsSettings(const char* Path, GraphicsSettings& OutSettings);
+		INSIGHT_API bool ReadWorldCells(const char* Path, float& OutCellSize, std::vector<WorldCell>& OutCells);
+		/*
+			Visit every actor in an Actors.json file.
+			@param Visitor - Called once per actor. Reading stops and false is returned if it returns false.
+			@param pOutStats - Optional, filled in with the number of actors read and the memory used.
+		*/
+		INSIGHT_API bool ReadActors(const char* Path, const ActorVisitor& Visitor, ActorReadStats* pOutStats = nullptr);
+		/*
+			Find the model every static mesh component in an Actors.json file uses, without building any json objects.
+			@param OnMesh - Called with each content directory relative model path, in file order. Paths may repeat.
+		*/
+		INSIGHT_API bool ReadMeshReferences(const char* Path, const std::function<void(const std::string& MeshPath)>& OnMesh);
+
+	} // end namespace JsonStream
+}
@@ -0,0 +1,193 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Asset_Hot_Reload.h"
+
+#include "Insight/Systems/Managers/Resource_Manager.h"
+#include "Insight/Systems/Managers/Geometry_Manager.h"
+#include "Insight/Rendering/Geometry/Model.h"
+#include "Insight/Rendering/Material.h"
+#include "Insight/Rendering/Renderer.h"
+#include "Insight/Events/Application_Event.h"
+#include "Insight/Utilities/String_Helper.h"
+
+namespace Insight {
+
+	typedef std::shared_ptr<const ImportedModel> ImportedModelPtr;
+
+#if defined (IE_PLATFORM_BUILD_WIN32)
+	static ImportedModelPtr ImportModel(const std::string ImportPath)
+	{
+		std::shared_ptr<ImportedModel> pImported = std::make_shared<ImportedModel>();
+		if (!MeshImporter::ImportFromFile(ImportPath, *pImported))
+			return nullptr;
+		return pImported;
+	}
+#endif
+
+	template <typename ResultType>
+	static bool IsReady(const std::future<ResultType>& Future)
+	{
+		return Future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+	}
+
+	AssetHotReload::~AssetHotReload()
+	{
+		Stop();
+	}
+
+	bool AssetHotReload::Start(const std::string& ContentDirectory)
+	{
+		if (!m_Watcher.Start(ContentDirectory))
+			return false;
+
+		IE_DEBUG_LOG(LogSeverity::Log, "Hot reloading assets changed in \"{0}\".", ContentDirectory);
+		return true;
+	}
+
+	void AssetHotReload::Stop()
+	{
+		m_Watcher.Stop();
+		Cancel();
+	}
+
+	void AssetHotReload::Cancel()
+	{
+		for (std::future<StrongTexturePtr>& Reload : m_TextureReloads)
+			Reload.wait();
+		for (ModelReload& Reload : m_ModelReloads)
+			Reload.Imported.wait();
+		m_TextureReloads.clear();
+		m_ModelReloads.clear();
+
+		std::lock_guard<std::mutex> Lock(m_ReadyMutex);
+		m_ReadyTextures.clear();
+		m_ReadyModels.clear();
+	}
+
+	void AssetHotReload::Update()
+	{
+		if (!m_Watcher.IsWatching())
+			return;
+
+		m_ChangedFiles.clear();
+		m_Watcher.PollChanges(m_ChangedFiles, SettleMs);
+		for (const std::string& ChangedFile : m_ChangedFiles)
+		{
+			if (!ReloadAssetsLoadedFrom(ChangedFile))
+				IE_DEBUG_LOG(LogSeverity::Verbose, "\"{0}\" changed but nothing in the scene was loaded from it.", ChangedFile);
+		}
+
+		if (m_TextureReloads.empty() && m_ModelReloads.empty())
+			return;
+
+		// Hand reloads over as one batch so assets saved together are swapped in on the same frame.
+		for (const std::future<StrongTexturePtr>& Reload : m_TextureReloads)
+			if (!IsReady(Reload)) return;
+		for (const ModelReload& Reload : m_ModelReloads)
+			if (!IsReady(Reload.Imported)) return;
+
+		{
+			std::lock_guard<std::mutex> Lock(m_ReadyMutex);
+			for (std::future<StrongTexturePtr>& Reload : m_TextureReloads)
+			{
+				if (StrongTexturePtr pTexture = Reload.get())
+					m_ReadyTextures.push_back(std::move(pTexture));
+			}
+			for (ModelReload& Reload : m_ModelReloads)
+			{
+				if (ImportedModelPtr pImported = Reload.Imported.get())
+					m_ReadyModels.push_back({ std::move(Reload.NormalizedPath), std::move(pImported) });
+				else
+					IE_DEBUG_LOG(LogSeverity::Error, "Failed to reimport model \"{0}\", the loaded model is kept.", Reload.NormalizedPath);
+			}
+		}
+		m_TextureReloads.clear();
+		m_ModelReloads.clear();
+
+		Renderer::PushEvent<AssetReloadEvent>(AssetReloadEvent{});
+	}
+
+	bool AssetHotReload::ReloadAssetsLoadedFrom(const std::string& NormalizedPath)
+	{
+		std::vector<IE_TEXTURE_INFO> Textures;
+		ResourceManager::Get().GetTextureManager().FindTexturesLoadedFrom(StringId::Intern(NormalizedPath), Textures);
+		for (const IE_TEXTURE_INFO& TexInfo : Textures)
+			m_TextureReloads.push_back(std::async(std::launch::async, &TextureManager::CreateTexture, TexInfo));
+
+		bool IsModelFile = false;
+#if defined (IE_PLATFORM_BUILD_WIN32)
+		GeometryManager::SceneModels* ModelLists[2] = { GeometryManager::Get().GetSceneModels(), GeometryManager::Get().GetTranslucentSceneModels() };
+		for (GeometryManager::SceneModels* pModels : ModelLists)
+		{
+			for (const StrongModelPtr& pModel : *pModels)
+			{
+				if (IsModelFile || StringHelper::NormalizePath(pModel->GetDirectory()) != NormalizedPath)
+					continue;
+
+				// Every model imported from the file shares the one import.
+				m_ModelReloads.push_back({ NormalizedPath, std::async(std::launch::async, &ImportModel, pModel->GetDirectory()) });
+				IsModelFile = true;
+			}
+		}
+#endif
+		if (!Textures.empty() || IsModelFile)
+			IE_DEBUG_LOG(LogSeverity::Log, "Reloading \"{0}\". {1} textures, {2} model.", NormalizedPath, Textures.size(), IsModelFile ? 1 : 0);
+		return !Textures.empty() || IsModelFile;
+	}
+
+	void AssetHotReload::SwapReloadedAssets()
+	{
+		std::vector<StrongTexturePtr> ReloadedTextures;
+		std::vector<std::pair<std::string, ImportedModelPtr>> ReloadedModels;
+		{
+			std::lock_guard<std::mutex> Lock(m_ReadyMutex);
+			ReloadedTextures.swap(m_ReadyTextures);
+			ReloadedModels.swap(m_ReadyModels);
+		}
+		if (ReloadedTextures.empty() && ReloadedModels.empty())
+			return;
+
+		// The frames in flight may still read the buffers and textures being replaced.
+		Renderer::WaitForGPU();
+
+		// Walk the scene's models once: model -> material -> texture ids, and model -> file.
+		uint32_t NumMaterialTextures = 0u;
+		uint32_t NumModels = 0u;
+		GeometryManager::SceneModels* ModelLists[2] = { GeometryManager::Get().GetSceneModels(), GeometryManager::Get().GetTranslucentSceneModels() };
+		for (GeometryManager::SceneModels* pModels : ModelLists)
+		{
+			for (const StrongModelPtr& pModel : *pModels)
+			{
+				for (const StrongTexturePtr& pTexture : ReloadedTextures)
+				{
+					if (pModel->GetMaterialRef().ReplaceTexture(pTexture))
+						NumMaterialTextures++;
+				}
+
+#if defined (IE_PLATFORM_BUILD_WIN32)
+				if (ReloadedModels.empty())
+					continue;
+
+				const std::string ModelPath = StringHelper::NormalizePath(pModel->GetDirectory());
+				for (const std::pair<std::string, ImportedModelPtr>& Reloaded : ReloadedModels)
+				{
+					if (Reloaded.first != ModelPath)
+						continue;
+
+					pModel->Reload(*Reloaded.second);
+					NumModels++;
+				}
+#endif
+			}
+		}
+
+		// Materials created after this point look the new textures up by id.
+		TextureManager& TexManager = ResourceManager::Get().GetTextureManager();
+		for (const StrongTexturePtr& pTexture : ReloadedTextures)
+			TexManager.ReplaceTexture(pTexture);
+
+		IE_DEBUG_LOG(LogSeverity::Log, "Hot reload swapped in {0} textures used by {1} material slots and {2} models.", ReloadedTextures.size(), NumMaterialTextures, NumModels);
+	}
+
+}
@@ -0,0 +1,84 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Asset_Hot_Reload.h
+	Source - Asset_Hot_Reload.cpp
+
+	Purpose:
+	Reloads the textures and models of the open scene when their files change on disk.
+
+	Description:
+	A FileWatcher watches the Content directory. Each frame the game thread maps the files that
+	changed to the assets loaded from them:
+	Texture file	- Every texture id the TextureManager loaded from the file, and through the
+					  texture ids, every material of a scene model that uses one of them.
+	Model file		- Every model registered with the GeometryManager that was imported from the file.
+	Files nothing in the scene was loaded from are ignored. Only the affected assets are imported
+	again, each on its own worker thread. Once every reload that is in flight has finished, the
+	results are handed to the render thread with an AssetReloadEvent and swapped in together at the
+	start of its next frame, before anything is drawn with them. The swap first waits for the GPU
+	to finish the frames in flight, which may still read the replaced buffers and textures. The
+	rest of the scene is untouched.
+
+	Example Usage:
+	// Game thread, once per frame.
+	ResourceManager::Get().GetAssetHotReload().Update();
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+#include "Insight/Rendering/Texture.h"
+#include "Insight/Systems/File_Watcher.h"
+#include "Insight/Rendering/Geometry/Mesh_Importer.h"
+
+namespace Insight {
+
+	class INSIGHT_API AssetHotReload
+	{
+	public:
+		// How long a file must go unchanged before it is reloaded. Exporters often write a file more than once.
+		static constexpr uint32_t SettleMs = 250u;
+
+	public:
+		AssetHotReload() = default;
+		~AssetHotReload();
+
+		// Start watching a directory for changed asset files.
+		bool Start(const std::string& ContentDirectory);
+		// Stop watching and drop every reload that has not been swapped in.
+		void Stop();
+		// Wait for the reloads in flight and drop them, Ex. before the scene's resources are flushed.
+		void Cancel();
+
+		// Start reloading the assets of changed files and hand finished reloads to the renderer. Call once per frame from the game thread.
+		void Update();
+		// Swap the finished reloads into the scene. Called on the render thread at the start of a frame, see Renderer::OnAssetReload.
+		void SwapReloadedAssets();
+
+		inline bool IsWatching() const { return m_Watcher.IsWatching(); }
+
+	private:
+		// Start the reloads for a file that changed. Returns false if no asset was loaded from it.
+		bool ReloadAssetsLoadedFrom(const std::string& NormalizedPath);
+
+	private:
+		struct ModelReload
+		{
+			std::string NormalizedPath;
+			std::future<std::shared_ptr<const ImportedModel>> Imported;
+		};
+
+		FileWatcher m_Watcher;
+
+		// Game thread only.
+		std::vector<std::future<StrongTexturePtr>> m_TextureReloads;
+		std::vector<ModelReload> m_ModelReloads;
+		std::vector<std::string> m_ChangedFiles;
+
+		// Finished reloads waiting for the render thread, swapped in together.
+		std::mutex m_ReadyMutex;
+		std::vector<StrongTexturePtr> m_ReadyTextures;
+		std::vector<std::pair<std::string, std::shared_ptr<const ImportedModel>>> m_ReadyModels;
+	};
+
+}
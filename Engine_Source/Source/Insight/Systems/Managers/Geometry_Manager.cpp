@@ -52,24 +52,27 @@ namespace Insight {
 	void GeometryManager::FlushModelCache()
 	{
 		s_Instance->m_OpaqueModels.clear();
+		s_Instance->m_IsLayoutDirty = true;
 	}
 
 	void GeometryManager::UnRegisterOpaqueModel(StrongModelPtr Model)
 	{
 		auto iter = std::find(s_Instance->m_OpaqueModels.begin(), s_Instance->m_OpaqueModels.end(), Model);
 
-		if (iter != s_Instance->m_OpaqueModels.end()) 
+		if (iter != s_Instance->m_OpaqueModels.end()) {
 			s_Instance->m_OpaqueModels.erase(iter);
-		
+			s_Instance->m_IsLayoutDirty = true;
+		}
 	}
 
 	void GeometryManager::UnRegisterTranslucentModel(StrongModelPtr Model)
 	{
 		auto iter = std::find(s_Instance->m_TranslucentModels.begin(), s_Instance->m_TranslucentModels.end(), Model);
 
-		if (iter != s_Instance->m_TranslucentModels.end()) 
+		if (iter != s_Instance->m_TranslucentModels.end()) {
 			s_Instance->m_TranslucentModels.erase(iter);
-		
+			s_Instance->m_IsLayoutDirty = true;
+		}
 	}
 
 }
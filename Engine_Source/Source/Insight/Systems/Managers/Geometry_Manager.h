@@ -4,6 +4,8 @@
 
 #include "Insight/Rendering/Geometry/Model.h"
 
+#include <atomic>
+
 namespace Insight {
 
 	using namespace Microsoft::WRL;
@@ -25,25 +27,29 @@ namespace Insight {
 
 		static GeometryManager& Get() { return *s_Instance; }
 		SceneModels* GetSceneModels() { return &m_OpaqueModels; }
+		SceneModels* GetTranslucentSceneModels() { return &m_TranslucentModels; }
 
 		static bool Init() { return s_Instance->Init_Impl(); }
 
 		// Issue draw commands to all models attached to the geometry manager.
 		static void Render(RenderPassType RenderPass) { s_Instance->Render_Impl(RenderPass); }
 		// Gather all geometry in the scene and uplaod their constant buffers to the GPU.
-		// Should only be called once, before 'Render()'. Does not draw models.
+		// Should only be called once, before 'Render()'. Does not draw models. Only the meshes
+		// the TransformJournal says moved are re-uploaded, unless the set of meshes changed.
 		static void GatherGeometry() { s_Instance->GatherGeometry_Impl(); }
 		// UnRegister all model in the model cache. Usually used 
 		// when switching scenes.
 		static void FlushModelCache();
+		// Re-upload every mesh on the next GatherGeometry, Ex. when the meshes of a registered model were replaced.
+		static void MarkLayoutDirty() { s_Instance->m_IsLayoutDirty = true; }
 		
 		// Register a model with an opaque material to be drawn in the geometry pass
-		static void RegisterOpaqueModel(StrongModelPtr Model) { s_Instance->m_OpaqueModels.push_back(Model); }
+		static void RegisterOpaqueModel(StrongModelPtr Model) { s_Instance->m_OpaqueModels.push_back(Model); s_Instance->m_IsLayoutDirty = true; }
 		// Unregister a model with an opaque material to not be drawn in the geometry pass
 		static void UnRegisterOpaqueModel(StrongModelPtr Model);
 		
 		// Register a model with a translucent material to be drawn in the translucency pass
-		static void RegisterTranslucentModel(StrongModelPtr Model) { s_Instance->m_TranslucentModels.push_back(Model); }
+		static void RegisterTranslucentModel(StrongModelPtr Model) { s_Instance->m_TranslucentModels.push_back(Model); s_Instance->m_IsLayoutDirty = true; }
 		// Unregister a model with a translucent material to not be drawn in the translucency pass
 		static void UnRegisterTranslucentModel(StrongModelPtr Model);
 
@@ -61,6 +67,8 @@ namespace Insight {
 	protected:
 		SceneModels m_OpaqueModels;
 		SceneModels m_TranslucentModels;
+		// True when models were added or removed since the last GatherGeometry, so constant buffer slots moved.
+		std::atomic<bool> m_IsLayoutDirty{ true };
 
 	private:
 		static GeometryManager* s_Instance;
@@ -3,6 +3,7 @@
 #include "Physics_Manager.h"
 
 #include "Insight/Physics/Physics_Common.h"
+#include "Insight/Memory/Memory_Tracker.h"
 
 
 namespace Insight {
@@ -27,7 +28,7 @@ namespace Insight {
 
 	void PhysicsManager::Simulate(const float DeltaMs)
 	{
-		
+		IE_MEMORY_TAG(Physics);
 	}
 
 	void PhysicsManager::UnRegisterPhysicsObject(IPhysicsObject* pPhysicsObject)
@@ -2,6 +2,7 @@
 
 #include "Resource_Manager.h"
 #include "Platform/Win32/Error/COM_Exception.h"
+#include "Insight/Utilities/String_Helper.h"
 
 namespace Insight {
 
@@ -19,6 +20,7 @@ namespace Insight {
 
 	ResourceManager::~ResourceManager()
 	{
+		m_AssetHotReload.Stop();
 		GeometryManager::Shutdown();
 		delete m_pTextureManager;
 		//delete m_pMonoScriptManager;
@@ -39,6 +41,11 @@ namespace Insight {
 		m_pTextureManager->PostInit();
 		//m_pMonoScriptManager->PostInit();
 
+		// Reload assets edited while the editor is open.
+		IE_STRIP_FOR_GAME_DIST(
+			m_AssetHotReload.Start(StringHelper::WideToString(FileSystem::GetRelativeContentDirectoryW(L"")));
+		)
+
 		return true;
 	}
 
@@ -50,11 +57,18 @@ namespace Insight {
 		return true;
 	}
 
+	bool ResourceManager::LoadTextureResources(const std::vector<JsonStream::TextureResource>& Textures)
+	{
+		return m_pTextureManager->LoadResources(Textures);
+	}
+
 	// Clears all resource caches for the currenly active scene.
 	// If used, make sure you are loading a new scene or immediatly 
 	// adding new resources AFTER this call
 	void ResourceManager::FlushAllResources()
 	{
+		// Reloads in flight belong to the resources being flushed.
+		m_AssetHotReload.Cancel();
 		GeometryManager::FlushModelCache();
 		m_pTextureManager->FlushTextureCache();
 		//m_pMonoScriptManager->Cleanup();
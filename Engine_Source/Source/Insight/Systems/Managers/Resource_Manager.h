@@ -4,6 +4,7 @@
 #include "Insight/Systems/Managers/Geometry_Manager.h"
 #include "Insight/Systems/Managers/Texture_Manager.h"
 #include "Insight/Systems/Managers/Mono_Script_Manager.h"
+#include "Insight/Systems/Managers/Asset_Hot_Reload.h"
 
 namespace Insight {
 
@@ -16,17 +17,21 @@ namespace Insight {
 		bool Init();
 		bool PostAppInit();
 		virtual bool LoadResourcesFromJson(const rapidjson::Value& jsonResources);
+		// Load a scene's textures read with JsonStream::ReadTextureResources.
+		bool LoadTextureResources(const std::vector<JsonStream::TextureResource>& Textures);
 
 		inline static ResourceManager& Get() { return *s_Instance; }
 		void FlushAllResources();
 
 		TextureManager& GetTextureManager() { return *m_pTextureManager; }
+		AssetHotReload& GetAssetHotReload() { return m_AssetHotReload; }
 #if defined (IE_PLATFORM_BUILD_WIN32)
 		MonoScriptManager& GetMonoScriptManager() { return *m_pMonoScriptManager; }
 #endif
 
 	private:
 		TextureManager* m_pTextureManager = nullptr;
+		AssetHotReload m_AssetHotReload;
 #if defined (IE_PLATFORM_BUILD_WIN32)
 		MonoScriptManager* m_pMonoScriptManager = nullptr;
 #endif
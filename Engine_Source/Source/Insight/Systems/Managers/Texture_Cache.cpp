@@ -0,0 +1,72 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Texture_Cache.h"
+
+namespace Insight {
+
+	void TextureCache::Add(StrongTexturePtr pTexture)
+	{
+		const IE_TEXTURE_INFO& TexInfo = pTexture->GetTextureInfo();
+		if (!IsCachedType(TexInfo.Type))
+		{
+			IE_DEBUG_LOG(LogSeverity::Warning, "Failed to identify texture to create with ID of: {0}", TexInfo.Id);
+			return;
+		}
+
+		std::lock_guard<std::mutex> Lock(m_MapMutexes[TexInfo.Type]);
+		m_TextureMaps[TexInfo.Type].insert({ TexInfo.Id, std::move(pTexture) });
+	}
+
+	void TextureCache::Replace(StrongTexturePtr pTexture)
+	{
+		const IE_TEXTURE_INFO& TexInfo = pTexture->GetTextureInfo();
+		if (!IsCachedType(TexInfo.Type))
+		{
+			IE_DEBUG_LOG(LogSeverity::Warning, "Failed to identify texture to replace with ID of: {0}", TexInfo.Id);
+			return;
+		}
+
+		std::lock_guard<std::mutex> Lock(m_MapMutexes[TexInfo.Type]);
+		m_TextureMaps[TexInfo.Type][TexInfo.Id] = std::move(pTexture);
+	}
+
+	void TextureCache::Flush()
+	{
+		for (uint32_t i = 0; i < NumCachedTextureTypes; ++i)
+		{
+			std::lock_guard<std::mutex> Lock(m_MapMutexes[i]);
+			m_TextureMaps[i].clear();
+		}
+	}
+
+	StrongTexturePtr TextureCache::GetTextureByID(Texture::ID TextureID, Texture::eTextureType TextureType)
+	{
+		if (!IsCachedType(TextureType))
+		{
+			IE_DEBUG_LOG(LogSeverity::Warning, "Failed to get texture handle for texture with ID: {0}", TextureID);
+			return nullptr;
+		}
+
+		{
+			std::lock_guard<std::mutex> Lock(m_MapMutexes[TextureType]);
+			auto Iter = m_TextureMaps[TextureType].find(TextureID);
+			if (Iter != m_TextureMaps[TextureType].end()) {
+				return (*Iter).second;
+			}
+		}
+		return m_DefaultTextures[TextureType];
+	}
+
+	void TextureCache::SetDefaultTexture(Texture::eTextureType TextureType, StrongTexturePtr pTexture)
+	{
+		if (IsCachedType(TextureType))
+			m_DefaultTextures[TextureType] = std::move(pTexture);
+	}
+
+	StrongTexturePtr TextureCache::GetDefaultTexture(Texture::eTextureType TextureType)
+	{
+		return IsCachedType(TextureType) ? m_DefaultTextures[TextureType] : nullptr;
+	}
+
+}
@@ -0,0 +1,60 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Texture_Cache.h
+	Source - Texture_Cache.cpp
+
+	Purpose:
+	Id lookup table for the textures owned by the TextureManager.
+
+	Description:
+	Holds one map per per-object texture type plus the default texture for each type that is
+	returned when an id is not (yet) loaded. Knows nothing about the graphics API that created
+	the textures, so texture lookups can be used and measured without a renderer.
+	Textures may be added from the asynchronous texture loading threads.
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+#include "Insight/Rendering/Texture.h"
+
+namespace Insight {
+
+	class INSIGHT_API TextureCache
+	{
+	public:
+		TextureCache() = default;
+		~TextureCache() = default;
+
+		// Add a texture to the cache under its id and type. Thread safe.
+		void Add(StrongTexturePtr pTexture);
+		// Add a texture to the cache, replacing the texture already cached under its id and type. Thread safe.
+		void Replace(StrongTexturePtr pTexture);
+		// Remove every texture from the cache. Default textures are kept.
+		void Flush();
+
+		// Returns the texture with the id and type. Returns the default texture for the type if it does not exist.
+		StrongTexturePtr GetTextureByID(Texture::ID TextureID, Texture::eTextureType TextureType);
+
+		// Set the fallback texture for a type.
+		void SetDefaultTexture(Texture::eTextureType TextureType, StrongTexturePtr pTexture);
+		// Returns the fallback texture for a type. nullptr if the type has no default.
+		StrongTexturePtr GetDefaultTexture(Texture::eTextureType TextureType);
+
+	private:
+		// Albedo through Translucency are stored in the cache, see Texture::eTextureType.
+		static constexpr uint32_t NumCachedTextureTypes = Texture::eTextureType_Translucency + 1;
+
+		static inline bool IsCachedType(Texture::eTextureType TextureType)
+		{
+			return TextureType >= Texture::eTextureType_Albedo && TextureType < static_cast<int>(NumCachedTextureTypes);
+		}
+
+	private:
+		std::map<Texture::ID, StrongTexturePtr> m_TextureMaps[NumCachedTextureTypes];
+		StrongTexturePtr m_DefaultTextures[NumCachedTextureTypes];
+		// Guards each map against the texture loading threads.
+		std::mutex m_MapMutexes[NumCachedTextureTypes];
+	};
+
+}
@@ -3,6 +3,9 @@
 #include "Texture_Manager.h"
 #include "Insight/Utilities/String_Helper.h"
 #include "Insight/Rendering/Renderer.h"
+#include "Insight/Memory/Memory_Tracker.h"
+#include "Insight/Systems/Json_Stream_Reader.h"
+#include "Insight/Systems/Virtual_File_System.h"
 
 #include "Platform/DirectX_12/Direct3D12_Context.h"
 #include "Platform/DirectX_12/Wrappers/D3D12_Texture.h"
@@ -24,19 +27,18 @@ namespace Insight {
 
 	void TextureManager::Destroy()
 	{
+		// Textures still loading register themselves with the manager when they finish.
+		for (std::future<void>& Future : m_TextureLoadFutures)
+			Future.wait();
+		m_TextureLoadFutures.clear();
 	}
 
 	void TextureManager::FlushTextureCache()
 	{
-		m_AlbedoTextureMap.clear();
-		m_NormalTextureMap.clear();
-		m_MetallicTextureMap.clear();
-		m_RoughnessTextureMap.clear();
-		m_AOTextureMap.clear();
-		m_OpacityTextureMap.clear();
-		m_TranslucencyTextureMap.clear();
-
+		m_Cache.Flush();
 
+		std::lock_guard<std::mutex> Lock(m_TextureFilesMutex);
+		m_TextureFiles.clear();
 	}
 
 	bool TextureManager::Init()
@@ -64,107 +66,77 @@ namespace Insight {
 			json::get_string(JsonTextures[i], "Filepath", Filepath);
 			json::get_bool(JsonTextures[i], "GenerateMipMaps", GenMipMaps);
 
-			Texture::IE_TEXTURE_INFO TexInfo = {};
-			TexInfo.Id = ID;
-			TexInfo.Filepath = FileSystem::GetRelativeContentDirectoryW(StringHelper::StringToWide(Filepath));
-			TexInfo.GenerateMipMaps = GenMipMaps;
-			TexInfo.Type = (Texture::eTextureType)Type;
+			LoadTexture(ID, Type, Filepath, GenMipMaps);
+		}
 
-			m_TextureLoadFutures.push_back(std::async(std::launch::async, &TextureManager::RegisterTextureByType, this, TexInfo));
-			//RegisterTextureByType(TexInfo);
+		return true;
+	}
 
-			m_HighestTextureId = ((int)m_HighestTextureId < ID) ? ID : m_HighestTextureId;
-		}
+	bool TextureManager::LoadResources(const std::vector<JsonStream::TextureResource>& Textures)
+	{
+		for (const JsonStream::TextureResource& Resource : Textures)
+			LoadTexture(Resource.ID, Resource.Type, Resource.Filepath, Resource.GenerateMipMaps);
 
 		return true;
 	}
 
-	StrongTexturePtr TextureManager::GetTextureByID(Texture::ID TextureID, Texture::eTextureType TextureType)
+	void TextureManager::LoadTexture(int ID, int Type, const std::string& Filepath, bool GenMipMaps)
 	{
-		switch (TextureType) 
-		{
-		case Texture::eTextureType::eTextureType_Albedo:
-		{
-			auto Iter = m_AlbedoTextureMap.find(TextureID);
-			if (Iter != m_AlbedoTextureMap.end()) {
-				return (*Iter).second;
-			}
-			else {
-				return m_DefaultAlbedoTexture;
-			}
-		}
-		case Texture::eTextureType::eTextureType_Normal:
-		{
-			auto Iter = m_NormalTextureMap.find(TextureID);
-			if (Iter != m_NormalTextureMap.end()) {
-				return (*Iter).second;
-			}
-			else {
-				return m_DefaultNormalTexture;
-			}
-		}
-		case Texture::eTextureType::eTextureType_Roughness:
-		{
-			auto Iter = m_RoughnessTextureMap.find(TextureID);
-			if (Iter != m_RoughnessTextureMap.end()) {
-				return (*Iter).second;
-			}
-			else {
-				return m_DefaultRoughnessTexture;
-			}
-		}
-		case Texture::eTextureType::eTextureType_Metallic:
-		{
-			auto Iter = m_MetallicTextureMap.find(TextureID);
-			if (Iter != m_MetallicTextureMap.end()) {
-				return (*Iter).second;
-			}
-			else {
-				return m_DefaultMetallicTexture;
-			}
-		}
-		case Texture::eTextureType::eTextureType_AmbientOcclusion:
-		{
-			auto Iter = m_AOTextureMap.find(TextureID);
-			if (Iter != m_AOTextureMap.end()) {
-				return (*Iter).second;
-			}
-			else {
-				return m_DefaultAOTexture;
-			}
-		}
-		case Texture::eTextureType::eTextureType_Opacity:
-		{
-			auto Iter = m_OpacityTextureMap.find(TextureID);
-			if (Iter != m_OpacityTextureMap.end()) {
-				return (*Iter).second;
-			}
-			else {
-				return m_DefaultAOTexture;
-			}
-		}
-		case Texture::eTextureType::eTextureType_Translucency:
-		{
-			auto Iter = m_TranslucencyTextureMap.find(TextureID);
-			if (Iter != m_TranslucencyTextureMap.end()) {
-				return (*Iter).second;
-			}
-			else {
-				return m_DefaultAOTexture;
-			}
-		}
-		default:
+		Texture::IE_TEXTURE_INFO TexInfo = {};
+		TexInfo.Id = ID;
+		TexInfo.Filepath = FileSystem::GetRelativeContentDirectoryW(StringHelper::StringToWide(Filepath));
+		TexInfo.GenerateMipMaps = GenMipMaps;
+		TexInfo.Type = (Texture::eTextureType)Type;
+		// Converted back once, the renderers keep the wide path and the reads below use this one.
+		const std::string ContentPath = StringHelper::WideToString(TexInfo.Filepath);
+
 		{
-			IE_DEBUG_LOG(LogSeverity::Warning, "Failed to get texture handle for texture with ID: {0}", TextureID);
-			break;
-		}
+			std::lock_guard<std::mutex> Lock(m_TextureFilesMutex);
+			m_TextureFiles.insert({ StringId::Intern(StringHelper::NormalizePath(ContentPath)), TexInfo });
 		}
 
-		return nullptr;
+		// Read the file with the async I/O service and create the texture on the I/O worker the read finishes on,
+		// so the next textures are being read while this one is decoded.
+		std::shared_ptr<std::promise<void>> pLoaded = std::make_shared<std::promise<void>>();
+		m_TextureLoadFutures.push_back(pLoaded->get_future());
+		VirtualFileSystem::Get().ReadAsync(ContentPath, AsyncIO::Priority::Normal, [this, TexInfo, pLoaded](FileView TextureFile)
+			{
+				try
+				{
+					IE_TEXTURE_INFO LoadedInfo = TexInfo;
+					LoadedInfo.SourceFile = std::move(TextureFile);
+					RegisterTextureByType(LoadedInfo);
+					pLoaded->set_value();
+				}
+				catch (...)
+				{
+					pLoaded->set_exception(std::current_exception());
+				}
+			});
+
+		m_HighestTextureId = ((int)m_HighestTextureId < ID) ? ID : m_HighestTextureId;
+	}
+
+	void TextureManager::FindTexturesLoadedFrom(StringId NormalizedPath, std::vector<IE_TEXTURE_INFO>& OutTextures)
+	{
+		std::lock_guard<std::mutex> Lock(m_TextureFilesMutex);
+		auto Range = m_TextureFiles.equal_range(NormalizedPath);
+		for (auto Iter = Range.first; Iter != Range.second; ++Iter)
+			OutTextures.push_back(Iter->second);
 	}
 
-	void TextureManager::RegisterTextureLoadCallback(Texture::ID AwaitingTextureId, StrongTexturePtr* AwaitingTexture)
+	void TextureManager::RegisterTextureLoadCallback(Texture::ID AwaitingTextureId, Texture::eTextureType TextureType, StrongTexturePtr* AwaitingTexture)
 	{
+		std::lock_guard<std::mutex> Lock(m_AwaitingLoadMutex);
+
+		// The texture may have finished loading since the caller looked it up.
+		StrongTexturePtr Loaded = m_Cache.GetTextureByID(AwaitingTextureId, TextureType);
+		if (Loaded && !Loaded->IsDefaultTexture())
+		{
+			*AwaitingTexture = Loaded;
+			return;
+		}
+
 		auto Iter = m_AwaitingLoadTextures.find(AwaitingTextureId);
 		if (Iter != m_AwaitingLoadTextures.end())
 		{
@@ -214,16 +186,21 @@ namespace Insight {
 		AOTexInfo.Type = Texture::eTextureType::eTextureType_AmbientOcclusion;
 		AOTexInfo.Filepath = DefaultAssetDirectory + L"Default_RoughAO.png";
 
+		StrongTexturePtr DefaultAlbedoTexture;
+		StrongTexturePtr DefaultNormalTexture;
+		StrongTexturePtr DefaultMetallicTexture;
+		StrongTexturePtr DefaultRoughnessTexture;
+		StrongTexturePtr DefaultAOTexture;
 		switch (Renderer::GetAPI())
 		{
 #if defined (IE_PLATFORM_WINDOWS)
 		case Renderer::TargetRenderAPI::Direct3D_11:
 		{
-			m_DefaultAlbedoTexture = make_shared<ieD3D11Texture>(AlbedoTexInfo);
-			m_DefaultNormalTexture = make_shared<ieD3D11Texture>(NormalTexInfo);
-			m_DefaultMetallicTexture = make_shared<ieD3D11Texture>(MetallicTexInfo);
-			m_DefaultRoughnessTexture = make_shared<ieD3D11Texture>(RoughnessTexInfo);
-			m_DefaultAOTexture = make_shared<ieD3D11Texture>(AOTexInfo);
+			DefaultAlbedoTexture = make_shared<ieD3D11Texture>(AlbedoTexInfo);
+			DefaultNormalTexture = make_shared<ieD3D11Texture>(NormalTexInfo);
+			DefaultMetallicTexture = make_shared<ieD3D11Texture>(MetallicTexInfo);
+			DefaultRoughnessTexture = make_shared<ieD3D11Texture>(RoughnessTexInfo);
+			DefaultAOTexture = make_shared<ieD3D11Texture>(AOTexInfo);
 			break;
 		}
 		case Renderer::TargetRenderAPI::Direct3D_12:
@@ -231,11 +208,11 @@ namespace Insight {
 			Direct3D12Context& RenderContext = Renderer::GetAs<Direct3D12Context>();
 			CDescriptorHeapWrapper& cbvSrvHeapStart = RenderContext.GetCBVSRVDescriptorHeap();
 
-			m_DefaultAlbedoTexture = make_shared<ieD3D12Texture>(AlbedoTexInfo, cbvSrvHeapStart);
-			m_DefaultNormalTexture = make_shared<ieD3D12Texture>(NormalTexInfo, cbvSrvHeapStart);
-			m_DefaultMetallicTexture = make_shared<ieD3D12Texture>(MetallicTexInfo, cbvSrvHeapStart);
-			m_DefaultRoughnessTexture = make_shared<ieD3D12Texture>(RoughnessTexInfo, cbvSrvHeapStart);
-			m_DefaultAOTexture = make_shared<ieD3D12Texture>(AOTexInfo, cbvSrvHeapStart);
+			DefaultAlbedoTexture = make_shared<ieD3D12Texture>(AlbedoTexInfo, cbvSrvHeapStart);
+			DefaultNormalTexture = make_shared<ieD3D12Texture>(NormalTexInfo, cbvSrvHeapStart);
+			DefaultMetallicTexture = make_shared<ieD3D12Texture>(MetallicTexInfo, cbvSrvHeapStart);
+			DefaultRoughnessTexture = make_shared<ieD3D12Texture>(RoughnessTexInfo, cbvSrvHeapStart);
+			DefaultAOTexture = make_shared<ieD3D12Texture>(AOTexInfo, cbvSrvHeapStart);
 			break;
 		}
 #endif // IE_PLATFORM_WINDOWS
@@ -245,71 +222,28 @@ namespace Insight {
 			break;
 		}
 		}
+
+		m_Cache.SetDefaultTexture(Texture::eTextureType_Albedo, DefaultAlbedoTexture);
+		m_Cache.SetDefaultTexture(Texture::eTextureType_Normal, DefaultNormalTexture);
+		m_Cache.SetDefaultTexture(Texture::eTextureType_Metallic, DefaultMetallicTexture);
+		m_Cache.SetDefaultTexture(Texture::eTextureType_Roughness, DefaultRoughnessTexture);
+		m_Cache.SetDefaultTexture(Texture::eTextureType_AmbientOcclusion, DefaultAOTexture);
+		// Opacity and translucency have no textures of their own and fall back to the AO texture.
+		m_Cache.SetDefaultTexture(Texture::eTextureType_Opacity, DefaultAOTexture);
+		m_Cache.SetDefaultTexture(Texture::eTextureType_Translucency, DefaultAOTexture);
 		return true;
 	}
 
-	static std::mutex s_AlbedoMutex;
-	static std::mutex s_NormalMutex;
-	static std::mutex s_MetallicMutex;
-	static std::mutex s_RoughnessMutex;
-	static std::mutex s_AOMutex;
-	static std::mutex s_OpacityMutex;
-	static std::mutex s_TranslucencyMutex;
-	void TextureManager::RegisterTextureByType(const IE_TEXTURE_INFO TexInfo)
+	StrongTexturePtr TextureManager::CreateTexture(const IE_TEXTURE_INFO& TexInfo)
 	{
+		IE_MEMORY_TAG(Assets);
+		StrongTexturePtr pTexture;
 		switch (Renderer::GetAPI())
 		{
+#if defined (IE_PLATFORM_WINDOWS)
 			case Renderer::TargetRenderAPI::Direct3D_11:
 			{
-				switch (TexInfo.Type) {
-				case Texture::eTextureType::eTextureType_Albedo:
-				{
-					std::lock_guard<std::mutex> Lock(s_AlbedoMutex);
-					m_AlbedoTextureMap.insert({ TexInfo.Id, std::move(make_shared<ieD3D11Texture>(TexInfo)) });
-					break;
-				}
-				case Texture::eTextureType::eTextureType_Normal:
-				{
-					std::lock_guard<std::mutex> Lock(s_NormalMutex);
-					m_NormalTextureMap.insert({ TexInfo.Id, std::move(make_shared<ieD3D11Texture>(TexInfo)) });
-					break;
-				}
-				case Texture::eTextureType::eTextureType_Roughness:
-				{
-					std::lock_guard<std::mutex> Lock(s_RoughnessMutex);
-					m_RoughnessTextureMap.insert({ TexInfo.Id, std::move(make_shared<ieD3D11Texture>(TexInfo)) });
-					break;
-				}
-				case Texture::eTextureType::eTextureType_Metallic:
-				{
-					std::lock_guard<std::mutex> Lock(s_MetallicMutex);
-					m_MetallicTextureMap.insert({ TexInfo.Id, std::move(make_shared<ieD3D11Texture>(TexInfo)) });
-					break;
-				}
-				case Texture::eTextureType::eTextureType_AmbientOcclusion:
-				{
-					std::lock_guard<std::mutex> Lock(s_AOMutex);
-					m_AOTextureMap.insert({ TexInfo.Id, std::move(make_shared<ieD3D11Texture>(TexInfo)) });
-					break;
-				}
-				case Texture::eTextureType::eTextureType_Opacity:
-				{
-					std::lock_guard<std::mutex> Lock(s_OpacityMutex);
-					m_OpacityTextureMap.insert({ TexInfo.Id, std::move(make_shared<ieD3D11Texture>(TexInfo)) });
-					break;
-				}
-				case Texture::eTextureType::eTextureType_Translucency:
-				{
-					std::lock_guard<std::mutex> Lock(s_TranslucencyMutex);
-					m_TranslucencyTextureMap.insert({ TexInfo.Id, std::move(make_shared<ieD3D11Texture>(TexInfo)) });
-					break;
-				}
-				default:
-				{
-					IE_DEBUG_LOG(LogSeverity::Warning, "Failed to identify texture to create with ID of {0}", TexInfo.Id);
-					break;
-				}
-				}
+				pTexture = make_shared<ieD3D11Texture>(TexInfo);
 				break;
 			}
 			case Renderer::TargetRenderAPI::Direct3D_12:
@@ -317,57 +251,10 @@ namespace Insight {
 				Direct3D12Context& RenderContext = Renderer::GetAs<Direct3D12Context>();
 				CDescriptorHeapWrapper& cbvSrvHeapStart = RenderContext.GetCBVSRVDescriptorHeap();
 
-				switch (TexInfo.Type) {
-				case Texture::eTextureType::eTextureType_Albedo:
-				{
-					std::lock_guard<std::mutex> Lock(s_AlbedoMutex);
-					m_AlbedoTextureMap.insert({ TexInfo.Id, std::move(make_shared<ieD3D12Texture>(TexInfo, cbvSrvHeapStart)) });
-					break;
-				}
-				case Texture::eTextureType::eTextureType_Normal:
-				{
-					std::lock_guard<std::mutex> Lock(s_NormalMutex);
-					m_NormalTextureMap.insert({ TexInfo.Id, std::move(make_shared<ieD3D12Texture>(TexInfo, cbvSrvHeapStart)) });
-					break;
-				}
-				case Texture::eTextureType::eTextureType_Roughness:
-				{
-					std::lock_guard<std::mutex> Lock(s_RoughnessMutex);
-					m_RoughnessTextureMap.insert({ TexInfo.Id, std::move(make_shared<ieD3D12Texture>(TexInfo, cbvSrvHeapStart)) });
-					break;
-				}
-				case Texture::eTextureType::eTextureType_Metallic:
-				{
-					std::lock_guard<std::mutex> Lock(s_MetallicMutex);
-					m_MetallicTextureMap.insert({ TexInfo.Id, std::move(make_shared<ieD3D12Texture>(TexInfo, cbvSrvHeapStart)) });
-					break;
-				}
-				case Texture::eTextureType::eTextureType_AmbientOcclusion:
-				{
-					std::lock_guard<std::mutex> Lock(s_AOMutex);
-					m_AOTextureMap.insert({ TexInfo.Id, std::move(make_shared<ieD3D12Texture>(TexInfo, cbvSrvHeapStart)) });
-					break;
-				}
-				case Texture::eTextureType::eTextureType_Opacity:
-				{
-					std::lock_guard<std::mutex> Lock(s_OpacityMutex);
-					m_OpacityTextureMap.insert({ TexInfo.Id, std::move(make_shared<ieD3D12Texture>(TexInfo, cbvSrvHeapStart)) });
-					break;
-				}
-				case Texture::eTextureType::eTextureType_Translucency:
-				{
-					std::lock_guard<std::mutex> Lock(s_TranslucencyMutex);
-					m_TranslucencyTextureMap.insert({ TexInfo.Id, std::move(make_shared<ieD3D12Texture>(TexInfo, cbvSrvHeapStart)) });
-					break;
-				}
-				default:
-				{
-					IE_DEBUG_LOG(LogSeverity::Warning, "Failed to identify texture to create with ID of: {0}", TexInfo.Id);
-					break;
-				}
-				}
+				pTexture = make_shared<ieD3D12Texture>(TexInfo, cbvSrvHeapStart);
 				break;
 			}
+#endif // IE_PLATFORM_WINDOWS
 			default:
 			{
 				IE_DEBUG_LOG(LogSeverity::Error, "Failed to determine graphics api to initialize texture. The renderer may not have been initialized yet.");
@@ -375,7 +262,20 @@ namespace Insight {
 			}
 
 		} // end switch(Renderer::GetAPI())
-				
+		return pTexture;
+	}
+
+	void TextureManager::RegisterTextureByType(const IE_TEXTURE_INFO TexInfo)
+	{
+		StrongTexturePtr pTexture = CreateTexture(TexInfo);
+		if (!pTexture)
+			return;
+
+		// Add and resolve under the same lock so a material registering a callback
+		// concurrently either sees the texture in the cache or is resolved here.
+		std::lock_guard<std::mutex> Lock(m_AwaitingLoadMutex);
+		m_Cache.Add(pTexture);
+
 		// Check if the loaded texture is currently being waited upon by any materials.
 		auto Iter = m_AwaitingLoadTextures.find(TexInfo.Id);
 		if (Iter != m_AwaitingLoadTextures.end())
@@ -383,7 +283,7 @@ namespace Insight {
 			// Reasign the texture in the material. There could be multiple materials waiting for the texture.
 			for (auto Tex : (*Iter).second)
 			{
-				*Tex = GetTextureByID(TexInfo.Id, TexInfo.Type);;
+				*Tex = pTexture;
 			}
 			// Erase the element from the map.
 			m_AwaitingLoadTextures.erase(Iter);
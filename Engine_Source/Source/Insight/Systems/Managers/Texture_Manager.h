@@ -3,6 +3,8 @@
 #include <Insight/Core.h>
 
 #include "Insight/Rendering/Texture.h"
+#include "Insight/Systems/Managers/Texture_Cache.h"
+#include "Insight/Utilities/String_Id.h"
 
 #define DEFAULT_ALBEDO_TEXTURE_ID -1
 #define DEFAULT_NORMAL_TEXTURE_ID -2
@@ -12,6 +14,10 @@
 
 namespace Insight {
 
+	namespace JsonStream {
+		struct TextureResource;
+	}
+
 	class INSIGHT_API TextureManager
 	{
 	public:
@@ -26,49 +32,56 @@ namespace Insight {
 		void FlushTextureCache();
 		// Load the textures in to the texture cache from a scene's resource file.
 		bool LoadResourcesFromJson(const rapidjson::Value& jsonTextures);
+		// Load the textures in to the texture cache from a resource file read with JsonStream::ReadTextureResources.
+		bool LoadResources(const std::vector<JsonStream::TextureResource>& Textures);
 		// Returns a reference to an existing texture by id that is owned by the manager. 
 		// Returns the default texture for the given texture type if it does not exist.
-		StrongTexturePtr GetTextureByID(Texture::ID TextureID, Texture::eTextureType TextreType);
-		// Queue a texture to wait for its file asset to be loaded. 
-		void RegisterTextureLoadCallback(Texture::ID AwaitingTextureId, StrongTexturePtr* AwaitingTexture);
+		inline StrongTexturePtr GetTextureByID(Texture::ID TextureID, Texture::eTextureType TextureType) { return m_Cache.GetTextureByID(TextureID, TextureType); }
+		// Queue a texture to wait for its file asset to be loaded. Assigned immediately if it finished loading
+		// since it was looked up. Thread safe, textures load while the scene's actors are being created.
+		void RegisterTextureLoadCallback(Texture::ID AwaitingTextureId, Texture::eTextureType TextureType, StrongTexturePtr* AwaitingTexture);
+
+		// Create a texture with the renderer's graphics api. Returns nullptr if it could not be created. Thread safe.
+		static StrongTexturePtr CreateTexture(const IE_TEXTURE_INFO& TexInfo);
+		// Replace a cached texture with one that was reloaded from its file. Materials using the old texture must be updated by the caller.
+		void ReplaceTexture(StrongTexturePtr pTexture) { m_Cache.Replace(std::move(pTexture)); }
+		// Get the textures loaded from a file. Thread safe.
+		// @param NormalizedPath - Id of the full path to the file, normalized with StringHelper::NormalizePath.
+		void FindTexturesLoadedFrom(StringId NormalizedPath, std::vector<IE_TEXTURE_INFO>& OutTextures);
 
 		// Return the default albedo texture.
-		StrongTexturePtr GetDefaultAlbedoTexture() { return m_DefaultAlbedoTexture; }
+		StrongTexturePtr GetDefaultAlbedoTexture() { return m_Cache.GetDefaultTexture(Texture::eTextureType_Albedo); }
 		// Return the default normal texture.
-		StrongTexturePtr GetDefaultNormalTexture() { return m_DefaultNormalTexture; }
+		StrongTexturePtr GetDefaultNormalTexture() { return m_Cache.GetDefaultTexture(Texture::eTextureType_Normal); }
 		// Return the default metallic texture.
-		StrongTexturePtr GetDefaultMetallicTexture() { return m_DefaultMetallicTexture; }
+		StrongTexturePtr GetDefaultMetallicTexture() { return m_Cache.GetDefaultTexture(Texture::eTextureType_Metallic); }
 		// Return the default roughness texture.
-		StrongTexturePtr GetDefaultRoughnessTexture() { return m_DefaultRoughnessTexture; }
+		StrongTexturePtr GetDefaultRoughnessTexture() { return m_Cache.GetDefaultTexture(Texture::eTextureType_Roughness); }
 		// Return the default ambient occlusion texture.
-		StrongTexturePtr GetDefaultAOTexture() { return m_DefaultAOTexture; }
+		StrongTexturePtr GetDefaultAOTexture() { return m_Cache.GetDefaultTexture(Texture::eTextureType_AmbientOcclusion); }
 
 	private:
 		// Load the default textures that will be used as fallbacks for invalid or placeholders textures.
 		bool LoadDefaultTextures();
 		// Create and register a texture inside the texture manager to be reused by other materials.
 		void RegisterTextureByType(const IE_TEXTURE_INFO TexInfo);
+		// Start reading a texture from a resource file entry. The texture is created on an AsyncIO worker once its file has been read.
+		void LoadTexture(int ID, int Type, const std::string& Filepath, bool GenMipMaps);
 
 	private:
 		Texture::ID m_HighestTextureId;
 
-		std::map<Texture::ID, StrongTexturePtr> m_AlbedoTextureMap;
-		std::map<Texture::ID, StrongTexturePtr> m_NormalTextureMap;
-		std::map<Texture::ID, StrongTexturePtr> m_MetallicTextureMap;
-		std::map<Texture::ID, StrongTexturePtr> m_RoughnessTextureMap;
-		std::map<Texture::ID, StrongTexturePtr> m_AOTextureMap;
-		std::map<Texture::ID, StrongTexturePtr> m_OpacityTextureMap;
-		std::map<Texture::ID, StrongTexturePtr> m_TranslucencyTextureMap;
-
-		StrongTexturePtr m_DefaultAlbedoTexture;
-		StrongTexturePtr m_DefaultNormalTexture;
-		StrongTexturePtr m_DefaultMetallicTexture;
-		StrongTexturePtr m_DefaultRoughnessTexture;
-		StrongTexturePtr m_DefaultAOTexture;
+		TextureCache m_Cache;
 		
 		std::vector<std::future<void>> m_TextureLoadFutures;
 
+		// Every texture loaded from a scene's resources, keyed by the id of the normalized path of its file.
+		std::unordered_multimap<StringId, IE_TEXTURE_INFO> m_TextureFiles;
+		std::mutex m_TextureFilesMutex;
+
 		std::map<Texture::ID, std::list<StrongTexturePtr*>> m_AwaitingLoadTextures;
+		// Guards m_AwaitingLoadTextures and orders it with textures being added to the cache.
+		std::mutex m_AwaitingLoadMutex;
 	};
 
 }
@@ -0,0 +1,112 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Mapped_File.h"
+
+#include "Insight/Utilities/String_Helper.h"
+
+namespace Insight {
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	bool MappedFile::Open(const std::string& Path)
+	{
+		Close();
+
+#if defined (IE_PLATFORM_WINDOWS)
+		const std::wstring WidePath = StringHelper::StringToWide(Path);
+	#if defined (IE_PLATFORM_BUILD_WIN32)
+		m_hFile = CreateFileW(WidePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	#elif defined (IE_PLATFORM_BUILD_UWP)
+		m_hFile = CreateFile2(WidePath.c_str(), GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, nullptr);
+	#endif
+		if (m_hFile == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER FileSize;
+		if (!GetFileSizeEx(m_hFile, &FileSize))
+		{
+			Close();
+			return false;
+		}
+		m_Size = static_cast<uint64_t>(FileSize.QuadPart);
+		m_IsOpen = true;
+
+		// Empty files cannot be mapped.
+		if (m_Size == 0u)
+			return true;
+
+	#if defined (IE_PLATFORM_BUILD_WIN32)
+		m_hMapping = CreateFileMappingW(m_hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (m_hMapping)
+			m_pData = static_cast<const uint8_t*>(MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0));
+	#elif defined (IE_PLATFORM_BUILD_UWP)
+		m_hMapping = CreateFileMappingFromApp(m_hFile, nullptr, PAGE_READONLY, 0, nullptr);
+		if (m_hMapping)
+			m_pData = static_cast<const uint8_t*>(MapViewOfFileFromApp(m_hMapping, FILE_MAP_READ, 0, 0));
+	#endif
+		if (!m_pData)
+		{
+			IE_DEBUG_LOG(LogSeverity::Error, "Failed to map file \"{0}\" into memory.", Path);
+			Close();
+			return false;
+		}
+		return true;
+#else
+		std::ifstream File(Path, std::ios::binary | std::ios::ate);
+		if (!File.is_open())
+			return false;
+
+		m_Contents.resize(static_cast<size_t>(File.tellg()));
+		File.seekg(0, std::ios::beg);
+		if (!File.read(reinterpret_cast<char*>(m_Contents.data()), m_Contents.size()))
+		{
+			m_Contents.clear();
+			return false;
+		}
+		m_pData = m_Contents.data();
+		m_Size = m_Contents.size();
+		m_IsOpen = true;
+		return true;
+#endif
+	}
+
+	void MappedFile::Close()
+	{
+#if defined (IE_PLATFORM_WINDOWS)
+		if (m_pData)
+			UnmapViewOfFile(m_pData);
+		if (m_hMapping)
+		{
+			CloseHandle(m_hMapping);
+			m_hMapping = nullptr;
+		}
+		if (m_hFile != INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(m_hFile);
+			m_hFile = INVALID_HANDLE_VALUE;
+		}
+#else
+		m_Contents.clear();
+		m_Contents.shrink_to_fit();
+#endif
+		m_pData = nullptr;
+		m_Size = 0u;
+		m_IsOpen = false;
+	}
+
+	FileView MappedFile::OpenView(const std::string& Path)
+	{
+		std::shared_ptr<MappedFile> pFile = std::make_shared<MappedFile>();
+		if (!pFile->Open(Path))
+			return FileView();
+
+		const uint8_t* pData = pFile->GetData();
+		const size_t Size = static_cast<size_t>(pFile->GetSize());
+		return FileView(std::move(pFile), pData, Size);
+	}
+
+}
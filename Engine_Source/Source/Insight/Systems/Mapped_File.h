@@ -0,0 +1,80 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Mapped_File.h
+	Source - Mapped_File.cpp
+
+	Purpose:
+	Maps a file into memory read only and hands out views of its bytes.
+
+	Description:
+	On Windows the file is mapped with CreateFileMapping and MapViewOfFile (the FromApp variants on UWP)
+	so reading it costs no copy, pages are faulted in by the OS as they are touched and stay in the
+	standby list for the next read of the same file. Other platforms read the file into a buffer.
+	A FileView is a pointer and size into a file's bytes plus the object that owns them. Views of a
+	mapped file keep the mapping open until the last view is released, views of decompressed data
+	own their buffer, so callers never need to know where the bytes came from.
+
+	Example Usage:
+	FileView View = MappedFile::OpenView("../Content/Scenes/Norway.iescene/Actors.json");
+	if (View)
+		Document.Parse(View.GetChars(), View.GetSize());
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+namespace Insight {
+
+	// A read only view of a file's bytes. Copies share the owner of the bytes.
+	struct FileView
+	{
+		FileView() = default;
+		FileView(std::shared_ptr<const void> pOwner, const uint8_t* pData, size_t Size)
+			: m_pOwner(std::move(pOwner)), m_pData(pData), m_Size(Size) {}
+
+		inline const uint8_t* GetData() const { return m_pData; }
+		inline const char* GetChars() const { return reinterpret_cast<const char*>(m_pData); }
+		inline size_t GetSize() const { return m_Size; }
+		// True if the file was read. Empty files are valid views with a size of 0.
+		inline bool IsValid() const { return m_pOwner != nullptr; }
+		inline explicit operator bool() const { return IsValid(); }
+
+	private:
+		std::shared_ptr<const void> m_pOwner;
+		const uint8_t* m_pData = nullptr;
+		size_t m_Size = 0u;
+	};
+
+	class INSIGHT_API MappedFile
+	{
+	public:
+		MappedFile() = default;
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator = (const MappedFile&) = delete;
+
+		// Map a file read only. Returns false if the file could not be opened.
+		bool Open(const std::string& Path);
+		void Close();
+
+		inline bool IsOpen() const { return m_IsOpen; }
+		inline const uint8_t* GetData() const { return m_pData; }
+		inline uint64_t GetSize() const { return m_Size; }
+
+		// Map a file and return a view of all of it. The view is invalid if the file could not be opened.
+		static FileView OpenView(const std::string& Path);
+
+	private:
+		bool m_IsOpen = false;
+		const uint8_t* m_pData = nullptr;
+		uint64_t m_Size = 0u;
+#if defined (IE_PLATFORM_WINDOWS)
+		HANDLE m_hFile = INVALID_HANDLE_VALUE;
+		HANDLE m_hMapping = nullptr;
+#else
+		std::vector<uint8_t> m_Contents;
+#endif
+	};
+
+}
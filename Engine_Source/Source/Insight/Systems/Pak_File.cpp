@@ -0,0 +1,465 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Pak_File.h"
+
+#include "Insight/Utilities/String_Helper.h"
+#include "Insight/Utilities/Lz4.h"
+#include "Insight/Utilities/Xxh64.h"
+
+#include <atomic>
+#include <filesystem>
+
+namespace Insight {
+
+	static inline uint64_t AlignUp(uint64_t Value, uint64_t Alignment)
+	{
+		return (Value + Alignment - 1u) & ~(Alignment - 1u);
+	}
+
+	uint64_t PakFile::HashPath(const std::string& NormalizedPath)
+	{
+		uint64_t Hash = 14695981039346656037ull;
+		for (const char Character : NormalizedPath)
+		{
+			Hash ^= static_cast<uint8_t>(Character);
+			Hash *= 1099511628211ull;
+		}
+		return Hash;
+	}
+
+	bool PakFile::Open(const std::string& Path)
+	{
+		m_Path = Path;
+		m_pHeader = nullptr;
+		if (!m_File.Open(Path))
+			return false;
+
+		const uint8_t* pBase = m_File.GetData();
+		const uint64_t FileSize = m_File.GetSize();
+		if (FileSize < sizeof(Header))
+		{
+			IE_DEBUG_LOG(LogSeverity::Error, "\"{0}\" is too small to be an .iepak archive.", Path);
+			return false;
+		}
+
+		const Header* pHeader = reinterpret_cast<const Header*>(pBase);
+		if (pHeader->Magic != Magic || pHeader->Version != Version)
+		{
+			IE_DEBUG_LOG(LogSeverity::Error, "\"{0}\" is not an .iepak archive or was packed with a different version (found version {1}, expected {2}).", Path, pHeader->Version, Version);
+			return false;
+		}
+
+		// Make sure every table fits in the archive before anything is read from them.
+		const uint64_t TocOffset = pHeader->TocOffset;
+		const uint64_t EntriesSize = static_cast<uint64_t>(pHeader->NumEntries) * sizeof(Entry);
+		const uint64_t ChunksSize = static_cast<uint64_t>(pHeader->NumChunks) * sizeof(uint32_t);
+		if (TocOffset % alignof(Entry) != 0u || TocOffset > FileSize || EntriesSize + ChunksSize > FileSize - TocOffset)
+		{
+			IE_DEBUG_LOG(LogSeverity::Error, "The table of contents of \"{0}\" is corrupt.", Path);
+			return false;
+		}
+		const Entry* pEntries = reinterpret_cast<const Entry*>(pBase + TocOffset);
+		const uint32_t* pChunkSizes = reinterpret_cast<const uint32_t*>(pBase + TocOffset + EntriesSize);
+		const uint64_t PathsOffset = TocOffset + EntriesSize + ChunksSize;
+		const uint64_t PathsSize = FileSize - PathsOffset;
+
+		for (uint32_t i = 0u; i < pHeader->NumEntries; ++i)
+		{
+			const Entry& FileEntry = pEntries[i];
+			const bool IsSorted = i == 0u || pEntries[i - 1u].PathHash <= FileEntry.PathHash;
+			const bool DataInBounds = FileEntry.Offset <= TocOffset && FileEntry.StoredSize <= TocOffset - FileEntry.Offset;
+			const bool ChunksInBounds = FileEntry.FirstChunk <= pHeader->NumChunks && FileEntry.NumChunks <= pHeader->NumChunks - FileEntry.FirstChunk;
+			const bool PathInBounds = FileEntry.PathOffset <= PathsSize && FileEntry.PathLength <= PathsSize - FileEntry.PathOffset;
+			// Read allocates Size bytes for a compressed entry, so it must fit in the entry's chunks before anything trusts it.
+			const bool SizeMatches = FileEntry.NumChunks == 0u
+				? FileEntry.StoredSize == FileEntry.Size
+				: FileEntry.Size <= static_cast<uint64_t>(FileEntry.NumChunks) * pHeader->ChunkSize;
+			if (!IsSorted || !DataInBounds || !ChunksInBounds || !PathInBounds || !SizeMatches)
+			{
+				IE_DEBUG_LOG(LogSeverity::Error, "Entry {0} of the table of contents of \"{1}\" is corrupt.", i, Path);
+				return false;
+			}
+		}
+
+		m_pHeader = pHeader;
+		m_pEntries = pEntries;
+		m_pChunkSizes = pChunkSizes;
+		m_pPaths = reinterpret_cast<const char*>(pBase + PathsOffset);
+		return true;
+	}
+
+	const PakFile::Entry* PakFile::Find(const std::string& RelativePath) const
+	{
+		if (!m_pHeader)
+			return nullptr;
+
+		const uint64_t Hash = HashPath(RelativePath);
+		const Entry* pEnd = m_pEntries + m_pHeader->NumEntries;
+		const Entry* pEntry = std::lower_bound(m_pEntries, pEnd, Hash, [](const Entry& Lhs, uint64_t Rhs) { return Lhs.PathHash < Rhs; });
+		for (; pEntry != pEnd && pEntry->PathHash == Hash; ++pEntry)
+		{
+			if (RelativePath.compare(0, std::string::npos, m_pPaths + pEntry->PathOffset, pEntry->PathLength) == 0)
+				return pEntry;
+		}
+		return nullptr;
+	}
+
+	FileView PakFile::Read(const std::string& RelativePath)
+	{
+		const Entry* pEntry = Find(RelativePath);
+		if (!pEntry)
+			return FileView();
+
+		const uint8_t* pData = m_File.GetData() + pEntry->Offset;
+		if (pEntry->NumChunks == 0u)
+			return FileView(shared_from_this(), pData, static_cast<size_t>(pEntry->Size));
+
+		std::shared_ptr<std::vector<uint8_t>> pContents = std::make_shared<std::vector<uint8_t>>(static_cast<size_t>(pEntry->Size));
+		if (!Decompress(*pEntry, pData, pContents->data()))
+		{
+			IE_DEBUG_LOG(LogSeverity::Error, "Failed to decompress \"{0}\" from \"{1}\", the archive is corrupt.", RelativePath, m_Path);
+			return FileView();
+		}
+		const uint8_t* pContentsData = pContents->data();
+		const size_t Size = pContents->size();
+		return FileView(std::move(pContents), pContentsData, Size);
+	}
+
+	FileView PakFile::Unpack(const Entry& FileEntry, std::shared_ptr<std::vector<uint8_t>> pStored) const
+	{
+		if (!pStored || pStored->size() != FileEntry.StoredSize)
+			return FileView();
+
+		if (FileEntry.NumChunks == 0u)
+		{
+			const uint8_t* pStoredData = pStored->data();
+			const size_t Size = pStored->size();
+			return FileView(std::move(pStored), pStoredData, Size);
+		}
+
+		std::shared_ptr<std::vector<uint8_t>> pContents = std::make_shared<std::vector<uint8_t>>(static_cast<size_t>(FileEntry.Size));
+		if (!Decompress(FileEntry, pStored->data(), pContents->data()))
+		{
+			IE_DEBUG_LOG(LogSeverity::Error, "Failed to decompress \"{0}\" from \"{1}\", the archive is corrupt.", std::string(m_pPaths + FileEntry.PathOffset, FileEntry.PathLength), m_Path);
+			return FileView();
+		}
+		const uint8_t* pContentsData = pContents->data();
+		const size_t Size = pContents->size();
+		return FileView(std::move(pContents), pContentsData, Size);
+	}
+
+	bool PakFile::Decompress(const Entry& FileEntry, const uint8_t* pIn, uint8_t* pOut) const
+	{
+		const uint8_t* pInEnd = pIn + FileEntry.StoredSize;
+		uint64_t Remaining = FileEntry.Size;
+
+		for (uint32_t i = 0u; i < FileEntry.NumChunks; ++i)
+		{
+			const uint32_t StoredChunk = m_pChunkSizes[FileEntry.FirstChunk + i];
+			const size_t StoredSize = StoredChunk & ~RawChunkFlag;
+			const size_t ChunkSize = static_cast<size_t>(std::min<uint64_t>(Remaining, m_pHeader->ChunkSize));
+			if (StoredSize > static_cast<size_t>(pInEnd - pIn) || ChunkSize == 0u)
+				return false;
+
+			if (StoredChunk & RawChunkFlag)
+			{
+				if (StoredSize != ChunkSize)
+					return false;
+				memcpy(pOut, pIn, ChunkSize);
+			}
+			else if (!Lz4::Decompress(pIn, StoredSize, pOut, ChunkSize))
+			{
+				return false;
+			}
+
+			pIn += StoredSize;
+			pOut += ChunkSize;
+			Remaining -= ChunkSize;
+		}
+		return Remaining == 0u;
+	}
+
+	uint64_t PakWriter::HashOptions(const Options& PakOptions)
+	{
+		uint64_t Hash = Xxh64::Hash(&PakFile::Version, sizeof(PakFile::Version));
+		Hash = Xxh64::Combine(Hash, PakOptions.Compress ? 1u : 0u);
+		Hash = Xxh64::Combine(Hash, PakOptions.ChunkSize);
+		return Xxh64::Combine(Hash, Xxh64::Hash(&PakOptions.MaxCompressedRatio, sizeof(PakOptions.MaxCompressedRatio)));
+	}
+
+	uint64_t PakWriter::HashStored(const uint8_t* pStored, size_t StoredSize, const uint32_t* pChunkSizes, uint32_t NumChunks)
+	{
+		const uint64_t Hash = Xxh64::Hash(pStored, StoredSize);
+		return Xxh64::Combine(Hash, Xxh64::Hash(pChunkSizes, NumChunks * sizeof(uint32_t)));
+	}
+
+	bool PakWriter::WriteDirectory(const std::string& SourceDirectory, const std::string& PakPath, const Options& PakOptions)
+	{
+		namespace fs = std::filesystem;
+
+		struct PackedFile
+		{
+			std::string SourcePath;
+			std::string RelativePath;
+			PakFile::Entry Entry;
+		};
+
+		// A file as it will be stored in the archive.
+		struct CookedFile
+		{
+			std::vector<uint8_t> Stored;
+			// Empty if the file is stored as is.
+			std::vector<uint32_t> ChunkSizes;
+			uint64_t Size = 0u;
+			uint64_t CookedHash = 0u;
+			bool Failed = false;
+			bool Reused = false;
+		};
+
+		std::error_code Error;
+		const fs::path SourceRoot(SourceDirectory);
+		if (!fs::is_directory(SourceRoot, Error))
+		{
+			IE_DEBUG_LOG(LogSeverity::Error, "Failed to pack \"{0}\", it is not a directory.", SourceDirectory);
+			return false;
+		}
+		if (PakOptions.ChunkSize == 0u || PakOptions.ChunkSize >= PakFile::RawChunkFlag)
+		{
+			IE_DEBUG_LOG(LogSeverity::Error, "Invalid .iepak chunk size {0}.", PakOptions.ChunkSize);
+			return false;
+		}
+
+		// The archive being written may be inside the folder being packed.
+		const fs::path TempPath = PakPath + ".tmp";
+		const fs::path AbsolutePakPath = fs::absolute(PakPath, Error).lexically_normal();
+		const fs::path AbsoluteTempPath = fs::absolute(TempPath, Error).lexically_normal();
+
+		std::vector<PackedFile> Files;
+		for (fs::recursive_directory_iterator Iter(SourceRoot, Error); !Error && Iter != fs::recursive_directory_iterator(); Iter.increment(Error))
+		{
+			if (!Iter->is_regular_file(Error))
+				continue;
+			const fs::path AbsolutePath = fs::absolute(Iter->path(), Error).lexically_normal();
+			if (AbsolutePath == AbsolutePakPath || AbsolutePath == AbsoluteTempPath)
+				continue;
+
+			PackedFile File = {};
+			File.SourcePath = Iter->path().string();
+			File.RelativePath = StringHelper::NormalizePath(Iter->path().lexically_relative(SourceRoot).string());
+			if (PakOptions.Filter && !PakOptions.Filter(File.RelativePath))
+				continue;
+			File.Entry.PathHash = PakFile::HashPath(File.RelativePath);
+			Files.push_back(std::move(File));
+		}
+		if (Error)
+		{
+			IE_DEBUG_LOG(LogSeverity::Error, "Failed to list the files of \"{0}\": {1}", SourceDirectory, Error.message());
+			return false;
+		}
+		std::sort(Files.begin(), Files.end(), [](const PackedFile& Lhs, const PackedFile& Rhs)
+			{
+				return Lhs.Entry.PathHash != Rhs.Entry.PathHash ? Lhs.Entry.PathHash < Rhs.Entry.PathHash : Lhs.RelativePath < Rhs.RelativePath;
+			});
+
+		// Released before the new archive replaces it, a mapped file cannot be replaced on Windows.
+		std::shared_ptr<PakFile> pPreviousPak;
+		if (!PakOptions.PreviousPakPath.empty() && PakOptions.IsCookUpToDate && fs::exists(PakOptions.PreviousPakPath, Error))
+		{
+			pPreviousPak = std::make_shared<PakFile>();
+			if (!pPreviousPak->Open(PakOptions.PreviousPakPath) || pPreviousPak->GetChunkSize() != PakOptions.ChunkSize)
+				pPreviousPak.reset();
+		}
+
+		auto CopyPrevious = [&pPreviousPak, &PakOptions](const PackedFile& File, CookedFile& OutCooked)
+		{
+			uint64_t CookedHash = 0u;
+			if (!pPreviousPak || !PakOptions.IsCookUpToDate(File.RelativePath, CookedHash))
+				return false;
+			const PakFile::Entry* pEntry = pPreviousPak->Find(File.RelativePath);
+			if (!pEntry)
+				return false;
+
+			// The previous archive may not be the one the database was cooked with.
+			const uint8_t* pStored = pPreviousPak->GetStoredData(*pEntry);
+			const uint32_t* pChunkSizes = pPreviousPak->GetChunkSizes(*pEntry);
+			if (HashStored(pStored, static_cast<size_t>(pEntry->StoredSize), pChunkSizes, pEntry->NumChunks) != CookedHash)
+				return false;
+
+			OutCooked.Stored.assign(pStored, pStored + pEntry->StoredSize);
+			OutCooked.ChunkSizes.assign(pChunkSizes, pChunkSizes + pEntry->NumChunks);
+			OutCooked.Size = pEntry->Size;
+			OutCooked.CookedHash = CookedHash;
+			OutCooked.Reused = true;
+			return true;
+		};
+
+		auto Cook = [&PakOptions, &CopyPrevious](const PackedFile& File, CookedFile& OutCooked)
+		{
+			if (CopyPrevious(File, OutCooked))
+				return;
+
+			std::vector<uint8_t> Contents;
+			{
+				std::ifstream In(File.SourcePath, std::ios::binary | std::ios::ate);
+				if (!In.is_open())
+				{
+					OutCooked.Failed = true;
+					return;
+				}
+				Contents.resize(static_cast<size_t>(In.tellg()));
+				In.seekg(0, std::ios::beg);
+				In.read(reinterpret_cast<char*>(Contents.data()), Contents.size());
+			}
+			OutCooked.Size = Contents.size();
+
+			// Compress the file chunk by chunk and keep it only if it saved enough.
+			std::vector<uint8_t> Compressed;
+			std::vector<uint32_t> FileChunkSizes;
+			if (PakOptions.Compress && !Contents.empty())
+			{
+				std::vector<uint8_t> ChunkBuffer(Lz4::CompressBound(PakOptions.ChunkSize));
+				for (size_t ChunkStart = 0u; ChunkStart < Contents.size(); ChunkStart += PakOptions.ChunkSize)
+				{
+					const size_t ChunkSize = std::min<size_t>(PakOptions.ChunkSize, Contents.size() - ChunkStart);
+					const size_t CompressedSize = Lz4::Compress(Contents.data() + ChunkStart, ChunkSize, ChunkBuffer.data(), ChunkBuffer.size());
+					if (CompressedSize != 0u && CompressedSize < ChunkSize)
+					{
+						Compressed.insert(Compressed.end(), ChunkBuffer.begin(), ChunkBuffer.begin() + CompressedSize);
+						FileChunkSizes.push_back(static_cast<uint32_t>(CompressedSize));
+					}
+					else
+					{
+						Compressed.insert(Compressed.end(), Contents.begin() + ChunkStart, Contents.begin() + ChunkStart + ChunkSize);
+						FileChunkSizes.push_back(static_cast<uint32_t>(ChunkSize) | PakFile::RawChunkFlag);
+					}
+				}
+			}
+
+			const bool IsCompressed = !FileChunkSizes.empty() && static_cast<float>(Compressed.size()) <= static_cast<float>(Contents.size()) * PakOptions.MaxCompressedRatio;
+			if (IsCompressed)
+			{
+				OutCooked.Stored = std::move(Compressed);
+				OutCooked.ChunkSizes = std::move(FileChunkSizes);
+			}
+			else
+			{
+				OutCooked.Stored = std::move(Contents);
+			}
+			OutCooked.CookedHash = HashStored(OutCooked.Stored.data(), OutCooked.Stored.size(), OutCooked.ChunkSizes.data(), static_cast<uint32_t>(OutCooked.ChunkSizes.size()));
+		};
+
+		std::ofstream Out(TempPath, std::ios::binary | std::ios::trunc);
+		if (!Out.is_open())
+		{
+			IE_DEBUG_LOG(LogSeverity::Error, "Failed to open \"{0}\" for writing.", TempPath.string());
+			return false;
+		}
+
+		PakFile::Header Header = {};
+		Out.write(reinterpret_cast<const char*>(&Header), sizeof(Header));
+		uint64_t Offset = sizeof(Header);
+		auto PadTo = [&Out, &Offset](uint64_t Alignment)
+		{
+			static const char Zeros[PakFile::DataAlignment] = {};
+			const uint64_t Aligned = AlignUp(Offset, Alignment);
+			Out.write(Zeros, static_cast<std::streamsize>(Aligned - Offset));
+			Offset = Aligned;
+		};
+
+		// Cook a batch of files in parallel, then write them in order. Batches bound the memory held by cooked files.
+		const uint32_t NumThreads = PakOptions.NumThreads != 0u ? PakOptions.NumThreads : std::max(std::thread::hardware_concurrency(), 1u);
+		const size_t BatchSize = static_cast<size_t>(NumThreads) * 4u;
+		std::vector<CookedFile> Cooked;
+		std::vector<uint32_t> ChunkSizes;
+		std::string Paths;
+		uint64_t TotalSize = 0u;
+		uint32_t NumReused = 0u;
+		for (size_t BatchStart = 0u; BatchStart < Files.size(); BatchStart += BatchSize)
+		{
+			const size_t BatchEnd = std::min(BatchStart + BatchSize, Files.size());
+			Cooked.clear();
+			Cooked.resize(BatchEnd - BatchStart);
+
+			std::atomic<size_t> NextFile = BatchStart;
+			std::vector<std::future<void>> Workers;
+			for (uint32_t i = 0u; i < NumThreads && i < BatchEnd - BatchStart; ++i)
+			{
+				Workers.push_back(std::async(std::launch::async, [&]()
+					{
+						for (size_t Index = NextFile++; Index < BatchEnd; Index = NextFile++)
+							Cook(Files[Index], Cooked[Index - BatchStart]);
+					}));
+			}
+			for (std::future<void>& Worker : Workers)
+				Worker.wait();
+
+			for (size_t i = BatchStart; i < BatchEnd; ++i)
+			{
+				PackedFile& File = Files[i];
+				CookedFile& FileCooked = Cooked[i - BatchStart];
+				if (FileCooked.Failed)
+				{
+					IE_DEBUG_LOG(LogSeverity::Error, "Failed to read \"{0}\" while packing \"{1}\".", File.SourcePath, PakPath);
+					return false;
+				}
+
+				PakFile::Entry& Entry = File.Entry;
+				Entry.Size = FileCooked.Size;
+				Entry.StoredSize = FileCooked.Stored.size();
+				Entry.PathOffset = static_cast<uint32_t>(Paths.size());
+				Entry.PathLength = static_cast<uint32_t>(File.RelativePath.size());
+				Paths += File.RelativePath;
+				TotalSize += Entry.Size;
+				NumReused += FileCooked.Reused ? 1u : 0u;
+
+				if (!FileCooked.ChunkSizes.empty())
+				{
+					Entry.FirstChunk = static_cast<uint32_t>(ChunkSizes.size());
+					Entry.NumChunks = static_cast<uint32_t>(FileCooked.ChunkSizes.size());
+					ChunkSizes.insert(ChunkSizes.end(), FileCooked.ChunkSizes.begin(), FileCooked.ChunkSizes.end());
+				}
+
+				PadTo(PakFile::DataAlignment);
+				Entry.Offset = Offset;
+				Out.write(reinterpret_cast<const char*>(FileCooked.Stored.data()), static_cast<std::streamsize>(FileCooked.Stored.size()));
+				Offset += Entry.StoredSize;
+
+				if (PakOptions.OnCooked)
+					PakOptions.OnCooked(File.RelativePath, FileCooked.CookedHash);
+			}
+		}
+		pPreviousPak.reset();
+
+		PadTo(PakFile::DataAlignment);
+		Header.Magic = PakFile::Magic;
+		Header.Version = PakFile::Version;
+		Header.NumEntries = static_cast<uint32_t>(Files.size());
+		Header.NumChunks = static_cast<uint32_t>(ChunkSizes.size());
+		Header.ChunkSize = PakOptions.ChunkSize;
+		Header.TocOffset = Offset;
+		for (const PackedFile& File : Files)
+			Out.write(reinterpret_cast<const char*>(&File.Entry), sizeof(File.Entry));
+		Out.write(reinterpret_cast<const char*>(ChunkSizes.data()), static_cast<std::streamsize>(ChunkSizes.size() * sizeof(uint32_t)));
+		Out.write(Paths.data(), static_cast<std::streamsize>(Paths.size()));
+
+		Out.seekp(0);
+		Out.write(reinterpret_cast<const char*>(&Header), sizeof(Header));
+		Out.close();
+		if (!Out.good())
+		{
+			IE_DEBUG_LOG(LogSeverity::Error, "Failed to write \"{0}\".", TempPath.string());
+			return false;
+		}
+
+		fs::rename(TempPath, PakPath, Error);
+		if (Error)
+		{
+			IE_DEBUG_LOG(LogSeverity::Error, "Failed to replace \"{0}\": {1}", PakPath, Error.message());
+			return false;
+		}
+		IE_DEBUG_LOG(LogSeverity::Log, "Packed {0} files ({1} bytes) from \"{2}\" into \"{3}\" ({4} bytes), {5} copied from the previous archive.", Files.size(), TotalSize, SourceDirectory, PakPath, Header.TocOffset, NumReused);
+		return true;
+	}
+
+}
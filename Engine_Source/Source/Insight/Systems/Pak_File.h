@@ -0,0 +1,168 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Pak_File.h
+	Source - Pak_File.cpp
+
+	Purpose:
+	Reads and writes .iepak archives, the packed form of a Content folder shipped with game builds.
+
+	Description:
+	An .iepak is one file laid out as:
+	Header				- Magic "IEPK", version, entry and chunk counts, the chunk size and where the table of contents starts.
+	File data			- Each file's bytes, starting on a DataAlignment boundary.
+	Table of contents	- An Entry per file sorted by path hash, the stored size of every compressed chunk
+						  and the paths of the files.
+	Paths are stored relative to the packed folder, lower case with '/' separators, and hashed with 64 bit
+	FNV-1a. A lookup is a binary search on the hash followed by a compare of the path.
+	Files that do not compress well are stored as is and read straight out of the mapped archive without a
+	copy. Compressed files are split into chunks of ChunkSize bytes, each compressed on its own with LZ4 so
+	a chunk that does not shrink can be stored raw, and are decompressed into a buffer on read.
+	The archive is mapped once when it is opened and is only read from after that, so reads are thread safe.
+	PakWriter compresses files in parallel. Incremental cooks pass the previous archive and a callback that
+	says which files are unchanged (see AssetDatabase), and those are copied across without compressing them.
+
+	Example Usage:
+	PakWriter::WriteDirectory("../Content", "../Content.iepak", PakWriter::Options());
+	...
+	std::shared_ptr<PakFile> pPak = std::make_shared<PakFile>();
+	pPak->Open("../Content.iepak");
+	FileView View = pPak->Read("textures/brick.dds");
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+#include "Insight/Systems/Mapped_File.h"
+
+#include <functional>
+
+namespace Insight {
+
+	class INSIGHT_API PakFile : public std::enable_shared_from_this<PakFile>
+	{
+	public:
+		static constexpr uint32_t Magic = 0x4B504549u; // "IEPK"
+		static constexpr uint32_t Version = 1u;
+		static constexpr uint32_t DataAlignment = 64u;
+		// Set on a chunk's stored size if the chunk was stored without compression.
+		static constexpr uint32_t RawChunkFlag = 0x80000000u;
+
+		struct Header
+		{
+			uint32_t Magic;
+			uint32_t Version;
+			uint32_t NumEntries;
+			uint32_t NumChunks;
+			uint32_t ChunkSize;
+			uint32_t Reserved;
+			uint64_t TocOffset;
+		};
+
+		struct Entry
+		{
+			uint64_t PathHash;
+			// Offset of the file's data from the start of the archive.
+			uint64_t Offset;
+			uint64_t Size;
+			// Size of the file's data in the archive. Equal to Size for files that are not compressed.
+			uint64_t StoredSize;
+			// The file's chunks in the chunk table. NumChunks is 0 for files that are not compressed.
+			uint32_t FirstChunk;
+			uint32_t NumChunks;
+			// The file's relative path in the path table.
+			uint32_t PathOffset;
+			uint32_t PathLength;
+		};
+		static_assert(sizeof(Header) == 32u, "The .iepak header must not change size.");
+		static_assert(sizeof(Entry) == 48u, "The .iepak table of contents entry must not change size.");
+
+	public:
+		PakFile() = default;
+		~PakFile() = default;
+
+		PakFile(const PakFile&) = delete;
+		PakFile& operator = (const PakFile&) = delete;
+
+		// Map an archive and validate its table of contents. Returns false if it is missing or corrupt.
+		bool Open(const std::string& Path);
+
+		/*
+			Read a file out of the archive. The view keeps the archive open. Invalid if the file is not packed
+			or failed to decompress. The PakFile must be owned by a std::shared_ptr.
+			@param RelativePath - Path relative to the packed folder, normalized with StringHelper::NormalizePath.
+		*/
+		FileView Read(const std::string& RelativePath);
+		bool Contains(const std::string& RelativePath) const { return Find(RelativePath) != nullptr; }
+		// Returns the table of contents entry of a packed file, or nullptr if it is not packed.
+		const Entry* Find(const std::string& RelativePath) const;
+		/*
+			Turn a file's stored bytes, read from the archive by the caller, into its contents. Used by async reads
+			that read the stored bytes with AsyncIO instead of faulting them in from the mapped archive.
+			@param pStored - The StoredSize bytes at the entry's Offset. Returned as the view as is if the file is not compressed.
+		*/
+		FileView Unpack(const Entry& FileEntry, std::shared_ptr<std::vector<uint8_t>> pStored) const;
+
+		// The bytes a file is stored as and the stored size of each of its chunks, Ex. to copy it into a new archive.
+		inline const uint8_t* GetStoredData(const Entry& FileEntry) const { return m_File.GetData() + FileEntry.Offset; }
+		inline const uint32_t* GetChunkSizes(const Entry& FileEntry) const { return m_pChunkSizes + FileEntry.FirstChunk; }
+		inline uint32_t GetChunkSize() const { return m_pHeader ? m_pHeader->ChunkSize : 0u; }
+		inline uint32_t GetNumEntries() const { return m_pHeader ? m_pHeader->NumEntries : 0u; }
+		inline const std::string& GetPath() const { return m_Path; }
+
+		// 64 bit FNV-1a hash of a path normalized with StringHelper::NormalizePath.
+		static uint64_t HashPath(const std::string& NormalizedPath);
+
+	private:
+		bool Decompress(const Entry& FileEntry, const uint8_t* pIn, uint8_t* pOut) const;
+
+	private:
+		std::string m_Path;
+		MappedFile m_File;
+		const Header* m_pHeader = nullptr;
+		const Entry* m_pEntries = nullptr;
+		const uint32_t* m_pChunkSizes = nullptr;
+		const char* m_pPaths = nullptr;
+	};
+
+	class INSIGHT_API PakWriter
+	{
+	public:
+		struct Options
+		{
+			// Compress files with LZ4. Files are stored as is if this is false.
+			bool Compress = true;
+			// Uncompressed size of each chunk a file is split into before it is compressed.
+			uint32_t ChunkSize = 64u * 1024u;
+			// Files that compress to more than this fraction of their size are stored as is, so they can be read without a copy.
+			float MaxCompressedRatio = 0.9f;
+			// Threads files are compressed on. 0 uses one per core.
+			uint32_t NumThreads = 0u;
+
+			// Optional. Only files it returns true for are packed.
+			std::function<bool(const std::string& RelativePath)> Filter;
+			/*
+				Optional, for incremental cooks. An archive written before, with the same options. A file is copied out of it
+				instead of being compressed again when IsCookUpToDate returns true and the file's stored bytes in the previous
+				archive still hash to OutCookedHash (see HashStored).
+			*/
+			std::string PreviousPakPath;
+			std::function<bool(const std::string& RelativePath, uint64_t& OutCookedHash)> IsCookUpToDate;
+			// Optional. Called in archive order with the hash of the bytes each file was stored as.
+			std::function<void(const std::string& RelativePath, uint64_t CookedHash)> OnCooked;
+		};
+
+		/*
+			Pack every file under a folder into an archive. An existing archive at PakPath is replaced
+			once the new one has been written. Returns false if a file could not be read or the archive could not be written.
+			@param SourceDirectory - Folder to pack. Packed paths are relative to it.
+			@param PakPath - Path of the .iepak to write.
+		*/
+		static bool WriteDirectory(const std::string& SourceDirectory, const std::string& PakPath, const Options& PakOptions);
+
+		// Hash of the options that change how files are stored. Cooked output is only reused between cooks with the same hash.
+		static uint64_t HashOptions(const Options& PakOptions);
+		// XXH64 of a file's stored bytes and chunk sizes, the cooked hash passed to OnCooked.
+		static uint64_t HashStored(const uint8_t* pStored, size_t StoredSize, const uint32_t* pChunkSizes, uint32_t NumChunks);
+	};
+
+}
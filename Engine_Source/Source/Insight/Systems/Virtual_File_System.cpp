@@ -0,0 +1,216 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Virtual_File_System.h"
+
+#include "Insight/Systems/Pak_File.h"
+
+#include <cctype>
+#include <filesystem>
+
+namespace Insight {
+
+	VirtualFileSystem VirtualFileSystem::s_Instance;
+
+	static std::string ToLower(std::string Path)
+	{
+		for (char& Character : Path)
+			Character = static_cast<char>(std::tolower(static_cast<unsigned char>(Character)));
+		return Path;
+	}
+
+	std::string VirtualFileSystem::GetAbsolutePath(const std::string& Path)
+	{
+		std::error_code Error;
+		std::filesystem::path Absolute = std::filesystem::absolute(Path, Error);
+		if (Error)
+			Absolute = Path;
+		return Absolute.lexically_normal().generic_string();
+	}
+
+	bool VirtualFileSystem::Mount(const std::string& MountPoint, const std::string& Source)
+	{
+		VirtualFileSystem::MountPoint NewMount;
+		NewMount.Root = ToLower(GetAbsolutePath(MountPoint));
+		if (NewMount.Root.empty() || NewMount.Root.back() != '/')
+			NewMount.Root += '/';
+
+		std::error_code Error;
+		if (ToLower(std::filesystem::path(Source).extension().string()) == ".iepak")
+		{
+			NewMount.pPak = std::make_shared<PakFile>();
+			if (!NewMount.pPak->Open(Source))
+			{
+				IE_DEBUG_LOG(LogSeverity::Error, "Failed to mount \"{0}\" to \"{1}\", the archive could not be opened.", Source, MountPoint);
+				return false;
+			}
+		}
+		else if (std::filesystem::is_directory(Source, Error))
+		{
+			NewMount.Directory = GetAbsolutePath(Source);
+			if (NewMount.Directory.back() != '/')
+				NewMount.Directory += '/';
+		}
+		else
+		{
+			IE_DEBUG_LOG(LogSeverity::Error, "Failed to mount \"{0}\" to \"{1}\", it is not an .iepak archive or a folder.", Source, MountPoint);
+			return false;
+		}
+
+		std::unique_lock<std::shared_mutex> Lock(m_MountMutex);
+		m_Mounts.push_back(std::move(NewMount));
+		IE_DEBUG_LOG(LogSeverity::Log, "Mounted \"{0}\" to \"{1}\".", Source, MountPoint);
+		return true;
+	}
+
+	void VirtualFileSystem::UnmountAll()
+	{
+		std::unique_lock<std::shared_mutex> Lock(m_MountMutex);
+		m_Mounts.clear();
+	}
+
+	FileView VirtualFileSystem::Read(const std::string& Path) const
+	{
+		const std::string AbsolutePath = GetAbsolutePath(Path);
+		const bool PreferLooseFiles = m_PreferLooseFiles;
+		if (PreferLooseFiles)
+		{
+			FileView Loose = MappedFile::OpenView(AbsolutePath);
+			if (Loose)
+				return Loose;
+		}
+
+		{
+			const std::string Key = ToLower(AbsolutePath);
+			std::shared_lock<std::shared_mutex> Lock(m_MountMutex);
+			for (auto Iter = m_Mounts.rbegin(); Iter != m_Mounts.rend(); ++Iter)
+			{
+				if (Key.compare(0, Iter->Root.size(), Iter->Root) != 0)
+					continue;
+
+				FileView View = Iter->pPak ? Iter->pPak->Read(Key.substr(Iter->Root.size())) : MappedFile::OpenView(Iter->Directory + AbsolutePath.substr(Iter->Root.size()));
+				if (View)
+					return View;
+			}
+		}
+
+		return PreferLooseFiles ? FileView() : MappedFile::OpenView(AbsolutePath);
+	}
+
+	void VirtualFileSystem::ReadAsync(const std::string& Path, AsyncIO::Priority ReadPriority, ReadCallback OnRead) const
+	{
+		const std::string AbsolutePath = GetAbsolutePath(Path);
+		const bool PreferLooseFiles = m_PreferLooseFiles;
+		if (PreferLooseFiles && ReadFileAsync(AbsolutePath, ReadPriority, OnRead))
+			return;
+
+		// Find where the file is under the lock, the read is queued after it is released in case OnRead runs inline.
+		std::shared_ptr<PakFile> pPak;
+		const PakFile::Entry* pEntry = nullptr;
+		std::string DirectoryPath;
+		{
+			const std::string Key = ToLower(AbsolutePath);
+			std::error_code Error;
+			std::shared_lock<std::shared_mutex> Lock(m_MountMutex);
+			for (auto Iter = m_Mounts.rbegin(); Iter != m_Mounts.rend(); ++Iter)
+			{
+				if (Key.compare(0, Iter->Root.size(), Iter->Root) != 0)
+					continue;
+
+				if (Iter->pPak)
+				{
+					pEntry = Iter->pPak->Find(Key.substr(Iter->Root.size()));
+					if (pEntry)
+					{
+						pPak = Iter->pPak;
+						break;
+					}
+				}
+				else
+				{
+					std::string MountedPath = Iter->Directory + AbsolutePath.substr(Iter->Root.size());
+					if (std::filesystem::is_regular_file(MountedPath, Error))
+					{
+						DirectoryPath = std::move(MountedPath);
+						break;
+					}
+				}
+			}
+		}
+
+		if (pPak)
+		{
+			std::shared_ptr<std::vector<uint8_t>> pStored = std::make_shared<std::vector<uint8_t>>(static_cast<size_t>(pEntry->StoredSize));
+			AsyncIO::ReadRequest Request;
+			Request.Path = pPak->GetPath();
+			Request.Offset = pEntry->Offset;
+			Request.Size = pEntry->StoredSize;
+			Request.pDestination = pStored->data();
+			Request.ReadPriority = ReadPriority;
+			Request.OnComplete = [pPak, pEntry, pStored, OnRead = std::move(OnRead)](const AsyncIO::ReadResult& Result)
+			{
+				OnRead(Result.Succeeded ? pPak->Unpack(*pEntry, pStored) : FileView());
+			};
+			AsyncIO::Get().Read(std::move(Request));
+			return;
+		}
+
+		if (!DirectoryPath.empty() && ReadFileAsync(DirectoryPath, ReadPriority, OnRead))
+			return;
+		if (!PreferLooseFiles && ReadFileAsync(AbsolutePath, ReadPriority, OnRead))
+			return;
+		OnRead(FileView());
+	}
+
+	bool VirtualFileSystem::ReadFileAsync(const std::string& Path, AsyncIO::Priority ReadPriority, const ReadCallback& OnRead)
+	{
+		std::error_code Error;
+		const uintmax_t Size = std::filesystem::file_size(Path, Error);
+		if (Error)
+			return false;
+
+		std::shared_ptr<std::vector<uint8_t>> pContents = std::make_shared<std::vector<uint8_t>>(static_cast<size_t>(Size));
+		AsyncIO::ReadRequest Request;
+		Request.Path = Path;
+		Request.Size = Size;
+		Request.pDestination = pContents->data();
+		Request.ReadPriority = ReadPriority;
+		Request.OnComplete = [pContents, OnRead](const AsyncIO::ReadResult& Result)
+		{
+			if (!Result.Succeeded)
+			{
+				OnRead(FileView());
+				return;
+			}
+			// The file may have been truncated since its size was read.
+			pContents->resize(static_cast<size_t>(Result.BytesRead));
+			const uint8_t* pData = pContents->data();
+			const size_t Size = pContents->size();
+			OnRead(FileView(pContents, pData, Size));
+		};
+		AsyncIO::Get().Read(std::move(Request));
+		return true;
+	}
+
+	bool VirtualFileSystem::Exists(const std::string& Path) const
+	{
+		const std::string AbsolutePath = GetAbsolutePath(Path);
+		std::error_code Error;
+		if (std::filesystem::is_regular_file(AbsolutePath, Error))
+			return true;
+
+		const std::string Key = ToLower(AbsolutePath);
+		std::shared_lock<std::shared_mutex> Lock(m_MountMutex);
+		for (auto Iter = m_Mounts.rbegin(); Iter != m_Mounts.rend(); ++Iter)
+		{
+			if (Key.compare(0, Iter->Root.size(), Iter->Root) != 0)
+				continue;
+
+			const bool Found = Iter->pPak ? Iter->pPak->Contains(Key.substr(Iter->Root.size())) : std::filesystem::is_regular_file(Iter->Directory + AbsolutePath.substr(Iter->Root.size()), Error);
+			if (Found)
+				return true;
+		}
+		return false;
+	}
+
+}
@@ -0,0 +1,104 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Virtual_File_System.h
+	Source - Virtual_File_System.cpp
+
+	Purpose:
+	Single entry point for reading engine files, whether they are loose on disk or packed in an .iepak.
+
+	Description:
+	Mount points map a folder the engine reads from to an .iepak archive or to another folder on disk.
+	Callers keep using the same paths they always have (Ex. "../Content/Textures/Brick.dds"). A read
+	goes to the most recently mounted mount point the path is under, then the ones before it, and paths
+	that are not under any mount point or not found in one are mapped straight from disk. Paths are
+	compared absolute and case insensitive, as Windows does. Reads return a FileView: loose files and
+	files stored raw in an archive are memory mapped and read without a copy, compressed files are
+	decompressed into a buffer the view owns.
+	Development builds prefer loose files so files edited while the engine is running (see AssetHotReload)
+	are read over the stale copy in an archive. Mounting is expected at startup, reads are thread safe.
+	ReadAsync resolves the path the same way and reads the file with AsyncIO instead of mapping it, so
+	loaders can queue many files at once and decode each one on an I/O worker as soon as it arrives.
+
+	Example Usage:
+	VirtualFileSystem::Get().Mount("../Content", "../Content/Content.iepak");
+	...
+	FileView View = VirtualFileSystem::Get().Read("../Content/Scenes/Norway.iescene/Actors.json");
+	VirtualFileSystem::Get().ReadAsync("../Content/Textures/Brick.dds", AsyncIO::Priority::Normal, [](FileView View) { ... });
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+#include "Insight/Systems/Mapped_File.h"
+#include "Insight/Systems/Async_IO.h"
+
+#include <atomic>
+#include <shared_mutex>
+
+namespace Insight {
+
+	class PakFile;
+
+	class INSIGHT_API VirtualFileSystem
+	{
+	public:
+		typedef std::function<void(FileView)> ReadCallback;
+
+	public:
+		VirtualFileSystem() = default;
+		~VirtualFileSystem() = default;
+
+		static VirtualFileSystem& Get() { return s_Instance; }
+
+		/*
+			Redirect reads under a folder. Mount points added later are searched first.
+			@param MountPoint - Folder whose files are redirected, Ex. "../Content".
+			@param Source - An .iepak archive, or a folder to read the files from instead.
+			Returns false if the source does not exist or the archive is corrupt.
+		*/
+		bool Mount(const std::string& MountPoint, const std::string& Source);
+		// Remove every mount point. Views that were read stay valid.
+		void UnmountAll();
+
+		// Read a whole file. The view is invalid if the file was not found. Thread safe.
+		// @param Path - The path the file is read from on disk when nothing is mounted.
+		FileView Read(const std::string& Path) const;
+		/*
+			Read a whole file in the background. Thread safe.
+			@param ReadPriority - Priority of the read in the AsyncIO queue.
+			@param OnRead - Called on an AsyncIO worker with the file, or an invalid view if it was not found or could not be read.
+			Called before ReadAsync returns if the file was not found or AsyncIO is not running.
+		*/
+		void ReadAsync(const std::string& Path, AsyncIO::Priority ReadPriority, ReadCallback OnRead) const;
+		// True if Read would find the file. Thread safe.
+		bool Exists(const std::string& Path) const;
+
+		// Read loose files over the mounted archives when both have the file.
+		inline void SetPreferLooseFiles(bool PreferLooseFiles) { m_PreferLooseFiles = PreferLooseFiles; }
+		inline uint32_t GetNumMounts() const { std::shared_lock<std::shared_mutex> Lock(m_MountMutex); return static_cast<uint32_t>(m_Mounts.size()); }
+
+	private:
+		struct MountPoint
+		{
+			// Absolute path of the mounted folder, normalized and ending in '/'.
+			std::string Root;
+			// Set when the folder is mounted to an archive.
+			std::shared_ptr<PakFile> pPak;
+			// Set when the folder is mounted to another folder. Ends in '/'.
+			std::string Directory;
+		};
+
+		// Returns the absolute, normalized form of a path, Ex. "C:\Game\Bin\../Content/a.png" becomes "C:/Game/Content/a.png".
+		static std::string GetAbsolutePath(const std::string& Path);
+		// Queue an async read of a whole file on disk. Returns false without calling OnRead if the file does not exist.
+		static bool ReadFileAsync(const std::string& Path, AsyncIO::Priority ReadPriority, const ReadCallback& OnRead);
+
+	private:
+		mutable std::shared_mutex m_MountMutex;
+		std::vector<MountPoint> m_Mounts;
+		std::atomic<bool> m_PreferLooseFiles = false;
+
+		static VirtualFileSystem s_Instance;
+	};
+
+}
@@ -59,6 +59,7 @@ namespace Insight {
 		#define EDITOR_TREE_NODE_EX(Label, Flags) ImGui::TreeNodeEx(Label, Flags)
 		#define EDITOR_POP_TREE_NODE() ImGui::TreePop()
 		#define EDITOR_IS_ITEM_CLICKED() ImGui::IsItemClicked()
+		#define EDITOR_IS_ANY_ITEM_ACTIVE() ImGui::IsAnyItemActive()
 		#define EDITOR_SAME_LINE() ImGui::SameLine()
 		#define EDITOR_PUSH_ID(ID) ImGui::PushID(ID)
 		#define EDITOR_POP_ID() ImGui::PopID()
@@ -86,6 +87,7 @@ namespace Insight {
 		#define EDITOR_TREE_NODE_EX(Label, Flags) false
 		#define EDITOR_POP_TREE_NODE()
 		#define EDITOR_IS_ITEM_CLICKED() false
+		#define EDITOR_IS_ANY_ITEM_ACTIVE() false
 		#define EDITOR_SAME_LINE()
 		#define EDITOR_PUSH_ID(ID)
 		#define EDITOR_POP_ID()
@@ -211,6 +213,12 @@ namespace Insight {
 			return EDITOR_IS_ITEM_CLICKED();
 		}
 
+		// True while any widget is being edited or clicked, Ex. a value being dragged.
+		static inline bool IsAnyItemActive()
+		{
+			return EDITOR_IS_ANY_ITEM_ACTIVE();
+		}
+
 		static void DrawVector3Control(const std::string& Label, Math::ieVector3& Values, float ResetValue = 0.0f, float ColumnWidth = 100.0f)
 		{
 #if defined (IE_PLATFORM_BUILD_WIN32)
@@ -0,0 +1,189 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Lz4.h"
+
+namespace Insight {
+
+	namespace Lz4 {
+
+		namespace {
+
+			// Shortest match the format can encode.
+			constexpr size_t MinMatch = 4u;
+			// The last match must start at least this far from the end of the block.
+			constexpr size_t MatchStartLimit = 12u;
+			// The last bytes of a block are always literals.
+			constexpr size_t LastLiterals = 5u;
+			constexpr size_t MaxOffset = 65535u;
+			constexpr uint32_t HashBits = 12u;
+
+			inline uint32_t Read32(const uint8_t* pData)
+			{
+				uint32_t Value;
+				memcpy(&Value, pData, sizeof(Value));
+				return Value;
+			}
+
+			inline uint32_t Hash(uint32_t Sequence)
+			{
+				return (Sequence * 2654435761u) >> (32u - HashBits);
+			}
+
+			// Write the 255 continued remainder of a length whose 4 bit field in the token was saturated.
+			inline bool WriteLength(size_t Length, uint8_t*& pOut, const uint8_t* pOutEnd)
+			{
+				for (; Length >= 255u; Length -= 255u)
+				{
+					if (pOut >= pOutEnd) return false;
+					*pOut++ = 255u;
+				}
+				if (pOut >= pOutEnd) return false;
+				*pOut++ = static_cast<uint8_t>(Length);
+				return true;
+			}
+
+			inline bool ReadLength(size_t& Length, const uint8_t*& pIn, const uint8_t* pInEnd)
+			{
+				uint8_t Byte;
+				do
+				{
+					if (pIn >= pInEnd) return false;
+					Byte = *pIn++;
+					Length += Byte;
+				} while (Byte == 255u);
+				return true;
+			}
+
+			// Write a sequence of literals followed by a match. A MatchLength of 0 writes the final literals only.
+			bool WriteSequence(const uint8_t* pLiterals, size_t NumLiterals, size_t Offset, size_t MatchLength, uint8_t*& pOut, const uint8_t* pOutEnd)
+			{
+				if (pOut >= pOutEnd)
+					return false;
+
+				uint8_t* pToken = pOut++;
+				*pToken = static_cast<uint8_t>((NumLiterals >= 15u ? 15u : NumLiterals) << 4u);
+				if (NumLiterals >= 15u && !WriteLength(NumLiterals - 15u, pOut, pOutEnd))
+					return false;
+
+				if (static_cast<size_t>(pOutEnd - pOut) < NumLiterals)
+					return false;
+				memcpy(pOut, pLiterals, NumLiterals);
+				pOut += NumLiterals;
+
+				if (MatchLength == 0u)
+					return true;
+
+				if (pOutEnd - pOut < 2)
+					return false;
+				*pOut++ = static_cast<uint8_t>(Offset);
+				*pOut++ = static_cast<uint8_t>(Offset >> 8u);
+
+				const size_t MatchCode = MatchLength - MinMatch;
+				*pToken |= static_cast<uint8_t>(MatchCode >= 15u ? 15u : MatchCode);
+				return MatchCode < 15u || WriteLength(MatchCode - 15u, pOut, pOutEnd);
+			}
+
+		} // end anonymous namespace
+
+		size_t Compress(const uint8_t* pSource, size_t SourceSize, uint8_t* pDest, size_t DestCapacity)
+		{
+			uint8_t* pOut = pDest;
+			const uint8_t* pOutEnd = pDest + DestCapacity;
+			size_t Anchor = 0u;
+
+			if (SourceSize > MatchStartLimit)
+			{
+				// Most recent position of each hashed 4 byte sequence, offset by one so 0 means empty.
+				std::vector<uint32_t> Table(size_t(1) << HashBits, 0u);
+				const size_t MatchLimit = SourceSize - MatchStartLimit;
+				const size_t MatchEnd = SourceSize - LastLiterals;
+
+				size_t Position = 0u;
+				while (Position < MatchLimit)
+				{
+					const uint32_t Sequence = Read32(pSource + Position);
+					uint32_t& Slot = Table[Hash(Sequence)];
+					const size_t Candidate = Slot;
+					Slot = static_cast<uint32_t>(Position + 1u);
+
+					if (Candidate == 0u || Position - (Candidate - 1u) > MaxOffset || Read32(pSource + Candidate - 1u) != Sequence)
+					{
+						++Position;
+						continue;
+					}
+
+					const size_t Match = Candidate - 1u;
+					size_t MatchLength = MinMatch;
+					while (Position + MatchLength < MatchEnd && pSource[Match + MatchLength] == pSource[Position + MatchLength])
+						++MatchLength;
+
+					if (!WriteSequence(pSource + Anchor, Position - Anchor, Position - Match, MatchLength, pOut, pOutEnd))
+						return 0u;
+
+					Position += MatchLength;
+					Anchor = Position;
+				}
+			}
+
+			if (!WriteSequence(pSource + Anchor, SourceSize - Anchor, 0u, 0u, pOut, pOutEnd))
+				return 0u;
+			return static_cast<size_t>(pOut - pDest);
+		}
+
+		bool Decompress(const uint8_t* pSource, size_t SourceSize, uint8_t* pDest, size_t DestSize)
+		{
+			const uint8_t* pIn = pSource;
+			const uint8_t* pInEnd = pSource + SourceSize;
+			uint8_t* pOut = pDest;
+			uint8_t* pOutEnd = pDest + DestSize;
+
+			while (pIn < pInEnd)
+			{
+				const uint8_t Token = *pIn++;
+
+				size_t NumLiterals = Token >> 4u;
+				if (NumLiterals == 15u && !ReadLength(NumLiterals, pIn, pInEnd))
+					return false;
+				if (static_cast<size_t>(pInEnd - pIn) < NumLiterals || static_cast<size_t>(pOutEnd - pOut) < NumLiterals)
+					return false;
+				memcpy(pOut, pIn, NumLiterals);
+				pIn += NumLiterals;
+				pOut += NumLiterals;
+
+				// The last sequence has no match.
+				if (pIn == pInEnd)
+					break;
+
+				if (pInEnd - pIn < 2)
+					return false;
+				const size_t Offset = static_cast<size_t>(pIn[0]) | (static_cast<size_t>(pIn[1]) << 8u);
+				pIn += 2;
+				if (Offset == 0u || Offset > static_cast<size_t>(pOut - pDest))
+					return false;
+
+				size_t MatchLength = Token & 15u;
+				if (MatchLength == 15u && !ReadLength(MatchLength, pIn, pInEnd))
+					return false;
+				MatchLength += MinMatch;
+				if (static_cast<size_t>(pOutEnd - pOut) < MatchLength)
+					return false;
+
+				// Matches may overlap the bytes they produce, Ex. an offset of 1 repeats one byte.
+				const uint8_t* pMatch = pOut - Offset;
+				if (Offset >= MatchLength)
+				{
+					memcpy(pOut, pMatch, MatchLength);
+					pOut += MatchLength;
+				}
+				else
+				{
+					for (size_t i = 0u; i < MatchLength; ++i)
+						*pOut++ = *pMatch++;
+				}
+			}
+			return pOut == pOutEnd;
+		}
+
+	} // end namespace Lz4
+}
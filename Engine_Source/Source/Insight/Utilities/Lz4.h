@@ -0,0 +1,40 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Lz4.h
+	Source - Lz4.cpp
+
+	Purpose:
+	Compresses and decompresses buffers in the LZ4 block format.
+
+	Description:
+	Only the block format is implemented, without the LZ4 frame header or checksums. The caller stores
+	the compressed and uncompressed sizes, as the .iepak table of contents does for each chunk.
+	The compressor is a single pass greedy match finder with a small hash table, fast enough to pack
+	the Content folder and paired with a decompressor that is fast enough to run on every read.
+	Decompress checks every length and offset against both buffers, so corrupt data fails instead
+	of reading or writing out of bounds.
+
+	Example Usage:
+	std::vector<uint8_t> Compressed(Lz4::CompressBound(Size));
+	Compressed.resize(Lz4::Compress(pData, Size, Compressed.data(), Compressed.size()));
+	...
+	Lz4::Decompress(Compressed.data(), Compressed.size(), pOut, Size);
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+namespace Insight {
+
+	namespace Lz4 {
+
+		// Largest size a buffer of SourceSize bytes can compress to.
+		inline size_t CompressBound(size_t SourceSize) { return SourceSize + SourceSize / 255u + 16u; }
+
+		// Compress a buffer. Returns the compressed size, 0 if it did not fit in DestCapacity.
+		INSIGHT_API size_t Compress(const uint8_t* pSource, size_t SourceSize, uint8_t* pDest, size_t DestCapacity);
+		// Decompress a buffer to exactly DestSize bytes. Returns false if the data is corrupt.
+		INSIGHT_API bool Decompress(const uint8_t* pSource, size_t SourceSize, uint8_t* pDest, size_t DestSize);
+
+	} // end namespace Lz4
+}
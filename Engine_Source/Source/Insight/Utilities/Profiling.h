@@ -7,7 +7,7 @@
 #if defined IE_SCOPE_PROFILING_ENABLED
 #define ScopedPerfTimer(Message, OutputType) Insight::Profiling::ScopedTimer Timer(Message, Insight::Profiling::ScopedTimer::eOutputType::##OutputType);
 #else
-	#define ScopedPerfTimer
+	#define ScopedPerfTimer(Message, OutputType)
 #endif
 
 namespace Insight {
@@ -25,12 +25,12 @@ namespace Insight {
 			ScopedTimer(const char* pScopeName, eOutputType outputType = eOutputType::OutputType_Millis)
 				: m_ScopeName(pScopeName), m_OutputType(outputType)
 			{
-				m_Start = std::chrono::high_resolution_clock::now();
+				m_Start = std::chrono::steady_clock::now();
 			}
 
 			~ScopedTimer()
 			{
-				m_End = std::chrono::high_resolution_clock::now();
+				m_End = std::chrono::steady_clock::now();
 				m_Duration = m_End - m_Start;
 
 				float time = 0.0f;
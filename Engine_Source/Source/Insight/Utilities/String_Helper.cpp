@@ -3,6 +3,8 @@
 #include "String_Helper.h"
 #include <locale>
 #include <clocale>
+#include <cctype>
+#include <filesystem>
 namespace Insight {
 
 	std::wstring StringHelper::StringToWide(const std::string& str)
@@ -108,4 +110,13 @@ namespace Insight {
 		return result;
 	}
 
+	std::string StringHelper::NormalizePath(const std::string& Path)
+	{
+		std::string Normalized = std::filesystem::path(Path).lexically_normal().generic_string();
+		// Windows paths are not case sensitive.
+		for (char& Character : Normalized)
+			Character = static_cast<char>(std::tolower(static_cast<unsigned char>(Character)));
+		return Normalized;
+	}
+
 }
@@ -13,5 +13,7 @@ namespace Insight {
 		static std::string GetFilenameFromDirectoryW(const std::wstring & filename);
 		static std::wstring GetFilenameFromDirectoryAsWideW(const std::wstring & filename);
 		std::string GetFilenameFromDirectoryNoExtension(const std::string& filename);
+		// Returns a path in a form that can be compared with other paths, Ex. "C:/Game/Bin/../Content/a.png" becomes "c:/game/content/a.png".
+		static std::string NormalizePath(const std::string& Path);
 	};
 }
\ No newline at end of file
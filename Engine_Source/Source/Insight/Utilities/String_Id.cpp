@@ -0,0 +1,45 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "String_Id.h"
+
+namespace Insight {
+
+	StringInterner StringInterner::s_Instance;
+
+	void StringInterner::Register(uint32_t HashBits, uint64_t Hash, const char* String, size_t Length)
+	{
+		std::unordered_map<uint64_t, std::string>& Strings = m_Strings[HashBits == 64u ? 1 : 0];
+		{
+			std::shared_lock<std::shared_mutex> Lock(m_Mutex);
+			auto Iter = Strings.find(Hash);
+			if (Iter != Strings.end())
+			{
+				if (Iter->second.size() != Length || Iter->second.compare(0, Length, String, Length) != 0)
+					IE_DEBUG_LOG(LogSeverity::Error, "String id collision, \"{0}\" and \"{1}\" share the {2} bit hash {3:x}.", Iter->second, std::string(String, Length), HashBits, Hash);
+				return;
+			}
+		}
+
+		std::unique_lock<std::shared_mutex> Lock(m_Mutex);
+		Strings.emplace(Hash, std::string(String, Length));
+	}
+
+	bool StringInterner::Find(uint32_t HashBits, uint64_t Hash, std::string& OutString) const
+	{
+		const std::unordered_map<uint64_t, std::string>& Strings = m_Strings[HashBits == 64u ? 1 : 0];
+		std::shared_lock<std::shared_mutex> Lock(m_Mutex);
+		auto Iter = Strings.find(Hash);
+		if (Iter == Strings.end())
+			return false;
+		OutString = Iter->second;
+		return true;
+	}
+
+	uint32_t StringInterner::GetNumStrings() const
+	{
+		std::shared_lock<std::shared_mutex> Lock(m_Mutex);
+		return static_cast<uint32_t>(m_Strings[0].size() + m_Strings[1].size());
+	}
+
+}
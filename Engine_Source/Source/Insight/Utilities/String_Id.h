@@ -0,0 +1,184 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - String_Id.h
+	Source - String_Id.cpp
+
+	Purpose:
+	Integer handles for strings that are compared and used as map keys far more often than they are read,
+	Ex. asset paths, actor types and input hints.
+
+	Description:
+	A StringId is the FNV-1a hash of a string, so comparing, hashing and ordering them are integer operations.
+	StringId is 64 bits and is used for open ended sets like asset paths, where two strings sharing a hash
+	must not happen in practice. StringId32 is 32 bits for small closed sets like json keys and input hints.
+	Literals are hashed at compile time, so a StringId built from one can be a case label or a constexpr.
+	StringId::Intern hashes a string at runtime. While IE_STRING_ID_NAMES_ENABLED is defined (Debug builds)
+	interned strings are also recorded in the StringInterner, which reports two strings that share a hash and
+	lets GetString show an id by name in logs and the editor. In other builds nothing is recorded and
+	GetString returns the hash in hex. Ids built from literals are only named if the same string was interned.
+
+	Example Usage:
+	const StringId Type = StringId::Intern(Header.Type);
+	switch (Type.GetHash())
+	{
+	case StringId("PointLight").GetHash(): ...
+	}
+	IE_DEBUG_LOG(LogSeverity::Log, "Unknown actor type {0}", Type.GetString());
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+#include <cstdio>
+#include <functional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace Insight {
+
+	namespace StringHash {
+
+		constexpr uint32_t Fnv1a32(const char* String, size_t Length)
+		{
+			uint32_t Hash = 2166136261u;
+			for (size_t i = 0u; i < Length; ++i)
+			{
+				Hash ^= static_cast<uint32_t>(static_cast<uint8_t>(String[i]));
+				Hash *= 16777619u;
+			}
+			return Hash;
+		}
+
+		constexpr uint64_t Fnv1a64(const char* String, size_t Length)
+		{
+			uint64_t Hash = 14695981039346656037ull;
+			for (size_t i = 0u; i < Length; ++i)
+			{
+				Hash ^= static_cast<uint64_t>(static_cast<uint8_t>(String[i]));
+				Hash *= 1099511628211ull;
+			}
+			return Hash;
+		}
+
+		// Length of a null terminated string. Usable in constant expressions.
+		constexpr size_t Length(const char* String)
+		{
+			size_t Length = 0u;
+			while (String[Length] != '\0')
+				Length++;
+			return Length;
+		}
+
+	}
+
+	/*
+		Records the strings behind interned StringIds. Only used while IE_STRING_ID_NAMES_ENABLED is defined.
+		Thread safe, lookups share a read lock and only strings seen for the first time take the write lock.
+	*/
+	class INSIGHT_API StringInterner
+	{
+	public:
+		StringInterner() = default;
+		~StringInterner() = default;
+
+		static StringInterner& Get() { return s_Instance; }
+
+		// Record the string behind a hash. Logs an error if a different string was recorded with the same hash.
+		void Register(uint32_t HashBits, uint64_t Hash, const char* String, size_t Length);
+		// Returns false if no string was recorded with the hash.
+		bool Find(uint32_t HashBits, uint64_t Hash, std::string& OutString) const;
+
+		uint32_t GetNumStrings() const;
+
+	private:
+		mutable std::shared_mutex m_Mutex;
+		// 32 and 64 bit hashes are kept apart, they are different hashes of the same strings.
+		std::unordered_map<uint64_t, std::string> m_Strings[2];
+
+		static StringInterner s_Instance;
+	};
+
+	template <typename HashType>
+	class TStringId
+	{
+	public:
+		constexpr TStringId() = default;
+		// Hashes a literal at compile time. Stops at the first null, so fixed size char buffers hash like their string.
+		template <size_t N>
+		constexpr TStringId(const char (&String)[N])
+			: m_Hash(HashString(String, BufferLength(String, N))) {}
+
+		static TStringId Intern(const char* String, size_t Length)
+		{
+			TStringId Id;
+			Id.m_Hash = HashString(String, Length);
+#if defined (IE_STRING_ID_NAMES_ENABLED)
+			StringInterner::Get().Register(sizeof(HashType) * 8u, Id.m_Hash, String, Length);
+#endif
+			return Id;
+		}
+		static inline TStringId Intern(const std::string& String) { return Intern(String.data(), String.size()); }
+		static inline TStringId Intern(const char* String) { return Intern(String, StringHash::Length(String)); }
+
+		// An id from a hash saved earlier with GetHash.
+		static constexpr TStringId FromHash(HashType Hash) { TStringId Id; Id.m_Hash = Hash; return Id; }
+
+		static constexpr HashType HashString(const char* String, size_t Length)
+		{
+			if constexpr (sizeof(HashType) == sizeof(uint32_t))
+				return StringHash::Fnv1a32(String, Length);
+			else
+				return StringHash::Fnv1a64(String, Length);
+		}
+
+		constexpr HashType GetHash() const { return m_Hash; }
+		// The default id is the only invalid one, the empty string hashes to the FNV offset basis.
+		constexpr bool IsValid() const { return m_Hash != 0u; }
+
+		// The interned string, or the hash in hex if the string was not recorded.
+		std::string GetString() const
+		{
+#if defined (IE_STRING_ID_NAMES_ENABLED)
+			std::string String;
+			if (StringInterner::Get().Find(sizeof(HashType) * 8u, m_Hash, String))
+				return String;
+#endif
+			char Hex[sizeof(HashType) * 2u + 2u];
+			snprintf(Hex, sizeof(Hex), "#%0*llx", static_cast<int>(sizeof(HashType) * 2u), static_cast<unsigned long long>(m_Hash));
+			return Hex;
+		}
+
+		constexpr bool operator == (const TStringId& Other) const { return m_Hash == Other.m_Hash; }
+		constexpr bool operator != (const TStringId& Other) const { return m_Hash != Other.m_Hash; }
+		// Orders by hash, not alphabetically.
+		constexpr bool operator < (const TStringId& Other) const { return m_Hash < Other.m_Hash; }
+
+	private:
+		static constexpr size_t BufferLength(const char* String, size_t Size)
+		{
+			size_t Length = 0u;
+			while (Length + 1u < Size && String[Length] != '\0')
+				Length++;
+			return Length;
+		}
+
+	private:
+		HashType m_Hash = 0u;
+	};
+
+	typedef TStringId<uint64_t> StringId;
+	typedef TStringId<uint32_t> StringId32;
+
+}
+
+namespace std {
+
+	template <typename HashType>
+	struct hash<Insight::TStringId<HashType>>
+	{
+		// The id already is a hash.
+		size_t operator () (const Insight::TStringId<HashType>& Id) const { return static_cast<size_t>(Id.GetHash()); }
+	};
+
+}
@@ -0,0 +1,114 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Xxh64.h"
+
+namespace Insight {
+
+	namespace Xxh64 {
+
+		namespace {
+
+			constexpr uint64_t Prime1 = 0x9E3779B185EBCA87ull;
+			constexpr uint64_t Prime2 = 0xC2B2AE3D27D4EB4Full;
+			constexpr uint64_t Prime3 = 0x165667B19E3779F9ull;
+			constexpr uint64_t Prime4 = 0x85EBCA77C2B2AE63ull;
+			constexpr uint64_t Prime5 = 0x27D4EB2F165667C5ull;
+
+			inline uint64_t RotateLeft(uint64_t Value, uint32_t Bits)
+			{
+				return (Value << Bits) | (Value >> (64u - Bits));
+			}
+
+			inline uint64_t Read64(const uint8_t* pData)
+			{
+				uint64_t Value;
+				memcpy(&Value, pData, sizeof(Value));
+				return Value;
+			}
+
+			inline uint32_t Read32(const uint8_t* pData)
+			{
+				uint32_t Value;
+				memcpy(&Value, pData, sizeof(Value));
+				return Value;
+			}
+
+			inline uint64_t Round(uint64_t Accumulator, uint64_t Input)
+			{
+				Accumulator += Input * Prime2;
+				Accumulator = RotateLeft(Accumulator, 31u);
+				return Accumulator * Prime1;
+			}
+
+			inline uint64_t MergeRound(uint64_t Accumulator, uint64_t Lane)
+			{
+				Accumulator ^= Round(0u, Lane);
+				return Accumulator * Prime1 + Prime4;
+			}
+
+		}
+
+		uint64_t Hash(const void* pData, size_t Size, uint64_t Seed)
+		{
+			const uint8_t* pIn = static_cast<const uint8_t*>(pData);
+			const uint8_t* const pEnd = pIn + Size;
+			uint64_t Result;
+
+			if (Size >= 32u)
+			{
+				uint64_t Lane1 = Seed + Prime1 + Prime2;
+				uint64_t Lane2 = Seed + Prime2;
+				uint64_t Lane3 = Seed;
+				uint64_t Lane4 = Seed - Prime1;
+
+				const uint8_t* const pStripesEnd = pEnd - 32u;
+				do
+				{
+					Lane1 = Round(Lane1, Read64(pIn));
+					Lane2 = Round(Lane2, Read64(pIn + 8u));
+					Lane3 = Round(Lane3, Read64(pIn + 16u));
+					Lane4 = Round(Lane4, Read64(pIn + 24u));
+					pIn += 32u;
+				} while (pIn <= pStripesEnd);
+
+				Result = RotateLeft(Lane1, 1u) + RotateLeft(Lane2, 7u) + RotateLeft(Lane3, 12u) + RotateLeft(Lane4, 18u);
+				Result = MergeRound(Result, Lane1);
+				Result = MergeRound(Result, Lane2);
+				Result = MergeRound(Result, Lane3);
+				Result = MergeRound(Result, Lane4);
+			}
+			else
+			{
+				Result = Seed + Prime5;
+			}
+			Result += static_cast<uint64_t>(Size);
+
+			// The last 0 to 31 bytes.
+			for (; pIn + 8u <= pEnd; pIn += 8u)
+			{
+				Result ^= Round(0u, Read64(pIn));
+				Result = RotateLeft(Result, 27u) * Prime1 + Prime4;
+			}
+			if (pIn + 4u <= pEnd)
+			{
+				Result ^= static_cast<uint64_t>(Read32(pIn)) * Prime1;
+				Result = RotateLeft(Result, 23u) * Prime2 + Prime3;
+				pIn += 4u;
+			}
+			for (; pIn < pEnd; ++pIn)
+			{
+				Result ^= static_cast<uint64_t>(*pIn) * Prime5;
+				Result = RotateLeft(Result, 11u) * Prime1;
+			}
+
+			Result ^= Result >> 33u;
+			Result *= Prime2;
+			Result ^= Result >> 29u;
+			Result *= Prime3;
+			Result ^= Result >> 32u;
+			return Result;
+		}
+
+	} // end namespace Xxh64
+}
@@ -0,0 +1,35 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Xxh64.h
+	Source - Xxh64.cpp
+
+	Purpose:
+	Hashes file contents with the 64 bit xxHash algorithm.
+
+	Description:
+	Used to tell whether an asset's bytes changed since it was last cooked, where FNV-1a (used for
+	short keys like paths and member names) would be too slow on large files. Four lanes are mixed
+	independently over 32 byte stripes, so the hash runs at memory speed. Not cryptographic, equal
+	hashes are trusted to mean equal contents. Matches the reference XXH64 for the same seed.
+
+	Example Usage:
+	const uint64_t Hash = Xxh64::Hash(View.GetData(), View.GetSize());
+*/
+#pragma once
+
+#include <Insight/Core.h>
+
+namespace Insight {
+
+	namespace Xxh64 {
+
+		INSIGHT_API uint64_t Hash(const void* pData, size_t Size, uint64_t Seed = 0u);
+
+		// Mix a value into a running hash, Ex. to combine the hashes of several files into one.
+		inline uint64_t Combine(uint64_t Hash, uint64_t Value)
+		{
+			return Hash ^ (Value + 0x9E3779B97F4A7C15ull + (Hash << 6u) + (Hash >> 2u));
+		}
+
+	} // end namespace Xxh64
+}
@@ -45,6 +45,8 @@ namespace Insight {
 		virtual void ExecuteDraw_Impl() override;
 		// Swap buffers with the new frame.
 		virtual void SwapBuffers_Impl() override;
+		// D3D11 keeps resources alive until the GPU is done with them, nothing to wait for.
+		virtual void WaitForGPU_Impl() override {}
 		// Resize render target, depth stencil and sreen rects when window size is changed.
 		virtual void OnWindowResize_Impl() override;
 		// Tells the swapchain to enable full screen rendering.
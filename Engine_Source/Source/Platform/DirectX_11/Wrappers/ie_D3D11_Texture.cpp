@@ -66,13 +66,15 @@ namespace Insight {
 
 	void ieD3D11Texture::InitDDSTexture()
 	{
-		HRESULT hr = DirectX::CreateDDSTextureFromFile(m_pDevice.Get(), m_pDeviceContext.Get(), m_TextureInfo.Filepath.c_str(), nullptr, m_pTextureView.GetAddressOf());
+		const FileView TextureFile = m_TextureInfo.SourceFile ? TakeSourceFile() : FileSystem::ReadFile(StringHelper::WideToString(m_TextureInfo.Filepath));
+		HRESULT hr = TextureFile ? DirectX::CreateDDSTextureFromMemory(m_pDevice.Get(), m_pDeviceContext.Get(), TextureFile.GetData(), TextureFile.GetSize(), nullptr, m_pTextureView.GetAddressOf()) : E_FAIL;
 		ThrowIfFailed(hr, "Failed to load D3D 11 DDS texture from file.");
 	}
 
 	void ieD3D11Texture::InitTextureFromFile()
 	{
-		HRESULT hr = DirectX::CreateWICTextureFromFile(m_pDevice.Get(), m_TextureInfo.Filepath.c_str(), nullptr, m_pTextureView.GetAddressOf());
+		const FileView TextureFile = m_TextureInfo.SourceFile ? TakeSourceFile() : FileSystem::ReadFile(StringHelper::WideToString(m_TextureInfo.Filepath));
+		HRESULT hr = TextureFile ? DirectX::CreateWICTextureFromMemory(m_pDevice.Get(), TextureFile.GetData(), TextureFile.GetSize(), nullptr, m_pTextureView.GetAddressOf()) : E_FAIL;
 		ThrowIfFailed(hr, "Failed to load D3D 11 WIC texture from file.");
 	}
 
@@ -138,7 +138,12 @@ namespace Insight {
 
 	void Direct3D12Context::OnUpdate_Impl(const float DeltaMs)
 	{
-		RETURN_IF_WINDOW_NOT_VISIBLE;
+		if (!m_WindowVisible || !m_WindowResizeComplete)
+		{
+			m_SkippedFrames = true;
+			return;
+		}
+		ResyncTransformsAfterSkippedFrames();
 
 		static float WorldSecond = 0.0f;
 		WorldSecond += DeltaMs;
@@ -190,6 +195,34 @@ namespace Insight {
 		}
 	}
 
+	void Direct3D12Context::ResyncTransformsAfterSkippedFrames()
+	{
+		if (!m_SkippedFrames)
+			return;
+		m_SkippedFrames = false;
+
+		GeometryManager::MarkLayoutDirty();
+
+		if (m_GraphicsSettings.RayTraceEnabled)
+		{
+			RayTraceHelpers* pRTHelper = m_RayTracedShadowPass.GetRTHelper();
+			auto ResyncInstances = [pRTHelper](const GeometryManager::SceneModels& Models)
+			{
+				for (const StrongModelPtr& pModel : Models)
+				{
+					for (uint32_t i = 0; i < pModel->GetNumChildMeshes(); ++i)
+					{
+						const std::unique_ptr<Mesh>& pMesh = pModel->GetMeshAtIndex(i);
+						pRTHelper->SetInstanceWorldMatrix(pMesh->GetRTInstanceIndex(), pMesh->GetConstantBuffer().World);
+					}
+				}
+			};
+			ResyncInstances(*GeometryManager::Get().GetSceneModels());
+			ResyncInstances(*GeometryManager::Get().GetTranslucentSceneModels());
+			pRTHelper->RequestRebuild();
+		}
+	}
+
 	void Direct3D12Context::OnPreFrameRender_Impl()
 	{
 		RETURN_IF_WINDOW_NOT_VISIBLE;
@@ -251,7 +284,12 @@ namespace Insight {
 
 	void Direct3D12Context::OnRender_Impl()
 	{
-		RETURN_IF_WINDOW_NOT_VISIBLE;
+		if (!m_WindowVisible || !m_WindowResizeComplete)
+		{
+			m_SkippedFrames = true;
+			return;
+		}
+		ResyncTransformsAfterSkippedFrames();
 
 		// Gather the geometry in the world and send it to the GPU.
 		GeometryManager::GatherGeometry();
@@ -549,9 +587,14 @@ namespace Insight {
 
 
 
-	uint32_t Direct3D12Context::RegisterGeometryWithRTAccelerationStucture(ComPtr<ID3D12Resource> pVertexBuffer, ComPtr<ID3D12Resource> pIndexBuffer, uint32_t NumVerticies, uint32_t NumIndices, DirectX::XMMATRIX MeshWorldMat)
+	uint32_t Direct3D12Context::RegisterGeometryWithRTAccelerationStucture(ComPtr<ID3D12Resource> pVertexBuffer, ComPtr<ID3D12Resource> pIndexBuffer, uint32_t NumVerticies, uint32_t NumIndices, DirectX::XMMATRIX MeshWorldMat, TransformJournal::TransformId TransformId)
+	{
+		return m_RayTracedShadowPass.GetRTHelper()->RegisterBottomLevelASGeometry(pVertexBuffer, pIndexBuffer, NumVerticies, NumIndices, MeshWorldMat, TransformId);
+	}
+
+	void Direct3D12Context::UnregisterGeometryWithRTAccelerationStucture(uint32_t InstanceIndex)
 	{
-		return m_RayTracedShadowPass.GetRTHelper()->RegisterBottomLevelASGeometry(pVertexBuffer, pIndexBuffer, NumVerticies, NumIndices, MeshWorldMat);
+		m_RayTracedShadowPass.GetRTHelper()->UnregisterBottomLevelASGeometry(InstanceIndex);
 	}
 
 	void Direct3D12Context::CreateSwapChainRTVDescriptorHeap()
@@ -128,6 +128,7 @@ namespace Insight {
 		virtual void OnEditorRender_Impl() override;
 		virtual void ExecuteDraw_Impl() override;
 		virtual void SwapBuffers_Impl() override;
+		virtual void WaitForGPU_Impl() override { m_DeviceResources.WaitForGPU(); }
 		virtual void OnWindowResize_Impl() override;
 		virtual void OnWindowFullScreen_Impl() override;
 		virtual void OnShaderReload_Impl() override;
@@ -167,8 +168,10 @@ namespace Insight {
 		// Ray Tracing
 		// -----------
 		ID3D12Resource* GetRayTracingSRV() const { return m_RayTraceOutput_SRV.Get(); }
-		[[nodiscard]] uint32_t RegisterGeometryWithRTAccelerationStucture(Microsoft::WRL::ComPtr<ID3D12Resource> pVertexBuffer, Microsoft::WRL::ComPtr<ID3D12Resource> pIndexBuffer, uint32_t NumVerticies, uint32_t NumIndices, DirectX::XMMATRIX MeshWorldMat);
-		void UpdateRTAccelerationStructureMatrix(uint32_t InstanceArrIndex, DirectX::XMMATRIX NewWorldMat) { m_RayTracedShadowPass.GetRTHelper()->UpdateInstanceTransformByIndex(InstanceArrIndex, NewWorldMat); }
+		// The instance follows the changes recorded for TransformId in the TransformJournal.
+		[[nodiscard]] uint32_t RegisterGeometryWithRTAccelerationStucture(Microsoft::WRL::ComPtr<ID3D12Resource> pVertexBuffer, Microsoft::WRL::ComPtr<ID3D12Resource> pIndexBuffer, uint32_t NumVerticies, uint32_t NumIndices, DirectX::XMMATRIX MeshWorldMat, TransformJournal::TransformId TransformId);
+		// Remove an instance added with RegisterGeometryWithRTAccelerationStucture. Safe to call from any thread.
+		void UnregisterGeometryWithRTAccelerationStucture(uint32_t InstanceIndex);
 
 
 		ID3D12Resource* GetSwapChainRenderTarget() const { return m_pSwapChainRenderTargets[IE_D3D12_FrameIndex].Get(); }
@@ -194,6 +197,9 @@ namespace Insight {
 
 		// Per-Frame
 		
+		// Re-upload every mesh and rebuild the ray tracing instances from the current world matrices if frames were skipped.
+		void ResyncTransformsAfterSkippedFrames();
+		
 		void BindShadowPass();
 		void BindTransparencyPass();
 		void DrawDebugScreenQuad();
@@ -262,6 +268,8 @@ namespace Insight {
 
 		bool				m_WindowResizeComplete = true;
 		bool				m_UseWarpDevice = false;
+		// The TransformJournal keeps publishing while the window is hidden or resizing, nothing reads the changes of those frames.
+		bool				m_SkippedFrames = false;
 
 		// D3D 12 Usings
 
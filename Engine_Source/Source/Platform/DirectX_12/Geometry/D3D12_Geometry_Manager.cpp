@@ -5,6 +5,7 @@
 #include "Platform/DirectX_12/Direct3D12_Context.h"
 
 #include "Insight/Rendering/Material.h"
+#include "Insight/Rendering/Geometry/Transform_Journal.h"
 
 namespace Insight {
 
@@ -116,41 +117,60 @@ namespace Insight {
 
 	void D3D12GeometryManager::GatherGeometry_Impl()
 	{
+		// Meshes only change slots when models are added, removed or hidden, upload every mesh then.
+		const bool LayoutChanged = m_IsLayoutDirty.exchange(false);
+		if (LayoutChanged)
+			m_CBSlotOfTransform.assign(TransformJournal::Get().GetIdCapacity(), InvalidCBSlot);
 
-		for (UINT32 i = 0; i < m_OpaqueModels.size(); i++) {
-
-			if (m_OpaqueModels[i]->GetCanBeRendered()) {
+		UploadConstantBuffers(m_OpaqueModels, LayoutChanged);
+		UploadConstantBuffers(m_TranslucentModels, LayoutChanged);
+		m_GPUAddressUploadOffset = 0u;
 
-				for (UINT32 j = 0; j < m_OpaqueModels[i]->GetNumChildMeshes(); j++) {
+		if (LayoutChanged)
+			return;
 
-					const CB_PS_VS_PerObjectMaterialAdditives cbMatOverrides = m_OpaqueModels[i]->GetMaterialRef().GetMaterialOverrideConstantBuffer();
-					memcpy(m_CbvMaterialGPUAddress + (ConstantBufferPerObjectMaterialAlignedSize * m_GPUAddressUploadOffset), &cbMatOverrides, sizeof(cbMatOverrides));
+		// Every mesh kept its slot, only write the world matrices of the ones that moved.
+		const TransformJournal& Journal = TransformJournal::Get();
+		const TransformJournal::TransformId* pChangedIds = Journal.GetChangedIds();
+		const ieMatrix4x4* pChangedWorldMatrices = Journal.GetChangedWorldMatrices();
+		for (uint32_t i = 0; i < Journal.GetNumChanged(); ++i) {
 
-					const CB_VS_PerObject cbPerObject = m_OpaqueModels[i]->GetMeshAtIndex(j)->GetConstantBuffer();
-					memcpy(m_CbvPerObjectGPUAddress + (ConstantBufferPerObjectAlignedSize * m_GPUAddressUploadOffset), &cbPerObject, sizeof(cbPerObject));
+			const TransformJournal::TransformId Id = pChangedIds[i];
+			if (Id >= m_CBSlotOfTransform.size() || m_CBSlotOfTransform[Id] == InvalidCBSlot)
+				continue;
 
-					m_GPUAddressUploadOffset++;
-				}
-			}
+			CB_VS_PerObject cbPerObject;
+			cbPerObject.World = pChangedWorldMatrices[i];
+			memcpy(m_CbvPerObjectGPUAddress + (ConstantBufferPerObjectAlignedSize * m_CBSlotOfTransform[Id]), &cbPerObject, sizeof(cbPerObject));
 		}
+	}
 
-		for (UINT32 i = 0; i < m_TranslucentModels.size(); i++) {
+	void D3D12GeometryManager::UploadConstantBuffers(const SceneModels& Models, bool UploadTransforms)
+	{
+		for (UINT32 i = 0; i < Models.size(); i++) {
 
-			if (m_TranslucentModels[i]->GetCanBeRendered()) {
+			if (Models[i]->GetCanBeRendered()) {
 
-				for (UINT32 j = 0; j < m_TranslucentModels[i]->GetNumChildMeshes(); j++) {
+				for (UINT32 j = 0; j < Models[i]->GetNumChildMeshes(); j++) {
 
-					const CB_PS_VS_PerObjectMaterialAdditives cbMatOverrides = m_TranslucentModels[i]->GetMaterialRef().GetMaterialOverrideConstantBuffer();
+					// Material overrides are edited in place without notice, they are always uploaded.
+					const CB_PS_VS_PerObjectMaterialAdditives cbMatOverrides = Models[i]->GetMaterialRef().GetMaterialOverrideConstantBuffer();
 					memcpy(m_CbvMaterialGPUAddress + (ConstantBufferPerObjectMaterialAlignedSize * m_GPUAddressUploadOffset), &cbMatOverrides, sizeof(cbMatOverrides));
 
-					const CB_VS_PerObject cbPerObject = m_TranslucentModels[i]->GetMeshAtIndex(j)->GetConstantBuffer();
-					memcpy(m_CbvPerObjectGPUAddress + (ConstantBufferPerObjectAlignedSize * m_GPUAddressUploadOffset), &cbPerObject, sizeof(cbPerObject));
+					if (UploadTransforms) {
+						const std::unique_ptr<Mesh>& pMesh = Models[i]->GetMeshAtIndex(j);
+						const CB_VS_PerObject cbPerObject = pMesh->GetConstantBuffer();
+						memcpy(m_CbvPerObjectGPUAddress + (ConstantBufferPerObjectAlignedSize * m_GPUAddressUploadOffset), &cbPerObject, sizeof(cbPerObject));
+
+						const TransformJournal::TransformId Id = pMesh->GetTransformId();
+						if (Id < m_CBSlotOfTransform.size())
+							m_CBSlotOfTransform[Id] = m_GPUAddressUploadOffset;
+					}
 
 					m_GPUAddressUploadOffset++;
 				}
 			}
 		}
-		m_GPUAddressUploadOffset = 0u;
 	}
 
 }
@@ -23,6 +23,9 @@ namespace Insight {
 	private:
 		D3D12GeometryManager() = default;
 		virtual ~D3D12GeometryManager();
+
+		// Write the material and, if UploadTransforms, the per-object constant buffers of every visible mesh at the next free slots.
+		void UploadConstantBuffers(const SceneModels& Models, bool UploadTransforms);
 	private:
 		D3D12_GPU_VIRTUAL_ADDRESS m_CbvUploadHeapHandle;
 		D3D12_GPU_VIRTUAL_ADDRESS m_CbvMaterialHeapHandle;
@@ -40,6 +43,9 @@ namespace Insight {
 		int ConstantBufferPerObjectMaterialAlignedSize = (sizeof(CB_PS_VS_PerObjectMaterialAdditives) + 255) & ~255;
 		UINT32 m_PerObjectCBDrawOffset = 0u;
 		UINT32 m_GPUAddressUploadOffset = 0u;
+		// Per-object constant buffer slot of each TransformId, so moved meshes are uploaded without gathering the scene.
+		std::vector<UINT32> m_CBSlotOfTransform;
+		static constexpr UINT32 InvalidCBSlot = ~0u;
 
 		std::vector<D3D12VertexBuffer> m_Vertexbuffers;
 		std::vector<D3D12IndexBuffer> m_Indexbuffers;
@@ -89,6 +89,32 @@ namespace Insight {
 		ID3D12Resource* ShadowDepthResources[] = { m_pOutputBuffer_UAV.Get() };
 		m_pRenderContextRef->ResourceBarrier(m_pCommandListRef.Get(), ShadowDepthResources, D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
 
+		// Follow the instances that moved since the last frame.
+		const TransformJournal& Journal = TransformJournal::Get();
+		const TransformJournal::TransformId* pChangedIds = Journal.GetChangedIds();
+		const ieMatrix4x4* pChangedWorldMatrices = Journal.GetChangedWorldMatrices();
+		bool InstancesMoved = false;
+		for (uint32_t i = 0; i < Journal.GetNumChanged(); ++i)
+		{
+			const TransformJournal::TransformId Id = pChangedIds[i];
+			if (Id >= m_InstanceOfTransform.size() || m_InstanceOfTransform[Id] == InvalidInstance)
+				continue;
+
+			m_Instances[m_InstanceOfTransform[Id]].second = pChangedWorldMatrices[i];
+			InstancesMoved = true;
+		}
+
+		bool HasPendingRemovals = false;
+		{
+			std::lock_guard<std::mutex> Lock(m_PendingRemovalsMutex);
+			HasPendingRemovals = !m_PendingRemovals.empty();
+		}
+		// A refit cannot add or remove instances. The rebuild also replaces the shader table, so it is done before the dispatch is described.
+		if (m_RebuildPending || HasPendingRemovals)
+			RebuildAccelerationStructures();
+		else if (InstancesMoved)
+			CreateTopLevelAS(m_Instances, true);
+
 		m_DispatchRaysDesc = {};
 		uint32_t RayGenerationSectionSizeInBytes = m_sbtHelper.GetRayGenSectionSize();
 		m_DispatchRaysDesc.RayGenerationShaderRecord.StartAddress = m_sbtStorage->GetGPUVirtualAddress();
@@ -109,9 +135,6 @@ namespace Insight {
 		m_DispatchRaysDesc.Depth = 1;
 
 		m_pCommandListRef->SetPipelineState1(m_rtStateObject.Get());
-
-		// Update the AS with new vertex transform data
-		CreateTopLevelAS(m_Instances, true);
 	}
 
 	void RayTraceHelpers::TraceScene()
@@ -122,15 +145,108 @@ namespace Insight {
 		m_pRenderContextRef->ResourceBarrier(m_pCommandListRef.Get(), ShadowDepthResources, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE);
 	}
 
-	uint32_t RayTraceHelpers::RegisterBottomLevelASGeometry(ComPtr<ID3D12Resource> pVertexBuffer, ComPtr<ID3D12Resource> pIndexBuffer, uint32_t NumVeticies, uint32_t NumIndices, XMMATRIX WorldMat)
+	uint32_t RayTraceHelpers::RegisterBottomLevelASGeometry(ComPtr<ID3D12Resource> pVertexBuffer, ComPtr<ID3D12Resource> pIndexBuffer, uint32_t NumVeticies, uint32_t NumIndices, XMMATRIX WorldMat, TransformJournal::TransformId TransformId)
+	{
+		uint32_t Instance = InvalidInstance;
+		if (!m_FreeInstances.empty())
+		{
+			Instance = m_FreeInstances.back();
+			m_FreeInstances.pop_back();
+			m_ASVertexBuffers[Instance] = std::make_pair(pVertexBuffer, NumVeticies);
+			m_ASIndexBuffers[Instance] = std::make_pair(pIndexBuffer, NumIndices);
+			m_Instances[Instance] = std::make_pair(nullptr, WorldMat);
+			m_TransformOfInstance[Instance] = TransformId;
+		}
+		else
+		{
+			Instance = static_cast<uint32_t>(m_Instances.size());
+			m_ASVertexBuffers.push_back(std::make_pair(pVertexBuffer, NumVeticies));
+			m_ASIndexBuffers.push_back(std::make_pair(pIndexBuffer, NumIndices));
+			m_Instances.push_back(std::make_pair(nullptr, WorldMat));
+			m_TransformOfInstance.push_back(TransformId);
+		}
+
+		// Once the acceleration structure exists the command list may be closed, the rebuild builds the geometry when recording the next trace.
+		if (m_TopLevelASBuffers.pResult)
+		{
+			m_RebuildPending = true;
+		}
+		else
+		{
+			AccelerationStructureBuffers BottomLevelBuffers = CreateBottomLevelAS({ {pVertexBuffer.Get(), NumVeticies} }, { {pIndexBuffer.Get(), NumIndices} });
+			m_Instances[Instance].first = BottomLevelBuffers.pResult;
+			m_AccelerationStructureBuffers.push_back(std::move(BottomLevelBuffers));
+		}
+
+		if (TransformId != TransformJournal::InvalidId)
+		{
+			if (TransformId >= m_InstanceOfTransform.size())
+				m_InstanceOfTransform.resize(TransformId + 1u, InvalidInstance);
+			m_InstanceOfTransform[TransformId] = Instance;
+		}
+		return Instance;
+	}
+
+	void RayTraceHelpers::UnregisterBottomLevelASGeometry(uint32_t InstanceIndex)
+	{
+		if (InstanceIndex == InvalidInstance)
+			return;
+		std::lock_guard<std::mutex> Lock(m_PendingRemovalsMutex);
+		m_PendingRemovals.push_back(InstanceIndex);
+	}
+
+	void RayTraceHelpers::SetInstanceWorldMatrix(uint32_t InstanceIndex, const XMMATRIX& WorldMat)
+	{
+		if (InstanceIndex >= m_Instances.size())
+			return;
+		m_Instances[InstanceIndex].second = WorldMat;
+	}
+
+	void RayTraceHelpers::RebuildAccelerationStructures()
 	{
-		m_ASVertexBuffers.push_back(std::make_pair(pVertexBuffer, NumVeticies));
-		m_ASIndexBuffers.push_back(std::make_pair(pIndexBuffer, NumIndices));
+		// Frames in flight may still trace against the structures, geometry and shader table being replaced.
+		m_pRenderContextRef->GetDeviceResources().WaitForGPU();
+		m_AccelerationStructureBuffers.clear();
+
+		std::vector<uint32_t> Removals;
+		{
+			std::lock_guard<std::mutex> Lock(m_PendingRemovalsMutex);
+			Removals.swap(m_PendingRemovals);
+		}
+		for (const uint32_t Instance : Removals)
+		{
+			if (Instance >= m_Instances.size() || !m_ASVertexBuffers[Instance].first)
+				continue;
+
+			// The transform id may already follow an instance registered since.
+			const TransformJournal::TransformId TransformId = m_TransformOfInstance[Instance];
+			if (TransformId < m_InstanceOfTransform.size() && m_InstanceOfTransform[TransformId] == Instance)
+				m_InstanceOfTransform[TransformId] = InvalidInstance;
+
+			m_TransformOfInstance[Instance] = TransformJournal::InvalidId;
+			m_Instances[Instance].first.Reset();
+			m_ASVertexBuffers[Instance] = std::make_pair(nullptr, 0u);
+			m_ASIndexBuffers[Instance] = std::make_pair(nullptr, 0u);
+			m_FreeInstances.push_back(Instance);
+		}
+
+		for (size_t i = 0; i < m_Instances.size(); ++i)
+		{
+			if (m_Instances[i].first || !m_ASVertexBuffers[i].first)
+				continue;
 
-		AccelerationStructureBuffers BottomLevelBuffers = CreateBottomLevelAS({ {pVertexBuffer.Get(), NumVeticies} }, { {pIndexBuffer.Get(), NumIndices} });
+			AccelerationStructureBuffers BottomLevelBuffers = CreateBottomLevelAS({ m_ASVertexBuffers[i] }, { m_ASIndexBuffers[i] });
+			m_Instances[i].first = BottomLevelBuffers.pResult;
+			m_AccelerationStructureBuffers.push_back(std::move(BottomLevelBuffers));
+		}
 
-		m_Instances.push_back(std::make_pair(BottomLevelBuffers.pResult, WorldMat));
-		return m_NextAvailabledInstanceArrIndex++;
+		// The generator keeps every instance it was given, start from an empty one.
+		m_TopLevelASGenerator = NvidiaHelpers::TopLevelASGenerator();
+		CreateTopLevelAS(m_Instances);
+		CreateTopLevelASView();
+		CreateShaderBindingTable();
+
+		m_RebuildPending = false;
 	}
 
 	RayTraceHelpers::AccelerationStructureBuffers RayTraceHelpers::CreateBottomLevelAS(std::vector<std::pair<ComPtr<ID3D12Resource>, uint32_t>> VertexBuffers, std::vector<std::pair<ComPtr<ID3D12Resource>, uint32_t>> IndexBuffers)
@@ -182,6 +298,10 @@ namespace Insight {
 
 			for (size_t i = 0; i < instances.size(); i++) 
 			{
+				// Removed instance.
+				if (!instances[i].first)
+					continue;
+
 				m_TopLevelASGenerator.AddInstance(instances[i].first.Get(), instances[i].second, static_cast<UINT>(i), static_cast<UINT>(2 * i));
 			}
 
@@ -360,10 +480,13 @@ namespace Insight {
 
 		for (uint32_t i = 0; i < m_ASVertexBuffers.size(); ++i) {
 
+			// Removed instances keep an empty record so the hit groups of the others do not move.
+			const D3D12_GPU_VIRTUAL_ADDRESS VertexBufferAddress = m_ASVertexBuffers[i].first ? m_ASVertexBuffers[i].first->GetGPUVirtualAddress() : 0u;
+			const D3D12_GPU_VIRTUAL_ADDRESS IndexBufferAddress = m_ASIndexBuffers[i].first ? m_ASIndexBuffers[i].first->GetGPUVirtualAddress() : 0u;
 			m_sbtHelper.AddHitGroup(L"HitGroup",
 				{
-					(void*)m_ASVertexBuffers[i].first->GetGPUVirtualAddress(),
-					(void*)m_ASIndexBuffers[i].first->GetGPUVirtualAddress(),
+					(void*)VertexBufferAddress,
+					(void*)IndexBufferAddress,
 					(void*)HeapPointer
 				}
 			);
@@ -394,12 +517,7 @@ namespace Insight {
 		
 
 		// Top-Level Accereration Structure
-		D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc;
-		srvDesc.Format = DXGI_FORMAT_UNKNOWN;
-		srvDesc.ViewDimension = D3D12_SRV_DIMENSION_RAYTRACING_ACCELERATION_STRUCTURE;
-		srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-		srvDesc.RaytracingAccelerationStructure.Location = m_TopLevelASBuffers.pResult->GetGPUVirtualAddress();
-		m_pDeviceRef->CreateShaderResourceView(nullptr, &srvDesc, m_srvUavHeap.hCPU(1));
+		CreateTopLevelASView();
 
 		// Describe and create a constant buffer view for the camera
 		D3D12_CONSTANT_BUFFER_VIEW_DESC cbvCameraDesc = {};
@@ -415,6 +533,16 @@ namespace Insight {
 
 	}
 
+	void RayTraceHelpers::CreateTopLevelASView()
+	{
+		D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc;
+		srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+		srvDesc.ViewDimension = D3D12_SRV_DIMENSION_RAYTRACING_ACCELERATION_STRUCTURE;
+		srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+		srvDesc.RaytracingAccelerationStructure.Location = m_TopLevelASBuffers.pResult->GetGPUVirtualAddress();
+		m_pDeviceRef->CreateShaderResourceView(nullptr, &srvDesc, m_srvUavHeap.hCPU(1));
+	}
+
 	ComPtr<ID3D12RootSignature> RayTraceHelpers::CreateRayGenSignature()
 	{
 		NvidiaHelpers::RootSignatureGenerator rsc;
@@ -5,6 +5,7 @@
 #include "DXR/nv_helpers_dx12/TopLevelASGenerator.h"
 #include "DXR/nv_helpers_dx12/ShaderBindingTableGenerator.h"
 #include "Platform/DirectX_12/Wrappers/Descriptor_Heap_Wrapper.h"
+#include "Insight/Rendering/Geometry/Transform_Journal.h"
 
 
 namespace Insight {
@@ -35,6 +36,9 @@ namespace Insight {
 			DirectX::XMMATRIX InverseView;
 			DirectX::XMMATRIX InverseProjection;
 		};
+	public:
+		static constexpr uint32_t InvalidInstance = ~0u;
+
 	public:
 		RayTraceHelpers() = default;
 		~RayTraceHelpers() = default;
@@ -43,22 +47,28 @@ namespace Insight {
 		void GenerateAccelerationStructure();
 		void Destroy();
 		void UpdateCBVs();
+		// Rebuild the top level acceleration structure if instances were added or removed, otherwise refit it if any of its instances moved. See TransformJournal.
 		void SetCommonPipeline();
 		void TraceScene();
 		inline void ReCreateOutputBuffer() { CreateRTOutputBuffer(); }
 
-		inline void UpdateInstanceTransformByIndex(uint32_t ArrIndex, DirectX::XMMATRIX UpdatedMat) 
-		{
-			m_Instances[ArrIndex].second = UpdatedMat; 
-		}
-
 		inline ID3D12Resource* GetOutputBuffer() { return m_pOutputBuffer_UAV.Get(); }
-		uint32_t RegisterBottomLevelASGeometry(Microsoft::WRL::ComPtr<ID3D12Resource> pVertexBuffer, Microsoft::WRL::ComPtr<ID3D12Resource> pIndexBuffer, uint32_t NumVeticies, uint32_t NumIndices, DirectX::XMMATRIX WorldMat);
+		// Add an instance of the geometry. Once the acceleration structure exists the instance is added by the next rebuild. Render thread only.
+		uint32_t RegisterBottomLevelASGeometry(Microsoft::WRL::ComPtr<ID3D12Resource> pVertexBuffer, Microsoft::WRL::ComPtr<ID3D12Resource> pIndexBuffer, uint32_t NumVeticies, uint32_t NumIndices, DirectX::XMMATRIX WorldMat, TransformJournal::TransformId TransformId);
+		// Remove an instance returned by RegisterBottomLevelASGeometry. Its buffers are kept until the next rebuild, after the GPU is done with them. Safe to call from any thread.
+		void UnregisterBottomLevelASGeometry(uint32_t InstanceIndex);
+		// Overwrite the world matrix of an instance, Ex. after frames whose TransformJournal changes were never applied. Render thread only.
+		void SetInstanceWorldMatrix(uint32_t InstanceIndex, const DirectX::XMMATRIX& WorldMat);
+		// Rebuild the top level acceleration structure on the next SetCommonPipeline rather than refitting it.
+		inline void RequestRebuild() { m_RebuildPending = true; }
 
 	private:
 		AccelerationStructureBuffers CreateBottomLevelAS(std::vector<std::pair<Microsoft::WRL::ComPtr<ID3D12Resource>, uint32_t>> VertexBuffers, std::vector<std::pair<Microsoft::WRL::ComPtr<ID3D12Resource>, uint32_t>> IndexBuffers = {});
 		void CreateTopLevelAS(const std::vector<std::pair<Microsoft::WRL::ComPtr<ID3D12Resource>, DirectX::XMMATRIX>>& instances, bool UpdateOnly = false);
 		void CreateAccelerationStructures();
+		// Apply the pending removals, build the bottom level structures of new instances and rebuild the top level structure and shader table.
+		void RebuildAccelerationStructures();
+		void CreateTopLevelASView();
 
 		void CreateRTPipeline();
 		void CreateRTOutputBuffer();
@@ -71,8 +81,6 @@ namespace Insight {
 		Microsoft::WRL::ComPtr<ID3D12RootSignature> CreateHitSignature();
 
 	private:
-		uint32_t m_NextAvailabledInstanceArrIndex = 0U;
-
 		std::vector< std::pair<Microsoft::WRL::ComPtr<ID3D12Resource>, uint32_t> > m_ASVertexBuffers;
 		std::vector< std::pair<Microsoft::WRL::ComPtr<ID3D12Resource>, uint32_t> > m_ASIndexBuffers;
 
@@ -102,8 +110,19 @@ namespace Insight {
 		NvidiaHelpers::TopLevelASGenerator		m_TopLevelASGenerator;
 		AccelerationStructureBuffers			m_TopLevelASBuffers;
 
+		// Removed instances keep their slot with a null bottom level structure, so the hit group of every other instance stays at 2 * its index.
 		std::vector<std::pair<Microsoft::WRL::ComPtr<ID3D12Resource>, DirectX::XMMATRIX>> m_Instances;
+		// Index in m_Instances of the instance following each TransformId, InvalidInstance if none does.
+		std::vector<uint32_t> m_InstanceOfTransform;
+		// TransformId each instance follows, parallel to m_Instances.
+		std::vector<TransformJournal::TransformId> m_TransformOfInstance;
+		std::vector<uint32_t> m_FreeInstances;
+		// Bottom level structures built since the last rebuild, their scratch buffers must outlive the commands building them.
 		std::vector<AccelerationStructureBuffers> m_AccelerationStructureBuffers;
+		bool m_RebuildPending = false;
+
+		std::mutex m_PendingRemovalsMutex;
+		std::vector<uint32_t> m_PendingRemovals;
 
 		Microsoft::WRL::ComPtr<ID3D12RootSignature> m_RayGenSignature;
 		Microsoft::WRL::ComPtr<ID3D12RootSignature> m_HitSignature;
@@ -70,6 +70,8 @@ namespace Insight {
 		else {
 			InitTextureFromFile(srvHeapHandle);
 		}
+		// Release the read ahead file if the loader read the file itself.
+		TakeSourceFile();
 
 		m_RootParamIndex = GetRootParameterIndexForTextureType(m_TextureInfo.Type);
 		return true;
@@ -85,8 +87,11 @@ namespace Insight {
 		DirectX::ResourceUploadBatch ResourceUpload(pDevice);
 		ResourceUpload.Begin();
 
-		HRESULT hr;
-		hr = DirectX::CreateDDSTextureFromFile(pDevice, ResourceUpload, m_TextureInfo.Filepath.c_str(), &m_pTexture, m_TextureInfo.GenerateMipMaps, 0, nullptr, &m_TextureInfo.IsCubeMap);
+		// Held until the upload has finished.
+		const FileView TextureFile = m_TextureInfo.SourceFile ? TakeSourceFile() : FileSystem::ReadFile(StringHelper::WideToString(m_TextureInfo.Filepath));
+		HRESULT hr = E_FAIL;
+		if (TextureFile)
+			hr = DirectX::CreateDDSTextureFromMemory(pDevice, ResourceUpload, TextureFile.GetData(), TextureFile.GetSize(), &m_pTexture, m_TextureInfo.GenerateMipMaps, 0, nullptr, &m_TextureInfo.IsCubeMap);
 		if (FAILED(hr)) {
 			IE_DEBUG_LOG(LogSeverity::Error, "Failed to load DDS texture from file with path \"{0}\"", StringHelper::WideToString(m_TextureInfo.Filepath));
 		}
@@ -129,8 +134,11 @@ namespace Insight {
 		DirectX::ResourceUploadBatch resourceUpload(pDevice);
 		resourceUpload.Begin();
 
-		HRESULT hr = S_OK;
-		hr = DirectX::CreateWICTextureFromFile(pDevice, resourceUpload, m_TextureInfo.Filepath.c_str(), &m_pTexture, m_TextureInfo.GenerateMipMaps);
+		// Held until the upload has finished.
+		const FileView TextureFile = m_TextureInfo.SourceFile ? TakeSourceFile() : FileSystem::ReadFile(StringHelper::WideToString(m_TextureInfo.Filepath));
+		HRESULT hr = E_FAIL;
+		if (TextureFile)
+			hr = DirectX::CreateWICTextureFromMemory(pDevice, resourceUpload, TextureFile.GetData(), TextureFile.GetSize(), &m_pTexture, m_TextureInfo.GenerateMipMaps);
 
 		if (FAILED(hr)) {
 			IE_DEBUG_LOG(LogSeverity::Error, "Failed to Create WIC texture from file with path \"{0}\"", StringHelper::WideToString(m_TextureInfo.Filepath));
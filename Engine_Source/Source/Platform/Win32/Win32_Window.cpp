@@ -18,6 +18,7 @@
 #include "Insight/Events/Mouse_Event.h"
 #include "Insight/Events/Application_Event.h"
 #include "Insight/Core/ie_Exception.h"
+#include "Insight/Memory/Scratch_Allocator.h"
 
 namespace Insight {
 
@@ -215,10 +216,12 @@ namespace Insight {
 
 			if (DataSize > 0)
 			{
-				std::unique_ptr<BYTE[]> rawdata = std::make_unique<BYTE[]>(DataSize);
-				if (GetRawInputData(reinterpret_cast<HRAWINPUT>(lParam), RID_INPUT, rawdata.get(), &DataSize, sizeof(RAWINPUTHEADER)) == DataSize)
+				// Raw input arrives many times a frame, keep it off of the heap.
+				Memory::ScratchScope Scratch;
+				BYTE* pRawData = static_cast<BYTE*>(Scratch.Allocate(DataSize, alignof(RAWINPUT)));
+				if (GetRawInputData(reinterpret_cast<HRAWINPUT>(lParam), RID_INPUT, pRawData, &DataSize, sizeof(RAWINPUTHEADER)) == DataSize)
 				{
-					RAWINPUT* raw = reinterpret_cast<RAWINPUT*>(rawdata.get());
+					RAWINPUT* raw = reinterpret_cast<RAWINPUT*>(pRawData);
 					if (raw->header.dwType == RIM_TYPEMOUSE)
 					{
 						if (raw->data.mouse.lLastX != 0.0f)
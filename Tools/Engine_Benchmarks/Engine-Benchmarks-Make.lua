@@ -0,0 +1,86 @@
+-- Engine Benchmarks
+-- Micro-benchmarks for engine systems that build without a renderer, so they also run on Linux.
+
+local benchRootDir = "../../"
+local benchEngineDir = benchRootDir .. "Engine_Source/Source/"
+local benchThirdPartyDir = benchRootDir .. "Engine_Source/Third_Party/"
+
+project ("Engine_Benchmarks")
+	location (benchRootDir .. "Tools/Engine_Benchmarks")
+	kind ("ConsoleApp")
+	cppdialect ("C++17")
+	language ("C++")
+	staticruntime ("off")
+	targetname ("Engine_Benchmarks")
+
+	targetdir (benchRootDir .. "Binaries/" .. outputdir .. "/%{prj.name}")
+	objdir (benchRootDir .. "Binaries/Intermediates/" .. outputdir .. "/%{prj.name}")
+
+	files
+	{
+		"Engine-Benchmarks-Make.lua",
+		"Source/**.h",
+		"Source/**.cpp",
+		-- Engine sources under test, compiled directly so the engine library and its graphics dependencies are not needed.
+		benchEngineDir .. "Insight/Math/Batch_Math*",
+		benchEngineDir .. "Insight/Systems/Cpu_Features.*",
+		benchEngineDir .. "Insight/Systems/Json_Stream_Reader.*",
+		benchEngineDir .. "Insight/Systems/Virtual_File_System.*",
+		benchEngineDir .. "Insight/Systems/Async_IO.*",
+		benchEngineDir .. "Insight/Systems/Mapped_File.*",
+		benchEngineDir .. "Insight/Systems/Pak_File.*",
+		benchEngineDir .. "Insight/Utilities/Lz4.*",
+		benchEngineDir .. "Insight/Utilities/Xxh64.*",
+		benchEngineDir .. "Insight/Utilities/String_Helper.*",
+		benchEngineDir .. "Insight/Math/Transform.*",
+		benchEngineDir .. "Insight/Core/Scene/Scene_Node.*",
+		benchEngineDir .. "Insight/Core/Scene/Tick_Manager.*",
+		benchEngineDir .. "Insight/Core/Scene/Actor_Registry.*",
+		benchEngineDir .. "Insight/Runtime/ECS/ECS_World.*",
+		benchEngineDir .. "Insight/Runtime/ECS/Archetype.*",
+		benchEngineDir .. "Insight/Memory/Deferred_Destruction.*",
+		benchEngineDir .. "Insight/Systems/Managers/Texture_Cache.*",
+		benchEngineDir .. "Insight/Input/Input_Dispatcher.*",
+		benchEngineDir .. "Insight/Input/Input_Recorder.*",
+		benchEngineDir .. "Insight/Events/Event_Bus.*",
+		benchEngineDir .. "Insight/Rendering/Geometry/Mesh_Importer.*",
+		benchThirdPartyDir .. "rapidjson/include/rapidjson/json.cpp",
+	}
+
+	includedirs
+	{
+		-- Must come first, provides the stand in Engine_pch.h.
+		"Source/",
+		benchEngineDir,
+		benchThirdPartyDir .. "rapidjson/include/",
+		benchThirdPartyDir .. "spdlog/include/",
+		benchThirdPartyDir .. "assimp-5.0.1/include/",
+	}
+
+	-- Scenes and models are read from Content/ relative to the repository root.
+	debugdir (benchRootDir)
+
+	systemversion ("latest")
+	defines
+	{
+		"_CRT_SECURE_NO_WARNINGS",
+	}
+
+	filter "system:linux"
+		links { "pthread", "assimp" }
+
+	filter { "system:windows", "configurations:Debug" }
+		libdirs { benchThirdPartyDir .. "assimp-5.0.1/build/code/Debug/" }
+		links { "assimp-vc142-mtd.lib" }
+		postbuildcommands { ("{COPY} " .. benchThirdPartyDir .. "assimp-5.0.1/build/code/Debug/assimp-vc142-mtd.dll %{cfg.targetdir}") }
+
+	filter { "system:windows", "configurations:not Debug" }
+		libdirs { benchThirdPartyDir .. "assimp-5.0.1/build/code/Release/" }
+		links { "assimp-vc142-mt.lib" }
+		postbuildcommands { ("{COPY} " .. benchThirdPartyDir .. "assimp-5.0.1/build/code/Release/assimp-vc142-mt.dll %{cfg.targetdir}") }
+
+	filter "configurations:Debug"
+		symbols "on"
+
+	filter "configurations:Release or configurations:Engine-Dist or configurations:Game-Dist"
+		optimize "on"
@@ -0,0 +1,187 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	Asset_Benchmarks - Reading the scenes in Content/Scenes and importing the models in Content/Models.
+
+	Scenes are read with the JsonStream readers SceneLoader::Load uses, timed per stage (Meta.json,
+	Resources.json, the mesh prefetch scan and streaming Actors.json) and with the stages overlapped
+	the way Load runs them. Creating the actors and their GPU resources needs a renderer, so each
+	streamed actor only has the values its LoadFromJson would read read from it. A scene that fails to read is
+	reported as a failure. Models go through MeshImporter, the renderer independent half of Model::Create.
+*/
+#include <Engine_pch.h>
+
+#include "Benchmark.h"
+
+#include "Insight/Rendering/Geometry/Mesh_Importer.h"
+#include "Insight/Systems/Json_Stream_Reader.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <future>
+
+using namespace Insight;
+
+namespace Benchmark {
+
+	static std::vector<std::filesystem::path> FindContent(const std::string& Directory, const char* Extension, bool Directories)
+	{
+		std::vector<std::filesystem::path> Paths;
+		std::error_code Error;
+		for (const std::filesystem::directory_entry& Entry : std::filesystem::directory_iterator(Directory, Error))
+		{
+			std::string EntryExtension = Entry.path().extension().string();
+			std::transform(EntryExtension.begin(), EntryExtension.end(), EntryExtension.begin(), [](char c) { return static_cast<char>(::tolower(c)); });
+			if (Entry.is_directory() == Directories && EntryExtension == Extension)
+				Paths.push_back(Entry.path());
+		}
+		// Directory iteration order is unspecified, keep the output stable between runs.
+		std::sort(Paths.begin(), Paths.end());
+		return Paths;
+	}
+
+	// The values AActor::LoadFromJson reads for every actor type: its transform, on the actor for built in
+	// types and on the SceneComponent for plain actors, and the mesh of its static mesh component.
+	static void ReadActorValues(const rapidjson::Value& JsonActor)
+	{
+		const rapidjson::Value* pTransform = nullptr;
+		std::string MeshPath;
+		if (JsonActor.HasMember("Transform"))
+		{
+			pTransform = &JsonActor["Transform"][0];
+		}
+		else if (JsonActor.HasMember("Subobjects"))
+		{
+			const rapidjson::Value& JsonSubobjects = JsonActor["Subobjects"];
+			for (rapidjson::SizeType i = 0; i < JsonSubobjects.Size(); ++i)
+			{
+				if (JsonSubobjects[i].HasMember("SceneComponent"))
+					pTransform = &JsonSubobjects[i]["SceneComponent"][0]["Transform"][0];
+				else if (JsonSubobjects[i].HasMember("StaticMesh"))
+					json::get_string(JsonSubobjects[i]["StaticMesh"][0], "Mesh", MeshPath);
+			}
+		}
+		DoNotOptimize(MeshPath);
+		if (!pTransform)
+			return;
+
+		float Values[9] = {};
+		const char* TransformKeys[9] = { "posX", "posY", "posZ", "rotX", "rotY", "rotZ", "scaX", "scaY", "scaZ" };
+		for (int i = 0; i < 9; ++i)
+			json::get_float(*pTransform, TransformKeys[i], Values[i]);
+		DoNotOptimize(Values);
+	}
+
+	// The stages of SceneLoader::Load with the same readers, minus what needs a renderer.
+	struct SceneStages
+	{
+		explicit SceneStages(const std::string& SceneDirectory)
+			: MetaPath(SceneDirectory + "/Meta.json")
+			, ResourcesPath(SceneDirectory + "/Resources.json")
+			, ActorsPath(SceneDirectory + "/Actors.json")
+		{
+		}
+
+		bool ReadMeta() const
+		{
+			JsonStream::SceneMeta Meta;
+			if (!JsonStream::ReadSceneMeta(MetaPath.c_str(), Meta))
+				return false;
+			DoNotOptimize(Meta);
+			return true;
+		}
+
+		bool ReadResources() const
+		{
+			std::vector<JsonStream::TextureResource> Textures;
+			if (!JsonStream::ReadTextureResources(ResourcesPath.c_str(), Textures))
+				return false;
+			DoNotOptimize(Textures);
+			return true;
+		}
+
+		// The prefetch scan. Each mesh would be handed to the MeshImportCache, imports are timed by ImportModel.
+		bool ScanMeshes() const
+		{
+			size_t NumMeshes = 0u;
+			if (!JsonStream::ReadMeshReferences(ActorsPath.c_str(), [&](const std::string& MeshPath) { DoNotOptimize(MeshPath); ++NumMeshes; }))
+				return false;
+			DoNotOptimize(NumMeshes);
+			return true;
+		}
+
+		// Stream the actors, reading from each what its LoadFromJson reads. Returns the number of actors.
+		uint32_t StreamActors() const
+		{
+			JsonStream::ActorReadStats Stats;
+			const bool Read = JsonStream::ReadActors(ActorsPath.c_str(), [](const JsonStream::ActorHeader& Header, const rapidjson::Value& JsonActor)
+			{
+				DoNotOptimize(Header);
+				ReadActorValues(JsonActor);
+				return true;
+			}, &Stats);
+			return Read ? Stats.NumActors : 0u;
+		}
+
+		// Every stage overlapped the way SceneLoader::Load runs them.
+		bool Load() const
+		{
+			if (!ReadMeta())
+				return false;
+			std::future<bool> ResourcesRead = std::async(std::launch::async, &SceneStages::ReadResources, this);
+			std::future<bool> MeshesScanned = std::async(std::launch::async, &SceneStages::ScanMeshes, this);
+			const bool ActorsRead = StreamActors() != 0u;
+			const bool MeshesRead = MeshesScanned.get();
+			return ResourcesRead.get() && MeshesRead && ActorsRead;
+		}
+
+		std::string MetaPath;
+		std::string ResourcesPath;
+		std::string ActorsPath;
+	};
+
+	void RunAssetBenchmarks(const Options& Opts, std::vector<Result>& OutResults)
+	{
+		const std::vector<std::filesystem::path> Scenes = FindContent(Opts.ContentDirectory + "Scenes", ".iescene", true);
+		if (Scenes.empty())
+			printf("No scenes found in \"%sScenes\". Use -Content to point at the content directory.\n", Opts.ContentDirectory.c_str());
+
+		for (const std::filesystem::path& Scene : Scenes)
+		{
+			const std::string SceneDirectory = Scene.string();
+			const std::string Variant = Scene.filename().string();
+			const SceneStages Stages(SceneDirectory);
+			const uint32_t NumActors = Stages.StreamActors();
+			if (NumActors == 0u || !Stages.Load())
+			{
+				const std::string Message = "Failed to read scene \"" + SceneDirectory + "\".";
+				ReportFailure("Asset", Message.c_str());
+				continue;
+			}
+
+			OutResults.push_back({ "Asset", "SceneMeta", Variant, 1, MeasureNanosecondsPerItem([&]() { Stages.ReadMeta(); }, 1) });
+			OutResults.push_back({ "Asset", "SceneResources", Variant, 1, MeasureNanosecondsPerItem([&]() { Stages.ReadResources(); }, 1) });
+			OutResults.push_back({ "Asset", "SceneMeshReferences", Variant, NumActors, MeasureNanosecondsPerItem([&]() { Stages.ScanMeshes(); }, NumActors) });
+			OutResults.push_back({ "Asset", "SceneActors", Variant, NumActors, MeasureNanosecondsPerItem([&]() { Stages.StreamActors(); }, NumActors) });
+			OutResults.push_back({ "Asset", "SceneLoad", Variant, NumActors, MeasureNanosecondsPerItem([&]() { Stages.Load(); }, NumActors) });
+		}
+
+		const std::vector<std::filesystem::path> Models = FindContent(Opts.ContentDirectory + "Models", ".fbx", false);
+		for (const std::filesystem::path& Model : Models)
+		{
+			const std::string ModelPath = Model.string();
+			ImportedModel Imported;
+			if (!MeshImporter::ImportFromFile(ModelPath, Imported))
+			{
+				printf("Failed to import model \"%s\". Skipping.\n", ModelPath.c_str());
+				continue;
+			}
+
+			OutResults.push_back({ "Asset", "ImportModel", Model.filename().string(), 1, MeasureNanosecondsPerItem([&]() {
+				ImportedModel Result;
+				MeshImporter::ImportFromFile(ModelPath, Result);
+				DoNotOptimize(Result.Meshes.size());
+			}, 1, 3) });
+		}
+	}
+
+} // end namespace Benchmark
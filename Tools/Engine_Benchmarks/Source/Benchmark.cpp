@@ -0,0 +1,80 @@
+// Copyright Insight Interactive. All Rights Reserved.
+#include <Engine_pch.h>
+
+#include "Benchmark.h"
+
+#include "Insight/Math/Batch_Math.h"
+#include "Insight/Systems/Cpu_Features.h"
+
+#include <ctime>
+#include <cstdio>
+#include <thread>
+
+using namespace Insight;
+
+namespace Benchmark {
+
+	static uint32_t s_NumFailures = 0;
+
+	void ReportFailure(const char* Suite, const char* Message)
+	{
+		printf("FAILED %s: %s\n", Suite, Message);
+		s_NumFailures++;
+	}
+
+	bool HasFailures()
+	{
+		return s_NumFailures > 0;
+	}
+
+	bool WriteResultsToJson(const char* Path, const std::vector<Result>& Results)
+	{
+		rapidjson::StringBuffer StrBuffer;
+		rapidjson::PrettyWriter<rapidjson::StringBuffer> Writer(StrBuffer);
+
+		const CpuFeatures& Cpu = CpuFeatures::Get();
+
+		Writer.StartObject();
+		{
+			// Enough about the machine and build to tell whether two runs are comparable.
+			Writer.Key("Timestamp");
+			Writer.Int64(static_cast<int64_t>(std::time(nullptr)));
+			Writer.Key("CpuVendor");
+			Writer.String(Cpu.Vendor);
+			Writer.Key("BatchMathLevel");
+			Writer.String(Math::GetBatchMathLevelName(Math::BatchMath::GetBestSupportedLevel()));
+			Writer.Key("HardwareThreads");
+			Writer.Uint(std::thread::hardware_concurrency());
+
+			Writer.Key("Results");
+			Writer.StartArray();
+			for (const Result& Res : Results)
+			{
+				Writer.StartObject();
+				Writer.Key("Suite");
+				Writer.String(Res.Suite.c_str());
+				Writer.Key("Name");
+				Writer.String(Res.Name.c_str());
+				Writer.Key("Variant");
+				Writer.String(Res.Variant.c_str());
+				Writer.Key("ItemCount");
+				Writer.Uint64(Res.ItemCount);
+				Writer.Key("NanosecondsPerItem");
+				Writer.Double(Res.NanosecondsPerItem);
+				if (Res.PeakBytes != 0)
+				{
+					Writer.Key("PeakBytes");
+					Writer.Uint64(Res.PeakBytes);
+				}
+				Writer.EndObject();
+			}
+			Writer.EndArray();
+		}
+		Writer.EndObject();
+
+		std::ofstream OutFile(Path);
+		OutFile << StrBuffer.GetString();
+		return OutFile.good();
+	}
+
+} // end namespace Benchmark
@@ -0,0 +1,88 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	File - Benchmark.h
+	Source - Benchmark.cpp
+
+	Purpose:
+	Minimal timing harness shared by the benchmark suites.
+
+	Description:
+	Each measurement runs the body once to warm caches, then several times and keeps the fastest
+	run, which is the least disturbed by the rest of the system. Results are reported per item
+	so suites with different batch sizes can be compared, and can be written to a json file so
+	runs can be compared against a baseline.
+*/
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+namespace Benchmark {
+
+	struct Result
+	{
+		std::string Suite;
+		std::string Name;
+		// Implementation or configuration variant, Ex. the BatchMath level.
+		std::string Variant;
+		size_t ItemCount;
+		double NanosecondsPerItem;
+		// Most memory the benchmark held at once, 0 when it was not measured.
+		size_t PeakBytes = 0;
+	};
+
+	// Options shared by every suite.
+	struct Options
+	{
+		// Content directory the asset suites read scenes and models from.
+		std::string ContentDirectory = "Content/";
+	};
+
+	// Keeps the optimizer from discarding results that are otherwise unused.
+	template <typename T>
+	inline void DoNotOptimize(const T& Value)
+	{
+		static const void* volatile s_pSink = nullptr;
+		s_pSink = &Value;
+		(void)s_pSink;
+	}
+
+	template <typename Body>
+	double MeasureNanosecondsPerItem(Body&& Func, size_t ItemCount, int Repeats = 10)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		Func();
+		double BestNanoseconds = 1e300;
+		for (int i = 0; i < Repeats; ++i)
+		{
+			const Clock::time_point Start = Clock::now();
+			Func();
+			const double Elapsed = std::chrono::duration<double, std::nano>(Clock::now() - Start).count();
+			BestNanoseconds = std::min(BestNanoseconds, Elapsed);
+		}
+		return BestNanoseconds / static_cast<double>(ItemCount ? ItemCount : 1);
+	}
+
+	// Write every result to a json file. Returns false if the file could not be written.
+	bool WriteResultsToJson(const char* Path, const std::vector<Result>& Results);
+
+	// Report a suite whose work came out wrong rather than slow. The benchmarks exit with an error once every suite has run.
+	void ReportFailure(const char* Suite, const char* Message);
+	bool HasFailures();
+
+	// Suites
+	void RunMathBenchmarks(const Options& Opts, std::vector<Result>& OutResults);
+	void RunTransformBenchmarks(const Options& Opts, std::vector<Result>& OutResults);
+	void RunSceneBenchmarks(const Options& Opts, std::vector<Result>& OutResults);
+	void RunTextureBenchmarks(const Options& Opts, std::vector<Result>& OutResults);
+	void RunInputBenchmarks(const Options& Opts, std::vector<Result>& OutResults);
+	void RunEventBenchmarks(const Options& Opts, std::vector<Result>& OutResults);
+	void RunAssetBenchmarks(const Options& Opts, std::vector<Result>& OutResults);
+	void RunSceneJsonBenchmarks(const Options& Opts, std::vector<Result>& OutResults);
+	void RunTickBenchmarks(const Options& Opts, std::vector<Result>& OutResults);
+
+} // end namespace Benchmark
@@ -0,0 +1,41 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	Stand in for Build_Rules/PCH_Source/Engine_pch.h when compiling engine sources into the benchmarks.
+	Only pulls in what the benchmarked systems need, none of the graphics headers.
+*/
+#pragma once
+
+#include <map>
+#include <list>
+#include <cmath>
+#include <mutex>
+#include <vector>
+#include <string>
+#include <memory>
+#include <sstream>
+#include <future>
+#include <cstring>
+#include <cstdint>
+#include <fstream>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+
+using std::shared_ptr;
+using std::weak_ptr;
+using std::unique_ptr;
+using std::make_shared;
+using std::make_unique;
+
+// Rapid Json
+#include <rapidjson/json.h>
+#include <rapidjson/writer.h>
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/prettywriter.h>
+
+#include <Insight/Core.h>
+#include "Insight/Core/Log.h"
+#include "Insight/Core/Interfaces.h"
+#include "Insight/Math/ie_Vectors.h"
+#include "Insight/Utilities/Profiling.h"
@@ -0,0 +1,97 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	Event_Benchmarks - EventBus immediate and queued delivery, and the EventDispatcher type
+	switch the input system still uses to route window events.
+*/
+#include <Engine_pch.h>
+
+#include "Benchmark.h"
+
+#include "Insight/Events/Event_Bus.h"
+#include "Insight/Events/Key_Event.h"
+#include "Insight/Events/Mouse_Event.h"
+#include "Insight/Events/Application_Event.h"
+
+using namespace Insight;
+
+namespace Benchmark {
+
+	static constexpr uint32_t kEventCount = 16 * 1024;
+	// Systems listening to the same event, Ex. the application, renderer and editor for a resize.
+	static constexpr uint32_t kSubscriberCount = 4;
+
+	struct ResizeListener
+	{
+		uint32_t NumReceived = 0;
+
+		bool OnWindowResize(WindowResizeEvent& e)
+		{
+			NumReceived += e.GetWidth() > 0 ? 1u : 0u;
+			return false;
+		}
+	};
+
+	void RunEventBenchmarks(const Options& Opts, std::vector<Result>& OutResults)
+	{
+		(void)Opts;
+
+		EventBus Bus;
+		ResizeListener Listeners[kSubscriberCount];
+		for (ResizeListener& Listener : Listeners)
+			Bus.Subscribe<WindowResizeEvent, ResizeListener, &ResizeListener::OnWindowResize>(&Listener);
+
+		auto Add = [&](const char* Name, size_t ItemCount, double NanosecondsPerItem)
+		{
+			OutResults.push_back({ "Event", Name, "", ItemCount, NanosecondsPerItem });
+		};
+
+		Add("PublishTyped", kEventCount, MeasureNanosecondsPerItem([&]() {
+			for (uint32_t i = 0; i < kEventCount; ++i)
+			{
+				WindowResizeEvent e(1920, 1080, false);
+				Bus.Publish(e);
+			}
+		}, kEventCount));
+
+		Add("PublishErased", kEventCount, MeasureNanosecondsPerItem([&]() {
+			for (uint32_t i = 0; i < kEventCount; ++i)
+			{
+				WindowResizeEvent e(1920, 1080, false);
+				Bus.Publish(static_cast<Event&>(e));
+			}
+		}, kEventCount));
+
+		// Game thread fills the queue, render thread drains it at the start of its frame.
+		Add("EnqueueFlush", EventBus::QueueCapacity, MeasureNanosecondsPerItem([&]() {
+			for (uint32_t i = 0; i < EventBus::QueueCapacity; ++i)
+				Bus.Enqueue(WindowResizeEvent(1920, 1080, false));
+			Bus.Flush();
+		}, EventBus::QueueCapacity));
+
+		// Same type switch as InputDispatcher::DispatchInputEvent, on a mix of event types.
+		uint32_t NumDispatched = 0;
+		auto Handle = [&NumDispatched](auto&) { ++NumDispatched; return false; };
+		KeyPressedEvent KeyPressed(KeyMapCode_Keyboard_W, 0);
+		KeyReleasedEvent KeyReleased(KeyMapCode_Keyboard_W);
+		MouseMovedEvent MouseMoved(1.0f, 1.0f, KeyMapCode_Mouse_MoveX);
+		MouseScrolledEvent MouseScrolled(0.0f, 1.0f, KeyMapCode_Mouse_Wheel_Up, InputEventType_Moved);
+		Event* Events[] = { &KeyPressed, &KeyReleased, &MouseMoved, &MouseScrolled };
+		Add("EventDispatcher", kEventCount, MeasureNanosecondsPerItem([&]() {
+			for (uint32_t i = 0; i < kEventCount; ++i)
+			{
+				EventDispatcher Dispatcher(*Events[i & 3u]);
+				Dispatcher.Dispatch<MouseMovedEvent>(Handle);
+				Dispatcher.Dispatch<MouseButtonPressedEvent>(Handle);
+				Dispatcher.Dispatch<MouseButtonReleasedEvent>(Handle);
+				Dispatcher.Dispatch<MouseScrolledEvent>(Handle);
+				Dispatcher.Dispatch<KeyPressedEvent>(Handle);
+				Dispatcher.Dispatch<KeyReleasedEvent>(Handle);
+			}
+		}, kEventCount));
+
+		DoNotOptimize(NumDispatched);
+		for (ResizeListener& Listener : Listeners)
+			DoNotOptimize(Listener.NumReceived);
+	}
+
+} // end namespace Benchmark
@@ -0,0 +1,86 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	Input_Benchmarks - InputDispatcher::ProcessInputEvent with the default mappings and a
+	handful of bound components, the path every window input event takes.
+*/
+#include <Engine_pch.h>
+
+#include "Benchmark.h"
+
+#include "Insight/Input/Input_Dispatcher.h"
+
+using namespace Insight;
+using namespace Insight::Input;
+
+namespace Benchmark {
+
+	static constexpr uint32_t kEventCount = 4 * 1024;
+	// Input components bound to each axis and action, Ex. the player, camera and a few scripts.
+	static constexpr uint32_t kListenersPerHint = 4;
+
+	void RunInputBenchmarks(const Options& Opts, std::vector<Result>& OutResults)
+	{
+		(void)Opts;
+
+		InputDispatcher Dispatcher;
+
+		float AxisSum = 0.0f;
+		uint32_t NumActions = 0;
+		for (uint32_t i = 0; i < kListenersPerHint; ++i)
+		{
+			Dispatcher.RegisterAxisCallback("MoveForward", [&AxisSum](float Value) { AxisSum += Value; });
+			Dispatcher.RegisterAxisCallback("MoveRight", [&AxisSum](float Value) { AxisSum += Value; });
+			Dispatcher.RegisterAxisCallback("LookUp", [&AxisSum](float Value) { AxisSum += Value; });
+			Dispatcher.RegisterAxisCallback("LookRight", [&AxisSum](float Value) { AxisSum += Value; });
+			Dispatcher.RegisterActionCallback("Sprint", InputEventType_Pressed, [&NumActions]() { ++NumActions; });
+			Dispatcher.RegisterActionCallback("Sprint", InputEventType_Released, [&NumActions]() { ++NumActions; });
+		}
+
+		auto Add = [&](const char* Name, double NanosecondsPerItem)
+		{
+			OutResults.push_back({ "Input", Name, "", kEventCount, NanosecondsPerItem });
+		};
+
+		// Movement keys held down, sent by UpdateInputs every frame.
+		const KeyMapCode MovementKeys[] = { KeyMapCode_Keyboard_W, KeyMapCode_Keyboard_A, KeyMapCode_Keyboard_S, KeyMapCode_Keyboard_D };
+		Add("KeyAxis", MeasureNanosecondsPerItem([&]() {
+			for (uint32_t i = 0; i < kEventCount; ++i)
+			{
+				KeyPressedEvent e(MovementKeys[i & 3u], 0, 1.0f);
+				Dispatcher.ProcessInputEvent(e);
+			}
+		}, kEventCount));
+
+		// Raw mouse movement, the most frequent event while looking around.
+		Add("MouseMove", MeasureNanosecondsPerItem([&]() {
+			for (uint32_t i = 0; i < kEventCount; ++i)
+			{
+				MouseMovedEvent e(1.0f, -1.0f, (i & 1u) ? KeyMapCode_Mouse_MoveX : KeyMapCode_Mouse_MoveY);
+				Dispatcher.ProcessInputEvent(e);
+			}
+		}, kEventCount));
+
+		Add("KeyAction", MeasureNanosecondsPerItem([&]() {
+			for (uint32_t i = 0; i < kEventCount; i += 2)
+			{
+				KeyPressedEvent Pressed(KeyMapCode_Keyboard_Shift, 0);
+				Dispatcher.ProcessInputEvent(Pressed);
+				KeyReleasedEvent Released(KeyMapCode_Keyboard_Shift);
+				Dispatcher.ProcessInputEvent(Released);
+			}
+		}, kEventCount));
+
+		// Keys nothing is mapped to still go through the dispatcher.
+		Add("UnmappedKey", MeasureNanosecondsPerItem([&]() {
+			for (uint32_t i = 0; i < kEventCount; ++i)
+			{
+				KeyPressedEvent e(KeyMapCode_Keyboard_Z, 0);
+				Dispatcher.ProcessInputEvent(e);
+			}
+		}, kEventCount));
+
+		DoNotOptimize(AxisSum);
+		DoNotOptimize(NumActions);
+	}
+
+} // end namespace Benchmark
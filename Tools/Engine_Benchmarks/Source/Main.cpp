@@ -0,0 +1,88 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	Engine_Benchmarks - Micro-benchmarks for engine systems.
+
+	Usage:
+	Engine_Benchmarks.exe [-Suite <name>] [-Content <directory>] [-Json <output file>]
+	-Suite: Only run the suite with the given name (Ex. Math, Scene). May be given more than once.
+	-Content: Directory the scenes and models are read from. Defaults to "Content/".
+	-Json: Also write the results to a json file so they can be compared against a baseline.
+	Exits with 1 if a suite reported a wrong result, Ex. ticks that ran out of dependency order.
+*/
+#include <Engine_pch.h>
+
+#include "Benchmark.h"
+
+#include <cstdio>
+
+struct Suite
+{
+	const char* Name;
+	void(*Run)(const Benchmark::Options&, std::vector<Benchmark::Result>&);
+};
+
+static const Suite s_Suites[] =
+{
+	{ "Math",		Benchmark::RunMathBenchmarks },
+	{ "Transform",	Benchmark::RunTransformBenchmarks },
+	{ "Scene",		Benchmark::RunSceneBenchmarks },
+	{ "Texture",	Benchmark::RunTextureBenchmarks },
+	{ "Input",		Benchmark::RunInputBenchmarks },
+	{ "Event",		Benchmark::RunEventBenchmarks },
+	{ "Asset",		Benchmark::RunAssetBenchmarks },
+	{ "SceneJson",	Benchmark::RunSceneJsonBenchmarks },
+	{ "Tick",		Benchmark::RunTickBenchmarks },
+};
+
+int main(int argc, char** argv)
+{
+	Benchmark::Options Opts;
+	const char* JsonPath = nullptr;
+	std::vector<std::string> SelectedSuites;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "-Json") == 0 && i + 1 < argc)
+			JsonPath = argv[++i];
+		else if (strcmp(argv[i], "-Content") == 0 && i + 1 < argc)
+			Opts.ContentDirectory = argv[++i];
+		else if (strcmp(argv[i], "-Suite") == 0 && i + 1 < argc)
+			SelectedSuites.push_back(argv[++i]);
+		else
+		{
+			printf("Unknown argument \"%s\".\nUsage: Engine_Benchmarks [-Suite <name>] [-Content <directory>] [-Json <output file>]\n", argv[i]);
+			return 1;
+		}
+	}
+	if (!Opts.ContentDirectory.empty() && Opts.ContentDirectory.back() != '/' && Opts.ContentDirectory.back() != '\\')
+		Opts.ContentDirectory += '/';
+
+	std::vector<Benchmark::Result> Results;
+	for (const Suite& Entry : s_Suites)
+	{
+		if (!SelectedSuites.empty() && std::find(SelectedSuites.begin(), SelectedSuites.end(), Entry.Name) == SelectedSuites.end())
+			continue;
+		Entry.Run(Opts, Results);
+	}
+
+	printf("%-10s %-22s %-16s %10s %14s %12s\n", "Suite", "Benchmark", "Variant", "Items", "ns/item", "Peak KB");
+	for (const Benchmark::Result& Result : Results)
+	{
+		printf("%-10s %-22s %-16s %10zu %14.3f",
+			Result.Suite.c_str(), Result.Name.c_str(), Result.Variant.c_str(), Result.ItemCount, Result.NanosecondsPerItem);
+		if (Result.PeakBytes != 0)
+			printf(" %12.1f", static_cast<double>(Result.PeakBytes) / 1024.0);
+		printf("\n");
+	}
+
+	if (JsonPath)
+	{
+		if (!Benchmark::WriteResultsToJson(JsonPath, Results))
+		{
+			printf("Failed to write results to \"%s\".\n", JsonPath);
+			return 1;
+		}
+		printf("Results written to \"%s\".\n", JsonPath);
+	}
+	return Benchmark::HasFailures() ? 1 : 0;
+}
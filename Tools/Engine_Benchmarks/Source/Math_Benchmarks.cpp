@@ -0,0 +1,132 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	Math_Benchmarks - Every BatchMath kernel at every level the CPU supports.
+	The Reference level is the one element at a time path the wide kernels are compared against.
+*/
+#include <Engine_pch.h>
+
+#include "Benchmark.h"
+
+#include "Insight/Math/Batch_Math.h"
+#include "Insight/Systems/Cpu_Features.h"
+
+#include <random>
+#include <cstdio>
+
+using namespace Insight;
+using namespace Insight::Math;
+
+namespace Benchmark {
+
+	static constexpr uint32_t kItemCount = 16 * 1024 + 7;
+
+	struct MathBenchmarkData
+	{
+		std::vector<ieFloat3> Points;
+		std::vector<ieFloat3> Scales;
+		std::vector<ieFloat4> Rotations;
+		std::vector<ieAABB> Boxes;
+		std::vector<ieSphere> Spheres;
+		std::vector<Simd::Matrix> Matrices;
+		ieFrustum Frustum;
+		Simd::Matrix Parent;
+
+		std::vector<ieFloat3> OutPoints;
+		std::vector<ieAABB> OutBoxes;
+		std::vector<Simd::Matrix> OutMatrices;
+		std::vector<uint32_t> OutIndices;
+
+		void Generate(uint32_t Count)
+		{
+			std::mt19937 Random(1234u);
+			std::uniform_real_distribution<float> Position(-100.0f, 100.0f);
+			std::uniform_real_distribution<float> Size(0.1f, 5.0f);
+			std::uniform_real_distribution<float> Unit(-1.0f, 1.0f);
+
+			Points.resize(Count);
+			Scales.resize(Count);
+			Rotations.resize(Count);
+			Boxes.resize(Count);
+			Spheres.resize(Count);
+			Matrices.resize(Count);
+			for (uint32_t i = 0; i < Count; ++i)
+			{
+				Points[i] = { Position(Random), Position(Random), Position(Random) };
+				Scales[i] = { Size(Random), Size(Random), Size(Random) };
+				Simd::StoreFloat4(&Rotations[i].x, Simd::QuaternionRollPitchYaw(Unit(Random) * 3.14f, Unit(Random) * 3.14f, Unit(Random) * 3.14f));
+				Boxes[i] = { Points[i], Scales[i] };
+				Spheres[i] = { Points[i], Size(Random) };
+				Matrices[i] = Simd::MatrixScaleTranslationRotation(Simd::LoadFloat3(&Scales[i].x), Simd::LoadFloat3(&Points[i].x), Simd::LoadFloat4(&Rotations[i].x));
+			}
+			Parent = Matrices[0];
+
+			// A box around the origin, roughly half of the generated objects are inside it.
+			const float Planes[6][4] = {
+				{ 1.0f, 0.0f, 0.0f, 60.0f }, { -1.0f, 0.0f, 0.0f, 60.0f },
+				{ 0.0f, 1.0f, 0.0f, 60.0f }, { 0.0f, -1.0f, 0.0f, 60.0f },
+				{ 0.0f, 0.0f, 1.0f, 60.0f }, { 0.0f, 0.0f, -1.0f, 60.0f },
+			};
+			for (int i = 0; i < 6; ++i)
+				Frustum.Planes[i] = { Planes[i][0], Planes[i][1], Planes[i][2], Planes[i][3] };
+
+			OutPoints.resize(Count);
+			OutBoxes.resize(Count);
+			OutMatrices.resize(Count);
+			OutIndices.resize(Count);
+		}
+	};
+
+	void RunMathBenchmarks(const Options& Opts, std::vector<Result>& OutResults)
+	{
+		(void)Opts;
+
+		const CpuFeatures& Cpu = CpuFeatures::Get();
+		printf("CPU: %s SSE4.1:%d AVX2:%d FMA:%d AVX-512F:%d, BatchMath best level: %s\n",
+			Cpu.Vendor, Cpu.SSE41, Cpu.AVX2, Cpu.FMA, Cpu.AVX512F, GetBatchMathLevelName(BatchMath::GetBestSupportedLevel()));
+
+		MathBenchmarkData Data;
+		Data.Generate(kItemCount);
+
+		for (int Level = 0; Level < static_cast<int>(BatchMathLevel::NumLevels); ++Level)
+		{
+			const BatchMathKernels* pKernels = BatchMath::GetKernels(static_cast<BatchMathLevel>(Level));
+			if (!pKernels)
+				continue;
+			const std::string Variant = GetBatchMathLevelName(static_cast<BatchMathLevel>(Level));
+
+			auto Add = [&](const char* Name, double NanosecondsPerItem)
+			{
+				OutResults.push_back({ "Math", Name, Variant, kItemCount, NanosecondsPerItem });
+			};
+
+			Add("TransformPoints", MeasureNanosecondsPerItem([&]() {
+				pKernels->TransformPoints(Data.Parent, Data.Points.data(), Data.OutPoints.data(), kItemCount);
+				DoNotOptimize(Data.OutPoints[0]);
+			}, kItemCount));
+
+			Add("TransformAABBs", MeasureNanosecondsPerItem([&]() {
+				pKernels->TransformAABBs(Data.Parent, Data.Boxes.data(), Data.OutBoxes.data(), kItemCount);
+				DoNotOptimize(Data.OutBoxes[0]);
+			}, kItemCount));
+
+			Add("MultiplyMatrices", MeasureNanosecondsPerItem([&]() {
+				pKernels->MultiplyMatrices(&Data.Parent, 0u, Data.Matrices.data(), 1u, Data.OutMatrices.data(), kItemCount);
+				DoNotOptimize(Data.OutMatrices[0]);
+			}, kItemCount));
+
+			Add("CullSpheres", MeasureNanosecondsPerItem([&]() {
+				DoNotOptimize(pKernels->CullSpheres(Data.Frustum, Data.Spheres.data(), kItemCount, Data.OutIndices.data()));
+			}, kItemCount));
+
+			Add("CullAABBs", MeasureNanosecondsPerItem([&]() {
+				DoNotOptimize(pKernels->CullAABBs(Data.Frustum, Data.Boxes.data(), kItemCount, Data.OutIndices.data()));
+			}, kItemCount));
+
+			Add("ComposeTransforms", MeasureNanosecondsPerItem([&]() {
+				pKernels->ComposeTransforms(Data.Points.data(), Data.Rotations.data(), Data.Scales.data(), Data.OutMatrices.data(), kItemCount);
+				DoNotOptimize(Data.OutMatrices[0]);
+			}, kItemCount));
+		}
+	}
+
+} // end namespace Benchmark
@@ -0,0 +1,84 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	Platform key codes for the benchmarks, which are built without a platform layer.
+	Uses the Win32 virtual key values so mappings read from settings files resolve the same as in the engine.
+*/
+#include <Engine_pch.h>
+
+#include "Insight/Input/Platform_Key_Codes.h"
+
+namespace ConstPlatformInputCodes
+{
+	const int PlatformMouseCode_Button_Left = 0x01;
+	const int PlatformMouseCode_Button_Right = 0x02;
+	const int PlatformMouseCode_Button_Middle = 0x04;
+
+	const int PlatformKeyboardCode_Shift = 0x10;
+	const int PlatformKeyboardCode_Shift_Left = 0xA0;
+	const int PlatformKeyboardCode_Shift_Right = 0xA1;
+	const int PlatformKeyboardCode_Alt = 0x12;
+	const int PlatformKeyboardCode_Control = 0x11;
+	const int PlatformKeyboardCode_Arrow_Left = 0x25;
+	const int PlatformKeyboardCode_Arrow_Right = 0x27;
+	const int PlatformKeyboardCode_Arrow_Up = 0x26;
+	const int PlatformKeyboardCode_Arrow_Down = 0x28;
+
+	const int PlatformKeyboardCode_0 = 0x60;
+	const int PlatformKeyboardCode_1 = 0x61;
+	const int PlatformKeyboardCode_2 = 0x62;
+	const int PlatformKeyboardCode_3 = 0x63;
+	const int PlatformKeyboardCode_4 = 0x64;
+	const int PlatformKeyboardCode_5 = 0x65;
+	const int PlatformKeyboardCode_6 = 0x66;
+	const int PlatformKeyboardCode_7 = 0x67;
+	const int PlatformKeyboardCode_8 = 0x68;
+	const int PlatformKeyboardCode_9 = 0x69;
+
+	const int PlatformKeyboardCode_A = 0x41;
+	const int PlatformKeyboardCode_B = 0x42;
+	const int PlatformKeyboardCode_C = 0x43;
+	const int PlatformKeyboardCode_D = 0x44;
+	const int PlatformKeyboardCode_E = 0x45;
+	const int PlatformKeyboardCode_F = 0x46;
+	const int PlatformKeyboardCode_G = 0x47;
+	const int PlatformKeyboardCode_H = 0x48;
+	const int PlatformKeyboardCode_I = 0x49;
+	const int PlatformKeyboardCode_J = 0x4A;
+	const int PlatformKeyboardCode_K = 0x4B;
+	const int PlatformKeyboardCode_L = 0x4C;
+	const int PlatformKeyboardCode_M = 0x4D;
+	const int PlatformKeyboardCode_N = 0x4E;
+	const int PlatformKeyboardCode_O = 0x4F;
+	const int PlatformKeyboardCode_P = 0x50;
+	const int PlatformKeyboardCode_Q = 0x51;
+	const int PlatformKeyboardCode_R = 0x52;
+	const int PlatformKeyboardCode_S = 0x53;
+	const int PlatformKeyboardCode_T = 0x54;
+	const int PlatformKeyboardCode_U = 0x55;
+	const int PlatformKeyboardCode_V = 0x56;
+	const int PlatformKeyboardCode_W = 0x57;
+	const int PlatformKeyboardCode_X = 0x58;
+	const int PlatformKeyboardCode_Y = 0x59;
+	const int PlatformKeyboardCode_Z = 0x5A;
+
+	const int PlatformGamepadButtonCode_A = 0xC3;
+	const int PlatformGamepadButtonCode_B = 0xC4;
+	const int PlatformGamepadButtonCode_X = 0xC5;
+	const int PlatformGamepadButtonCode_Y = 0xC6;
+	const int PlatformGamepadButtonCode_DPad_Up = 0xCB;
+	const int PlatformGamepadButtonCode_DPad_Down = 0xCC;
+	const int PlatformGamepadButtonCode_DPad_Left = 0xCD;
+	const int PlatformGamepadButtonCode_DPad_Right = 0xCE;
+	const int PlatformGamepadButtonCode_Start = 0xCF;
+	const int PlatformGamepadButtonCode_Back = 0xD0;
+	const int PlatformGamepadButtonCode_Thumbstick_Left = 0xD1;
+	const int PlatformGamepadButtonCode_Thumbstick_Right = 0xD2;
+	const int PlatformGamepadButtonCode_Shoulder_Left = 0xC8;
+	const int PlatformGamepadButtonCode_Shoulder_Right = 0xC7;
+	const int PlatformGamepadTriggerCode_Left = 0xC9;
+	const int PlatformGamepadTriggerCode_Right = 0xCA;
+	const int PlatformGamepadThumbstick_Left_Axis_X = 0xD5;
+	const int PlatformGamepadThumbstick_Left_Axis_Y = 0xD3;
+	const int PlatformGamepadThumbstick_Right_Axis_X = 0xD9;
+	const int PlatformGamepadThumbstick_Right_Axis_Y = 0xD7;
+}
@@ -0,0 +1,91 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	Scene_Benchmarks - Walking the SceneNode graph the way Scene does each frame.
+	The graph is a few levels deep and wide like a loaded scene, each node carrying a transform.
+*/
+#include <Engine_pch.h>
+
+#include "Benchmark.h"
+
+#include "Insight/Core/Scene/Scene_Node.h"
+#include "Insight/Memory/Deferred_Destruction.h"
+
+using namespace Insight;
+
+namespace Benchmark {
+
+	// Stands in for an actor, moves a little every update.
+	class BenchmarkNode : public SceneNode
+	{
+	public:
+		BenchmarkNode()
+			: SceneNode("Benchmark Node") {}
+
+		virtual void OnUpdate(const float DeltaMs) override
+		{
+			m_Transform.Translate(DeltaMs, 0.0f, 0.0f);
+			m_Transform.UpdateLocalMatrix();
+			DoNotOptimize(m_Transform.GetLocalSimdMatrix());
+			SceneNode::OnUpdate(DeltaMs);
+		}
+
+	private:
+		ieTransform m_Transform;
+	};
+
+	static uint32_t BuildTree(SceneNode* pParent, const uint32_t* pBranching, uint32_t Depth)
+	{
+		if (Depth == 0)
+			return 0;
+
+		uint32_t NumCreated = 0;
+		pParent->ResizeNumChildren(pBranching[0]);
+		for (uint32_t i = 0; i < pBranching[0]; ++i)
+		{
+			SceneNode* pChild = new BenchmarkNode();
+			pParent->AddChild(pChild);
+			NumCreated += 1 + BuildTree(pChild, pBranching + 1, Depth - 1);
+		}
+		return NumCreated;
+	}
+
+	void RunSceneBenchmarks(const Options& Opts, std::vector<Result>& OutResults)
+	{
+		(void)Opts;
+
+		// 256 actors with 4 components of 3 sub nodes each.
+		const uint32_t Branching[] = { 256, 4, 3 };
+
+		SceneNode* pRoot = new SceneNode("Benchmark Root");
+		const uint32_t NumNodes = BuildTree(pRoot, Branching, 3);
+
+		auto Add = [&](const char* Name, double NanosecondsPerItem)
+		{
+			OutResults.push_back({ "Scene", Name, "", NumNodes, NanosecondsPerItem });
+		};
+
+		Add("OnUpdate", MeasureNanosecondsPerItem([&]() {
+			pRoot->OnUpdate(0.016f);
+		}, NumNodes));
+
+		// Tick has no per node work, only the cost of the traversal itself.
+		Add("Tick", MeasureNanosecondsPerItem([&]() {
+			pRoot->Tick(0.016f);
+		}, NumNodes));
+
+		Add("OnPostInit", MeasureNanosecondsPerItem([&]() {
+			pRoot->OnPostInit();
+		}, NumNodes));
+
+		Add("BuildAndDestroy", MeasureNanosecondsPerItem([&]() {
+			SceneNode* pTemporaryRoot = new SceneNode("Benchmark Temporary Root");
+			BuildTree(pTemporaryRoot, Branching, 3);
+			delete pTemporaryRoot;
+			Memory::DeferredDestructionQueue::Get().Flush();
+		}, NumNodes, 3));
+
+		delete pRoot;
+		Memory::DeferredDestructionQueue::Get().Flush();
+	}
+
+} // end namespace Benchmark
@@ -0,0 +1,223 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	Scene_Json_Benchmarks - Reading a large Actors.json with the whole file Document against the JsonStream readers.
+
+	A synthetic scene of SyntheticActorCount actors, written in the same layout FileSystem::WriteSceneToJson
+	uses, is read by:
+	DOM		- json::load followed by the reads SceneLoader made before it streamed actors.
+	Stream	- JsonStream::ReadActors with the same reads made on each actor's json.
+	Meshes	- JsonStream::ReadMeshReferences, the mesh prefetch scan.
+	PeakBytes is the json memory held at once: the file text and Document for DOM, the per actor
+	Document for Stream. Allocations made by the benchmark's own reads are not counted.
+*/
+#include <Engine_pch.h>
+
+#include "Benchmark.h"
+
+#include "Insight/Systems/Json_Stream_Reader.h"
+
+#include <cstdio>
+#include <filesystem>
+
+using namespace Insight;
+
+namespace Benchmark {
+
+	static constexpr size_t SyntheticActorCount = 100000u;
+
+	static void WriteTransform(rapidjson::Writer<rapidjson::StringBuffer>& Writer, const char* Key, float Offset)
+	{
+		const char* TransformKeys[9] = { "posX", "posY", "posZ", "rotX", "rotY", "rotZ", "scaX", "scaY", "scaZ" };
+		Writer.Key(Key);
+		Writer.StartArray();
+		Writer.StartObject();
+		for (int i = 0; i < 9; ++i)
+		{
+			Writer.Key(TransformKeys[i]);
+			Writer.Double(i < 3 ? Offset * (i + 1) : (i < 6 ? 0.0 : 1.0));
+		}
+		Writer.EndObject();
+		Writer.EndArray();
+	}
+
+	// Every eighth actor is a point light, the rest are static meshes spread over 16 models.
+	static bool WriteSyntheticActors(const std::string& Path, size_t NumActors)
+	{
+		rapidjson::StringBuffer StrBuffer;
+		rapidjson::Writer<rapidjson::StringBuffer> Writer(StrBuffer);
+
+		Writer.StartObject();
+		Writer.Key("Set");
+		Writer.StartArray();
+		for (size_t a = 0; a < NumActors; ++a)
+		{
+			const std::string DisplayName = "Actor " + std::to_string(a);
+			const float Offset = static_cast<float>(a % 1000) * 0.5f;
+
+			Writer.StartObject();
+			if (a % 8 == 7)
+			{
+				Writer.Key("Type");				Writer.String("PointLight");
+				Writer.Key("DisplayName");		Writer.String(DisplayName.c_str());
+				WriteTransform(Writer, "Transform", Offset);
+				Writer.Key("Emission");
+				Writer.StartArray();
+				Writer.StartObject();
+				Writer.Key("diffuseR");			Writer.Double(0.93);
+				Writer.Key("diffuseG");			Writer.Double(0.87);
+				Writer.Key("diffuseB");			Writer.Double(0.75);
+				Writer.Key("strength");			Writer.Double(8.0);
+				Writer.EndObject();
+				Writer.EndArray();
+				Writer.Key("Subobjects");
+				Writer.StartArray();
+				Writer.EndArray();
+			}
+			else
+			{
+				const std::string MeshPath = "Models/Synthetic_" + std::to_string(a % 16) + ".obj";
+
+				Writer.Key("Type");				Writer.String("Actor");
+				Writer.Key("DisplayName");		Writer.String(DisplayName.c_str());
+				Writer.Key("Subobjects");
+				Writer.StartArray();
+				{
+					Writer.StartObject();
+					Writer.Key("SceneComponent");
+					Writer.StartArray();
+					Writer.StartObject();
+					WriteTransform(Writer, "Transform", Offset);
+					Writer.EndObject();
+					Writer.EndArray();
+					Writer.EndObject();
+
+					Writer.StartObject();
+					Writer.Key("StaticMesh");
+					Writer.StartArray();
+					Writer.StartObject();
+					Writer.Key("Mesh");			Writer.String(MeshPath.c_str());
+					Writer.Key("Enabled");		Writer.Bool(true);
+					WriteTransform(Writer, "LocalTransform", 0.0f);
+					Writer.EndObject();
+					Writer.StartObject();
+					Writer.Key("Category");			Writer.Int(0);
+					Writer.Key("AlbedoMapID");		Writer.Int(6);
+					Writer.Key("NormalMapID");		Writer.Int(7);
+					Writer.Key("MetallicMapID");	Writer.Int(8);
+					Writer.Key("RoughnessMapID");	Writer.Int(9);
+					Writer.Key("AOMapID");			Writer.Int(10);
+					Writer.EndObject();
+					Writer.EndArray();
+					Writer.EndObject();
+				}
+				Writer.EndArray();
+			}
+			Writer.EndObject();
+		}
+		Writer.EndArray();
+		Writer.EndObject();
+
+		std::ofstream OutFile(Path, std::ios::binary);
+		OutFile.write(StrBuffer.GetString(), StrBuffer.GetSize());
+		return OutFile.good();
+	}
+
+	// The values the actors read from their json, Ex. the transform and mesh of an Actor.
+	static void ReadActorValues(const rapidjson::Value& JsonActor)
+	{
+		const rapidjson::Value* pTransform = nullptr;
+		std::string MeshPath;
+		if (JsonActor.HasMember("Transform"))
+		{
+			pTransform = &JsonActor["Transform"][0];
+		}
+		else if (JsonActor.HasMember("Subobjects"))
+		{
+			const rapidjson::Value& JsonSubobjects = JsonActor["Subobjects"];
+			for (rapidjson::SizeType i = 0; i < JsonSubobjects.Size(); ++i)
+			{
+				if (JsonSubobjects[i].HasMember("SceneComponent"))
+					pTransform = &JsonSubobjects[i]["SceneComponent"][0]["Transform"][0];
+				else if (JsonSubobjects[i].HasMember("StaticMesh"))
+					json::get_string(JsonSubobjects[i]["StaticMesh"][0], "Mesh", MeshPath);
+			}
+		}
+		DoNotOptimize(MeshPath);
+		if (!pTransform)
+			return;
+
+		float Values[9] = {};
+		const char* TransformKeys[9] = { "posX", "posY", "posZ", "rotX", "rotY", "rotZ", "scaX", "scaY", "scaZ" };
+		for (int i = 0; i < 9; ++i)
+			json::get_float(*pTransform, TransformKeys[i], Values[i]);
+		DoNotOptimize(Values);
+	}
+
+	static size_t ReadActorsDom(const std::string& Path)
+	{
+		rapidjson::Document RawActorsFile;
+		if (!json::load(Path.c_str(), RawActorsFile))
+			return 0;
+
+		const rapidjson::Value& SceneObjects = RawActorsFile["Set"];
+		for (rapidjson::SizeType a = 0; a < SceneObjects.Size(); a++)
+		{
+			std::string ActorDisplayName;
+			std::string ActorType;
+			json::get_string(SceneObjects[a], "DisplayName", ActorDisplayName);
+			json::get_string(SceneObjects[a], "Type", ActorType);
+			ReadActorValues(SceneObjects[a]);
+		}
+		// json::load holds the file text while the Document is built.
+		return RawActorsFile.GetAllocator().Capacity() + static_cast<size_t>(std::filesystem::file_size(Path));
+	}
+
+	static size_t ReadActorsStream(const std::string& Path)
+	{
+		JsonStream::ActorReadStats Stats;
+		JsonStream::ReadActors(Path.c_str(), [](const JsonStream::ActorHeader& Header, const rapidjson::Value& JsonActor)
+		{
+			DoNotOptimize(Header.Type);
+			ReadActorValues(JsonActor);
+			return true;
+		}, &Stats);
+		return Stats.PeakActorBytes;
+	}
+
+	void RunSceneJsonBenchmarks(const Options& Opts, std::vector<Result>& OutResults)
+	{
+		(void)Opts;
+
+		std::error_code Error;
+		const std::string Path = (std::filesystem::temp_directory_path(Error) / "Insight_Benchmark_Actors.json").string();
+		if (Error || !WriteSyntheticActors(Path, SyntheticActorCount))
+		{
+			printf("Failed to write the synthetic scene to \"%s\". Skipping.\n", Path.c_str());
+			return;
+		}
+
+		// Both readers must see the same scene.
+		uint32_t NumStreamed = 0u;
+		JsonStream::ReadActors(Path.c_str(), [&](const JsonStream::ActorHeader&, const rapidjson::Value&) { ++NumStreamed; return true; });
+		if (NumStreamed != SyntheticActorCount)
+			printf("Streamed %u of %zu synthetic actors.\n", NumStreamed, SyntheticActorCount);
+
+		size_t DomBytes = 0u, StreamBytes = 0u;
+		Result Dom = { "SceneJson", "ReadActors", "DOM", SyntheticActorCount, MeasureNanosecondsPerItem([&]() { DomBytes = ReadActorsDom(Path); }, SyntheticActorCount, 3) };
+		Dom.PeakBytes = DomBytes;
+		OutResults.push_back(Dom);
+
+		Result Stream = { "SceneJson", "ReadActors", "Stream", SyntheticActorCount, MeasureNanosecondsPerItem([&]() { StreamBytes = ReadActorsStream(Path); }, SyntheticActorCount, 3) };
+		Stream.PeakBytes = StreamBytes;
+		OutResults.push_back(Stream);
+
+		OutResults.push_back({ "SceneJson", "ReadMeshReferences", "Stream", SyntheticActorCount, MeasureNanosecondsPerItem([&]() {
+			size_t NumMeshes = 0u;
+			JsonStream::ReadMeshReferences(Path.c_str(), [&](const std::string&) { ++NumMeshes; });
+			DoNotOptimize(NumMeshes);
+		}, SyntheticActorCount, 3) });
+
+		std::filesystem::remove(Path, Error);
+	}
+
+} // end namespace Benchmark
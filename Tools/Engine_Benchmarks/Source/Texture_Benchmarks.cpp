@@ -0,0 +1,93 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	Texture_Benchmarks - TextureManager::GetTextureByID, which forwards to the TextureCache.
+	Materials look up five textures each when they are created and again whenever a texture id is changed in the editor.
+*/
+#include <Engine_pch.h>
+
+#include "Benchmark.h"
+
+#include "Insight/Systems/Managers/Texture_Cache.h"
+
+#include <random>
+
+using namespace Insight;
+
+namespace Benchmark {
+
+	static constexpr uint32_t kTexturesPerType = 512;
+	static constexpr uint32_t kLookupCount = 16 * 1024;
+
+	// A texture without any graphics resources.
+	class NullTexture : public Texture
+	{
+	public:
+		NullTexture(IE_TEXTURE_INFO CreateInfo)
+			: Texture(CreateInfo) {}
+
+		virtual void Destroy() override {}
+		virtual void BindForDeferredPass() override {}
+		virtual void BindForForwardPass() override {}
+	};
+
+	static StrongTexturePtr CreateNullTexture(Texture::ID Id, Texture::eTextureType Type)
+	{
+		IE_TEXTURE_INFO TexInfo = {};
+		TexInfo.Id = Id;
+		TexInfo.Type = Type;
+		return make_shared<NullTexture>(TexInfo);
+	}
+
+	void RunTextureBenchmarks(const Options& Opts, std::vector<Result>& OutResults)
+	{
+		(void)Opts;
+
+		const Texture::eTextureType MaterialTypes[] = {
+			Texture::eTextureType_Albedo, Texture::eTextureType_Normal, Texture::eTextureType_Metallic,
+			Texture::eTextureType_Roughness, Texture::eTextureType_AmbientOcclusion,
+		};
+
+		TextureCache Cache;
+		for (Texture::eTextureType Type : MaterialTypes)
+		{
+			Cache.SetDefaultTexture(Type, CreateNullTexture(-1 - Type, Type));
+			for (Texture::ID Id = 1; Id <= static_cast<Texture::ID>(kTexturesPerType); ++Id)
+				Cache.Add(CreateNullTexture(Id, Type));
+		}
+
+		std::mt19937 Random(1234u);
+		std::uniform_int_distribution<Texture::ID> LoadedId(1, kTexturesPerType);
+		std::uniform_int_distribution<Texture::ID> MissingId(kTexturesPerType + 1, kTexturesPerType * 2);
+		std::uniform_int_distribution<uint32_t> TypeIndex(0, static_cast<uint32_t>(sizeof(MaterialTypes) / sizeof(MaterialTypes[0])) - 1);
+
+		struct Lookup
+		{
+			Texture::ID Id;
+			Texture::eTextureType Type;
+		};
+		std::vector<Lookup> Hits(kLookupCount);
+		std::vector<Lookup> Misses(kLookupCount);
+		for (uint32_t i = 0; i < kLookupCount; ++i)
+		{
+			Hits[i] = { LoadedId(Random), MaterialTypes[TypeIndex(Random)] };
+			Misses[i] = { MissingId(Random), MaterialTypes[TypeIndex(Random)] };
+		}
+
+		auto Add = [&](const char* Name, double NanosecondsPerItem)
+		{
+			OutResults.push_back({ "Texture", Name, "", kLookupCount, NanosecondsPerItem });
+		};
+
+		Add("GetTextureByID", MeasureNanosecondsPerItem([&]() {
+			for (const Lookup& Query : Hits)
+				DoNotOptimize(Cache.GetTextureByID(Query.Id, Query.Type));
+		}, kLookupCount));
+
+		// Ids that are not loaded (yet) return the default texture for the type.
+		Add("GetTextureByIDDefault", MeasureNanosecondsPerItem([&]() {
+			for (const Lookup& Query : Misses)
+				DoNotOptimize(Cache.GetTextureByID(Query.Id, Query.Type));
+		}, kLookupCount));
+	}
+
+} // end namespace Benchmark
@@ -0,0 +1,211 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	Tick_Benchmarks - A frame of the TickManager's dependency graph, run on the workers and serially.
+	Ticks form chains through shared state they declare. Each chain is written by every fourth tick
+	and read by the ticks in between, some of which stay on the game thread, so the graph has
+	dependencies from the workers to the game thread and back. The game thread is held at the start
+	of the frame until a worker has ticked, so the dependencies cross threads however few cores the
+	machine has. Every frame is checked: a tick must start only after the ticks it depends on have finished.
+*/
+#include <Engine_pch.h>
+
+#include "Benchmark.h"
+
+#include "Insight/Core/Scene/Tick_Manager.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace Insight;
+
+namespace Benchmark {
+
+	static constexpr uint32_t kChainCount = 8;
+	static constexpr uint32_t kChainLength = 64;
+	static constexpr uint32_t kTickCount = kChainCount * kChainLength;
+	// Busy work per tick, enough for the workers to overlap.
+	static constexpr uint32_t kWorkIterations = 2000;
+
+	struct TickGraphState
+	{
+		// Advanced as each tick starts and finishes.
+		std::atomic<uint32_t> Clock{ 0u };
+		std::atomic<uint32_t> NumOffGameThread{ 0u };
+		std::thread::id GameThreadId;
+	};
+
+	struct BenchmarkTick
+	{
+		TickFunction Function;
+		TickGraphState* pState = nullptr;
+		uint32_t StartTime = 0;
+		uint32_t EndTime = 0;
+		std::thread::id ThreadId;
+		float Result = 0.0f;
+	};
+
+	static void TickBenchmark(void* pTarget, float DeltaMs)
+	{
+		BenchmarkTick& Tick = *static_cast<BenchmarkTick*>(pTarget);
+		Tick.ThreadId = std::this_thread::get_id();
+		Tick.StartTime = Tick.pState->Clock.fetch_add(1u, std::memory_order_acq_rel);
+
+		float Value = DeltaMs;
+		for (uint32_t i = 0; i < kWorkIterations; ++i)
+			Value = Value * 0.5f + static_cast<float>(i);
+		Tick.Result = Value;
+
+		Tick.EndTime = Tick.pState->Clock.fetch_add(1u, std::memory_order_acq_rel);
+		if (Tick.ThreadId != Tick.pState->GameThreadId)
+			Tick.pState->NumOffGameThread.fetch_add(1u, std::memory_order_release);
+	}
+
+	// Runs first on the game thread. The game thread helps with worker ticks when it has none of its own, so
+	// without it a machine with few cores may run the whole frame on the game thread.
+	static void TickGate(void* pTarget, float)
+	{
+		const TickGraphState& State = *static_cast<TickGraphState*>(pTarget);
+		if (TickManager::IsSerialTicking())
+			return;
+
+		const std::chrono::steady_clock::time_point Deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+		while (State.NumOffGameThread.load(std::memory_order_acquire) == 0u && std::chrono::steady_clock::now() < Deadline)
+			std::this_thread::yield();
+	}
+
+	// The ticks each tick must wait on, from what they declared: the last write of the chain before it, and a write
+	// also waits on the reads since the last write.
+	static std::vector<std::pair<uint32_t, uint32_t>> GetExpectedDependencies(const BenchmarkTick* pTicks)
+	{
+		std::vector<std::pair<uint32_t, uint32_t>> Dependencies;
+		for (uint32_t Chain = 0; Chain < kChainCount; ++Chain)
+		{
+			uint32_t LastWriter = kTickCount;
+			std::vector<uint32_t> Readers;
+			for (uint32_t Link = 0; Link < kChainLength; ++Link)
+			{
+				const uint32_t Index = Link * kChainCount + Chain;
+				if (LastWriter != kTickCount)
+					Dependencies.emplace_back(LastWriter, Index);
+				if (pTicks[Index].Function.Writes != TickAccess_None)
+				{
+					for (uint32_t Reader : Readers)
+						Dependencies.emplace_back(Reader, Index);
+					Readers.clear();
+					LastWriter = Index;
+				}
+				else
+				{
+					Readers.push_back(Index);
+				}
+			}
+		}
+		return Dependencies;
+	}
+
+	// Returns false and reports the failure if a tick did not run, or started before a tick it depends on finished.
+	static bool CheckFrame(const BenchmarkTick* pTicks, const std::vector<std::pair<uint32_t, uint32_t>>& Dependencies,
+		uint32_t NumTicked, const char* Variant)
+	{
+		char Message[256];
+		if (NumTicked != kTickCount)
+		{
+			snprintf(Message, sizeof(Message), "%s: %u of %u ticks ran.", Variant, NumTicked, kTickCount);
+			ReportFailure("Tick", Message);
+			return false;
+		}
+		for (const std::pair<uint32_t, uint32_t>& Dependency : Dependencies)
+		{
+			const BenchmarkTick& Before = pTicks[Dependency.first];
+			const BenchmarkTick& After = pTicks[Dependency.second];
+			if (Before.EndTime >= After.StartTime)
+			{
+				snprintf(Message, sizeof(Message), "%s: tick %u started before tick %u, which it depends on, finished.",
+					Variant, Dependency.second, Dependency.first);
+				ReportFailure("Tick", Message);
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void RunTickBenchmarks(const Options& Opts, std::vector<Result>& OutResults)
+	{
+		(void)Opts;
+
+		// Outlive the tick manager, it unregisters them when it is destroyed.
+		TickGraphState State;
+		State.GameThreadId = std::this_thread::get_id();
+		TickFunction Gate;
+		std::unique_ptr<BenchmarkTick[]> pTicks(new BenchmarkTick[kTickCount]);
+
+		TickManager Ticks;
+		Ticks.GetSignificanceSettings().Enabled = false;
+		Gate.CanEverTick = true;
+		Gate.UseSignificance = false;
+		Ticks.Register(Gate, &TickGate, &State, nullptr);
+		// Interleave the chains so the ticks of different chains are free to run side by side.
+		for (uint32_t Link = 0; Link < kChainLength; ++Link)
+		{
+			for (uint32_t Chain = 0; Chain < kChainCount; ++Chain)
+			{
+				BenchmarkTick& Tick = pTicks[Link * kChainCount + Chain];
+				const uint64_t ChainAccess = static_cast<uint64_t>(TickAccess_FirstCustom) << Chain;
+				Tick.pState = &State;
+				Tick.Function.CanEverTick = true;
+				Tick.Function.UseSignificance = false;
+				Tick.Function.RunOnGameThread = (Link % 4u) == 2u;
+				if (Link % 4u == 0u)
+					Tick.Function.Writes = ChainAccess;
+				else
+					Tick.Function.Reads = ChainAccess;
+				Ticks.Register(Tick.Function, &TickBenchmark, &Tick, nullptr);
+			}
+		}
+		const std::vector<std::pair<uint32_t, uint32_t>> Dependencies = GetExpectedDependencies(pTicks.get());
+		const ieVector3 ViewerPosition(0.0f, 0.0f, 0.0f);
+
+		auto Add = [&](const char* Name, const char* Variant, double NanosecondsPerItem)
+		{
+			OutResults.push_back({ "Tick", Name, Variant, kTickCount, NanosecondsPerItem });
+		};
+
+		struct Variant
+		{
+			const char* Name;
+			bool Serial;
+		};
+		const Variant Variants[] = { { "Workers", false }, { "Serial", true } };
+		for (const Variant& Var : Variants)
+		{
+			TickManager::SetSerialTicking(Var.Serial);
+			bool IsCorrect = true;
+			Add("Frame", Var.Name, MeasureNanosecondsPerItem([&]() {
+				State.NumOffGameThread.store(0u, std::memory_order_relaxed);
+				Ticks.Tick(1.0f, ViewerPosition);
+				// The gate ticks too.
+				if (IsCorrect)
+					IsCorrect = CheckFrame(pTicks.get(), Dependencies, Ticks.GetNumTickedLastFrame() - 1u, Var.Name);
+			}, kTickCount));
+			if (!IsCorrect)
+				continue;
+
+			// The graph only tests anything if its dependencies cross threads.
+			const uint32_t NumOffGameThread = State.NumOffGameThread.load(std::memory_order_acquire);
+			uint32_t NumCrossThread = 0;
+			for (const std::pair<uint32_t, uint32_t>& Dependency : Dependencies)
+				NumCrossThread += pTicks[Dependency.first].ThreadId != pTicks[Dependency.second].ThreadId ? 1u : 0u;
+
+			if (Var.Serial && NumOffGameThread != 0)
+				ReportFailure("Tick", "Serial: ticks ran off the game thread.");
+			if (!Var.Serial && (NumOffGameThread == 0 || NumCrossThread == 0))
+				ReportFailure("Tick", "Workers: no tick or dependency crossed threads.");
+		}
+		TickManager::SetSerialTicking(false);
+
+		for (uint32_t i = 0; i < kTickCount; ++i)
+			DoNotOptimize(pTicks[i].Result);
+	}
+
+} // end namespace Benchmark
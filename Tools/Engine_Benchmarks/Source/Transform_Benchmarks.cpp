@@ -0,0 +1,74 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	Transform_Benchmarks - ieTransform updates the way actors and cameras make them each frame.
+*/
+#include <Engine_pch.h>
+
+#include "Benchmark.h"
+
+#include "Insight/Math/Transform.h"
+
+#include <random>
+
+using namespace Insight;
+
+namespace Benchmark {
+
+	static constexpr uint32_t kTransformCount = 16 * 1024;
+
+	void RunTransformBenchmarks(const Options& Opts, std::vector<Result>& OutResults)
+	{
+		(void)Opts;
+
+		std::mt19937 Random(1234u);
+		std::uniform_real_distribution<float> Position(-100.0f, 100.0f);
+		std::uniform_real_distribution<float> Angle(-180.0f, 180.0f);
+
+		std::vector<ieTransform> Transforms(kTransformCount);
+		for (ieTransform& Transform : Transforms)
+		{
+			Transform.SetPosition(Position(Random), Position(Random), Position(Random));
+			Transform.SetRotation(Angle(Random), Angle(Random), Angle(Random));
+			Transform.UpdateLocalMatrix();
+		}
+
+		auto Add = [&](const char* Name, double NanosecondsPerItem)
+		{
+			OutResults.push_back({ "Transform", Name, "", kTransformCount, NanosecondsPerItem });
+		};
+
+		// A moving actor, several changes per frame then one matrix read by the renderer.
+		Add("TranslateRotateRebuild", MeasureNanosecondsPerItem([&]() {
+			for (ieTransform& Transform : Transforms)
+			{
+				Transform.Translate(0.1f, 0.0f, 0.1f);
+				Transform.Rotate(0.0f, 1.0f, 0.0f);
+				Transform.UpdateLocalMatrix();
+				DoNotOptimize(Transform.GetLocalSimdMatrix());
+			}
+		}, kTransformCount));
+
+		// A static actor, the matrix is read every frame but never rebuilt.
+		Add("CleanMatrixRead", MeasureNanosecondsPerItem([&]() {
+			for (const ieTransform& Transform : Transforms)
+				DoNotOptimize(Transform.GetLocalSimdMatrix());
+		}, kTransformCount));
+
+		// Camera and character movement query direction vectors after rotating.
+		Add("RotateLocalForward", MeasureNanosecondsPerItem([&]() {
+			for (ieTransform& Transform : Transforms)
+			{
+				Transform.Rotate(1.0f, 0.0f, 0.0f);
+				DoNotOptimize(Transform.GetLocalForward());
+			}
+		}, kTransformCount));
+
+		Add("WorldFromParent", MeasureNanosecondsPerItem([&]() {
+			const Math::Simd::Matrix Parent = Transforms[0].GetLocalSimdMatrix();
+			for (ieTransform& Transform : Transforms)
+				Transform.SetWorldSimdMatrix(Math::Simd::MatrixMultiply(Transform.GetLocalSimdMatrix(), Parent));
+			DoNotOptimize(Transforms.back().GetWorldSimdMatrix());
+		}, kTransformCount));
+	}
+
+} // end namespace Benchmark
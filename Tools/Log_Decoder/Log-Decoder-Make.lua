@@ -0,0 +1,42 @@
+-- Log Decoder
+-- Converts binary logs written by the engine's asynchronous logger into text.
+
+local decoderRootDir = "../../"
+local decoderThirdPartyDir = decoderRootDir .. "Engine_Source/Third_Party/"
+
+project ("Log_Decoder")
+	location (decoderRootDir .. "Tools/Log_Decoder")
+	kind ("ConsoleApp")
+	cppdialect ("C++17")
+	language ("C++")
+	staticruntime ("off")
+	targetname ("Log_Decoder")
+
+	targetdir (decoderRootDir .. "Binaries/" .. outputdir .. "/%{prj.name}")
+	objdir (decoderRootDir .. "Binaries/Intermediates/" .. outputdir .. "/%{prj.name}")
+
+	files
+	{
+		"Log-Decoder-Make.lua",
+		"Source/**.cpp",
+		-- Shared encoding with the engine's logger.
+		decoderRootDir .. "Engine_Source/Source/Insight/Core/Log_Codec.h",
+	}
+
+	includedirs
+	{
+		decoderThirdPartyDir .. "spdlog/include/",
+		decoderRootDir .. "Engine_Source/Source/",
+	}
+
+	systemversion ("latest")
+	defines
+	{
+		"_CRT_SECURE_NO_WARNINGS",
+	}
+
+	filter "configurations:Debug"
+		symbols "on"
+
+	filter "configurations:Release or configurations:Engine-Dist or configurations:Game-Dist"
+		optimize "on"
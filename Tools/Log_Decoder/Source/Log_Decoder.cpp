@@ -0,0 +1,137 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	Log_Decoder - Turns a binary log written by the engine's asynchronous logger into text.
+
+	Usage:
+	Log_Decoder.exe <BinaryLogFile> [OutputFile]
+	Writes to stdout if no output file is given.
+*/
+#include "Insight/Core/Log_Codec.h"
+
+#include <ctime>
+#include <cstdio>
+#include <vector>
+#include <string>
+#include <unordered_map>
+
+using namespace Insight::Debug;
+
+static const char* GetSeverityName(uint8_t Severity)
+{
+	switch (static_cast<LogSeverity>(Severity))
+	{
+	case LogSeverity::Log:		return "Log";
+	case LogSeverity::Verbose:	return "Verbose";
+	case LogSeverity::Warning:	return "Warning";
+	case LogSeverity::Error:	return "Error";
+	case LogSeverity::Critical:	return "Critical";
+	default:					return "Unknown";
+	}
+}
+
+struct DecodedSite
+{
+	uint32_t Line;
+	std::string File;
+	std::string Format;
+};
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		fprintf(stderr, "Usage: %s <BinaryLogFile> [OutputFile]\n", argv[0]);
+		return 1;
+	}
+
+	FILE* pInput = fopen(argv[1], "rb");
+	if (!pInput)
+	{
+		fprintf(stderr, "Failed to open binary log \"%s\".\n", argv[1]);
+		return 1;
+	}
+	FILE* pOutput = (argc > 2) ? fopen(argv[2], "w") : stdout;
+	if (!pOutput)
+	{
+		fprintf(stderr, "Failed to open output file \"%s\".\n", argv[2]);
+		fclose(pInput);
+		return 1;
+	}
+
+	BinaryLogFileHeader FileHeader = {};
+	if (fread(&FileHeader, sizeof(BinaryLogFileHeader), 1, pInput) != 1 || FileHeader.Magic != BinaryLogMagic || FileHeader.Version != BinaryLogVersion)
+	{
+		fprintf(stderr, "\"%s\" is not a binary log or was written by an incompatible version.\n", argv[1]);
+		fclose(pInput);
+		return 1;
+	}
+
+	std::unordered_map<uint32_t, DecodedSite> Sites;
+	std::vector<uint8_t> Payload;
+	fmt::memory_buffer Message;
+	uint64_t NumRecords = 0u;
+	bool Truncated = false;
+
+	int Chunk = 0;
+	while ((Chunk = fgetc(pInput)) != EOF)
+	{
+		if (Chunk == BinaryLogChunk_Site)
+		{
+			BinaryLogSiteHeader SiteHeader = {};
+			if (fread(&SiteHeader, sizeof(BinaryLogSiteHeader), 1, pInput) != 1) { Truncated = true; break; }
+
+			DecodedSite& Site = Sites[SiteHeader.SiteId];
+			Site.Line = SiteHeader.Line;
+			Site.File.resize(SiteHeader.FileLength);
+			Site.Format.resize(SiteHeader.FormatLength);
+			if (fread(&Site.File[0], 1, SiteHeader.FileLength, pInput) != SiteHeader.FileLength
+				|| fread(&Site.Format[0], 1, SiteHeader.FormatLength, pInput) != SiteHeader.FormatLength)
+			{
+				Truncated = true;
+				break;
+			}
+		}
+		else if (Chunk == BinaryLogChunk_Record)
+		{
+			BinaryLogRecordHeader Record = {};
+			if (fread(&Record, sizeof(BinaryLogRecordHeader), 1, pInput) != 1) { Truncated = true; break; }
+			Payload.resize(Record.PayloadSize);
+			if (Record.PayloadSize > 0 && fread(Payload.data(), 1, Record.PayloadSize, pInput) != Record.PayloadSize) { Truncated = true; break; }
+
+			auto Iter = Sites.find(Record.SiteId);
+			if (Iter == Sites.end())
+			{
+				fprintf(stderr, "Record references unknown log site %u. Skipping.\n", Record.SiteId);
+				continue;
+			}
+			const DecodedSite& Site = Iter->second;
+
+			Message.clear();
+			FormatLogPayload(Site.Format.c_str(), Payload.data(), Record.PayloadSize, Record.NumArgs, Record.Flags, Message);
+
+			const time_t Seconds = static_cast<time_t>(Record.Timestamp / 1000000000ull);
+			const uint32_t Micros = static_cast<uint32_t>((Record.Timestamp / 1000ull) % 1000000ull);
+			char TimeString[32] = {};
+			strftime(TimeString, sizeof(TimeString), "%H:%M:%S", localtime(&Seconds));
+
+			fprintf(pOutput, "[%s.%06u] [%s] [Thread %u] %.*s (%s:%u)\n", TimeString, Micros, GetSeverityName(Record.Severity), Record.ThreadId,
+				static_cast<int>(Message.size()), Message.data(), Site.File.c_str(), Site.Line);
+			NumRecords++;
+		}
+		else
+		{
+			fprintf(stderr, "Unknown chunk type '%c'. The log is corrupt.\n", Chunk);
+			Truncated = true;
+			break;
+		}
+	}
+
+	if (Truncated)
+		fprintf(stderr, "Binary log ended early. The engine may not have shut down cleanly.\n");
+	fprintf(stderr, "Decoded %llu records from %zu log sites.\n", static_cast<unsigned long long>(NumRecords), Sites.size());
+
+	fclose(pInput);
+	if (pOutput != stdout)
+		fclose(pOutput);
+	return 0;
+}
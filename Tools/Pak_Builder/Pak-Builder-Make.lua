@@ -0,0 +1,60 @@
+-- Pak Builder
+-- Packs a Content folder into an .iepak archive the engine's virtual file system mounts in game builds.
+
+local pakRootDir = "../../"
+local pakEngineDir = pakRootDir .. "Engine_Source/Source/"
+local pakThirdPartyDir = pakRootDir .. "Engine_Source/Third_Party/"
+
+project ("Pak_Builder")
+	location (pakRootDir .. "Tools/Pak_Builder")
+	kind ("ConsoleApp")
+	cppdialect ("C++17")
+	language ("C++")
+	staticruntime ("off")
+	targetname ("Pak_Builder")
+
+	targetdir (pakRootDir .. "Binaries/" .. outputdir .. "/%{prj.name}")
+	objdir (pakRootDir .. "Binaries/Intermediates/" .. outputdir .. "/%{prj.name}")
+
+	files
+	{
+		"Pak-Builder-Make.lua",
+		"Source/**.h",
+		"Source/**.cpp",
+		-- Shared archive format with the engine's virtual file system.
+		pakEngineDir .. "Insight/Systems/Pak_File.*",
+		pakEngineDir .. "Insight/Systems/Mapped_File.*",
+		pakEngineDir .. "Insight/Utilities/Lz4.*",
+		pakEngineDir .. "Insight/Utilities/String_Helper.*",
+		-- Asset database, reads scenes the same way the engine does.
+		pakEngineDir .. "Insight/Systems/Asset_Database.*",
+		pakEngineDir .. "Insight/Systems/Json_Stream_Reader.*",
+		pakEngineDir .. "Insight/Systems/Virtual_File_System.*",
+		pakEngineDir .. "Insight/Systems/Async_IO.*",
+		pakEngineDir .. "Insight/Utilities/Xxh64.*",
+		pakThirdPartyDir .. "rapidjson/include/rapidjson/json.cpp",
+	}
+
+	includedirs
+	{
+		-- Must come first, provides the stand in Engine_pch.h.
+		"Source/",
+		pakEngineDir,
+		pakThirdPartyDir .. "spdlog/include/",
+		pakThirdPartyDir .. "rapidjson/include/",
+	}
+
+	systemversion ("latest")
+	defines
+	{
+		"_CRT_SECURE_NO_WARNINGS",
+	}
+
+	filter "system:linux"
+		links { "pthread" }
+
+	filter "configurations:Debug"
+		symbols "on"
+
+	filter "configurations:Release or configurations:Engine-Dist or configurations:Game-Dist"
+		optimize "on"
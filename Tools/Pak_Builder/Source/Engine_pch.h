@@ -0,0 +1,29 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	Stand in for Build_Rules/PCH_Source/Engine_pch.h when compiling the engine's archive sources into the Pak_Builder.
+*/
+#pragma once
+
+#include <mutex>
+#include <vector>
+#include <string>
+#include <memory>
+#include <thread>
+#include <future>
+#include <atomic>
+#include <functional>
+#include <cstring>
+#include <cstdint>
+#include <fstream>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <rapidjson/json.h>
+#include <rapidjson/writer.h>
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/prettywriter.h>
+
+#include <Insight/Core.h>
+#include "Insight/Core/Log.h"
@@ -0,0 +1,240 @@
+// Copyright Insight Interactive. All Rights Reserved.
+/*
+	Pak_Builder - Packs a folder into an .iepak archive, see Insight/Systems/Pak_File.h.
+
+	Usage:
+	Pak_Builder.exe <SourceDirectory> <OutputPak> [--no-compress] [--chunk-size <Bytes>] [--full] [--scene <Scene>]... [--deps <Asset>]
+	Ex. Pak_Builder.exe ../Content ../Content.iepak --scene Scenes/Norway.iescene
+	An asset database (see Insight/Systems/Asset_Database.h) is kept next to the archive, Ex. ../Content.iedb.
+	Files that have not changed since the last build are copied out of the previous archive instead of being
+	compressed again. --full compresses every file.
+	--scene packs only the listed scenes and the models and textures they use, along with every file that
+	is not part of a scene, a model or a texture (fonts, sounds, settings). May be given more than once.
+	--deps prints everything an asset depends on and which assets use it, then exits without packing.
+	Every file is read back out of the archive after it is written and compared with the original.
+*/
+#include <Engine_pch.h>
+
+#include "Insight/Systems/Pak_File.h"
+#include "Insight/Systems/Asset_Database.h"
+#include "Insight/Utilities/String_Helper.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <unordered_set>
+
+using namespace Insight;
+
+typedef std::function<bool(const std::string& RelativePath)> PackFilter;
+
+// Read every packed file back and compare it with the file it was packed from.
+static bool VerifyPak(const std::string& SourceDirectory, const std::string& PakPath, const PackFilter& Filter, uint64_t& OutTotalSize)
+{
+	namespace fs = std::filesystem;
+
+	std::shared_ptr<PakFile> pPak = std::make_shared<PakFile>();
+	if (!pPak->Open(PakPath))
+	{
+		fprintf(stderr, "Failed to open \"%s\" after writing it.\n", PakPath.c_str());
+		return false;
+	}
+
+	const fs::path AbsolutePakPath = fs::absolute(PakPath).lexically_normal();
+	uint32_t NumFiles = 0u;
+	OutTotalSize = 0u;
+	std::error_code Error;
+	for (fs::recursive_directory_iterator Iter(SourceDirectory, Error); !Error && Iter != fs::recursive_directory_iterator(); Iter.increment(Error))
+	{
+		if (!Iter->is_regular_file(Error) || fs::absolute(Iter->path()).lexically_normal() == AbsolutePakPath)
+			continue;
+
+		const std::string RelativePath = StringHelper::NormalizePath(Iter->path().lexically_relative(SourceDirectory).string());
+		if (Filter && !Filter(RelativePath))
+			continue;
+
+		const FileView Packed = pPak->Read(RelativePath);
+		const FileView Original = MappedFile::OpenView(Iter->path().string());
+		if (!Packed || !Original || Packed.GetSize() != Original.GetSize() || memcmp(Packed.GetData(), Original.GetData(), Original.GetSize()) != 0)
+		{
+			fprintf(stderr, "\"%s\" does not match its packed copy.\n", RelativePath.c_str());
+			return false;
+		}
+		OutTotalSize += Original.GetSize();
+		NumFiles++;
+	}
+
+	if (NumFiles != pPak->GetNumEntries())
+	{
+		fprintf(stderr, "Packed %u files but found %u in \"%s\".\n", pPak->GetNumEntries(), NumFiles, SourceDirectory.c_str());
+		return false;
+	}
+	return true;
+}
+
+// Warn about files scenes use that are not in the Content folder, they would fail to load from the archive too.
+static void ReportMissingDependencies(const AssetDatabase& Database, const std::vector<std::string>& Scenes)
+{
+	for (const std::string& Scene : Scenes)
+	{
+		std::vector<std::string> Dependencies;
+		Database.GetDependencies(Scene, Dependencies);
+		for (const std::string& Dependency : Dependencies)
+		{
+			if (!Database.Find(Dependency))
+				fprintf(stderr, "Warning: \"%s\" uses \"%s\", which is not in the Content folder.\n", Scene.c_str(), Dependency.c_str());
+		}
+	}
+}
+
+static void PrintDependencies(const AssetDatabase& Database, const std::string& AssetPath)
+{
+	std::vector<std::string> Dependencies, Dependents;
+	Database.GetDependencies(AssetPath, Dependencies);
+	Database.GetDependents(AssetPath, Dependents);
+
+	printf("%s depends on:\n", AssetPath.c_str());
+	for (size_t i = 1u; i < Dependencies.size(); ++i)
+	{
+		const AssetDatabase::Asset* pAsset = Database.Find(Dependencies[i]);
+		printf("\t%-9s %s\n", pAsset ? AssetDatabase::GetTypeName(pAsset->Type) : "Missing", Dependencies[i].c_str());
+	}
+	printf("%s is used by:\n", AssetPath.c_str());
+	for (const std::string& Dependent : Dependents)
+		printf("\t%s\n", Dependent.c_str());
+}
+
+static std::string NormalizeAssetPath(const std::string& Path)
+{
+	std::string Normalized = StringHelper::NormalizePath(Path);
+	while (!Normalized.empty() && Normalized.back() == '/')
+		Normalized.pop_back();
+	return Normalized;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		fprintf(stderr, "Usage: %s <SourceDirectory> <OutputPak> [--no-compress] [--chunk-size <Bytes>] [--full] [--scene <Scene>]... [--deps <Asset>]\n", argv[0]);
+		return 1;
+	}
+
+	const std::string SourceDirectory = argv[1];
+	const std::string PakPath = argv[2];
+	PakWriter::Options PakOptions;
+	bool FullCook = false;
+	std::vector<std::string> Scenes;
+	std::string DependenciesOf;
+	for (int i = 3; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "--no-compress") == 0)
+		{
+			PakOptions.Compress = false;
+		}
+		else if (strcmp(argv[i], "--chunk-size") == 0 && i + 1 < argc)
+		{
+			PakOptions.ChunkSize = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+		}
+		else if (strcmp(argv[i], "--full") == 0)
+		{
+			FullCook = true;
+		}
+		else if (strcmp(argv[i], "--scene") == 0 && i + 1 < argc)
+		{
+			Scenes.push_back(NormalizeAssetPath(argv[++i]));
+		}
+		else if (strcmp(argv[i], "--deps") == 0 && i + 1 < argc)
+		{
+			DependenciesOf = NormalizeAssetPath(argv[++i]);
+		}
+		else
+		{
+			fprintf(stderr, "Unknown argument \"%s\".\n", argv[i]);
+			return 1;
+		}
+	}
+
+	const std::string DatabasePath = std::filesystem::path(PakPath).replace_extension(".iedb").string();
+	AssetDatabase Database;
+	if (!FullCook)
+		Database.Load(DatabasePath);
+	if (!Database.Scan(SourceDirectory))
+	{
+		fprintf(stderr, "Failed to scan \"%s\".\n", SourceDirectory.c_str());
+		return 1;
+	}
+
+	if (!DependenciesOf.empty())
+	{
+		PrintDependencies(Database, DependenciesOf);
+		return 0;
+	}
+
+	std::vector<std::string> ReportedScenes = Scenes;
+	if (ReportedScenes.empty())
+	{
+		for (const auto& Entry : Database.GetAssets())
+			if (Entry.second.Type == AssetDatabase::AssetType::Scene)
+				ReportedScenes.push_back(Entry.first);
+	}
+	ReportMissingDependencies(Database, ReportedScenes);
+
+	PackFilter Filter;
+	if (!Scenes.empty())
+	{
+		std::unordered_set<std::string> Packed;
+		for (const std::string& Scene : Scenes)
+		{
+			if (!Database.Find(Scene))
+			{
+				fprintf(stderr, "\"%s\" is not a scene in \"%s\".\n", Scene.c_str(), SourceDirectory.c_str());
+				return 1;
+			}
+			std::vector<std::string> Dependencies;
+			Database.GetDependencies(Scene, Dependencies);
+			Packed.insert(Dependencies.begin(), Dependencies.end());
+		}
+
+		Filter = [&Database, Packed](const std::string& RelativePath)
+		{
+			if (Packed.count(RelativePath) != 0u)
+				return true;
+			const AssetDatabase::Asset* pAsset = Database.Find(RelativePath);
+			const bool IsSceneFile = RelativePath.find(".iescene/") != std::string::npos;
+			return pAsset && pAsset->Type == AssetDatabase::AssetType::File && !IsSceneFile;
+		};
+	}
+
+	const uint64_t OptionsHash = PakWriter::HashOptions(PakOptions);
+	PakOptions.Filter = Filter;
+	if (!FullCook)
+	{
+		PakOptions.PreviousPakPath = PakPath;
+		PakOptions.IsCookUpToDate = [&Database, OptionsHash](const std::string& RelativePath, uint64_t& OutCookedHash)
+		{
+			return Database.IsCookUpToDate(RelativePath, OptionsHash, OutCookedHash);
+		};
+	}
+	PakOptions.OnCooked = [&Database, OptionsHash](const std::string& RelativePath, uint64_t CookedHash)
+	{
+		Database.SetCooked(RelativePath, OptionsHash, CookedHash);
+	};
+
+	if (!PakWriter::WriteDirectory(SourceDirectory, PakPath, PakOptions))
+	{
+		fprintf(stderr, "Failed to pack \"%s\" into \"%s\".\n", SourceDirectory.c_str(), PakPath.c_str());
+		return 1;
+	}
+
+	uint64_t TotalSize = 0u;
+	if (!VerifyPak(SourceDirectory, PakPath, Filter, TotalSize))
+		return 1;
+	if (!Database.Save(DatabasePath))
+		fprintf(stderr, "Failed to save the asset database \"%s\", the next build will compress every file.\n", DatabasePath.c_str());
+
+	std::error_code Error;
+	const uintmax_t PakSize = std::filesystem::file_size(PakPath, Error);
+	fprintf(stderr, "Packed %llu bytes from \"%s\" into \"%s\" (%llu bytes).\n", static_cast<unsigned long long>(TotalSize),
+		SourceDirectory.c_str(), PakPath.c_str(), static_cast<unsigned long long>(PakSize));
+	return 0;
+}
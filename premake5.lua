@@ -29,6 +29,9 @@ CustomDefines["IE_BUILD_CONFIG"] = outputdir
 -- Tools
 group ("Tools")
 	include ("Engine_Source/Third_Party/ImGui/premake5.lua")
+	include ("Tools/Log_Decoder/Log-Decoder-Make.lua")
+	include ("Tools/Pak_Builder/Pak-Builder-Make.lua")
+	include ("Tools/Engine_Benchmarks/Engine-Benchmarks-Make.lua")
 group ("")
 
 -- Applications